@@ -0,0 +1,336 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "quant_hft/core/binary_section_file.h"
+#include "quant_hft/services/bar_aggregator.h"
+
+namespace quant_hft::apps {
+
+// Where the replay loop handed a one-minute bar to the strategies, relative to the tick it was
+// processing. Replaying cached bars at the same points keeps fills and equity samples identical
+// to a run that aggregates ticks itself.
+enum class ReplayBarEmitPoint : std::uint8_t {
+    kFilteredTick = 0,   // the tick was rejected by the session filter
+    kTick = 1,           // the tick was applied to the aggregator
+    kFlushFinished = 2,  // lateness flush after the tick
+    kEnd = 3,            // end-of-input flush; tick_index equals the tick count
+};
+
+struct CachedReplayBar {
+    std::uint64_t tick_index{0};
+    ReplayBarEmitPoint emit_point{ReplayBarEmitPoint::kTick};
+    BarSnapshot bar;
+    // Replayed ticks bounding the bar, as indices into the loaded tick stream.
+    std::uint64_t first_tick_index{0};
+    std::uint64_t last_tick_index{0};
+};
+
+// Output of the tick-to-bar stage of one replay: the canonical one-minute bars in emission
+// order plus the ticks the session filter dropped. It is only valid for the exact tick stream
+// and session config it was built from, which the cache key captures.
+struct ReplayBarCache {
+    std::string key;
+    std::uint64_t tick_count{0};
+    std::vector<std::uint8_t> filtered_ticks;
+    std::vector<CachedReplayBar> bars;
+};
+
+namespace detail {
+
+// Bar cache layout: a sectioned binary file (see binary_section_file.h) with
+//   kReplayBarCacheMeta:    key | u64 tick_count | u64 bar_count | filtered tick indices |
+//                           string table
+//   kReplayBarCacheColumns: one array per column
+// Columns are stored contiguously so a load is a handful of sequential passes per field.
+constexpr BinarySectionFileFormat kReplayBarCacheFormat{
+    {'Q', 'H', 'B', 'A', 'R', 'C', 'H', '\0'}, 2, "bar cache"};
+constexpr std::uint32_t kReplayBarCacheMeta = 1;
+constexpr std::uint32_t kReplayBarCacheColumns = 2;
+
+template <typename T, typename Field>
+void PutReplayBarColumn(BinarySectionWriter* writer, const std::vector<CachedReplayBar>& rows,
+                        Field field) {
+    for (const CachedReplayBar& row : rows) {
+        writer->Put(static_cast<T>(field(row)));
+    }
+}
+
+template <typename T, typename Assign>
+bool GetReplayBarColumn(BinarySectionReader* reader, std::vector<CachedReplayBar>* rows,
+                        Assign assign) {
+    for (CachedReplayBar& row : *rows) {
+        T value{};
+        if (!reader->Get(&value)) {
+            return false;
+        }
+        assign(&row, value);
+    }
+    return true;
+}
+
+// Instrument, exchange, day and minute strings repeat across almost every bar; the cache stores
+// each distinct value once and the rows as u32 references into this table.
+class ReplayBarCacheStringTable {
+   public:
+    std::uint32_t Intern(const std::string& value) {
+        const auto [it, inserted] =
+            index_.try_emplace(value, static_cast<std::uint32_t>(values_.size()));
+        if (inserted) {
+            values_.push_back(value);
+        }
+        return it->second;
+    }
+
+    const std::vector<std::string>& values() const { return values_; }
+
+   private:
+    std::unordered_map<std::string, std::uint32_t> index_;
+    std::vector<std::string> values_;
+};
+
+inline void SetReplayBarCacheError(std::string* error, const std::string& message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+}  // namespace detail
+
+inline std::filesystem::path ReplayBarCachePath(const std::filesystem::path& cache_dir,
+                                                const std::string& key) {
+    return cache_dir / ("bars-" + key + ".qhbc");
+}
+
+inline bool SaveReplayBarCache(const std::filesystem::path& path, const ReplayBarCache& cache,
+                               std::string* error) {
+    if (cache.filtered_ticks.size() != cache.tick_count) {
+        detail::SetReplayBarCacheError(error, "bar cache filtered tick mask size mismatch");
+        return false;
+    }
+
+    detail::ReplayBarCacheStringTable strings;
+    std::vector<std::array<std::uint32_t, 5>> string_refs;
+    string_refs.reserve(cache.bars.size());
+    for (const CachedReplayBar& row : cache.bars) {
+        string_refs.push_back({strings.Intern(row.bar.instrument_id),
+                               strings.Intern(row.bar.exchange_id),
+                               strings.Intern(row.bar.trading_day),
+                               strings.Intern(row.bar.action_day), strings.Intern(row.bar.minute)});
+    }
+
+    std::string encoded;
+    BinarySectionWriter writer(&encoded);
+    writer.BeginSection(detail::kReplayBarCacheMeta);
+    writer.PutString(cache.key);
+    writer.Put(cache.tick_count);
+    writer.Put(static_cast<std::uint64_t>(cache.bars.size()));
+    // Session-filtered ticks are rare, so they are stored as a sparse index list.
+    std::vector<std::uint64_t> filtered_indices;
+    for (std::size_t index = 0; index < cache.filtered_ticks.size(); ++index) {
+        if (cache.filtered_ticks[index] != 0) {
+            filtered_indices.push_back(index);
+        }
+    }
+    writer.Put(static_cast<std::uint64_t>(filtered_indices.size()));
+    for (const std::uint64_t index : filtered_indices) {
+        writer.Put(index);
+    }
+    writer.Put(static_cast<std::uint32_t>(strings.values().size()));
+    for (const std::string& value : strings.values()) {
+        writer.PutString(value);
+    }
+    writer.EndSection();
+
+    writer.BeginSection(detail::kReplayBarCacheColumns);
+    for (std::size_t field = 0; field < 5; ++field) {
+        for (const auto& refs : string_refs) {
+            writer.Put(refs[field]);
+        }
+    }
+    const auto& rows = cache.bars;
+    const auto put_index = [&](std::uint64_t CachedReplayBar::*field) {
+        detail::PutReplayBarColumn<std::uint64_t>(
+            &writer, rows, [field](const CachedReplayBar& row) { return row.*field; });
+    };
+    const auto put_bar_field = [&](auto BarSnapshot::*field) {
+        using Value = std::remove_reference_t<decltype(std::declval<BarSnapshot>().*field)>;
+        detail::PutReplayBarColumn<Value>(
+            &writer, rows, [field](const CachedReplayBar& row) { return row.bar.*field; });
+    };
+    put_index(&CachedReplayBar::tick_index);
+    detail::PutReplayBarColumn<std::uint8_t>(
+        &writer, rows, [](const CachedReplayBar& row) { return row.emit_point; });
+    put_index(&CachedReplayBar::first_tick_index);
+    put_index(&CachedReplayBar::last_tick_index);
+    put_bar_field(&BarSnapshot::open);
+    put_bar_field(&BarSnapshot::high);
+    put_bar_field(&BarSnapshot::low);
+    put_bar_field(&BarSnapshot::close);
+    put_bar_field(&BarSnapshot::analysis_open);
+    put_bar_field(&BarSnapshot::analysis_high);
+    put_bar_field(&BarSnapshot::analysis_low);
+    put_bar_field(&BarSnapshot::analysis_close);
+    put_bar_field(&BarSnapshot::analysis_price_offset);
+    put_bar_field(&BarSnapshot::volume);
+    put_bar_field(&BarSnapshot::ts_ns);
+    put_bar_field(&BarSnapshot::period_end_ts_ns);
+    put_bar_field(&BarSnapshot::finalized_ts_ns);
+    put_bar_field(&BarSnapshot::expected_source_bars);
+    put_bar_field(&BarSnapshot::observed_source_bars);
+    detail::PutReplayBarColumn<std::uint8_t>(&writer, rows, [](const CachedReplayBar& row) {
+        const BarSnapshot& bar = row.bar;
+        return (bar.is_complete ? 0x01U : 0U) | (bar.is_session_endpoint ? 0x02U : 0U) |
+               (bar.strategy_eligible ? 0x04U : 0U) | (bar.volume_complete ? 0x08U : 0U) |
+               (bar.has_conflict ? 0x10U : 0U) | (bar.is_recovery_replay ? 0x20U : 0U);
+    });
+    writer.EndSection();
+    writer.Finish(detail::kReplayBarCacheFormat);
+
+    // Concurrent replays sharing a cache directory may store the same key; each writes its own
+    // temp file and the last rename wins.
+    return WriteFileAtomically(path.string(), encoded, detail::kReplayBarCacheFormat.label, error);
+}
+
+// Loads the cache stored at `path`. Returns false with `error` set when the file is missing,
+// corrupt, or was built for a different key; callers treat all of these as a cache miss.
+inline bool LoadReplayBarCache(const std::filesystem::path& path, const std::string& expected_key,
+                               ReplayBarCache* cache, std::string* error) {
+    if (cache == nullptr) {
+        detail::SetReplayBarCacheError(error, "bar cache output is null");
+        return false;
+    }
+    MappedReadOnlyFile file;
+    if (!file.Open(path.string(), detail::kReplayBarCacheFormat.label, error)) {
+        return false;
+    }
+    const auto corrupt = [&](const std::string& reason) {
+        detail::SetReplayBarCacheError(error, "invalid bar cache " + path.string() + ": " + reason);
+        return false;
+    };
+    std::vector<BinarySection> sections;
+    std::string split_error;
+    if (!SplitBinarySections(file.data(), file.size(), detail::kReplayBarCacheFormat, &sections,
+                             &split_error)) {
+        return corrupt(split_error);
+    }
+    if (sections.size() != 2 || sections[0].kind != detail::kReplayBarCacheMeta ||
+        sections[1].kind != detail::kReplayBarCacheColumns) {
+        return corrupt("unexpected sections");
+    }
+
+    BinarySectionReader reader(sections[0].payload, sections[0].payload_bytes);
+    const std::size_t file_bytes = file.size();
+    ReplayBarCache loaded;
+    std::uint64_t bar_count = 0;
+    if (!reader.GetString(&loaded.key) || !reader.Get(&loaded.tick_count) ||
+        !reader.Get(&bar_count)) {
+        return corrupt("truncated meta section");
+    }
+    if (loaded.key != expected_key) {
+        detail::SetReplayBarCacheError(error, "bar cache key mismatch: " + path.string());
+        return false;
+    }
+    if (bar_count > file_bytes || loaded.tick_count > file_bytes) {
+        return corrupt("row count out of range");
+    }
+    std::uint64_t filtered_count = 0;
+    if (!reader.Get(&filtered_count) || filtered_count > loaded.tick_count) {
+        return corrupt("truncated filtered tick list");
+    }
+    loaded.filtered_ticks.assign(static_cast<std::size_t>(loaded.tick_count), 0);
+    for (std::uint64_t index = 0; index < filtered_count; ++index) {
+        std::uint64_t tick_index = 0;
+        if (!reader.Get(&tick_index) || tick_index >= loaded.tick_count) {
+            return corrupt("invalid filtered tick list");
+        }
+        loaded.filtered_ticks[static_cast<std::size_t>(tick_index)] = 1;
+    }
+    std::uint32_t string_count = 0;
+    if (!reader.Get(&string_count) || string_count > file_bytes) {
+        return corrupt("truncated string table");
+    }
+    std::vector<std::string> strings(string_count);
+    for (std::string& value : strings) {
+        if (!reader.GetString(&value)) {
+            return corrupt("truncated string table");
+        }
+    }
+    if (!reader.AtEnd()) {
+        return corrupt("malformed meta section");
+    }
+
+    loaded.bars.resize(static_cast<std::size_t>(bar_count));
+    BinarySectionReader columns(sections[1].payload, sections[1].payload_bytes);
+    bool strings_valid = true;
+    const auto column = [&](auto type_tag, auto assign) {
+        using Value = decltype(type_tag);
+        return detail::GetReplayBarColumn<Value>(&columns, &loaded.bars, assign);
+    };
+    const auto string_column = [&](std::string BarSnapshot::*field) {
+        return column(std::uint32_t{}, [&](CachedReplayBar* row, std::uint32_t ref) {
+            if (ref >= strings.size()) {
+                strings_valid = false;
+                return;
+            }
+            row->bar.*field = strings[ref];
+        });
+    };
+    const auto index_column = [&](std::uint64_t CachedReplayBar::*field) {
+        return column(std::uint64_t{},
+                      [field](CachedReplayBar* row, std::uint64_t value) { row->*field = value; });
+    };
+    const auto bar_column = [&](auto BarSnapshot::*field) {
+        using Value = std::remove_reference_t<decltype(std::declval<BarSnapshot>().*field)>;
+        return column(Value{},
+                      [field](CachedReplayBar* row, Value value) { row->bar.*field = value; });
+    };
+    const bool columns_read =
+        string_column(&BarSnapshot::instrument_id) && string_column(&BarSnapshot::exchange_id) &&
+        string_column(&BarSnapshot::trading_day) && string_column(&BarSnapshot::action_day) &&
+        string_column(&BarSnapshot::minute) && index_column(&CachedReplayBar::tick_index) &&
+        column(std::uint8_t{},
+               [](CachedReplayBar* row, std::uint8_t value) {
+                   row->emit_point = static_cast<ReplayBarEmitPoint>(value);
+               }) &&
+        index_column(&CachedReplayBar::first_tick_index) &&
+        index_column(&CachedReplayBar::last_tick_index) && bar_column(&BarSnapshot::open) &&
+        bar_column(&BarSnapshot::high) && bar_column(&BarSnapshot::low) &&
+        bar_column(&BarSnapshot::close) && bar_column(&BarSnapshot::analysis_open) &&
+        bar_column(&BarSnapshot::analysis_high) && bar_column(&BarSnapshot::analysis_low) &&
+        bar_column(&BarSnapshot::analysis_close) &&
+        bar_column(&BarSnapshot::analysis_price_offset) && bar_column(&BarSnapshot::volume) &&
+        bar_column(&BarSnapshot::ts_ns) && bar_column(&BarSnapshot::period_end_ts_ns) &&
+        bar_column(&BarSnapshot::finalized_ts_ns) &&
+        bar_column(&BarSnapshot::expected_source_bars) &&
+        bar_column(&BarSnapshot::observed_source_bars) &&
+        column(std::uint8_t{}, [](CachedReplayBar* row, std::uint8_t flags) {
+            row->bar.is_complete = (flags & 0x01U) != 0;
+            row->bar.is_session_endpoint = (flags & 0x02U) != 0;
+            row->bar.strategy_eligible = (flags & 0x04U) != 0;
+            row->bar.volume_complete = (flags & 0x08U) != 0;
+            row->bar.has_conflict = (flags & 0x10U) != 0;
+            row->bar.is_recovery_replay = (flags & 0x20U) != 0;
+        });
+    if (!columns_read || !strings_valid || !columns.AtEnd()) {
+        return corrupt("malformed columns");
+    }
+    for (const CachedReplayBar& row : loaded.bars) {
+        if (row.emit_point > ReplayBarEmitPoint::kEnd || row.tick_index > loaded.tick_count ||
+            row.first_tick_index > row.last_tick_index ||
+            row.last_tick_index >= loaded.tick_count) {
+            return corrupt("row out of range");
+        }
+    }
+    *cache = std::move(loaded);
+    return true;
+}
+
+}  // namespace quant_hft::apps
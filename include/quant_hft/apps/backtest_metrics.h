@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -159,6 +161,88 @@ struct EquitySample {
     std::string market_regime;
 };
 
+// Sliding-window annualised Sharpe and max drawdown over daily rows. Each Push is amortised
+// O(1): the window is kept as two stacks of partial aggregates (mean/M2, peak/trough/drawdown)
+// instead of copying and rescanning the window for every end index.
+class RollingWindowAccumulator {
+   public:
+    struct Aggregate {
+        std::size_t count{0};
+        double mean{0.0};
+        double m2{0.0};
+        double peak{0.0};
+        double trough{0.0};
+        double max_drawdown_pct{0.0};
+    };
+
+    explicit RollingWindowAccumulator(int window_days = 63);
+
+    void Push(double daily_return, double capital);
+    bool full() const { return size() >= window_; }
+    std::size_t size() const { return front_.size() + back_.size(); }
+    double sharpe() const;
+    double max_drawdown_pct() const;
+
+   private:
+    struct Entry {
+        Aggregate value;
+        Aggregate suffix;
+    };
+
+    void PopOldest();
+    Aggregate Current() const;
+
+    std::size_t window_{63};
+    std::vector<Entry> front_;
+    std::vector<Aggregate> back_;
+    Aggregate back_total_;
+};
+
+// Online daily metrics: fed with equity samples as replay advances, closes each trading day
+// when the next one starts and keeps the rolling Sharpe/drawdown series up to date, so the
+// replay never has to retain intraday equity history.
+class OnlineDailyMetrics {
+   public:
+    explicit OnlineDailyMetrics(double initial_capital, int rolling_window_days = 63);
+
+    // Keeps the latest sample per trading day; samples older than the day's latest are ignored
+    // and an empty regime keeps the previously seen one.
+    void UpsertEquitySample(const EquitySample& sample);
+
+    std::size_t closed_days() const { return closed_.size(); }
+    double rolling_sharpe_last() const;
+    double rolling_max_dd_last() const;
+
+    // Produces the same rows as ComputeDailyMetrics/ComputeRollingMetrics over the latest
+    // sample of every trading day.
+    std::vector<DailyPerformance> Finalize(const std::vector<TradeRecord>& trades,
+                                           RollingMetrics* rolling) const;
+
+   private:
+    struct DailyState {
+        bool started{false};
+        double initial_capital{0.0};
+        double previous_capital{0.0};
+        double running_peak{0.0};
+    };
+
+    void CloseDay(const EquitySample& sample, DailyState* state,
+                  RollingWindowAccumulator* accumulator, std::vector<DailyPerformance>* daily,
+                  RollingMetrics* rolling) const;
+
+    double configured_initial_capital_{0.0};
+    int rolling_window_days_{63};
+    bool has_open_day_{false};
+    EquitySample open_day_;
+    std::vector<EquitySample> closed_samples_;
+    std::vector<DailyPerformance> closed_;
+    RollingMetrics closed_rolling_;
+    DailyState state_;
+    RollingWindowAccumulator accumulator_;
+    // Samples that arrived for a day earlier than the open one; forces a batch rebuild.
+    std::map<std::string, EquitySample> late_samples_;
+};
+
 std::vector<DailyPerformance> ComputeDailyMetrics(const std::vector<EquitySample>& equity_history,
                                                   const std::vector<TradeRecord>& trades,
                                                   double initial_capital);
@@ -184,4 +268,10 @@ AdvancedSummary ComputeAdvancedSummary(const std::vector<DailyPerformance>& dail
                                        const std::vector<TradeRecord>& trades,
                                        const RiskMetrics& risk_metrics);
 
+// Same as above, reusing an already computed 63-day rolling series.
+AdvancedSummary ComputeAdvancedSummary(const std::vector<DailyPerformance>& daily,
+                                       const std::vector<TradeRecord>& trades,
+                                       const RiskMetrics& risk_metrics,
+                                       const RollingMetrics& rolling);
+
 }  // namespace quant_hft::apps
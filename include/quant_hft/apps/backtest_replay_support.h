@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <chrono>
 #include <cmath>
@@ -13,6 +14,8 @@
 #include <iomanip>
 #include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <queue>
@@ -21,13 +24,16 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "quant_hft/apps/backtest_bar_cache.h"
 #include "quant_hft/apps/backtest_metrics.h"
 #include "quant_hft/apps/cli_support.h"
+#include "quant_hft/apps/dataset_digest_index.h"
 #include "quant_hft/backtest/contract_expiry_calendar.h"
 #include "quant_hft/backtest/indicator_trace_csv_writer.h"
 #include "quant_hft/backtest/indicator_trace_parquet_writer.h"
@@ -37,6 +43,7 @@
 #include "quant_hft/backtest/sub_strategy_indicator_trace_parquet_writer.h"
 #include "quant_hft/common/timestamp.h"
 #include "quant_hft/services/bar_aggregator.h"
+#include "quant_hft/services/compiled_session_calendar.h"
 #include "quant_hft/services/market_state_detector.h"
 #include "quant_hft/strategy/composite_config_loader.h"
 #include "quant_hft/strategy/composite_strategy.h"
@@ -746,31 +753,34 @@ inline std::string LocalDateTimeFromTradingDayAndUpdateTime(const std::string& t
     return DateTimeFromEpochNs(fallback_ts_ns);
 }
 
-inline BarAggregator& SharedSessionResolver() {
-    static BarAggregator resolver([] {
-        BarAggregatorConfig config;
-        config.filter_non_trading_ticks = false;
-        config.is_backtest_mode = true;
-        return config;
-    }());
-    return resolver;
+inline const CompiledSessionCalendar& SharedSessionCalendar() {
+    static const std::shared_ptr<const CompiledSessionCalendar> calendar =
+        CompiledSessionCalendar::Shared(BarAggregatorConfig{}.trading_sessions_config_path, true);
+    return *calendar;
 }
 
 inline int ResolveSessionOrderForOutput(const std::string& exchange, const std::string& symbol,
                                         const std::string& update_time) {
-    std::string resolved_update_time = update_time;
-    if (resolved_update_time.empty()) {
+    int minute_of_day = 0;
+    if (!CompiledSessionCalendar::ParseMinuteOfDay(update_time, &minute_of_day)) {
         return std::numeric_limits<int>::max();
     }
-    return SharedSessionResolver().ResolveSessionOrder(exchange, symbol, resolved_update_time);
+    const auto* schedule = SharedSessionCalendar().ResolveInstrument(exchange, symbol);
+    const auto* interval = schedule == nullptr ? nullptr : schedule->IntervalAt(minute_of_day);
+    return interval == nullptr ? minute_of_day
+                               : CompiledSessionCalendar::SessionOrderKey(*interval);
 }
 
 inline std::string ResolveSessionKey(const std::string& exchange_id,
                                      const std::string& instrument_id,
                                      const std::string& update_time) {
-    const std::string exchange =
-        exchange_id.empty() ? SharedSessionResolver().InferExchangeId(instrument_id) : exchange_id;
-    return SharedSessionResolver().ResolveSessionKey(exchange, instrument_id, update_time);
+    int minute_of_day = 0;
+    if (!CompiledSessionCalendar::ParseMinuteOfDay(update_time, &minute_of_day)) {
+        return "";
+    }
+    const auto* schedule = SharedSessionCalendar().ResolveInstrument(exchange_id, instrument_id);
+    const auto* interval = schedule == nullptr ? nullptr : schedule->IntervalAt(minute_of_day);
+    return interval == nullptr ? "" : CompiledSessionCalendar::FormatSessionKey(*interval);
 }
 
 inline std::string BuildReplayMinuteKey(const std::string& trading_day,
@@ -1116,140 +1126,6 @@ inline double Mean(const std::vector<double>& values) {
     return sum / static_cast<double>(values.size());
 }
 
-inline bool ExtractJsonNumber(const std::string& json, const std::string& key, double* out_value) {
-    if (out_value == nullptr) {
-        return false;
-    }
-    const std::string quoted_key = "\"" + key + "\"";
-    const std::size_t key_pos = json.find(quoted_key);
-    if (key_pos == std::string::npos) {
-        return false;
-    }
-    const std::size_t colon_pos = json.find(':', key_pos + quoted_key.size());
-    if (colon_pos == std::string::npos) {
-        return false;
-    }
-
-    std::size_t value_start = colon_pos + 1;
-    while (value_start < json.size() &&
-           std::isspace(static_cast<unsigned char>(json[value_start])) != 0) {
-        ++value_start;
-    }
-
-    std::size_t value_end = value_start;
-    while (value_end < json.size()) {
-        const char ch = json[value_end];
-        if ((ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.' || ch == 'e' ||
-            ch == 'E') {
-            ++value_end;
-            continue;
-        }
-        break;
-    }
-
-    if (value_end <= value_start) {
-        return false;
-    }
-
-    return ParseDouble(json.substr(value_start, value_end - value_start), out_value);
-}
-
-inline bool ExtractJsonString(const std::string& json, const std::string& key,
-                              std::string* out_value) {
-    if (out_value == nullptr) {
-        return false;
-    }
-    const std::string quoted_key = "\"" + key + "\"";
-    const std::size_t key_pos = json.find(quoted_key);
-    if (key_pos == std::string::npos) {
-        return false;
-    }
-    const std::size_t colon_pos = json.find(':', key_pos + quoted_key.size());
-    if (colon_pos == std::string::npos) {
-        return false;
-    }
-
-    std::size_t value_pos = colon_pos + 1;
-    while (value_pos < json.size() &&
-           std::isspace(static_cast<unsigned char>(json[value_pos])) != 0) {
-        ++value_pos;
-    }
-    if (value_pos >= json.size() || json[value_pos] != '"') {
-        return false;
-    }
-    ++value_pos;
-
-    std::string value;
-    value.reserve(32);
-    bool escaped = false;
-    while (value_pos < json.size()) {
-        const char ch = json[value_pos++];
-        if (escaped) {
-            switch (ch) {
-                case '"':
-                    value.push_back('"');
-                    break;
-                case '\\':
-                    value.push_back('\\');
-                    break;
-                case 'n':
-                    value.push_back('\n');
-                    break;
-                case 'r':
-                    value.push_back('\r');
-                    break;
-                case 't':
-                    value.push_back('\t');
-                    break;
-                default:
-                    value.push_back(ch);
-                    break;
-            }
-            escaped = false;
-            continue;
-        }
-        if (ch == '\\') {
-            escaped = true;
-            continue;
-        }
-        if (ch == '"') {
-            *out_value = value;
-            return true;
-        }
-        value.push_back(ch);
-    }
-    return false;
-}
-
-inline bool ExtractJsonBool(const std::string& json, const std::string& key, bool* out_value) {
-    if (out_value == nullptr) {
-        return false;
-    }
-    const std::string quoted_key = "\"" + key + "\"";
-    const std::size_t key_pos = json.find(quoted_key);
-    if (key_pos == std::string::npos) {
-        return false;
-    }
-    const std::size_t colon_pos = json.find(':', key_pos + quoted_key.size());
-    if (colon_pos == std::string::npos) {
-        return false;
-    }
-    std::size_t value_start = colon_pos + 1;
-    while (value_start < json.size() &&
-           std::isspace(static_cast<unsigned char>(json[value_start])) != 0) {
-        ++value_start;
-    }
-    if (value_start + 4 <= json.size() && json.compare(value_start, 4, "true") == 0) {
-        *out_value = true;
-        return true;
-    }
-    if (value_start + 5 <= json.size() && json.compare(value_start, 5, "false") == 0) {
-        *out_value = false;
-        return true;
-    }
-    return false;
-}
-
 }  // namespace detail
 
 struct BacktestStrategyConfig {
@@ -1298,6 +1174,14 @@ struct BacktestCliSpec {
     bool emit_orders{true};
     bool emit_position_history{false};
     bool emit_per_variety_outputs{false};
+    // > 0 replays each product on its own account (no cross-product margin or equity coupling)
+    // using up to this many workers, and merges the accounts at `product_sync_granularity`
+    // ("tick", "bar" or "day"). The merged result does not depend on the worker count.
+    std::int64_t product_parallelism{0};
+    std::string product_sync_granularity{"bar"};
+    // Directory of content-addressed one-minute bar caches. When set, replays reuse the bars a
+    // previous run aggregated from the same ticks and session config instead of rebuilding them.
+    std::string bar_cache_dir;
     MarketStateDetectorConfig detector_config{};
     MarketStateDetectorConfigByProduct detector_config_by_product{};
 };
@@ -1322,6 +1206,8 @@ namespace detail {
 struct ReplayBarTickContext {
     ReplayTick first_tick;
     ReplayTick last_tick;
+    std::size_t first_tick_index{0};
+    std::size_t last_tick_index{0};
     bool initialized{false};
 };
 
@@ -1342,7 +1228,7 @@ struct PendingBarIntent {
 
 inline bool TrackReplayBarTickContext(
     const ReplayTick& tick, std::unordered_map<std::string, ReplayBarTickContext>* contexts,
-    std::string* error) {
+    std::string* error, std::size_t tick_index = 0) {
     if (contexts == nullptr) {
         if (error != nullptr) {
             *error = "replay bar context map is null";
@@ -1362,10 +1248,13 @@ inline bool TrackReplayBarTickContext(
     if (!context.initialized) {
         context.first_tick = tick;
         context.last_tick = tick;
+        context.first_tick_index = tick_index;
+        context.last_tick_index = tick_index;
         context.initialized = true;
         return true;
     }
     context.last_tick = tick;
+    context.last_tick_index = tick_index;
     return true;
 }
 
@@ -1569,6 +1458,7 @@ class ReplayTimeframeFanout {
                 bucket.bar.action_day = one_minute_bar.action_day;
             }
             bucket.context.last_tick = context.last_tick;
+            bucket.context.last_tick_index = context.last_tick_index;
             emit_session_end_bucket();
         }
 
@@ -1678,12 +1568,14 @@ class ReplayTimeframeFanout {
     }
 
     static bool IsSessionEndMinute(const BarSnapshot& bar) {
-        const std::string update_time = UpdateTimeFromMinuteKey(bar.minute);
-        if (update_time.empty()) {
+        int minute_of_day = 0;
+        if (!CompiledSessionCalendar::ParseMinuteOfDay(UpdateTimeFromMinuteKey(bar.minute),
+                                                       &minute_of_day)) {
             return false;
         }
-        return SharedSessionResolver().IsSessionEndMinute(bar.exchange_id, bar.instrument_id,
-                                                          update_time);
+        const auto* schedule =
+            SharedSessionCalendar().ResolveInstrument(bar.exchange_id, bar.instrument_id);
+        return schedule != nullptr && schedule->IsLastMinute(minute_of_day);
     }
 
     static std::string UpdateTimeFromMinuteKey(const std::string& minute_key) {
@@ -1805,6 +1697,8 @@ struct BacktestCliResult {
     bool sub_strategy_indicator_trace_enabled{false};
     std::string sub_strategy_indicator_trace_path;
     std::int64_t sub_strategy_indicator_trace_rows{0};
+    // "hit" or "stored" when the replay used `spec.bar_cache_dir`; empty otherwise.
+    std::string bar_cache_status;
     ReplayReport replay;
     bool has_deterministic{false};
     DeterministicReplayReport deterministic;
@@ -2171,6 +2065,21 @@ inline bool ParseBacktestCliSpec(const ArgMap& args, BacktestCliSpec* out, std::
             }
         }
     }
+    {
+        const std::string raw =
+            detail::GetArgAny(args, {"product_parallelism", "product-parallelism"}, "0");
+        std::int64_t parsed = 0;
+        if (!detail::ParseInt64(raw, &parsed) || parsed < 0) {
+            if (error != nullptr) {
+                *error = "invalid product_parallelism: " + raw;
+            }
+            return false;
+        }
+        spec.product_parallelism = parsed;
+        spec.product_sync_granularity = detail::ToLower(detail::GetArgAny(
+            args, {"product_sync_granularity", "product-sync-granularity"}, "bar"));
+    }
+    spec.bar_cache_dir = detail::GetArgAny(args, {"bar_cache_dir", "bar-cache-dir"}, "");
     {
         const std::string raw_initial =
             detail::GetArgAny(args, {"initial_equity", "initial-equity"}, "1000000");
@@ -2439,6 +2348,13 @@ inline bool ParseBacktestCliSpec(const ArgMap& args, BacktestCliSpec* out, std::
         }
         return false;
     }
+    if (spec.product_sync_granularity != "tick" && spec.product_sync_granularity != "bar" &&
+        spec.product_sync_granularity != "day") {
+        if (error != nullptr) {
+            *error = "unsupported product_sync_granularity: " + spec.product_sync_granularity;
+        }
+        return false;
+    }
     if (!(spec.initial_equity > 0.0)) {
         if (error != nullptr) {
             *error = "initial_equity must be > 0";
@@ -2658,9 +2574,43 @@ inline std::string BuildInputSignature(const BacktestCliSpec& spec) {
         << "emit_orders=" << (spec.emit_orders ? "true" : "false") << ';'
         << "emit_position_history=" << (spec.emit_position_history ? "true" : "false") << ';'
         << "emit_per_variety_outputs=" << (spec.emit_per_variety_outputs ? "true" : "false") << ';';
+    if (spec.product_parallelism > 0) {
+        oss << "product_isolated=true;product_sync_granularity=" << spec.product_sync_granularity
+            << ';';
+    }
     return detail::StableDigest(oss.str());
 }
 
+namespace detail {
+
+// Everything that decides which ticks are replayed and how they fold into one-minute bars.
+// Strategy, detector and fill settings are deliberately absent: they act on the bars and can
+// change between runs that share one cache entry.
+inline std::string BuildReplayBarCacheKey(const BacktestCliSpec& spec,
+                                          const std::string& data_source,
+                                          const std::string& data_signature,
+                                          const std::string& sessions_signature,
+                                          std::int32_t allowed_lateness_ms,
+                                          std::size_t tick_count) {
+    std::ostringstream oss;
+    oss << "format=" << kReplayBarCacheFormat.version << ';' << "data_source=" << data_source
+        << ';' << "data_signature=" << data_signature << ';'
+        << "sessions_signature=" << sessions_signature << ';'
+        << "allowed_lateness_ms=" << allowed_lateness_ms << ';'
+        << "engine_mode=" << spec.engine_mode << ';'
+        << "dataset_manifest=" << spec.dataset_manifest << ';'
+        << "strict_parquet=" << (spec.strict_parquet ? "true" : "false") << ';' << "symbols=";
+    for (std::size_t index = 0; index < spec.symbols.size(); ++index) {
+        oss << (index > 0 ? "," : "") << spec.symbols[index];
+    }
+    oss << ';' << "start_date=" << spec.start_date << ';' << "end_date=" << spec.end_date << ';'
+        << "max_ticks=" << (spec.max_ticks.has_value() ? std::to_string(*spec.max_ticks) : "")
+        << ';' << "tick_count=" << tick_count << ';';
+    return StableDigest(oss.str());
+}
+
+}  // namespace detail
+
 inline std::string ComputeFileDigest(const std::filesystem::path& path, std::string* error) {
     std::ifstream input(path, std::ios::binary);
     if (!input.is_open()) {
@@ -2692,22 +2642,109 @@ inline std::string ComputeFileDigest(const std::filesystem::path& path, std::str
     return detail::HexDigest64(hash);
 }
 
-inline std::string ComputeDatasetDigest(const std::filesystem::path& root,
-                                        const std::string& start_date, const std::string& end_date,
-                                        std::string* error) {
-    if (!std::filesystem::exists(root)) {
+namespace detail {
+
+// Runs job(index) for every index below `count` on up to `parallelism` threads (0 picks the
+// hardware thread count). Jobs must only touch their own slot.
+template <typename Job>
+inline void RunParallelDigestJobs(std::size_t count, std::size_t parallelism, Job job) {
+    if (parallelism == 0) {
+        parallelism = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    const std::size_t worker_count = std::min(count, parallelism);
+    if (worker_count <= 1) {
+        for (std::size_t index = 0; index < count; ++index) {
+            job(index);
+        }
+        return;
+    }
+    std::atomic<std::size_t> next_job{0};
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (std::size_t worker = 0; worker < worker_count; ++worker) {
+        workers.emplace_back([&]() {
+            for (std::size_t index = next_job++; index < count; index = next_job++) {
+                job(index);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// The mtime is only compared with the one recorded in the digest index, so it stays in
+// file_time_type ticks rather than being converted to the Unix epoch.
+inline bool StatDigestFile(const std::filesystem::path& path, DatasetDigestIndex::Entry* out) {
+    std::error_code ec;
+    const std::filesystem::directory_entry entry(path, ec);
+    if (ec || !entry.is_regular_file(ec)) {
+        return false;
+    }
+    const std::uintmax_t size = entry.file_size(ec);
+    if (ec) {
+        return false;
+    }
+    const std::filesystem::file_time_type mtime = entry.last_write_time(ec);
+    if (ec) {
+        return false;
+    }
+    out->size = static_cast<std::uint64_t>(size);
+    out->mtime_ns = static_cast<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count());
+    return true;
+}
+
+inline bool BuildDateRange(const std::string& start_date, const std::string& end_date,
+                           Timestamp* out_start, Timestamp* out_end, std::string* error) {
+    try {
+        if (start_date.empty()) {
+            *out_start = Timestamp(0);
+        } else {
+            const std::string text = start_date.substr(0, 4) + "-" + start_date.substr(4, 2) +
+                                     "-" + start_date.substr(6, 2) + " 00:00:00";
+            *out_start = Timestamp::FromSql(text);
+        }
+
+        if (end_date.empty()) {
+            *out_end = Timestamp(4'102'444'799LL * kNanosPerSecond);
+        } else {
+            const std::string text = end_date.substr(0, 4) + "-" + end_date.substr(4, 2) + "-" +
+                                     end_date.substr(6, 2) + " 23:59:59";
+            *out_end = Timestamp::FromSql(text);
+        }
+    } catch (const std::exception& ex) {
         if (error != nullptr) {
-            *error = "dataset root does not exist: " + root.string();
+            *error = ex.what();
         }
-        return "";
+        return false;
+    }
+    return true;
+}
+
+inline std::filesystem::path ResolveDatasetManifestPath(const std::filesystem::path& root,
+                                                        const std::string& dataset_manifest) {
+    std::filesystem::path manifest_path(dataset_manifest);
+    if (manifest_path.empty()) {
+        return root / "_manifest" / "partitions.jsonl";
     }
+    if (manifest_path.is_relative() && !std::filesystem::exists(manifest_path)) {
+        return root / manifest_path;
+    }
+    return manifest_path;
+}
 
+// Digest of a dataset root without a manifest: size and mtime of every data file found by
+// walking the tree.
+inline std::string ComputeDatasetWalkDigest(const std::filesystem::path& root,
+                                            const std::string& start_date,
+                                            const std::string& end_date) {
     std::vector<std::filesystem::path> files;
     for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
         if (!entry.is_regular_file()) {
             continue;
         }
-        const std::string ext = detail::ToLower(entry.path().extension().string());
+        const std::string ext = ToLower(entry.path().extension().string());
         if (ext == ".parquet" || ext == ".csv") {
             files.push_back(entry.path());
         }
@@ -2715,9 +2752,9 @@ inline std::string ComputeDatasetDigest(const std::filesystem::path& root,
     std::sort(files.begin(), files.end());
 
     std::uint64_t hash = 14695981039346656037ULL;
-    hash = detail::Fnv1a64(hash, root.string());
-    hash = detail::Fnv1a64(hash, start_date);
-    hash = detail::Fnv1a64(hash, end_date);
+    hash = Fnv1a64(hash, root.string());
+    hash = Fnv1a64(hash, start_date);
+    hash = Fnv1a64(hash, end_date);
 
     for (const auto& path : files) {
         const std::string relative = std::filesystem::relative(path, root).string();
@@ -2727,9 +2764,157 @@ inline std::string ComputeDatasetDigest(const std::filesystem::path& root,
         }
         const auto size = std::filesystem::file_size(path);
         const auto mtime = std::filesystem::last_write_time(path).time_since_epoch().count();
-        hash = detail::Fnv1a64(hash, relative);
-        hash = detail::Fnv1a64(hash, std::to_string(size));
-        hash = detail::Fnv1a64(hash, std::to_string(mtime));
+        hash = Fnv1a64(hash, relative);
+        hash = Fnv1a64(hash, std::to_string(size));
+        hash = Fnv1a64(hash, std::to_string(mtime));
+    }
+    return HexDigest64(hash);
+}
+
+}  // namespace detail
+
+// Content digests of `paths` in order, hashed on up to `parallelism` threads (0 picks the
+// hardware thread count). Each value equals ComputeFileDigest of that file.
+inline bool ComputeFileDigests(const std::vector<std::filesystem::path>& paths,
+                               std::size_t parallelism, std::vector<std::string>* out,
+                               std::string* error) {
+    if (out == nullptr) {
+        if (error != nullptr) {
+            *error = "file digest output is null";
+        }
+        return false;
+    }
+    out->assign(paths.size(), std::string{});
+    std::vector<std::string> errors(paths.size());
+    detail::RunParallelDigestJobs(paths.size(), parallelism, [&](std::size_t index) {
+        (*out)[index] = ComputeFileDigest(paths[index], &errors[index]);
+    });
+    for (std::size_t index = 0; index < paths.size(); ++index) {
+        if ((*out)[index].empty()) {
+            if (error != nullptr) {
+                *error = errors[index];
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+// ComputeFileDigest through a digest index: a file whose size and mtime match the record for
+// `key` is only stat'ed, otherwise it is rehashed and the record replaced.
+inline std::string ComputeIndexedFileDigest(const std::filesystem::path& path,
+                                            const std::string& key, DatasetDigestIndex* index,
+                                            std::string* error) {
+    DatasetDigestIndex::Entry entry;
+    if (index == nullptr || !detail::StatDigestFile(path, &entry)) {
+        return ComputeFileDigest(path, error);
+    }
+    if (const std::string* cached = index->FindDigest(key, entry.size, entry.mtime_ns)) {
+        return *cached;
+    }
+    entry.content_digest = ComputeFileDigest(path, error);
+    if (!entry.content_digest.empty()) {
+        index->Update(key, entry);
+    }
+    return entry.content_digest;
+}
+
+// Digest of the data a replay over [start_date, end_date] reads. With a partition manifest
+// only the partitions it lists for that range are considered, and each contributes its content
+// digest through the index under `_manifest/`, so unchanged partitions cost one stat and a
+// touched-but-identical file keeps the digest stable. Without a manifest the whole tree is
+// walked and size/mtime are digested.
+inline std::string ComputeDatasetDigest(const std::filesystem::path& root,
+                                        const std::string& start_date, const std::string& end_date,
+                                        std::string* error,
+                                        const std::string& dataset_manifest = std::string{},
+                                        std::size_t parallelism = 0) {
+    if (!std::filesystem::exists(root)) {
+        if (error != nullptr) {
+            *error = "dataset root does not exist: " + root.string();
+        }
+        return "";
+    }
+
+    const std::filesystem::path manifest_path =
+        detail::ResolveDatasetManifestPath(root, dataset_manifest);
+    if (!std::filesystem::exists(manifest_path)) {
+        if (error != nullptr) {
+            error->clear();
+        }
+        return detail::ComputeDatasetWalkDigest(root, start_date, end_date);
+    }
+
+    ParquetDataFeed feed(root.string());
+    if (!feed.LoadManifestJsonl(manifest_path.string(), error)) {
+        return "";
+    }
+    Timestamp start;
+    Timestamp end;
+    if (!detail::BuildDateRange(start_date, end_date, &start, &end, error)) {
+        return "";
+    }
+    std::vector<ParquetPartitionMeta> partitions =
+        feed.QueryPartitions(start.ToEpochNanos(), end.ToEpochNanos(), std::vector<std::string>{},
+                             std::string{});
+    std::sort(partitions.begin(), partitions.end(),
+              [](const ParquetPartitionMeta& left, const ParquetPartitionMeta& right) {
+                  return left.file_path < right.file_path;
+              });
+
+    DatasetDigestIndex index;
+    const std::filesystem::path index_path = DatasetDigestIndex::PathFor(root);
+    std::string index_error;
+    if (!index.Load(index_path, &index_error)) {
+        index = DatasetDigestIndex{};
+    }
+
+    std::vector<std::string> keys(partitions.size());
+    std::vector<DatasetDigestIndex::Entry> entries(partitions.size());
+    std::vector<std::uint8_t> present(partitions.size(), 0);
+    detail::RunParallelDigestJobs(partitions.size(), parallelism, [&](std::size_t slot) {
+        const std::filesystem::path path(partitions[slot].file_path);
+        keys[slot] = path.lexically_relative(root.lexically_normal()).generic_string();
+        if (keys[slot].empty() || keys[slot].rfind("..", 0) == 0) {
+            keys[slot] = path.generic_string();
+        }
+        present[slot] = detail::StatDigestFile(path, &entries[slot]) ? 1 : 0;
+        if (present[slot] != 0) {
+            if (const std::string* cached =
+                    index.FindDigest(keys[slot], entries[slot].size, entries[slot].mtime_ns)) {
+                entries[slot].content_digest = *cached;
+            }
+        }
+    });
+
+    std::vector<std::size_t> stale;
+    std::vector<std::filesystem::path> stale_paths;
+    for (std::size_t slot = 0; slot < partitions.size(); ++slot) {
+        if (present[slot] != 0 && entries[slot].content_digest.empty()) {
+            stale.push_back(slot);
+            stale_paths.emplace_back(partitions[slot].file_path);
+        }
+    }
+    std::vector<std::string> stale_digests;
+    if (!ComputeFileDigests(stale_paths, parallelism, &stale_digests, error)) {
+        return "";
+    }
+    for (std::size_t position = 0; position < stale.size(); ++position) {
+        const std::size_t slot = stale[position];
+        entries[slot].content_digest = stale_digests[position];
+        index.Update(keys[slot], entries[slot]);
+    }
+    if (index.dirty()) {
+        (void)index.Save(index_path, &index_error);
+    }
+
+    std::uint64_t hash = 14695981039346656037ULL;
+    hash = detail::Fnv1a64(hash, root.string());
+    hash = detail::Fnv1a64(hash, start_date);
+    hash = detail::Fnv1a64(hash, end_date);
+    for (std::size_t slot = 0; slot < partitions.size(); ++slot) {
+        hash = detail::Fnv1a64(hash, keys[slot]);
+        hash = detail::Fnv1a64(hash, present[slot] != 0 ? entries[slot].content_digest : "-");
     }
 
     if (error != nullptr) {
@@ -2934,31 +3119,7 @@ inline bool BuildTimestampRange(const BacktestCliSpec& spec, Timestamp* out_star
         return false;
     }
 
-    try {
-        if (spec.start_date.empty()) {
-            *out_start = Timestamp(0);
-        } else {
-            const std::string text = spec.start_date.substr(0, 4) + "-" +
-                                     spec.start_date.substr(4, 2) + "-" +
-                                     spec.start_date.substr(6, 2) + " 00:00:00";
-            *out_start = Timestamp::FromSql(text);
-        }
-
-        if (spec.end_date.empty()) {
-            *out_end = Timestamp(4'102'444'799LL * detail::kNanosPerSecond);
-        } else {
-            const std::string text = spec.end_date.substr(0, 4) + "-" + spec.end_date.substr(4, 2) +
-                                     "-" + spec.end_date.substr(6, 2) + " 23:59:59";
-            *out_end = Timestamp::FromSql(text);
-        }
-    } catch (const std::exception& ex) {
-        if (error != nullptr) {
-            *error = ex.what();
-        }
-        return false;
-    }
-
-    return true;
+    return detail::BuildDateRange(spec.start_date, spec.end_date, out_start, out_end, error);
 }
 
 inline bool ValidatePartitionMetaFile(const std::filesystem::path& meta_path, std::string* error) {
@@ -3213,14 +3374,8 @@ inline bool LoadParquetTicks(const BacktestCliSpec& spec, std::vector<ReplayTick
     }
 
     ParquetDataFeed feed(root.string());
-    std::filesystem::path manifest_path(spec.dataset_manifest);
-    if (manifest_path.empty()) {
-        manifest_path = root / "_manifest" / "partitions.jsonl";
-    } else if (manifest_path.is_relative()) {
-        if (!std::filesystem::exists(manifest_path)) {
-            manifest_path = root / manifest_path;
-        }
-    }
+    const std::filesystem::path manifest_path =
+        detail::ResolveDatasetManifestPath(root, spec.dataset_manifest);
 
     const bool manifest_exists = std::filesystem::exists(manifest_path);
     if (!manifest_exists && spec.strict_parquet) {
@@ -3891,39 +4046,124 @@ inline std::string BuildDefaultSubStrategyIndicatorTracePath(const std::string&
         .primary_path;
 }
 
-inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
-                            std::string* error) {
-    if (out == nullptr) {
-        if (error != nullptr) {
-            *error = "result output is null";
-        }
-        return false;
-    }
+namespace detail {
 
-    std::vector<ReplayTick> ticks;
-    std::string data_source;
-    ReplayReport replay;
-    if (!LoadTicksForSpec(spec, &ticks, &data_source, &replay, error)) {
-        return false;
-    }
+// Account equity observed by one replay. Product-parallel replays export these so the merged
+// account curve can be rebuilt at the configured synchronization granularity.
+struct ReplayEquitySample {
+    enum class Kind { kSeed, kTick, kBar };
 
-    std::string register_error;
-    if (!RegisterDemoLiveStrategy(&register_error)) {
-        if (error != nullptr) {
-            *error = "failed to register demo strategy: " + register_error;
-        }
-        return false;
+    Kind kind{Kind::kTick};
+    EpochNanos ts_ns{0};
+    std::string trading_day;
+    double equity{0.0};
+    double position_value{0.0};
+    double margin_used{0.0};
+    std::string market_regime;
+};
+
+struct ReplayRunHooks {
+    // When set, the replay appends its equity samples here. Samples are coalesced per trading
+    // day according to `sync_granularity`: "tick" keeps all, "bar" keeps bar closes plus the
+    // latest tick, "day" keeps only the latest sample.
+    std::vector<ReplayEquitySample>* equity_samples{nullptr};
+    std::string sync_granularity{"bar"};
+    bool compute_data_signature{true};
+    // Replays of a single product still close bars on the shared market clock. Entry i is the
+    // latest timestamp of other products seen just before ticks[i] (0 when none), and
+    // `final_clock_watermark_ns` is the clock after the product's last tick.
+    const std::vector<EpochNanos>* clock_watermarks_ns{nullptr};
+    EpochNanos final_clock_watermark_ns{0};
+};
+
+inline void AppendReplayEquitySample(const ReplayRunHooks& hooks, ReplayEquitySample sample) {
+    if (hooks.equity_samples == nullptr) {
+        return;
     }
-    if (!RegisterCompositeStrategy(&register_error)) {
-        if (error != nullptr) {
-            *error = "failed to register composite strategy: " + register_error;
+    std::vector<ReplayEquitySample>& samples = *hooks.equity_samples;
+    if (!samples.empty() && samples.back().trading_day == sample.trading_day &&
+        samples.back().kind != ReplayEquitySample::Kind::kSeed) {
+        ReplayEquitySample& last = samples.back();
+        const bool coalesce = hooks.sync_granularity == "day" ||
+                              (hooks.sync_granularity == "bar" &&
+                               sample.kind == ReplayEquitySample::Kind::kTick &&
+                               last.kind == ReplayEquitySample::Kind::kTick);
+        if (coalesce) {
+            if (sample.market_regime.empty()) {
+                sample.market_regime = std::move(last.market_regime);
+            }
+            last = std::move(sample);
+            return;
         }
-        return false;
     }
+    samples.push_back(std::move(sample));
+}
 
-    std::vector<BacktestStrategyConfig> strategy_configs;
-    if (!ResolveBacktestStrategyConfigs(spec, &strategy_configs, error)) {
-        return false;
+inline void PopulateBacktestAnalytics(const OnlineDailyMetrics& daily_metrics,
+                                      double initial_equity, BacktestCliResult* result) {
+    result->daily = daily_metrics.Finalize(result->trades, &result->rolling_metrics);
+    result->risk_metrics = ComputeRiskMetrics(result->daily);
+    result->execution_quality = ComputeExecutionQuality(result->orders, result->trades);
+    result->regime_performance = ComputeRegimePerformance(result->trades);
+    result->advanced_summary = ComputeAdvancedSummary(
+        result->daily, result->trades, result->risk_metrics, result->rolling_metrics);
+    result->monte_carlo = ComputeMonteCarloResult(result->daily, initial_equity);
+    result->factor_exposure = ComputeFactorExposure(result->daily);
+}
+
+inline void SummarizeEquityPoints(const std::vector<double>& equity_points,
+                                  BacktestPerformanceSummary* performance) {
+    double max_equity = 0.0;
+    double min_equity = 0.0;
+    double max_drawdown = 0.0;
+    if (!equity_points.empty()) {
+        max_equity = equity_points.front();
+        min_equity = equity_points.front();
+        double running_peak = equity_points.front();
+        for (double equity : equity_points) {
+            max_equity = std::max(max_equity, equity);
+            min_equity = std::min(min_equity, equity);
+            running_peak = std::max(running_peak, equity);
+            max_drawdown = std::max(max_drawdown, running_peak - equity);
+        }
+    }
+    performance->max_equity = max_equity;
+    performance->min_equity = min_equity;
+    performance->max_drawdown = max_drawdown;
+}
+
+}  // namespace detail
+
+// Replays already loaded ticks through the strategies and simulated account. `replay` carries
+// the scan counters of the load.
+inline bool ReplayBacktestTicks(const BacktestCliSpec& spec, const std::vector<ReplayTick>& ticks,
+                                const std::string& data_source, ReplayReport replay,
+                                const detail::ReplayRunHooks& hooks, BacktestCliResult* out,
+                                std::string* error) {
+    if (out == nullptr) {
+        if (error != nullptr) {
+            *error = "result output is null";
+        }
+        return false;
+    }
+
+    std::string register_error;
+    if (!RegisterDemoLiveStrategy(&register_error)) {
+        if (error != nullptr) {
+            *error = "failed to register demo strategy: " + register_error;
+        }
+        return false;
+    }
+    if (!RegisterCompositeStrategy(&register_error)) {
+        if (error != nullptr) {
+            *error = "failed to register composite strategy: " + register_error;
+        }
+        return false;
+    }
+
+    std::vector<BacktestStrategyConfig> strategy_configs;
+    if (!ResolveBacktestStrategyConfigs(spec, &strategy_configs, error)) {
+        return false;
     }
 
     struct BacktestStrategyRuntime {
@@ -4016,8 +4256,7 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
     std::map<std::string, std::int64_t> instrument_bars;
     std::map<std::string, std::int64_t> order_status_counts;
     std::vector<double> equity_points;
-    std::vector<EquitySample> equity_history;
-    std::map<std::string, EquitySample> latest_daily_equity_samples;
+    OnlineDailyMetrics online_daily_metrics(spec.initial_equity, 63);
     std::vector<TradeRecord> trades;
     std::vector<OrderRecord> orders;
     std::vector<PositionSnapshot> position_history;
@@ -4043,8 +4282,11 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
             seed.equity = spec.initial_equity;
             seed.position_value = 0.0;
             seed.market_regime = "kUnknown";
-            equity_history.push_back(std::move(seed));
-            latest_daily_equity_samples[equity_history.back().trading_day] = equity_history.back();
+            online_daily_metrics.UpsertEquitySample(seed);
+            detail::AppendReplayEquitySample(
+                hooks, detail::ReplayEquitySample{detail::ReplayEquitySample::Kind::kSeed,
+                                                  seed.ts_ns, seed.trading_day, seed.equity, 0.0,
+                                                  0.0, seed.market_regime});
         }
     }
 
@@ -4270,8 +4512,11 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
         spec.indicator_trace_path, BuildDefaultIndicatorTraceBasePath(spec.run_id),
         spec.trace_output_format);
     std::string indicator_trace_path = indicator_trace_paths.primary_path;
+    // Trace row groups are encoded beside the replay thread instead of stalling it.
+    TraceParquetWriterOptions trace_parquet_options;
+    trace_parquet_options.background_encoding = true;
     IndicatorTraceCsvWriter indicator_trace_csv_writer;
-    IndicatorTraceParquetWriter indicator_trace_parquet_writer;
+    IndicatorTraceParquetWriter indicator_trace_parquet_writer(trace_parquet_options);
     const bool emit_indicator_trace_csv =
         spec.emit_indicator_trace && detail::TraceOutputWritesCsv(spec.trace_output_format);
     const bool emit_indicator_trace_parquet =
@@ -4291,7 +4536,8 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
                                         spec.trace_output_format);
     std::string sub_strategy_indicator_trace_path = sub_strategy_indicator_trace_paths.primary_path;
     SubStrategyIndicatorTraceCsvWriter sub_strategy_indicator_trace_csv_writer;
-    SubStrategyIndicatorTraceParquetWriter sub_strategy_indicator_trace_parquet_writer;
+    SubStrategyIndicatorTraceParquetWriter sub_strategy_indicator_trace_parquet_writer(
+        trace_parquet_options);
     const bool emit_sub_strategy_indicator_trace_csv =
         spec.emit_sub_strategy_indicator_trace &&
         detail::TraceOutputWritesCsv(spec.trace_output_format);
@@ -4320,8 +4566,8 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
     const bool use_bar_aggregator = data_source == "csv" || data_source == "parquet";
     std::optional<BarAggregatorConfig> replay_bar_aggregator_config;
     std::unique_ptr<BarAggregator> replay_bar_aggregator;
+    std::string trading_sessions_config_path;
     if (use_bar_aggregator) {
-        std::string trading_sessions_config_path;
         if (!detail::ResolveTradingSessionsConfigPathForParquetBacktest(
                 &trading_sessions_config_path, error)) {
             return false;
@@ -4335,6 +4581,44 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
         replay_bar_aggregator_config = aggregator_config;
         replay_bar_aggregator = std::make_unique<BarAggregator>(aggregator_config);
     }
+    // One-minute bars depend only on the tick stream and the session config. A cache hit replays
+    // them at their recorded emission points and skips the aggregator; a miss records them.
+    const bool use_bar_cache = !spec.bar_cache_dir.empty() && use_bar_aggregator &&
+                               !expiry_close_mode && hooks.clock_watermarks_ns == nullptr;
+    std::string data_signature;
+    ReplayBarCache bar_cache;
+    bool replay_cached_bars = false;
+    if (use_bar_cache) {
+        data_signature =
+            data_source == "csv"
+                ? ComputeFileDigest(spec.csv_path, error)
+                : ComputeDatasetDigest(spec.dataset_root, spec.start_date, spec.end_date, error,
+                                       spec.dataset_manifest);
+        if (data_signature.empty()) {
+            return false;
+        }
+        std::string cache_error;
+        const std::string bar_cache_key = detail::BuildReplayBarCacheKey(
+            spec, data_source, data_signature,
+            ComputeFileDigest(trading_sessions_config_path, &cache_error),
+            replay_bar_aggregator_config->allowed_lateness_ms, ticks.size());
+        replay_cached_bars = LoadReplayBarCache(ReplayBarCachePath(spec.bar_cache_dir,
+                                                                   bar_cache_key),
+                                                bar_cache_key, &bar_cache, &cache_error) &&
+                             bar_cache.tick_count == ticks.size();
+        if (!replay_cached_bars) {
+            bar_cache = ReplayBarCache{};
+            bar_cache.key = bar_cache_key;
+            bar_cache.tick_count = ticks.size();
+            bar_cache.filtered_ticks.assign(ticks.size(), 0);
+        }
+    }
+    const bool record_bar_cache = use_bar_cache && !replay_cached_bars;
+    std::size_t bar_emit_tick_index = 0;
+    ReplayBarEmitPoint bar_emit_point = ReplayBarEmitPoint::kTick;
+    std::size_t next_cached_bar = 0;
+    std::string bar_cache_status;
+
     detail::ReplayTimeframeFanout timeframe_fanout(subscribed_timeframes);
     ProductSeriesAdjuster product_series_adjuster(enable_product_series_adjustment);
     std::unordered_map<std::string, EpochNanos> instrument_last_tick_ts_ns;
@@ -4373,27 +4657,23 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
     auto upsert_latest_daily_equity_sample = [&](EpochNanos ts_ns, const std::string& trading_day,
                                                  double equity, double position_value,
                                                  const std::string& market_regime) {
-        std::string normalized_day = detail::NormalizeTradingDay(trading_day);
-        if (normalized_day.empty()) {
-            normalized_day = detail::TradingDayFromEpochNs(ts_ns);
-        }
-        if (normalized_day.empty()) {
-            return;
-        }
-
-        EquitySample& latest_sample = latest_daily_equity_samples[normalized_day];
-        if (!latest_sample.trading_day.empty() && ts_ns < latest_sample.ts_ns) {
-            return;
-        }
-
-        latest_sample.ts_ns = ts_ns;
-        latest_sample.trading_day = normalized_day;
-        latest_sample.equity = equity;
-        latest_sample.position_value = position_value;
-        if (!market_regime.empty()) {
-            latest_sample.market_regime = market_regime;
-        } else if (latest_sample.market_regime.empty()) {
-            latest_sample.market_regime = "kUnknown";
+        EquitySample sample;
+        sample.ts_ns = ts_ns;
+        sample.trading_day = trading_day;
+        sample.equity = equity;
+        sample.position_value = position_value;
+        sample.market_regime = market_regime;
+        online_daily_metrics.UpsertEquitySample(sample);
+        if (hooks.equity_samples != nullptr) {
+            std::string normalized_day = detail::NormalizeTradingDay(trading_day);
+            if (normalized_day.empty()) {
+                normalized_day = detail::TradingDayFromEpochNs(ts_ns);
+            }
+            detail::AppendReplayEquitySample(
+                hooks, detail::ReplayEquitySample{detail::ReplayEquitySample::Kind::kTick, ts_ns,
+                                                  std::move(normalized_day), equity,
+                                                  position_value, used_margin_total,
+                                                  market_regime});
         }
     };
 
@@ -4818,7 +5098,7 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
         if (!tick.exchange_id.empty()) {
             return tick.exchange_id;
         }
-        return detail::SharedSessionResolver().InferExchangeId(tick.instrument_id);
+        return detail::SharedSessionCalendar().InferExchangeId(tick.instrument_id);
     };
 
     auto signal_timing_from_tick = [&](const ReplayTick& tick) {
@@ -5511,19 +5791,18 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
             sample.equity = current_equity;
             sample.position_value = compute_position_value();
             sample.market_regime = MarketRegimeToString(state.market_regime);
-            upsert_latest_daily_equity_sample(sample.ts_ns, sample.trading_day, sample.equity,
-                                              sample.position_value, sample.market_regime);
-            equity_history.push_back(std::move(sample));
+            detail::AppendReplayEquitySample(
+                hooks, detail::ReplayEquitySample{detail::ReplayEquitySample::Kind::kBar,
+                                                  sample.ts_ns, sample.trading_day, sample.equity,
+                                                  sample.position_value, used_margin_total,
+                                                  sample.market_regime});
+            online_daily_metrics.UpsertEquitySample(sample);
         }
         return true;
     };
 
-    auto process_one_minute_bar = [&](const BarSnapshot& bar) -> bool {
-        detail::ReplayBarTickContext context;
-        if (!detail::ConsumeReplayBarTickContext(bar, &replay_bar_contexts, &context, error)) {
-            return false;
-        }
-
+    auto process_one_minute_bar_in_context =
+        [&](const BarSnapshot& bar, const detail::ReplayBarTickContext& context) -> bool {
         const BarSnapshot adjusted_bar = product_series_adjuster.Apply(bar);
         const std::vector<detail::ReplayAggregatedBar> aggregated_bars =
             timeframe_fanout.OnOneMinuteBar(adjusted_bar, context);
@@ -5544,6 +5823,47 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
         return true;
     };
 
+    auto process_one_minute_bar = [&](const BarSnapshot& bar) -> bool {
+        detail::ReplayBarTickContext context;
+        if (!detail::ConsumeReplayBarTickContext(bar, &replay_bar_contexts, &context, error)) {
+            return false;
+        }
+        if (record_bar_cache) {
+            bar_cache.bars.push_back(CachedReplayBar{bar_emit_tick_index, bar_emit_point, bar,
+                                                     context.first_tick_index,
+                                                     context.last_tick_index});
+        }
+        return process_one_minute_bar_in_context(bar, context);
+    };
+
+    // Bar contexts carry ticks with the trading day normalized the same way the snapshot is.
+    auto replay_context_tick = [&](const ReplayTick& tick) {
+        ReplayTick context_tick = tick;
+        context_tick.trading_day = detail::NormalizeTradingDay(tick.trading_day);
+        if (context_tick.trading_day.empty()) {
+            context_tick.trading_day = detail::TradingDayFromEpochNs(tick.ts_ns);
+        }
+        return context_tick;
+    };
+
+    auto process_cached_bars = [&](std::size_t tick_index, ReplayBarEmitPoint point) -> bool {
+        while (next_cached_bar < bar_cache.bars.size() &&
+               bar_cache.bars[next_cached_bar].tick_index == tick_index &&
+               bar_cache.bars[next_cached_bar].emit_point == point) {
+            const CachedReplayBar& cached = bar_cache.bars[next_cached_bar++];
+            detail::ReplayBarTickContext context;
+            context.first_tick = replay_context_tick(ticks[cached.first_tick_index]);
+            context.last_tick = replay_context_tick(ticks[cached.last_tick_index]);
+            context.first_tick_index = cached.first_tick_index;
+            context.last_tick_index = cached.last_tick_index;
+            context.initialized = true;
+            if (!process_one_minute_bar_in_context(cached.bar, context)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
     if (!use_bar_aggregator || replay_bar_aggregator == nullptr) {
         if (error != nullptr) {
             *error = "replay bar aggregator is not initialized";
@@ -5551,7 +5871,26 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
         return false;
     }
 
-    for (const ReplayTick& tick : ticks) {
+    auto advance_market_clock = [&](EpochNanos now_ns) -> bool {
+        if (now_ns <= 0) {
+            return true;
+        }
+        const std::vector<BarSnapshot> finished_bars =
+            replay_bar_aggregator->FlushFinished(instrument_last_tick_ts_ns, now_ns);
+        for (const BarSnapshot& bar : finished_bars) {
+            if (!process_one_minute_bar(bar)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    for (std::size_t tick_index = 0; tick_index < ticks.size(); ++tick_index) {
+        const ReplayTick& tick = ticks[tick_index];
+        if (hooks.clock_watermarks_ns != nullptr &&
+            !advance_market_clock((*hooks.clock_watermarks_ns)[tick_index])) {
+            return false;
+        }
         if (replay.ticks_read == 0) {
             replay.first_instrument = tick.instrument_id;
             replay.first_ts_ns = tick.ts_ns;
@@ -5583,7 +5922,21 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
         snapshot.exchange_ts_ns = tick.ts_ns;
         snapshot.recv_ts_ns = tick.ts_ns;
 
-        if (!replay_bar_aggregator->ShouldProcessSnapshot(snapshot)) {
+        bar_emit_tick_index = tick_index;
+        const bool session_filtered = replay_cached_bars
+                                          ? bar_cache.filtered_ticks[tick_index] != 0
+                                          : !replay_bar_aggregator->ShouldProcessSnapshot(snapshot);
+        if (session_filtered) {
+            if (replay_cached_bars) {
+                if (!process_cached_bars(tick_index, ReplayBarEmitPoint::kFilteredTick)) {
+                    return false;
+                }
+                continue;
+            }
+            if (record_bar_cache) {
+                bar_cache.filtered_ticks[tick_index] = 1;
+            }
+            bar_emit_point = ReplayBarEmitPoint::kFilteredTick;
             const std::vector<BarSnapshot> emitted_bars =
                 replay_bar_aggregator->OnMarketSnapshot(snapshot);
             for (const BarSnapshot& bar : emitted_bars) {
@@ -5689,26 +6042,36 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
             }
         }
 
-        const std::vector<BarSnapshot> emitted_bars =
-            replay_bar_aggregator->OnMarketSnapshot(snapshot);
-        for (const BarSnapshot& bar : emitted_bars) {
-            if (!process_one_minute_bar(bar)) {
+        if (replay_cached_bars) {
+            if (!process_cached_bars(tick_index, ReplayBarEmitPoint::kTick) ||
+                !process_cached_bars(tick_index, ReplayBarEmitPoint::kFlushFinished)) {
                 return false;
             }
-        }
-
-        ReplayTick context_tick = tick;
-        context_tick.trading_day = snapshot.trading_day;
-        if (!detail::TrackReplayBarTickContext(context_tick, &replay_bar_contexts, error)) {
-            return false;
-        }
+        } else {
+            bar_emit_point = ReplayBarEmitPoint::kTick;
+            const std::vector<BarSnapshot> emitted_bars =
+                replay_bar_aggregator->OnMarketSnapshot(snapshot);
+            for (const BarSnapshot& bar : emitted_bars) {
+                if (!process_one_minute_bar(bar)) {
+                    return false;
+                }
+            }
 
-        const std::vector<BarSnapshot> finished_one_minute_bars =
-            replay_bar_aggregator->FlushFinished(instrument_last_tick_ts_ns, tick.ts_ns);
-        for (const BarSnapshot& bar : finished_one_minute_bars) {
-            if (!process_one_minute_bar(bar)) {
+            ReplayTick context_tick = tick;
+            context_tick.trading_day = snapshot.trading_day;
+            if (!detail::TrackReplayBarTickContext(context_tick, &replay_bar_contexts, error,
+                                                   tick_index)) {
                 return false;
             }
+
+            bar_emit_point = ReplayBarEmitPoint::kFlushFinished;
+            const std::vector<BarSnapshot> finished_one_minute_bars =
+                replay_bar_aggregator->FlushFinished(instrument_last_tick_ts_ns, tick.ts_ns);
+            for (const BarSnapshot& bar : finished_one_minute_bars) {
+                if (!process_one_minute_bar(bar)) {
+                    return false;
+                }
+            }
         }
 
         if (spec.deterministic_fills) {
@@ -5716,19 +6079,38 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
         }
     }
 
-    std::vector<BarSnapshot> flush_bars = replay_bar_aggregator->Flush();
-    std::sort(flush_bars.begin(), flush_bars.end(),
-              [](const BarSnapshot& left, const BarSnapshot& right) {
-                  if (left.ts_ns != right.ts_ns) {
-                      return left.ts_ns < right.ts_ns;
-                  }
-                  return left.instrument_id < right.instrument_id;
-              });
-
-    for (const BarSnapshot& bar : flush_bars) {
-        if (!process_one_minute_bar(bar)) {
+    if (!advance_market_clock(hooks.final_clock_watermark_ns)) {
+        return false;
+    }
+    if (replay_cached_bars) {
+        if (!process_cached_bars(ticks.size(), ReplayBarEmitPoint::kEnd)) {
+            return false;
+        }
+        if (next_cached_bar != bar_cache.bars.size()) {
+            if (error != nullptr) {
+                *error = "bar cache replay stopped at bar " + std::to_string(next_cached_bar) +
+                         " of " + std::to_string(bar_cache.bars.size());
+            }
             return false;
         }
+        bar_cache_status = "hit";
+    } else {
+        std::vector<BarSnapshot> flush_bars = replay_bar_aggregator->Flush();
+        std::sort(flush_bars.begin(), flush_bars.end(),
+                  [](const BarSnapshot& left, const BarSnapshot& right) {
+                      if (left.ts_ns != right.ts_ns) {
+                          return left.ts_ns < right.ts_ns;
+                      }
+                      return left.instrument_id < right.instrument_id;
+                  });
+
+        bar_emit_tick_index = ticks.size();
+        bar_emit_point = ReplayBarEmitPoint::kEnd;
+        for (const BarSnapshot& bar : flush_bars) {
+            if (!process_one_minute_bar(bar)) {
+                return false;
+            }
+        }
     }
 
     const std::vector<detail::ReplayAggregatedBar> fanout_flush_bars = timeframe_fanout.Flush();
@@ -5802,14 +6184,28 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
             ? sub_strategy_indicator_trace_csv_writer.rows_written()
             : sub_strategy_indicator_trace_parquet_writer.rows_written();
 
-    if (data_source == "csv") {
-        result.data_signature = ComputeFileDigest(spec.csv_path, error);
-    } else {
-        result.data_signature =
-            ComputeDatasetDigest(spec.dataset_root, spec.start_date, spec.end_date, error);
+    if (record_bar_cache) {
+        // A cache that cannot be written only costs the next run its speedup.
+        std::string cache_error;
+        if (SaveReplayBarCache(ReplayBarCachePath(spec.bar_cache_dir, bar_cache.key), bar_cache,
+                               &cache_error)) {
+            bar_cache_status = "stored";
+        }
     }
-    if (result.data_signature.empty()) {
-        return false;
+    result.bar_cache_status = bar_cache_status;
+
+    if (!data_signature.empty()) {
+        result.data_signature = data_signature;
+    } else if (hooks.compute_data_signature) {
+        if (data_source == "csv") {
+            result.data_signature = ComputeFileDigest(spec.csv_path, error);
+        } else {
+            result.data_signature = ComputeDatasetDigest(
+                spec.dataset_root, spec.start_date, spec.end_date, error, spec.dataset_manifest);
+        }
+        if (result.data_signature.empty()) {
+            return false;
+        }
     }
 
     result.parameters.start_date = spec.start_date;
@@ -5828,23 +6224,7 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
     if (spec.emit_position_history) {
         result.position_history = position_history;
     }
-    std::vector<EquitySample> daily_equity_history;
-    if (!latest_daily_equity_samples.empty()) {
-        daily_equity_history.reserve(latest_daily_equity_samples.size());
-        for (const auto& [day, sample] : latest_daily_equity_samples) {
-            (void)day;
-            daily_equity_history.push_back(sample);
-        }
-    }
-    result.daily = ComputeDailyMetrics(daily_equity_history, result.trades, spec.initial_equity);
-    result.risk_metrics = ComputeRiskMetrics(result.daily);
-    result.execution_quality = ComputeExecutionQuality(result.orders, result.trades);
-    result.rolling_metrics = ComputeRollingMetrics(result.daily, 63);
-    result.regime_performance = ComputeRegimePerformance(result.trades);
-    result.advanced_summary =
-        ComputeAdvancedSummary(result.daily, result.trades, result.risk_metrics);
-    result.monte_carlo = ComputeMonteCarloResult(result.daily, spec.initial_equity);
-    result.factor_exposure = ComputeFactorExposure(result.daily);
+    detail::PopulateBacktestAnalytics(online_daily_metrics, spec.initial_equity, &result);
 
     if (!spec.deterministic_fills) {
         result.replay = replay;
@@ -5876,21 +6256,6 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
         total_unrealized_pnl += snapshot.unrealized_pnl;
     }
 
-    double max_equity = 0.0;
-    double min_equity = 0.0;
-    double max_drawdown = 0.0;
-    if (!equity_points.empty()) {
-        max_equity = equity_points.front();
-        min_equity = equity_points.front();
-        double running_peak = equity_points.front();
-        for (double equity : equity_points) {
-            max_equity = std::max(max_equity, equity);
-            min_equity = std::min(min_equity, equity);
-            running_peak = std::max(running_peak, equity);
-            max_drawdown = std::max(max_drawdown, running_peak - equity);
-        }
-    }
-
     DeterministicReplayReport deterministic;
     deterministic.replay = replay;
     deterministic.intents_processed = intents_processed;
@@ -5914,9 +6279,7 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
                         : 0.0;
     deterministic.performance.margin_clipped_orders = margin_clipped_orders;
     deterministic.performance.margin_rejected_orders = margin_rejected_orders;
-    deterministic.performance.max_equity = max_equity;
-    deterministic.performance.min_equity = min_equity;
-    deterministic.performance.max_drawdown = max_drawdown;
+    detail::SummarizeEquityPoints(equity_points, &deterministic.performance);
     deterministic.performance.order_status_counts = order_status_counts;
     deterministic.invariant_violations = ValidateInvariants(instrument_pnl);
     deterministic.rollover_events = rollover_events;
@@ -5933,6 +6296,578 @@ inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
     return true;
 }
 
+namespace detail {
+
+struct ProductReplayRun {
+    std::string product_id;
+    BacktestCliSpec spec;
+    std::vector<ReplayTick> ticks;
+    std::vector<EpochNanos> clock_watermarks_ns;
+    EpochNanos final_clock_watermark_ns{0};
+    std::vector<ReplayEquitySample> equity_samples;
+    BacktestCliResult result;
+    std::string error;
+    bool ok{false};
+};
+
+inline std::string ReplayProductKey(const std::string& instrument_or_product) {
+    return ToLower(InstrumentSymbolPrefix(instrument_or_product));
+}
+
+inline bool ValidateProductParallelSpec(const BacktestCliSpec& spec, std::string* error) {
+    std::string reason;
+    if (!spec.deterministic_fills) {
+        reason = "deterministic_fills";
+    } else if (!spec.wal_path.empty()) {
+        reason = "an empty wal_path";
+    } else if (spec.emit_indicator_trace || spec.emit_sub_strategy_indicator_trace) {
+        reason = "indicator traces to be disabled";
+    } else if (spec.product_sync_granularity != "tick" && spec.product_sync_granularity != "bar" &&
+               spec.product_sync_granularity != "day") {
+        reason = "product_sync_granularity tick, bar or day";
+    }
+    if (reason.empty()) {
+        return true;
+    }
+    if (error != nullptr) {
+        *error = "product_parallelism requires " + reason;
+    }
+    return false;
+}
+
+// Splits the loaded ticks into one replay per product. Every replayed product needs its own
+// strategy configs, since nothing else would trade it on an isolated account.
+inline bool BuildProductReplayRuns(const BacktestCliSpec& spec, std::vector<ReplayTick> ticks,
+                                   std::vector<ProductReplayRun>* runs, std::string* error) {
+    std::vector<BacktestStrategyConfig> strategy_configs;
+    if (!ResolveBacktestStrategyConfigs(spec, &strategy_configs, error)) {
+        return false;
+    }
+    std::map<std::string, std::vector<BacktestStrategyConfig>> configs_by_product;
+    for (const BacktestStrategyConfig& config : strategy_configs) {
+        const std::string product_id = ToLower(Trim(config.product_id));
+        if (product_id.empty()) {
+            if (error != nullptr) {
+                *error = "product_parallelism requires product_id on every strategy: " +
+                         config.strategy_id;
+            }
+            return false;
+        }
+        configs_by_product[product_id].push_back(config);
+    }
+
+    // Ticks are globally ordered, so the other products' clock between two ticks of one product
+    // is just the timestamp of the tick right before it, when that tick is foreign.
+    struct ProductTicks {
+        std::vector<ReplayTick> ticks;
+        std::vector<EpochNanos> clock_watermarks_ns;
+        EpochNanos final_clock_watermark_ns{0};
+    };
+    std::map<std::string, ProductTicks> ticks_by_product;
+    std::string previous_product;
+    EpochNanos previous_ts_ns = 0;
+    for (ReplayTick& tick : ticks) {
+        std::string product_id = ReplayProductKey(tick.instrument_id);
+        const EpochNanos ts_ns = tick.ts_ns;
+        ProductTicks& product = ticks_by_product[product_id];
+        product.clock_watermarks_ns.push_back(
+            !previous_product.empty() && previous_product != product_id ? previous_ts_ns : 0);
+        product.ticks.push_back(std::move(tick));
+        previous_product = std::move(product_id);
+        previous_ts_ns = ts_ns;
+    }
+    for (auto& [product_id, product] : ticks_by_product) {
+        if (product_id != previous_product) {
+            product.final_clock_watermark_ns = previous_ts_ns;
+        }
+    }
+
+    runs->clear();
+    for (auto& [product_id, product_ticks] : ticks_by_product) {
+        const auto configs_it = configs_by_product.find(product_id);
+        if (configs_it == configs_by_product.end()) {
+            if (error != nullptr) {
+                *error = "product_parallelism found no strategy for replayed product: " +
+                         product_id;
+            }
+            return false;
+        }
+        ProductReplayRun run;
+        run.product_id = product_id;
+        run.spec = spec;
+        run.spec.strategy_configs = configs_it->second;
+        run.spec.symbols.clear();
+        for (const std::string& symbol : spec.symbols) {
+            if (ReplayProductKey(symbol) == product_id) {
+                run.spec.symbols.push_back(symbol);
+            }
+        }
+        run.ticks = std::move(product_ticks.ticks);
+        run.clock_watermarks_ns = std::move(product_ticks.clock_watermarks_ns);
+        run.final_clock_watermark_ns = product_ticks.final_clock_watermark_ns;
+        runs->push_back(std::move(run));
+    }
+    return true;
+}
+
+// Merges per-product row streams in replay order: rows keep their order within a product and
+// are interleaved by (timestamp, symbol, product), which is the order the shared tick stream
+// would have produced them in.
+template <typename Row, typename TimestampFn>
+inline std::vector<std::pair<std::size_t, Row*>> InterleaveProductRows(
+    std::vector<std::vector<Row>*> per_product, TimestampFn timestamp_of) {
+    std::size_t total = 0;
+    for (const std::vector<Row>* rows : per_product) {
+        total += rows->size();
+    }
+    std::vector<std::pair<std::size_t, Row*>> merged;
+    merged.reserve(total);
+    std::vector<std::size_t> cursor(per_product.size(), 0);
+    while (merged.size() < total) {
+        std::size_t best = per_product.size();
+        for (std::size_t index = 0; index < per_product.size(); ++index) {
+            if (cursor[index] >= per_product[index]->size()) {
+                continue;
+            }
+            if (best == per_product.size()) {
+                best = index;
+                continue;
+            }
+            const Row& candidate = (*per_product[index])[cursor[index]];
+            const Row& current = (*per_product[best])[cursor[best]];
+            const EpochNanos candidate_ts = timestamp_of(candidate);
+            const EpochNanos current_ts = timestamp_of(current);
+            if (candidate_ts < current_ts ||
+                (candidate_ts == current_ts && candidate.symbol < current.symbol)) {
+                best = index;
+            }
+        }
+        merged.emplace_back(best, &(*per_product[best])[cursor[best]]);
+        ++cursor[best];
+    }
+    return merged;
+}
+
+template <typename Event>
+inline std::vector<Event> InterleaveByTimestamp(std::vector<std::vector<Event>*> per_product) {
+    std::vector<Event> merged;
+    for (std::vector<Event>* events : per_product) {
+        merged.insert(merged.end(), events->begin(), events->end());
+    }
+    std::stable_sort(merged.begin(), merged.end(), [](const Event& left, const Event& right) {
+        return left.ts_ns < right.ts_ns;
+    });
+    return merged;
+}
+
+// Renumbers order and trade ids so the merged run keeps one monotonic sequence per id family,
+// the same shape a single shared replay assigns.
+class MergedIdSequencer {
+   public:
+    std::string OrderId(std::size_t product_index, const std::string& id) {
+        const auto key = std::make_pair(product_index, id);
+        const auto it = order_ids_.find(key);
+        if (it != order_ids_.end()) {
+            return it->second;
+        }
+        std::string renamed = id;
+        if (id.rfind("rollover-order-", 0) == 0) {
+            renamed = "rollover-order-" + std::to_string(++order_seq_);
+        } else if (id.rfind("order-", 0) == 0) {
+            renamed = "order-" + std::to_string(++order_seq_);
+        }
+        order_ids_.emplace(key, renamed);
+        return renamed;
+    }
+
+    void RenumberTrade(std::size_t product_index, TradeRecord* trade) {
+        if (trade->trade_id.rfind("rollover-trade-", 0) == 0) {
+            const std::string seq = std::to_string(++trade_seq_);
+            trade->trade_id = "rollover-trade-" + seq;
+            if (trade->order_id.rfind("rollover-order-close-", 0) == 0) {
+                trade->order_id = "rollover-order-close-" + seq;
+            } else if (trade->order_id.rfind("rollover-order-open-", 0) == 0) {
+                trade->order_id = "rollover-order-open-" + seq;
+            }
+            return;
+        }
+        if (trade->trade_id.rfind("trade-", 0) == 0) {
+            trade->trade_id = "trade-" + std::to_string(++trade_seq_);
+        }
+        trade->order_id = OrderId(product_index, trade->order_id);
+    }
+
+   private:
+    std::map<std::pair<std::size_t, std::string>, std::string> order_ids_;
+    std::int64_t order_seq_{0};
+    std::int64_t trade_seq_{0};
+};
+
+inline bool MergeProductReplayRuns(const BacktestCliSpec& spec, const std::string& data_source,
+                                   const ReplayReport& load_report,
+                                   std::vector<ProductReplayRun>* runs, BacktestCliResult* out,
+                                   std::string* error) {
+    const std::size_t product_count = runs->size();
+    const BacktestCliResult& first = runs->front().result;
+
+    BacktestCliResult result;
+    result.run_id = first.run_id;
+    result.mode = first.mode;
+    result.data_source = data_source;
+    result.engine_mode = first.engine_mode;
+    result.rollover_mode = first.rollover_mode;
+    result.initial_equity = spec.initial_equity;
+    result.spec = first.spec;
+    result.spec.symbols = spec.symbols;
+    result.spec.strategy_configs = spec.strategy_configs;
+    BacktestCliSpec signature_spec = spec;
+    signature_spec.indicator_trace_path = first.spec.indicator_trace_path;
+    signature_spec.sub_strategy_indicator_trace_path = first.spec.sub_strategy_indicator_trace_path;
+    result.input_signature = BuildInputSignature(signature_spec);
+    result.indicator_trace_path = first.indicator_trace_path;
+    result.sub_strategy_indicator_trace_path = first.sub_strategy_indicator_trace_path;
+    result.parameters = first.parameters;
+    if (data_source == "csv") {
+        result.data_signature = ComputeFileDigest(spec.csv_path, error);
+    } else {
+        result.data_signature = ComputeDatasetDigest(spec.dataset_root, spec.start_date,
+                                                     spec.end_date, error, spec.dataset_manifest);
+    }
+    if (result.data_signature.empty()) {
+        return false;
+    }
+
+    std::vector<std::vector<OrderRecord>*> orders;
+    std::vector<std::vector<TradeRecord>*> trades;
+    std::vector<std::vector<PositionSnapshot>*> positions;
+    std::vector<std::vector<RolloverEvent>*> rollover_events;
+    std::vector<std::vector<RolloverAction>*> rollover_actions;
+    for (ProductReplayRun& run : *runs) {
+        orders.push_back(&run.result.orders);
+        trades.push_back(&run.result.trades);
+        positions.push_back(&run.result.position_history);
+        rollover_events.push_back(&run.result.deterministic.rollover_events);
+        rollover_actions.push_back(&run.result.deterministic.rollover_actions);
+    }
+
+    MergedIdSequencer ids;
+    std::int64_t order_record_seq = 0;
+    for (auto& [product_index, order] :
+         InterleaveProductRows(orders, [](const OrderRecord& row) { return row.created_at_ns; })) {
+        OrderRecord merged = std::move(*order);
+        merged.order_seq = ++order_record_seq;
+        const bool client_is_order = merged.client_order_id == merged.order_id;
+        merged.order_id = ids.OrderId(product_index, merged.order_id);
+        if (client_is_order) {
+            merged.client_order_id = merged.order_id;
+        }
+        result.orders.push_back(std::move(merged));
+    }
+    std::int64_t fill_record_seq = 0;
+    for (auto& [product_index, trade] :
+         InterleaveProductRows(trades, [](const TradeRecord& row) { return row.timestamp_ns; })) {
+        TradeRecord merged = std::move(*trade);
+        merged.fill_seq = ++fill_record_seq;
+        ids.RenumberTrade(product_index, &merged);
+        result.trades.push_back(std::move(merged));
+    }
+    for (auto& [product_index, snapshot] : InterleaveProductRows(
+             positions, [](const PositionSnapshot& row) { return row.timestamp_ns; })) {
+        (void)product_index;
+        result.position_history.push_back(std::move(*snapshot));
+    }
+
+    // Rebuild the account curve: each product contributes its latest sample at every sync point.
+    std::vector<double> product_equity(product_count, spec.initial_equity);
+    std::vector<double> product_position_value(product_count, 0.0);
+    std::vector<double> product_margin(product_count, 0.0);
+    std::vector<std::size_t> cursor(product_count, 0);
+    OnlineDailyMetrics daily_metrics(spec.initial_equity, 63);
+    std::vector<double> equity_points{spec.initial_equity};
+    double max_margin_used = 0.0;
+    const bool day_sync = spec.product_sync_granularity == "day";
+    for (;;) {
+        std::size_t next = product_count;
+        for (std::size_t index = 0; index < product_count; ++index) {
+            const auto& samples = (*runs)[index].equity_samples;
+            if (cursor[index] >= samples.size()) {
+                continue;
+            }
+            if (next == product_count ||
+                samples[cursor[index]].ts_ns < (*runs)[next].equity_samples[cursor[next]].ts_ns) {
+                next = index;
+            }
+        }
+        if (next == product_count) {
+            break;
+        }
+        const ReplayEquitySample& sample = (*runs)[next].equity_samples[cursor[next]++];
+        product_equity[next] = sample.equity;
+        product_position_value[next] = sample.position_value;
+        product_margin[next] = sample.margin_used;
+
+        EquitySample merged;
+        merged.ts_ns = sample.ts_ns;
+        merged.trading_day = sample.trading_day;
+        merged.equity = spec.initial_equity;
+        merged.position_value = 0.0;
+        double margin_used = 0.0;
+        for (std::size_t index = 0; index < product_count; ++index) {
+            merged.equity += product_equity[index] - spec.initial_equity;
+            merged.position_value += product_position_value[index];
+            margin_used += product_margin[index];
+        }
+        merged.market_regime = sample.market_regime;
+        daily_metrics.UpsertEquitySample(merged);
+        max_margin_used = std::max(max_margin_used, margin_used);
+        if (sample.kind == ReplayEquitySample::Kind::kBar ||
+            (day_sync && sample.kind != ReplayEquitySample::Kind::kSeed)) {
+            equity_points.push_back(merged.equity);
+        }
+    }
+
+    ReplayReport replay = load_report;
+    replay.ticks_read = 0;
+    replay.bars_emitted = 0;
+    replay.intents_emitted = 0;
+    std::set<std::string> instrument_universe;
+    DeterministicReplayReport deterministic;
+    BacktestPerformanceSummary& performance = deterministic.performance;
+    performance.initial_equity = spec.initial_equity;
+    performance.final_equity = spec.initial_equity;
+    for (ProductReplayRun& run : *runs) {
+        const ReplayReport& product_replay = run.result.replay;
+        replay.ticks_read += product_replay.ticks_read;
+        replay.bars_emitted += product_replay.bars_emitted;
+        replay.intents_emitted += product_replay.intents_emitted;
+        if (product_replay.ticks_read > 0 &&
+            (replay.first_instrument.empty() ||
+             std::make_pair(product_replay.first_ts_ns, product_replay.first_instrument) <
+                 std::make_pair(replay.first_ts_ns, replay.first_instrument))) {
+            replay.first_ts_ns = product_replay.first_ts_ns;
+            replay.first_instrument = product_replay.first_instrument;
+        }
+        if (product_replay.ticks_read > 0 &&
+            (replay.last_instrument.empty() ||
+             std::make_pair(product_replay.last_ts_ns, product_replay.last_instrument) >=
+                 std::make_pair(replay.last_ts_ns, replay.last_instrument))) {
+            replay.last_ts_ns = product_replay.last_ts_ns;
+            replay.last_instrument = product_replay.last_instrument;
+        }
+        instrument_universe.insert(product_replay.instrument_universe.begin(),
+                                   product_replay.instrument_universe.end());
+
+        const DeterministicReplayReport& product = run.result.deterministic;
+        deterministic.intents_processed += product.intents_processed;
+        deterministic.order_events_emitted += product.order_events_emitted;
+        deterministic.wal_records += product.wal_records;
+        deterministic.instrument_bars.insert(product.instrument_bars.begin(),
+                                             product.instrument_bars.end());
+        deterministic.instrument_pnl.insert(product.instrument_pnl.begin(),
+                                            product.instrument_pnl.end());
+        deterministic.total_realized_pnl += product.total_realized_pnl;
+        deterministic.total_unrealized_pnl += product.total_unrealized_pnl;
+        deterministic.rollover_slippage_cost += product.rollover_slippage_cost;
+        deterministic.rollover_canceled_orders += product.rollover_canceled_orders;
+
+        const BacktestPerformanceSummary& product_performance = product.performance;
+        performance.final_equity += product_performance.final_equity - spec.initial_equity;
+        performance.total_commission += product_performance.total_commission;
+        performance.final_margin_used += product_performance.final_margin_used;
+        performance.margin_clipped_orders += product_performance.margin_clipped_orders;
+        performance.margin_rejected_orders += product_performance.margin_rejected_orders;
+        max_margin_used = std::max(max_margin_used, product_performance.max_margin_used);
+        for (const auto& [status, count] : product_performance.order_status_counts) {
+            performance.order_status_counts[status] += count;
+        }
+    }
+    replay.instrument_count = static_cast<std::int64_t>(instrument_universe.size());
+    replay.instrument_universe.assign(instrument_universe.begin(), instrument_universe.end());
+
+    performance.total_realized_pnl = deterministic.total_realized_pnl;
+    performance.total_unrealized_pnl = deterministic.total_unrealized_pnl;
+    performance.total_pnl = deterministic.total_realized_pnl + deterministic.total_unrealized_pnl;
+    performance.total_pnl_after_cost = performance.total_pnl - performance.total_commission;
+    performance.max_margin_used = max_margin_used;
+    SummarizeEquityPoints(equity_points, &performance);
+    deterministic.invariant_violations = ValidateInvariants(deterministic.instrument_pnl);
+    deterministic.rollover_events = InterleaveByTimestamp(rollover_events);
+    deterministic.rollover_actions = InterleaveByTimestamp(rollover_actions);
+    deterministic.replay = replay;
+
+    PopulateBacktestAnalytics(daily_metrics, spec.initial_equity, &result);
+    result.replay = replay;
+    result.has_deterministic = true;
+    result.deterministic = std::move(deterministic);
+    result.final_equity = result.deterministic.performance.final_equity;
+    *out = std::move(result);
+    return true;
+}
+
+// Replays every product on its own isolated account, at most `spec.product_parallelism` at a
+// time, then merges them in a fixed product order so the result is independent of scheduling.
+inline bool RunProductParallelBacktest(const BacktestCliSpec& spec, std::vector<ReplayTick> ticks,
+                                       const std::string& data_source,
+                                       const ReplayReport& load_report, BacktestCliResult* out,
+                                       std::string* error) {
+    if (!ValidateProductParallelSpec(spec, error)) {
+        return false;
+    }
+    std::vector<ProductReplayRun> runs;
+    if (!BuildProductReplayRuns(spec, std::move(ticks), &runs, error)) {
+        return false;
+    }
+    if (runs.empty()) {
+        if (error != nullptr) {
+            *error = "product_parallelism found no ticks to replay";
+        }
+        return false;
+    }
+
+    auto replay_run = [&](ProductReplayRun* run) {
+        ReplayRunHooks hooks;
+        hooks.equity_samples = &run->equity_samples;
+        hooks.sync_granularity = spec.product_sync_granularity;
+        hooks.compute_data_signature = false;
+        hooks.clock_watermarks_ns = &run->clock_watermarks_ns;
+        hooks.final_clock_watermark_ns = run->final_clock_watermark_ns;
+        run->ok = ReplayBacktestTicks(run->spec, run->ticks, data_source, ReplayReport{}, hooks,
+                                      &run->result, &run->error);
+        std::vector<ReplayTick>().swap(run->ticks);
+        std::vector<EpochNanos>().swap(run->clock_watermarks_ns);
+    };
+    const std::size_t worker_count = std::min<std::size_t>(
+        runs.size(), static_cast<std::size_t>(std::max<std::int64_t>(1, spec.product_parallelism)));
+    if (worker_count <= 1) {
+        for (ProductReplayRun& run : runs) {
+            replay_run(&run);
+        }
+    } else {
+        std::atomic<std::size_t> next_run{0};
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count);
+        for (std::size_t worker = 0; worker < worker_count; ++worker) {
+            workers.emplace_back([&]() {
+                for (std::size_t index = next_run++; index < runs.size(); index = next_run++) {
+                    replay_run(&runs[index]);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    for (const ProductReplayRun& run : runs) {
+        if (!run.ok) {
+            if (error != nullptr) {
+                *error = "product " + run.product_id + ": " + run.error;
+            }
+            return false;
+        }
+    }
+    return MergeProductReplayRuns(spec, data_source, load_report, &runs, out, error);
+}
+
+}  // namespace detail
+
+inline bool RunBacktestSpec(const BacktestCliSpec& spec, BacktestCliResult* out,
+                            std::string* error) {
+    if (out == nullptr) {
+        if (error != nullptr) {
+            *error = "result output is null";
+        }
+        return false;
+    }
+
+    std::vector<ReplayTick> ticks;
+    std::string data_source;
+    ReplayReport replay;
+    if (!LoadTicksForSpec(spec, &ticks, &data_source, &replay, error)) {
+        return false;
+    }
+    if (spec.product_parallelism > 0) {
+        return detail::RunProductParallelBacktest(spec, std::move(ticks), data_source, replay, out,
+                                                  error);
+    }
+    return ReplayBacktestTicks(spec, ticks, data_source, replay, detail::ReplayRunHooks{}, out,
+                               error);
+}
+
+// Ticks loaded for one data selection, replayable by every spec that selects the same data.
+struct LoadedReplayDataset {
+    std::vector<ReplayTick> ticks;
+    std::string data_source;
+    ReplayReport report;
+};
+
+// The spec fields LoadTicksForSpec reads; specs with equal keys load identical ticks.
+inline std::string BuildReplayDataSelectionKey(const BacktestCliSpec& spec) {
+    std::ostringstream oss;
+    oss << "engine_mode=" << spec.engine_mode << ';' << "csv_path=" << spec.csv_path << ';'
+        << "dataset_root=" << spec.dataset_root << ';'
+        << "dataset_manifest=" << spec.dataset_manifest << ';' << "symbols=";
+    for (std::size_t index = 0; index < spec.symbols.size(); ++index) {
+        oss << (index > 0 ? "," : "") << spec.symbols[index];
+    }
+    oss << ';' << "start_date=" << spec.start_date << ';' << "end_date=" << spec.end_date << ';'
+        << "max_ticks=" << (spec.max_ticks.has_value() ? std::to_string(*spec.max_ticks) : "")
+        << ';' << "strict_parquet=" << (spec.strict_parquet ? "true" : "false") << ';'
+        << "streaming=" << (spec.streaming ? "true" : "false") << ';';
+    return oss.str();
+}
+
+// RunBacktestSpec over ticks loaded earlier; `dataset` is only read, so concurrent runs may
+// share it.
+inline bool RunBacktestSpecOnDataset(const BacktestCliSpec& spec,
+                                     const LoadedReplayDataset& dataset, BacktestCliResult* out,
+                                     std::string* error) {
+    if (out == nullptr) {
+        if (error != nullptr) {
+            *error = "result output is null";
+        }
+        return false;
+    }
+    if (spec.product_parallelism > 0) {
+        return detail::RunProductParallelBacktest(spec, dataset.ticks, dataset.data_source,
+                                                  dataset.report, out, error);
+    }
+    return ReplayBacktestTicks(spec, dataset.ticks, dataset.data_source, dataset.report,
+                               detail::ReplayRunHooks{}, out, error);
+}
+
+// Loads each distinct data selection once for a batch of backtests over the same window
+// (e.g. validation candidates) and hands out shared read-only datasets. Thread-safe; a caller
+// asking for a selection that is still loading waits for it.
+class ReplayDatasetCache {
+   public:
+    std::shared_ptr<const LoadedReplayDataset> Get(const BacktestCliSpec& spec,
+                                                   std::string* error) {
+        const std::string key = BuildReplayDataSelectionKey(spec);
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = datasets_.find(key);
+        if (it != datasets_.end()) {
+            return it->second;
+        }
+        auto dataset = std::make_shared<LoadedReplayDataset>();
+        if (!LoadTicksForSpec(spec, &dataset->ticks, &dataset->data_source, &dataset->report,
+                              error)) {
+            return nullptr;
+        }
+        datasets_.emplace(key, dataset);
+        return dataset;
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return datasets_.size();
+    }
+
+   private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<const LoadedReplayDataset>> datasets_;
+};
+
 inline BacktestSummary SummarizeBacktest(const BacktestCliResult& result) {
     BacktestSummary summary;
     summary.intents_emitted = result.replay.intents_emitted;
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "quant_hft/core/binary_section_file.h"
+
+namespace quant_hft::apps {
+
+// Size, mtime and content digest of files under one dataset root, persisted next to the
+// partition manifest. A recorded digest is reused while the file keeps its size and mtime, so
+// repeated digests of a large archive only stat the files and rehash the ones that changed.
+class DatasetDigestIndex {
+   public:
+    struct Entry {
+        std::uint64_t size{0};
+        std::int64_t mtime_ns{0};
+        std::string content_digest;
+    };
+
+    static std::filesystem::path PathFor(const std::filesystem::path& dataset_root) {
+        return dataset_root / "_manifest" / "digest_index.tsv";
+    }
+
+    // A missing file loads as an empty index. Malformed lines are dropped so a damaged index
+    // only costs rehashing.
+    bool Load(const std::filesystem::path& path, std::string* error) {
+        entries_.clear();
+        dirty_ = false;
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec)) {
+            return true;
+        }
+        std::ifstream input(path);
+        if (!input.is_open()) {
+            if (error != nullptr) {
+                *error = "unable to open dataset digest index: " + path.string();
+            }
+            return false;
+        }
+        std::string line;
+        if (!std::getline(input, line) || line != kHeader) {
+            dirty_ = true;
+            return true;
+        }
+        while (std::getline(input, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            std::string size;
+            std::string mtime;
+            Entry entry;
+            if (!std::getline(fields, key, '\t') || !std::getline(fields, size, '\t') ||
+                !std::getline(fields, mtime, '\t') ||
+                !std::getline(fields, entry.content_digest) || key.empty()) {
+                dirty_ = true;
+                continue;
+            }
+            try {
+                entry.size = std::stoull(size);
+                entry.mtime_ns = std::stoll(mtime);
+            } catch (...) {
+                dirty_ = true;
+                continue;
+            }
+            entries_[key] = std::move(entry);
+        }
+        return true;
+    }
+
+    // Published through WriteFileAtomically, so concurrent runs sharing a dataset never observe
+    // a torn index; the last writer wins.
+    bool Save(const std::filesystem::path& path, std::string* error) {
+        std::vector<const std::pair<const std::string, Entry>*> rows;
+        rows.reserve(entries_.size());
+        for (const auto& row : entries_) {
+            rows.push_back(&row);
+        }
+        std::sort(rows.begin(), rows.end(),
+                  [](const auto* left, const auto* right) { return left->first < right->first; });
+
+        std::ostringstream output;
+        output << kHeader << '\n';
+        for (const auto* row : rows) {
+            output << row->first << '\t' << row->second.size << '\t' << row->second.mtime_ns
+                   << '\t' << row->second.content_digest << '\n';
+        }
+        if (!WriteFileAtomically(path.string(), output.str(), "dataset digest index", error)) {
+            return false;
+        }
+        dirty_ = false;
+        return true;
+    }
+
+    // The recorded digest for `key` if the file still has the given size and mtime.
+    const std::string* FindDigest(const std::string& key, std::uint64_t size,
+                                  std::int64_t mtime_ns) const {
+        const auto it = entries_.find(key);
+        if (it == entries_.end() || it->second.size != size || it->second.mtime_ns != mtime_ns ||
+            it->second.content_digest.empty()) {
+            return nullptr;
+        }
+        return &it->second.content_digest;
+    }
+
+    void Update(const std::string& key, Entry entry) {
+        entries_[key] = std::move(entry);
+        dirty_ = true;
+    }
+
+    bool dirty() const { return dirty_; }
+    std::size_t size() const { return entries_.size(); }
+
+   private:
+    // v2: mtimes are std::filesystem::file_time_type ticks; a v1 index loads as empty.
+    static constexpr const char* kHeader = "# quant_hft dataset digest index v2";
+
+    std::unordered_map<std::string, Entry> entries_;
+    bool dirty_{false};
+};
+
+}  // namespace quant_hft::apps
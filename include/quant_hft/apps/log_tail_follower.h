@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace quant_hft::apps {
+
+// Follows one append-only text file across polls. The follower remembers the file identity
+// (device + inode) and the byte offset already consumed, so each poll reads only the complete
+// lines appended since the previous one. A trailing line without '\n' is held back until it is
+// finished.
+class LogTailFollower {
+   public:
+    struct PollResult {
+        bool exists{false};
+        // Set when lines returned by earlier polls no longer describe the file: it vanished,
+        // the path changed, the file was replaced (rotation) or it shrank (truncation).
+        // `lines` then holds the file from the beginning.
+        bool reset{false};
+        std::vector<std::string> lines;
+    };
+
+    PollResult Poll(const std::string& path);
+    void Clear();
+
+    const std::string& path() const { return path_; }
+    std::uint64_t offset() const { return offset_; }
+    // Unterminated tail of the file as of the last poll; readers that treat end-of-file as a
+    // line end (like std::getline) fold it in provisionally.
+    const std::string& pending_line() const { return partial_line_; }
+
+   private:
+    std::string path_;
+    std::uint64_t device_{0};
+    std::uint64_t inode_{0};
+    std::uint64_t offset_{0};
+    std::string partial_line_;
+    bool opened_{false};
+};
+
+}  // namespace quant_hft::apps
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "quant_hft/contracts/types.h"
+#include "quant_hft/core/instrument_meta_cache.h"
+#include "quant_hft/core/structured_log.h"
+#include "quant_hft/services/compiled_session_calendar.h"
+
+namespace quant_hft {
+
+// Identity of a text file a startup bundle was compiled from.  A bundle section is only used
+// while its source still has the recorded size and modification time.
+struct StartupBundleSource {
+    std::string path;
+    bool exists{false};
+    std::uint64_t size_bytes{0};
+    std::int64_t mtime_ns{0};
+};
+
+struct StartupBundleInstrumentCache {
+    StartupBundleSource source;
+    InstrumentMetaCacheDocument document;
+};
+
+struct StartupBundleSessions {
+    // Resolved config path (TRADING_SESSIONS_CONFIG_PATH applied) and the rules LoadRules
+    // returned for it, defaults merged in when `use_default_fallback` is set.
+    StartupBundleSource source;
+    bool use_default_fallback{true};
+    CompiledSessionCalendar::RuleSet rules;
+};
+
+// Pre-parsed startup inputs of core_engine: the per-product instrument meta caches under
+// runtime/ctp_instruments and the trading session rules.  Produced by startup_bundle_cli and
+// loaded with a single mapped read; anything stale or missing falls back to the text files.
+struct StartupBundle {
+    EpochNanos generated_ts_ns{0};
+    std::vector<StartupBundleInstrumentCache> instrument_caches;
+    bool has_sessions{false};
+    StartupBundleSessions sessions;
+};
+
+bool StatStartupBundleSource(const std::string& path, StartupBundleSource* out,
+                             std::string* error = nullptr);
+// False with a reason when the file was created, removed or rewritten since it was recorded.
+bool IsStartupBundleSourceCurrent(const StartupBundleSource& source,
+                                  std::string* reason = nullptr);
+
+// Parses every instrument cache in `instrument_cache_paths` and the session config.
+bool BuildStartupBundle(const std::vector<std::string>& instrument_cache_paths,
+                        const std::string& trading_sessions_config_path,
+                        bool use_default_session_fallback, EpochNanos generated_ts_ns,
+                        StartupBundle* out, std::string* error = nullptr);
+
+std::string EncodeStartupBundle(const StartupBundle& bundle);
+bool DecodeStartupBundle(const char* data, std::size_t size, StartupBundle* out,
+                         std::string* error = nullptr);
+bool WriteStartupBundleAtomically(const std::string& path, const StartupBundle& bundle,
+                                  std::string* error = nullptr);
+bool LoadStartupBundle(const std::string& path, StartupBundle* out,
+                       std::string* error = nullptr);
+
+// The cache for `product_id` (case-insensitive), or nullptr.
+const StartupBundleInstrumentCache* FindStartupBundleInstrumentCache(
+    const StartupBundle& bundle, const std::string& product_id);
+
+// Wall time of consecutive startup phases, reported once the process is subscribed.
+class StartupPhaseTimer {
+   public:
+    StartupPhaseTimer();
+
+    // Closes the phase that started at the previous mark (or construction).
+    void Mark(const std::string& phase);
+    // "<phase>_ms" for every marked phase in order, then "total_ms".
+    LogFields ReportFields() const;
+
+   private:
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_;
+    std::vector<std::pair<std::string, std::int64_t>> phases_ms_;
+};
+
+}  // namespace quant_hft
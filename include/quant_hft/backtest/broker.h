@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -7,6 +8,7 @@
 #include <vector>
 
 #include "quant_hft/contracts/types.h"
+#include "quant_hft/core/instrument_registry.h"
 
 namespace quant_hft::backtest {
 
@@ -42,25 +44,57 @@ private:
         bool is_market{false};
     };
 
+    // Price fields of the latest tick, kept so a newly placed order can match immediately
+    // without holding a full Tick copy per symbol.
+    struct BookQuote {
+        EpochNanos ts_ns{0};
+        double last_price{0.0};
+        std::int32_t last_volume{0};
+        double ask_price1{0.0};
+        double bid_price1{0.0};
+    };
+
     struct PositionLot {
         PositionDirection direction{PositionDirection::kLong};
         std::int32_t volume{0};
         double open_price{0.0};
     };
 
-    void TryMatchOrder(PendingOrder* pending, const Tick& tick);
+    // Resting orders, latest quote and open lots of one symbol, addressed by its interned id.
+    struct SymbolBook {
+        BookQuote quote;
+        bool has_quote{false};
+        std::vector<PendingOrder> buy_orders;
+        std::vector<PendingOrder> sell_orders;
+        double contract_multiplier{1.0};
+        // Set by the first fill; GetPositions reports the symbol from then on.
+        bool has_position{false};
+        std::vector<PositionLot> lots;
+    };
+
+    SymbolBook& ResolveBook(const std::string& symbol);
+    SymbolBook& BookFor(InstrumentId id, const std::string& symbol);
+    void MatchBook(SymbolBook* book);
+    void TryMatchOrder(PendingOrder* pending, SymbolBook* book);
     double ComputeCommission(const PendingOrder& pending,
                              std::int32_t fill_qty,
-                             double fill_price) const;
+                             double fill_price,
+                             double contract_multiplier) const;
     double ApplySlippage(double raw_price, Side side) const;
-    double ApplyTradeToPosition(const Trade& trade);
-    double ResolveContractMultiplier(const std::string& symbol) const;
+    double ApplyTradeToPosition(const Trade& trade, SymbolBook* book);
+    double ResolveContractMultiplier(InstrumentId id, const std::string& symbol) const;
 
     BrokerConfig config_;
-    std::vector<PendingOrder> buy_orders_;
-    std::vector<PendingOrder> sell_orders_;
-    std::unordered_map<std::string, std::vector<PositionLot>> lots_by_symbol_;
-    std::unordered_map<std::string, Tick> last_tick_by_symbol_;
+    // InstrumentMap growth keeps book references valid when a callback places an order on a
+    // new symbol.
+    InstrumentMap<SymbolBook> books_;
+    // Symbols the registry cannot intern, such as an empty id.
+    std::unordered_map<std::string, SymbolBook> unregistered_books_;
+    // Books of orders and of ticks without a registry handle; the registry's lock is only taken
+    // the first time a symbol is seen.  Ticks interned by the feed index books_ directly.
+    std::unordered_map<std::string, SymbolBook*> books_by_symbol_;
+    // Book of every resting order, so cancels only scan the owning book.
+    std::unordered_map<std::string, SymbolBook*> order_books_;
 
     double account_balance_{0.0};
     std::int64_t id_seed_{0};
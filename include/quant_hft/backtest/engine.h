@@ -20,6 +20,14 @@ struct EquityPoint {
     double balance{0.0};
 };
 
+// Controls how densely the equity curve is recorded. With both fields at their defaults a point
+// is kept for every tick; otherwise a point is kept when `interval_ns` has elapsed since the last
+// one or, with `on_change`, when the balance moved. The first and last ticks are always kept.
+struct EquitySamplingConfig {
+    EpochNanos interval_ns{0};
+    bool on_change{false};
+};
+
 struct BacktestResult {
     std::vector<Order> orders;
     std::vector<Trade> trades;
@@ -34,15 +42,19 @@ public:
 
     void Run();
 
-    BacktestResult GetResult() const;
+    const BacktestResult& GetResult() const;
+    // Moves the accumulated result out, leaving the engine with an empty one.
+    BacktestResult TakeResult();
 
     void SetTimeRange(const Timestamp& start, const Timestamp& end);
+    void SetEquitySampling(EquitySamplingConfig config);
 
 private:
     void ProcessEvent(const Event& event);
     void OnMarketData(const Tick& tick);
     void OnOrderUpdate(const Order& order);
     void OnFill(const Trade& trade);
+    void RecordEquity(EpochNanos ts_ns, double balance);
 
     std::unique_ptr<DataFeed> data_feed_;
     std::unique_ptr<SimulatedBroker> broker_;
@@ -51,6 +63,10 @@ private:
     Timestamp start_time_;
     Timestamp end_time_;
     BacktestResult result_;
+    EquitySamplingConfig equity_sampling_;
+    // Latest tick not yet written to the equity curve; flushed at the end of Run().
+    EquityPoint pending_equity_;
+    bool has_pending_equity_{false};
 };
 
 }  // namespace backtest
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -36,10 +37,21 @@ struct IndicatorTraceRow {
     std::string market_state_decision_reason;
 };
 
+// Shared by the indicator and sub-strategy trace writers.
+struct TraceParquetWriterOptions {
+    // Rows buffered in column builders before they are written out as one row group.
+    std::int64_t row_group_rows{65'536};
+    // Encode and write row groups on a background thread instead of inside Append.
+    bool background_encoding{false};
+};
+
 class IndicatorTraceParquetWriter {
    public:
-    IndicatorTraceParquetWriter() = default;
-    ~IndicatorTraceParquetWriter() = default;
+    explicit IndicatorTraceParquetWriter(TraceParquetWriterOptions options = {});
+    ~IndicatorTraceParquetWriter();
+
+    IndicatorTraceParquetWriter(const IndicatorTraceParquetWriter&) = delete;
+    IndicatorTraceParquetWriter& operator=(const IndicatorTraceParquetWriter&) = delete;
 
     bool Open(const std::string& output_path, std::string* error);
     bool Append(const IndicatorTraceRow& row, std::string* error);
@@ -50,13 +62,16 @@ class IndicatorTraceParquetWriter {
     bool is_open() const noexcept { return is_open_; }
 
    private:
+    // Column builders for the row group in progress plus the file they stream into.
+    struct ColumnSink;
+
+    bool FlushRowGroup(std::string* error);
+
+    TraceParquetWriterOptions options_;
     bool is_open_{false};
     std::int64_t rows_written_{0};
     std::string output_path_;
-
-#if QUANT_HFT_ENABLE_ARROW_PARQUET
-    std::vector<IndicatorTraceRow> rows_;
-#endif
+    std::unique_ptr<ColumnSink> sink_;
 };
 
 }  // namespace quant_hft
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
+#include "quant_hft/backtest/indicator_trace_parquet_writer.h"
 #include "quant_hft/contracts/types.h"
 
 namespace quant_hft {
@@ -44,8 +46,12 @@ struct SubStrategyIndicatorTraceRow {
 
 class SubStrategyIndicatorTraceParquetWriter {
    public:
-    SubStrategyIndicatorTraceParquetWriter() = default;
-    ~SubStrategyIndicatorTraceParquetWriter() = default;
+    explicit SubStrategyIndicatorTraceParquetWriter(TraceParquetWriterOptions options = {});
+    ~SubStrategyIndicatorTraceParquetWriter();
+
+    SubStrategyIndicatorTraceParquetWriter(const SubStrategyIndicatorTraceParquetWriter&) = delete;
+    SubStrategyIndicatorTraceParquetWriter& operator=(
+        const SubStrategyIndicatorTraceParquetWriter&) = delete;
 
     bool Open(const std::string& output_path, std::string* error);
     bool Append(const SubStrategyIndicatorTraceRow& row, std::string* error);
@@ -56,13 +62,16 @@ class SubStrategyIndicatorTraceParquetWriter {
     bool is_open() const noexcept { return is_open_; }
 
    private:
+    // Column builders for the row group in progress plus the file they stream into.
+    struct ColumnSink;
+
+    bool FlushRowGroup(std::string* error);
+
+    TraceParquetWriterOptions options_;
     bool is_open_{false};
     std::int64_t rows_written_{0};
     std::string output_path_;
-
-#if QUANT_HFT_ENABLE_ARROW_PARQUET
-    std::vector<SubStrategyIndicatorTraceRow> rows_;
-#endif
+    std::unique_ptr<ColumnSink> sink_;
 };
 
 }  // namespace quant_hft
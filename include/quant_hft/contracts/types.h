@@ -9,6 +9,11 @@ namespace quant_hft {
 
 using EpochNanos = std::int64_t;
 
+// Dense process-wide handle of an instrument id string, issued by InstrumentRegistry.  Handles
+// start at zero and are never reused, so they index arrays directly.
+using InstrumentId = std::uint32_t;
+inline constexpr InstrumentId kInvalidInstrumentId = std::numeric_limits<InstrumentId>::max();
+
 inline EpochNanos NowEpochNanos();
 
 enum class Side {
@@ -132,6 +137,9 @@ struct Tick {
     std::int64_t volume{0};
     double turnover{0.0};
     std::int64_t open_interest{0};
+    // InstrumentRegistry handle of `symbol`, interned where the tick is read; consumers fall
+    // back to the symbol when it is kInvalidInstrumentId.
+    InstrumentId instrument_handle{kInvalidInstrumentId};
 };
 
 struct Bar {
@@ -237,6 +245,9 @@ struct MarketSnapshot {
     // False means the contract multiplier was unavailable and average_price_norm must not be
     // consumed.  Kept at the end for append-only CSV/schema compatibility.
     bool average_price_norm_valid{false};
+    // InstrumentRegistry handle of `instrument_id`, interned where the snapshot is received.
+    // In-memory only; never serialized.
+    InstrumentId instrument_handle{kInvalidInstrumentId};
 };
 
 struct StateSnapshot7D {
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace quant_hft {
+
+// Layout shared by the sectioned binary files (market bar checkpoint, startup bundle), in host
+// byte order checked through kBinarySectionByteOrderMark:
+//   header:  magic[8] | u32 format_version | u32 byte_order | u32 section_count | u32 crc32
+//   section: u32 kind | u32 payload_crc32 | u64 payload_bytes | payload
+// Each section carries its own CRC so a corrupt section is pinpointed.
+inline constexpr std::uint32_t kBinarySectionByteOrderMark = 0x01020304U;
+inline constexpr std::size_t kBinarySectionHeaderBytes = 24;
+inline constexpr std::size_t kBinarySectionFrameBytes = 16;
+
+struct BinarySectionFileFormat {
+    char magic[8];
+    std::uint32_t version;
+    // Names the file in error messages, e.g. "startup bundle".
+    const char* label;
+};
+
+// CRC-32 (IEEE 802.3, reflected).
+std::uint32_t BinarySectionCrc32(const char* data, std::size_t size);
+
+class BinarySectionWriter {
+   public:
+    // Resets `out` to an empty header; Finish() fills it in once every section is written.
+    explicit BinarySectionWriter(std::string* out);
+
+    template <typename T>
+    void Put(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "section fields must be POD");
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out_->append(bytes, sizeof(T));
+    }
+
+    void PutBool(bool value) { Put(static_cast<std::uint8_t>(value ? 1 : 0)); }
+
+    void PutString(const std::string& value) {
+        Put(static_cast<std::uint32_t>(value.size()));
+        out_->append(value);
+    }
+
+    void BeginSection(std::uint32_t kind);
+    void EndSection();
+    void Finish(const BinarySectionFileFormat& format);
+
+   private:
+    std::string* out_;
+    std::size_t section_start_{0};
+    std::uint32_t section_count_{0};
+};
+
+class BinarySectionReader {
+   public:
+    BinarySectionReader(const char* data, std::size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    bool Get(T* value) {
+        if (size_ - offset_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(value, data_ + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return true;
+    }
+
+    bool GetBool(bool* value);
+    bool GetString(std::string* value);
+    bool AtEnd() const { return offset_ == size_; }
+
+   private:
+    const char* data_;
+    std::size_t size_;
+    std::size_t offset_{0};
+};
+
+struct BinarySection {
+    std::uint32_t kind{0};
+    const char* payload{nullptr};
+    std::size_t payload_bytes{0};
+};
+
+// Validates the header, every section frame and CRC, and that nothing trails the last section.
+// Payloads point into `data`.
+bool SplitBinarySections(const char* data, std::size_t size, const BinarySectionFileFormat& format,
+                         std::vector<BinarySection>* sections, std::string* error);
+
+// Read-only view of a file; mapped where the platform allows it.
+class MappedReadOnlyFile {
+   public:
+    MappedReadOnlyFile() = default;
+    MappedReadOnlyFile(const MappedReadOnlyFile&) = delete;
+    MappedReadOnlyFile& operator=(const MappedReadOnlyFile&) = delete;
+    ~MappedReadOnlyFile();
+
+    // `label` names the file in error messages.
+    bool Open(const std::string& path, const std::string& label, std::string* error);
+
+    const char* data() const;
+    std::size_t size() const { return size_; }
+
+   private:
+    std::size_t size_{0};
+#if !defined(_WIN32)
+    void* mapped_{nullptr};
+#else
+    std::string buffer_;
+#endif
+};
+
+// Writes `payload` to a temp file next to `path`, fsyncs it, renames it over `path` and fsyncs
+// the directory, so readers see either the old file or the complete new one.
+bool WriteFileAtomically(const std::string& path, const std::string& payload,
+                         const std::string& label, std::string* error);
+
+}  // namespace quant_hft
@@ -124,6 +124,8 @@ struct ExecutionConfig {
     ExecutionPriceMode price_mode{ExecutionPriceMode::kSignalLimit};
     int slice_size{1};
     int slice_interval_ms{200};
+    // Worker lanes used by the asynchronous slice scheduler; orders are laned by instrument.
+    int scheduler_lanes{1};
     int twap_duration_ms{0};
     int vwap_lookback_bars{20};
     double throttle_reject_ratio{0.0};
@@ -35,6 +35,7 @@ struct CtpFileConfig {
     std::string strategy_composite_config;
     std::unordered_map<std::string, std::string> strategy_composite_config_map;
     int strategy_queue_capacity{8192};
+    int strategy_worker_count{1};
     bool strategy_state_persist_enabled{false};
     std::string strategy_state_backend{"redis"};
     int strategy_state_snapshot_interval_ms{60'000};
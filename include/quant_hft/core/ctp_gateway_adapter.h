@@ -58,7 +58,8 @@ class CtpGatewayAdapter : public IMarketDataGateway, public IOrderGateway {
         std::function<void(const std::vector<InstrumentOrderCommRateSnapshot>&)>;
 
     explicit CtpGatewayAdapter(std::size_t query_qps_limit = 10);
-    void CompleteScheduledQuery();
+    // Frees the query slot held by `request_id` and starts whatever is queued behind it.
+    void CompleteScheduledQuery(int request_id);
     ~CtpGatewayAdapter() override;
 
     bool Connect(const MarketDataConnectConfig& config) override;
@@ -166,7 +167,26 @@ class CtpGatewayAdapter : public IMarketDataGateway, public IOrderGateway {
     void TryMarkHealthyFromState();
     bool ReplayMarketDataSubscriptions();
     void DisconnectRealApi();
-    bool FinishQuerySchedule(std::size_t drained, bool query_ok);
+    struct ScheduledQueryTaskState;
+    // Callers waiting on one order/trade query: its own request id plus any merged into it.
+    struct QueryWaiters {
+        std::string query_name;
+        std::vector<int> request_ids;
+    };
+
+    QueryScheduler::ScheduleResult ScheduleQuery(
+        QueryScheduler::QueryTask task, std::string coalesce_key,
+        const std::shared_ptr<ScheduledQueryTaskState>& state);
+    // Runs a newly queued query inline when the scheduler is idle and reports whether it was
+    // issued, is still queued, or was absorbed by an identical pending query.
+    bool FinishQuerySchedule(QueryScheduler::ScheduleResult scheduled,
+                             ScheduledQueryTaskState* state);
+    // Hands a finished task's snapshots to their callbacks and answers waiters that get no
+    // response: simulated queries and requests that failed to go out.
+    void DeliverScheduledQuery(int request_id, const ScheduledQueryTaskState& state);
+    std::vector<int> TakeQueryWaitersLocked(int request_id);
+    void NotifyQueryComplete(const std::string& query_name, const std::vector<int>& request_ids,
+                             bool success);
     bool ExecuteTdQueryWithRetry(const std::function<int()>& request_fn) const;
     int NextRequestIdLocked();
     std::string NextOrderRefLocked();
@@ -189,6 +209,8 @@ class CtpGatewayAdapter : public IMarketDataGateway, public IOrderGateway {
     OrderSubmitPrepareCallback order_submit_prepare_callback_;
 
     QueryScheduler query_scheduler_;
+    // In-flight order/trade queries by the request id their response will carry.
+    std::unordered_map<int, QueryWaiters> query_waiters_;
     CtpUserSessionInfo user_session_;
     TradingAccountSnapshot trading_account_snapshot_;
     std::vector<InvestorPositionSnapshot> investor_position_snapshots_;
@@ -1,40 +1,70 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <string_view>
 #include <unordered_map>
-#include <vector>
 
 #include "quant_hft/contracts/types.h"
 
 namespace quant_hft {
 
+// Attributes CTP order and trade callbacks to the order that submitted them.
+//
+// Each mapping is stored once in an append-only arena; the lookup indexes are open-addressing
+// tables of atomic pointers into it. Callbacks load the published index generation with one
+// atomic shared_ptr read and probe it without taking the writer mutex, so EnrichOrderEvent
+// never waits behind a concurrent Upsert. Writers serialize on the mutex, fill slots in place
+// and publish a larger generation once a table passes half full; readers still probing the
+// previous generation keep it (and its arena) alive.
+//
+// When a mapping arrives for a new trading day, mappings older than the newest
+// `retained_trading_days` days are dropped so a long-running engine stays bounded. Mappings
+// without a trading day are never retired.
 class CtpOrderMappingStore {
    public:
+    static constexpr std::size_t kDefaultRetainedTradingDays = 3;
+
+    // `retained_trading_days` of 0 keeps every trading day.
+    explicit CtpOrderMappingStore(std::size_t retained_trading_days = kDefaultRetainedTradingDays)
+        : retained_trading_days_(retained_trading_days) {
+        Rebuild(std::make_shared<Arena>(), kMinCapacity);
+    }
+
     void Upsert(const CtpOrderSubmitMapping& mapping) {
         if (mapping.client_order_id.empty() || mapping.order_ref.empty()) {
             return;
         }
 
         std::lock_guard<std::mutex> lock(mutex_);
-        by_client_order_id_[mapping.client_order_id] = mapping;
-
-        if (mapping.front_id > 0 && mapping.session_id > 0) {
-            by_exact_key_[BuildExactKey(mapping.account_id, mapping.trading_day, mapping.front_id,
-                                        mapping.session_id, mapping.order_ref)] = mapping;
-            by_exact_key_[BuildExactKey("", mapping.trading_day, mapping.front_id,
-                                        mapping.session_id, mapping.order_ref)] = mapping;
+        const std::string& trading_day = mapping.trading_day;
+        if (!trading_day.empty() && trading_days_.count(trading_day) == 0) {
+            const bool newest = trading_days_.empty() || trading_day > *trading_days_.rbegin();
+            trading_days_.insert(trading_day);
+            if (newest && retained_trading_days_ > 0 &&
+                trading_days_.size() > retained_trading_days_) {
+                auto cutoff = trading_days_.rbegin();
+                std::advance(cutoff, retained_trading_days_ - 1);
+                RetireTradingDaysBeforeLocked(*cutoff);
+            }
         }
 
-        auto& rows = by_order_ref_[mapping.order_ref];
-        for (auto& row : rows) {
-            if (row.client_order_id == mapping.client_order_id) {
-                row = mapping;
-                return;
-            }
+        arena_->records.push_back(Record{mapping, PackSessionKey(mapping.front_id,
+                                                                 mapping.session_id)});
+        const Record* record = &arena_->records.back();
+        if (writable_->NeedsGrowth()) {
+            Rebuild(arena_, writable_->capacity * 2);
+            return;
         }
-        rows.push_back(mapping);
+        IndexRecord(writable_.get(), record);
     }
 
     // Records the broker identity after an order callback has been attributed.  CTP trade
@@ -46,74 +76,345 @@ class CtpOrderMappingStore {
             event.trading_day.empty()) {
             return;
         }
+        // Order callbacks repeat for every status change; only the first one needs the lock.
+        if (IsExchangeOrderIdBound(*LoadGeneration(), event)) {
+            return;
+        }
 
         std::lock_guard<std::mutex> lock(mutex_);
-        const auto client_it = by_client_order_id_.find(event.client_order_id);
-        if (client_it == by_client_order_id_.end()) {
+        const Record* current = FindByClientOrderId(*writable_, event.client_order_id);
+        if (current == nullptr) {
             return;
         }
-        const auto& mapping = client_it->second;
-        by_exchange_order_id_[BuildExchangeOrderKey(mapping.account_id, event.trading_day,
-                                                    event.exchange_id, event.exchange_order_id)] =
-            mapping;
-        by_exchange_order_id_[BuildExchangeOrderKey("", event.trading_day, event.exchange_id,
-                                                    event.exchange_order_id)] = mapping;
+        arena_->bindings.push_back(ExchangeBinding{current->mapping.account_id, event.trading_day,
+                                                   event.exchange_id, event.exchange_order_id,
+                                                   current});
+        const ExchangeBinding* binding = &arena_->bindings.back();
+        if (writable_->NeedsGrowth()) {
+            Rebuild(arena_, writable_->capacity * 2);
+            return;
+        }
+        IndexBinding(writable_.get(), binding);
     }
 
     bool Resolve(const OrderEvent& event, CtpOrderSubmitMapping* mapping) const {
+        const std::shared_ptr<const Generation> generation = LoadGeneration();
+        const Record* record = FindRecord(*generation, event);
+        if (record == nullptr) {
+            return false;
+        }
+        Assign(mapping, record->mapping);
+        return true;
+    }
+
+    bool EnrichOrderEvent(OrderEvent* event) {
+        if (event == nullptr) {
+            return false;
+        }
+        const std::shared_ptr<const Generation> generation = LoadGeneration();
+        const Record* record = FindRecord(*generation, *event);
+        if (record == nullptr) {
+            return false;
+        }
+        const CtpOrderSubmitMapping& mapping = record->mapping;
+
+        event->client_order_id = mapping.client_order_id;
+        if (event->account_id.empty()) {
+            event->account_id = mapping.account_id;
+        }
+        if (event->strategy_id.empty()) {
+            event->strategy_id = mapping.strategy_id;
+        }
+        if (event->trace_id.empty()) {
+            event->trace_id = mapping.trace_id;
+        }
+        if (event->instrument_id.empty()) {
+            event->instrument_id = mapping.instrument_id;
+        }
+        if (event->exchange_id.empty()) {
+            event->exchange_id = mapping.exchange_id;
+        }
+        if (event->trading_day.empty()) {
+            event->trading_day = mapping.trading_day;
+        }
+        if (event->total_volume <= 0) {
+            event->total_volume = mapping.volume;
+        }
+        event->side = mapping.side;
+        event->offset = mapping.offset;
+        BindExchangeOrderId(*event);
+        return true;
+    }
+
+    // Drops mappings and exchange bindings of trading days before `trading_day`.
+    void RetireTradingDaysBefore(const std::string& trading_day) {
         std::lock_guard<std::mutex> lock(mutex_);
+        RetireTradingDaysBeforeLocked(trading_day);
+    }
+
+    // Mappings held, including superseded versions still reachable by earlier index entries.
+    std::size_t stored_mapping_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return arena_->records.size();
+    }
+
+   private:
+    static constexpr std::size_t kMinCapacity = 1024;
+
+    struct Record {
+        CtpOrderSubmitMapping mapping;
+        std::uint64_t session_key{0};
+    };
+
+    struct ExchangeBinding {
+        std::string account_id;
+        std::string trading_day;
+        std::string exchange_id;
+        std::string exchange_order_id;
+        const Record* record{nullptr};
+    };
+
+    // Owns what the index slots point at. Appending to a deque never moves its elements, so
+    // readers may follow published pointers while the writer appends.
+    struct Arena {
+        std::deque<Record> records;
+        std::deque<ExchangeBinding> bindings;
+    };
+
+    struct OrderRefLink {
+        const Record* record{nullptr};
+        const OrderRefLink* previous{nullptr};
+    };
+
+    // Open-addressing table with linear probing. One writer (under the store mutex) fills or
+    // repoints slots; readers probe concurrently. A slot's hash is stored before its value is
+    // published, and a filled slot is never emptied.
+    template <typename T>
+    class AtomicIndex {
+       public:
+        explicit AtomicIndex(std::size_t capacity)
+            : mask_(capacity - 1), slots_(new Slot[capacity]) {}
+
+        template <typename Match>
+        const T* Find(std::uint64_t hash, Match&& match) const {
+            for (std::size_t pos = hash & mask_;; pos = (pos + 1) & mask_) {
+                const T* value = slots_[pos].value.load(std::memory_order_acquire);
+                if (value == nullptr) {
+                    return nullptr;
+                }
+                if (slots_[pos].hash.load(std::memory_order_relaxed) == hash && match(*value)) {
+                    return value;
+                }
+            }
+        }
+
+        // Points the slot matching `hash`/`match` at `value`, filling an empty slot if none does.
+        template <typename Match>
+        void Store(std::uint64_t hash, const T* value, Match&& match) {
+            for (std::size_t pos = hash & mask_;; pos = (pos + 1) & mask_) {
+                Slot& slot = slots_[pos];
+                const T* current = slot.value.load(std::memory_order_relaxed);
+                if (current == nullptr) {
+                    slot.hash.store(hash, std::memory_order_relaxed);
+                    slot.value.store(value, std::memory_order_release);
+                    ++size_;
+                    return;
+                }
+                if (slot.hash.load(std::memory_order_relaxed) == hash && match(*current)) {
+                    slot.value.store(value, std::memory_order_release);
+                    return;
+                }
+            }
+        }
+
+        std::size_t size() const { return size_; }
+
+       private:
+        struct Slot {
+            std::atomic<std::uint64_t> hash{0};
+            std::atomic<const T*> value{nullptr};
+        };
+
+        std::size_t mask_;
+        std::unique_ptr<Slot[]> slots_;
+        std::size_t size_{0};
+    };
+
+    struct Generation {
+        Generation(std::shared_ptr<const Arena> arena_in, std::size_t capacity_in)
+            : arena(std::move(arena_in)),
+              capacity(capacity_in),
+              by_client_order_id(capacity_in),
+              by_account_session_key(capacity_in),
+              by_session_key(capacity_in),
+              by_order_ref(capacity_in),
+              by_account_exchange_order_id(capacity_in),
+              by_exchange_order_id(capacity_in) {}
+
+        // True once the next insert could leave a table more than half full.
+        bool NeedsGrowth() const {
+            const std::size_t limit = capacity / 2;
+            return by_client_order_id.size() + 1 > limit || by_order_ref.size() + 1 > limit ||
+                   by_account_session_key.size() + 1 > limit ||
+                   by_account_exchange_order_id.size() + 1 > limit;
+        }
+
+        std::shared_ptr<const Arena> arena;
+        std::size_t capacity;
+        AtomicIndex<Record> by_client_order_id;
+        // (account, trading day, packed front/session, order ref); by_session_key omits the
+        // account. Each holds the latest mapping submitted under the key.
+        AtomicIndex<Record> by_account_session_key;
+        AtomicIndex<Record> by_session_key;
+        // Head of the per-OrderRef chain of every mapping submitted under that OrderRef.
+        AtomicIndex<OrderRefLink> by_order_ref;
+        std::deque<OrderRefLink> order_ref_links;
+        AtomicIndex<ExchangeBinding> by_account_exchange_order_id;
+        AtomicIndex<ExchangeBinding> by_exchange_order_id;
+    };
+
+    static std::uint64_t PackSessionKey(std::int32_t front_id, std::int32_t session_id) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(front_id)) << 32U) |
+               static_cast<std::uint32_t>(session_id);
+    }
+
+    static std::uint64_t HashText(std::string_view text) {
+        return std::hash<std::string_view>{}(text);
+    }
+
+    static std::uint64_t Mix(std::uint64_t seed, std::uint64_t value) {
+        return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U));
+    }
+
+    static std::uint64_t HashSessionKey(std::string_view account_id, std::string_view trading_day,
+                                        std::uint64_t session_key, std::string_view order_ref) {
+        return Mix(Mix(Mix(session_key, HashText(order_ref)), HashText(trading_day)),
+                   HashText(account_id));
+    }
+
+    static std::uint64_t HashExchangeOrderKey(std::string_view account_id,
+                                              std::string_view trading_day,
+                                              std::string_view exchange_id,
+                                              std::string_view exchange_order_id) {
+        return Mix(Mix(Mix(HashText(exchange_order_id), HashText(exchange_id)),
+                       HashText(trading_day)),
+                   HashText(account_id));
+    }
+
+    static bool SessionKeyMatches(const Record& record, std::string_view trading_day,
+                                  std::uint64_t session_key, std::string_view order_ref) {
+        return record.session_key == session_key && record.mapping.order_ref == order_ref &&
+               record.mapping.trading_day == trading_day;
+    }
+
+    static bool ExchangeKeyMatches(const ExchangeBinding& binding, std::string_view trading_day,
+                                   std::string_view exchange_id,
+                                   std::string_view exchange_order_id) {
+        return binding.exchange_order_id == exchange_order_id &&
+               binding.exchange_id == exchange_id && binding.trading_day == trading_day;
+    }
+
+    static const Record* FindByClientOrderId(const Generation& generation,
+                                             std::string_view client_order_id) {
+        return generation.by_client_order_id.Find(
+            HashText(client_order_id), [client_order_id](const Record& record) {
+                return record.mapping.client_order_id == client_order_id;
+            });
+    }
+
+    static const Record* FindBySessionKey(const Generation& generation, std::string_view account_id,
+                                          std::string_view trading_day, std::uint64_t session_key,
+                                          std::string_view order_ref) {
+        if (!account_id.empty()) {
+            const Record* record = generation.by_account_session_key.Find(
+                HashSessionKey(account_id, trading_day, session_key, order_ref),
+                [&](const Record& candidate) {
+                    return candidate.mapping.account_id == account_id &&
+                           SessionKeyMatches(candidate, trading_day, session_key, order_ref);
+                });
+            if (record != nullptr) {
+                return record;
+            }
+        }
+        return generation.by_session_key.Find(
+            HashSessionKey("", trading_day, session_key, order_ref),
+            [&](const Record& candidate) {
+                return SessionKeyMatches(candidate, trading_day, session_key, order_ref);
+            });
+    }
+
+    static const ExchangeBinding* FindExchangeBinding(const Generation& generation,
+                                                      std::string_view account_id,
+                                                      std::string_view trading_day,
+                                                      std::string_view exchange_id,
+                                                      std::string_view exchange_order_id) {
+        if (!account_id.empty()) {
+            const ExchangeBinding* binding = generation.by_account_exchange_order_id.Find(
+                HashExchangeOrderKey(account_id, trading_day, exchange_id, exchange_order_id),
+                [&](const ExchangeBinding& candidate) {
+                    return candidate.account_id == account_id &&
+                           ExchangeKeyMatches(candidate, trading_day, exchange_id,
+                                              exchange_order_id);
+                });
+            if (binding != nullptr) {
+                return binding;
+            }
+        }
+        return generation.by_exchange_order_id.Find(
+            HashExchangeOrderKey("", trading_day, exchange_id, exchange_order_id),
+            [&](const ExchangeBinding& candidate) {
+                return ExchangeKeyMatches(candidate, trading_day, exchange_id, exchange_order_id);
+            });
+    }
+
+    static const Record* FindRecord(const Generation& generation, const OrderEvent& event) {
         if (!event.client_order_id.empty()) {
-            const auto client_it = by_client_order_id_.find(event.client_order_id);
-            if (client_it != by_client_order_id_.end()) {
-                Assign(mapping, client_it->second);
-                return true;
+            const Record* record = FindByClientOrderId(generation, event.client_order_id);
+            if (record != nullptr) {
+                return record;
             }
         }
 
-        const std::string order_ref =
+        const std::string_view order_ref =
             !event.order_ref.empty() ? event.order_ref : event.client_order_id;
 
         if (event.front_id > 0 && event.session_id > 0) {
-            auto exact_it = by_exact_key_.find(BuildExactKey(
-                event.account_id, event.trading_day, event.front_id, event.session_id, order_ref));
-            if (exact_it != by_exact_key_.end()) {
-                Assign(mapping, exact_it->second);
-                return true;
-            }
-            exact_it = by_exact_key_.find(
-                BuildExactKey("", event.trading_day, event.front_id, event.session_id, order_ref));
-            if (exact_it != by_exact_key_.end()) {
-                Assign(mapping, exact_it->second);
-                return true;
+            const Record* record =
+                FindBySessionKey(generation, event.account_id, event.trading_day,
+                                 PackSessionKey(event.front_id, event.session_id), order_ref);
+            if (record != nullptr) {
+                return record;
             }
         }
 
         if (!event.exchange_order_id.empty() && !event.exchange_id.empty() &&
             !event.trading_day.empty()) {
-            auto exchange_it = by_exchange_order_id_.find(BuildExchangeOrderKey(
-                event.account_id, event.trading_day, event.exchange_id, event.exchange_order_id));
-            if (exchange_it != by_exchange_order_id_.end()) {
-                Assign(mapping, exchange_it->second);
-                return true;
-            }
-            exchange_it = by_exchange_order_id_.find(BuildExchangeOrderKey(
-                "", event.trading_day, event.exchange_id, event.exchange_order_id));
-            if (exchange_it != by_exchange_order_id_.end()) {
-                Assign(mapping, exchange_it->second);
-                return true;
+            const ExchangeBinding* binding =
+                FindExchangeBinding(generation, event.account_id, event.trading_day,
+                                    event.exchange_id, event.exchange_order_id);
+            if (binding != nullptr) {
+                return binding->record;
             }
         }
 
         if (order_ref.empty()) {
-            return false;
+            return nullptr;
         }
 
-        const auto fallback_it = by_order_ref_.find(order_ref);
-        if (fallback_it == by_order_ref_.end()) {
-            return false;
-        }
-        std::vector<const CtpOrderSubmitMapping*> candidates;
-        for (const auto& candidate : fallback_it->second) {
+        const OrderRefLink* link = generation.by_order_ref.Find(
+            HashText(order_ref), [order_ref](const OrderRefLink& head) {
+                return head.record->mapping.order_ref == order_ref;
+            });
+        const Record* match = nullptr;
+        for (; link != nullptr; link = link->previous) {
+            const Record& record = *link->record;
+            const CtpOrderSubmitMapping& candidate = record.mapping;
+            // A later Upsert of the same order under the same OrderRef replaces this version.
+            const Record* current = FindByClientOrderId(generation, candidate.client_order_id);
+            if (current != &record && current != nullptr &&
+                current->mapping.order_ref == candidate.order_ref) {
+                continue;
+            }
             if (!event.trading_day.empty() && candidate.trading_day != event.trading_day) {
                 continue;
             }
@@ -135,70 +436,140 @@ class CtpOrderMappingStore {
             if (event.ts_ns > 0 && candidate.submit_ts_ns > event.ts_ns) {
                 continue;
             }
-            candidates.push_back(&candidate);
-        }
-        if (candidates.empty()) {
-            return false;
-        }
-        // The OrderRef-only fallback is deliberately strict.  Picking the most recent candidate
-        // can silently join an old callback to a new order after a restart or trading-day change.
-        if (candidates.size() != 1U) {
-            return false;
+            // The OrderRef-only fallback is deliberately strict.  Picking the most recent
+            // candidate can silently join an old callback to a new order after a restart or
+            // trading-day change.
+            if (match != nullptr) {
+                return nullptr;
+            }
+            match = &record;
         }
-        Assign(mapping, *candidates.front());
-        return true;
+        return match;
     }
 
-    bool EnrichOrderEvent(OrderEvent* event) {
-        if (event == nullptr) {
-            return false;
+    static bool IsExchangeOrderIdBound(const Generation& generation, const OrderEvent& event) {
+        const Record* current = FindByClientOrderId(generation, event.client_order_id);
+        if (current == nullptr) {
+            return true;
         }
-        CtpOrderSubmitMapping mapping;
-        if (!Resolve(*event, &mapping)) {
+        const std::string& account_id = current->mapping.account_id;
+        const ExchangeBinding* binding =
+            FindExchangeBinding(generation, account_id, event.trading_day, event.exchange_id,
+                                event.exchange_order_id);
+        if (binding == nullptr || binding->record != current) {
             return false;
         }
-
-        event->client_order_id = mapping.client_order_id;
-        if (event->account_id.empty()) {
-            event->account_id = mapping.account_id;
-        }
-        if (event->strategy_id.empty()) {
-            event->strategy_id = mapping.strategy_id;
-        }
-        if (event->trace_id.empty()) {
-            event->trace_id = mapping.trace_id;
+        if (account_id.empty()) {
+            return true;
         }
-        if (event->instrument_id.empty()) {
-            event->instrument_id = mapping.instrument_id;
+        const ExchangeBinding* any_account = FindExchangeBinding(
+            generation, "", event.trading_day, event.exchange_id, event.exchange_order_id);
+        return any_account != nullptr && any_account->record == current;
+    }
+
+    static void IndexRecord(Generation* generation, const Record* record) {
+        const CtpOrderSubmitMapping& mapping = record->mapping;
+        generation->by_client_order_id.Store(
+            HashText(mapping.client_order_id), record, [&](const Record& existing) {
+                return existing.mapping.client_order_id == mapping.client_order_id;
+            });
+
+        if (mapping.front_id > 0 && mapping.session_id > 0) {
+            generation->by_account_session_key.Store(
+                HashSessionKey(mapping.account_id, mapping.trading_day, record->session_key,
+                               mapping.order_ref),
+                record, [&](const Record& existing) {
+                    return existing.mapping.account_id == mapping.account_id &&
+                           SessionKeyMatches(existing, mapping.trading_day, record->session_key,
+                                             mapping.order_ref);
+                });
+            generation->by_session_key.Store(
+                HashSessionKey("", mapping.trading_day, record->session_key, mapping.order_ref),
+                record, [&](const Record& existing) {
+                    return SessionKeyMatches(existing, mapping.trading_day, record->session_key,
+                                             mapping.order_ref);
+                });
         }
-        if (event->exchange_id.empty()) {
-            event->exchange_id = mapping.exchange_id;
+
+        const std::uint64_t order_ref_hash = HashText(mapping.order_ref);
+        const auto same_order_ref = [&](const OrderRefLink& head) {
+            return head.record->mapping.order_ref == mapping.order_ref;
+        };
+        const OrderRefLink* previous =
+            generation->by_order_ref.Find(order_ref_hash, same_order_ref);
+        generation->order_ref_links.push_back(OrderRefLink{record, previous});
+        generation->by_order_ref.Store(order_ref_hash, &generation->order_ref_links.back(),
+                                       same_order_ref);
+    }
+
+    static void IndexBinding(Generation* generation, const ExchangeBinding* binding) {
+        const auto same_exchange_key = [binding](const ExchangeBinding& existing) {
+            return ExchangeKeyMatches(existing, binding->trading_day, binding->exchange_id,
+                                      binding->exchange_order_id);
+        };
+        generation->by_account_exchange_order_id.Store(
+            HashExchangeOrderKey(binding->account_id, binding->trading_day, binding->exchange_id,
+                                 binding->exchange_order_id),
+            binding, [&](const ExchangeBinding& existing) {
+                return existing.account_id == binding->account_id && same_exchange_key(existing);
+            });
+        generation->by_exchange_order_id.Store(
+            HashExchangeOrderKey("", binding->trading_day, binding->exchange_id,
+                                 binding->exchange_order_id),
+            binding, same_exchange_key);
+    }
+
+    std::shared_ptr<const Generation> LoadGeneration() const {
+        return std::atomic_load_explicit(&generation_, std::memory_order_acquire);
+    }
+
+    // Indexes every mapping and binding of `arena` in insertion order into fresh tables of at
+    // least `capacity` slots and publishes them.
+    void Rebuild(std::shared_ptr<Arena> arena, std::size_t capacity) {
+        const std::size_t entries = std::max(arena->records.size(), arena->bindings.size());
+        capacity = std::max(capacity, kMinCapacity);
+        while (capacity / 2 < entries + 1) {
+            capacity *= 2;
         }
-        if (event->trading_day.empty()) {
-            event->trading_day = mapping.trading_day;
+        auto generation = std::make_shared<Generation>(arena, capacity);
+        for (const Record& record : arena->records) {
+            IndexRecord(generation.get(), &record);
         }
-        if (event->total_volume <= 0) {
-            event->total_volume = mapping.volume;
+        for (const ExchangeBinding& binding : arena->bindings) {
+            IndexBinding(generation.get(), &binding);
         }
-        event->side = mapping.side;
-        event->offset = mapping.offset;
-        BindExchangeOrderId(*event);
-        return true;
+        arena_ = std::move(arena);
+        writable_ = generation;
+        std::atomic_store_explicit(&generation_,
+                                   std::shared_ptr<const Generation>(std::move(generation)),
+                                   std::memory_order_release);
     }
 
-   private:
-    static std::string BuildExactKey(const std::string& account_id, const std::string& trading_day,
-                                     std::int32_t front_id, std::int32_t session_id,
-                                     const std::string& order_ref) {
-        return account_id + "|" + trading_day + "|" + std::to_string(front_id) + "|" +
-               std::to_string(session_id) + "|" + order_ref;
-    }
-
-    static std::string BuildExchangeOrderKey(const std::string& account_id,
-                                             const std::string& trading_day,
-                                             const std::string& exchange_id,
-                                             const std::string& exchange_order_id) {
-        return account_id + "|" + trading_day + "|" + exchange_id + "|" + exchange_order_id;
+    // Copies the surviving mappings into a new arena; the old one is released once no reader
+    // holds a generation built on it.
+    void RetireTradingDaysBeforeLocked(const std::string& trading_day) {
+        const auto retired = [&trading_day](const std::string& day) {
+            return !day.empty() && day < trading_day;
+        };
+        auto arena = std::make_shared<Arena>();
+        std::unordered_map<const Record*, const Record*> moved;
+        for (const Record& record : arena_->records) {
+            if (retired(record.mapping.trading_day)) {
+                continue;
+            }
+            arena->records.push_back(record);
+            moved.emplace(&record, &arena->records.back());
+        }
+        for (const ExchangeBinding& binding : arena_->bindings) {
+            const auto moved_it = moved.find(binding.record);
+            if (retired(binding.trading_day) || moved_it == moved.end()) {
+                continue;
+            }
+            arena->bindings.push_back(binding);
+            arena->bindings.back().record = moved_it->second;
+        }
+        trading_days_.erase(trading_days_.begin(), trading_days_.lower_bound(trading_day));
+        Rebuild(std::move(arena), kMinCapacity);
     }
 
     static void Assign(CtpOrderSubmitMapping* out, const CtpOrderSubmitMapping& value) {
@@ -207,11 +578,13 @@ class CtpOrderMappingStore {
         }
     }
 
+    const std::size_t retained_trading_days_;
     mutable std::mutex mutex_;
-    std::unordered_map<std::string, CtpOrderSubmitMapping> by_client_order_id_;
-    std::unordered_map<std::string, CtpOrderSubmitMapping> by_exact_key_;
-    std::unordered_map<std::string, CtpOrderSubmitMapping> by_exchange_order_id_;
-    std::unordered_map<std::string, std::vector<CtpOrderSubmitMapping>> by_order_ref_;
+    std::shared_ptr<Arena> arena_;
+    std::shared_ptr<Generation> writable_;
+    std::set<std::string> trading_days_;
+    // Read with atomic_load by callbacks; replaced only under mutex_.
+    std::shared_ptr<const Generation> generation_;
 };
 
 }  // namespace quant_hft
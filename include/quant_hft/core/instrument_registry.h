@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "quant_hft/contracts/types.h"
+
+namespace quant_hft {
+
+struct InstrumentInfo {
+    std::string instrument_id;
+    // Lower-case product derived from the symbol, as ExtractFuturesProductId returns it.
+    std::string product_id;
+    std::string exchange_id;
+    std::int32_t volume_multiple{0};
+    double price_tick{0.0};
+};
+
+// Interns instrument ids once at the edge of the system (market data, order entry, metadata
+// load) so downstream state can be kept in InstrumentMap instead of string-keyed hash maps.
+// Interning takes a lock; Info() never does, and the returned reference stays valid for the
+// life of the registry.  Metadata from the instrument cache replaces an entry's info as a
+// whole, so a reader sees either the old or the new record, never a mix.
+class InstrumentRegistry {
+   public:
+    InstrumentRegistry();
+    ~InstrumentRegistry();
+
+    InstrumentRegistry(const InstrumentRegistry&) = delete;
+    InstrumentRegistry& operator=(const InstrumentRegistry&) = delete;
+
+    static InstrumentRegistry& Global();
+
+    // kInvalidInstrumentId for an empty id or once the registry is full.
+    InstrumentId Intern(const std::string& instrument_id);
+    // kInvalidInstrumentId when the id has never been interned.
+    InstrumentId Find(const std::string& instrument_id) const;
+    // Interns the instrument and records its exchange, multiplier and tick size.
+    InstrumentId Register(const InstrumentMetaSnapshot& meta);
+    std::size_t RegisterAll(const std::vector<InstrumentMetaSnapshot>& instruments);
+
+    // `id` must come from this registry.
+    const InstrumentInfo& Info(InstrumentId id) const;
+    std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+   private:
+    static constexpr std::size_t kChunkSize = 1024;
+    static constexpr std::size_t kMaxChunks = 256;
+
+    using Chunk = std::array<std::atomic<const InstrumentInfo*>, kChunkSize>;
+
+    std::atomic<const InstrumentInfo*>& SlotFor(InstrumentId id) const;
+    InstrumentId InternLocked(const std::string& instrument_id);
+    const InstrumentInfo* KeepLocked(InstrumentInfo info);
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, InstrumentId> ids_;
+    std::array<std::atomic<Chunk*>, kMaxChunks> chunks_{};
+    std::atomic<std::size_t> size_{0};
+    // Owns every InstrumentInfo ever published; replaced records are kept so references
+    // handed out by Info() stay valid.
+    std::vector<std::unique_ptr<const InstrumentInfo>> records_;
+};
+
+// Values keyed by InstrumentId in a dense array.  Storage grows to the largest id used and
+// never shrinks; growth does not move existing values, so references stay valid while other
+// instruments are added.
+template <typename T>
+class InstrumentMap {
+   public:
+    T& operator[](InstrumentId id) {
+        if (id >= values_.size()) {
+            values_.resize(static_cast<std::size_t>(id) + 1);
+            present_.resize(static_cast<std::size_t>(id) + 1, false);
+        }
+        if (!present_[id]) {
+            present_[id] = true;
+            ++size_;
+        }
+        return values_[id];
+    }
+
+    T* Find(InstrumentId id) { return Contains(id) ? &values_[id] : nullptr; }
+    const T* Find(InstrumentId id) const { return Contains(id) ? &values_[id] : nullptr; }
+    bool Contains(InstrumentId id) const { return id < present_.size() && present_[id]; }
+
+    bool Erase(InstrumentId id) {
+        if (!Contains(id)) {
+            return false;
+        }
+        values_[id] = T{};
+        present_[id] = false;
+        --size_;
+        return true;
+    }
+
+    void Clear() {
+        values_.clear();
+        present_.clear();
+        size_ = 0;
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Visits present entries in id order.
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (std::size_t id = 0; id < present_.size(); ++id) {
+            if (present_[id]) {
+                fn(static_cast<InstrumentId>(id), values_[id]);
+            }
+        }
+    }
+
+    template <typename Fn>
+    void ForEach(Fn&& fn) {
+        for (std::size_t id = 0; id < present_.size(); ++id) {
+            if (present_[id]) {
+                fn(static_cast<InstrumentId>(id), values_[id]);
+            }
+        }
+    }
+
+   private:
+    std::deque<T> values_;
+    std::vector<bool> present_;
+    std::size_t size_{0};
+};
+
+}  // namespace quant_hft
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "quant_hft/core/storage_connection_config.h"
@@ -23,6 +24,10 @@ public:
                    const std::vector<std::string>& conflict_keys,
                    const std::vector<std::string>& update_keys,
                    std::string* error) override;
+    // Sends each batch as multi-row INSERT statements on one connection inside
+    // a single BEGIN/COMMIT, rolling back on the first failure.
+    bool WriteBatches(const std::vector<TimescaleWriteBatch>& batches,
+                      std::string* error) override;
 
     std::vector<std::unordered_map<std::string, std::string>> QueryRows(
         const std::string& table,
@@ -54,7 +59,19 @@ private:
     static bool IsTuplesOk(const LibpqApi& api, void* result_ptr);
     static std::string ResultStatusText(const LibpqApi& api, void* result_ptr);
 
+    using Statement = std::pair<std::string, std::vector<std::string>>;
+
+    bool AppendBatchStatements(const TimescaleWriteBatch& batch,
+                               std::vector<Statement>* statements,
+                               std::string* error) const;
     bool Connect(void** out_conn, std::string* error) const;
+    static bool ExecuteOnConnection(
+        void* conn_ptr,
+        const std::string& sql,
+        const std::vector<std::string>& params,
+        bool expect_tuples,
+        std::vector<std::unordered_map<std::string, std::string>>* out_rows,
+        std::string* error);
     bool ExecuteStatement(const std::string& sql,
                           const std::vector<std::string>& params,
                           bool expect_tuples,
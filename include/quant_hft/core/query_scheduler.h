@@ -2,13 +2,29 @@
 
 #include <array>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <mutex>
-#include <queue>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace quant_hft {
 
+// Token-bucket scheduler for broker queries: at most one query in flight, at most `max_qps`
+// started per second, higher priorities first.
+//
+// Pending tasks that share a non-empty coalesce key are merged, so a poll that repeats while
+// the previous one is still queued costs nothing and the single response answers both; the
+// merged request ids ride on the queued task. Tasks still queued at their deadline are dropped
+// rather than executed stale, and their owner hears about it through `on_expired`. With the drain
+// thread started, queued tasks run as soon as the in-flight slot frees, a token refills or the
+// in-flight timeout passes, without waiting for the next DrainOnce call.
 class QueryScheduler {
 public:
     enum class Priority {
@@ -17,32 +33,92 @@ public:
         kLow = 2,
     };
 
+    enum class ScheduleResult {
+        kQueued = 0,
+        kCoalesced = 1,
+        kRejected = 2,
+    };
+
     struct QueryTask {
         int request_id{0};
         Priority priority{Priority::kNormal};
         std::function<void()> execute;
         std::chrono::steady_clock::time_point created_at;
+        std::string coalesce_key;
+        // Unset means the task never expires.
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        // The query has no asynchronous response, so its slot frees once execute returns.
+        bool completes_on_return{false};
+        // Request ids of later tasks merged into this one.
+        std::vector<int> merged_request_ids;
+        // Called outside the lock when the task expires unexecuted, with its own request id
+        // followed by the merged ones.
+        std::function<void(const std::vector<int>& request_ids)> on_expired;
     };
 
     explicit QueryScheduler(std::size_t max_qps = 10);
+    ~QueryScheduler();
+
+    QueryScheduler(const QueryScheduler&) = delete;
+    QueryScheduler& operator=(const QueryScheduler&) = delete;
 
+    // Only queues; DrainOnce starts the task right away when the scheduler is idle. Tasks
+    // DrainOnce cannot start yet are left to the drain thread.
+    ScheduleResult Schedule(QueryTask task);
     bool TrySchedule(QueryTask task);
     std::size_t DrainOnce();
+    // Frees the in-flight slot whatever holds it, e.g. after the session dropped.
     void MarkComplete();
+    // Frees the slot only while `request_id` holds it, so a response arriving after its query
+    // timed out cannot release the query started since.
+    void MarkComplete(int request_id);
+    // Hands over the request ids merged into the in-flight task `request_id`, once.
+    std::vector<int> TakeMergedRequestIds(int request_id);
     std::size_t PendingCount() const;
     void SetRateLimit(std::size_t max_qps);
+    // A query whose response has not arrived after `timeout` no longer blocks the queue, e.g.
+    // when the session dropped mid-query. Zero waits forever.
+    void SetInFlightTimeout(std::chrono::milliseconds timeout);
+
+    void StartDrainThread();
+    void StopDrainThread();
+
+    std::uint64_t CoalescedCount() const;
+    std::uint64_t ExpiredCount() const;
 
 private:
-    using Queue = std::queue<QueryTask>;
+    using Queue = std::deque<QueryTask>;
+    using Clock = std::chrono::steady_clock;
 
     void RefillTokens();
+    void ExpireLocked(Clock::time_point now, std::vector<QueryTask>* expired);
+    static void NotifyExpired(std::vector<QueryTask>* expired);
+    void CompleteGeneration(std::uint64_t generation);
+    void ReleaseStaleInFlightLocked(Clock::time_point now);
+    bool HasPendingLocked() const;
+    bool CanStartLocked() const;
+    std::optional<Clock::time_point> NextWakeLocked(Clock::time_point now) const;
+    void DrainLoop();
 
     mutable std::mutex mutex_;
+    std::condition_variable cv_;
     std::array<Queue, 3> queues_;
+    // Pending tasks by coalesce key. Deque elements stay put until popped or erased.
+    std::unordered_map<std::string, QueryTask*> pending_by_key_;
     std::size_t max_qps_{10};
     double tokens_{10.0};
     std::chrono::steady_clock::time_point last_refill_;
     bool in_flight_{false};
+    // Bumped whenever a task starts; completions for an older generation are stale.
+    std::uint64_t in_flight_generation_{0};
+    int in_flight_request_id_{0};
+    std::vector<int> in_flight_merged_request_ids_;
+    Clock::time_point in_flight_since_;
+    std::chrono::milliseconds in_flight_timeout_{0};
+    std::uint64_t coalesced_count_{0};
+    std::uint64_t expired_count_{0};
+    std::thread drain_thread_;
+    bool stop_drain_{false};
 };
 
 }  // namespace quant_hft
@@ -4,6 +4,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace quant_hft {
 
@@ -21,6 +22,10 @@ public:
                          const std::string& field,
                          std::int64_t delta,
                          std::string* error) = 0;
+    // Removes `fields` from the hash; fields that are not present are ignored.
+    virtual bool HDel(const std::string& key,
+                      const std::vector<std::string>& fields,
+                      std::string* error) = 0;
     virtual bool Expire(const std::string& key,
                         int ttl_seconds,
                         std::string* error) = 0;
@@ -39,6 +44,9 @@ public:
                  const std::string& field,
                  std::int64_t delta,
                  std::string* error) override;
+    bool HDel(const std::string& key,
+              const std::vector<std::string>& fields,
+              std::string* error) override;
     bool Expire(const std::string& key, int ttl_seconds, std::string* error) override;
     bool Ping(std::string* error) const override;
 
@@ -77,6 +77,14 @@ public:
     bool UpsertSystemConfig(const std::string& key,
                             const std::string& value,
                             std::string* error) override;
+    bool AppendDetails(const std::vector<SettlementDetailRecord>& details,
+                       std::string* error) override;
+    bool AppendPrices(const std::vector<SettlementPriceRecord>& prices,
+                      std::string* error) override;
+    bool AppendReconcileDiffs(const std::vector<SettlementReconcileDiffRecord>& diffs,
+                              std::string* error) override;
+    bool UpdatePositionsAfterSettlement(const std::vector<SettlementOpenPositionRecord>& positions,
+                                        std::string* error) override;
 
 private:
     bool SumTradeField(const std::string& account_id,
@@ -92,6 +100,18 @@ private:
                          const std::vector<std::string>& conflict_keys,
                          const std::vector<std::string>& update_keys,
                          std::string* error) const;
+    // Writes between BeginTransaction and CommitTransaction are staged and
+    // flushed as one atomic WriteBatches call; they are not visible to reads
+    // until the commit.
+    bool WriteRows(const std::string& table,
+                   std::vector<std::unordered_map<std::string, std::string>> rows,
+                   std::vector<std::string> conflict_keys,
+                   std::vector<std::string> update_keys,
+                   std::string* error);
+    bool WriteBatchesWithRetry(const std::vector<TimescaleWriteBatch>& batches,
+                               std::string* error) const;
+    static bool SameColumns(const std::unordered_map<std::string, std::string>& lhs,
+                            const std::unordered_map<std::string, std::string>& rhs);
     bool IsDuplicateKeyError(const std::string& error) const;
     bool IsUpsertUnsupportedError(const std::string& error) const;
     std::string TableName(const std::string& schema, const std::string& table) const;
@@ -105,6 +125,7 @@ private:
     std::string trading_schema_;
     std::string ops_schema_;
     bool in_transaction_{false};
+    std::vector<TimescaleWriteBatch> pending_writes_;
 };
 
 }  // namespace quant_hft
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <cctype>
+#include <charconv>
+#include <cstdint>
 #include <map>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -74,15 +78,48 @@ inline std::string Trim(const std::string& input) {
     return input.substr(begin, end - begin);
 }
 
+// Same set as std::isspace in the "C" locale, without the locale lookup.
+inline bool IsSpace(char ch) {
+    return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f';
+}
+
+inline bool IsDigit(char ch) { return ch >= '0' && ch <= '9'; }
+
+inline void SetError(std::string* error, const char* message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+inline void AppendUtf8(std::uint32_t code_point, std::string* out) {
+    if (code_point < 0x80U) {
+        out->push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800U) {
+        out->push_back(static_cast<char>(0xC0U | (code_point >> 6)));
+        out->push_back(static_cast<char>(0x80U | (code_point & 0x3FU)));
+    } else if (code_point < 0x10000U) {
+        out->push_back(static_cast<char>(0xE0U | (code_point >> 12)));
+        out->push_back(static_cast<char>(0x80U | ((code_point >> 6) & 0x3FU)));
+        out->push_back(static_cast<char>(0x80U | (code_point & 0x3FU)));
+    } else {
+        out->push_back(static_cast<char>(0xF0U | (code_point >> 18)));
+        out->push_back(static_cast<char>(0x80U | ((code_point >> 12) & 0x3FU)));
+        out->push_back(static_cast<char>(0x80U | ((code_point >> 6) & 0x3FU)));
+        out->push_back(static_cast<char>(0x80U | (code_point & 0x3FU)));
+    }
+}
+
+// Single-pass recursive-descent reader over a borrowed buffer.  Values are parsed in place into
+// their parent container, runs of unescaped string bytes are copied in one append and numbers
+// are converted straight from the buffer, so the only allocations are the Value nodes
+// themselves.  SkipValue validates a value without materialising it, for ObjectCursor.
 class Parser {
    public:
-    explicit Parser(const std::string& text) : text_(text) {}
+    explicit Parser(std::string_view text) : text_(text) {}
 
     bool Parse(Value* out, std::string* error) {
         if (out == nullptr) {
-            if (error != nullptr) {
-                *error = "json output is null";
-            }
+            SetError(error, "json output is null");
             return false;
         }
         SkipSpace();
@@ -92,24 +129,23 @@ class Parser {
         }
         SkipSpace();
         if (!IsEnd()) {
-            if (error != nullptr) {
-                *error = "unexpected trailing characters in json";
-            }
+            SetError(error, "unexpected trailing characters in json");
             return false;
         }
         *out = std::move(value);
         return true;
     }
 
-   private:
     bool IsEnd() const { return pos_ >= text_.size(); }
 
     char Peek() const { return IsEnd() ? '\0' : text_[pos_]; }
 
     char Take() { return IsEnd() ? '\0' : text_[pos_++]; }
 
+    std::size_t position() const { return pos_; }
+
     void SkipSpace() {
-        while (!IsEnd() && std::isspace(static_cast<unsigned char>(text_[pos_])) != 0) {
+        while (!IsEnd() && IsSpace(text_[pos_])) {
             ++pos_;
         }
     }
@@ -117,9 +153,7 @@ class Parser {
     bool ParseValue(Value* out, std::string* error) {
         SkipSpace();
         if (IsEnd()) {
-            if (error != nullptr) {
-                *error = "unexpected end of json";
-            }
+            SetError(error, "unexpected end of json");
             return false;
         }
         const char ch = Peek();
@@ -142,11 +176,70 @@ class Parser {
         return ParseNumber(out, error);
     }
 
+    // Consumes one value and reports its type; nothing is allocated.
+    bool SkipValue(Value::Type* type, std::string* error) {
+        SkipSpace();
+        if (IsEnd()) {
+            SetError(error, "unexpected end of json");
+            return false;
+        }
+        const char ch = Peek();
+        if (ch == '{' || ch == '[') {
+            *type = ch == '{' ? Value::Type::kObject : Value::Type::kArray;
+            return SkipContainer(error);
+        }
+        if (ch == '"') {
+            *type = Value::Type::kString;
+            return SkipString(error);
+        }
+        Value scalar;
+        if (ch == 't' || ch == 'f') {
+            *type = Value::Type::kBool;
+            return ParseBool(&scalar, error);
+        }
+        if (ch == 'n') {
+            *type = Value::Type::kNull;
+            return ParseNull(&scalar, error);
+        }
+        *type = Value::Type::kNumber;
+        std::size_t begin = 0;
+        return ScanNumber(&begin, error);
+    }
+
+    bool ParseString(std::string* out, std::string* error) {
+        if (out == nullptr) {
+            SetError(error, "string output is null");
+            return false;
+        }
+        if (Take() != '"') {
+            SetError(error, "expected '\"'");
+            return false;
+        }
+        out->clear();
+        while (!IsEnd()) {
+            const std::size_t run_begin = pos_;
+            while (!IsEnd() && text_[pos_] != '"' && text_[pos_] != '\\') {
+                ++pos_;
+            }
+            out->append(text_.data() + run_begin, pos_ - run_begin);
+            if (IsEnd()) {
+                break;
+            }
+            if (Take() == '"') {
+                return true;
+            }
+            if (!ParseEscape(out, error)) {
+                return false;
+            }
+        }
+        SetError(error, "unterminated string");
+        return false;
+    }
+
+   private:
     bool ParseObject(Value* out, std::string* error) {
         if (Take() != '{') {
-            if (error != nullptr) {
-                *error = "expected '{'";
-            }
+            SetError(error, "expected '{'");
             return false;
         }
         out->type = Value::Type::kObject;
@@ -158,24 +251,27 @@ class Parser {
             return true;
         }
 
+        std::string key;
         while (true) {
             SkipSpace();
-            std::string key;
             if (!ParseString(&key, error)) {
                 return false;
             }
             SkipSpace();
             if (Take() != ':') {
-                if (error != nullptr) {
-                    *error = "expected ':' in object";
-                }
+                SetError(error, "expected ':' in object");
                 return false;
             }
-            Value value;
-            if (!ParseValue(&value, error)) {
+            // Writers usually emit sorted keys, which makes the end hint exact.  A repeated key
+            // keeps the last value, as before.
+            const std::size_t before = out->object_value.size();
+            auto it = out->object_value.try_emplace(out->object_value.end(), std::move(key));
+            if (out->object_value.size() == before) {
+                it->second = Value{};
+            }
+            if (!ParseValue(&it->second, error)) {
                 return false;
             }
-            out->object_value[key] = std::move(value);
 
             SkipSpace();
             const char next = Take();
@@ -183,9 +279,7 @@ class Parser {
                 return true;
             }
             if (next != ',') {
-                if (error != nullptr) {
-                    *error = "expected ',' or '}' in object";
-                }
+                SetError(error, "expected ',' or '}' in object");
                 return false;
             }
         }
@@ -193,9 +287,7 @@ class Parser {
 
     bool ParseArray(Value* out, std::string* error) {
         if (Take() != '[') {
-            if (error != nullptr) {
-                *error = "expected '['";
-            }
+            SetError(error, "expected '['");
             return false;
         }
         out->type = Value::Type::kArray;
@@ -208,11 +300,10 @@ class Parser {
         }
 
         while (true) {
-            Value item;
-            if (!ParseValue(&item, error)) {
+            out->array_value.emplace_back();
+            if (!ParseValue(&out->array_value.back(), error)) {
                 return false;
             }
-            out->array_value.push_back(std::move(item));
 
             SkipSpace();
             const char next = Take();
@@ -220,78 +311,146 @@ class Parser {
                 return true;
             }
             if (next != ',') {
-                if (error != nullptr) {
-                    *error = "expected ',' or ']' in array";
-                }
+                SetError(error, "expected ',' or ']' in array");
                 return false;
             }
         }
     }
 
-    bool ParseString(std::string* out, std::string* error) {
-        if (out == nullptr) {
-            if (error != nullptr) {
-                *error = "string output is null";
+    bool SkipContainer(std::string* error) {
+        const char close = Take() == '{' ? '}' : ']';
+        SkipSpace();
+        if (Peek() == close) {
+            Take();
+            return true;
+        }
+        Value::Type ignored = Value::Type::kNull;
+        while (true) {
+            SkipSpace();
+            if (close == '}') {
+                if (!SkipString(error)) {
+                    return false;
+                }
+                SkipSpace();
+                if (Take() != ':') {
+                    SetError(error, "expected ':' in object");
+                    return false;
+                }
+            }
+            if (!SkipValue(&ignored, error)) {
+                return false;
+            }
+            SkipSpace();
+            const char next = Take();
+            if (next == close) {
+                return true;
+            }
+            if (next != ',') {
+                SetError(error, close == '}' ? "expected ',' or '}' in object"
+                                             : "expected ',' or ']' in array");
+                return false;
             }
-            return false;
         }
+    }
+
+    bool SkipString(std::string* error) {
         if (Take() != '"') {
-            if (error != nullptr) {
-                *error = "expected '\"'";
-            }
+            SetError(error, "expected '\"'");
             return false;
         }
-        std::string result;
         while (!IsEnd()) {
             const char ch = Take();
             if (ch == '"') {
-                *out = std::move(result);
                 return true;
             }
-            if (ch != '\\') {
-                result.push_back(ch);
-                continue;
+            if (ch == '\\') {
+                if (IsEnd()) {
+                    break;
+                }
+                ++pos_;
             }
-            if (IsEnd()) {
-                break;
+        }
+        SetError(error, "unterminated string");
+        return false;
+    }
+
+    bool ParseHex4(std::uint32_t* out, std::string* error) {
+        if (text_.size() - pos_ < 4) {
+            SetError(error, "invalid unicode escape");
+            return false;
+        }
+        std::uint32_t value = 0;
+        for (int index = 0; index < 4; ++index) {
+            const char ch = text_[pos_++];
+            value <<= 4;
+            if (IsDigit(ch)) {
+                value |= static_cast<std::uint32_t>(ch - '0');
+            } else if (ch >= 'a' && ch <= 'f') {
+                value |= static_cast<std::uint32_t>(ch - 'a' + 10);
+            } else if (ch >= 'A' && ch <= 'F') {
+                value |= static_cast<std::uint32_t>(ch - 'A' + 10);
+            } else {
+                SetError(error, "invalid unicode escape");
+                return false;
             }
-            const char escaped = Take();
-            switch (escaped) {
-                case '"':
-                    result.push_back('"');
-                    break;
-                case '\\':
-                    result.push_back('\\');
-                    break;
-                case '/':
-                    result.push_back('/');
-                    break;
-                case 'b':
-                    result.push_back('\b');
-                    break;
-                case 'f':
-                    result.push_back('\f');
-                    break;
-                case 'n':
-                    result.push_back('\n');
-                    break;
-                case 'r':
-                    result.push_back('\r');
-                    break;
-                case 't':
-                    result.push_back('\t');
-                    break;
-                default:
-                    if (error != nullptr) {
-                        *error = "unsupported escape sequence";
-                    }
+        }
+        *out = value;
+        return true;
+    }
+
+    bool ParseEscape(std::string* out, std::string* error) {
+        if (IsEnd()) {
+            SetError(error, "unterminated string");
+            return false;
+        }
+        const char escaped = Take();
+        switch (escaped) {
+            case '"':
+            case '\\':
+            case '/':
+                out->push_back(escaped);
+                return true;
+            case 'b':
+                out->push_back('\b');
+                return true;
+            case 'f':
+                out->push_back('\f');
+                return true;
+            case 'n':
+                out->push_back('\n');
+                return true;
+            case 'r':
+                out->push_back('\r');
+                return true;
+            case 't':
+                out->push_back('\t');
+                return true;
+            case 'u': {
+                std::uint32_t code_point = 0;
+                if (!ParseHex4(&code_point, error)) {
                     return false;
+                }
+                if (code_point >= 0xD800U && code_point <= 0xDFFFU) {
+                    // Only a high surrogate followed by an escaped low surrogate is valid.
+                    std::uint32_t low = 0;
+                    const bool has_low = code_point <= 0xDBFFU &&
+                                         text_.compare(pos_, 2, "\\u") == 0;
+                    if (has_low) {
+                        pos_ += 2;
+                    }
+                    if (!has_low || !ParseHex4(&low, error) || low < 0xDC00U || low > 0xDFFFU) {
+                        SetError(error, "invalid unicode surrogate pair");
+                        return false;
+                    }
+                    code_point = 0x10000U + ((code_point - 0xD800U) << 10) + (low - 0xDC00U);
+                }
+                AppendUtf8(code_point, out);
+                return true;
             }
+            default:
+                SetError(error, "unsupported escape sequence");
+                return false;
         }
-        if (error != nullptr) {
-            *error = "unterminated string";
-        }
-        return false;
     }
 
     bool ParseBool(Value* out, std::string* error) {
@@ -307,17 +466,13 @@ class Parser {
             out->bool_value = false;
             return true;
         }
-        if (error != nullptr) {
-            *error = "invalid bool token";
-        }
+        SetError(error, "invalid bool token");
         return false;
     }
 
     bool ParseNull(Value* out, std::string* error) {
         if (text_.compare(pos_, 4, "null") != 0) {
-            if (error != nullptr) {
-                *error = "invalid null token";
-            }
+            SetError(error, "invalid null token");
             return false;
         }
         pos_ += 4;
@@ -325,19 +480,19 @@ class Parser {
         return true;
     }
 
-    bool ParseNumber(Value* out, std::string* error) {
-        const std::size_t begin = pos_;
+    bool ScanNumber(std::size_t* begin, std::string* error) {
+        *begin = pos_;
         if (Peek() == '-') {
             ++pos_;
         }
         bool has_digit = false;
-        while (!IsEnd() && std::isdigit(static_cast<unsigned char>(Peek())) != 0) {
+        while (!IsEnd() && IsDigit(Peek())) {
             has_digit = true;
             ++pos_;
         }
         if (!IsEnd() && Peek() == '.') {
             ++pos_;
-            while (!IsEnd() && std::isdigit(static_cast<unsigned char>(Peek())) != 0) {
+            while (!IsEnd() && IsDigit(Peek())) {
                 has_digit = true;
                 ++pos_;
             }
@@ -348,46 +503,193 @@ class Parser {
                 ++pos_;
             }
             bool exp_digit = false;
-            while (!IsEnd() && std::isdigit(static_cast<unsigned char>(Peek())) != 0) {
+            while (!IsEnd() && IsDigit(Peek())) {
                 exp_digit = true;
                 ++pos_;
             }
             if (!exp_digit) {
-                if (error != nullptr) {
-                    *error = "invalid number exponent";
-                }
+                SetError(error, "invalid number exponent");
                 return false;
             }
         }
         if (!has_digit) {
-            if (error != nullptr) {
-                *error = "invalid number token";
-            }
+            SetError(error, "invalid number token");
             return false;
         }
+        return true;
+    }
 
-        const std::string token = Trim(text_.substr(begin, pos_ - begin));
-        try {
-            out->type = Value::Type::kNumber;
-            out->number_value = std::stod(token);
-            return true;
-        } catch (...) {
-            if (error != nullptr) {
-                *error = "failed to parse number token";
-            }
+    bool ParseNumber(Value* out, std::string* error) {
+        std::size_t begin = 0;
+        if (!ScanNumber(&begin, error)) {
+            return false;
+        }
+        double value = 0.0;
+        const char* first = text_.data() + begin;
+        const char* last = text_.data() + pos_;
+        const auto [end, ec] = std::from_chars(first, last, value);
+        if (ec != std::errc() || end != last) {
+            SetError(error, "failed to parse number token");
             return false;
         }
+        out->type = Value::Type::kNumber;
+        out->number_value = value;
+        return true;
     }
 
-    const std::string& text_;
+    std::string_view text_;
     std::size_t pos_{0};
 };
 
 }  // namespace detail
 
-inline bool Parse(const std::string& text, Value* out, std::string* error) {
+inline bool Parse(std::string_view text, Value* out, std::string* error) {
     detail::Parser parser(text);
     return parser.Parse(out, error);
 }
 
+// One member value seen by ObjectCursor.  `text` is the raw JSON of the value (quotes included
+// for strings) and stays valid as long as the cursor's input does.
+struct RawValue {
+    Value::Type type{Value::Type::kNull};
+    std::string_view text;
+
+    bool GetString(std::string* out) const {
+        if (type != Value::Type::kString || out == nullptr) {
+            return false;
+        }
+        detail::Parser parser(text);
+        return parser.ParseString(out, nullptr);
+    }
+
+    bool GetNumber(double* out) const {
+        if (type != Value::Type::kNumber || out == nullptr) {
+            return false;
+        }
+        double value = 0.0;
+        const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc() || end != text.data() + text.size()) {
+            return false;
+        }
+        *out = value;
+        return true;
+    }
+
+    // Integral tokens only; "1.5" or "1e3" are rejected rather than truncated.
+    bool GetInt64(std::int64_t* out) const {
+        if (type != Value::Type::kNumber || out == nullptr) {
+            return false;
+        }
+        std::int64_t value = 0;
+        const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc() || end != text.data() + text.size()) {
+            return false;
+        }
+        *out = value;
+        return true;
+    }
+
+    bool GetBool(bool* out) const {
+        if (type != Value::Type::kBool || out == nullptr) {
+            return false;
+        }
+        *out = text == "true";
+        return true;
+    }
+
+    // Materialises the value, e.g. a nested object the caller does need as a tree.
+    bool Parse(Value* out, std::string* error = nullptr) const {
+        return simple_json::Parse(text, out, error);
+    }
+};
+
+// Walks the top-level members of one JSON object (typically a JSONL line) without building a
+// Value tree.  Scalars are decoded only when the caller asks for them and nested containers are
+// validated and skipped, so scanning a line for a handful of keys is one pass over the text.
+//
+//   ObjectCursor cursor(line);
+//   std::string_view key;
+//   RawValue value;
+//   while (cursor.Next(&key, &value)) { ... }
+//   if (!cursor.ok()) { ... cursor.error() ... }
+class ObjectCursor {
+   public:
+    explicit ObjectCursor(std::string_view text) : text_(text), parser_(text) {
+        parser_.SkipSpace();
+        if (parser_.Take() != '{') {
+            Fail("expected '{'");
+            return;
+        }
+        parser_.SkipSpace();
+        if (parser_.Peek() == '}') {
+            parser_.Take();
+            Finish();
+        }
+    }
+
+    // False after the last member or on malformed input; ok() tells the two apart.  `key`
+    // points into the input, or into the cursor for keys that contain escapes.
+    bool Next(std::string_view* key, RawValue* value) {
+        if (done_ || key == nullptr || value == nullptr) {
+            return false;
+        }
+        parser_.SkipSpace();
+        const std::size_t key_begin = parser_.position();
+        if (!parser_.ParseString(&key_buffer_, &error_)) {
+            return Fail(nullptr);
+        }
+        const std::size_t key_length = parser_.position() - key_begin - 2;
+        const std::string_view raw_key = text_.substr(key_begin + 1, key_length);
+        *key = raw_key.find('\\') == std::string_view::npos ? raw_key
+                                                             : std::string_view(key_buffer_);
+        parser_.SkipSpace();
+        if (parser_.Take() != ':') {
+            return Fail("expected ':' in object");
+        }
+        parser_.SkipSpace();
+        const std::size_t value_begin = parser_.position();
+        if (!parser_.SkipValue(&value->type, &error_)) {
+            return Fail(nullptr);
+        }
+        value->text = text_.substr(value_begin, parser_.position() - value_begin);
+        parser_.SkipSpace();
+        const char next = parser_.Take();
+        if (next == '}') {
+            Finish();
+        } else if (next != ',') {
+            return Fail("expected ',' or '}' in object");
+        }
+        return true;
+    }
+
+    bool ok() const { return error_.empty(); }
+    const std::string& error() const { return error_; }
+
+   private:
+    void Finish() {
+        done_ = true;
+        parser_.SkipSpace();
+        if (!parser_.IsEnd()) {
+            Fail("unexpected trailing characters in json");
+        }
+    }
+
+    bool Fail(const char* message) {
+        done_ = true;
+        if (message != nullptr) {
+            error_ = message;
+        }
+        if (error_.empty()) {
+            error_ = "malformed json object";
+        }
+        return false;
+    }
+
+    std::string_view text_;
+    detail::Parser parser_;
+    std::string key_buffer_;
+    std::string error_;
+    bool done_{false};
+};
+
 }  // namespace quant_hft::simple_json
@@ -25,6 +25,9 @@ public:
                  const std::string& field,
                  std::int64_t delta,
                  std::string* error) override;
+    bool HDel(const std::string& key,
+              const std::vector<std::string>& fields,
+              std::string* error) override;
     bool Expire(const std::string& key, int ttl_seconds, std::string* error) override;
     bool Ping(std::string* error) const override;
 
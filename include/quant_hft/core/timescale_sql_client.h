@@ -7,6 +7,16 @@
 
 namespace quant_hft {
 
+// Rows written to one table with one statement shape. An empty conflict_keys
+// means a plain insert where rows colliding with an existing unique key are
+// skipped; otherwise rows are upserted on conflict_keys.
+struct TimescaleWriteBatch {
+    std::string table;
+    std::vector<std::unordered_map<std::string, std::string>> rows;
+    std::vector<std::string> conflict_keys;
+    std::vector<std::string> update_keys;
+};
+
 class ITimescaleSqlClient {
 public:
     virtual ~ITimescaleSqlClient() = default;
@@ -30,6 +40,24 @@ public:
         return false;
     }
 
+    // Applies every batch in order. Backends with transactions apply them all
+    // or none; the default falls back to row-at-a-time writes.
+    virtual bool WriteBatches(const std::vector<TimescaleWriteBatch>& batches,
+                              std::string* error) {
+        for (const auto& batch : batches) {
+            for (const auto& row : batch.rows) {
+                const bool ok = batch.conflict_keys.empty()
+                                    ? InsertRow(batch.table, row, error)
+                                    : UpsertRow(batch.table, row, batch.conflict_keys,
+                                                batch.update_keys, error);
+                if (!ok) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
     virtual std::vector<std::unordered_map<std::string, std::string>> QueryRows(
         const std::string& table,
         const std::string& key,
@@ -52,6 +80,8 @@ public:
                    const std::vector<std::string>& conflict_keys,
                    const std::vector<std::string>& update_keys,
                    std::string* error) override;
+    bool WriteBatches(const std::vector<TimescaleWriteBatch>& batches,
+                      std::string* error) override;
 
     std::vector<std::unordered_map<std::string, std::string>> QueryRows(
         const std::string& table,
@@ -65,6 +95,14 @@ public:
     bool Ping(std::string* error) const override;
 
 private:
+    using Rows = std::vector<std::unordered_map<std::string, std::string>>;
+
+    static bool UpsertInto(Rows* rows,
+                           const std::unordered_map<std::string, std::string>& row,
+                           const std::vector<std::string>& conflict_keys,
+                           const std::vector<std::string>& update_keys,
+                           std::string* error);
+
     mutable std::mutex mutex_;
     std::unordered_map<std::string,
                        std::vector<std::unordered_map<std::string, std::string>>>
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace quant_hft {
+
+// Batch indicators evaluate P parameter sets ("lanes") over one bar series in a
+// single pass. Inputs every lane shares (price history, true range, directional
+// movement) are computed once per bar; per-lane state is kept as structure of
+// arrays so each update is a flat loop over contiguous lane data. Every lane
+// reproduces the scalar indicator with the same parameters bit for bit.
+
+namespace batch_detail {
+
+// Fixed-capacity history of the most recent values; offset 0 is the newest.
+class RecentHistory {
+   public:
+    explicit RecentHistory(std::size_t capacity = 0);
+
+    void Push(double value);
+    double Back(std::size_t offset) const;
+    std::size_t size() const { return size_; }
+    void Clear();
+
+   private:
+    std::vector<double> values_;
+    std::size_t head_{0};
+    std::size_t size_{0};
+};
+
+}  // namespace batch_detail
+
+class BatchSMA {
+   public:
+    explicit BatchSMA(std::vector<int> periods);
+
+    void Update(double high, double low, double close, double volume = 0.0);
+    std::optional<double> Value(std::size_t lane) const;
+    bool IsReady(std::size_t lane) const;
+    std::size_t lane_count() const { return periods_.size(); }
+    void Reset();
+
+   private:
+    std::vector<int> periods_;
+    std::vector<double> sums_;
+    batch_detail::RecentHistory closes_;
+    std::int64_t bars_{0};
+};
+
+class BatchEMA {
+   public:
+    explicit BatchEMA(std::vector<int> periods);
+
+    void Update(double high, double low, double close, double volume = 0.0);
+    std::optional<double> Value(std::size_t lane) const;
+    bool IsReady(std::size_t lane) const;
+    std::size_t lane_count() const { return periods_.size(); }
+    void Reset();
+
+   private:
+    std::vector<int> periods_;
+    std::vector<double> alphas_;
+    std::vector<double> emas_;
+    batch_detail::RecentHistory closes_;
+    std::int64_t bars_{0};
+};
+
+class BatchATR {
+   public:
+    explicit BatchATR(std::vector<int> periods);
+
+    void Update(double high, double low, double close, double volume = 0.0);
+    std::optional<double> Value(std::size_t lane) const;
+    bool IsReady(std::size_t lane) const;
+    std::size_t lane_count() const { return periods_.size(); }
+    void Reset();
+
+   private:
+    std::vector<int> periods_;
+    std::vector<double> seed_sums_;
+    std::vector<double> atrs_;
+    bool has_prev_close_{false};
+    double prev_close_{0.0};
+    std::int64_t bars_{0};
+};
+
+class BatchADX {
+   public:
+    explicit BatchADX(std::vector<int> periods);
+
+    void Update(double high, double low, double close, double volume = 0.0);
+    std::optional<double> Value(std::size_t lane) const;
+    std::optional<double> PlusDI(std::size_t lane) const;
+    std::optional<double> MinusDI(std::size_t lane) const;
+    std::optional<double> Dx(std::size_t lane) const;
+    bool IsReady(std::size_t lane) const;
+    std::size_t lane_count() const { return periods_.size(); }
+    void Reset();
+
+   private:
+    bool DiReady(std::size_t lane) const;
+
+    std::vector<int> periods_;
+    std::vector<double> tr_smoothed_;
+    std::vector<double> plus_dm_smoothed_;
+    std::vector<double> minus_dm_smoothed_;
+    std::vector<double> plus_di_;
+    std::vector<double> minus_di_;
+    std::vector<double> dx_;
+    std::vector<double> dx_seed_sums_;
+    std::vector<double> adx_;
+    bool has_prev_bar_{false};
+    double prev_high_{0.0};
+    double prev_low_{0.0};
+    double prev_close_{0.0};
+    std::int64_t bars_{0};
+};
+
+class BatchKAMA {
+   public:
+    struct Params {
+        int er_period{10};
+        int fast_period{2};
+        int slow_period{30};
+    };
+
+    explicit BatchKAMA(std::vector<Params> params);
+
+    void Update(double high, double low, double close, double volume = 0.0);
+    std::optional<double> Value(std::size_t lane) const;
+    std::optional<double> EfficiencyRatio(std::size_t lane) const;
+    bool IsReady(std::size_t lane) const;
+    std::size_t lane_count() const { return er_periods_.size(); }
+    void Reset();
+
+   private:
+    std::vector<int> er_periods_;
+    std::vector<double> fast_sc_;
+    std::vector<double> slow_sc_;
+    std::vector<double> volatility_sums_;
+    std::vector<double> efficiency_ratios_;
+    std::vector<double> kamas_;
+    std::vector<std::uint8_t> initialized_;
+    batch_detail::RecentHistory closes_;
+    // |close[t] - close[t-1]| per bar, shared by every lane's volatility window.
+    batch_detail::RecentHistory abs_changes_;
+    std::int64_t bars_{0};
+};
+
+}  // namespace quant_hft
@@ -202,6 +202,46 @@ public:
     virtual bool UpsertSystemConfig(const std::string& key,
                                     const std::string& value,
                                     std::string* error) = 0;
+
+    // Set-based variants used by the settlement loop. Stores backed by SQL
+    // override them with multi-row statements; the defaults write per row.
+    virtual bool AppendDetails(const std::vector<SettlementDetailRecord>& details,
+                               std::string* error) {
+        for (const auto& detail : details) {
+            if (!AppendDetail(detail, error)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    virtual bool AppendPrices(const std::vector<SettlementPriceRecord>& prices,
+                              std::string* error) {
+        for (const auto& price : prices) {
+            if (!AppendPrice(price, error)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    virtual bool AppendReconcileDiffs(const std::vector<SettlementReconcileDiffRecord>& diffs,
+                                      std::string* error) {
+        for (const auto& diff : diffs) {
+            if (!AppendReconcileDiff(diff, error)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    virtual bool UpdatePositionsAfterSettlement(
+        const std::vector<SettlementOpenPositionRecord>& positions,
+        std::string* error) {
+        for (const auto& position : positions) {
+            if (!UpdatePositionAfterSettlement(position, error)) {
+                return false;
+            }
+        }
+        return true;
+    }
 };
 
 }  // namespace quant_hft
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "quant_hft/optim/temp_config_generator.h"
+#include "quant_hft/strategy/atomic/kama_trend_indicator_batch.h"
+
+namespace quant_hft::optim {
+
+// Shares KAMA/ADX/ATR computation between the KamaTrendStrategy sub-strategies of one batch of
+// trials, so the batch computes each distinct indicator configuration once in a single pass over
+// the bars instead of once per trial. Returns null when fewer than two KamaTrendStrategy
+// instances would run; trials whose config cannot be resolved are left out and fail on their own.
+std::shared_ptr<KamaTrendIndicatorBatch> BuildKamaTrendIndicatorBatch(
+    const std::vector<TrialConfigRequest>& requests);
+
+}  // namespace quant_hft::optim
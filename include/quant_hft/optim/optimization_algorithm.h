@@ -28,6 +28,13 @@ struct TrialMetricsSnapshot {
     std::optional<double> expectancy_r;
 };
 
+// Share of the backtest date range a trial ran on; rung counts promotions in
+// multi-fidelity search. Full-range trials use the defaults.
+struct TrialFidelity {
+    int rung{0};
+    double fraction{1.0};
+};
+
 struct Trial {
     std::string trial_id;
     ParamValueMap params;
@@ -42,6 +49,7 @@ struct Trial {
     std::string archived_artifact_dir;
     TrialMetricsSnapshot metrics;
     std::string metrics_error;
+    TrialFidelity fidelity;
 };
 
 struct OptimizationObjective {
@@ -83,6 +91,10 @@ struct OptimizationConfig {
     int batch_size{1};
     int preserve_top_k_trials{0};
     bool export_heatmap{false};
+    // successive_halving: each rung keeps the best 1/halving_eta of its trials and
+    // the first rung runs on halving_min_fraction of the backtest date range.
+    int halving_eta{3};
+    double halving_min_fraction{1.0 / 9.0};
     std::vector<OptimizationConstraint> constraints;
     std::string output_json{"runtime/optim/optimization_report.json"};
     std::string output_md{"runtime/optim/optimization_report.md"};
@@ -101,6 +113,8 @@ class IOptimizationAlgorithm {
     virtual bool IsFinished() const = 0;
     virtual std::vector<Trial> GetAllTrials() const = 0;
     virtual Trial GetBestTrial() const = 0;
+    // Fidelity of the batch returned by the latest GetNextBatch call.
+    virtual TrialFidelity CurrentFidelity() const { return {}; }
 };
 
 }  // namespace quant_hft::optim
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "quant_hft/optim/optimization_algorithm.h"
@@ -19,6 +21,8 @@ struct OptimizationReport {
     int total_trials{0};
     int completed_trials{0};
     int failed_trials{0};
+    // Completed trials that ran on a shortened date range; they never rank.
+    int partial_fidelity_trials{0};
     ConstraintStats constraint_stats;
     bool interrupted{false};
     std::vector<Trial> trials;
@@ -27,6 +31,28 @@ struct OptimizationReport {
     std::vector<double> all_objectives;
 };
 
+// One value reachable from the result.json root through object keys. Arrays are
+// not descended; their element data only feeds the derived snapshot.
+struct TrialResultField {
+    enum class Kind : std::uint8_t {
+        kNumber,
+        kObject,
+        kOther,
+    };
+
+    Kind kind{Kind::kOther};
+    double value{0.0};
+};
+
+// Decoded trial result: a flat dotted-path table (the root object is keyed by "")
+// plus the derived metrics snapshot, so objective, metrics and constraint
+// evaluation share a single parse of result.json.
+struct TrialResultRecord {
+    std::unordered_map<std::string, TrialResultField> fields;
+    TrialMetricsSnapshot metrics;
+    std::string metrics_warnings;
+};
+
 class ResultAnalyzer {
    public:
     static bool ParseOptimizationConstraint(const std::string& expression,
@@ -69,6 +95,35 @@ class ResultAnalyzer {
                                                 std::vector<std::string>* violations,
                                                 std::string* error);
 
+    static bool DecodeTrialResultJsonText(const std::string& json_text,
+                                          TrialResultRecord* out_record,
+                                          std::string* error);
+
+    // Prefers the binary sidecar written next to json_path when it matches the
+    // current result.json size and mtime; otherwise parses the JSON.
+    static bool LoadTrialResult(const std::string& json_path,
+                                TrialResultRecord* out_record,
+                                std::string* error);
+
+    static std::string TrialResultSidecarPath(const std::string& json_path);
+
+    static bool WriteTrialResultSidecar(const std::string& json_path,
+                                        const TrialResultRecord& record,
+                                        std::string* error);
+
+    static double ExtractMetric(const TrialResultRecord& record,
+                                const std::string& metric_path,
+                                std::string* error);
+
+    static double ComputeObjective(const TrialResultRecord& record,
+                                   const OptimizationConfig& config,
+                                   std::string* error);
+
+    static bool EvaluateConstraints(const TrialResultRecord& record,
+                                    const OptimizationConfig& config,
+                                    std::vector<std::string>* violations,
+                                    std::string* error);
+
     static OptimizationReport Analyze(const std::vector<Trial>& trials,
                                       const OptimizationConfig& config,
                                       bool interrupted);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "quant_hft/optim/optimization_algorithm.h"
+#include "quant_hft/optim/parameter_space.h"
+
+namespace quant_hft::optim {
+
+// Multi-fidelity search: samples max_trials combinations like RandomSearch, runs
+// them on a short leading slice of the date range, and promotes the best
+// 1/halving_eta of each rung to a slice halving_eta times longer until the
+// survivors run on the full range. Only full-range trials compete for best.
+class SuccessiveHalving : public IOptimizationAlgorithm {
+   public:
+    void Initialize(const ParameterSpace& space, const OptimizationConfig& config) override;
+    std::vector<ParamValueMap> GetNextBatch(int batch_size) override;
+    void AddTrialResult(const Trial& trial) override;
+    bool IsFinished() const override;
+    std::vector<Trial> GetAllTrials() const override;
+    Trial GetBestTrial() const override;
+    TrialFidelity CurrentFidelity() const override;
+
+    const std::vector<double>& rung_fractions() const { return rung_fractions_; }
+
+   private:
+    void AdvanceRung();
+
+    OptimizationConfig config_;
+    std::vector<double> rung_fractions_;
+    std::size_t current_rung_{0};
+    std::vector<ParamValueMap> rung_candidates_;
+    std::size_t emitted_in_rung_{0};
+    std::vector<Trial> rung_results_;
+    std::vector<Trial> results_;
+    bool finished_{true};
+};
+
+// Shortens [start_date, end_date] to its leading `fraction` of calendar days.
+// Dates accept YYYYMMDD or YYYY-MM-DD; the shortened end is written as YYYYMMDD.
+bool ResolveFidelityEndDate(const std::string& start_date,
+                            const std::string& end_date,
+                            double fraction,
+                            std::string* out_end_date,
+                            std::string* error);
+
+}  // namespace quant_hft::optim
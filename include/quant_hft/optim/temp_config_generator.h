@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "quant_hft/optim/optimization_algorithm.h"
+#include "quant_hft/strategy/composite_strategy.h"
 
 namespace quant_hft::optim {
 
@@ -25,4 +26,8 @@ bool GenerateTrialConfig(const TrialConfigRequest& request,
                          TrialConfigArtifacts* out,
                          std::string* error);
 
+// The composite definition GenerateTrialConfig writes for `request`, without writing files.
+bool ResolveTrialCompositeDefinition(const TrialConfigRequest& request,
+                                     CompositeStrategyDefinition* out, std::string* error);
+
 }  // namespace quant_hft::optim
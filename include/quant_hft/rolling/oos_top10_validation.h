@@ -21,6 +21,9 @@ struct OosTop10ValidationRequest {
     int top_n{10};
     bool overwrite{false};
     std::string output_dir;
+    // Candidates replayed concurrently. Above 1 a custom run_fn must be thread-safe; rows,
+    // the CSV and the recommendation stay in rank order either way.
+    int parallelism{1};
 };
 
 struct OosTop10ValidationRow {
@@ -58,6 +61,8 @@ struct OosTop10ValidationReport {
     std::vector<OosTop10ValidationRow> rows;
 };
 
+// Without a run_fn the candidates replay against one shared, lazily loaded copy of the OOS
+// dataset instead of reloading it per candidate.
 bool RunOosTop10Validation(const OosTop10ValidationRequest& request,
                            OosTop10ValidationReport* report,
                            std::string* error,
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -9,6 +10,7 @@
 #include <vector>
 
 #include "quant_hft/contracts/types.h"
+#include "quant_hft/services/compiled_session_calendar.h"
 
 namespace quant_hft {
 
@@ -56,16 +58,8 @@ struct BarAggregatorConfig {
 class BarAggregator {
    public:
     using PersistenceState = std::unordered_map<std::string, std::string>;
-    struct SessionInterval {
-        int start_minute{0};
-        int end_minute{0};
-    };
-
-    struct SessionRule {
-        std::string instrument_prefix;
-        std::string product;
-        std::vector<SessionInterval> intervals;
-    };
+    using SessionInterval = CompiledSessionCalendar::Interval;
+    using SessionRule = CompiledSessionCalendar::Rule;
 
     explicit BarAggregator(BarAggregatorConfig config = {});
 
@@ -97,6 +91,9 @@ class BarAggregator {
                                   const std::string& update_time) const;
     int ResolveSessionOrder(const std::string& exchange_id, const std::string& instrument_id,
                             const std::string& update_time) const;
+    // The compiled sessions this aggregator filters with, shared by every aggregator built
+    // from the same config.
+    const CompiledSessionCalendar& session_calendar() const;
     static std::vector<BarSnapshot> AggregateFromOneMinute(
         const std::vector<BarSnapshot>& one_minute_bars, std::int32_t timeframe_minutes);
 
@@ -122,9 +119,7 @@ class BarAggregator {
         std::int64_t cumulative_volume{0};
     };
 
-    static bool ParseMinuteOfDay(const std::string& update_time, int* minute_of_day);
     std::string ResolveExchangeId(const MarketSnapshot& snapshot) const;
-    static std::string ResolveProductCode(const MarketSnapshot& snapshot);
     static std::string ResolveTradingDay(const MarketSnapshot& snapshot);
     static std::string ResolveActionDay(const MarketSnapshot& snapshot);
     static std::string BuildMinuteKey(const std::string& trading_day,
@@ -132,16 +127,10 @@ class BarAggregator {
     static EpochNanos ResolveEventTimestamp(const MarketSnapshot& snapshot);
     static EpochNanos ResolvePhysicalMinuteStart(const MarketSnapshot& snapshot);
     EpochNanos ResolveTimestamp(const MarketSnapshot& snapshot) const;
-    bool IsInTradingSession(const std::string& exchange_id, const std::string& instrument_id,
-                            const std::string& product, const std::string& update_time) const;
-    bool ResolveSessionInterval(const std::string& exchange_id, const std::string& instrument_id,
-                                const std::string& product, const std::string& update_time,
-                                SessionInterval* interval) const;
-    bool IsExactSessionEndTime(const std::string& exchange_id, const std::string& instrument_id,
-                               const std::string& product, const std::string& update_time) const;
+    static bool IsExactSessionEndTime(const CompiledSessionCalendar::Schedule& schedule,
+                                      const std::string& update_time);
     bool IsSessionEndMinuteKey(const std::string& exchange_id, const std::string& instrument_id,
                                const std::string& minute_key) const;
-    void LoadTradingSessions();
 
     void ResetBucketLocked(MinuteBucket* bucket, const MarketSnapshot& snapshot,
                            const std::string& exchange_id, const std::string& trading_day,
@@ -165,7 +154,7 @@ class BarAggregator {
     std::unordered_set<std::string> finalized_minute_keys_;
     std::uint64_t next_arrival_seq_{1};
     std::unordered_set<std::string> closed_session_boundary_minutes_;
-    std::unordered_map<std::string, std::vector<SessionRule>> session_rules_by_exchange_;
+    std::shared_ptr<const CompiledSessionCalendar> sessions_;
 };
 
 }  // namespace quant_hft
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace quant_hft {
+
+// Intraday sessions from configs/trading_sessions.yaml compiled into per-product minute-of-day
+// lookup tables.  An instance is immutable once built, so one copy is shared by live market
+// data, execution gating, backtest and replay; lookups take integer minutes and never parse
+// time strings or walk the configured rules.
+class CompiledSessionCalendar {
+   public:
+    static constexpr int kMinutesPerDay = 24 * 60;
+
+    // Half-open [start_minute, end_minute); start > end wraps past midnight.
+    struct Interval {
+        int start_minute{0};
+        int end_minute{0};
+    };
+
+    struct Rule {
+        std::string instrument_prefix;
+        std::string product;
+        std::vector<Interval> intervals;
+    };
+
+    using RuleSet = std::unordered_map<std::string, std::vector<Rule>>;
+
+    // The sessions that apply to one product of one exchange.
+    class Schedule {
+       public:
+        explicit Schedule(const std::vector<const Rule*>& rules);
+
+        // First configured interval containing the minute, or nullptr outside every session.
+        const Interval* IntervalAt(int minute_of_day) const;
+        bool IsOpen(int minute_of_day) const { return IntervalAt(minute_of_day) != nullptr; }
+        // The minute is the exclusive end of some interval, e.g. 15:00 for 13:30-15:00.  The
+        // exchange still sends a closing tick at that minute.
+        bool IsIntervalEnd(int minute_of_day) const;
+        // The last in-session minute of its interval, or an interval end.
+        bool IsLastMinute(int minute_of_day) const;
+
+       private:
+        static constexpr std::uint8_t kNoInterval = 0xFF;
+
+        std::vector<Interval> intervals_;
+        std::array<std::uint8_t, kMinutesPerDay> interval_at_{};
+        std::bitset<kMinutesPerDay> interval_end_;
+    };
+
+    // Built-in rules used when a config is missing entries or absent altogether.
+    static RuleSet DefaultRules();
+    // Parses `config_path` (TRADING_SESSIONS_CONFIG_PATH overrides it) on top of the default
+    // rules when `use_default_fallback` is set.  A missing file yields the defaults alone.
+    static RuleSet LoadRules(const std::string& config_path, bool use_default_fallback);
+    static std::shared_ptr<const CompiledSessionCalendar> Build(const RuleSet& rules);
+    // One compiled calendar per config file and fallback flag for the whole process.  The file
+    // is compiled again only if its size or modification time changes.
+    static std::shared_ptr<const CompiledSessionCalendar> Shared(const std::string& config_path,
+                                                                 bool use_default_fallback);
+    // Makes a calendar compiled from already-loaded `rules` the Shared() instance for the config,
+    // as if the file had just been parsed.  The caller vouches that the rules match the file.
+    static std::shared_ptr<const CompiledSessionCalendar> InstallShared(
+        const std::string& config_path, bool use_default_fallback, const RuleSet& rules);
+    // `config_path`, or TRADING_SESSIONS_CONFIG_PATH when that is set.
+    static std::string ResolveConfigPath(const std::string& config_path);
+
+    // Exchange and instrument ids are matched case-insensitively; an unknown exchange uses the
+    // "*" rules.  With no instrument and no product the schedule spans every rule of the
+    // exchange.  Returns nullptr when no rule applies.
+    const Schedule* Resolve(std::string_view exchange_id, std::string_view instrument_id,
+                            std::string_view product) const;
+    // Resolve with the product code taken from the instrument id and, when `exchange_id` is
+    // empty, the exchange inferred from it.
+    const Schedule* ResolveInstrument(std::string_view exchange_id,
+                                      std::string_view instrument_id) const;
+    // Exchange of the longest configured prefix matching the instrument, or the exchange part
+    // of a dotted "SHFE.rb2610" id.
+    std::string InferExchangeId(std::string_view instrument_id) const;
+
+    // "HH:MM" or "HH:MM:SS[.mmm]"; seconds are optional and validated only when present.
+    static bool ParseMinuteOfDay(std::string_view update_time, int* minute_of_day);
+    static bool ParseSecondOfDay(std::string_view update_time, int* second_of_day);
+    // Leading letters of the symbol, upper-cased: "SHFE.rb2610" -> "RB".
+    static std::string ProductCode(std::string_view instrument_id);
+    // "start-end" in minutes of day, as reported by BarAggregator::ResolveSessionKey.
+    static std::string FormatSessionKey(const Interval& interval);
+    // Night sessions sort before the day sessions of the same trading day.
+    static int SessionOrderKey(const Interval& interval);
+
+   private:
+    struct ExchangeTable {
+        std::size_t max_prefix_length{0};
+        // Keyed by the longest matching configured prefix ("" for none), then '|' and the
+        // product selector when product rules exist.
+        std::unordered_map<std::string, std::size_t> schedule_by_key;
+        std::size_t all_rules_schedule{0};
+        bool has_product_rules{false};
+        std::vector<std::string> products;
+    };
+
+    CompiledSessionCalendar() = default;
+
+    static std::shared_ptr<const CompiledSessionCalendar> SharedOrInstall(
+        const std::string& config_path, bool use_default_fallback, const RuleSet* rules);
+
+    const ExchangeTable* FindExchange(std::string_view exchange_id) const;
+
+    std::vector<Schedule> schedules_;
+    std::unordered_map<std::string, ExchangeTable> exchanges_;
+    // Upper-cased configured prefix -> exchange, for InferExchangeId.
+    std::unordered_map<std::string, std::string> exchange_by_prefix_;
+    std::size_t max_inferred_prefix_length_{0};
+};
+
+}  // namespace quant_hft
@@ -23,6 +23,9 @@ struct DailySettlementConfig {
     int running_stale_timeout_ms{300000};
     std::string evidence_path;
     std::string diff_report_path;
+    // Resolve every settlement price with one provider batch call instead of
+    // one lookup per instrument.
+    bool prefetch_settlement_prices{true};
 };
 
 struct DailySettlementResult {
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "quant_hft/contracts/types.h"
+#include "quant_hft/core/instrument_registry.h"
 
 namespace quant_hft {
 
@@ -153,7 +154,8 @@ class DominantContractCoordinator {
         DominantContractStatus status;
         std::unordered_set<std::string> eligible_instruments;
         std::unordered_map<std::string, MarketSnapshot> baseline_snapshots;
-        std::unordered_map<std::string, MarketSnapshot> live_snapshots;
+        // Keyed by interned instrument id; refreshed on every tick.
+        InstrumentMap<MarketSnapshot> live_snapshots;
         DominantContractBrokerState broker;
         std::unordered_set<std::string> warmup_bar_keys;
     };
@@ -163,12 +165,21 @@ class DominantContractCoordinator {
     const MarketSnapshot* BestSnapshotLocked(const ProductState& state, std::string* metric) const;
     const MarketSnapshot* LatestSnapshotLocked(const ProductState& state,
                                                const std::string& instrument_id) const;
+    const MarketSnapshot* LiveSnapshotLocked(const ProductState& state,
+                                             const std::string& instrument_id) const;
+    ProductState* StateForInstrumentLocked(const std::string& instrument_id) const;
+    InstrumentId LocalIdLocked(const std::string& instrument_id) const;
     void RebuildInstrumentIndexLocked();
 
     DominantContractCoordinatorConfig config_;
     mutable std::mutex mutex_;
+    // Node-based, so the ProductState pointers indexed below stay valid.
     std::unordered_map<std::string, ProductState> products_;
-    std::unordered_map<std::string, std::string> product_by_instrument_;
+    InstrumentMap<ProductState*> state_by_instrument_;
+    // Ids of every instrument ever indexed, for lookups by id string and snapshots that arrive
+    // without a handle; kept here so they stay off the registry's lock.  Ids are never reused,
+    // so entries are kept.
+    std::unordered_map<std::string, InstrumentId> instrument_ids_;
 };
 
 }  // namespace quant_hft
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace quant_hft {
+
+// Timer-driven order submission scheduler. Tasks are keyed by due time and
+// handed to a lane worker once due; tasks sharing a lane key (e.g. an
+// instrument) run in (due time, schedule order) on the same lane so slices of
+// one execution plan keep their order while other lanes proceed independently.
+class ExecutionScheduler {
+   public:
+    using Clock = std::chrono::steady_clock;
+    using Task = std::function<void()>;
+
+    struct Stats {
+        std::size_t pending_timers{0};
+        std::size_t pending_dispatch{0};
+        std::size_t scheduled{0};
+        std::size_t executed{0};
+        std::size_t rejected{0};
+        std::size_t dropped_on_stop{0};
+        std::size_t max_pending{0};
+        std::int64_t max_dispatch_delay_ms{0};
+    };
+
+    explicit ExecutionScheduler(std::size_t lane_count = 1, std::size_t max_pending = 10000);
+    ~ExecutionScheduler();
+
+    ExecutionScheduler(const ExecutionScheduler&) = delete;
+    ExecutionScheduler& operator=(const ExecutionScheduler&) = delete;
+
+    void Start();
+    // Runs tasks that are already due and drops timers that are not.
+    void Stop();
+
+    bool ScheduleAt(const std::string& lane_key, Clock::time_point due, Task task);
+    bool ScheduleAfter(const std::string& lane_key, std::chrono::milliseconds delay, Task task);
+
+    // Blocks until no timers are pending and every lane is idle.
+    bool WaitUntilIdle(std::chrono::milliseconds timeout);
+    Stats GetStats() const;
+    std::size_t lane_count() const { return lanes_.size(); }
+
+   private:
+    struct Lane {
+        std::deque<std::pair<Clock::time_point, Task>> queue;
+        std::condition_variable cv;
+        std::thread worker;
+        bool busy{false};
+    };
+
+    void TimerLoop();
+    void LaneLoop(std::size_t lane_index);
+    std::size_t LaneIndex(const std::string& lane_key) const;
+    std::size_t PendingLocked() const;
+    bool IdleLocked() const;
+
+    const std::size_t max_pending_;
+    mutable std::mutex mutex_;
+    std::condition_variable timer_cv_;
+    std::condition_variable idle_cv_;
+    // (due_ns, sequence) keeps timers ordered by due time and FIFO within a tick.
+    std::map<std::pair<std::int64_t, std::uint64_t>, std::pair<std::size_t, Task>> timers_;
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::thread timer_worker_;
+    std::uint64_t next_sequence_{0};
+    bool running_{false};
+    bool stop_{false};
+    Stats stats_;
+};
+
+}  // namespace quant_hft
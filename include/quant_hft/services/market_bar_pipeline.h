@@ -59,6 +59,10 @@ class MarketBarPipeline {
 
     bool SaveState(PersistenceState* out, std::string* error) const;
     bool LoadState(const PersistenceState& state, std::string* error);
+    // Checkpoint files use a versioned binary layout with one CRC-checked section per
+    // instrument.  Saving captures a consistent snapshot under the pipeline lock and encodes
+    // and writes it after releasing the lock; loading maps the file and decodes it in place.
+    // Loading still accepts the earlier escaped key=value text checkpoints.
     bool SaveCheckpointAtomically(const std::string& path, std::string* error) const;
     bool LoadCheckpointFile(const std::string& path, std::string* error);
 
@@ -74,11 +78,27 @@ class MarketBarPipeline {
         std::int32_t consecutive_complete_five_minute_bars{0};
     };
 
+    // Everything a checkpoint carries, captured as plain containers so it can be encoded
+    // without holding mutex_.
+    struct CheckpointSnapshot {
+        EpochNanos last_watermark_ns{0};
+        BarAggregator::PersistenceState aggregator;
+        TimeframeStateFanout::PersistenceState fanout;
+        std::unordered_map<std::string, EpochNanos> tick_fingerprints;
+        std::unordered_map<std::string, std::string> canonical_bars;
+        std::unordered_map<std::string, RecoveryState> recovery;
+        std::unordered_map<std::string, std::deque<StateSnapshot7D>> recent_states;
+    };
+
     static std::string TickFingerprint(const MarketSnapshot& snapshot);
     static std::string BarKey(const BarSnapshot& bar, std::int32_t timeframe_minutes);
     static std::string BarFingerprint(const BarSnapshot& bar);
-    static std::string EscapeCheckpointValue(const std::string& value);
     static bool UnescapeCheckpointValue(const std::string& value, std::string* out);
+    static std::string EncodeCheckpoint(const CheckpointSnapshot& snapshot);
+    bool DecodeCheckpoint(const char* data, std::size_t size, CheckpointSnapshot* out,
+                          std::string* error) const;
+    static bool ParseTextCheckpoint(const char* data, std::size_t size, PersistenceState* out,
+                                    std::string* error);
 
     void PruneTickFingerprintsLocked(EpochNanos reference_ts_ns);
     MarketBarPipelineResult ProcessOneMinuteBarsLocked(std::vector<BarSnapshot> bars,
@@ -90,6 +110,10 @@ class MarketBarPipeline {
     void MergeResult(MarketBarPipelineResult source, MarketBarPipelineResult* destination) const;
     bool SaveStateLocked(PersistenceState* out, std::string* error) const;
     bool LoadStateLocked(const PersistenceState& state, std::string* error);
+    bool CaptureSnapshotLocked(CheckpointSnapshot* out, std::string* error) const;
+    bool StateToSnapshot(const PersistenceState& state, CheckpointSnapshot* out,
+                         std::string* error) const;
+    bool InstallSnapshotLocked(CheckpointSnapshot snapshot, std::string* error);
 
     MarketBarPipelineConfig config_;
     mutable std::mutex mutex_;
@@ -2,11 +2,12 @@
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 
 #include "quant_hft/contracts/types.h"
-#include "quant_hft/services/bar_aggregator.h"
+#include "quant_hft/services/compiled_session_calendar.h"
 
 namespace quant_hft {
 
@@ -24,9 +25,10 @@ struct TradingSessionDecision {
     std::string reason;
 };
 
-// Shared session semantics for market data and execution.  Intraday rules are sourced from the
-// same parser as BarAggregator; an optional trading-day resolver can layer an authoritative
-// exchange calendar on top without coupling this service to a particular database client.
+// Shared session semantics for market data and execution.  Intraday rules come from the same
+// compiled calendar as BarAggregator; an optional trading-day resolver can layer an
+// authoritative exchange calendar on top without coupling this service to a particular database
+// client.  The second-of-day overloads skip time-string parsing on the order path.
 class TradingSessionCalendar {
    public:
     using TradingDayOpenResolver =
@@ -40,6 +42,10 @@ class TradingSessionCalendar {
                           const std::string& update_time) const;
     bool IsOrderTime(const std::string& exchange_id, const std::string& instrument_id,
                      const std::string& update_time) const;
+    bool IsMarketDataTime(const std::string& exchange_id, const std::string& instrument_id,
+                          int second_of_day) const;
+    bool IsOrderTime(const std::string& exchange_id, const std::string& instrument_id,
+                     int second_of_day) const;
 
     TradingSessionDecision EvaluateOrderTime(const std::string& exchange_id,
                                              const std::string& instrument_id,
@@ -51,15 +57,17 @@ class TradingSessionCalendar {
                                         const std::string& instrument_id,
                                         const std::string& update_time,
                                         std::int32_t update_millisec = 0) const;
+    std::int64_t RemainingSessionMillis(const std::string& exchange_id,
+                                        const std::string& instrument_id, int second_of_day,
+                                        std::int32_t update_millisec) const;
 
     std::string TimeOfDay(EpochNanos ts_ns) const;
+    // Local second of day in the configured timezone.
+    int SecondOfDay(EpochNanos ts_ns) const;
 
    private:
-    static bool ParseMinute(const std::string& text, int* minute_of_day, int* second);
-    static bool ParseSessionKey(const std::string& key, int* start_minute, int* end_minute);
-
     TradingSessionCalendarConfig config_;
-    BarAggregator delegate_;
+    std::shared_ptr<const CompiledSessionCalendar> sessions_;
     TradingDayOpenResolver trading_day_open_resolver_;
 };
 
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "quant_hft/indicators/batch_indicators.h"
+
+namespace quant_hft {
+
+// KAMA/ADX/ATR parameters of one KamaTrendStrategy configuration.
+struct KamaTrendIndicatorSpec {
+    int er_period{10};
+    int fast_period{2};
+    int slow_period{30};
+    int adx_period{14};
+    // 0 when the exit mode that reads this ATR is "none".
+    int stop_loss_atr_period{0};
+    int take_profit_atr_period{0};
+
+    bool operator==(const KamaTrendIndicatorSpec& other) const {
+        return er_period == other.er_period && fast_period == other.fast_period &&
+               slow_period == other.slow_period && adx_period == other.adx_period &&
+               stop_loss_atr_period == other.stop_loss_atr_period &&
+               take_profit_atr_period == other.take_profit_atr_period;
+    }
+};
+
+struct KamaTrendIndicatorValues {
+    std::optional<double> kama;
+    std::optional<double> efficiency_ratio;
+    std::optional<double> adx;
+    std::optional<double> stop_loss_atr;
+    std::optional<double> take_profit_atr;
+};
+
+struct KamaTrendIndicatorBar {
+    double high{0.0};
+    double low{0.0};
+    double close{0.0};
+};
+
+// Indicators of a batch of KamaTrendStrategy configurations (one optimizer batch) computed in a
+// single pass over the bars with the batch kernels. Every backtest of the batch replays the same
+// bars: the first strategy to reach bar n advances all lanes and records their values, the others
+// read the recording. Thread-safe, so the batch's backtests may run concurrently.
+class KamaTrendIndicatorBatch {
+   public:
+    // Duplicate configurations are merged; configurations with equal periods share a lane.
+    explicit KamaTrendIndicatorBatch(std::vector<KamaTrendIndicatorSpec> specs);
+
+    // Index of `spec` among the batch's distinct configurations.
+    std::optional<std::size_t> Find(const KamaTrendIndicatorSpec& spec) const;
+
+    // Values of configuration `index` after bar `step` (0-based). Returns false when `bar` is not
+    // the bar recorded at that step; the caller's bars have diverged from the batch and it must
+    // compute its own indicators from then on.
+    bool Values(std::size_t index, std::size_t step, const KamaTrendIndicatorBar& bar,
+                KamaTrendIndicatorValues* out);
+
+    // The first `steps` recorded bars, for a caller rebuilding its own indicators.
+    std::vector<KamaTrendIndicatorBar> RecordedBars(std::size_t steps) const;
+
+    std::size_t size() const { return specs_.size(); }
+    std::size_t kama_lane_count() const { return kama_->lane_count(); }
+    std::size_t adx_lane_count() const { return adx_->lane_count(); }
+    std::size_t atr_lane_count() const { return atr_->lane_count(); }
+
+    // Binds a batch to the current thread for the scope's lifetime; KamaTrendStrategy::Init on
+    // that thread shares the batch's indicators when its configuration is part of it.
+    class Scope {
+       public:
+        explicit Scope(std::shared_ptr<KamaTrendIndicatorBatch> batch);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+       private:
+        std::shared_ptr<KamaTrendIndicatorBatch> previous_;
+    };
+
+    static std::shared_ptr<KamaTrendIndicatorBatch> Current();
+
+   private:
+    struct Lanes {
+        std::size_t kama{0};
+        std::size_t adx{0};
+        std::optional<std::size_t> stop_loss_atr;
+        std::optional<std::size_t> take_profit_atr;
+    };
+
+    void RecordStepLocked(const KamaTrendIndicatorBar& bar);
+    std::optional<double> RecordedLocked(std::size_t step, std::size_t slot) const;
+
+    std::vector<KamaTrendIndicatorSpec> specs_;
+    std::vector<Lanes> lanes_;
+    std::optional<BatchKAMA> kama_;
+    std::optional<BatchADX> adx_;
+    std::optional<BatchATR> atr_;
+    // Recorded values per step: KAMA and efficiency ratio of each KAMA lane, then each ADX lane,
+    // then each ATR lane.
+    std::size_t slots_per_step_{0};
+
+    mutable std::mutex mutex_;
+    std::vector<KamaTrendIndicatorBar> bars_;
+    std::vector<double> values_;
+    std::vector<std::uint8_t> has_value_;
+};
+
+}  // namespace quant_hft
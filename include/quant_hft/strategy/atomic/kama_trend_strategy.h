@@ -10,6 +10,7 @@
 #include "quant_hft/indicators/adx.h"
 #include "quant_hft/indicators/atr.h"
 #include "quant_hft/indicators/kama.h"
+#include "quant_hft/strategy/atomic/kama_trend_indicator_batch.h"
 #include "quant_hft/strategy/atomic_strategy.h"
 
 namespace quant_hft {
@@ -34,7 +35,13 @@ class KamaTrendStrategy final : public ISubStrategy,
     bool SaveState(AtomicState* out, std::string* error) const override;
     bool LoadState(const AtomicState& state, std::string* error) override;
 
+    // Indicator parameters after Init; the exit ATR periods are 0 when their mode is "none".
+    KamaTrendIndicatorSpec IndicatorSpec() const;
+
    private:
+    void UpdateOwnIndicators(const KamaTrendIndicatorBar& bar);
+    KamaTrendIndicatorValues OwnIndicatorValues() const;
+    void DetachSharedIndicators();
     int ClassifyDiff(double diff, double threshold) const;
     int ComputeOrderVolume(const AtomicStrategyContext& ctx, const std::string& instrument_id,
                            double atr_value) const;
@@ -69,6 +76,11 @@ class KamaTrendStrategy final : public ISubStrategy,
     std::unique_ptr<ADX> adx_;
     std::unique_ptr<ATR> stop_loss_atr_;
     std::unique_ptr<ATR> take_profit_atr_;
+    // Set while a KamaTrendIndicatorBatch computes the indicators above; they then lag behind by
+    // shared_indicator_step_ bars until DetachSharedIndicators() replays the recorded bars.
+    std::shared_ptr<KamaTrendIndicatorBatch> shared_indicators_;
+    std::size_t shared_indicator_index_{0};
+    std::size_t shared_indicator_step_{0};
     std::deque<double> kama_recent_;
     std::deque<double> kama_window_;
     double kama_window_sum_{0.0};
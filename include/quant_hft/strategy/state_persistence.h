@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "quant_hft/core/redis_hash_client.h"
 #include "quant_hft/strategy/live_strategy.h"
@@ -15,6 +16,19 @@ class IStrategyStatePersistence {
                                    const StrategyState& state, std::string* error) = 0;
     virtual bool LoadStrategyState(const std::string& account_id, const std::string& strategy_id,
                                    StrategyState* state, std::string* error) const = 0;
+    // Incremental save: `changed_fields` holds the entries of `state` that differ from the last
+    // successful save and `removed_fields` the keys that save had but `state` no longer has (both
+    // empty when nothing changed). Backends that can patch in place override this; the default
+    // rewrites the full state.
+    virtual bool SaveStrategyStateDelta(const std::string& account_id,
+                                        const std::string& strategy_id, const StrategyState& state,
+                                        const StrategyState& changed_fields,
+                                        const std::vector<std::string>& removed_fields,
+                                        std::string* error) {
+        (void)changed_fields;
+        (void)removed_fields;
+        return SaveStrategyState(account_id, strategy_id, state, error);
+    }
 };
 
 class RedisStrategyStatePersistence final : public IStrategyStatePersistence {
@@ -26,6 +40,11 @@ class RedisStrategyStatePersistence final : public IStrategyStatePersistence {
                            const StrategyState& state, std::string* error) override;
     bool LoadStrategyState(const std::string& account_id, const std::string& strategy_id,
                            StrategyState* state, std::string* error) const override;
+    // HSETs only the changed fields and HDELs the removed ones, then refreshes the TTL.
+    bool SaveStrategyStateDelta(const std::string& account_id, const std::string& strategy_id,
+                                const StrategyState& state, const StrategyState& changed_fields,
+                                const std::vector<std::string>& removed_fields,
+                                std::string* error) override;
 
    private:
     std::string BuildKey(const std::string& account_id, const std::string& strategy_id) const;
@@ -43,6 +62,12 @@ class FileStrategyStatePersistence final : public IStrategyStatePersistence {
                            const StrategyState& state, std::string* error) override;
     bool LoadStrategyState(const std::string& account_id, const std::string& strategy_id,
                            StrategyState* state, std::string* error) const override;
+    // The file is rewritten whole whenever a field changed or was removed. Unchanged state is
+    // skipped unless a TTL is configured, in which case the rewrite refreshes saved_epoch_seconds.
+    bool SaveStrategyStateDelta(const std::string& account_id, const std::string& strategy_id,
+                                const StrategyState& state, const StrategyState& changed_fields,
+                                const std::vector<std::string>& removed_fields,
+                                std::string* error) override;
 
    private:
     std::string BuildPath(const std::string& account_id, const std::string& strategy_id) const;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "quant_hft/strategy/state_persistence.h"
+
+namespace quant_hft {
+
+// Persists strategy state snapshots on a background thread so strategy workers only pay for
+// capturing the state map. A snapshot submitted while an older one for the same strategy is
+// still pending replaces it, and each write carries only the fields that changed since the
+// last successful write for that strategy.
+class StrategyStateSnapshotWriter {
+   public:
+    struct Stats {
+        std::uint64_t submitted{0};
+        std::uint64_t coalesced{0};
+        std::uint64_t written{0};
+        std::uint64_t unchanged{0};
+        std::uint64_t changed_fields{0};
+        std::uint64_t failures{0};
+    };
+
+    explicit StrategyStateSnapshotWriter(std::shared_ptr<IStrategyStatePersistence> persistence);
+    ~StrategyStateSnapshotWriter();
+
+    StrategyStateSnapshotWriter(const StrategyStateSnapshotWriter&) = delete;
+    StrategyStateSnapshotWriter& operator=(const StrategyStateSnapshotWriter&) = delete;
+
+    // Records `state` as already persisted (e.g. just loaded on start) so the next snapshot only
+    // writes fields that differ from it.
+    void SetBaseline(const std::string& account_id, const std::string& strategy_id,
+                     StrategyState state);
+    void Submit(const std::string& account_id, const std::string& strategy_id,
+                StrategyState state);
+    // Waits until every snapshot submitted before the call has been written or has failed.
+    bool Flush(std::int64_t timeout_ms);
+    Stats GetStats() const;
+
+   private:
+    using Key = std::pair<std::string, std::string>;
+
+    void Run();
+
+    std::shared_ptr<IStrategyStatePersistence> persistence_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<Key, StrategyState> pending_;
+    std::map<Key, StrategyState> pending_baselines_;
+    bool writing_{false};
+    bool stop_requested_{false};
+    Stats stats_;
+
+    // Last successfully written state per strategy; owned by the writer thread.
+    std::map<Key, StrategyState> written_;
+    std::thread thread_;
+};
+
+}  // namespace quant_hft
@@ -3,7 +3,6 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
-#include <deque>
 #include <functional>
 #include <future>
 #include <memory>
@@ -12,12 +11,14 @@
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
 #include "quant_hft/contracts/types.h"
 #include "quant_hft/strategy/composite_strategy.h"
 #include "quant_hft/strategy/live_strategy.h"
 #include "quant_hft/strategy/state_persistence.h"
+#include "quant_hft/strategy/state_snapshot_writer.h"
 
 namespace quant_hft {
 
@@ -38,6 +39,9 @@ struct StrategyEngineConfig {
     bool load_state_on_start{false};
     EpochNanos state_snapshot_interval_ns{0};
     EpochNanos metrics_collect_interval_ns{1'000'000'000};
+    // Strategies are pinned to one of `worker_count` workers by affinity key. Callbacks on
+    // different workers run concurrently, so sinks and resolvers must be thread-safe when > 1.
+    std::size_t worker_count{1};
 };
 
 class StrategyEngine {
@@ -53,6 +57,12 @@ class StrategyEngine {
         std::string strategy_id;
         std::string strategy_factory;
         StrategyContext context;
+        // Products this strategy trades. States and ticks tagged with another product are not
+        // routed to it; empty means every product.
+        std::vector<std::string> product_ids;
+        // Strategies sharing a key share a worker (e.g. a product or an account id). Defaults
+        // to the first product id, then the strategy id.
+        std::string affinity_key;
     };
 
     struct Stats {
@@ -64,6 +74,9 @@ class StrategyEngine {
         std::uint64_t strategy_callback_exceptions{0};
         std::uint64_t state_snapshot_runs{0};
         std::uint64_t state_snapshot_failures{0};
+        std::uint64_t state_snapshot_writes{0};
+        std::uint64_t state_snapshot_coalesced{0};
+        std::uint64_t state_snapshot_unchanged{0};
         std::uint64_t metrics_collection_runs{0};
     };
 
@@ -105,79 +118,152 @@ class StrategyEngine {
                                   std::uint64_t contract_generation, std::int64_t timeout_ms);
 
     Stats GetStats() const;
+    std::size_t worker_count() const { return workers_.size(); }
 
    private:
-    enum class EventType {
-        kState,
-        kMarketTick,
-        kOrderEvent,
-        kAccountSnapshot,
-        kReconcilePositions,
-        kContractSwitch,
-        kContractWarmupState,
+    struct StateEvent {
+        StateSnapshot7D state;
+        std::string product_id;
+        std::uint64_t contract_generation{0};
+        bool emit_intents{true};
     };
 
-    struct EngineEvent {
-        EventType type{EventType::kState};
-        StateSnapshot7D state;
-        MarketSnapshot market_tick;
-        OrderEvent order_event;
-        TradingAccountSnapshot account_snapshot;
-        std::string reconcile_account_id;
-        std::unordered_map<std::string, std::int32_t> reconcile_net;
-        std::unordered_map<std::string, double> reconcile_avg_open;
+    struct MarketTickEvent {
+        MarketSnapshot snapshot;
         std::string product_id;
         std::uint64_t contract_generation{0};
         bool emit_intents{true};
-        ContractSwitchContext contract_switch;
+    };
+
+    struct ReconcileEvent {
+        std::string account_id;
+        std::unordered_map<std::string, std::int32_t> authoritative_net;
+        std::unordered_map<std::string, double> authoritative_avg_open;
+    };
+
+    // Shared by the copies of one contract switch queued on every worker. Workers reset their
+    // strategies, meet at the barrier to agree on the warmup length, then replay; the last
+    // worker to finish fulfils the promise.
+    struct ContractSwitchBarrier {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t participants{0};
+        std::size_t reset_arrivals{0};
+        std::size_t finished{0};
+        ContractSwitchReport report;
+        std::promise<ContractSwitchReport> promise;
+    };
+
+    struct ContractSwitchEvent {
+        ContractSwitchContext context;
         std::vector<StateSnapshot7D> warmup_states;
-        std::shared_ptr<std::promise<ContractSwitchReport>> contract_switch_promise;
-        std::shared_ptr<std::promise<bool>> contract_warmup_promise;
+        std::shared_ptr<ContractSwitchBarrier> barrier;
     };
 
+    struct ContractWarmupCompletion {
+        std::atomic<std::size_t> remaining{0};
+        std::atomic<bool> success{true};
+        std::promise<bool> promise;
+    };
+
+    struct ContractWarmupEvent {
+        StateEvent state;
+        std::shared_ptr<ContractWarmupCompletion> completion;
+    };
+
+    // Hot-path state and tick payloads are stored inline; larger or rarer payloads are boxed
+    // so a queue slot stays close to the size of one state snapshot.
+    using EngineEvent =
+        std::variant<std::monostate, StateEvent, MarketTickEvent, std::unique_ptr<OrderEvent>,
+                     TradingAccountSnapshot, std::unique_ptr<ReconcileEvent>,
+                     std::unique_ptr<ContractSwitchEvent>, std::unique_ptr<ContractWarmupEvent>>;
+
     struct StrategyEntry {
         std::string strategy_id;
         std::string account_id;
+        std::vector<std::string> product_ids;
         std::unique_ptr<ILiveStrategy> strategy;
     };
 
-    void EnqueueEvent(EngineEvent event);
-    void WorkerLoop();
-    bool DispatchState(const StateSnapshot7D& state, const std::string& product_id,
-                       std::uint64_t contract_generation, bool emit_intents);
-    void DispatchMarketTick(const MarketSnapshot& snapshot, const std::string& product_id,
-                            std::uint64_t contract_generation, bool emit_intents);
-    void DispatchOrderEvent(const OrderEvent& event);
-    void DispatchAccountSnapshot(const TradingAccountSnapshot& snapshot);
+    struct Worker {
+        mutable std::mutex mutex;
+        std::condition_variable cv;
+        // Bounded ring pre-allocated to queue_capacity. Ordinary events drop the oldest
+        // ordinary event when full; contract control events are never dropped and grow the
+        // ring instead.
+        std::vector<EngineEvent> events;
+        std::size_t events_head{0};
+        std::size_t events_size{0};
+        bool dispatching{false};
+        bool stop_requested{false};
+        std::uint64_t enqueued_events{0};
+        std::uint64_t processed_events{0};
+        std::uint64_t dropped_oldest_events{0};
+        std::vector<StrategyMetric> cached_metrics;
+        // Owned by the worker thread.
+        std::vector<std::size_t> strategy_indices;
+        EpochNanos last_state_snapshot_ns{0};
+        EpochNanos last_metrics_collect_ns{0};
+        std::thread thread;
+    };
+
+    // Immutable per Start(); maps event keys to the workers owning affected strategies.
+    struct Routing {
+        std::vector<std::size_t> active_workers;
+        std::vector<std::size_t> unscoped_workers;
+        std::unordered_map<std::string, std::vector<std::size_t>> workers_by_product;
+        std::unordered_map<std::string, std::vector<std::size_t>> workers_by_account;
+        std::unordered_map<std::string, std::size_t> worker_by_strategy;
+    };
+
+    std::shared_ptr<const Routing> CurrentRouting() const;
+    const std::vector<std::size_t>& ProductWorkers(const Routing* routing,
+                                                   const std::string& product_id) const;
+    template <typename MakeEvent>
+    void EnqueueRouted(const std::vector<std::size_t>& worker_indices, MakeEvent make_event);
+    void EnqueueEvent(Worker& worker, EngineEvent event);
+    static void PushEventLocked(Worker& worker, EngineEvent event);
+    static void ClearEventsLocked(Worker& worker);
+    void WorkerLoop(Worker& worker);
+    void DispatchEvent(Worker& worker, EngineEvent& event);
+    bool DispatchState(const Worker& worker, const StateSnapshot7D& state,
+                       const std::string& product_id, std::uint64_t contract_generation,
+                       bool emit_intents);
+    void DispatchMarketTick(const Worker& worker, const MarketSnapshot& snapshot,
+                            const std::string& product_id, std::uint64_t contract_generation,
+                            bool emit_intents);
+    void DispatchOrderEvent(const Worker& worker, const OrderEvent& event);
+    void DispatchAccountSnapshot(const Worker& worker, const TradingAccountSnapshot& snapshot);
     void DispatchReconcilePositions(
-        const std::string& account_id,
+        const Worker& worker, const std::string& account_id,
         const std::unordered_map<std::string, std::int32_t>& authoritative_net,
         const std::unordered_map<std::string, double>& authoritative_avg_open);
-    void DispatchTimer(EpochNanos now_ns);
-    ContractSwitchReport DispatchContractSwitch(const ContractSwitchContext& context,
-                                                const std::vector<StateSnapshot7D>& warmup_states);
-    void MaybeSnapshotStates(EpochNanos now_ns);
-    void SnapshotStates(EpochNanos now_ns);
-    void MaybeCollectMetrics(EpochNanos now_ns);
+    void DispatchTimer(Worker& worker, EpochNanos now_ns);
+    void DispatchContractSwitch(const Worker& worker, const ContractSwitchEvent& event);
+    void MaybeSnapshotStates(Worker& worker, EpochNanos now_ns);
+    void SnapshotStates(const std::vector<std::size_t>& strategy_indices);
+    void MaybeCollectMetrics(Worker& worker, EpochNanos now_ns);
     void EmitIntents(const std::string& strategy_id, std::vector<SignalIntent> intents,
                      const std::string& product_id = {}, std::uint64_t contract_generation = 0);
 
     StrategyEngineConfig config_;
     IntentSink intent_sink_;
 
+    // Guards lifecycle flags, routing_ swaps and the engine-wide stats_ counters; each worker's
+    // queue has its own lock so producers for different workers do not contend.
     mutable std::mutex mutex_;
-    std::condition_variable cv_;
-    std::deque<EngineEvent> queue_;
     std::vector<StrategyEntry> strategies_;
-    std::vector<StrategyMetric> cached_metrics_;
+    // Swapped atomically under mutex_ so producers can load it without taking the lock.
+    std::shared_ptr<const Routing> routing_;
     Stats stats_;
     bool running_{false};
     bool stop_requested_{false};
-    bool dispatching_{false};
-    EpochNanos last_state_snapshot_ns_{0};
-    EpochNanos last_metrics_collect_ns_{0};
 
-    std::thread worker_thread_;
+    // Sized once in the constructor so producers can index it without the engine lock.
+    std::vector<std::unique_ptr<Worker>> workers_;
+    // Present when state_persistence is configured; outlives Start/Stop cycles so dirty-field
+    // tracking carries across restarts of the engine.
+    std::unique_ptr<StrategyStateSnapshotWriter> state_writer_;
 };
 
 }  // namespace quant_hft
@@ -462,6 +462,9 @@ max_ticks="$(cfg_get "max_ticks" "")"
 start_date="$(cfg_get "start_date" "")"
 end_date="$(cfg_get "end_date" "")"
 deterministic_fills="$(cfg_get "deterministic_fills" "true")"
+product_parallelism="$(cfg_get "product_parallelism" "")"
+product_sync_granularity="$(cfg_get "product_sync_granularity" "")"
+bar_cache_dir="$(cfg_get "bar_cache_dir" "")"
 strict_parquet="$(cfg_get "strict_parquet" "true")"
 rollover_mode="$(cfg_get "rollover_mode" "strict")"
 rollover_price_mode="$(cfg_get "rollover_price_mode" "bbo")"
@@ -746,6 +749,9 @@ append_arg_if_set backtest_cmd --start_date "${start_date}"
 append_arg_if_set backtest_cmd --end_date "${end_date}"
 append_arg_if_set backtest_cmd --detector_config "${detector_config}"
 append_arg_if_set backtest_cmd --deterministic_fills "${deterministic_fills}"
+append_arg_if_set backtest_cmd --product_parallelism "${product_parallelism}"
+append_arg_if_set backtest_cmd --product_sync_granularity "${product_sync_granularity}"
+append_arg_if_set backtest_cmd --bar_cache_dir "${bar_cache_dir}"
 append_arg_if_set backtest_cmd --strict_parquet "${strict_parquet}"
 append_arg_if_set backtest_cmd --rollover_mode "${rollover_mode}"
 append_arg_if_set backtest_cmd --rollover_price_mode "${rollover_price_mode}"
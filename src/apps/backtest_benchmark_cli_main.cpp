@@ -2,9 +2,11 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "quant_hft/apps/backtest_replay_support.h"
+#include "quant_hft/core/simple_json.h"
 
 int main(int argc, char** argv) {
     using namespace quant_hft::apps;
@@ -27,14 +29,33 @@ int main(int argc, char** argv) {
             std::ostringstream content;
             content << baseline_in.rdbuf();
             const std::string baseline_json = content.str();
-            detail::ExtractJsonNumber(baseline_json, "old_p95_ms", &baseline_old_p95_ms);
+            double baseline_max_p95_ms = 0.0;
+            quant_hft::simple_json::ObjectCursor cursor(baseline_json);
+            std::string_view key;
+            quant_hft::simple_json::RawValue value;
+            while (cursor.Next(&key, &value)) {
+                if (key == "old_p95_ms") {
+                    value.GetNumber(&baseline_old_p95_ms);
+                } else if (key == "max_p95_ms") {
+                    value.GetNumber(&baseline_max_p95_ms);
+                } else if (key == "max_ticks") {
+                    value.GetNumber(&baseline_max_ticks);
+                } else if (key == "runs") {
+                    value.GetNumber(&baseline_runs);
+                } else if (key == "warmup_runs") {
+                    value.GetNumber(&baseline_warmup_runs);
+                } else if (key == "min_ticks_read") {
+                    value.GetNumber(&baseline_min_ticks);
+                }
+            }
+            if (!cursor.ok()) {
+                std::cerr << "backtest_benchmark_cli: invalid baseline json " << baseline_file
+                          << ": " << cursor.error() << '\n';
+                return 2;
+            }
             if (baseline_old_p95_ms <= 0.0) {
-                detail::ExtractJsonNumber(baseline_json, "max_p95_ms", &baseline_old_p95_ms);
+                baseline_old_p95_ms = baseline_max_p95_ms;
             }
-            detail::ExtractJsonNumber(baseline_json, "max_ticks", &baseline_max_ticks);
-            detail::ExtractJsonNumber(baseline_json, "runs", &baseline_runs);
-            detail::ExtractJsonNumber(baseline_json, "warmup_runs", &baseline_warmup_runs);
-            detail::ExtractJsonNumber(baseline_json, "min_ticks_read", &baseline_min_ticks);
         }
     }
 
@@ -2,6 +2,7 @@
 #include <string>
 
 #include "quant_hft/apps/backtest_replay_support.h"
+#include "quant_hft/optim/result_analyzer.h"
 
 int main(int argc, char** argv) {
     using namespace quant_hft::apps;
@@ -33,6 +34,16 @@ int main(int argc, char** argv) {
         std::cerr << "backtest_cli: " << error << '\n';
         return 1;
     }
+    if (!output_paths.output_json.empty()) {
+        // The sidecar only saves parameter_optim_cli a re-parse of result.json; failing to
+        // write it leaves the JSON authoritative.
+        using quant_hft::optim::ResultAnalyzer;
+        quant_hft::optim::TrialResultRecord record;
+        if (!ResultAnalyzer::DecodeTrialResultJsonText(json, &record, &error) ||
+            !ResultAnalyzer::WriteTrialResultSidecar(output_paths.output_json, record, &error)) {
+            std::cerr << "backtest_cli: skip result sidecar: " << error << '\n';
+        }
+    }
     if (!WriteTextFile(output_paths.output_md, markdown, &error)) {
         std::cerr << "backtest_cli: " << error << '\n';
         return 1;
@@ -1,15 +1,17 @@
 #include <algorithm>
-#include <cctype>
 #include <cmath>
 #include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "quant_hft/apps/backtest_replay_support.h"
+#include "quant_hft/core/simple_json.h"
 
 namespace {
 
@@ -71,210 +73,53 @@ bool ReadTextFile(const std::string& path, std::string* out, std::string* error)
     return true;
 }
 
-bool ExtractJsonValueStart(const std::string& json,
-                           const std::string& key,
-                           std::size_t* value_start) {
-    if (value_start == nullptr) {
-        return false;
+using JsonMembers = std::map<std::string, quant_hft::simple_json::RawValue>;
+
+// Top-level members of one JSON object; values stay views into `json`.
+bool CollectJsonMembers(std::string_view json, JsonMembers* out, std::string* error) {
+    quant_hft::simple_json::ObjectCursor cursor(json);
+    std::string_view key;
+    quant_hft::simple_json::RawValue value;
+    while (cursor.Next(&key, &value)) {
+        (*out)[std::string(key)] = value;
     }
-    const std::string quoted_key = "\"" + key + "\"";
-    std::size_t key_pos = json.find(quoted_key);
-    std::size_t colon_pos = std::string::npos;
-    while (key_pos != std::string::npos) {
-        std::size_t key_end = key_pos + quoted_key.size();
-        while (key_end < json.size() &&
-               std::isspace(static_cast<unsigned char>(json[key_end])) != 0) {
-            ++key_end;
-        }
-        if (key_end < json.size() && json[key_end] == ':') {
-            colon_pos = key_end;
-            break;
+    if (!cursor.ok()) {
+        if (error != nullptr) {
+            *error = cursor.error();
         }
-        key_pos = json.find(quoted_key, key_pos + quoted_key.size());
-    }
-    if (colon_pos == std::string::npos) {
         return false;
     }
-    std::size_t cursor = colon_pos + 1;
-    while (cursor < json.size() && std::isspace(static_cast<unsigned char>(json[cursor])) != 0) {
-        ++cursor;
-    }
-    if (cursor >= json.size()) {
-        return false;
-    }
-    *value_start = cursor;
     return true;
 }
 
-bool ExtractJsonObjectByKey(const std::string& json,
-                            const std::string& key,
-                            std::string* out_object) {
-    if (out_object == nullptr) {
-        return false;
-    }
-    std::size_t start = 0;
-    if (!ExtractJsonValueStart(json, key, &start) || json[start] != '{') {
-        return false;
-    }
-
-    int depth = 0;
-    bool in_string = false;
-    bool escaped = false;
-    for (std::size_t i = start; i < json.size(); ++i) {
-        const char ch = json[i];
-        if (in_string) {
-            if (escaped) {
-                escaped = false;
-                continue;
-            }
-            if (ch == '\\') {
-                escaped = true;
-                continue;
-            }
-            if (ch == '"') {
-                in_string = false;
-            }
-            continue;
-        }
-        if (ch == '"') {
-            in_string = true;
-            continue;
-        }
-        if (ch == '{') {
-            ++depth;
-            continue;
-        }
-        if (ch == '}') {
-            --depth;
-            if (depth == 0) {
-                *out_object = json.substr(start, i - start + 1);
-                return true;
-            }
+bool ExtractRequiredObject(const JsonMembers& parent,
+                           const std::string& key,
+                           JsonMembers* out,
+                           std::string* error) {
+    const auto it = parent.find(key);
+    if (it == parent.end() ||
+        it->second.type != quant_hft::simple_json::Value::Type::kObject) {
+        if (error != nullptr) {
+            *error = "baseline missing object: " + key;
         }
-    }
-    return false;
-}
-
-bool ExtractJsonArrayByKey(const std::string& json, const std::string& key, std::string* out_array) {
-    if (out_array == nullptr) {
         return false;
     }
-    std::size_t start = 0;
-    if (!ExtractJsonValueStart(json, key, &start) || json[start] != '[') {
-        return false;
-    }
-
-    int depth = 0;
-    bool in_string = false;
-    bool escaped = false;
-    for (std::size_t i = start; i < json.size(); ++i) {
-        const char ch = json[i];
-        if (in_string) {
-            if (escaped) {
-                escaped = false;
-                continue;
-            }
-            if (ch == '\\') {
-                escaped = true;
-                continue;
-            }
-            if (ch == '"') {
-                in_string = false;
-            }
-            continue;
-        }
-        if (ch == '"') {
-            in_string = true;
-            continue;
-        }
-        if (ch == '[') {
-            ++depth;
-            continue;
-        }
-        if (ch == ']') {
-            --depth;
-            if (depth == 0) {
-                *out_array = json.substr(start, i - start + 1);
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-std::int64_t CountJsonArrayElements(const std::string& array_json) {
-    if (array_json.size() < 2 || array_json.front() != '[' || array_json.back() != ']') {
-        return 0;
-    }
-
-    bool in_string = false;
-    bool escaped = false;
-    int brace_depth = 0;
-    int bracket_depth = 0;
-    bool has_token = false;
-    std::int64_t commas = 0;
-
-    for (std::size_t i = 1; i + 1 < array_json.size(); ++i) {
-        const char ch = array_json[i];
-        if (in_string) {
-            if (escaped) {
-                escaped = false;
-                continue;
-            }
-            if (ch == '\\') {
-                escaped = true;
-                continue;
-            }
-            if (ch == '"') {
-                in_string = false;
-            }
-            has_token = true;
-            continue;
-        }
-        if (std::isspace(static_cast<unsigned char>(ch)) != 0) {
-            continue;
-        }
-        if (ch == '"') {
-            in_string = true;
-            has_token = true;
-            continue;
-        }
-        if (ch == '{') {
-            ++brace_depth;
-            has_token = true;
-            continue;
-        }
-        if (ch == '}') {
-            --brace_depth;
-            continue;
-        }
-        if (ch == '[') {
-            ++bracket_depth;
-            has_token = true;
-            continue;
-        }
-        if (ch == ']') {
-            --bracket_depth;
-            continue;
-        }
-        if (ch == ',' && brace_depth == 0 && bracket_depth == 0) {
-            ++commas;
-            continue;
+    std::string member_error;
+    if (!CollectJsonMembers(it->second.text, out, &member_error)) {
+        if (error != nullptr) {
+            *error = "baseline object " + key + " is invalid: " + member_error;
         }
-        has_token = true;
-    }
-
-    if (!has_token) {
-        return 0;
+        return false;
     }
-    return commas + 1;
+    return true;
 }
 
-bool ExtractRequiredNumber(const std::string& json,
+bool ExtractRequiredNumber(const JsonMembers& members,
                            const std::string& key,
                            double* out,
                            std::string* error) {
-    if (!quant_hft::apps::detail::ExtractJsonNumber(json, key, out)) {
+    const auto it = members.find(key);
+    if (it == members.end() || !it->second.GetNumber(out)) {
         if (error != nullptr) {
             *error = "missing numeric key: " + key;
         }
@@ -283,6 +128,24 @@ bool ExtractRequiredNumber(const std::string& json,
     return true;
 }
 
+bool CountRequiredArray(const JsonMembers& members,
+                        const std::string& key,
+                        std::int64_t* out,
+                        std::string* error) {
+    const auto it = members.find(key);
+    quant_hft::simple_json::Value array;
+    if (it == members.end() ||
+        it->second.type != quant_hft::simple_json::Value::Type::kArray ||
+        !it->second.Parse(&array)) {
+        if (error != nullptr) {
+            *error = "baseline missing array: deterministic." + key;
+        }
+        return false;
+    }
+    *out = static_cast<std::int64_t>(array.array_value.size());
+    return true;
+}
+
 bool ParseBaselineExpectation(const std::string& baseline_json,
                               BaselineExpectation* out,
                               std::string* error) {
@@ -293,9 +156,17 @@ bool ParseBaselineExpectation(const std::string& baseline_json,
         return false;
     }
 
+    JsonMembers baseline;
+    std::string json_error;
+    if (!CollectJsonMembers(baseline_json, &baseline, &json_error)) {
+        if (error != nullptr) {
+            *error = "baseline is not a json object: " + json_error;
+        }
+        return false;
+    }
     for (const std::string& key :
          {"run_id", "mode", "spec", "replay", "deterministic", "summary"}) {
-        if (baseline_json.find("\"" + key + "\"") == std::string::npos) {
+        if (baseline.find(key) == baseline.end()) {
             if (error != nullptr) {
                 *error = "baseline missing required key: " + key;
             }
@@ -304,66 +175,46 @@ bool ParseBaselineExpectation(const std::string& baseline_json,
     }
 
     BaselineExpectation parsed;
-    std::string summary_object;
-    std::string deterministic_object;
-    if (!ExtractJsonObjectByKey(baseline_json, "summary", &summary_object)) {
-        if (error != nullptr) {
-            *error = "baseline missing object: summary";
-        }
-        return false;
-    }
-    if (!ExtractJsonObjectByKey(baseline_json, "deterministic", &deterministic_object)) {
-        if (error != nullptr) {
-            *error = "baseline missing object: deterministic";
-        }
+    JsonMembers summary;
+    JsonMembers deterministic;
+    if (!ExtractRequiredObject(baseline, "summary", &summary, error) ||
+        !ExtractRequiredObject(baseline, "deterministic", &deterministic, error)) {
         return false;
     }
 
     double numeric = 0.0;
-    if (!ExtractRequiredNumber(summary_object, "intents_emitted", &numeric, error)) {
+    if (!ExtractRequiredNumber(summary, "intents_emitted", &numeric, error)) {
         return false;
     }
     parsed.intents_emitted = static_cast<std::int64_t>(std::llround(numeric));
 
-    if (!ExtractRequiredNumber(summary_object, "order_events", &numeric, error)) {
+    if (!ExtractRequiredNumber(summary, "order_events", &numeric, error)) {
         return false;
     }
     parsed.order_events = static_cast<std::int64_t>(std::llround(numeric));
 
-    if (!ExtractRequiredNumber(summary_object, "total_pnl", &parsed.total_pnl, error)) {
+    if (!ExtractRequiredNumber(summary, "total_pnl", &parsed.total_pnl, error)) {
         return false;
     }
 
-    if (!ExtractRequiredNumber(summary_object, "max_drawdown", &parsed.max_drawdown, error)) {
+    if (!ExtractRequiredNumber(summary, "max_drawdown", &parsed.max_drawdown, error)) {
         return false;
     }
 
     if (!ExtractRequiredNumber(
-            deterministic_object, "rollover_slippage_cost", &parsed.rollover_slippage_cost, error)) {
+            deterministic, "rollover_slippage_cost", &parsed.rollover_slippage_cost, error)) {
         return false;
     }
 
-    if (!ExtractRequiredNumber(deterministic_object, "rollover_canceled_orders", &numeric, error)) {
+    if (!ExtractRequiredNumber(deterministic, "rollover_canceled_orders", &numeric, error)) {
         return false;
     }
     parsed.rollover_canceled_orders = static_cast<std::int64_t>(std::llround(numeric));
 
-    std::string rollover_events;
-    std::string rollover_actions;
-    if (!ExtractJsonArrayByKey(deterministic_object, "rollover_events", &rollover_events)) {
-        if (error != nullptr) {
-            *error = "baseline missing array: deterministic.rollover_events";
-        }
-        return false;
-    }
-    if (!ExtractJsonArrayByKey(deterministic_object, "rollover_actions", &rollover_actions)) {
-        if (error != nullptr) {
-            *error = "baseline missing array: deterministic.rollover_actions";
-        }
+    if (!CountRequiredArray(deterministic, "rollover_events", &parsed.rollover_events, error) ||
+        !CountRequiredArray(deterministic, "rollover_actions", &parsed.rollover_actions, error)) {
         return false;
     }
-    parsed.rollover_events = CountJsonArrayElements(rollover_events);
-    parsed.rollover_actions = CountJsonArrayElements(rollover_actions);
 
     *out = parsed;
     return true;
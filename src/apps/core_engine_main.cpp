@@ -23,6 +23,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "quant_hft/apps/startup_bundle.h"
+#include "quant_hft/contracts/instrument_utils.h"
 #include "quant_hft/contracts/types.h"
 #include "quant_hft/core/circuit_breaker.h"
 #include "quant_hft/core/ctp_config_loader.h"
@@ -32,6 +34,7 @@
 #include "quant_hft/core/ctp_trader_adapter.h"
 #include "quant_hft/core/flow_controller.h"
 #include "quant_hft/core/instrument_meta_cache.h"
+#include "quant_hft/core/instrument_registry.h"
 #include "quant_hft/core/local_wal_regulatory_sink.h"
 #include "quant_hft/core/market_bus_producer.h"
 #include "quant_hft/core/redis_realtime_store_client_adapter.h"
@@ -55,6 +58,7 @@
 #include "quant_hft/services/dominant_contract_coordinator.h"
 #include "quant_hft/services/execution_engine.h"
 #include "quant_hft/services/execution_planner.h"
+#include "quant_hft/services/execution_scheduler.h"
 #include "quant_hft/services/execution_router.h"
 #include "quant_hft/services/in_memory_portfolio_ledger.h"
 #include "quant_hft/services/market_bar_pipeline.h"
@@ -221,8 +225,10 @@ void EmitCompositeStrategyInitLogs(const quant_hft::CtpRuntimeConfig& config,
 }
 
 bool ParseArgs(int argc, char** argv, std::string* config_path, int* run_seconds,
-               bool* force_instrument_refresh, std::string* error) {
-    if (config_path == nullptr || run_seconds == nullptr || force_instrument_refresh == nullptr) {
+               bool* force_instrument_refresh, std::string* startup_bundle_path,
+               std::string* error) {
+    if (config_path == nullptr || run_seconds == nullptr || force_instrument_refresh == nullptr ||
+        startup_bundle_path == nullptr) {
         if (error != nullptr) {
             *error = "output argument pointer is null";
         }
@@ -235,6 +241,8 @@ bool ParseArgs(int argc, char** argv, std::string* config_path, int* run_seconds
     *config_path = quant_hft::GetEnvOrDefault("CTP_CONFIG_PATH", default_config);
     *run_seconds = 0;
     *force_instrument_refresh = false;
+    *startup_bundle_path =
+        quant_hft::GetEnvOrDefault("STARTUP_BUNDLE_PATH", "runtime/startup_bundle.bin");
 
     for (int i = 1; i < argc; ++i) {
         const std::string arg = argv[i];
@@ -263,6 +271,20 @@ bool ParseArgs(int argc, char** argv, std::string* config_path, int* run_seconds
             *config_path = value;
             continue;
         }
+        if (arg == "--startup-bundle") {
+            if (i + 1 >= argc) {
+                if (error != nullptr) {
+                    *error = "--startup-bundle requires a value";
+                }
+                return false;
+            }
+            *startup_bundle_path = argv[++i];
+            continue;
+        }
+        if (arg.rfind("--startup-bundle=", 0) == 0) {
+            *startup_bundle_path = arg.substr(std::string("--startup-bundle=").size());
+            continue;
+        }
         if (arg == "--run-seconds") {
             if (i + 1 >= argc) {
                 if (error != nullptr) {
@@ -1013,6 +1035,17 @@ std::vector<std::string> ResolveStrategyIds(const quant_hft::CtpFileConfig& conf
     return {"demo"};
 }
 
+// Product a composite strategy is configured for, lower-cased like CompositeStrategy matches it;
+// empty when the config names none (the strategy then trades every product).
+std::string ResolveCompositeProductId(const std::string& composite_config_path) {
+    quant_hft::CompositeStrategyDefinition definition;
+    std::string error;
+    if (!quant_hft::LoadCompositeStrategyDefinition(composite_config_path, &definition, &error)) {
+        return {};
+    }
+    return ToLowerAscii(TrimAscii(definition.product_id));
+}
+
 std::vector<std::int32_t> ResolveStrategyTimeframes(const quant_hft::CtpFileConfig& config,
                                                     const std::vector<std::string>& strategy_ids,
                                                     std::string* error) {
@@ -1597,9 +1630,11 @@ int main(int argc, char** argv) {
     std::string config_path;
     int run_seconds = 0;
     bool force_instrument_refresh = false;
+    std::string startup_bundle_path;
     std::string parse_error;
+    StartupPhaseTimer startup_phases;
     if (!ParseArgs(argc, argv, &config_path, &run_seconds, &force_instrument_refresh,
-                   &parse_error)) {
+                   &startup_bundle_path, &parse_error)) {
         EmitStructuredLog(&bootstrap_runtime, "core_engine", "error", "invalid_arguments",
                           {{"error", parse_error}});
         return 1;
@@ -1613,6 +1648,42 @@ int main(int argc, char** argv) {
         return 1;
     }
     const auto& config = file_config.runtime;
+    startup_phases.Mark("config_load");
+
+    // Sections of the startup bundle stand in for their text sources only while those files
+    // are unchanged; anything else is parsed from text as before.
+    StartupBundle startup_bundle;
+    bool startup_bundle_loaded = false;
+    if (!startup_bundle_path.empty()) {
+        std::string bundle_error;
+        startup_bundle_loaded =
+            LoadStartupBundle(startup_bundle_path, &startup_bundle, &bundle_error);
+        std::string sessions_reason = startup_bundle_loaded ? "absent" : bundle_error;
+        bool sessions_installed = false;
+        if (startup_bundle_loaded && startup_bundle.has_sessions) {
+            const TradingSessionCalendarConfig session_config;
+            const auto& sessions = startup_bundle.sessions;
+            if (sessions.source.path != CompiledSessionCalendar::ResolveConfigPath(
+                                            session_config.trading_sessions_config_path) ||
+                sessions.use_default_fallback != session_config.use_default_session_fallback) {
+                sessions_reason = "config_mismatch";
+            } else if (IsStartupBundleSourceCurrent(sessions.source, &sessions_reason)) {
+                CompiledSessionCalendar::InstallShared(sessions.source.path,
+                                                       sessions.use_default_fallback,
+                                                       sessions.rules);
+                sessions_installed = true;
+                sessions_reason.clear();
+            }
+        }
+        EmitStructuredLog(
+            &config, "core_engine", "info",
+            startup_bundle_loaded ? "startup_bundle_loaded" : "startup_bundle_unavailable",
+            {{"path", startup_bundle_path},
+             {"products", std::to_string(startup_bundle.instrument_caches.size())},
+             {"sessions_installed", sessions_installed ? "true" : "false"},
+             {"sessions_reason", sessions_reason}});
+    }
+    startup_phases.Mark("startup_bundle");
     const bool dominant_contract_mode =
         file_config.active_contract_mode == "dominant_open_interest";
     const auto dominant_product_ids = dominant_contract_mode
@@ -1782,7 +1853,12 @@ int main(int argc, char** argv) {
     std::mutex submitted_order_ack_mutex;
     std::unordered_map<std::string, SubmittedOrderAckWatch> submitted_order_ack_watches;
     std::unordered_map<std::string, std::string> submitted_order_ack_by_submit_key;
+    // Submit keys with slices queued in execution_scheduler but not yet sent to the gateway.
+    std::unordered_map<std::string, std::int32_t> scheduled_submit_counts;
+    EpochNanos next_scheduled_suppress_log_ns = 0;
     std::function<void(const SignalIntent&)> process_signal_intent;
+    // Serializes intent and indicator-trace callbacks coming from multiple strategy workers.
+    std::mutex strategy_sink_mutex;
     std::unique_ptr<StrategyEngine> strategy_engine;
     KamaTraceCsvWriter kama_trace_writer;
     std::mutex timeframe_trace_mutex;
@@ -1828,6 +1904,8 @@ int main(int argc, char** argv) {
     };
     StrategyEngineConfig strategy_engine_config;
     strategy_engine_config.queue_capacity = strategy_queue_capacity;
+    strategy_engine_config.worker_count =
+        static_cast<std::size_t>(std::max(1, file_config.strategy_worker_count));
     strategy_engine_config.state_persistence = strategy_state_persistence;
     strategy_engine_config.indicator_trace_sink = [&](const StateSnapshot7D& state,
                                                       const std::string& engine_strategy_id,
@@ -1841,6 +1919,7 @@ int main(int argc, char** argv) {
             }
         }
         std::string trace_error;
+        std::lock_guard<std::mutex> sink_lock(strategy_sink_mutex);
         if (!kama_trace_writer.Append(minute, state, engine_strategy_id, row, &trace_error)) {
             EmitStructuredLog(&config, "core_engine", "error", "kama_trace_write_failed",
                               {{"instrument_id", state.instrument_id},
@@ -1870,6 +1949,7 @@ int main(int argc, char** argv) {
         static_cast<EpochNanos>(file_config.strategy_metrics_emit_interval_ms) * 1'000'000;
     strategy_engine =
         std::make_unique<StrategyEngine>(strategy_engine_config, [&](const SignalIntent& signal) {
+            std::lock_guard<std::mutex> lock(strategy_sink_mutex);
             if (process_signal_intent) {
                 process_signal_intent(signal);
             }
@@ -2267,6 +2347,33 @@ int main(int argc, char** argv) {
         const std::string submit_key = BuildExecutionSubmitCooldownKey(signal);
         LogFields fields;
         bool should_log = false;
+        bool scheduled_pending = false;
+        {
+            std::lock_guard<std::mutex> lock(submitted_order_ack_mutex);
+            if (const auto scheduled_it = scheduled_submit_counts.find(submit_key);
+                scheduled_it != scheduled_submit_counts.end()) {
+                if (now_ns >= next_scheduled_suppress_log_ns) {
+                    should_log = true;
+                    next_scheduled_suppress_log_ns = now_ns + retry_ns;
+                    fields = {{"strategy_id", signal.strategy_id},
+                              {"instrument_id", signal.instrument_id},
+                              {"signal_type", SignalTypeToString(signal.signal_type)},
+                              {"side", SideToString(signal.side)},
+                              {"offset", OffsetToString(signal.offset)},
+                              {"reason", "order_submit_scheduled"},
+                              {"scheduled_slices", std::to_string(scheduled_it->second)},
+                              {"trace_id", signal.trace_id}};
+                }
+                scheduled_pending = true;
+            }
+        }
+        if (scheduled_pending) {
+            if (should_log) {
+                EmitStructuredLog(&config, "core_engine", "warn",
+                                  "execution_submit_retry_suppressed", fields);
+            }
+            return true;
+        }
         {
             std::lock_guard<std::mutex> lock(submitted_order_ack_mutex);
             const auto key_it = submitted_order_ack_by_submit_key.find(submit_key);
@@ -2640,6 +2747,209 @@ int main(int argc, char** argv) {
         return stored;
     };
 
+    // Runs on an ExecutionScheduler lane: reserves ledger funds/positions, submits the slice and
+    // settles the reservation from the gateway result, keeping the strategy thread unblocked.
+    auto submit_planned_order = [&](const PlannedOrder& planned,
+                                    std::int64_t observed_market_volume) {
+        const auto& intent = planned.intent;
+        if (dominant_contract_mode) {
+            SignalIntent order_validation_signal;
+            order_validation_signal.strategy_id = intent.strategy_id;
+            order_validation_signal.instrument_id = intent.instrument_id;
+            order_validation_signal.signal_type =
+                intent.offset == OffsetFlag::kOpen ? SignalType::kOpen : SignalType::kClose;
+            order_validation_signal.side = intent.side;
+            order_validation_signal.offset = intent.offset;
+            order_validation_signal.trace_id = intent.trace_id;
+            order_validation_signal.product_id = intent.product_id;
+            order_validation_signal.contract_generation = intent.contract_generation;
+            std::int32_t broker_close_volume = 0;
+            if (intent.offset != OffsetFlag::kOpen) {
+                const PositionDirection close_direction = intent.side == Side::kSell
+                                                              ? PositionDirection::kLong
+                                                              : PositionDirection::kShort;
+                const std::string exchange_id =
+                    InferCtpExchangeIdFromInstrumentId(intent.instrument_id);
+                std::lock_guard<std::mutex> lock(ctp_ledger_mutex);
+                for (const std::string& position_date :
+                     {std::string("today"), std::string("yesterday")}) {
+                    broker_close_volume +=
+                        ctp_position_ledger
+                            .GetPosition(account_id, intent.instrument_id, close_direction,
+                                         position_date, exchange_id)
+                            .position;
+                }
+            }
+            const auto validation = dominant_contract_coordinator.ValidateSignal(
+                order_validation_signal, broker_close_volume);
+            if (!validation.allowed) {
+                EmitOrderRejectedIntentLog(config, intent,
+                                           "dominant_contract:" + validation.reason,
+                                           ExecutionMetadata{});
+                process_order_event(BuildRejectedEvent(
+                    intent, "dominant_contract:" + validation.reason, ExecutionMetadata{}));
+                return;
+            }
+        }
+        ExecutionMetadata metadata;
+        metadata.strategy_id = intent.strategy_id;
+        metadata.execution_algo_id = planned.execution_algo_id;
+        metadata.slice_index = planned.slice_index;
+        metadata.slice_total = planned.slice_total;
+        const auto route =
+            execution_router.Route(planned, execution_config, observed_market_volume);
+        metadata.venue = route.venue;
+        metadata.route_id = route.route_id;
+        metadata.slippage_bps = route.slippage_bps;
+        metadata.impact_cost = route.impact_cost;
+        {
+            std::lock_guard<std::mutex> lock(execution_metadata_mutex);
+            execution_metadata_by_order[intent.client_order_id] = metadata;
+        }
+
+        bool throttle_applied = false;
+        double throttle_ratio = 0.0;
+        if (execution_config.throttle_reject_ratio > 0.0) {
+            std::lock_guard<std::mutex> lock(planner_mutex);
+            throttle_applied =
+                execution_planner.ShouldThrottle(execution_config.throttle_reject_ratio);
+            throttle_ratio = execution_planner.CurrentRejectRatio();
+        }
+        if (throttle_applied) {
+            RiskDecision throttle_decision;
+            throttle_decision.action = RiskAction::kReject;
+            throttle_decision.rule_id = "policy.execution.throttle.reject_ratio";
+            throttle_decision.rule_group = "execution";
+            throttle_decision.rule_version = "v1";
+            throttle_decision.policy_id = "policy.execution.throttle";
+            throttle_decision.policy_scope = "execution";
+            throttle_decision.observed_value = throttle_ratio;
+            throttle_decision.threshold_value = execution_config.throttle_reject_ratio;
+            throttle_decision.decision_tags = "execution,throttle";
+            throttle_decision.reason = "reject ratio exceeds threshold";
+            throttle_decision.decision_ts_ns = NowEpochNanos();
+            timeseries_store.AppendRiskDecision(intent, throttle_decision);
+
+            metadata.throttle_applied = true;
+            EmitOrderRejectedIntentLog(config, intent, "throttled:reject_ratio_exceeded",
+                                       metadata);
+            process_order_event(
+                BuildRejectedEvent(intent, "throttled:reject_ratio_exceeded", metadata));
+            return;
+        }
+
+        if (!order_state_machine.OnOrderIntent(intent)) {
+            EmitOrderRejectedIntentLog(config, intent,
+                                       "order_state_reject:duplicate_or_invalid", metadata);
+            process_order_event(BuildRejectedEvent(
+                intent, "order_state_reject:duplicate_or_invalid", metadata));
+        } else {
+            std::string ctp_ledger_error;
+            {
+                const auto ledger_intent = BuildCtpLedgerIntent(intent);
+                std::lock_guard<std::mutex> lock(ctp_ledger_mutex);
+                CtpOrderFundInputs fund_inputs;
+                fund_inputs.client_order_id = intent.client_order_id;
+                fund_inputs.price = intent.price;
+                fund_inputs.volume = intent.volume;
+                {
+                    std::lock_guard<std::mutex> fee_lock(fee_rate_mutex);
+                    const auto meta_it = instrument_meta_by_id.find(intent.instrument_id);
+                    if (meta_it != instrument_meta_by_id.end()) {
+                        fund_inputs.volume_multiple = meta_it->second.volume_multiple;
+                    }
+                    const auto margin_it = margin_rate_by_instrument.find(intent.instrument_id);
+                    if (intent.offset == OffsetFlag::kOpen &&
+                        margin_it != margin_rate_by_instrument.end()) {
+                        const auto direction = ResolveLedgerDirection(intent);
+                        if (direction == PositionDirection::kLong) {
+                            fund_inputs.margin_ratio_by_money =
+                                margin_it->second.long_margin_ratio_by_money;
+                            fund_inputs.margin_ratio_by_volume =
+                                margin_it->second.long_margin_ratio_by_volume;
+                        } else {
+                            fund_inputs.margin_ratio_by_money =
+                                margin_it->second.short_margin_ratio_by_money;
+                            fund_inputs.margin_ratio_by_volume =
+                                margin_it->second.short_margin_ratio_by_volume;
+                        }
+                    }
+                    const auto commission_it =
+                        commission_rate_by_instrument.find(intent.instrument_id);
+                    if (commission_it != commission_rate_by_instrument.end()) {
+                        if (intent.offset == OffsetFlag::kOpen) {
+                            fund_inputs.commission_ratio_by_money =
+                                commission_it->second.open_ratio_by_money;
+                            fund_inputs.commission_ratio_by_volume =
+                                commission_it->second.open_ratio_by_volume;
+                        } else if (intent.offset == OffsetFlag::kCloseToday) {
+                            fund_inputs.commission_ratio_by_money =
+                                commission_it->second.close_today_ratio_by_money;
+                            fund_inputs.commission_ratio_by_volume =
+                                commission_it->second.close_today_ratio_by_volume;
+                        } else {
+                            fund_inputs.commission_ratio_by_money =
+                                commission_it->second.close_ratio_by_money;
+                            fund_inputs.commission_ratio_by_volume =
+                                commission_it->second.close_ratio_by_volume;
+                        }
+                    }
+                    const auto order_comm_it =
+                        order_comm_rate_by_instrument.find(intent.instrument_id);
+                    if (order_comm_it != order_comm_rate_by_instrument.end()) {
+                        fund_inputs.commission_ratio_by_volume +=
+                            order_comm_it->second.order_comm_by_volume;
+                    }
+                }
+                std::string ctp_account_error;
+                if (!ctp_account_ledger.ReserveOrderFunds(fund_inputs, &ctp_account_error)) {
+                    EmitOrderRejectedIntentLog(
+                        config, intent, "account_ledger_reject:" + ctp_account_error, metadata);
+                    process_order_event(BuildRejectedEvent(
+                        intent, "account_ledger_reject:" + ctp_account_error, metadata));
+                    return;
+                }
+                if (!ctp_position_ledger.RegisterOrderIntent(ledger_intent,
+                                                             &ctp_ledger_error)) {
+                    EmitOrderRejectedIntentLog(
+                        config, intent, "position_ledger_reject:" + ctp_ledger_error, metadata);
+                    process_order_event(BuildRejectedEvent(
+                        intent, "position_ledger_reject:" + ctp_ledger_error, metadata));
+                    return;
+                }
+            }
+            const quant_hft::OrderResult order_result =
+                execution_engine.PlaceOrderAsync(intent).get();
+            if (!order_result.success) {
+                start_order_submit_cooldown(intent, order_result.message);
+                EmitOrderRejectedIntentLog(config, intent, "gateway_reject:place_order_failed",
+                                           metadata, order_result.message);
+                process_order_event(
+                    BuildRejectedEvent(intent, "gateway_reject:place_order_failed", metadata));
+                return;
+            }
+            clear_order_submit_cooldown(intent);
+            track_submitted_order_ack(intent, order_result);
+            EmitOrderSubmittedLog(config, intent, order_result, metadata);
+            std::lock_guard<std::mutex> lock(planner_mutex);
+            execution_planner.RecordOrderResult(false);
+        }
+    };
+
+    auto release_scheduled_submit = [&](const std::string& submit_key) {
+        std::lock_guard<std::mutex> lock(submitted_order_ack_mutex);
+        const auto it = scheduled_submit_counts.find(submit_key);
+        if (it != scheduled_submit_counts.end() && --it->second <= 0) {
+            scheduled_submit_counts.erase(it);
+        }
+    };
+
+    // Declared after everything its tasks capture, so on every return path its destructor
+    // stops it (running or dropping queued slices) while those objects are still alive.
+    ExecutionScheduler execution_scheduler(
+        static_cast<std::size_t>(std::max(1, execution_config.scheduler_lanes)));
+    execution_scheduler.Start();
+
     process_signal_intent = [&](const SignalIntent& signal) {
         if (signal.trace_id.empty()) {
             EmitSignalPlanRejectedLog(config, signal, "missing_trace_id");
@@ -2823,199 +3133,36 @@ int main(int argc, char** argv) {
             }
         }
 
+        const bool interval_enabled = execution_config.algo != ExecutionAlgo::kDirect &&
+                                      execution_config.slice_interval_ms > 0;
+        const std::int64_t observed_market_volume =
+            recent_market.empty() ? 0 : recent_market.back().volume;
+        std::chrono::milliseconds slice_delay{0};
         for (const auto& planned : plans) {
-            const auto& intent = planned.intent;
-            if (dominant_contract_mode) {
-                SignalIntent order_validation_signal;
-                order_validation_signal.strategy_id = intent.strategy_id;
-                order_validation_signal.instrument_id = intent.instrument_id;
-                order_validation_signal.signal_type =
-                    intent.offset == OffsetFlag::kOpen ? SignalType::kOpen : SignalType::kClose;
-                order_validation_signal.side = intent.side;
-                order_validation_signal.offset = intent.offset;
-                order_validation_signal.trace_id = intent.trace_id;
-                order_validation_signal.product_id = intent.product_id;
-                order_validation_signal.contract_generation = intent.contract_generation;
-                std::int32_t broker_close_volume = 0;
-                if (intent.offset != OffsetFlag::kOpen) {
-                    const PositionDirection close_direction = intent.side == Side::kSell
-                                                                  ? PositionDirection::kLong
-                                                                  : PositionDirection::kShort;
-                    const std::string exchange_id =
-                        InferCtpExchangeIdFromInstrumentId(intent.instrument_id);
-                    std::lock_guard<std::mutex> lock(ctp_ledger_mutex);
-                    for (const std::string& position_date :
-                         {std::string("today"), std::string("yesterday")}) {
-                        broker_close_volume +=
-                            ctp_position_ledger
-                                .GetPosition(account_id, intent.instrument_id, close_direction,
-                                             position_date, exchange_id)
-                                .position;
-                    }
-                }
-                const auto validation = dominant_contract_coordinator.ValidateSignal(
-                    order_validation_signal, broker_close_volume);
-                if (!validation.allowed) {
-                    EmitOrderRejectedIntentLog(config, intent,
-                                               "dominant_contract:" + validation.reason,
-                                               ExecutionMetadata{});
-                    process_order_event(BuildRejectedEvent(
-                        intent, "dominant_contract:" + validation.reason, ExecutionMetadata{}));
-                    continue;
-                }
-            }
-            ExecutionMetadata metadata;
-            metadata.strategy_id = intent.strategy_id;
-            metadata.execution_algo_id = planned.execution_algo_id;
-            metadata.slice_index = planned.slice_index;
-            metadata.slice_total = planned.slice_total;
-            const std::int64_t observed_market_volume =
-                recent_market.empty() ? 0 : recent_market.back().volume;
-            const auto route =
-                execution_router.Route(planned, execution_config, observed_market_volume);
-            metadata.venue = route.venue;
-            metadata.route_id = route.route_id;
-            metadata.slippage_bps = route.slippage_bps;
-            metadata.impact_cost = route.impact_cost;
+            const std::string submit_key = BuildExecutionSubmitCooldownKey(planned.intent);
             {
-                std::lock_guard<std::mutex> lock(execution_metadata_mutex);
-                execution_metadata_by_order[intent.client_order_id] = metadata;
-            }
-
-            bool throttle_applied = false;
-            double throttle_ratio = 0.0;
-            if (execution_config.throttle_reject_ratio > 0.0) {
-                std::lock_guard<std::mutex> lock(planner_mutex);
-                throttle_applied =
-                    execution_planner.ShouldThrottle(execution_config.throttle_reject_ratio);
-                throttle_ratio = execution_planner.CurrentRejectRatio();
-            }
-            if (throttle_applied) {
-                RiskDecision throttle_decision;
-                throttle_decision.action = RiskAction::kReject;
-                throttle_decision.rule_id = "policy.execution.throttle.reject_ratio";
-                throttle_decision.rule_group = "execution";
-                throttle_decision.rule_version = "v1";
-                throttle_decision.policy_id = "policy.execution.throttle";
-                throttle_decision.policy_scope = "execution";
-                throttle_decision.observed_value = throttle_ratio;
-                throttle_decision.threshold_value = execution_config.throttle_reject_ratio;
-                throttle_decision.decision_tags = "execution,throttle";
-                throttle_decision.reason = "reject ratio exceeds threshold";
-                throttle_decision.decision_ts_ns = NowEpochNanos();
-                timeseries_store.AppendRiskDecision(intent, throttle_decision);
-
-                metadata.throttle_applied = true;
-                EmitOrderRejectedIntentLog(config, intent, "throttled:reject_ratio_exceeded",
-                                           metadata);
-                process_order_event(
-                    BuildRejectedEvent(intent, "throttled:reject_ratio_exceeded", metadata));
-                continue;
-            }
-
-            if (!order_state_machine.OnOrderIntent(intent)) {
-                EmitOrderRejectedIntentLog(config, intent,
-                                           "order_state_reject:duplicate_or_invalid", metadata);
+                std::lock_guard<std::mutex> lock(submitted_order_ack_mutex);
+                ++scheduled_submit_counts[submit_key];
+            }
+            const bool scheduled = execution_scheduler.ScheduleAfter(
+                planned.intent.instrument_id, slice_delay,
+                [&submit_planned_order, &release_scheduled_submit, planned, submit_key,
+                 observed_market_volume]() {
+                    submit_planned_order(planned, observed_market_volume);
+                    release_scheduled_submit(submit_key);
+                });
+            if (!scheduled) {
+                release_scheduled_submit(submit_key);
+                EmitOrderRejectedIntentLog(config, planned.intent,
+                                           "execution_scheduler_reject:unavailable",
+                                           ExecutionMetadata{});
                 process_order_event(BuildRejectedEvent(
-                    intent, "order_state_reject:duplicate_or_invalid", metadata));
-            } else {
-                std::string ctp_ledger_error;
-                {
-                    const auto ledger_intent = BuildCtpLedgerIntent(intent);
-                    std::lock_guard<std::mutex> lock(ctp_ledger_mutex);
-                    CtpOrderFundInputs fund_inputs;
-                    fund_inputs.client_order_id = intent.client_order_id;
-                    fund_inputs.price = intent.price;
-                    fund_inputs.volume = intent.volume;
-                    {
-                        std::lock_guard<std::mutex> fee_lock(fee_rate_mutex);
-                        const auto meta_it = instrument_meta_by_id.find(intent.instrument_id);
-                        if (meta_it != instrument_meta_by_id.end()) {
-                            fund_inputs.volume_multiple = meta_it->second.volume_multiple;
-                        }
-                        const auto margin_it = margin_rate_by_instrument.find(intent.instrument_id);
-                        if (intent.offset == OffsetFlag::kOpen &&
-                            margin_it != margin_rate_by_instrument.end()) {
-                            const auto direction = ResolveLedgerDirection(intent);
-                            if (direction == PositionDirection::kLong) {
-                                fund_inputs.margin_ratio_by_money =
-                                    margin_it->second.long_margin_ratio_by_money;
-                                fund_inputs.margin_ratio_by_volume =
-                                    margin_it->second.long_margin_ratio_by_volume;
-                            } else {
-                                fund_inputs.margin_ratio_by_money =
-                                    margin_it->second.short_margin_ratio_by_money;
-                                fund_inputs.margin_ratio_by_volume =
-                                    margin_it->second.short_margin_ratio_by_volume;
-                            }
-                        }
-                        const auto commission_it =
-                            commission_rate_by_instrument.find(intent.instrument_id);
-                        if (commission_it != commission_rate_by_instrument.end()) {
-                            if (intent.offset == OffsetFlag::kOpen) {
-                                fund_inputs.commission_ratio_by_money =
-                                    commission_it->second.open_ratio_by_money;
-                                fund_inputs.commission_ratio_by_volume =
-                                    commission_it->second.open_ratio_by_volume;
-                            } else if (intent.offset == OffsetFlag::kCloseToday) {
-                                fund_inputs.commission_ratio_by_money =
-                                    commission_it->second.close_today_ratio_by_money;
-                                fund_inputs.commission_ratio_by_volume =
-                                    commission_it->second.close_today_ratio_by_volume;
-                            } else {
-                                fund_inputs.commission_ratio_by_money =
-                                    commission_it->second.close_ratio_by_money;
-                                fund_inputs.commission_ratio_by_volume =
-                                    commission_it->second.close_ratio_by_volume;
-                            }
-                        }
-                        const auto order_comm_it =
-                            order_comm_rate_by_instrument.find(intent.instrument_id);
-                        if (order_comm_it != order_comm_rate_by_instrument.end()) {
-                            fund_inputs.commission_ratio_by_volume +=
-                                order_comm_it->second.order_comm_by_volume;
-                        }
-                    }
-                    std::string ctp_account_error;
-                    if (!ctp_account_ledger.ReserveOrderFunds(fund_inputs, &ctp_account_error)) {
-                        EmitOrderRejectedIntentLog(
-                            config, intent, "account_ledger_reject:" + ctp_account_error, metadata);
-                        process_order_event(BuildRejectedEvent(
-                            intent, "account_ledger_reject:" + ctp_account_error, metadata));
-                        continue;
-                    }
-                    if (!ctp_position_ledger.RegisterOrderIntent(ledger_intent,
-                                                                 &ctp_ledger_error)) {
-                        EmitOrderRejectedIntentLog(
-                            config, intent, "position_ledger_reject:" + ctp_ledger_error, metadata);
-                        process_order_event(BuildRejectedEvent(
-                            intent, "position_ledger_reject:" + ctp_ledger_error, metadata));
-                        continue;
-                    }
-                }
-                const quant_hft::OrderResult order_result =
-                    execution_engine.PlaceOrderAsync(intent).get();
-                if (!order_result.success) {
-                    start_order_submit_cooldown(intent, order_result.message);
-                    EmitOrderRejectedIntentLog(config, intent, "gateway_reject:place_order_failed",
-                                               metadata, order_result.message);
-                    process_order_event(
-                        BuildRejectedEvent(intent, "gateway_reject:place_order_failed", metadata));
-                    continue;
-                }
-                clear_order_submit_cooldown(intent);
-                track_submitted_order_ack(intent, order_result);
-                EmitOrderSubmittedLog(config, intent, order_result, metadata);
-                std::lock_guard<std::mutex> lock(planner_mutex);
-                execution_planner.RecordOrderResult(false);
+                    planned.intent, "execution_scheduler_reject:unavailable", ExecutionMetadata{}));
+                continue;
             }
-
             const bool is_last_slice = planned.slice_index == planned.slice_total;
-            const bool interval_enabled = execution_config.algo != ExecutionAlgo::kDirect &&
-                                          execution_config.slice_interval_ms > 0;
             if (!is_last_slice && interval_enabled) {
-                std::this_thread::sleep_for(
-                    std::chrono::milliseconds(execution_config.slice_interval_ms));
+                slice_delay += std::chrono::milliseconds(execution_config.slice_interval_ms);
             }
         }
     };
@@ -3177,7 +3324,9 @@ int main(int argc, char** argv) {
                                                       !warming_event);
                     }
                 } else {
-                    strategy_engine->EnqueueState(emission.state);
+                    strategy_engine->EnqueueState(
+                        emission.state,
+                        ExtractProductIdFromInstrumentId(emission.state.instrument_id));
                 }
             }
         }
@@ -3361,7 +3510,8 @@ int main(int argc, char** argv) {
         process_market_snapshot(snapshot);
         if (strategy_engine != nullptr && std::isfinite(snapshot.last_price) &&
             snapshot.last_price > 0.0) {
-            strategy_engine->EnqueueMarketTick(snapshot);
+            strategy_engine->EnqueueMarketTick(
+                snapshot, ExtractProductIdFromInstrumentId(snapshot.instrument_id));
         }
     });
     ctp_trader->RegisterTradingAccountSnapshotCallback([&](const TradingAccountSnapshot& snapshot) {
@@ -3654,7 +3804,8 @@ int main(int argc, char** argv) {
                     strategy_engine->EnqueueState(state, *product, *generation, !warming_event);
                 }
             } else {
-                strategy_engine->EnqueueState(state);
+                strategy_engine->EnqueueState(
+                    state, ExtractProductIdFromInstrumentId(state.instrument_id));
             }
         }
     });
@@ -3698,6 +3849,16 @@ int main(int argc, char** argv) {
         StrategyEngine::StrategyLaunchSpec spec;
         spec.strategy_id = strategy_id;
         spec.strategy_factory = strategy_factory;
+        if (strategy_factory == "composite") {
+            // Scoping the strategy to its product lets the engine route that product's states
+            // to one worker; strategies on the same product share it.
+            const std::string product_id =
+                ResolveCompositeProductId(strategy_context.metadata["composite_config_path"]);
+            if (!product_id.empty()) {
+                spec.product_ids = {product_id};
+                spec.affinity_key = product_id;
+            }
+        }
         spec.context = std::move(strategy_context);
         launch_specs.push_back(std::move(spec));
     }
@@ -3745,6 +3906,7 @@ int main(int argc, char** argv) {
     std::atomic<std::uint64_t> permission_recovery_generation{0};
     std::atomic<bool> recovery_order_trade_queries_complete{false};
 
+    startup_phases.Mark("engine_setup");
     if (!ctp_trader->Connect(connect_cfg)) {
         EmitStructuredLog(&config, "core_engine", "error", "ctp_trader_connect_failed");
         const auto diagnostic = ctp_trader->GetLastConnectDiagnostic();
@@ -3770,6 +3932,7 @@ int main(int argc, char** argv) {
     EmitStructuredLog(
         &config, "core_engine", "info", "ctp_settlement_confirmed",
         {{"settlement_confirm_required", config.settlement_confirm_required ? "true" : "false"}});
+    startup_phases.Mark("ctp_connect");
 
     const std::uint64_t initial_recovery_generation = ctp_gateway->GetSessionGeneration();
     permission_recovery_generation.store(initial_recovery_generation);
@@ -3797,6 +3960,7 @@ int main(int argc, char** argv) {
          {"elapsed_ms", std::to_string(initial_recovery_report.elapsed_ms)},
          {"error_stage", initial_recovery_report.error_stage},
          {"error", initial_recovery_report.error}});
+    startup_phases.Mark("recovery");
 
     if (dominant_contract_mode) {
         const auto& product_ids = dominant_product_ids;
@@ -3823,9 +3987,25 @@ int main(int argc, char** argv) {
             InstrumentMetaCacheDocument cached;
             std::string cache_error;
             std::string cache_reason;
-            const bool cache_loaded =
-                !force_instrument_refresh &&
-                LoadInstrumentMetaCacheDocument(cache_path, &cached, &cache_error);
+            bool cache_loaded = false;
+            bool cache_from_bundle = false;
+            if (!force_instrument_refresh) {
+                const auto* bundled =
+                    startup_bundle_loaded
+                        ? FindStartupBundleInstrumentCache(startup_bundle, product_id)
+                        : nullptr;
+                if (bundled != nullptr &&
+                    std::filesystem::path(bundled->source.path).lexically_normal() ==
+                        std::filesystem::path(cache_path).lexically_normal() &&
+                    IsStartupBundleSourceCurrent(bundled->source)) {
+                    cached = bundled->document;
+                    cache_loaded = true;
+                    cache_from_bundle = true;
+                } else {
+                    cache_loaded =
+                        LoadInstrumentMetaCacheDocument(cache_path, &cached, &cache_error);
+                }
+            }
             const bool cache_current =
                 cache_loaded && IsInstrumentMetaCacheCurrent(
                                     cached, broker_trading_day, NowEpochNanos(),
@@ -3835,12 +4015,14 @@ int main(int argc, char** argv) {
                                             : "dominant_contract_candidate_cache_refresh_required",
                               {{"product_id", product_id},
                                {"path", cache_path},
+                               {"source", cache_from_bundle ? "startup_bundle" : "json"},
                                {"force_refresh", force_instrument_refresh ? "true" : "false"},
                                {"reason", force_instrument_refresh
                                               ? "force_instrument_refresh"
                                               : (cache_loaded ? cache_reason : cache_error)}});
             if (cache_current) {
                 ctp_md->UpdateInstrumentMetadata(cached.instruments);
+                InstrumentRegistry::Global().RegisterAll(cached.instruments);
             }
         }
 
@@ -3871,6 +4053,7 @@ int main(int argc, char** argv) {
             }
             received_instrument_meta = instrument_meta_snapshots;
         }
+        InstrumentRegistry::Global().RegisterAll(received_instrument_meta);
 
         std::unordered_map<std::string, std::vector<std::string>> candidate_ids_by_product;
         std::vector<std::string> all_candidate_ids;
@@ -3911,6 +4094,7 @@ int main(int argc, char** argv) {
         all_candidate_ids.erase(std::unique(all_candidate_ids.begin(), all_candidate_ids.end()),
                                 all_candidate_ids.end());
         dominant_candidate_ids_by_product = candidate_ids_by_product;
+        startup_phases.Mark("instrument_metadata");
 
         const std::unordered_set<std::string> configured_dominant_products(product_ids.begin(),
                                                                            product_ids.end());
@@ -4245,6 +4429,9 @@ int main(int argc, char** argv) {
                           {{"instrument_count", std::to_string(instruments.size())}});
         return 2;
     }
+    startup_phases.Mark("subscribe");
+    EmitStructuredLog(&config, "core_engine", "info", "startup_phase_report",
+                      startup_phases.ReportFields());
 
     {
         std::lock_guard<std::mutex> lock(active_instrument_state_mutex);
@@ -5462,6 +5649,7 @@ int main(int argc, char** argv) {
             for (const auto& instrument_id : active_instruments) {
                 MarketSnapshot snapshot;
                 snapshot.instrument_id = instrument_id;
+                snapshot.instrument_handle = InstrumentRegistry::Global().Intern(instrument_id);
                 snapshot.last_price = 4500.0 + static_cast<double>(synthetic_tick % 20) * 0.5;
                 snapshot.bid_price_1 = snapshot.last_price - 0.5;
                 snapshot.ask_price_1 = snapshot.last_price + 0.5;
@@ -5571,6 +5759,16 @@ int main(int argc, char** argv) {
     if (strategy_engine != nullptr) {
         strategy_engine->Stop();
     }
+    execution_scheduler.Stop();
+    const auto execution_scheduler_stats = execution_scheduler.GetStats();
+    EmitStructuredLog(
+        &config, "core_engine", "info", "execution_scheduler_stopped",
+        {{"scheduled", std::to_string(execution_scheduler_stats.scheduled)},
+         {"executed", std::to_string(execution_scheduler_stats.executed)},
+         {"rejected", std::to_string(execution_scheduler_stats.rejected)},
+         {"dropped_on_stop", std::to_string(execution_scheduler_stats.dropped_on_stop)},
+         {"max_dispatch_delay_ms",
+          std::to_string(execution_scheduler_stats.max_dispatch_delay_ms)}});
     metrics_exporter.Stop();
     std::string market_data_close_error;
     if (!market_data_recorder.Close(&market_data_close_error)) {
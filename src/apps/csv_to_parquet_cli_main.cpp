@@ -8,12 +8,14 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "quant_hft/apps/backtest_replay_support.h"
+#include "quant_hft/core/simple_json.h"
 
 #if QUANT_HFT_ENABLE_ARROW_PARQUET
 #include <arrow/api.h>
@@ -576,28 +578,38 @@ bool LoadExistingManifest(const std::filesystem::path& manifest_path,
         }
 
         ManifestEntry entry;
-        if (!qapps::detail::ExtractJsonString(line, "file_path", &entry.relative_file_path)) {
+        bool has_file_path = false;
+        quant_hft::simple_json::ObjectCursor cursor(line);
+        std::string_view key;
+        quant_hft::simple_json::RawValue value;
+        while (cursor.Next(&key, &value)) {
+            if (key == "file_path") {
+                has_file_path = value.GetString(&entry.relative_file_path);
+            } else if (key == "source") {
+                value.GetString(&entry.source);
+            } else if (key == "trading_day") {
+                value.GetString(&entry.trading_day);
+            } else if (key == "instrument_id") {
+                value.GetString(&entry.instrument_id);
+            } else if (key == "schema_version") {
+                value.GetString(&entry.schema_version);
+            } else if (key == "source_csv_fingerprint") {
+                value.GetString(&entry.source_csv_fingerprint);
+            } else if (key == "min_ts_ns") {
+                value.GetInt64(&entry.min_ts_ns);
+            } else if (key == "max_ts_ns") {
+                value.GetInt64(&entry.max_ts_ns);
+            } else if (key == "row_count") {
+                value.GetInt64(&entry.row_count);
+            }
+        }
+        if (!cursor.ok() || !has_file_path) {
             if (error != nullptr) {
-                *error = "invalid manifest line: missing file_path";
+                *error = cursor.ok() ? "invalid manifest line: missing file_path"
+                                     : "invalid manifest line: " + cursor.error();
             }
             return false;
         }
-        qapps::detail::ExtractJsonString(line, "source", &entry.source);
-        qapps::detail::ExtractJsonString(line, "trading_day", &entry.trading_day);
-        qapps::detail::ExtractJsonString(line, "instrument_id", &entry.instrument_id);
-        qapps::detail::ExtractJsonString(line, "schema_version", &entry.schema_version);
-        qapps::detail::ExtractJsonString(line, "source_csv_fingerprint",
-                                         &entry.source_csv_fingerprint);
-        double number = 0.0;
-        if (qapps::detail::ExtractJsonNumber(line, "min_ts_ns", &number)) {
-            entry.min_ts_ns = static_cast<std::int64_t>(number);
-        }
-        if (qapps::detail::ExtractJsonNumber(line, "max_ts_ns", &number)) {
-            entry.max_ts_ns = static_cast<std::int64_t>(number);
-        }
-        if (qapps::detail::ExtractJsonNumber(line, "row_count", &number)) {
-            entry.row_count = static_cast<std::int64_t>(number);
-        }
         if (entry.schema_version.empty()) {
             entry.schema_version = kSchemaVersion;
         }
@@ -982,11 +994,24 @@ int main(int argc, char** argv) {
     const std::filesystem::path tmp_root = output_root / "_tmp" / "csv_to_parquet_runs";
     std::filesystem::create_directories(tmp_root);
 
-    std::string fingerprint = ComputeFileDigest(spec.input_csv, &error);
+    // Reconverting into the same output root usually sees the same source files; the digest
+    // index lets an unchanged CSV skip the full re-read that fingerprinting needs.
+    DatasetDigestIndex digest_index;
+    const std::filesystem::path digest_index_path = DatasetDigestIndex::PathFor(output_root);
+    std::string digest_index_error;
+    if (!digest_index.Load(digest_index_path, &digest_index_error)) {
+        digest_index = DatasetDigestIndex{};
+    }
+    const std::string fingerprint = ComputeIndexedFileDigest(
+        spec.input_csv, std::filesystem::absolute(spec.input_csv).lexically_normal().string(),
+        &digest_index, &error);
     if (fingerprint.empty()) {
         std::cerr << "csv_to_parquet_cli: " << error << '\n';
         return 1;
     }
+    if (digest_index.dirty()) {
+        (void)digest_index.Save(digest_index_path, &digest_index_error);
+    }
 
     std::ifstream input(spec.input_csv);
     if (!input.is_open()) {
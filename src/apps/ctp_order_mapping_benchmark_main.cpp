@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "quant_hft/core/ctp_order_mapping_store.h"
+
+namespace {
+
+using quant_hft::CtpOrderMappingStore;
+using quant_hft::CtpOrderSubmitMapping;
+using quant_hft::OrderEvent;
+
+constexpr const char* kTradingDay = "20260719";
+constexpr std::int32_t kFrontId = 3;
+constexpr std::int32_t kSessionId = 1'234'567;
+
+CtpOrderSubmitMapping MakeMapping(std::size_t index) {
+    CtpOrderSubmitMapping mapping;
+    mapping.account_id = "sim-account";
+    mapping.strategy_id = "kama_trend_1";
+    mapping.trace_id = "trace-" + std::to_string(index);
+    mapping.client_order_id = "kama_trend_1-open-rb2610-" + std::to_string(index);
+    mapping.instrument_id = "SHFE.rb2610";
+    mapping.exchange_id = "SHFE";
+    mapping.volume = 1;
+    mapping.price = 3500.0;
+    mapping.order_ref = std::to_string(100'000 + index);
+    mapping.front_id = kFrontId;
+    mapping.session_id = kSessionId;
+    mapping.request_id = static_cast<std::int32_t>(index);
+    mapping.submit_ts_ns = static_cast<std::int64_t>(index) * 1'000;
+    mapping.trading_day = kTradingDay;
+    return mapping;
+}
+
+// What OnRtnOrder carries: the broker session identity, no client order id.
+OrderEvent MakeOrderCallback(std::size_t index) {
+    OrderEvent event;
+    event.account_id = "sim-account";
+    event.order_ref = std::to_string(100'000 + index);
+    event.front_id = kFrontId;
+    event.session_id = kSessionId;
+    event.trading_day = kTradingDay;
+    event.exchange_id = "SHFE";
+    event.exchange_order_id = "SYS" + std::to_string(index);
+    return event;
+}
+
+// What OnRtnTrade carries: only the exchange order identity.
+OrderEvent MakeTradeCallback(std::size_t index) {
+    OrderEvent event;
+    event.account_id = "sim-account";
+    event.trading_day = kTradingDay;
+    event.exchange_id = "SHFE";
+    event.exchange_order_id = "SYS" + std::to_string(index);
+    return event;
+}
+
+struct LatencyStats {
+    double avg_ns{0.0};
+    double p50_ns{0.0};
+    double p99_ns{0.0};
+};
+
+LatencyStats Summarize(std::vector<std::int64_t>* samples) {
+    LatencyStats stats;
+    if (samples->empty()) {
+        return stats;
+    }
+    std::sort(samples->begin(), samples->end());
+    double total = 0.0;
+    for (const std::int64_t sample : *samples) {
+        total += static_cast<double>(sample);
+    }
+    stats.avg_ns = total / static_cast<double>(samples->size());
+    stats.p50_ns = static_cast<double>((*samples)[samples->size() / 2]);
+    stats.p99_ns = static_cast<double>((*samples)[samples->size() * 99 / 100]);
+    return stats;
+}
+
+// Times EnrichOrderEvent on a copy of each callback, as core_engine does per callback.
+LatencyStats TimeCallbacks(CtpOrderMappingStore* store, const std::vector<OrderEvent>& callbacks,
+                           std::size_t* resolved) {
+    std::vector<std::int64_t> samples;
+    samples.reserve(callbacks.size());
+    for (const OrderEvent& callback : callbacks) {
+        OrderEvent event = callback;
+        const auto started = std::chrono::steady_clock::now();
+        const bool ok = store->EnrichOrderEvent(&event);
+        const auto elapsed = std::chrono::steady_clock::now() - started;
+        samples.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        *resolved += ok ? 1U : 0U;
+    }
+    return Summarize(&samples);
+}
+
+void PrintStats(const std::string& name, const LatencyStats& stats) {
+    std::cout << name << "_avg_ns=" << stats.avg_ns << "\n";
+    std::cout << name << "_p50_ns=" << stats.p50_ns << "\n";
+    std::cout << name << "_p99_ns=" << stats.p99_ns << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t orders = 50'000;
+    std::size_t readers = 2;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--orders" && i + 1 < argc) {
+            orders = static_cast<std::size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--readers" && i + 1 < argc) {
+            readers = static_cast<std::size_t>(std::stoull(argv[++i]));
+        }
+    }
+    if (orders == 0) {
+        std::cerr << "error=invalid_arguments" << std::endl;
+        return 2;
+    }
+
+    std::vector<CtpOrderSubmitMapping> mappings;
+    std::vector<OrderEvent> order_callbacks;
+    std::vector<OrderEvent> trade_callbacks;
+    mappings.reserve(orders);
+    order_callbacks.reserve(orders);
+    trade_callbacks.reserve(orders);
+    for (std::size_t index = 0; index < orders; ++index) {
+        mappings.push_back(MakeMapping(index));
+        order_callbacks.push_back(MakeOrderCallback(index));
+        trade_callbacks.push_back(MakeTradeCallback(index));
+    }
+
+    CtpOrderMappingStore store;
+    const auto upsert_started = std::chrono::steady_clock::now();
+    for (const CtpOrderSubmitMapping& mapping : mappings) {
+        store.Upsert(mapping);
+    }
+    const double upsert_avg_ns =
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - upsert_started)
+                                .count()) /
+        static_cast<double>(orders);
+
+    std::size_t resolved = 0;
+    const LatencyStats order_stats = TimeCallbacks(&store, order_callbacks, &resolved);
+    const LatencyStats trade_stats = TimeCallbacks(&store, trade_callbacks, &resolved);
+
+    // Trade callbacks racing a writer that keeps submitting new orders.
+    CtpOrderMappingStore contended;
+    for (std::size_t index = 0; index < orders / 2; ++index) {
+        contended.Upsert(mappings[index]);
+        OrderEvent event = order_callbacks[index];
+        (void)contended.EnrichOrderEvent(&event);
+    }
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> reader_threads;
+    for (std::size_t reader = 0; reader < readers; ++reader) {
+        reader_threads.emplace_back([&]() {
+            std::size_t index = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                OrderEvent event = trade_callbacks[index];
+                (void)contended.EnrichOrderEvent(&event);
+                index = (index + 1) % (orders / 2 == 0 ? 1 : orders / 2);
+            }
+        });
+    }
+    std::vector<std::int64_t> contended_samples;
+    contended_samples.reserve(orders - orders / 2);
+    for (std::size_t index = orders / 2; index < orders; ++index) {
+        contended.Upsert(mappings[index]);
+        OrderEvent event = order_callbacks[index];
+        const auto started = std::chrono::steady_clock::now();
+        resolved += contended.EnrichOrderEvent(&event) ? 1U : 0U;
+        contended_samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        std::chrono::steady_clock::now() - started)
+                                        .count());
+    }
+    stop.store(true);
+    for (std::thread& thread : reader_threads) {
+        thread.join();
+    }
+    const LatencyStats contended_stats = Summarize(&contended_samples);
+
+    std::cout << "orders=" << orders << "\n";
+    std::cout << "readers=" << readers << "\n";
+    std::cout << "upsert_avg_ns=" << upsert_avg_ns << "\n";
+    PrintStats("order_callback", order_stats);
+    PrintStats("trade_callback", trade_stats);
+    PrintStats("contended_order_callback", contended_stats);
+    std::cout << "resolved=" << resolved << "\n";
+    std::cout << "status=ok\n";
+    return 0;
+}
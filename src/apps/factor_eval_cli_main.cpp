@@ -4,66 +4,86 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "quant_hft/apps/backtest_replay_support.h"
+#include "quant_hft/core/simple_json.h"
 
 namespace {
 
-void ApplySpecJsonToArgs(const std::string& json, quant_hft::apps::ArgMap* args) {
+bool ApplySpecJsonToArgs(const std::string& json, quant_hft::apps::ArgMap* args,
+                         std::string* error) {
     if (args == nullptr) {
-        return;
+        return false;
     }
-    auto apply_string = [&](const std::string& key) {
-        std::string value;
-        if (quant_hft::apps::detail::ExtractJsonString(json, key, &value)) {
-            (*args)[key] = value;
-        }
+    static const std::set<std::string_view> kStringKeys = {
+        "csv_path",
+        "dataset_root",
+        "engine_mode",
+        "rollover_mode",
+        "product_series_mode",
+        "rollover_price_mode",
+        "detector_config",
+        "start_date",
+        "end_date",
+        "wal_path",
+        "account_id",
+        "run_id",
+        "product_config_path",
+        "strategy_main_config_path",
+        "strategy_factory",
+        "strategy_composite_config",
+        "trace_output_format",
+        "indicator_trace_path",
+        "sub_strategy_indicator_trace_path",
     };
-    auto apply_number = [&](const std::string& key) {
-        double value = 0.0;
-        if (quant_hft::apps::detail::ExtractJsonNumber(json, key, &value)) {
-            std::ostringstream oss;
-            oss << value;
-            (*args)[key] = oss.str();
-        }
+    static const std::set<std::string_view> kNumberKeys = {
+        "rollover_slippage_bps",
+        "max_ticks",
+        "initial_equity",
+        "max_loss_percent",
     };
-    auto apply_bool = [&](const std::string& key) {
-        bool value = false;
-        if (quant_hft::apps::detail::ExtractJsonBool(json, key, &value)) {
-            (*args)[key] = value ? "true" : "false";
-        }
+    static const std::set<std::string_view> kBoolKeys = {
+        "deterministic_fills",
+        "emit_state_snapshots",
+        "emit_indicator_trace",
+        "emit_sub_strategy_indicator_trace",
     };
 
-    apply_string("csv_path");
-    apply_string("dataset_root");
-    apply_string("engine_mode");
-    apply_string("rollover_mode");
-    apply_string("product_series_mode");
-    apply_string("rollover_price_mode");
-    apply_string("detector_config");
-    apply_string("start_date");
-    apply_string("end_date");
-    apply_string("wal_path");
-    apply_string("account_id");
-    apply_string("run_id");
-    apply_string("product_config_path");
-    apply_string("strategy_main_config_path");
-    apply_string("strategy_factory");
-    apply_string("strategy_composite_config");
-    apply_string("trace_output_format");
-    apply_string("indicator_trace_path");
-    apply_string("sub_strategy_indicator_trace_path");
-    apply_number("rollover_slippage_bps");
-    apply_number("max_ticks");
-    apply_number("initial_equity");
-    apply_number("max_loss_percent");
-    apply_bool("deterministic_fills");
-    apply_bool("emit_state_snapshots");
-    apply_bool("emit_indicator_trace");
-    apply_bool("emit_sub_strategy_indicator_trace");
+    quant_hft::simple_json::ObjectCursor cursor(json);
+    std::string_view key;
+    quant_hft::simple_json::RawValue value;
+    while (cursor.Next(&key, &value)) {
+        if (kStringKeys.count(key) > 0) {
+            std::string text;
+            if (value.GetString(&text)) {
+                (*args)[std::string(key)] = text;
+            }
+        } else if (kNumberKeys.count(key) > 0) {
+            double number = 0.0;
+            if (value.GetNumber(&number)) {
+                std::ostringstream oss;
+                oss << number;
+                (*args)[std::string(key)] = oss.str();
+            }
+        } else if (kBoolKeys.count(key) > 0) {
+            bool flag = false;
+            if (value.GetBool(&flag)) {
+                (*args)[std::string(key)] = flag ? "true" : "false";
+            }
+        }
+    }
+    if (!cursor.ok()) {
+        if (error != nullptr) {
+            *error = cursor.error();
+        }
+        return false;
+    }
+    return true;
 }
 
 bool IsAllowedTemplate(const std::string& value) {
@@ -99,7 +119,12 @@ int main(int argc, char** argv) {
         }
         std::ostringstream content;
         content << in.rdbuf();
-        ApplySpecJsonToArgs(content.str(), &spec_args);
+        std::string spec_error;
+        if (!ApplySpecJsonToArgs(content.str(), &spec_args, &spec_error)) {
+            std::cerr << "factor_eval_cli: invalid spec_file " << spec_file << ": " << spec_error
+                      << '\n';
+            return 2;
+        }
     }
 
     const std::string dataset_root =
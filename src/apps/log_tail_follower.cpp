@@ -0,0 +1,81 @@
+#include "quant_hft/apps/log_tail_follower.h"
+
+#include <sys/stat.h>
+
+#include <fstream>
+
+namespace quant_hft::apps {
+namespace {
+
+constexpr std::size_t kReadChunkBytes = 64 * 1024;
+
+}  // namespace
+
+LogTailFollower::PollResult LogTailFollower::Poll(const std::string& path) {
+    PollResult result;
+    struct stat info {};
+    if (path.empty() || ::stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        result.reset = opened_;
+        Clear();
+        path_ = path;
+        return result;
+    }
+    result.exists = true;
+
+    const auto device = static_cast<std::uint64_t>(info.st_dev);
+    const auto inode = static_cast<std::uint64_t>(info.st_ino);
+    const auto size = static_cast<std::uint64_t>(info.st_size);
+    if (!opened_ || path != path_ || device != device_ || inode != inode_ || size < offset_) {
+        result.reset = opened_;
+        Clear();
+        path_ = path;
+        device_ = device;
+        inode_ = inode;
+        opened_ = true;
+    }
+    if (size == offset_) {
+        return result;
+    }
+
+    std::ifstream input(path, std::ios::binary);
+    if (!input.is_open()) {
+        result.exists = false;
+        return result;
+    }
+    input.seekg(static_cast<std::streamoff>(offset_));
+    std::string chunk(kReadChunkBytes, '\0');
+    while (input) {
+        input.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        const auto count = static_cast<std::size_t>(input.gcount());
+        if (count == 0) {
+            break;
+        }
+        offset_ += count;
+        std::size_t start = 0;
+        for (std::size_t index = 0; index < count; ++index) {
+            if (chunk[index] != '\n') {
+                continue;
+            }
+            partial_line_.append(chunk, start, index - start);
+            if (!partial_line_.empty() && partial_line_.back() == '\r') {
+                partial_line_.pop_back();
+            }
+            result.lines.push_back(std::move(partial_line_));
+            partial_line_.clear();
+            start = index + 1;
+        }
+        partial_line_.append(chunk, start, count - start);
+    }
+    return result;
+}
+
+void LogTailFollower::Clear() {
+    path_.clear();
+    device_ = 0;
+    inode_ = 0;
+    offset_ = 0;
+    partial_line_.clear();
+    opened_ = false;
+}
+
+}  // namespace quant_hft::apps
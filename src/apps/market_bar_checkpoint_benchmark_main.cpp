@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "quant_hft/services/market_bar_pipeline.h"
+
+namespace {
+
+using quant_hft::EpochNanos;
+
+constexpr const char* kTradingDay = "20260710";
+
+EpochNanos ShanghaiEpochNs(int hour, int minute, int second) {
+    std::tm utc_tm{};
+    utc_tm.tm_year = 2026 - 1900;
+    utc_tm.tm_mon = 6;
+    utc_tm.tm_mday = 10;
+    utc_tm.tm_hour = hour;
+    utc_tm.tm_min = minute;
+    utc_tm.tm_sec = second;
+    return (static_cast<EpochNanos>(timegm(&utc_tm)) - 8LL * 60LL * 60LL) * 1'000'000'000LL;
+}
+
+quant_hft::MarketSnapshot MakeTick(const std::string& instrument_id, int minute, int second,
+                                   std::int64_t volume, double price) {
+    char update_time[16];
+    std::snprintf(update_time, sizeof(update_time), "09:%02d:%02d", minute, second);
+    quant_hft::MarketSnapshot snapshot;
+    snapshot.instrument_id = instrument_id;
+    snapshot.exchange_id = "DCE";
+    snapshot.trading_day = kTradingDay;
+    snapshot.action_day = kTradingDay;
+    snapshot.update_time = update_time;
+    snapshot.last_price = price;
+    snapshot.bid_price_1 = price - 1.0;
+    snapshot.ask_price_1 = price + 1.0;
+    snapshot.volume = volume;
+    snapshot.exchange_ts_ns = ShanghaiEpochNs(9, minute, second);
+    snapshot.recv_ts_ns = snapshot.exchange_ts_ns;
+    return snapshot;
+}
+
+quant_hft::MarketBarPipelineConfig MakeConfig() {
+    quant_hft::MarketBarPipelineConfig config;
+    config.bar_aggregator.allowed_lateness_ms = 3500;
+    config.timeframes = {5, 15};
+    return config;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point started) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started)
+        .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t instruments = 500;
+    std::size_t minutes = 30;
+    std::size_t runs = 5;
+    std::string path =
+        (std::filesystem::temp_directory_path() / "quant_hft_market_bar_checkpoint_bench.state")
+            .string();
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--instruments" && i + 1 < argc) {
+            instruments = static_cast<std::size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--minutes" && i + 1 < argc) {
+            minutes = static_cast<std::size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--runs" && i + 1 < argc) {
+            runs = static_cast<std::size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--path" && i + 1 < argc) {
+            path = argv[++i];
+        }
+    }
+    if (instruments == 0 || minutes == 0 || minutes > 59 || runs == 0) {
+        std::cerr << "error=invalid_arguments" << std::endl;
+        return 2;
+    }
+
+    std::vector<std::string> instrument_ids;
+    for (std::size_t index = 0; index < instruments; ++index) {
+        instrument_ids.push_back("DCE.c" + std::to_string(2000 + index));
+    }
+
+    // Finalized minutes populate canonical bars, detectors and recent states; the last minute
+    // is left pending so the checkpoint also carries open aggregator buckets.
+    quant_hft::MarketBarPipeline source(MakeConfig());
+    for (std::size_t minute = 0; minute <= minutes; ++minute) {
+        for (std::size_t index = 0; index < instruments; ++index) {
+            const double price = 100.0 + static_cast<double>((minute * 7 + index) % 13);
+            (void)source.OnTick(MakeTick(instrument_ids[index], static_cast<int>(minute), 10,
+                                         static_cast<std::int64_t>(100 + minute * 10), price));
+        }
+        if (minute < minutes) {
+            (void)source.AdvanceWatermark(ShanghaiEpochNs(9, static_cast<int>(minute) + 1, 4));
+        }
+    }
+
+    std::string error;
+    double save_ms_total = 0.0;
+    double save_ms_max = 0.0;
+    for (std::size_t run = 0; run < runs; ++run) {
+        const auto started = std::chrono::steady_clock::now();
+        if (!source.SaveCheckpointAtomically(path, &error)) {
+            std::cerr << "error=" << error << std::endl;
+            return 1;
+        }
+        const double elapsed = ElapsedMs(started);
+        save_ms_total += elapsed;
+        save_ms_max = std::max(save_ms_max, elapsed);
+    }
+
+    double load_ms_total = 0.0;
+    double load_ms_max = 0.0;
+    for (std::size_t run = 0; run < runs; ++run) {
+        quant_hft::MarketBarPipeline restored(MakeConfig());
+        const auto started = std::chrono::steady_clock::now();
+        if (!restored.LoadCheckpointFile(path, &error)) {
+            std::cerr << "error=" << error << std::endl;
+            return 1;
+        }
+        const double elapsed = ElapsedMs(started);
+        load_ms_total += elapsed;
+        load_ms_max = std::max(load_ms_max, elapsed);
+    }
+
+    std::error_code ec;
+    const auto bytes = std::filesystem::file_size(path, ec);
+    std::filesystem::remove(path, ec);
+
+    std::cout << "instruments=" << instruments << "\n";
+    std::cout << "minutes=" << minutes << "\n";
+    std::cout << "runs=" << runs << "\n";
+    std::cout << "checkpoint_bytes=" << bytes << "\n";
+    std::cout << "save_ms_avg=" << save_ms_total / static_cast<double>(runs) << "\n";
+    std::cout << "save_ms_max=" << save_ms_max << "\n";
+    std::cout << "load_ms_avg=" << load_ms_total / static_cast<double>(runs) << "\n";
+    std::cout << "load_ms_max=" << load_ms_max << "\n";
+    std::cout << "status=ok\n";
+    return 0;
+}
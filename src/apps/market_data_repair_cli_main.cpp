@@ -4,8 +4,12 @@
 #include <cctype>
 #include <chrono>
 #include <cstdint>
+#include <cstring>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -14,6 +18,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -30,6 +35,8 @@ namespace {
 namespace fs = std::filesystem;
 
 constexpr quant_hft::EpochNanos kTenMinutesNs = 600'000'000'000LL;
+constexpr std::size_t kDefaultMaxBufferedMb = 256;
+constexpr std::size_t kReadChunkBytes = 1 << 20;
 
 struct DayProductInfo {
     std::string trading_day;
@@ -87,56 +94,103 @@ struct ProductRuntime {
     std::unique_ptr<quant_hft::CompositeStrategy> strategy;
 };
 
+// Rows are buffered in memory per output file and appended to disk once the buffered total
+// reaches `max_buffered_bytes` (0 buffers until Close). Each product worker owns one instance,
+// and products never share an output file, so workers need no coordination.
 class OutputFiles {
    public:
-    explicit OutputFiles(fs::path root) : root_(std::move(root)) {}
+    explicit OutputFiles(fs::path root, std::size_t max_buffered_bytes = 0)
+        : root_(std::move(root)), max_buffered_bytes_(max_buffered_bytes) {}
 
-    std::ofstream* Open(const fs::path& relative, const std::string& header, std::string* error) {
-        const std::string key = relative.generic_string();
-        const auto existing = streams_.find(key);
-        if (existing != streams_.end()) {
-            return existing->second.get();
-        }
-        const fs::path path = root_ / relative;
-        std::error_code ec;
-        fs::create_directories(path.parent_path(), ec);
-        if (ec) {
-            SetError(error, "failed to create output directory: " + ec.message());
-            return nullptr;
+    std::ostream* Open(const fs::path& relative, const std::string& header, std::string* error) {
+        if (max_buffered_bytes_ > 0 && ++rows_since_check_ >= kBufferCheckRows) {
+            rows_since_check_ = 0;
+            if (BufferedBytes() >= max_buffered_bytes_ && !Flush(error)) {
+                return nullptr;
+            }
         }
-        auto stream = std::make_unique<std::ofstream>(path, std::ios::out | std::ios::trunc);
-        if (!stream->is_open()) {
-            SetError(error, "failed to open output: " + path.string());
-            return nullptr;
+        const std::string key = relative.generic_string();
+        const auto existing = files_.find(key);
+        if (existing != files_.end()) {
+            return &existing->second->buffer;
         }
-        *stream << header << '\n';
-        auto* raw = stream.get();
-        streams_.emplace(key, std::move(stream));
+        auto file = std::make_unique<BufferedFile>();
+        file->buffer << header << '\n';
+        auto* raw = &file->buffer;
+        files_.emplace(key, std::move(file));
         return raw;
     }
 
-    bool Close(std::string* error) {
-        for (auto& [path, stream] : streams_) {
-            stream->flush();
-            if (!stream->good()) {
-                SetError(error, "failed to flush output: " + path);
+    bool Flush(std::string* error) {
+        for (auto& [key, file] : files_) {
+            std::string payload = file->buffer.str();
+            if (payload.empty()) {
+                continue;
+            }
+            const fs::path path = root_ / key;
+            if (!file->created) {
+                std::error_code ec;
+                fs::create_directories(path.parent_path(), ec);
+                if (ec && !fs::is_directory(path.parent_path())) {
+                    SetError(error, "failed to create output directory: " + ec.message());
+                    return false;
+                }
+            }
+            std::ofstream output(path, std::ios::out | std::ios::binary |
+                                           (file->created ? std::ios::app : std::ios::trunc));
+            if (!output.is_open()) {
+                SetError(error, "failed to open output: " + path.string());
                 return false;
             }
-            stream->close();
+            output.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            output.flush();
+            if (!output.good()) {
+                SetError(error, "failed to flush output: " + key);
+                return false;
+            }
+            file->created = true;
+            file->buffer.str(std::string());
+            file->buffer.clear();
         }
-        streams_.clear();
+        return true;
+    }
+
+    bool Close(std::string* error) {
+        if (!Flush(error)) {
+            return false;
+        }
+        files_.clear();
         return true;
     }
 
    private:
+    static constexpr std::size_t kBufferCheckRows = 256;
+
+    struct BufferedFile {
+        std::ostringstream buffer;
+        bool created{false};
+    };
+
     static void SetError(std::string* error, const std::string& value) {
         if (error != nullptr) {
             *error = value;
         }
     }
 
+    std::size_t BufferedBytes() {
+        std::size_t total = 0;
+        for (auto& [key, file] : files_) {
+            (void)key;
+            const auto position = file->buffer.tellp();
+            total += position > 0 ? static_cast<std::size_t>(position) : 0;
+        }
+        return total;
+    }
+
     fs::path root_;
-    std::map<std::string, std::unique_ptr<std::ofstream>> streams_;
+    std::size_t max_buffered_bytes_{0};
+    std::size_t rows_since_check_{0};
+    std::map<std::string, std::unique_ptr<BufferedFile>> files_;
 };
 
 void SetError(std::string* error, const std::string& value) {
@@ -304,46 +358,117 @@ std::string FormatMinute(int minute_of_day) {
     return out.str();
 }
 
-std::string Sha256File(const fs::path& path, std::string* error) {
-    std::ifstream input(path, std::ios::in | std::ios::binary);
-    if (!input.is_open()) {
-        SetError(error, "failed to open evidence file: " + path.string());
-        return "";
-    }
-    EVP_MD_CTX* context = EVP_MD_CTX_new();
-    if (context == nullptr || EVP_DigestInit_ex(context, EVP_sha256(), nullptr) != 1) {
-        if (context != nullptr) {
-            EVP_MD_CTX_free(context);
-        }
-        SetError(error, "failed to initialize SHA-256");
-        return "";
-    }
-    std::vector<char> buffer(1 << 20);
-    while (input.good()) {
-        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
-        const auto count = input.gcount();
-        if (count > 0 &&
-            EVP_DigestUpdate(context, buffer.data(), static_cast<std::size_t>(count)) != 1) {
-            EVP_MD_CTX_free(context);
-            SetError(error, "failed to update SHA-256: " + path.string());
-            return "";
-        }
-    }
-    unsigned char digest[EVP_MAX_MD_SIZE];
-    unsigned int digest_size = 0;
-    if (EVP_DigestFinal_ex(context, digest, &digest_size) != 1) {
-        EVP_MD_CTX_free(context);
-        SetError(error, "failed to finalize SHA-256: " + path.string());
-        return "";
-    }
-    EVP_MD_CTX_free(context);
-    std::ostringstream out;
-    out << std::hex << std::setfill('0');
-    for (unsigned int index = 0; index < digest_size; ++index) {
-        out << std::setw(2) << static_cast<int>(digest[index]);
+struct FileDigest {
+    std::string sha256;
+    std::uintmax_t size_bytes{0};
+    std::string error;
+};
+
+// Reads a file in large chunks, hashing every byte as it is consumed, so tick files get their
+// evidence digest from the same pass that parses them. ReadLine follows std::getline.
+class Sha256LineReader {
+   public:
+    explicit Sha256LineReader(const fs::path& path)
+        : path_(path),
+          input_(path, std::ios::in | std::ios::binary),
+          context_(EVP_MD_CTX_new()),
+          buffer_(kReadChunkBytes) {
+        if (!input_.is_open()) {
+            error_ = "failed to open evidence file: " + path.string();
+        } else if (context_ == nullptr ||
+                   EVP_DigestInit_ex(context_, EVP_sha256(), nullptr) != 1) {
+            error_ = "failed to initialize SHA-256";
+        }
+    }
+
+    ~Sha256LineReader() {
+        if (context_ != nullptr) {
+            EVP_MD_CTX_free(context_);
+        }
+    }
+
+    Sha256LineReader(const Sha256LineReader&) = delete;
+    Sha256LineReader& operator=(const Sha256LineReader&) = delete;
+
+    bool ok() const { return error_.empty(); }
+
+    bool ReadLine(std::string* line) {
+        line->clear();
+        bool extracted = false;
+        for (;;) {
+            if (position_ == end_ && !Fill()) {
+                return extracted;
+            }
+            const char* begin = buffer_.data() + position_;
+            const auto* newline =
+                static_cast<const char*>(std::memchr(begin, '\n', end_ - position_));
+            if (newline != nullptr) {
+                line->append(begin, newline);
+                position_ += static_cast<std::size_t>(newline - begin) + 1;
+                return true;
+            }
+            line->append(begin, end_ - position_);
+            position_ = end_;
+            extracted = true;
+        }
     }
-    return out.str();
-}
+
+    // Hashes whatever has not been read yet and returns the digest of the whole file.
+    FileDigest Finish() {
+        while (Fill()) {
+        }
+        FileDigest result;
+        if (!ok()) {
+            result.error = error_;
+            return result;
+        }
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int digest_size = 0;
+        if (EVP_DigestFinal_ex(context_, digest, &digest_size) != 1) {
+            result.error = "failed to finalize SHA-256: " + path_.string();
+            return result;
+        }
+        std::ostringstream out;
+        out << std::hex << std::setfill('0');
+        for (unsigned int index = 0; index < digest_size; ++index) {
+            out << std::setw(2) << static_cast<int>(digest[index]);
+        }
+        result.sha256 = out.str();
+        result.size_bytes = bytes_read_;
+        return result;
+    }
+
+   private:
+    bool Fill() {
+        if (!ok() || !input_.good()) {
+            return false;
+        }
+        input_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        const auto count = static_cast<std::size_t>(input_.gcount());
+        if (count == 0) {
+            return false;
+        }
+        if (EVP_DigestUpdate(context_, buffer_.data(), count) != 1) {
+            error_ = "failed to update SHA-256: " + path_.string();
+            return false;
+        }
+        bytes_read_ += count;
+        position_ = 0;
+        end_ = count;
+        return true;
+    }
+
+    fs::path path_;
+    std::ifstream input_;
+    EVP_MD_CTX* context_{nullptr};
+    std::vector<char> buffer_;
+    std::size_t position_{0};
+    std::size_t end_{0};
+    std::uintmax_t bytes_read_{0};
+    std::string error_;
+};
+
+FileDigest Sha256File(const fs::path& path) { return Sha256LineReader(path).Finish(); }
 
 bool ContainsRelevantDay(const std::string& value, const std::string& start_day,
                          const std::string& end_day) {
@@ -433,7 +558,7 @@ std::string BarHeader() {
            "is_recovery_replay";
 }
 
-void WriteBar(std::ofstream* output, const quant_hft::BarSnapshot& bar) {
+void WriteBar(std::ostream* output, const quant_hft::BarSnapshot& bar) {
     *output << std::setprecision(17) << bar.instrument_id << ',' << bar.exchange_id << ','
             << bar.trading_day << ',' << bar.action_day << ',' << bar.minute << ',' << bar.open
             << ',' << bar.high << ',' << bar.low << ',' << bar.close << ',' << bar.analysis_open
@@ -568,6 +693,134 @@ bool ProcessResult(ProductRuntime* runtime, quant_hft::MarketBarPipelineResult r
     return true;
 }
 
+// A product's trading days share one pipeline and strategy, so they replay in day order on a
+// single worker; different products are independent and run concurrently.
+struct ProductTask {
+    std::string product;
+    std::vector<fs::path> tick_files;
+};
+
+struct ProductOutcome {
+    bool ok{true};
+    std::string error;
+    ValidationStats stats;
+    std::map<std::string, DayProductInfo> day_product_info;
+    std::set<std::string> observed_1m;
+    std::set<std::string> observed_5m;
+    std::map<fs::path, FileDigest> tick_digests;
+};
+
+ProductOutcome RunProduct(const ProductTask& task, const fs::path& repository_root,
+                          const fs::path& output_root, std::size_t max_buffered_bytes) {
+    ProductOutcome outcome;
+    const auto fail = [&outcome]() {
+        outcome.ok = false;
+        return std::move(outcome);
+    };
+    ProductRuntime runtime(task.product);
+    if (!InitializeStrategy(&runtime, repository_root, &outcome.error)) {
+        return fail();
+    }
+    OutputFiles outputs(output_root, max_buffered_bytes);
+    for (const auto& tick_file : task.tick_files) {
+        const std::string path_day = DayFromPath(tick_file);
+        Sha256LineReader input(tick_file);
+        std::string line;
+        if (!input.ReadLine(&line)) {
+            ++outcome.stats.parse_errors;
+            if (input.ok()) {
+                outcome.tick_digests.emplace(tick_file, input.Finish());
+            }
+            continue;
+        }
+        const auto header = HeaderMap(line);
+        const std::string info_key = task.product + "|" + path_day;
+        quant_hft::EpochNanos max_recv_ts_ns = 0;
+        while (input.ReadLine(&line)) {
+            if (line.empty()) {
+                continue;
+            }
+            ++outcome.stats.input_tick_rows;
+            const auto parsed = ParseTick(SplitCsv(line), header);
+            if (!parsed.has_value()) {
+                ++outcome.stats.parse_errors;
+                continue;
+            }
+            const auto& snapshot = *parsed;
+            outcome.day_product_info.try_emplace(
+                info_key, DayProductInfo{path_day, task.product, snapshot.instrument_id,
+                                         snapshot.exchange_id});
+            max_recv_ts_ns = std::max(max_recv_ts_ns, snapshot.recv_ts_ns);
+            if (!ProcessResult(&runtime, runtime.pipeline.OnTick(snapshot), &outputs,
+                               &outcome.stats, &outcome.observed_1m, &outcome.observed_5m,
+                               &outcome.error)) {
+                return fail();
+            }
+        }
+        if (max_recv_ts_ns > 0 &&
+            !ProcessResult(&runtime,
+                           runtime.pipeline.AdvanceWatermark(max_recv_ts_ns + kTenMinutesNs),
+                           &outputs, &outcome.stats, &outcome.observed_1m, &outcome.observed_5m,
+                           &outcome.error)) {
+            return fail();
+        }
+        FileDigest digest = input.Finish();
+        if (!digest.error.empty()) {
+            outcome.error = digest.error;
+            return fail();
+        }
+        outcome.tick_digests.emplace(tick_file, std::move(digest));
+    }
+    if (!outputs.Close(&outcome.error)) {
+        return fail();
+    }
+    return outcome;
+}
+
+void MergeStats(const ValidationStats& from, ValidationStats* into) {
+    into->input_tick_rows += from.input_tick_rows;
+    into->parse_errors += from.parse_errors;
+    into->duplicate_ticks += from.duplicate_ticks;
+    into->late_ticks += from.late_ticks;
+    into->endpoint_1m_bars += from.endpoint_1m_bars;
+    into->endpoint_5m_bars += from.endpoint_5m_bars;
+    into->incomplete_5m_bars += from.incomplete_5m_bars;
+    into->ineligible_integrity_violations += from.ineligible_integrity_violations;
+    into->critical_conflicts += from.critical_conflicts;
+    into->duplicate_1m_keys += from.duplicate_1m_keys;
+    into->duplicate_5m_keys += from.duplicate_5m_keys;
+    into->strategy_evaluations += from.strategy_evaluations;
+    into->signal_candidates += from.signal_candidates;
+    if (from.hc_1125_corrected_bars > 0) {
+        into->hc_1125_corrected_bars += from.hc_1125_corrected_bars;
+        into->hc_1125_complete = from.hc_1125_complete;
+        into->hc_1125_close = from.hc_1125_close;
+        into->hc_1125_corrected_raw_signal = from.hc_1125_corrected_raw_signal;
+    }
+}
+
+// Runs at most `jobs` tasks at a time and returns results in task order, like
+// optim::TaskScheduler::RunBatch, so merged output does not depend on scheduling.
+template <typename Result>
+std::vector<Result> RunBounded(const std::vector<std::function<Result()>>& tasks,
+                               std::size_t jobs) {
+    std::vector<Result> results;
+    results.reserve(tasks.size());
+    std::deque<std::future<Result>> active;
+    for (const auto& task : tasks) {
+        if (active.size() >= std::max<std::size_t>(1, jobs)) {
+            results.push_back(active.front().get());
+            active.pop_front();
+        }
+        active.push_back(std::async(std::launch::async, task));
+    }
+    while (!active.empty()) {
+        results.push_back(active.front().get());
+        active.pop_front();
+    }
+    return results;
+}
+
 void CountOldHcSignal(const fs::path& input_root, ValidationStats* stats) {
     const fs::path path =
         input_root / "trading_day=20260713" / "varieties" / "hc" / "strategy" / "kama_5m.csv";
@@ -708,6 +961,16 @@ int main(int argc, char** argv) {
         (repository_root / "docs/results/20260701_20260718_repair_validation.md").string());
     const std::string start_day = quant_hft::apps::GetArg(args, "start-day", "20260701");
     const std::string end_day = quant_hft::apps::GetArg(args, "end-day", "20260718");
+    std::int64_t requested_jobs = std::max(1U, std::thread::hardware_concurrency());
+    std::int64_t max_buffered_mb = static_cast<std::int64_t>(kDefaultMaxBufferedMb);
+    const std::string jobs_arg = quant_hft::apps::GetArg(args, "jobs", "");
+    const std::string buffered_arg = quant_hft::apps::GetArg(args, "max-buffered-mb", "");
+    if ((!jobs_arg.empty() && (!ParseInt64(jobs_arg, &requested_jobs) || requested_jobs <= 0)) ||
+        (!buffered_arg.empty() &&
+         (!ParseInt64(buffered_arg, &max_buffered_mb) || max_buffered_mb <= 0))) {
+        std::cerr << "market_data_repair_cli: --jobs and --max-buffered-mb must be > 0\n";
+        return 2;
+    }
 
     std::error_code ec;
     if (!fs::is_directory(input_root, ec)) {
@@ -759,63 +1022,59 @@ int main(int argc, char** argv) {
     });
     stats.trading_days = static_cast<std::int64_t>(discovered_days.size());
 
-    std::map<std::string, std::unique_ptr<ProductRuntime>> runtimes;
-    std::map<std::string, DayProductInfo> day_product_info;
-    std::set<std::string> observed_1m;
-    std::set<std::string> observed_5m;
-
+    std::vector<ProductTask> product_tasks;
     for (const auto& tick_file : tick_files) {
         const std::string product = ProductFromPath(tick_file);
-        const std::string path_day = DayFromPath(tick_file);
-        auto& runtime = runtimes[product];
-        if (runtime == nullptr) {
-            runtime = std::make_unique<ProductRuntime>(product);
-            if (!InitializeStrategy(runtime.get(), repository_root, &error)) {
-                std::cerr << "market_data_repair_cli: " << error << '\n';
-                fs::remove_all(temporary_root, ec);
-                return 3;
-            }
+        if (product_tasks.empty() || product_tasks.back().product != product) {
+            product_tasks.push_back(ProductTask{product, {}});
         }
+        product_tasks.back().tick_files.push_back(tick_file);
+    }
+    const std::size_t jobs = std::max<std::size_t>(
+        1, std::min(static_cast<std::size_t>(requested_jobs), product_tasks.size()));
+    // The buffer budget is shared by all concurrent workers.
+    const std::size_t max_buffered_bytes_per_job =
+        static_cast<std::size_t>(max_buffered_mb) * 1024 * 1024 / jobs;
 
-        std::ifstream input(tick_file);
-        std::string line;
-        if (!std::getline(input, line)) {
-            ++stats.parse_errors;
-            continue;
-        }
-        const auto header = HeaderMap(line);
-        quant_hft::EpochNanos max_recv_ts_ns = 0;
-        while (std::getline(input, line)) {
-            if (line.empty()) {
-                continue;
-            }
-            ++stats.input_tick_rows;
-            const auto parsed = ParseTick(SplitCsv(line), header);
-            if (!parsed.has_value()) {
-                ++stats.parse_errors;
-                continue;
-            }
-            const auto& snapshot = *parsed;
-            const std::string info_key = product + "|" + path_day;
-            day_product_info.try_emplace(
-                info_key,
-                DayProductInfo{path_day, product, snapshot.instrument_id, snapshot.exchange_id});
-            max_recv_ts_ns = std::max(max_recv_ts_ns, snapshot.recv_ts_ns);
-            if (!ProcessResult(runtime.get(), runtime->pipeline.OnTick(snapshot), &outputs, &stats,
-                               &observed_1m, &observed_5m, &error)) {
-                std::cerr << "market_data_repair_cli: " << error << '\n';
-                fs::remove_all(temporary_root, ec);
-                return 3;
+    // Evidence outside the tick files is hashed on a background thread while products replay;
+    // tick files are hashed by the workers as they parse them.
+    const auto evidence_files =
+        CollectEvidenceFiles(input_root, trading_root, wal_file, start_day, end_day);
+    const std::set<fs::path> tick_file_set(tick_files.begin(), tick_files.end());
+    auto evidence_digests = std::async(std::launch::async, [&evidence_files, &tick_file_set]() {
+        std::map<fs::path, FileDigest> digests;
+        for (const auto& path : evidence_files) {
+            if (tick_file_set.find(path) == tick_file_set.end()) {
+                digests.emplace(path, Sha256File(path));
             }
         }
-        if (max_recv_ts_ns > 0 &&
-            !ProcessResult(runtime.get(),
-                           runtime->pipeline.AdvanceWatermark(max_recv_ts_ns + kTenMinutesNs),
-                           &outputs, &stats, &observed_1m, &observed_5m, &error)) {
-            std::cerr << "market_data_repair_cli: " << error << '\n';
+        return digests;
+    });
+
+    std::vector<std::function<ProductOutcome()>> runs;
+    runs.reserve(product_tasks.size());
+    for (const auto& task : product_tasks) {
+        runs.push_back([&task, &repository_root, &temporary_root, max_buffered_bytes_per_job]() {
+            return RunProduct(task, repository_root, temporary_root, max_buffered_bytes_per_job);
+        });
+    }
+    std::vector<ProductOutcome> outcomes = RunBounded(runs, jobs);
+    std::map<fs::path, FileDigest> digests = evidence_digests.get();
+
+    std::map<std::string, DayProductInfo> day_product_info;
+    std::set<std::string> observed_1m;
+    std::set<std::string> observed_5m;
+    for (auto& outcome : outcomes) {
+        if (!outcome.ok) {
+            std::cerr << "market_data_repair_cli: " << outcome.error << '\n';
             fs::remove_all(temporary_root, ec);
             return 3;
         }
+        MergeStats(outcome.stats, &stats);
+        day_product_info.merge(outcome.day_product_info);
+        observed_1m.merge(outcome.observed_1m);
+        observed_5m.merge(outcome.observed_5m);
+        digests.merge(outcome.tick_digests);
     }
     stats.product_days = static_cast<std::int64_t>(day_product_info.size());
 
@@ -876,8 +1135,6 @@ int main(int argc, char** argv) {
     }
 
     CountOldHcSignal(input_root, &stats);
-    const auto evidence_files =
-        CollectEvidenceFiles(input_root, trading_root, wal_file, start_day, end_day);
     auto* manifest = outputs.Open("baseline_sha256.csv", "sha256,size_bytes,path", &error);
     if (manifest == nullptr) {
         std::cerr << "market_data_repair_cli: " << error << '\n';
@@ -885,22 +1142,17 @@ int main(int argc, char** argv) {
         return 3;
     }
     for (const auto& path : evidence_files) {
-        const std::string digest = Sha256File(path, &error);
-        if (digest.empty()) {
-            std::cerr << "market_data_repair_cli: " << error << '\n';
-            fs::remove_all(temporary_root, ec);
-            return 3;
-        }
-        const auto size = fs::file_size(path, ec);
-        if (ec) {
-            std::cerr << "market_data_repair_cli: failed to stat evidence: " << path << '\n';
+        const auto found = digests.find(path);
+        const FileDigest digest = found != digests.end() ? found->second : Sha256File(path);
+        if (digest.sha256.empty()) {
+            std::cerr << "market_data_repair_cli: " << digest.error << '\n';
             fs::remove_all(temporary_root, ec);
             return 3;
         }
-        *manifest << digest << ',' << size << ','
+        *manifest << digest.sha256 << ',' << digest.size_bytes << ','
                   << PortableReportPath(path, repository_root).generic_string() << '\n';
         ++stats.evidence_files;
-        stats.evidence_bytes += size;
+        stats.evidence_bytes += digest.size_bytes;
     }
 
     if (!outputs.Close(&error)) {
@@ -943,6 +1195,6 @@ int main(int argc, char** argv) {
               << " canonical_1m=" << stats.canonical_1m_slots
               << " gaps_1m=" << stats.no_tick_1m_gaps << " expected_5m=" << stats.expected_5m_keys
               << " canonical_5m=" << stats.canonical_5m_keys << " gaps_5m=" << stats.no_tick_5m_gaps
-              << '\n';
+              << " jobs=" << jobs << '\n';
     return passed ? 0 : 4;
 }
@@ -18,7 +18,8 @@ void PrintUsage(const char* argv0) {
     std::cout << "Usage: " << argv0
               << " --train-report-json <parameter_optim_report.json>"
                  " --oos-start <YYYY-MM-DD|YYYYMMDD> --oos-end <YYYY-MM-DD|YYYYMMDD>"
-                 " [--top-n <count>] [--output-dir <dir>] [--overwrite]\n";
+                 " [--top-n <count>] [--parallelism <workers>] [--output-dir <dir>]"
+                 " [--overwrite]\n";
 }
 
 bool ParsePositiveInt(const std::string& text, int* out) {
@@ -61,6 +62,14 @@ int main(int argc, char** argv) {
         return 2;
     }
 
+    const std::string parallelism_raw = GetArg(args, "parallelism", "1");
+    if (!ParsePositiveInt(parallelism_raw, &request.parallelism)) {
+        std::cerr << "oos_top10_validation_cli: invalid --parallelism: " << parallelism_raw
+                  << '\n';
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
     if (request.train_report_json.empty() || request.oos_start_date.empty() ||
         request.oos_end_date.empty()) {
         PrintUsage(argv[0]);
@@ -22,6 +22,7 @@
 #include "quant_hft/optim/parameter_space.h"
 #include "quant_hft/optim/random_search.h"
 #include "quant_hft/optim/result_analyzer.h"
+#include "quant_hft/optim/successive_halving.h"
 #include "quant_hft/optim/task_scheduler.h"
 #include "quant_hft/optim/temp_config_generator.h"
 
@@ -45,6 +46,8 @@ using quant_hft::optim::TaskScheduler;
 using quant_hft::optim::Trial;
 using quant_hft::optim::TrialConfigArtifacts;
 using quant_hft::optim::TrialConfigRequest;
+using quant_hft::optim::TrialFidelity;
+using quant_hft::optim::TrialResultRecord;
 using quant_hft::optim::GenerateTrialConfig;
 
 std::atomic<bool> g_interrupted{false};
@@ -247,7 +250,8 @@ bool PreserveTopKTrials(const OptimizationConfig& config,
     std::vector<std::size_t> completed_indices;
     completed_indices.reserve(report->trials.size());
     for (std::size_t index = 0; index < report->trials.size(); ++index) {
-        if (report->trials[index].status == "completed") {
+        if (report->trials[index].status == "completed" &&
+            report->trials[index].fidelity.fraction >= 1.0) {
             completed_indices.push_back(index);
         }
     }
@@ -378,6 +382,8 @@ int main(int argc, char** argv) {
         algorithm = std::make_unique<quant_hft::optim::GridSearch>();
     } else if (space.optimization.algorithm == "random") {
         algorithm = std::make_unique<quant_hft::optim::RandomSearch>();
+    } else if (space.optimization.algorithm == "successive_halving") {
+        algorithm = std::make_unique<quant_hft::optim::SuccessiveHalving>();
     } else {
         std::cerr << "parameter_optim_cli: unsupported algorithm: " << space.optimization.algorithm
                   << '\n';
@@ -410,11 +416,27 @@ int main(int argc, char** argv) {
     const auto task_started_steady = std::chrono::steady_clock::now();
     const std::string task_id = MakeTaskId(task_started_system);
 
+    TrialFidelity batch_fidelity;
     auto task = [&](const ParamValueMap& params) -> Trial {
         Trial trial;
         const int index = trial_counter.fetch_add(1);
         trial.trial_id = "trial_" + std::to_string(index + 1);
         trial.params = params;
+        trial.fidelity = batch_fidelity;
+
+        std::map<std::string, std::string> backtest_args = space.backtest_args;
+        if (trial.fidelity.fraction < 1.0) {
+            std::string fidelity_end_date;
+            std::string fidelity_error;
+            if (!quant_hft::optim::ResolveFidelityEndDate(
+                    backtest_args["start_date"], backtest_args["end_date"],
+                    trial.fidelity.fraction, &fidelity_end_date, &fidelity_error)) {
+                trial.status = "failed";
+                trial.error_msg = fidelity_error;
+                return trial;
+            }
+            backtest_args["end_date"] = fidelity_end_date;
+        }
 
         TrialConfigRequest request;
         request.composite_config_path = space.composite_config_path;
@@ -439,7 +461,7 @@ int main(int argc, char** argv) {
         trial.stderr_log_path = stderr_log.string();
 
         const std::string command =
-            BuildBacktestCommand(backtest_cli_path, space.backtest_args, trial.trial_id, artifacts,
+            BuildBacktestCommand(backtest_cli_path, backtest_args, trial.trial_id, artifacts,
                                  result_json, stdout_log, stderr_log);
 
         const auto start = std::chrono::steady_clock::now();
@@ -454,10 +476,18 @@ int main(int argc, char** argv) {
             return trial;
         }
 
+        TrialResultRecord result_record;
+        std::string load_error;
+        if (!ResultAnalyzer::LoadTrialResult(trial.result_json_path, &result_record,
+                                             &load_error)) {
+            trial.status = "failed";
+            trial.error_msg = load_error;
+            return trial;
+        }
+
         std::string metric_error;
         const double objective =
-            ResultAnalyzer::ComputeObjectiveFromJson(trial.result_json_path, space.optimization,
-                                                     &metric_error);
+            ResultAnalyzer::ComputeObjective(result_record, space.optimization, &metric_error);
         if (!metric_error.empty()) {
             trial.status = "failed";
             trial.error_msg = metric_error;
@@ -466,20 +496,13 @@ int main(int argc, char** argv) {
 
         trial.status = "completed";
         trial.objective = objective;
-
-        std::string metrics_error;
-        if (!ResultAnalyzer::ExtractTrialMetricsFromJson(trial.result_json_path, &trial.metrics,
-                                                         &metrics_error)) {
-            trial.metrics_error = metrics_error;
-        } else {
-            trial.metrics_error = metrics_error;
-        }
+        trial.metrics = result_record.metrics;
+        trial.metrics_error = result_record.metrics_warnings;
 
         std::vector<std::string> constraint_violations;
         std::string constraint_error;
-        if (!ResultAnalyzer::EvaluateConstraintsFromJson(trial.result_json_path, space.optimization,
-                                                         &constraint_violations,
-                                                         &constraint_error)) {
+        if (!ResultAnalyzer::EvaluateConstraints(result_record, space.optimization,
+                                                 &constraint_violations, &constraint_error)) {
             trial.status = "failed";
             trial.error_msg = constraint_error;
             return trial;
@@ -502,6 +525,7 @@ int main(int argc, char** argv) {
             break;
         }
 
+        batch_fidelity = algorithm->CurrentFidelity();
         std::vector<Trial> batch_results = scheduler.RunBatch(batch, task);
         for (Trial& trial : batch_results) {
             if (trial.status == "completed") {
@@ -511,6 +535,10 @@ int main(int argc, char** argv) {
             }
             algorithm->AddTrialResult(trial);
             std::cout << "trial=" << trial.trial_id << " status=" << trial.status;
+            if (trial.fidelity.fraction < 1.0) {
+                std::cout << " rung=" << trial.fidelity.rung
+                          << " fidelity=" << trial.fidelity.fraction;
+            }
             if (trial.status == "completed") {
                 std::cout << " objective=" << trial.objective;
             } else {
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "quant_hft/apps/cli_support.h"
+#include "quant_hft/apps/log_tail_follower.h"
 #include "quant_hft/core/ctp_text.h"
 
 namespace {
@@ -57,6 +58,8 @@ struct DashboardOptions {
     std::string state_dir;
     std::string output_dir;
     int watch_seconds{0};
+    // Watch mode stops after this many refreshes; 0 keeps refreshing.
+    int max_refreshes{0};
     bool strict_exit{false};
 };
 
@@ -412,6 +415,50 @@ struct DashboardState {
     std::map<std::string, std::string> paths;
 };
 
+// Connection state folded from one log source, starting from a default status. `recovered`
+// records whether any line cleared the error count, so the fold can be overlaid on an earlier
+// source with the same result as replaying its lines there.
+struct CtpConnectionFold {
+    CtpConnectionStatus status;
+    bool recovered{false};
+};
+
+// Watch mode keeps these across refreshes so each followed log is parsed only for the lines
+// appended since the previous refresh. New lines are folded into running per-source aggregates
+// rather than kept, so memory and refresh cost do not grow with the log; collectors overlay the
+// aggregates in source order.
+struct WalIngest {
+    quant_hft::apps::LogTailFollower follower;
+    WalStatus counts;
+    // Run the order flow was folded for; WAL lines of other runs only seed fill dedup keys.
+    std::string run_id;
+    CtpOrderFlowStatus order_flow;
+};
+
+struct CoreLogIngest {
+    quant_hft::apps::LogTailFollower follower;
+    CtpConnectionFold connection;
+    CtpOrderFlowStatus order_flow;
+    std::vector<std::string> alerts;
+};
+
+struct ProbeLogIngest {
+    quant_hft::apps::LogTailFollower follower;
+    CtpConnectionFold connection;
+};
+
+struct SignalEventIngest {
+    quant_hft::apps::LogTailFollower follower;
+    SignalMonitorEpoch epoch;
+};
+
+struct DashboardIngestCache {
+    WalIngest wal;
+    CoreLogIngest core_log;
+    ProbeLogIngest probe_log;
+    SignalEventIngest signal_events;
+};
+
 std::string GetEnvOrDefault(const char* key, const std::string& fallback) {
     const char* value = std::getenv(key);
     if (value == nullptr || std::string(value).empty()) {
@@ -1314,32 +1361,42 @@ std::string RunIdFromRunDir(const std::string& run_dir) {
     return fs::path(run_dir).filename().string();
 }
 
-SignalMonitorEpoch CurrentSignalMonitorEpochFromLog(const std::string& event_log_path) {
-    std::ifstream input(event_log_path);
-    std::vector<std::string> all_lines;
-    SignalMonitorEpoch epoch;
-    std::string line;
-    while (std::getline(input, line)) {
-        if (line.empty()) {
-            continue;
-        }
-        all_lines.push_back(line);
-        const std::string event = ExtractJsonString(line, "event");
-        if (event == "monitor_started" || event == "core_engine_running") {
-            epoch.lines.clear();
-            epoch.reset_by_core_engine = event == "core_engine_running";
-        }
-        epoch.lines.push_back(line);
+std::string CurrentRunId(const DashboardOptions& options, const ProcessStatus& process) {
+    const std::string run_id = RunIdFromRunDir(process.run_dir);
+    if (!run_id.empty()) {
+        return run_id;
     }
-    if (epoch.lines.empty()) {
-        epoch.lines = std::move(all_lines);
-        epoch.reset_by_core_engine = false;
+    return RunIdFromRunDir(ReadFirstLine(fs::path(options.run_root) / "current_run_dir"));
+}
+
+void AppendSignalMonitorLine(const std::string& line, SignalMonitorEpoch* epoch) {
+    if (line.empty()) {
+        return;
     }
+    const std::string event = ExtractJsonString(line, "event");
+    if (event == "monitor_started" || event == "core_engine_running") {
+        epoch->lines.clear();
+        epoch->reset_by_core_engine = event == "core_engine_running";
+    }
+    epoch->lines.push_back(line);
+}
+
+SignalMonitorEpoch CurrentSignalMonitorEpoch(const SignalEventIngest& ingest) {
+    SignalMonitorEpoch epoch = ingest.epoch;
+    AppendSignalMonitorLine(ingest.follower.pending_line(), &epoch);
     return epoch;
 }
 
-std::vector<std::string> CurrentSignalMonitorEpochLines(const std::string& event_log_path) {
-    return CurrentSignalMonitorEpochFromLog(event_log_path).lines;
+SignalMonitorEpoch PollSignalMonitorEpoch(const std::string& event_log_path,
+                                          SignalEventIngest* ingest) {
+    auto poll = ingest->follower.Poll(event_log_path);
+    if (poll.reset) {
+        ingest->epoch = {};
+    }
+    for (const std::string& line : poll.lines) {
+        AppendSignalMonitorLine(line, &ingest->epoch);
+    }
+    return CurrentSignalMonitorEpoch(*ingest);
 }
 
 std::string ExtractSignalMonitorField(const std::string& line, const std::string& key) {
@@ -1684,31 +1741,30 @@ std::vector<MarketFileStatus> CollectMarketStatus(const DashboardOptions& option
     return markets;
 }
 
-WalStatus CollectWalStatus(const DashboardOptions& options) {
-    WalStatus status;
-    status.path = options.wal_file;
-    std::ifstream input(options.wal_file);
-    if (!input.is_open()) {
-        status.exists = false;
-        return status;
+void CountWalLine(const std::string& line, WalStatus* status) {
+    if (line.empty()) {
+        return;
     }
-    status.exists = true;
-    std::string line;
-    while (std::getline(input, line)) {
-        if (line.empty()) {
-            continue;
-        }
-        ++status.lines_total;
-        if (line.find("\"event_type\":\"order_update\"") != std::string::npos ||
-            line.find("\"kind\":\"order\"") != std::string::npos) {
-            ++status.order_events;
-        }
-        if (line.find("\"event_type\":\"trade_fill\"") != std::string::npos ||
-            line.find("\"kind\":\"trade\"") != std::string::npos) {
-            ++status.trade_or_fill_events;
-        }
+    ++status->lines_total;
+    if (line.find("\"event_type\":\"order_update\"") != std::string::npos ||
+        line.find("\"kind\":\"order\"") != std::string::npos) {
+        ++status->order_events;
+    }
+    if (line.find("\"event_type\":\"trade_fill\"") != std::string::npos ||
+        line.find("\"kind\":\"trade\"") != std::string::npos) {
+        ++status->trade_or_fill_events;
     }
-    return status;
+}
+
+bool IsWalOrderOrTradeLine(const std::string& lower) {
+    return lower.find("\"event_type\":\"order_update\"") != std::string::npos ||
+           lower.find("\"event_type\": \"order_update\"") != std::string::npos ||
+           lower.find("\"kind\":\"order\"") != std::string::npos ||
+           lower.find("\"kind\": \"order\"") != std::string::npos ||
+           lower.find("\"event_type\":\"trade_fill\"") != std::string::npos ||
+           lower.find("\"event_type\": \"trade_fill\"") != std::string::npos ||
+           lower.find("\"kind\":\"trade\"") != std::string::npos ||
+           lower.find("\"kind\": \"trade\"") != std::string::npos;
 }
 
 DailyStatus CollectDailyStatus(const DashboardOptions& options) {
@@ -1787,7 +1843,8 @@ std::string BriefSignalMonitorEvent(const std::string& line) {
     return out.str();
 }
 
-SignalMonitorStatus CollectSignalMonitorStatus(const DashboardOptions& options) {
+SignalMonitorStatus CollectSignalMonitorStatus(const DashboardOptions& options,
+                                               SignalEventIngest* ingest) {
     SignalMonitorStatus status;
     const fs::path run_root(options.run_root);
     const fs::path monitor_root(options.monitor_root);
@@ -1812,7 +1869,7 @@ SignalMonitorStatus CollectSignalMonitorStatus(const DashboardOptions& options)
         status.status = "missing";
     }
 
-    const SignalMonitorEpoch epoch = CurrentSignalMonitorEpochFromLog(event_log.string());
+    const SignalMonitorEpoch epoch = PollSignalMonitorEpoch(event_log.string(), ingest);
     const SignalMonitorEpochStats epoch_stats = BuildSignalMonitorEpochStats(epoch);
     status.signals = epoch_stats.signals;
     status.active = epoch_stats.active;
@@ -1948,34 +2005,31 @@ std::string SanitizeLogLine(std::string line) {
     return SafeAscii(line);
 }
 
-std::vector<std::string> CollectRecentAlerts(const std::string& core_log) {
-    std::vector<std::string> alerts;
-    if (core_log.empty()) {
-        alerts.emplace_back("core log is unavailable");
-        return alerts;
+bool IsAlertLine(const std::string& lower) {
+    static const std::vector<std::string> needles = {
+        "level=warn", "level=error",     "reject",       "timeout",          "disconnect",
+        "critical",   "client_order_id", "order_insert", "order_event",      "order_intent",
+        "onrtntrade", "filled_volume",   "trade_id",     "partially_filled", "filled"};
+    return HasAnyNeedle(lower, needles);
+}
+
+void PushAlertLine(const std::string& line, std::vector<std::string>* alerts) {
+    alerts->push_back(SanitizeLogLine(line));
+    if (alerts->size() > kRecentAlertLimit) {
+        alerts->erase(alerts->begin());
     }
-    std::ifstream input(core_log);
-    if (!input.is_open()) {
+}
+
+std::vector<std::string> CollectRecentAlerts(const CoreLogIngest& ingest, bool core_log_exists) {
+    std::vector<std::string> alerts;
+    if (!core_log_exists) {
         alerts.emplace_back("core log is unavailable");
         return alerts;
     }
-    const std::vector<std::string> needles = {
-        "level=warn", "level=error",     "reject",       "timeout",          "disconnect",
-        "critical",   "client_order_id", "order_insert", "order_event",      "order_intent",
-        "onrtntrade", "filled_volume",   "trade_id",     "partially_filled", "filled"};
-    std::string line;
-    while (std::getline(input, line)) {
-        const std::string lower = ToLower(line);
-        const bool matched = std::any_of(needles.begin(), needles.end(), [&](const auto& needle) {
-            return lower.find(needle) != std::string::npos;
-        });
-        if (!matched) {
-            continue;
-        }
-        alerts.push_back(SanitizeLogLine(line));
-        if (alerts.size() > kRecentAlertLimit) {
-            alerts.erase(alerts.begin());
-        }
+    alerts = ingest.alerts;
+    const std::string& pending = ingest.follower.pending_line();
+    if (!pending.empty() && IsAlertLine(ToLower(pending))) {
+        PushAlertLine(pending, &alerts);
     }
     if (alerts.empty()) {
         alerts.emplace_back("no recent alert lines matched");
@@ -2019,20 +2073,23 @@ bool LineLooksCtpRecovered(const std::string& lower) {
            (lower.find("health_status") != std::string::npos && LineHasHealthyStatus(lower));
 }
 
+bool IsCtpConnectionLine(const std::string& lower) {
+    return HasAnyNeedle(
+        lower, {"onfront", "rspuserlogin", "authenticate", "settlement_confirm", "reqsettlement",
+                "reconnect", "front_connected", "front_disconnected", "connect_success",
+                "probe_completed", "session_snapshot", "health_status"});
+}
+
 void UpdateCtpConnectionFromLine(const std::string& line, const std::string& source,
                                  CtpConnectionStatus* status) {
     if (status == nullptr || line.empty()) {
         return;
     }
     const std::string lower = ToLower(line);
-    const std::string issue = ClassifyCtpIssue(line);
-    const bool connection_related = HasAnyNeedle(
-        lower, {"onfront", "rspuserlogin", "authenticate", "settlement_confirm", "reqsettlement",
-                "reconnect", "front_connected", "front_disconnected", "connect_success",
-                "probe_completed", "session_snapshot", "health_status"});
-    if (!connection_related) {
+    if (!IsCtpConnectionLine(lower)) {
         return;
     }
+    const std::string issue = ClassifyCtpIssue(line);
 
     PushLimited(&status->recent_events, SanitizeLogLine(BriefStructuredEvent(line, source)),
                 kRecentCtpEventLimit);
@@ -2095,9 +2152,55 @@ void UpdateCtpConnectionFromLine(const std::string& line, const std::string& sou
     }
 }
 
+void FoldCtpConnectionLine(const std::string& line, const std::string& lower,
+                           const std::string& source, CtpConnectionFold* fold) {
+    if (!IsCtpConnectionLine(lower)) {
+        return;
+    }
+    UpdateCtpConnectionFromLine(line, source, &fold->status);
+    if (LineLooksCtpRecovered(lower)) {
+        fold->recovered = true;
+    }
+}
+
+// Applies a later source's fold on top of `status`, with the same result as feeding its lines
+// through UpdateCtpConnectionFromLine one by one. Every state field the lines set differs from
+// its default, so a field still at its default was never touched.
+void OverlayCtpConnection(const CtpConnectionFold& later, CtpConnectionStatus* status) {
+    const CtpConnectionStatus defaults;
+    const auto overlay = [](const std::string& value, const std::string& unset,
+                            std::string* out) {
+        if (value != unset) {
+            *out = value;
+        }
+    };
+    overlay(later.status.td_front, defaults.td_front, &status->td_front);
+    overlay(later.status.md_front, defaults.md_front, &status->md_front);
+    overlay(later.status.login_status, defaults.login_status, &status->login_status);
+    overlay(later.status.auth_status, defaults.auth_status, &status->auth_status);
+    overlay(later.status.settlement_status, defaults.settlement_status,
+            &status->settlement_status);
+    overlay(later.status.probe_status, defaults.probe_status, &status->probe_status);
+    for (const std::string& event : later.status.recent_events) {
+        PushLimited(&status->recent_events, event, kRecentCtpEventLimit);
+    }
+    status->reconnect_attempts += later.status.reconnect_attempts;
+    if (later.recovered) {
+        status->ctp_errors = later.status.ctp_errors;
+        status->last_error = later.status.last_error;
+        return;
+    }
+    status->ctp_errors += later.status.ctp_errors;
+    if (!later.status.last_error.empty()) {
+        status->last_error = later.status.last_error;
+    }
+}
+
 CtpConnectionStatus CollectCtpConnectionStatus(const DashboardOptions& options,
                                                const ProcessStatus& process,
-                                               const std::vector<ContractStatus>& contracts) {
+                                               const std::vector<ContractStatus>& contracts,
+                                               const CoreLogIngest& core_ingest,
+                                               ProbeLogIngest* probe_ingest) {
     CtpConnectionStatus status;
     for (const auto& contract : contracts) {
         if (!contract.instrument_id.empty()) {
@@ -2123,19 +2226,20 @@ CtpConnectionStatus CollectCtpConnectionStatus(const DashboardOptions& options,
     if (!probe_log.empty()) {
         status.probe_status = "history_only";
         status.probe_age_seconds = FileAgeSeconds(probe_log);
-        std::ifstream input(probe_log);
-        std::string line;
-        while (std::getline(input, line)) {
-            UpdateCtpConnectionFromLine(line, "probe", &status);
+        auto poll = probe_ingest->follower.Poll(probe_log);
+        if (poll.reset) {
+            probe_ingest->connection = {};
         }
+        for (const std::string& line : poll.lines) {
+            FoldCtpConnectionLine(line, ToLower(line), "probe", &probe_ingest->connection);
+        }
+        OverlayCtpConnection(probe_ingest->connection, &status);
+        UpdateCtpConnectionFromLine(probe_ingest->follower.pending_line(), "probe", &status);
     }
 
     if (!process.core_log.empty()) {
-        std::ifstream input(process.core_log);
-        std::string line;
-        while (std::getline(input, line)) {
-            UpdateCtpConnectionFromLine(line, "core", &status);
-        }
+        OverlayCtpConnection(core_ingest.connection, &status);
+        UpdateCtpConnectionFromLine(core_ingest.follower.pending_line(), "core", &status);
     }
 
     if (!process.healthy) {
@@ -2355,18 +2459,21 @@ void ApplyStructuredReadiness(const ReadinessStatus& readiness, CtpConnectionSta
     }
 }
 
+bool IsCtpOrderFlowLine(const std::string& lower) {
+    return HasAnyNeedle(
+        lower,
+        {"signal_passed", "order_submitted", "ctp_order_submitted", "ctp_order_submit_rejected",
+         "order_rejected", "order_update", "trade_fill", "onrsporderinsert", "onerrrtnorderinsert",
+         "onrtnorder", "onrtntrade", "client_order_id", "order_ref", "settlement_unconfirmed"});
+}
+
 void UpdateCtpOrderFlowFromLine(const std::string& line, const std::string& source,
                                 CtpOrderFlowStatus* flow) {
     if (flow == nullptr || line.empty()) {
         return;
     }
     const std::string lower = ToLower(line);
-    const bool relevant = HasAnyNeedle(
-        lower,
-        {"signal_passed", "order_submitted", "ctp_order_submitted", "ctp_order_submit_rejected",
-         "order_rejected", "order_update", "trade_fill", "onrsporderinsert", "onerrrtnorderinsert",
-         "onrtnorder", "onrtntrade", "client_order_id", "order_ref", "settlement_unconfirmed"});
-    if (!relevant) {
+    if (!IsCtpOrderFlowLine(lower)) {
         return;
     }
 
@@ -2609,10 +2716,84 @@ void UpdateCtpOrderFlowFromWalLine(const std::string& line, CtpOrderFlowStatus*
     }
 }
 
-CtpOrderFlowStatus CollectCtpOrderFlowStatus(const DashboardOptions& options,
-                                             const SignalMonitorStatus& signal_monitor,
+// Applies a later source's folded order flow on top of `flow`, with the same result as feeding
+// its lines through one by one. Only WAL lines record fills, and the WAL is overlaid last, so
+// its fill and dedup state is taken over whole.
+void OverlayCtpOrderFlow(const CtpOrderFlowStatus& later, CtpOrderFlowStatus* flow) {
+    for (const std::string& event : later.recent_events) {
+        PushLimited(&flow->recent_events, event, kRecentCtpEventLimit);
+    }
+    for (const std::string& rejection : later.recent_rejections) {
+        PushLimited(&flow->recent_rejections, rejection, kRecentCtpEventLimit);
+    }
+    flow->order_submitted_logs += later.order_submitted_logs;
+    flow->ctp_submitted += later.ctp_submitted;
+    flow->ctp_submit_rejected += later.ctp_submit_rejected;
+    flow->ctp_callbacks += later.ctp_callbacks;
+    flow->wal_rejected += later.wal_rejected;
+    flow->wal_fills += later.wal_fills;
+    flow->wal_fills_raw += later.wal_fills_raw;
+    flow->wal_duplicate_fills += later.wal_duplicate_fills;
+    if (!later.last_error_id.empty()) {
+        flow->last_error_id = later.last_error_id;
+    }
+    if (!later.last_reject_reason.empty()) {
+        flow->last_reject_reason = later.last_reject_reason;
+    }
+    if (!later.trade_fill_index_by_key.empty() || !later.trade_fills.empty()) {
+        flow->trade_fills = later.trade_fills;
+        flow->replay_duplicate_fills = later.replay_duplicate_fills;
+        flow->trade_fill_index_by_key = later.trade_fill_index_by_key;
+        flow->historical_fill_by_key = later.historical_fill_by_key;
+    }
+}
+
+void FoldWalOrderFlowLine(const std::string& line, const std::string& current_run_id,
+                          CtpOrderFlowStatus* flow) {
+    const std::string line_run_id = ExtractJsonString(line, "run_id");
+    if (!current_run_id.empty() && line_run_id != current_run_id) {
+        SeedTradeFillDedupKeyFromWalLine(line, flow);
+        return;
+    }
+    UpdateCtpOrderFlowFromWalLine(line, flow);
+}
+
+WalStatus CollectWalStatus(const DashboardOptions& options, const std::string& current_run_id,
+                           WalIngest* ingest) {
+    if (ingest->run_id != current_run_id) {
+        // Which lines count as the current run changed, so fold the whole file again.
+        ingest->follower.Clear();
+        ingest->counts = {};
+        ingest->order_flow = {};
+        ingest->run_id = current_run_id;
+    }
+    auto poll = ingest->follower.Poll(options.wal_file);
+    if (poll.reset) {
+        ingest->counts = {};
+        ingest->order_flow = {};
+    }
+    for (const std::string& line : poll.lines) {
+        CountWalLine(line, &ingest->counts);
+        if (IsWalOrderOrTradeLine(ToLower(line))) {
+            FoldWalOrderFlowLine(line, ingest->run_id, &ingest->order_flow);
+        }
+    }
+
+    WalStatus status = ingest->counts;
+    status.path = options.wal_file;
+    status.exists = poll.exists;
+    if (!status.exists) {
+        return status;
+    }
+    CountWalLine(ingest->follower.pending_line(), &status);
+    return status;
+}
+
+CtpOrderFlowStatus CollectCtpOrderFlowStatus(const SignalMonitorStatus& signal_monitor,
+                                             const SignalMonitorEpoch& signal_epoch,
                                              const WalStatus& wal_status,
-                                             const ProcessStatus& process) {
+                                             const ProcessStatus& process,
+                                             const DashboardIngestCache& ingest) {
     CtpOrderFlowStatus flow;
     flow.signals = signal_monitor.signals;
     flow.active = signal_monitor.active;
@@ -2620,7 +2801,7 @@ CtpOrderFlowStatus CollectCtpOrderFlowStatus(const DashboardOptions& options,
     flow.monitor_incidents = signal_monitor.incidents;
 
     std::int64_t signal_passed_events = 0;
-    for (const auto& line : CurrentSignalMonitorEpochLines(signal_monitor.event_log_path)) {
+    for (const auto& line : signal_epoch.lines) {
         if (line.find("\"event\":\"signal_passed\"") != std::string::npos ||
             line.find("\"event\": \"signal_passed\"") != std::string::npos) {
             ++signal_passed_events;
@@ -2632,29 +2813,12 @@ CtpOrderFlowStatus CollectCtpOrderFlowStatus(const DashboardOptions& options,
     }
 
     if (!process.core_log.empty()) {
-        std::ifstream core_input(process.core_log);
-        std::string line;
-        while (std::getline(core_input, line)) {
-            UpdateCtpOrderFlowFromLine(line, "core", &flow);
-        }
-    }
-
-    std::string current_run_id = RunIdFromRunDir(process.run_dir);
-    if (current_run_id.empty()) {
-        current_run_id =
-            RunIdFromRunDir(ReadFirstLine(fs::path(options.run_root) / "current_run_dir"));
+        OverlayCtpOrderFlow(ingest.core_log.order_flow, &flow);
+        UpdateCtpOrderFlowFromLine(ingest.core_log.follower.pending_line(), "core", &flow);
     }
     if (wal_status.exists) {
-        std::ifstream wal_input(options.wal_file);
-        std::string line;
-        while (std::getline(wal_input, line)) {
-            const std::string line_run_id = ExtractJsonString(line, "run_id");
-            if (!current_run_id.empty() && line_run_id != current_run_id) {
-                SeedTradeFillDedupKeyFromWalLine(line, &flow);
-                continue;
-            }
-            UpdateCtpOrderFlowFromWalLine(line, &flow);
-        }
+        OverlayCtpOrderFlow(ingest.wal.order_flow, &flow);
+        FoldWalOrderFlowLine(ingest.wal.follower.pending_line(), ingest.wal.run_id, &flow);
     }
 
     const bool has_activity = flow.signals > 0 || flow.order_submitted_logs > 0 ||
@@ -3802,6 +3966,12 @@ DashboardOptions ParseOptions(int argc, char** argv, std::string* error) {
             *error = "--watch-seconds must be a non-negative integer";
         }
     }
+    const std::string max_refreshes = quant_hft::apps::GetArg(args, "max-refreshes", "0");
+    if (!ParseNonNegativeInt(max_refreshes, &options.max_refreshes)) {
+        if (error != nullptr) {
+            *error = "--max-refreshes must be a non-negative integer";
+        }
+    }
     return options;
 }
 
@@ -3990,7 +4160,25 @@ std::vector<PositionRow> CollectPositions(const DashboardOptions& options, std::
     return rows;
 }
 
-DashboardState CollectState(const DashboardOptions& options) {
+bool PollCoreLog(const std::string& core_log, CoreLogIngest* ingest) {
+    auto poll = ingest->follower.Poll(core_log);
+    if (poll.reset) {
+        ingest->connection = {};
+        ingest->order_flow = {};
+        ingest->alerts.clear();
+    }
+    for (const std::string& line : poll.lines) {
+        const std::string lower = ToLower(line);
+        if (IsAlertLine(lower)) {
+            PushAlertLine(line, &ingest->alerts);
+        }
+        FoldCtpConnectionLine(line, lower, "core", &ingest->connection);
+        UpdateCtpOrderFlowFromLine(line, "core", &ingest->order_flow);
+    }
+    return poll.exists;
+}
+
+DashboardState CollectState(const DashboardOptions& options, DashboardIngestCache* ingest) {
     DashboardState state;
     state.generated_ts_ns = UnixEpochNanosNow();
     state.generated_at_local = FormatLocalTime(state.generated_ts_ns);
@@ -4010,19 +4198,22 @@ DashboardState CollectState(const DashboardOptions& options) {
     };
 
     state.process = CollectProcessStatus(options);
+    const bool core_log_exists = PollCoreLog(state.process.core_log, &ingest->core_log);
     state.contracts = DiscoverContracts(options.ctp_instrument_dir);
     state.markets = CollectMarketStatus(options);
-    state.wal = CollectWalStatus(options);
+    state.wal = CollectWalStatus(options, CurrentRunId(options, state.process), &ingest->wal);
     state.daily = CollectDailyStatus(options);
-    state.signal_monitor = CollectSignalMonitorStatus(options);
+    state.signal_monitor = CollectSignalMonitorStatus(options, &ingest->signal_events);
     state.pipeline_health = CollectPipelineHealthStatus(options);
     state.readiness = CollectReadinessStatus(options);
-    state.ctp_connection = CollectCtpConnectionStatus(options, state.process, state.contracts);
+    state.ctp_connection = CollectCtpConnectionStatus(options, state.process, state.contracts,
+                                                      ingest->core_log, &ingest->probe_log);
     ApplyStructuredReadiness(state.readiness, &state.ctp_connection);
-    state.ctp_order_flow =
-        CollectCtpOrderFlowStatus(options, state.signal_monitor, state.wal, state.process);
+    state.ctp_order_flow = CollectCtpOrderFlowStatus(
+        state.signal_monitor, CurrentSignalMonitorEpoch(ingest->signal_events), state.wal,
+        state.process, *ingest);
     state.positions = CollectPositions(options, &state.positions_source);
-    state.recent_alerts = CollectRecentAlerts(state.process.core_log);
+    state.recent_alerts = CollectRecentAlerts(ingest->core_log, core_log_exists);
 
     const bool waiting_for_window = state.process.status == "waiting_for_trading_window";
     bool market_healthy = true;
@@ -4163,16 +4354,19 @@ int main(int argc, char** argv) {
         return 2;
     }
 
-    while (true) {
-        const DashboardState state = CollectState(options);
+    // Lives for the whole watch loop; one-shot mode simply starts from an empty cache.
+    DashboardIngestCache ingest;
+    for (int refresh = 1;; ++refresh) {
+        const DashboardState state = CollectState(options, &ingest);
         if (!WriteDashboard(options, state, &error)) {
             std::cerr << "simnow_dashboard_cli: " << error << '\n';
             return 1;
         }
         std::cout << "wrote " << (fs::path(options.output_dir) / "index.html").string()
-                  << " overall_healthy=" << (state.overall_healthy ? "true" : "false") << '\n';
+                  << " overall_healthy=" << (state.overall_healthy ? "true" : "false")
+                  << std::endl;
 
-        if (options.watch_seconds == 0) {
+        if (options.watch_seconds == 0 || refresh == options.max_refreshes) {
             return options.strict_exit && state.live_status == "unhealthy" ? 2 : 0;
         }
         std::this_thread::sleep_for(std::chrono::seconds(options.watch_seconds));
@@ -0,0 +1,381 @@
+#include "quant_hft/apps/startup_bundle.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <unordered_set>
+#include <utility>
+
+#include "quant_hft/core/binary_section_file.h"
+
+namespace quant_hft {
+namespace {
+
+void SetError(std::string* error, const std::string& value) {
+    if (error != nullptr) {
+        *error = value;
+    }
+}
+
+std::string Lowercase(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+    return value;
+}
+
+// Every instrument cache is its own section so one bad product does not hide the others.
+constexpr BinarySectionFileFormat kBundleFormat{
+    {'Q', 'H', 'S', 'T', 'B', 'N', 'D', '\0'}, 1, "startup bundle"};
+
+enum class BundleSection : std::uint32_t {
+    kManifest = 1,
+    kInstrumentCache = 2,
+    kSessions = 3,
+};
+
+void PutSource(BinarySectionWriter* writer, const StartupBundleSource& source) {
+    writer->PutString(source.path);
+    writer->PutBool(source.exists);
+    writer->Put(source.size_bytes);
+    writer->Put(source.mtime_ns);
+}
+
+bool GetSource(BinarySectionReader* reader, StartupBundleSource* source) {
+    return reader->GetString(&source->path) && reader->GetBool(&source->exists) &&
+           reader->Get(&source->size_bytes) && reader->Get(&source->mtime_ns);
+}
+
+void PutInstrumentCache(BinarySectionWriter* writer, const StartupBundleInstrumentCache& cache) {
+    const auto& document = cache.document;
+    PutSource(writer, cache.source);
+    writer->Put(document.schema_version);
+    writer->PutString(document.product_id);
+    writer->PutString(document.broker_trading_day);
+    writer->Put(document.generated_ts_ns);
+    writer->PutBool(document.legacy);
+    writer->Put(static_cast<std::uint32_t>(document.instruments.size()));
+    for (const auto& row : document.instruments) {
+        writer->PutString(row.instrument_id);
+        writer->PutString(row.exchange_id);
+        writer->PutString(row.product_id);
+        writer->Put(row.volume_multiple);
+        writer->Put(row.price_tick);
+        writer->PutBool(row.max_margin_side_algorithm);
+        writer->Put(row.ts_ns);
+        writer->PutString(row.source);
+        writer->PutString(row.open_date);
+        writer->PutString(row.expire_date);
+        writer->PutBool(row.is_trading);
+        writer->PutString(row.product_class);
+    }
+}
+
+bool GetInstrumentCache(BinarySectionReader* reader, StartupBundleInstrumentCache* cache) {
+    auto& document = cache->document;
+    std::uint32_t count = 0;
+    if (!GetSource(reader, &cache->source) || !reader->Get(&document.schema_version) ||
+        !reader->GetString(&document.product_id) ||
+        !reader->GetString(&document.broker_trading_day) ||
+        !reader->Get(&document.generated_ts_ns) || !reader->GetBool(&document.legacy) ||
+        !reader->Get(&count)) {
+        return false;
+    }
+    document.instruments.resize(count);
+    for (auto& row : document.instruments) {
+        if (!reader->GetString(&row.instrument_id) || !reader->GetString(&row.exchange_id) ||
+            !reader->GetString(&row.product_id) || !reader->Get(&row.volume_multiple) ||
+            !reader->Get(&row.price_tick) || !reader->GetBool(&row.max_margin_side_algorithm) ||
+            !reader->Get(&row.ts_ns) || !reader->GetString(&row.source) ||
+            !reader->GetString(&row.open_date) || !reader->GetString(&row.expire_date) ||
+            !reader->GetBool(&row.is_trading) || !reader->GetString(&row.product_class)) {
+            return false;
+        }
+    }
+    return reader->AtEnd();
+}
+
+void PutSessions(BinarySectionWriter* writer, const StartupBundleSessions& sessions) {
+    PutSource(writer, sessions.source);
+    writer->PutBool(sessions.use_default_fallback);
+    std::vector<const std::string*> exchanges;
+    exchanges.reserve(sessions.rules.size());
+    for (const auto& entry : sessions.rules) {
+        exchanges.push_back(&entry.first);
+    }
+    std::sort(exchanges.begin(), exchanges.end(),
+              [](const std::string* lhs, const std::string* rhs) { return *lhs < *rhs; });
+    writer->Put(static_cast<std::uint32_t>(exchanges.size()));
+    for (const std::string* exchange : exchanges) {
+        const auto& rules = sessions.rules.at(*exchange);
+        writer->PutString(*exchange);
+        writer->Put(static_cast<std::uint32_t>(rules.size()));
+        for (const auto& rule : rules) {
+            writer->PutString(rule.instrument_prefix);
+            writer->PutString(rule.product);
+            writer->Put(static_cast<std::uint32_t>(rule.intervals.size()));
+            for (const auto& interval : rule.intervals) {
+                writer->Put(static_cast<std::int32_t>(interval.start_minute));
+                writer->Put(static_cast<std::int32_t>(interval.end_minute));
+            }
+        }
+    }
+}
+
+bool IsMinuteOfDay(std::int32_t minute) {
+    return minute >= 0 && minute < CompiledSessionCalendar::kMinutesPerDay;
+}
+
+bool GetSessions(BinarySectionReader* reader, StartupBundleSessions* sessions) {
+    std::uint32_t exchange_count = 0;
+    if (!GetSource(reader, &sessions->source) ||
+        !reader->GetBool(&sessions->use_default_fallback) || !reader->Get(&exchange_count)) {
+        return false;
+    }
+    for (std::uint32_t exchange_index = 0; exchange_index < exchange_count; ++exchange_index) {
+        std::string exchange;
+        std::uint32_t rule_count = 0;
+        if (!reader->GetString(&exchange) || sessions->rules.count(exchange) != 0 ||
+            !reader->Get(&rule_count)) {
+            return false;
+        }
+        auto& rules = sessions->rules[exchange];
+        rules.resize(rule_count);
+        for (auto& rule : rules) {
+            std::uint32_t interval_count = 0;
+            if (!reader->GetString(&rule.instrument_prefix) || !reader->GetString(&rule.product) ||
+                !reader->Get(&interval_count)) {
+                return false;
+            }
+            rule.intervals.resize(interval_count);
+            for (auto& interval : rule.intervals) {
+                std::int32_t start = 0;
+                std::int32_t end = 0;
+                if (!reader->Get(&start) || !reader->Get(&end) || !IsMinuteOfDay(start) ||
+                    !IsMinuteOfDay(end)) {
+                    return false;
+                }
+                interval.start_minute = start;
+                interval.end_minute = end;
+            }
+        }
+    }
+    return reader->AtEnd();
+}
+
+}  // namespace
+
+bool StatStartupBundleSource(const std::string& path, StartupBundleSource* out,
+                             std::string* error) {
+    if (out == nullptr || path.empty()) {
+        SetError(error, "invalid startup bundle source");
+        return false;
+    }
+    *out = StartupBundleSource{};
+    out->path = path;
+    std::error_code ec;
+    out->exists = std::filesystem::is_regular_file(path, ec);
+    if (!out->exists) {
+        return true;
+    }
+    out->size_bytes = static_cast<std::uint64_t>(std::filesystem::file_size(path, ec));
+    if (ec) {
+        SetError(error, "failed to stat startup bundle source " + path + ": " + ec.message());
+        return false;
+    }
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        SetError(error, "failed to stat startup bundle source " + path + ": " + ec.message());
+        return false;
+    }
+    out->mtime_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count();
+    return true;
+}
+
+bool IsStartupBundleSourceCurrent(const StartupBundleSource& source, std::string* reason) {
+    StartupBundleSource now;
+    std::string stat_error;
+    if (!StatStartupBundleSource(source.path, &now, &stat_error)) {
+        SetError(reason, stat_error);
+        return false;
+    }
+    if (now.exists != source.exists) {
+        SetError(reason, source.exists ? "source_removed" : "source_created");
+        return false;
+    }
+    if (now.size_bytes != source.size_bytes || now.mtime_ns != source.mtime_ns) {
+        SetError(reason, "source_modified");
+        return false;
+    }
+    return true;
+}
+
+bool BuildStartupBundle(const std::vector<std::string>& instrument_cache_paths,
+                        const std::string& trading_sessions_config_path,
+                        bool use_default_session_fallback, EpochNanos generated_ts_ns,
+                        StartupBundle* out, std::string* error) {
+    if (out == nullptr) {
+        SetError(error, "startup bundle output is null");
+        return false;
+    }
+    StartupBundle bundle;
+    bundle.generated_ts_ns = generated_ts_ns;
+    std::unordered_set<std::string> products;
+    for (const auto& path : instrument_cache_paths) {
+        StartupBundleInstrumentCache cache;
+        std::string load_error;
+        // Stat before parsing so a concurrent rewrite makes the section stale, not wrong.
+        if (!StatStartupBundleSource(path, &cache.source, error)) {
+            return false;
+        }
+        if (!LoadInstrumentMetaCacheDocument(path, &cache.document, &load_error)) {
+            SetError(error, "failed to load instrument cache " + path + ": " + load_error);
+            return false;
+        }
+        if (!products.insert(Lowercase(cache.document.product_id)).second) {
+            SetError(error, "duplicate instrument cache for product " +
+                                cache.document.product_id + ": " + path);
+            return false;
+        }
+        bundle.instrument_caches.push_back(std::move(cache));
+    }
+    std::sort(bundle.instrument_caches.begin(), bundle.instrument_caches.end(),
+              [](const auto& lhs, const auto& rhs) {
+                  return lhs.document.product_id < rhs.document.product_id;
+              });
+
+    const std::string sessions_path =
+        CompiledSessionCalendar::ResolveConfigPath(trading_sessions_config_path);
+    if (!sessions_path.empty()) {
+        if (!StatStartupBundleSource(sessions_path, &bundle.sessions.source, error)) {
+            return false;
+        }
+        bundle.sessions.use_default_fallback = use_default_session_fallback;
+        bundle.sessions.rules =
+            CompiledSessionCalendar::LoadRules(sessions_path, use_default_session_fallback);
+        bundle.has_sessions = true;
+    }
+    *out = std::move(bundle);
+    return true;
+}
+
+std::string EncodeStartupBundle(const StartupBundle& bundle) {
+    std::string out;
+    BinarySectionWriter writer(&out);
+
+    writer.BeginSection(static_cast<std::uint32_t>(BundleSection::kManifest));
+    writer.Put(bundle.generated_ts_ns);
+    writer.EndSection();
+    for (const auto& cache : bundle.instrument_caches) {
+        writer.BeginSection(static_cast<std::uint32_t>(BundleSection::kInstrumentCache));
+        PutInstrumentCache(&writer, cache);
+        writer.EndSection();
+    }
+    if (bundle.has_sessions) {
+        writer.BeginSection(static_cast<std::uint32_t>(BundleSection::kSessions));
+        PutSessions(&writer, bundle.sessions);
+        writer.EndSection();
+    }
+
+    writer.Finish(kBundleFormat);
+    return out;
+}
+
+bool DecodeStartupBundle(const char* data, std::size_t size, StartupBundle* out,
+                         std::string* error) {
+    if (out == nullptr) {
+        SetError(error, "startup bundle output is null");
+        return false;
+    }
+    std::vector<BinarySection> sections;
+    if (!SplitBinarySections(data, size, kBundleFormat, &sections, error)) {
+        return false;
+    }
+
+    StartupBundle bundle;
+    bool saw_manifest = false;
+    std::unordered_set<std::string> products;
+    for (const BinarySection& section : sections) {
+        BinarySectionReader reader(section.payload, section.payload_bytes);
+        bool ok = true;
+        switch (static_cast<BundleSection>(section.kind)) {
+            case BundleSection::kManifest:
+                ok = !saw_manifest && reader.Get(&bundle.generated_ts_ns) && reader.AtEnd();
+                saw_manifest = true;
+                break;
+            case BundleSection::kInstrumentCache: {
+                StartupBundleInstrumentCache cache;
+                ok = GetInstrumentCache(&reader, &cache) &&
+                     products.insert(Lowercase(cache.document.product_id)).second;
+                bundle.instrument_caches.push_back(std::move(cache));
+                break;
+            }
+            case BundleSection::kSessions:
+                ok = !bundle.has_sessions && GetSessions(&reader, &bundle.sessions);
+                bundle.has_sessions = true;
+                break;
+            default:
+                ok = false;
+                break;
+        }
+        if (!ok) {
+            SetError(error, "malformed startup bundle section " + std::to_string(section.kind));
+            return false;
+        }
+    }
+    if (!saw_manifest) {
+        SetError(error, "startup bundle has no manifest");
+        return false;
+    }
+    *out = std::move(bundle);
+    return true;
+}
+
+bool WriteStartupBundleAtomically(const std::string& path, const StartupBundle& bundle,
+                                  std::string* error) {
+    return WriteFileAtomically(path, EncodeStartupBundle(bundle), kBundleFormat.label, error);
+}
+
+bool LoadStartupBundle(const std::string& path, StartupBundle* out, std::string* error) {
+    MappedReadOnlyFile file;
+    if (!file.Open(path, kBundleFormat.label, error)) {
+        return false;
+    }
+    return DecodeStartupBundle(file.data(), file.size(), out, error);
+}
+
+const StartupBundleInstrumentCache* FindStartupBundleInstrumentCache(
+    const StartupBundle& bundle, const std::string& product_id) {
+    const std::string wanted = Lowercase(product_id);
+    for (const auto& cache : bundle.instrument_caches) {
+        if (Lowercase(cache.document.product_id) == wanted) {
+            return &cache;
+        }
+    }
+    return nullptr;
+}
+
+StartupPhaseTimer::StartupPhaseTimer()
+    : start_(std::chrono::steady_clock::now()), last_(start_) {}
+
+void StartupPhaseTimer::Mark(const std::string& phase) {
+    const auto now = std::chrono::steady_clock::now();
+    phases_ms_.emplace_back(
+        phase, std::chrono::duration_cast<std::chrono::milliseconds>(now - last_).count());
+    last_ = now;
+}
+
+LogFields StartupPhaseTimer::ReportFields() const {
+    LogFields fields;
+    fields.reserve(phases_ms_.size() + 1);
+    for (const auto& [phase, elapsed_ms] : phases_ms_) {
+        fields.emplace_back(phase + "_ms", std::to_string(elapsed_ms));
+    }
+    fields.emplace_back(
+        "total_ms",
+        std::to_string(
+            std::chrono::duration_cast<std::chrono::milliseconds>(last_ - start_).count()));
+    return fields;
+}
+
+}  // namespace quant_hft
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "quant_hft/apps/cli_support.h"
+#include "quant_hft/apps/startup_bundle.h"
+
+namespace {
+
+constexpr const char* kInstrumentCacheSuffix = "_contracts.json";
+
+bool ListInstrumentCaches(const std::string& directory, std::vector<std::string>* paths,
+                          std::string* error) {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec)) {
+        // No product has been queried yet; the bundle then only carries sessions.
+        return true;
+    }
+    const std::string suffix(kInstrumentCacheSuffix);
+    for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        const std::string name = it->path().filename().string();
+        if (it->is_regular_file() && name.size() > suffix.size() &&
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            paths->push_back(it->path().string());
+        }
+    }
+    if (ec) {
+        *error = "failed to list instrument caches in " + directory + ": " + ec.message();
+        return false;
+    }
+    std::sort(paths->begin(), paths->end());
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    using namespace quant_hft;
+    const apps::ArgMap args = apps::ParseArgs(argc, argv);
+    const std::string cache_dir =
+        apps::GetArg(args, "instrument-cache-dir", "runtime/ctp_instruments");
+    const std::string sessions_path =
+        apps::GetArg(args, "trading-sessions", "configs/trading_sessions.yaml");
+    const std::string output = apps::GetArg(args, "output", "runtime/startup_bundle.bin");
+    const bool use_default_fallback = apps::GetArg(args, "no-session-fallback") != "true";
+
+    std::string error;
+    std::vector<std::string> cache_paths;
+    if (!ListInstrumentCaches(cache_dir, &cache_paths, &error)) {
+        std::cerr << "startup_bundle_cli: " << error << '\n';
+        return 1;
+    }
+    const EpochNanos now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::system_clock::now().time_since_epoch())
+                                  .count();
+    StartupBundle bundle;
+    if (!BuildStartupBundle(cache_paths, sessions_path, use_default_fallback, now_ns, &bundle,
+                            &error) ||
+        !WriteStartupBundleAtomically(output, bundle, &error)) {
+        std::cerr << "startup_bundle_cli: " << error << '\n';
+        return 1;
+    }
+
+    std::size_t instrument_count = 0;
+    for (const auto& cache : bundle.instrument_caches) {
+        instrument_count += cache.document.instruments.size();
+    }
+    std::cout << "{\"output\":\"" << apps::JsonEscape(output)
+              << "\",\"products\":" << bundle.instrument_caches.size()
+              << ",\"instruments\":" << instrument_count
+              << ",\"sessions\":" << (bundle.has_sessions ? "true" : "false") << "}\n";
+    return 0;
+}
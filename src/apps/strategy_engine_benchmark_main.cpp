@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "quant_hft/strategy/live_strategy.h"
+#include "quant_hft/strategy/strategy_engine.h"
+#include "quant_hft/strategy/strategy_registry.h"
+
+namespace {
+
+using quant_hft::EpochNanos;
+
+std::int64_t SteadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct DispatchProbe {
+    std::atomic<std::uint64_t> callbacks{0};
+    std::atomic<std::uint64_t> latency_samples{0};
+    std::atomic<std::int64_t> latency_ns_total{0};
+    std::atomic<std::int64_t> latency_ns_max{0};
+};
+
+DispatchProbe g_probe;
+
+// Records enqueue-to-callback latency from the first strategy only; the others
+// just count callbacks so every state fans out to the full strategy set.
+class NoopStrategy final : public quant_hft::ILiveStrategy {
+   public:
+    void Initialize(const quant_hft::StrategyContext& ctx) override {
+        record_latency_ = ctx.strategy_id == "bench_0";
+    }
+
+    std::vector<quant_hft::SignalIntent> OnState(const quant_hft::StateSnapshot7D& state) override {
+        g_probe.callbacks.fetch_add(1, std::memory_order_relaxed);
+        if (record_latency_) {
+            const std::int64_t latency = SteadyNowNs() - state.ts_ns;
+            g_probe.latency_samples.fetch_add(1, std::memory_order_relaxed);
+            g_probe.latency_ns_total.fetch_add(latency, std::memory_order_relaxed);
+            std::int64_t previous = g_probe.latency_ns_max.load(std::memory_order_relaxed);
+            while (latency > previous &&
+                   !g_probe.latency_ns_max.compare_exchange_weak(previous, latency)) {
+            }
+        }
+        return {};
+    }
+
+    void OnOrderEvent(const quant_hft::OrderEvent& event) override { (void)event; }
+
+    std::vector<quant_hft::SignalIntent> OnTimer(EpochNanos now_ns) override {
+        (void)now_ns;
+        return {};
+    }
+
+    void Shutdown() override {}
+
+   private:
+    bool record_latency_{false};
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t states_per_sec = 50000;
+    std::size_t strategies = 20;
+    std::size_t duration_ms = 2000;
+    std::size_t queue_capacity = 8192;
+    std::size_t workers = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--states-per-sec" && i + 1 < argc) {
+            states_per_sec = static_cast<std::size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--strategies" && i + 1 < argc) {
+            strategies = static_cast<std::size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--duration-ms" && i + 1 < argc) {
+            duration_ms = static_cast<std::size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--queue-capacity" && i + 1 < argc) {
+            queue_capacity = static_cast<std::size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--workers" && i + 1 < argc) {
+            workers = static_cast<std::size_t>(std::stoull(argv[++i]));
+        }
+    }
+
+    if (states_per_sec == 0 || strategies == 0 || duration_ms == 0 || queue_capacity == 0 ||
+        workers == 0) {
+        std::cerr << "error=invalid_arguments" << std::endl;
+        return 2;
+    }
+
+    const std::string factory_name = "strategy_engine_benchmark_noop";
+    std::string error;
+    if (!quant_hft::StrategyRegistry::Instance().RegisterFactory(
+            factory_name, []() { return std::make_unique<NoopStrategy>(); }, &error)) {
+        std::cerr << "error=" << error << std::endl;
+        return 1;
+    }
+
+    quant_hft::StrategyEngineConfig config;
+    config.queue_capacity = queue_capacity;
+    config.metrics_collect_interval_ns = 0;
+    config.worker_count = workers;
+    quant_hft::StrategyEngine engine(config);
+    std::vector<std::string> strategy_ids;
+    for (std::size_t index = 0; index < strategies; ++index) {
+        strategy_ids.push_back("bench_" + std::to_string(index));
+    }
+    if (!engine.Start(strategy_ids, factory_name, quant_hft::StrategyContext{}, &error)) {
+        std::cerr << "error=" << error << std::endl;
+        return 1;
+    }
+
+    const std::size_t total_states = states_per_sec * duration_ms / 1000;
+    const auto interval = std::chrono::nanoseconds(1'000'000'000LL / states_per_sec);
+    quant_hft::StateSnapshot7D state;
+    state.instrument_id = "SHFE.rb2405";
+    state.timeframe_minutes = 1;
+    state.has_bar = true;
+
+    std::int64_t enqueue_ns_total = 0;
+    const auto started = std::chrono::steady_clock::now();
+    auto next_due = started;
+    for (std::size_t index = 0; index < total_states; ++index) {
+        while (std::chrono::steady_clock::now() < next_due) {
+            std::this_thread::yield();
+        }
+        next_due += interval;
+        state.bar_close = 3500.0 + static_cast<double>(index % 100);
+        state.ts_ns = SteadyNowNs();
+        engine.EnqueueState(state);
+        enqueue_ns_total += SteadyNowNs() - state.ts_ns;
+    }
+    const bool drained = engine.WaitUntilDrained(60'000);
+    const auto ended = std::chrono::steady_clock::now();
+    const auto stats = engine.GetStats();
+    engine.Stop();
+
+    const double elapsed_sec = std::chrono::duration<double>(ended - started).count();
+    const std::uint64_t samples = std::max<std::uint64_t>(1, g_probe.latency_samples.load());
+    std::cout << "strategies=" << strategies << "\n";
+    std::cout << "workers=" << engine.worker_count() << "\n";
+    std::cout << "target_states_per_sec=" << states_per_sec << "\n";
+    std::cout << "enqueued_states=" << stats.enqueued_events << "\n";
+    std::cout << "processed_states=" << stats.processed_events << "\n";
+    std::cout << "dropped_oldest_events=" << stats.dropped_oldest_events << "\n";
+    std::cout << "strategy_callbacks=" << g_probe.callbacks.load() << "\n";
+    std::cout << "achieved_states_per_sec="
+              << static_cast<double>(stats.processed_events) / std::max(elapsed_sec, 1e-9)
+              << "\n";
+    std::cout << "enqueue_ns_per_op="
+              << static_cast<double>(enqueue_ns_total) /
+                     static_cast<double>(std::max<std::size_t>(1, total_states))
+              << "\n";
+    std::cout << "dispatch_latency_ns_avg="
+              << static_cast<double>(g_probe.latency_ns_total.load()) /
+                     static_cast<double>(samples)
+              << "\n";
+    std::cout << "dispatch_latency_ns_max=" << g_probe.latency_ns_max.load() << "\n";
+    std::cout << "status=" << (drained ? "ok" : "drain_timeout") << "\n";
+    return drained ? 0 : 1;
+}
@@ -115,6 +115,10 @@ std::vector<std::string> NormalizeFields(const std::string& contract, const std:
     std::vector<std::string> normalized;
     normalized.reserve(fields.size());
     for (const std::string& field : fields) {
+        // Registry handles are process-local and never leave the process.
+        if (source == "C++" && field == "instrument_handle") {
+            continue;
+        }
         if (contract == "OrderIntent" && source == "proto" && field == "order_type") {
             normalized.push_back("type");
         } else {
@@ -47,22 +47,27 @@ std::string NormalizeStatus(std::string status) {
     return status;
 }
 
-double PercentileFromSorted(const std::vector<double>& sorted_values, double p) {
-    if (sorted_values.empty()) {
+// Linear-interpolated percentile via selection; reorders *values but avoids a full sort.
+double PercentileBySelection(std::vector<double>* values, double p) {
+    if (values == nullptr || values->empty()) {
         return 0.0;
     }
-    if (sorted_values.size() == 1) {
-        return sorted_values.front();
+    if (values->size() == 1) {
+        return values->front();
     }
     const double clamped_p = std::clamp(p, 0.0, 1.0);
-    const double index = clamped_p * static_cast<double>(sorted_values.size() - 1);
+    const double index = clamped_p * static_cast<double>(values->size() - 1);
     const std::size_t lo = static_cast<std::size_t>(std::floor(index));
     const std::size_t hi = static_cast<std::size_t>(std::ceil(index));
+    const auto lo_it = values->begin() + static_cast<std::ptrdiff_t>(lo);
+    std::nth_element(values->begin(), lo_it, values->end());
+    const double lo_value = *lo_it;
     if (lo == hi) {
-        return sorted_values[lo];
+        return lo_value;
     }
+    const double hi_value = *std::min_element(lo_it + 1, values->end());
     const double w = index - static_cast<double>(lo);
-    return sorted_values[lo] * (1.0 - w) + sorted_values[hi] * w;
+    return lo_value * (1.0 - w) + hi_value * w;
 }
 
 double Mean(const std::vector<double>& values) {
@@ -175,8 +180,288 @@ OlsEstimate ComputeSingleFactorOls(const std::vector<double>& returns,
     return estimate;
 }
 
+void AccumulateTradesByDay(const std::vector<TradeRecord>& trades,
+                           std::map<std::string, int>* day_trade_count,
+                           std::map<std::string, double>* day_turnover) {
+    for (const TradeRecord& trade : trades) {
+        const std::string day = NormalizeTradingDay(trade.trading_day).empty()
+                                    ? TradingDayFromEpochNs(trade.timestamp_ns)
+                                    : NormalizeTradingDay(trade.trading_day);
+        (*day_trade_count)[day] += 1;
+        (*day_turnover)[day] += std::fabs(trade.price * static_cast<double>(trade.volume));
+    }
+}
+
+void ApplyTradesByDay(const std::vector<TradeRecord>& trades,
+                      std::vector<DailyPerformance>* daily) {
+    if (trades.empty()) {
+        return;
+    }
+    std::map<std::string, int> day_trade_count;
+    std::map<std::string, double> day_turnover;
+    AccumulateTradesByDay(trades, &day_trade_count, &day_turnover);
+    for (DailyPerformance& perf : *daily) {
+        const auto trade_count_it = day_trade_count.find(perf.date);
+        if (trade_count_it != day_trade_count.end()) {
+            perf.trades_count = trade_count_it->second;
+        }
+        const auto turnover_it = day_turnover.find(perf.date);
+        if (turnover_it != day_turnover.end()) {
+            perf.turnover = turnover_it->second;
+        }
+    }
+}
+
+// Fills return/drawdown fields of one closing-equity row and advances the running state.
+void AdvanceDailyRow(double initial_capital, double* previous_capital, double* running_peak,
+                     DailyPerformance* perf) {
+    if (std::fabs(*previous_capital) > 1e-12) {
+        perf->daily_return_pct = (perf->capital - *previous_capital) / *previous_capital * 100.0;
+    }
+    if (std::fabs(initial_capital) > 1e-12) {
+        perf->cumulative_return_pct = (perf->capital - initial_capital) / initial_capital * 100.0;
+    }
+    *running_peak = std::max(*running_peak, perf->capital);
+    if (*running_peak > 0.0) {
+        perf->drawdown_pct = (*running_peak - perf->capital) / *running_peak * 100.0;
+    }
+    *previous_capital = perf->capital;
+}
+
+RollingWindowAccumulator::Aggregate MakeLeaf(double daily_return, double capital) {
+    RollingWindowAccumulator::Aggregate leaf;
+    leaf.count = 1;
+    leaf.mean = daily_return;
+    leaf.peak = capital;
+    leaf.trough = capital;
+    return leaf;
+}
+
+// Merges an older window segment with the newer one that follows it (Chan et al. for the
+// moments; the cross drawdown is the older peak against the newer trough).
+RollingWindowAccumulator::Aggregate Combine(const RollingWindowAccumulator::Aggregate& older,
+                                            const RollingWindowAccumulator::Aggregate& newer) {
+    if (older.count == 0) {
+        return newer;
+    }
+    if (newer.count == 0) {
+        return older;
+    }
+    RollingWindowAccumulator::Aggregate merged;
+    merged.count = older.count + newer.count;
+    const double older_n = static_cast<double>(older.count);
+    const double newer_n = static_cast<double>(newer.count);
+    const double total_n = static_cast<double>(merged.count);
+    const double delta = newer.mean - older.mean;
+    merged.mean = older.mean + delta * newer_n / total_n;
+    merged.m2 = older.m2 + newer.m2 + delta * delta * older_n * newer_n / total_n;
+    merged.peak = std::max(older.peak, newer.peak);
+    merged.trough = std::min(older.trough, newer.trough);
+    merged.max_drawdown_pct = std::max(older.max_drawdown_pct, newer.max_drawdown_pct);
+    if (older.peak > 0.0) {
+        merged.max_drawdown_pct = std::max(merged.max_drawdown_pct,
+                                           (older.peak - newer.trough) / older.peak * 100.0);
+    }
+    return merged;
+}
+
 }  // namespace
 
+RollingWindowAccumulator::RollingWindowAccumulator(int window_days)
+    : window_(static_cast<std::size_t>(std::max(2, window_days))) {
+    front_.reserve(window_);
+    back_.reserve(window_);
+}
+
+void RollingWindowAccumulator::Push(double daily_return, double capital) {
+    if (size() >= window_) {
+        PopOldest();
+    }
+    const Aggregate leaf = MakeLeaf(daily_return, capital);
+    back_total_ = back_.empty() ? leaf : Combine(back_total_, leaf);
+    back_.push_back(leaf);
+}
+
+void RollingWindowAccumulator::PopOldest() {
+    if (front_.empty()) {
+        for (std::size_t index = back_.size(); index-- > 0;) {
+            Entry entry;
+            entry.value = back_[index];
+            entry.suffix =
+                front_.empty() ? back_[index] : Combine(back_[index], front_.back().suffix);
+            front_.push_back(entry);
+        }
+        back_.clear();
+        back_total_ = Aggregate{};
+    }
+    if (!front_.empty()) {
+        front_.pop_back();
+    }
+}
+
+RollingWindowAccumulator::Aggregate RollingWindowAccumulator::Current() const {
+    if (front_.empty()) {
+        return back_total_;
+    }
+    return Combine(front_.back().suffix, back_total_);
+}
+
+double RollingWindowAccumulator::sharpe() const {
+    if (!full()) {
+        return 0.0;
+    }
+    const Aggregate aggregate = Current();
+    const double stdev = std::sqrt(aggregate.m2 / static_cast<double>(aggregate.count));
+    if (stdev > 1e-12) {
+        return (aggregate.mean / stdev) * std::sqrt(252.0);
+    }
+    return 0.0;
+}
+
+double RollingWindowAccumulator::max_drawdown_pct() const {
+    if (!full()) {
+        return 0.0;
+    }
+    return Current().max_drawdown_pct;
+}
+
+OnlineDailyMetrics::OnlineDailyMetrics(double initial_capital, int rolling_window_days)
+    : configured_initial_capital_(initial_capital),
+      rolling_window_days_(rolling_window_days),
+      accumulator_(rolling_window_days) {}
+
+void OnlineDailyMetrics::UpsertEquitySample(const EquitySample& sample) {
+    EquitySample normalized = sample;
+    normalized.trading_day = NormalizeTradingDay(sample.trading_day);
+    if (normalized.trading_day.empty()) {
+        normalized.trading_day = TradingDayFromEpochNs(sample.ts_ns);
+    }
+    if (normalized.trading_day.empty()) {
+        return;
+    }
+    const bool has_regime = !normalized.market_regime.empty();
+    auto upsert = [&normalized, has_regime](EquitySample* latest) {
+        if (normalized.ts_ns < latest->ts_ns) {
+            return;
+        }
+        latest->ts_ns = normalized.ts_ns;
+        latest->equity = normalized.equity;
+        latest->position_value = normalized.position_value;
+        if (has_regime) {
+            latest->market_regime = normalized.market_regime;
+        }
+    };
+    if (!has_regime) {
+        normalized.market_regime = "kUnknown";
+    }
+
+    if (!has_open_day_) {
+        open_day_ = std::move(normalized);
+        has_open_day_ = true;
+        return;
+    }
+    if (normalized.trading_day == open_day_.trading_day) {
+        upsert(&open_day_);
+        return;
+    }
+    if (normalized.trading_day > open_day_.trading_day) {
+        CloseDay(open_day_, &state_, &accumulator_, &closed_, &closed_rolling_);
+        closed_samples_.push_back(std::move(open_day_));
+        open_day_ = std::move(normalized);
+        return;
+    }
+
+    auto late_it = late_samples_.find(normalized.trading_day);
+    if (late_it == late_samples_.end()) {
+        const auto closed_it = std::find_if(
+            closed_samples_.begin(), closed_samples_.end(),
+            [&normalized](const EquitySample& row) {
+                return row.trading_day == normalized.trading_day;
+            });
+        if (closed_it == closed_samples_.end()) {
+            late_samples_.emplace(normalized.trading_day, normalized);
+            return;
+        }
+        late_it = late_samples_.emplace(normalized.trading_day, *closed_it).first;
+    }
+    upsert(&late_it->second);
+}
+
+double OnlineDailyMetrics::rolling_sharpe_last() const {
+    return closed_rolling_.rolling_sharpe_3m.empty() ? 0.0
+                                                     : closed_rolling_.rolling_sharpe_3m.back();
+}
+
+double OnlineDailyMetrics::rolling_max_dd_last() const {
+    return closed_rolling_.rolling_max_dd_3m.empty() ? 0.0
+                                                     : closed_rolling_.rolling_max_dd_3m.back();
+}
+
+void OnlineDailyMetrics::CloseDay(const EquitySample& sample, DailyState* state,
+                                  RollingWindowAccumulator* accumulator,
+                                  std::vector<DailyPerformance>* daily,
+                                  RollingMetrics* rolling) const {
+    if (!state->started) {
+        state->initial_capital =
+            configured_initial_capital_ <= 0.0 ? sample.equity : configured_initial_capital_;
+        state->previous_capital = state->initial_capital;
+        state->running_peak = state->initial_capital;
+        state->started = true;
+    }
+    DailyPerformance perf;
+    perf.date = sample.trading_day;
+    perf.capital = sample.equity;
+    perf.position_value = sample.position_value;
+    perf.market_regime = sample.market_regime.empty() ? "kUnknown" : sample.market_regime;
+    AdvanceDailyRow(state->initial_capital, &state->previous_capital, &state->running_peak, &perf);
+
+    accumulator->Push(perf.daily_return_pct / 100.0, perf.capital);
+    rolling->rolling_sharpe_3m.push_back(accumulator->sharpe());
+    rolling->rolling_max_dd_3m.push_back(accumulator->max_drawdown_pct());
+    daily->push_back(std::move(perf));
+}
+
+std::vector<DailyPerformance> OnlineDailyMetrics::Finalize(const std::vector<TradeRecord>& trades,
+                                                           RollingMetrics* rolling) const {
+    if (!late_samples_.empty()) {
+        std::map<std::string, EquitySample> merged;
+        for (const EquitySample& sample : closed_samples_) {
+            merged[sample.trading_day] = sample;
+        }
+        if (has_open_day_) {
+            merged[open_day_.trading_day] = open_day_;
+        }
+        for (const auto& [day, sample] : late_samples_) {
+            merged[day] = sample;
+        }
+        std::vector<EquitySample> samples;
+        samples.reserve(merged.size());
+        for (const auto& [day, sample] : merged) {
+            (void)day;
+            samples.push_back(sample);
+        }
+        std::vector<DailyPerformance> daily =
+            ComputeDailyMetrics(samples, trades, configured_initial_capital_);
+        if (rolling != nullptr) {
+            *rolling = ComputeRollingMetrics(daily, rolling_window_days_);
+        }
+        return daily;
+    }
+
+    std::vector<DailyPerformance> daily = closed_;
+    RollingMetrics series = closed_rolling_;
+    if (has_open_day_) {
+        DailyState state = state_;
+        RollingWindowAccumulator accumulator = accumulator_;
+        CloseDay(open_day_, &state, &accumulator, &daily, &series);
+    }
+    ApplyTradesByDay(trades, &daily);
+    if (rolling != nullptr) {
+        *rolling = std::move(series);
+    }
+    return daily;
+}
+
 std::vector<DailyPerformance> ComputeDailyMetrics(const std::vector<EquitySample>& equity_history,
                                                   const std::vector<TradeRecord>& trades,
                                                   double initial_capital) {
@@ -209,13 +494,7 @@ std::vector<DailyPerformance> ComputeDailyMetrics(const std::vector<EquitySample
 
     std::map<std::string, int> day_trade_count;
     std::map<std::string, double> day_turnover;
-    for (const TradeRecord& trade : trades) {
-        const std::string day = NormalizeTradingDay(trade.trading_day).empty()
-                                    ? TradingDayFromEpochNs(trade.timestamp_ns)
-                                    : NormalizeTradingDay(trade.trading_day);
-        day_trade_count[day] += 1;
-        day_turnover[day] += std::fabs(trade.price * static_cast<double>(trade.volume));
-    }
+    AccumulateTradesByDay(trades, &day_trade_count, &day_turnover);
 
     std::vector<DailyPerformance> daily;
     daily.reserve(per_day.size());
@@ -241,17 +520,7 @@ std::vector<DailyPerformance> ComputeDailyMetrics(const std::vector<EquitySample
             perf.turnover = turnover_it->second;
         }
 
-        if (std::fabs(previous_capital) > 1e-12) {
-            perf.daily_return_pct = (perf.capital - previous_capital) / previous_capital * 100.0;
-        }
-        if (std::fabs(initial_capital) > 1e-12) {
-            perf.cumulative_return_pct = (perf.capital - initial_capital) / initial_capital * 100.0;
-        }
-        running_peak = std::max(running_peak, perf.capital);
-        if (running_peak > 0.0) {
-            perf.drawdown_pct = (running_peak - perf.capital) / running_peak * 100.0;
-        }
-        previous_capital = perf.capital;
+        AdvanceDailyRow(initial_capital, &previous_capital, &running_peak, &perf);
         daily.push_back(std::move(perf));
     }
 
@@ -270,14 +539,13 @@ RiskMetrics ComputeRiskMetrics(const std::vector<DailyPerformance>& daily) {
         returns.push_back(row.daily_return_pct / 100.0);
     }
 
-    std::vector<double> sorted_returns = returns;
-    std::sort(sorted_returns.begin(), sorted_returns.end());
-    const double q05 = PercentileFromSorted(sorted_returns, 0.05);
+    std::vector<double> selection = returns;
+    const double q05 = PercentileBySelection(&selection, 0.05);
     metrics.var_95 = std::max(0.0, -q05 * 100.0);
 
     double es_sum = 0.0;
     int es_count = 0;
-    for (const double value : sorted_returns) {
+    for (const double value : returns) {
         if (value <= q05) {
             es_sum += value;
             ++es_count;
@@ -353,11 +621,10 @@ ExecutionQuality ComputeExecutionQuality(const std::vector<OrderRecord>& orders,
     quality.slippage_mean = Mean(slippages);
     quality.slippage_std = StdDev(slippages, quality.slippage_mean);
 
-    std::sort(slippages.begin(), slippages.end());
     quality.slippage_percentiles = {
-        PercentileFromSorted(slippages, 0.25),
-        PercentileFromSorted(slippages, 0.50),
-        PercentileFromSorted(slippages, 0.75),
+        PercentileBySelection(&slippages, 0.25),
+        PercentileBySelection(&slippages, 0.50),
+        PercentileBySelection(&slippages, 0.75),
     };
     return quality;
 }
@@ -368,39 +635,13 @@ RollingMetrics ComputeRollingMetrics(const std::vector<DailyPerformance>& daily,
         return metrics;
     }
 
-    const int window = std::max(2, window_days);
-    std::vector<double> returns;
-    std::vector<double> capitals;
-    returns.reserve(daily.size());
-    capitals.reserve(daily.size());
-    for (const DailyPerformance& row : daily) {
-        returns.push_back(row.daily_return_pct / 100.0);
-        capitals.push_back(row.capital);
-    }
-
+    RollingWindowAccumulator accumulator(window_days);
     metrics.rolling_sharpe_3m.reserve(daily.size());
     metrics.rolling_max_dd_3m.reserve(daily.size());
-    for (std::size_t end = 0; end < daily.size(); ++end) {
-        if (static_cast<int>(end + 1) < window) {
-            metrics.rolling_sharpe_3m.push_back(0.0);
-            metrics.rolling_max_dd_3m.push_back(0.0);
-            continue;
-        }
-        const std::size_t begin = end + 1 - static_cast<std::size_t>(window);
-
-        std::vector<double> window_returns(returns.begin() + static_cast<std::ptrdiff_t>(begin),
-                                           returns.begin() + static_cast<std::ptrdiff_t>(end + 1));
-        const double mean = Mean(window_returns);
-        const double stdev = StdDev(window_returns, mean);
-        double sharpe = 0.0;
-        if (stdev > 1e-12) {
-            sharpe = (mean / stdev) * std::sqrt(252.0);
-        }
-        metrics.rolling_sharpe_3m.push_back(sharpe);
-
-        std::vector<double> window_capitals(capitals.begin() + static_cast<std::ptrdiff_t>(begin),
-                                            capitals.begin() + static_cast<std::ptrdiff_t>(end + 1));
-        metrics.rolling_max_dd_3m.push_back(MaxDrawdownPct(window_capitals));
+    for (const DailyPerformance& row : daily) {
+        accumulator.Push(row.daily_return_pct / 100.0, row.capital);
+        metrics.rolling_sharpe_3m.push_back(accumulator.sharpe());
+        metrics.rolling_max_dd_3m.push_back(accumulator.max_drawdown_pct());
     }
 
     return metrics;
@@ -537,12 +778,9 @@ MonteCarloResult ComputeMonteCarloResult(const std::vector<DailyPerformance>& da
     result.mean_final_capital = Mean(final_capitals);
     result.prob_loss = static_cast<double>(loss_count) / static_cast<double>(simulations);
 
-    std::sort(final_capitals.begin(), final_capitals.end());
-    result.ci_95_lower = PercentileFromSorted(final_capitals, 0.025);
-    result.ci_95_upper = PercentileFromSorted(final_capitals, 0.975);
-
-    std::sort(max_drawdowns.begin(), max_drawdowns.end());
-    result.max_drawdown_95 = PercentileFromSorted(max_drawdowns, 0.95);
+    result.ci_95_lower = PercentileBySelection(&final_capitals, 0.025);
+    result.ci_95_upper = PercentileBySelection(&final_capitals, 0.975);
+    result.max_drawdown_95 = PercentileBySelection(&max_drawdowns, 0.95);
     return result;
 }
 
@@ -579,13 +817,22 @@ std::vector<FactorExposure> ComputeFactorExposure(const std::vector<DailyPerform
 
 AdvancedSummary ComputeAdvancedSummary(const std::vector<DailyPerformance>& daily,
                                        const std::vector<TradeRecord>& trades,
-                                       const RiskMetrics& /*risk_metrics*/) {
+                                       const RiskMetrics& risk_metrics) {
+    if (daily.empty()) {
+        return AdvancedSummary{};
+    }
+    return ComputeAdvancedSummary(daily, trades, risk_metrics, ComputeRollingMetrics(daily, 63));
+}
+
+AdvancedSummary ComputeAdvancedSummary(const std::vector<DailyPerformance>& daily,
+                                       const std::vector<TradeRecord>& trades,
+                                       const RiskMetrics& /*risk_metrics*/,
+                                       const RollingMetrics& rolling) {
     AdvancedSummary summary;
     if (daily.empty()) {
         return summary;
     }
 
-    const RollingMetrics rolling = ComputeRollingMetrics(daily, 63);
     if (!rolling.rolling_sharpe_3m.empty()) {
         summary.rolling_sharpe_3m_last = rolling.rolling_sharpe_3m.back();
     }
@@ -607,10 +854,9 @@ AdvancedSummary ComputeAdvancedSummary(const std::vector<DailyPerformance>& dail
         }
     }
 
-    std::vector<double> sorted = returns;
-    std::sort(sorted.begin(), sorted.end());
-    const double q95 = PercentileFromSorted(sorted, 0.95);
-    const double q05 = PercentileFromSorted(sorted, 0.05);
+    std::vector<double> selection = returns;
+    const double q95 = PercentileBySelection(&selection, 0.95);
+    const double q05 = PercentileBySelection(&selection, 0.05);
     const double mean_return = Mean(returns);
     const double std_return = StdDev(returns, mean_return);
     if (std_return > 1e-12) {
@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <deque>
 #include <utility>
 
 namespace quant_hft::backtest {
@@ -11,25 +10,16 @@ SimulatedBroker::SimulatedBroker(BrokerConfig config)
     : config_(config), account_balance_(config.initial_capital) {}
 
 void SimulatedBroker::OnTick(const Tick& tick) {
-    last_tick_by_symbol_[tick.symbol] = tick;
-
-    auto process_side = [&](std::vector<PendingOrder>* orders) {
-        for (auto* pending = orders->data(); pending != orders->data() + orders->size(); ++pending) {
-            if (pending->remaining_volume <= 0 || pending->order.symbol != tick.symbol) {
-                continue;
-            }
-            TryMatchOrder(pending, tick);
-        }
-
-        orders->erase(
-            std::remove_if(orders->begin(), orders->end(), [](const PendingOrder& pending) {
-                return pending.remaining_volume <= 0 || pending.order.status == OrderStatus::kCanceled;
-            }),
-            orders->end());
-    };
-
-    process_side(&buy_orders_);
-    process_side(&sell_orders_);
+    SymbolBook& book = tick.instrument_handle != kInvalidInstrumentId
+                           ? BookFor(tick.instrument_handle, tick.symbol)
+                           : ResolveBook(tick.symbol);
+    book.quote.ts_ns = tick.ts_ns;
+    book.quote.last_price = tick.last_price;
+    book.quote.last_volume = tick.last_volume;
+    book.quote.ask_price1 = tick.ask_price1;
+    book.quote.bid_price1 = tick.bid_price1;
+    book.has_quote = true;
+    MatchBook(&book);
 }
 
 std::string SimulatedBroker::PlaceOrder(const OrderIntent& intent) {
@@ -56,21 +46,29 @@ std::string SimulatedBroker::PlaceOrder(const OrderIntent& intent) {
         order_callback_(pending.order);
     }
 
+    SymbolBook& book = ResolveBook(pending.order.symbol);
+    std::string order_id = pending.order.order_id;
+    order_books_[order_id] = &book;
     if (pending.order.side == Side::kBuy) {
-        buy_orders_.push_back(pending);
+        book.buy_orders.push_back(std::move(pending));
     } else {
-        sell_orders_.push_back(pending);
+        book.sell_orders.push_back(std::move(pending));
     }
 
-    const auto tick_it = last_tick_by_symbol_.find(pending.order.symbol);
-    if (tick_it != last_tick_by_symbol_.end()) {
-        OnTick(tick_it->second);
+    if (book.has_quote) {
+        MatchBook(&book);
     }
 
-    return pending.order.order_id;
+    return order_id;
 }
 
 bool SimulatedBroker::CancelOrder(const std::string& client_order_id) {
+    const auto book_it = order_books_.find(client_order_id);
+    if (book_it == order_books_.end()) {
+        return false;
+    }
+    SymbolBook& book = *book_it->second;
+
     auto cancel_in = [&](std::vector<PendingOrder>* orders) {
         for (auto& pending : *orders) {
             if (pending.order.order_id != client_order_id) {
@@ -78,6 +76,8 @@ bool SimulatedBroker::CancelOrder(const std::string& client_order_id) {
             }
             pending.order.status = OrderStatus::kCanceled;
             pending.remaining_volume = 0;
+            // The entry itself is swept from the book on the next match.
+            order_books_.erase(book_it);
             if (order_callback_) {
                 order_callback_(pending.order);
             }
@@ -86,19 +86,18 @@ bool SimulatedBroker::CancelOrder(const std::string& client_order_id) {
         return false;
     };
 
-    return cancel_in(&buy_orders_) || cancel_in(&sell_orders_);
+    return cancel_in(&book.buy_orders) || cancel_in(&book.sell_orders);
 }
 
 std::vector<Position> SimulatedBroker::GetPositions(const std::string& symbol) const {
     std::vector<Position> result;
-    for (const auto& [instrument, lots] : lots_by_symbol_) {
-        if (!symbol.empty() && instrument != symbol) {
-            continue;
+    auto append = [&](const std::string& instrument, const SymbolBook& book) {
+        if (!book.has_position || (!symbol.empty() && instrument != symbol)) {
+            return;
         }
-
         Position position;
         position.symbol = instrument;
-        for (const auto& lot : lots) {
+        for (const auto& lot : book.lots) {
             if (lot.direction == PositionDirection::kLong) {
                 position.long_qty += lot.volume;
             } else {
@@ -106,6 +105,13 @@ std::vector<Position> SimulatedBroker::GetPositions(const std::string& symbol) c
             }
         }
         result.push_back(position);
+    };
+    const InstrumentRegistry& registry = InstrumentRegistry::Global();
+    books_.ForEach([&](InstrumentId id, const SymbolBook& book) {
+        append(registry.Info(id).instrument_id, book);
+    });
+    for (const auto& [instrument, book] : unregistered_books_) {
+        append(instrument, book);
     }
     return result;
 }
@@ -122,13 +128,67 @@ void SimulatedBroker::SetOrderCallback(std::function<void(const Order&)> callbac
     order_callback_ = std::move(callback);
 }
 
-void SimulatedBroker::TryMatchOrder(PendingOrder* pending, const Tick& tick) {
+SimulatedBroker::SymbolBook& SimulatedBroker::ResolveBook(const std::string& symbol) {
+    auto [cached, inserted] = books_by_symbol_.try_emplace(symbol, nullptr);
+    if (inserted) {
+        const InstrumentId id = InstrumentRegistry::Global().Intern(symbol);
+        if (id == kInvalidInstrumentId) {
+            SymbolBook* book = &unregistered_books_[symbol];
+            book->contract_multiplier = ResolveContractMultiplier(id, symbol);
+            cached->second = book;
+        } else {
+            cached->second = &BookFor(id, symbol);
+        }
+    }
+    return *cached->second;
+}
+
+SimulatedBroker::SymbolBook& SimulatedBroker::BookFor(InstrumentId id, const std::string& symbol) {
+    SymbolBook* book = books_.Find(id);
+    if (book == nullptr) {
+        book = &books_[id];
+        book->contract_multiplier = ResolveContractMultiplier(id, symbol);
+    }
+    return *book;
+}
+
+void SimulatedBroker::MatchBook(SymbolBook* book) {
+    auto process_side = [&](std::vector<PendingOrder>* orders) {
+        if (orders->empty()) {
+            return;
+        }
+        // Fill callbacks may place orders on this book, so iterate by index.
+        for (std::size_t index = 0; index < orders->size(); ++index) {
+            if ((*orders)[index].remaining_volume <= 0) {
+                continue;
+            }
+            TryMatchOrder(&(*orders)[index], book);
+        }
+
+        orders->erase(
+            std::remove_if(orders->begin(), orders->end(), [this](const PendingOrder& pending) {
+                const bool done = pending.remaining_volume <= 0 ||
+                                  pending.order.status == OrderStatus::kCanceled;
+                if (done) {
+                    order_books_.erase(pending.order.order_id);
+                }
+                return done;
+            }),
+            orders->end());
+    };
+
+    process_side(&book->buy_orders);
+    process_side(&book->sell_orders);
+}
+
+void SimulatedBroker::TryMatchOrder(PendingOrder* pending, SymbolBook* book) {
     if (pending->remaining_volume <= 0) {
         return;
     }
+    const BookQuote& quote = book->quote;
 
-    const double bid = tick.bid_price1 > 0.0 ? tick.bid_price1 : tick.last_price;
-    const double ask = tick.ask_price1 > 0.0 ? tick.ask_price1 : tick.last_price;
+    const double bid = quote.bid_price1 > 0.0 ? quote.bid_price1 : quote.last_price;
+    const double ask = quote.ask_price1 > 0.0 ? quote.ask_price1 : quote.last_price;
 
     bool should_fill = pending->is_market;
     double match_price = pending->order.side == Side::kBuy ? ask : bid;
@@ -147,19 +207,21 @@ void SimulatedBroker::TryMatchOrder(PendingOrder* pending, const Tick& tick) {
         return;
     }
 
-    const std::int32_t available_liquidity = tick.last_volume > 0 ? tick.last_volume : pending->remaining_volume;
+    const std::int32_t available_liquidity =
+        quote.last_volume > 0 ? quote.last_volume : pending->remaining_volume;
     std::int32_t fill_qty = pending->remaining_volume;
     if (config_.partial_fill_enabled) {
         fill_qty = std::max(1, std::min(pending->remaining_volume, available_liquidity));
     }
 
     const double filled_price = ApplySlippage(match_price, pending->order.side);
-    const double commission = ComputeCommission(*pending, fill_qty, filled_price);
+    const double commission =
+        ComputeCommission(*pending, fill_qty, filled_price, book->contract_multiplier);
 
     pending->remaining_volume -= fill_qty;
     pending->order.filled_quantity += fill_qty;
     pending->order.avg_fill_price = filled_price;
-    pending->order.updated_at_ns = tick.ts_ns;
+    pending->order.updated_at_ns = quote.ts_ns;
     pending->order.status = pending->remaining_volume == 0 ? OrderStatus::kFilled
                                                            : OrderStatus::kPartiallyFilled;
 
@@ -174,10 +236,10 @@ void SimulatedBroker::TryMatchOrder(PendingOrder* pending, const Tick& tick) {
     trade.offset = pending->offset;
     trade.price = filled_price;
     trade.quantity = fill_qty;
-    trade.trade_ts_ns = tick.ts_ns;
+    trade.trade_ts_ns = quote.ts_ns;
     trade.commission = commission;
 
-    trade.profit = ApplyTradeToPosition(trade);
+    trade.profit = ApplyTradeToPosition(trade, book);
     account_balance_ += trade.profit;
     account_balance_ -= commission;
 
@@ -191,9 +253,9 @@ void SimulatedBroker::TryMatchOrder(PendingOrder* pending, const Tick& tick) {
 
 double SimulatedBroker::ComputeCommission(const PendingOrder& pending,
                                           std::int32_t fill_qty,
-                                          double fill_price) const {
-    const double amount =
-        fill_price * static_cast<double>(fill_qty) * ResolveContractMultiplier(pending.order.symbol);
+                                          double fill_price,
+                                          double contract_multiplier) const {
+    const double amount = fill_price * static_cast<double>(fill_qty) * contract_multiplier;
     const bool is_close = pending.offset != OffsetFlag::kOpen;
     const double rate = is_close ? config_.close_today_commission_rate : config_.commission_rate;
     return amount * rate;
@@ -206,9 +268,10 @@ double SimulatedBroker::ApplySlippage(double raw_price, Side side) const {
     return side == Side::kBuy ? raw_price + config_.slippage : raw_price - config_.slippage;
 }
 
-double SimulatedBroker::ApplyTradeToPosition(const Trade& trade) {
-    auto& lots = lots_by_symbol_[trade.symbol];
-    const double contract_multiplier = ResolveContractMultiplier(trade.symbol);
+double SimulatedBroker::ApplyTradeToPosition(const Trade& trade, SymbolBook* book) {
+    book->has_position = true;
+    auto& lots = book->lots;
+    const double contract_multiplier = book->contract_multiplier;
     double realized_total = 0.0;
 
     auto consume_lots = [&](PositionDirection direction_to_consume, std::int32_t qty_to_close) {
@@ -256,7 +319,16 @@ double SimulatedBroker::ApplyTradeToPosition(const Trade& trade) {
     return realized_total;
 }
 
-double SimulatedBroker::ResolveContractMultiplier(const std::string& symbol) const {
+double SimulatedBroker::ResolveContractMultiplier(InstrumentId id,
+                                                  const std::string& symbol) const {
+    // Exchange metadata registered for the instrument wins; the config covers replays that run
+    // without an instrument cache.
+    if (id != kInvalidInstrumentId) {
+        const std::int32_t volume_multiple = InstrumentRegistry::Global().Info(id).volume_multiple;
+        if (volume_multiple > 0) {
+            return static_cast<double>(volume_multiple);
+        }
+    }
     const auto it = config_.contract_multipliers.find(symbol);
     if (it == config_.contract_multipliers.end() || !std::isfinite(it->second) || it->second <= 0.0) {
         return 1.0;
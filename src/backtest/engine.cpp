@@ -35,17 +35,32 @@ void BacktestEngine::Run() {
         nullptr);
 
     data_feed_->Run();
+
+    if (has_pending_equity_) {
+        result_.equity_curve.push_back(pending_equity_);
+        has_pending_equity_ = false;
+    }
 }
 
-BacktestResult BacktestEngine::GetResult() const {
+const BacktestResult& BacktestEngine::GetResult() const {
     return result_;
 }
 
+BacktestResult BacktestEngine::TakeResult() {
+    BacktestResult result = std::move(result_);
+    result_ = BacktestResult{};
+    return result;
+}
+
 void BacktestEngine::SetTimeRange(const Timestamp& start, const Timestamp& end) {
     start_time_ = start;
     end_time_ = end;
 }
 
+void BacktestEngine::SetEquitySampling(EquitySamplingConfig config) {
+    equity_sampling_ = config;
+}
+
 void BacktestEngine::ProcessEvent(const Event& event) {
     switch (event.type) {
         case EventType::kMarket:
@@ -65,11 +80,30 @@ void BacktestEngine::ProcessEvent(const Event& event) {
 void BacktestEngine::OnMarketData(const Tick& tick) {
     strategy_->OnTick(tick);
     broker_->OnTick(tick);
+    RecordEquity(tick.ts_ns, broker_->GetAccountBalance());
+}
+
+void BacktestEngine::RecordEquity(EpochNanos ts_ns, double balance) {
+    auto& curve = result_.equity_curve;
+    const bool every_tick = equity_sampling_.interval_ns <= 0 && !equity_sampling_.on_change;
+    bool keep = every_tick || curve.empty();
+    if (!keep && equity_sampling_.interval_ns > 0) {
+        keep = ts_ns - curve.back().time.ToEpochNanos() >= equity_sampling_.interval_ns;
+    }
+    if (!keep && equity_sampling_.on_change) {
+        keep = balance != curve.back().balance;
+    }
 
     EquityPoint point;
-    point.time = Timestamp(tick.ts_ns);
-    point.balance = broker_->GetAccountBalance();
-    result_.equity_curve.push_back(point);
+    point.time = Timestamp(ts_ns);
+    point.balance = balance;
+    if (keep) {
+        curve.push_back(point);
+        has_pending_equity_ = false;
+    } else {
+        pending_equity_ = point;
+        has_pending_equity_ = true;
+    }
 }
 
 void BacktestEngine::OnOrderUpdate(const Order& order) {
@@ -8,11 +8,15 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "quant_hft/core/instrument_registry.h"
+#include "quant_hft/core/simple_json.h"
+
 #if QUANT_HFT_ENABLE_ARROW_PARQUET
 #include <arrow/api.h>
 #include <arrow/io/file.h>
@@ -115,98 +119,6 @@ bool ParseSize(const std::string& raw, std::size_t* out) {
     }
 }
 
-bool ExtractJsonString(const std::string& json, const std::string& key, std::string* out) {
-    if (out == nullptr) {
-        return false;
-    }
-    const std::string quoted_key = "\"" + key + "\"";
-    const std::size_t key_pos = json.find(quoted_key);
-    if (key_pos == std::string::npos) {
-        return false;
-    }
-    const std::size_t colon_pos = json.find(':', key_pos + quoted_key.size());
-    if (colon_pos == std::string::npos) {
-        return false;
-    }
-
-    std::size_t pos = colon_pos + 1;
-    while (pos < json.size() && std::isspace(static_cast<unsigned char>(json[pos])) != 0) {
-        ++pos;
-    }
-    if (pos >= json.size() || json[pos] != '"') {
-        return false;
-    }
-    ++pos;
-
-    std::string value;
-    bool escaped = false;
-    while (pos < json.size()) {
-        const char ch = json[pos++];
-        if (escaped) {
-            switch (ch) {
-                case '"':
-                    value.push_back('"');
-                    break;
-                case '\\':
-                    value.push_back('\\');
-                    break;
-                case 'n':
-                    value.push_back('\n');
-                    break;
-                case 'r':
-                    value.push_back('\r');
-                    break;
-                case 't':
-                    value.push_back('\t');
-                    break;
-                default:
-                    value.push_back(ch);
-                    break;
-            }
-            escaped = false;
-            continue;
-        }
-        if (ch == '\\') {
-            escaped = true;
-            continue;
-        }
-        if (ch == '"') {
-            *out = value;
-            return true;
-        }
-        value.push_back(ch);
-    }
-    return false;
-}
-
-bool ExtractJsonInt64(const std::string& json, const std::string& key, std::int64_t* out) {
-    if (out == nullptr) {
-        return false;
-    }
-    const std::string quoted_key = "\"" + key + "\"";
-    const std::size_t key_pos = json.find(quoted_key);
-    if (key_pos == std::string::npos) {
-        return false;
-    }
-    const std::size_t colon_pos = json.find(':', key_pos + quoted_key.size());
-    if (colon_pos == std::string::npos) {
-        return false;
-    }
-    std::size_t start = colon_pos + 1;
-    while (start < json.size() && std::isspace(static_cast<unsigned char>(json[start])) != 0) {
-        ++start;
-    }
-    std::size_t end = start;
-    while (end < json.size() &&
-           (std::isdigit(static_cast<unsigned char>(json[end])) != 0 || json[end] == '-')) {
-        ++end;
-    }
-    if (end <= start) {
-        return false;
-    }
-    return ParseInt64(json.substr(start, end - start), out);
-}
-
 void LoadMetaFile(const std::filesystem::path& meta_path, ParquetPartitionMeta* out) {
     if (out == nullptr) {
         return;
@@ -616,6 +528,21 @@ bool LoadTicksFromSidecar(const ParquetPartitionMeta& partition, const Timestamp
 }
 #endif
 
+// Stamps each tick with its registry handle so the replay consumers skip their own lookup.  A
+// partition is normally one symbol, so the registry is consulted once per run of equal symbols.
+void InternTickSymbols(std::vector<Tick>* ticks) {
+    InstrumentRegistry& registry = InstrumentRegistry::Global();
+    const std::string* last_symbol = nullptr;
+    InstrumentId last_id = kInvalidInstrumentId;
+    for (Tick& tick : *ticks) {
+        if (last_symbol == nullptr || tick.symbol != *last_symbol) {
+            last_id = registry.Intern(tick.symbol);
+            last_symbol = &tick.symbol;
+        }
+        tick.instrument_handle = last_id;
+    }
+}
+
 }  // namespace
 
 ParquetDataFeed::ParquetDataFeed(std::string parquet_root)
@@ -659,7 +586,39 @@ bool ParquetDataFeed::LoadManifestJsonl(const std::string& manifest_path, std::s
 
         ParquetPartitionMeta meta;
         std::string file_path;
-        if (!ExtractJsonString(line, "file_path", &file_path)) {
+        bool has_file_path = false;
+        simple_json::ObjectCursor cursor(line);
+        std::string_view key;
+        simple_json::RawValue value;
+        std::int64_t parsed_int = 0;
+        while (cursor.Next(&key, &value)) {
+            if (key == "file_path") {
+                has_file_path = value.GetString(&file_path);
+            } else if (key == "source") {
+                value.GetString(&meta.source);
+            } else if (key == "trading_day") {
+                value.GetString(&meta.trading_day);
+            } else if (key == "instrument_id") {
+                value.GetString(&meta.instrument_id);
+            } else if (key == "schema_version") {
+                value.GetString(&meta.schema_version);
+            } else if (key == "source_csv_fingerprint") {
+                value.GetString(&meta.source_csv_fingerprint);
+            } else if (key == "min_ts_ns" && value.GetInt64(&parsed_int)) {
+                meta.min_ts_ns = static_cast<EpochNanos>(parsed_int);
+            } else if (key == "max_ts_ns" && value.GetInt64(&parsed_int)) {
+                meta.max_ts_ns = static_cast<EpochNanos>(parsed_int);
+            } else if (key == "row_count" && value.GetInt64(&parsed_int) && parsed_int >= 0) {
+                meta.row_count = static_cast<std::size_t>(parsed_int);
+            }
+        }
+        if (!cursor.ok()) {
+            if (error != nullptr) {
+                *error = "malformed manifest line: " + cursor.error();
+            }
+            return false;
+        }
+        if (!has_file_path) {
             if (error != nullptr) {
                 *error = "manifest line missing file_path";
             }
@@ -671,22 +630,6 @@ bool ParquetDataFeed::LoadManifestJsonl(const std::string& manifest_path, std::s
             parsed = root / parsed;
         }
         meta.file_path = parsed.lexically_normal().string();
-        ExtractJsonString(line, "source", &meta.source);
-        ExtractJsonString(line, "trading_day", &meta.trading_day);
-        ExtractJsonString(line, "instrument_id", &meta.instrument_id);
-        ExtractJsonString(line, "schema_version", &meta.schema_version);
-        ExtractJsonString(line, "source_csv_fingerprint", &meta.source_csv_fingerprint);
-
-        std::int64_t parsed_int = 0;
-        if (ExtractJsonInt64(line, "min_ts_ns", &parsed_int)) {
-            meta.min_ts_ns = static_cast<EpochNanos>(parsed_int);
-        }
-        if (ExtractJsonInt64(line, "max_ts_ns", &parsed_int)) {
-            meta.max_ts_ns = static_cast<EpochNanos>(parsed_int);
-        }
-        if (ExtractJsonInt64(line, "row_count", &parsed_int) && parsed_int >= 0) {
-            meta.row_count = static_cast<std::size_t>(parsed_int);
-        }
 
         if (meta.source.empty()) {
             for (const auto& segment : parsed) {
@@ -865,6 +808,7 @@ bool ParquetDataFeed::LoadPartitionTicks(const ParquetPartitionMeta& partition,
     }
 #endif
 
+    InternTickSymbols(out);
     std::sort(out->begin(), out->end(), [](const Tick& left, const Tick& right) {
         if (left.ts_ns != right.ts_ns) {
             return left.ts_ns < right.ts_ns;
@@ -6,11 +6,13 @@
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #if QUANT_HFT_ENABLE_ARROW_PARQUET
 #include <arrow/api.h>
-#include <arrow/io/file.h>
-#include <parquet/arrow/writer.h>
+
+#include "trace_parquet_file_sink.h"
 #endif
 
 namespace quant_hft {
@@ -77,10 +79,93 @@ bool FinishArray(BuilderT* builder, const std::string& name, std::shared_ptr<arr
     return ExpectArrowStatus(status, "failed to finalize sub-strategy trace field '" + name + "'",
                              error);
 }
+
+bool AppendOptional(const std::optional<double>& value, arrow::DoubleBuilder* builder,
+                    const std::string& field_name, std::string* error) {
+    if (!value.has_value()) {
+        return ExpectArrowStatus(builder->AppendNull(), "failed appending null for " + field_name,
+                                 error);
+    }
+    return ExpectArrowStatus(builder->Append(*value), "failed appending " + field_name, error);
+}
+
+std::shared_ptr<arrow::Schema> MakeSubStrategyTraceSchema() {
+    return arrow::schema({
+        arrow::field("instrument_id", arrow::utf8(), false),
+        arrow::field("ts_ns", arrow::int64(), false),
+        arrow::field("dt_utc", arrow::utf8(), false),
+        arrow::field("trading_day", arrow::utf8(), false),
+        arrow::field("action_day", arrow::utf8(), false),
+        arrow::field("timeframe_minutes", arrow::int32(), false),
+        arrow::field("strategy_id", arrow::utf8(), false),
+        arrow::field("strategy_type", arrow::utf8(), false),
+        arrow::field("bar_open", arrow::float64(), false),
+        arrow::field("bar_high", arrow::float64(), false),
+        arrow::field("bar_low", arrow::float64(), false),
+        arrow::field("bar_close", arrow::float64(), false),
+        arrow::field("bar_volume", arrow::float64(), false),
+        arrow::field("analysis_bar_open", arrow::float64(), false),
+        arrow::field("analysis_bar_high", arrow::float64(), false),
+        arrow::field("analysis_bar_low", arrow::float64(), false),
+        arrow::field("analysis_bar_close", arrow::float64(), false),
+        arrow::field("analysis_price_offset", arrow::float64(), false),
+        arrow::field("kama", arrow::float64(), true),
+        arrow::field("atr", arrow::float64(), true),
+        arrow::field("adx", arrow::float64(), true),
+        arrow::field("er", arrow::float64(), true),
+        arrow::field("market_regime", arrow::utf8(), false),
+        arrow::field("market_state_adx", arrow::float64(), true),
+        arrow::field("market_state_kama_er", arrow::float64(), true),
+        arrow::field("market_state_atr_ratio", arrow::float64(), true),
+        arrow::field("market_state_bars_seen", arrow::uint64(), false),
+        arrow::field("market_state_decision_reason", arrow::utf8(), false),
+    });
+}
 #endif
 
 }  // namespace
 
+struct SubStrategyIndicatorTraceParquetWriter::ColumnSink {
+#if QUANT_HFT_ENABLE_ARROW_PARQUET
+    trace_internal::TraceParquetFileSink file;
+    std::int64_t pending_rows{0};
+    arrow::StringBuilder instrument_id;
+    arrow::Int64Builder ts_ns;
+    arrow::StringBuilder dt_utc;
+    arrow::StringBuilder trading_day;
+    arrow::StringBuilder action_day;
+    arrow::Int32Builder timeframe_minutes;
+    arrow::StringBuilder strategy_id;
+    arrow::StringBuilder strategy_type;
+    arrow::DoubleBuilder bar_open;
+    arrow::DoubleBuilder bar_high;
+    arrow::DoubleBuilder bar_low;
+    arrow::DoubleBuilder bar_close;
+    arrow::DoubleBuilder bar_volume;
+    arrow::DoubleBuilder analysis_bar_open;
+    arrow::DoubleBuilder analysis_bar_high;
+    arrow::DoubleBuilder analysis_bar_low;
+    arrow::DoubleBuilder analysis_bar_close;
+    arrow::DoubleBuilder analysis_price_offset;
+    arrow::DoubleBuilder kama;
+    arrow::DoubleBuilder atr;
+    arrow::DoubleBuilder adx;
+    arrow::DoubleBuilder er;
+    arrow::StringBuilder market_regime;
+    arrow::DoubleBuilder market_state_adx;
+    arrow::DoubleBuilder market_state_kama_er;
+    arrow::DoubleBuilder market_state_atr_ratio;
+    arrow::UInt64Builder market_state_bars_seen;
+    arrow::StringBuilder market_state_decision_reason;
+#endif
+};
+
+SubStrategyIndicatorTraceParquetWriter::SubStrategyIndicatorTraceParquetWriter(
+    TraceParquetWriterOptions options)
+    : options_(options) {}
+
+SubStrategyIndicatorTraceParquetWriter::~SubStrategyIndicatorTraceParquetWriter() = default;
+
 bool SubStrategyIndicatorTraceParquetWriter::Open(const std::string& output_path,
                                                   std::string* error) {
     if (is_open_) {
@@ -110,9 +195,14 @@ bool SubStrategyIndicatorTraceParquetWriter::Open(const std::string& output_path
             error);
     }
 
+    auto sink = std::make_unique<ColumnSink>();
+    if (!sink->file.Open(output_path, MakeSubStrategyTraceSchema(), options_.background_encoding,
+                         "sub-strategy indicator trace", error)) {
+        return false;
+    }
+    sink_ = std::move(sink);
     output_path_ = output_path;
     rows_written_ = 0;
-    rows_.clear();
     is_open_ = true;
     return true;
 #endif
@@ -138,8 +228,69 @@ bool SubStrategyIndicatorTraceParquetWriter::Append(const SubStrategyIndicatorTr
     return SetError("sub-strategy indicator trace requires QUANT_HFT_ENABLE_ARROW_PARQUET=ON",
                     error);
 #else
-    rows_.push_back(row);
+    ColumnSink& columns = *sink_;
+    if (!ExpectArrowStatus(columns.instrument_id.Append(row.instrument_id),
+                           "failed appending instrument_id", error) ||
+        !ExpectArrowStatus(columns.ts_ns.Append(row.ts_ns), "failed appending ts_ns", error) ||
+        !ExpectArrowStatus(
+            columns.dt_utc.Append(row.dt_utc.empty() ? FormatDateTimeFromEpochNs(row.ts_ns)
+                                                     : row.dt_utc),
+            "failed appending dt_utc", error) ||
+        !ExpectArrowStatus(columns.trading_day.Append(row.trading_day),
+                           "failed appending trading_day", error) ||
+        !ExpectArrowStatus(columns.action_day.Append(row.action_day),
+                           "failed appending action_day", error) ||
+        !ExpectArrowStatus(
+            columns.timeframe_minutes.Append(row.timeframe_minutes > 0 ? row.timeframe_minutes : 1),
+            "failed appending timeframe_minutes", error) ||
+        !ExpectArrowStatus(columns.strategy_id.Append(row.strategy_id),
+                           "failed appending strategy_id", error) ||
+        !ExpectArrowStatus(columns.strategy_type.Append(row.strategy_type),
+                           "failed appending strategy_type", error) ||
+        !ExpectArrowStatus(columns.bar_open.Append(row.bar_open), "failed appending bar_open",
+                           error) ||
+        !ExpectArrowStatus(columns.bar_high.Append(row.bar_high), "failed appending bar_high",
+                           error) ||
+        !ExpectArrowStatus(columns.bar_low.Append(row.bar_low), "failed appending bar_low",
+                           error) ||
+        !ExpectArrowStatus(columns.bar_close.Append(row.bar_close), "failed appending bar_close",
+                           error) ||
+        !ExpectArrowStatus(columns.bar_volume.Append(row.bar_volume),
+                           "failed appending bar_volume", error) ||
+        !ExpectArrowStatus(columns.analysis_bar_open.Append(row.analysis_bar_open),
+                           "failed appending analysis_bar_open", error) ||
+        !ExpectArrowStatus(columns.analysis_bar_high.Append(row.analysis_bar_high),
+                           "failed appending analysis_bar_high", error) ||
+        !ExpectArrowStatus(columns.analysis_bar_low.Append(row.analysis_bar_low),
+                           "failed appending analysis_bar_low", error) ||
+        !ExpectArrowStatus(columns.analysis_bar_close.Append(row.analysis_bar_close),
+                           "failed appending analysis_bar_close", error) ||
+        !ExpectArrowStatus(columns.analysis_price_offset.Append(row.analysis_price_offset),
+                           "failed appending analysis_price_offset", error) ||
+        !ExpectArrowStatus(columns.market_regime.Append(MarketRegimeToLabel(row.market_regime)),
+                           "failed appending market_regime", error) ||
+        !AppendOptional(row.kama, &columns.kama, "kama", error) ||
+        !AppendOptional(row.atr, &columns.atr, "atr", error) ||
+        !AppendOptional(row.adx, &columns.adx, "adx", error) ||
+        !AppendOptional(row.er, &columns.er, "er", error) ||
+        !AppendOptional(row.market_state_adx, &columns.market_state_adx, "market_state_adx",
+                        error) ||
+        !AppendOptional(row.market_state_kama_er, &columns.market_state_kama_er,
+                        "market_state_kama_er", error) ||
+        !AppendOptional(row.market_state_atr_ratio, &columns.market_state_atr_ratio,
+                        "market_state_atr_ratio", error) ||
+        !ExpectArrowStatus(columns.market_state_bars_seen.Append(row.market_state_bars_seen),
+                           "failed appending market_state_bars_seen", error) ||
+        !ExpectArrowStatus(
+            columns.market_state_decision_reason.Append(row.market_state_decision_reason),
+            "failed appending market_state_decision_reason", error)) {
+        return false;
+    }
+    ++columns.pending_rows;
     ++rows_written_;
+    if (columns.pending_rows >= std::max<std::int64_t>(1, options_.row_group_rows)) {
+        return FlushRowGroup(error);
+    }
     return true;
 #endif
 }
@@ -153,286 +304,61 @@ bool SubStrategyIndicatorTraceParquetWriter::Close(std::string* error) {
     return SetError("sub-strategy indicator trace requires QUANT_HFT_ENABLE_ARROW_PARQUET=ON",
                     error);
 #else
-    arrow::StringBuilder instrument_id_builder;
-    arrow::Int64Builder ts_ns_builder;
-    arrow::StringBuilder dt_utc_builder;
-    arrow::StringBuilder trading_day_builder;
-    arrow::StringBuilder action_day_builder;
-    arrow::Int32Builder timeframe_minutes_builder;
-    arrow::StringBuilder strategy_id_builder;
-    arrow::StringBuilder strategy_type_builder;
-    arrow::DoubleBuilder bar_open_builder;
-    arrow::DoubleBuilder bar_high_builder;
-    arrow::DoubleBuilder bar_low_builder;
-    arrow::DoubleBuilder bar_close_builder;
-    arrow::DoubleBuilder bar_volume_builder;
-    arrow::DoubleBuilder analysis_bar_open_builder;
-    arrow::DoubleBuilder analysis_bar_high_builder;
-    arrow::DoubleBuilder analysis_bar_low_builder;
-    arrow::DoubleBuilder analysis_bar_close_builder;
-    arrow::DoubleBuilder analysis_price_offset_builder;
-    arrow::DoubleBuilder kama_builder;
-    arrow::DoubleBuilder atr_builder;
-    arrow::DoubleBuilder adx_builder;
-    arrow::DoubleBuilder er_builder;
-    arrow::StringBuilder market_regime_builder;
-    arrow::DoubleBuilder market_state_adx_builder;
-    arrow::DoubleBuilder market_state_kama_er_builder;
-    arrow::DoubleBuilder market_state_atr_ratio_builder;
-    arrow::UInt64Builder market_state_bars_seen_builder;
-    arrow::StringBuilder market_state_decision_reason_builder;
-
-    const auto append_optional = [&](const std::optional<double>& value, arrow::DoubleBuilder* b,
-                                     const std::string& field_name) -> bool {
-        if (!value.has_value()) {
-            return ExpectArrowStatus(b->AppendNull(), "failed appending null for " + field_name,
-                                     error);
-        }
-        return ExpectArrowStatus(b->Append(*value), "failed appending " + field_name, error);
-    };
+    const bool closed = FlushRowGroup(error) && sink_->file.Finish(error);
+    sink_.reset();
+    is_open_ = false;
+    return closed;
+#endif
+}
 
-    for (const auto& row : rows_) {
-        if (!ExpectArrowStatus(instrument_id_builder.Append(row.instrument_id),
-                               "failed appending instrument_id", error) ||
-            !ExpectArrowStatus(ts_ns_builder.Append(row.ts_ns), "failed appending ts_ns", error) ||
-            !ExpectArrowStatus(
-                dt_utc_builder.Append(row.dt_utc.empty() ? FormatDateTimeFromEpochNs(row.ts_ns)
-                                                         : row.dt_utc),
-                "failed appending dt_utc", error) ||
-            !ExpectArrowStatus(trading_day_builder.Append(row.trading_day),
-                               "failed appending trading_day", error) ||
-            !ExpectArrowStatus(action_day_builder.Append(row.action_day),
-                               "failed appending action_day", error) ||
-            !ExpectArrowStatus(timeframe_minutes_builder.Append(
-                                   row.timeframe_minutes > 0 ? row.timeframe_minutes : 1),
-                               "failed appending timeframe_minutes", error) ||
-            !ExpectArrowStatus(strategy_id_builder.Append(row.strategy_id),
-                               "failed appending strategy_id", error) ||
-            !ExpectArrowStatus(strategy_type_builder.Append(row.strategy_type),
-                               "failed appending strategy_type", error) ||
-            !ExpectArrowStatus(bar_open_builder.Append(row.bar_open), "failed appending bar_open",
-                               error) ||
-            !ExpectArrowStatus(bar_high_builder.Append(row.bar_high), "failed appending bar_high",
-                               error) ||
-            !ExpectArrowStatus(bar_low_builder.Append(row.bar_low), "failed appending bar_low",
-                               error) ||
-            !ExpectArrowStatus(bar_close_builder.Append(row.bar_close),
-                               "failed appending bar_close", error) ||
-            !ExpectArrowStatus(bar_volume_builder.Append(row.bar_volume),
-                               "failed appending bar_volume", error) ||
-            !ExpectArrowStatus(analysis_bar_open_builder.Append(row.analysis_bar_open),
-                               "failed appending analysis_bar_open", error) ||
-            !ExpectArrowStatus(analysis_bar_high_builder.Append(row.analysis_bar_high),
-                               "failed appending analysis_bar_high", error) ||
-            !ExpectArrowStatus(analysis_bar_low_builder.Append(row.analysis_bar_low),
-                               "failed appending analysis_bar_low", error) ||
-            !ExpectArrowStatus(analysis_bar_close_builder.Append(row.analysis_bar_close),
-                               "failed appending analysis_bar_close", error) ||
-            !ExpectArrowStatus(analysis_price_offset_builder.Append(row.analysis_price_offset),
-                               "failed appending analysis_price_offset", error) ||
-            !ExpectArrowStatus(market_regime_builder.Append(MarketRegimeToLabel(row.market_regime)),
-                               "failed appending market_regime", error) ||
-            !append_optional(row.kama, &kama_builder, "kama") ||
-            !append_optional(row.atr, &atr_builder, "atr") ||
-            !append_optional(row.adx, &adx_builder, "adx") ||
-            !append_optional(row.er, &er_builder, "er") ||
-            !append_optional(row.market_state_adx, &market_state_adx_builder, "market_state_adx") ||
-            !append_optional(row.market_state_kama_er, &market_state_kama_er_builder,
-                             "market_state_kama_er") ||
-            !append_optional(row.market_state_atr_ratio, &market_state_atr_ratio_builder,
-                             "market_state_atr_ratio") ||
-            !ExpectArrowStatus(market_state_bars_seen_builder.Append(row.market_state_bars_seen),
-                               "failed appending market_state_bars_seen", error) ||
-            !ExpectArrowStatus(
-                market_state_decision_reason_builder.Append(row.market_state_decision_reason),
-                "failed appending market_state_decision_reason", error)) {
-            return false;
-        }
+bool SubStrategyIndicatorTraceParquetWriter::FlushRowGroup(std::string* error) {
+#if !QUANT_HFT_ENABLE_ARROW_PARQUET
+    return SetError("sub-strategy indicator trace requires QUANT_HFT_ENABLE_ARROW_PARQUET=ON",
+                    error);
+#else
+    ColumnSink& columns = *sink_;
+    if (columns.pending_rows == 0) {
+        return true;
     }
 
-    std::shared_ptr<arrow::Array> instrument_id_array;
-    std::shared_ptr<arrow::Array> ts_ns_array;
-    std::shared_ptr<arrow::Array> dt_utc_array;
-    std::shared_ptr<arrow::Array> trading_day_array;
-    std::shared_ptr<arrow::Array> action_day_array;
-    std::shared_ptr<arrow::Array> timeframe_minutes_array;
-    std::shared_ptr<arrow::Array> strategy_id_array;
-    std::shared_ptr<arrow::Array> strategy_type_array;
-    std::shared_ptr<arrow::Array> bar_open_array;
-    std::shared_ptr<arrow::Array> bar_high_array;
-    std::shared_ptr<arrow::Array> bar_low_array;
-    std::shared_ptr<arrow::Array> bar_close_array;
-    std::shared_ptr<arrow::Array> bar_volume_array;
-    std::shared_ptr<arrow::Array> analysis_bar_open_array;
-    std::shared_ptr<arrow::Array> analysis_bar_high_array;
-    std::shared_ptr<arrow::Array> analysis_bar_low_array;
-    std::shared_ptr<arrow::Array> analysis_bar_close_array;
-    std::shared_ptr<arrow::Array> analysis_price_offset_array;
-    std::shared_ptr<arrow::Array> kama_array;
-    std::shared_ptr<arrow::Array> atr_array;
-    std::shared_ptr<arrow::Array> adx_array;
-    std::shared_ptr<arrow::Array> er_array;
-    std::shared_ptr<arrow::Array> market_regime_array;
-    std::shared_ptr<arrow::Array> market_state_adx_array;
-    std::shared_ptr<arrow::Array> market_state_kama_er_array;
-    std::shared_ptr<arrow::Array> market_state_atr_ratio_array;
-    std::shared_ptr<arrow::Array> market_state_bars_seen_array;
-    std::shared_ptr<arrow::Array> market_state_decision_reason_array;
-
-    if (!FinishArray(&instrument_id_builder, "instrument_id", &instrument_id_array, error) ||
-        !FinishArray(&ts_ns_builder, "ts_ns", &ts_ns_array, error) ||
-        !FinishArray(&dt_utc_builder, "dt_utc", &dt_utc_array, error) ||
-        !FinishArray(&trading_day_builder, "trading_day", &trading_day_array, error) ||
-        !FinishArray(&action_day_builder, "action_day", &action_day_array, error) ||
-        !FinishArray(&timeframe_minutes_builder, "timeframe_minutes", &timeframe_minutes_array,
-                     error) ||
-        !FinishArray(&strategy_id_builder, "strategy_id", &strategy_id_array, error) ||
-        !FinishArray(&strategy_type_builder, "strategy_type", &strategy_type_array, error) ||
-        !FinishArray(&bar_open_builder, "bar_open", &bar_open_array, error) ||
-        !FinishArray(&bar_high_builder, "bar_high", &bar_high_array, error) ||
-        !FinishArray(&bar_low_builder, "bar_low", &bar_low_array, error) ||
-        !FinishArray(&bar_close_builder, "bar_close", &bar_close_array, error) ||
-        !FinishArray(&bar_volume_builder, "bar_volume", &bar_volume_array, error) ||
-        !FinishArray(&analysis_bar_open_builder, "analysis_bar_open", &analysis_bar_open_array,
-                     error) ||
-        !FinishArray(&analysis_bar_high_builder, "analysis_bar_high", &analysis_bar_high_array,
-                     error) ||
-        !FinishArray(&analysis_bar_low_builder, "analysis_bar_low", &analysis_bar_low_array,
+    std::vector<std::shared_ptr<arrow::Array>> arrays(28);
+    if (!FinishArray(&columns.instrument_id, "instrument_id", &arrays[0], error) ||
+        !FinishArray(&columns.ts_ns, "ts_ns", &arrays[1], error) ||
+        !FinishArray(&columns.dt_utc, "dt_utc", &arrays[2], error) ||
+        !FinishArray(&columns.trading_day, "trading_day", &arrays[3], error) ||
+        !FinishArray(&columns.action_day, "action_day", &arrays[4], error) ||
+        !FinishArray(&columns.timeframe_minutes, "timeframe_minutes", &arrays[5], error) ||
+        !FinishArray(&columns.strategy_id, "strategy_id", &arrays[6], error) ||
+        !FinishArray(&columns.strategy_type, "strategy_type", &arrays[7], error) ||
+        !FinishArray(&columns.bar_open, "bar_open", &arrays[8], error) ||
+        !FinishArray(&columns.bar_high, "bar_high", &arrays[9], error) ||
+        !FinishArray(&columns.bar_low, "bar_low", &arrays[10], error) ||
+        !FinishArray(&columns.bar_close, "bar_close", &arrays[11], error) ||
+        !FinishArray(&columns.bar_volume, "bar_volume", &arrays[12], error) ||
+        !FinishArray(&columns.analysis_bar_open, "analysis_bar_open", &arrays[13], error) ||
+        !FinishArray(&columns.analysis_bar_high, "analysis_bar_high", &arrays[14], error) ||
+        !FinishArray(&columns.analysis_bar_low, "analysis_bar_low", &arrays[15], error) ||
+        !FinishArray(&columns.analysis_bar_close, "analysis_bar_close", &arrays[16], error) ||
+        !FinishArray(&columns.analysis_price_offset, "analysis_price_offset", &arrays[17],
                      error) ||
-        !FinishArray(&analysis_bar_close_builder, "analysis_bar_close", &analysis_bar_close_array,
+        !FinishArray(&columns.kama, "kama", &arrays[18], error) ||
+        !FinishArray(&columns.atr, "atr", &arrays[19], error) ||
+        !FinishArray(&columns.adx, "adx", &arrays[20], error) ||
+        !FinishArray(&columns.er, "er", &arrays[21], error) ||
+        !FinishArray(&columns.market_regime, "market_regime", &arrays[22], error) ||
+        !FinishArray(&columns.market_state_adx, "market_state_adx", &arrays[23], error) ||
+        !FinishArray(&columns.market_state_kama_er, "market_state_kama_er", &arrays[24], error) ||
+        !FinishArray(&columns.market_state_atr_ratio, "market_state_atr_ratio", &arrays[25],
                      error) ||
-        !FinishArray(&analysis_price_offset_builder, "analysis_price_offset",
-                     &analysis_price_offset_array, error) ||
-        !FinishArray(&kama_builder, "kama", &kama_array, error) ||
-        !FinishArray(&atr_builder, "atr", &atr_array, error) ||
-        !FinishArray(&adx_builder, "adx", &adx_array, error) ||
-        !FinishArray(&er_builder, "er", &er_array, error) ||
-        !FinishArray(&market_regime_builder, "market_regime", &market_regime_array, error) ||
-        !FinishArray(&market_state_adx_builder, "market_state_adx", &market_state_adx_array,
+        !FinishArray(&columns.market_state_bars_seen, "market_state_bars_seen", &arrays[26],
                      error) ||
-        !FinishArray(&market_state_kama_er_builder, "market_state_kama_er",
-                     &market_state_kama_er_array, error) ||
-        !FinishArray(&market_state_atr_ratio_builder, "market_state_atr_ratio",
-                     &market_state_atr_ratio_array, error) ||
-        !FinishArray(&market_state_bars_seen_builder, "market_state_bars_seen",
-                     &market_state_bars_seen_array, error) ||
-        !FinishArray(&market_state_decision_reason_builder, "market_state_decision_reason",
-                     &market_state_decision_reason_array, error)) {
+        !FinishArray(&columns.market_state_decision_reason, "market_state_decision_reason",
+                     &arrays[27], error)) {
         return false;
     }
-
-    auto schema = arrow::schema({
-        arrow::field("instrument_id", arrow::utf8(), false),
-        arrow::field("ts_ns", arrow::int64(), false),
-        arrow::field("dt_utc", arrow::utf8(), false),
-        arrow::field("trading_day", arrow::utf8(), false),
-        arrow::field("action_day", arrow::utf8(), false),
-        arrow::field("timeframe_minutes", arrow::int32(), false),
-        arrow::field("strategy_id", arrow::utf8(), false),
-        arrow::field("strategy_type", arrow::utf8(), false),
-        arrow::field("bar_open", arrow::float64(), false),
-        arrow::field("bar_high", arrow::float64(), false),
-        arrow::field("bar_low", arrow::float64(), false),
-        arrow::field("bar_close", arrow::float64(), false),
-        arrow::field("bar_volume", arrow::float64(), false),
-        arrow::field("analysis_bar_open", arrow::float64(), false),
-        arrow::field("analysis_bar_high", arrow::float64(), false),
-        arrow::field("analysis_bar_low", arrow::float64(), false),
-        arrow::field("analysis_bar_close", arrow::float64(), false),
-        arrow::field("analysis_price_offset", arrow::float64(), false),
-        arrow::field("kama", arrow::float64(), true),
-        arrow::field("atr", arrow::float64(), true),
-        arrow::field("adx", arrow::float64(), true),
-        arrow::field("er", arrow::float64(), true),
-        arrow::field("market_regime", arrow::utf8(), false),
-        arrow::field("market_state_adx", arrow::float64(), true),
-        arrow::field("market_state_kama_er", arrow::float64(), true),
-        arrow::field("market_state_atr_ratio", arrow::float64(), true),
-        arrow::field("market_state_bars_seen", arrow::uint64(), false),
-        arrow::field("market_state_decision_reason", arrow::utf8(), false),
-    });
-
-    auto table = arrow::Table::Make(schema, {instrument_id_array,
-                                             ts_ns_array,
-                                             dt_utc_array,
-                                             trading_day_array,
-                                             action_day_array,
-                                             timeframe_minutes_array,
-                                             strategy_id_array,
-                                             strategy_type_array,
-                                             bar_open_array,
-                                             bar_high_array,
-                                             bar_low_array,
-                                             bar_close_array,
-                                             bar_volume_array,
-                                             analysis_bar_open_array,
-                                             analysis_bar_high_array,
-                                             analysis_bar_low_array,
-                                             analysis_bar_close_array,
-                                             analysis_price_offset_array,
-                                             kama_array,
-                                             atr_array,
-                                             adx_array,
-                                             er_array,
-                                             market_regime_array,
-                                             market_state_adx_array,
-                                             market_state_kama_er_array,
-                                             market_state_atr_ratio_array,
-                                             market_state_bars_seen_array,
-                                             market_state_decision_reason_array});
-
-    const std::filesystem::path output_path(output_path_);
-    const std::filesystem::path tmp_path(output_path_ + ".tmp");
-
-    auto file_result = arrow::io::FileOutputStream::Open(tmp_path.string());
-    if (!file_result.ok()) {
-        return SetError("failed to open sub-strategy indicator trace parquet output: " +
-                            file_result.status().ToString(),
-                        error);
-    }
-    std::shared_ptr<arrow::io::FileOutputStream> output_stream = file_result.ValueOrDie();
-
-    parquet::WriterProperties::Builder writer_props_builder;
-    writer_props_builder.compression(parquet::Compression::SNAPPY);
-    std::shared_ptr<parquet::WriterProperties> writer_props = writer_props_builder.build();
-    parquet::ArrowWriterProperties::Builder arrow_props_builder;
-    std::shared_ptr<parquet::ArrowWriterProperties> arrow_props = arrow_props_builder.build();
-
-    const auto write_status = parquet::arrow::WriteTable(
-        *table, arrow::default_memory_pool(), output_stream,
-        std::max<std::int64_t>(1, rows_written_), writer_props, arrow_props);
-    if (!write_status.ok()) {
-        std::error_code ec;
-        std::filesystem::remove(tmp_path, ec);
-        return SetError(
-            "failed to write sub-strategy indicator trace parquet: " + write_status.ToString(),
-            error);
-    }
-
-    const auto close_status = output_stream->Close();
-    if (!close_status.ok()) {
-        std::error_code ec;
-        std::filesystem::remove(tmp_path, ec);
-        return SetError(
-            "failed to close sub-strategy indicator trace parquet file: " + close_status.ToString(),
-            error);
-    }
-
-    try {
-        std::error_code ec;
-        std::filesystem::remove(output_path, ec);
-        std::filesystem::rename(tmp_path, output_path);
-    } catch (const std::exception& ex) {
-        std::error_code ec;
-        std::filesystem::remove(tmp_path, ec);
-        return SetError(
-            std::string("failed to finalize sub-strategy indicator trace parquet: ") + ex.what(),
-            error);
-    }
-
-    rows_.clear();
-    is_open_ = false;
-    return true;
+    const std::int64_t rows = columns.pending_rows;
+    columns.pending_rows = 0;
+    return columns.file.WriteRowGroup(std::move(arrays), rows, error);
 #endif
 }
 
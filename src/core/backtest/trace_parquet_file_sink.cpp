@@ -0,0 +1,206 @@
+#include "trace_parquet_file_sink.h"
+
+#if QUANT_HFT_ENABLE_ARROW_PARQUET
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+namespace quant_hft::trace_internal {
+namespace {
+
+bool SetError(const std::string& message, std::string* error) {
+    if (error != nullptr) {
+        *error = message;
+    }
+    return false;
+}
+
+}  // namespace
+
+TraceParquetFileSink::~TraceParquetFileSink() { Abort(); }
+
+bool TraceParquetFileSink::Open(const std::string& output_path,
+                                std::shared_ptr<arrow::Schema> schema, bool background_encoding,
+                                const std::string& label, std::string* error) {
+    if (is_open()) {
+        return SetError(label + " parquet sink is already open", error);
+    }
+    output_path_ = output_path;
+    tmp_path_ = output_path + ".tmp";
+    label_ = label;
+    schema_ = std::move(schema);
+
+    auto file_result = arrow::io::FileOutputStream::Open(tmp_path_);
+    if (!file_result.ok()) {
+        return SetError(
+            "failed to open " + label_ + " parquet output: " + file_result.status().ToString(),
+            error);
+    }
+    output_ = file_result.ValueOrDie();
+
+    parquet::WriterProperties::Builder writer_props_builder;
+    writer_props_builder.compression(parquet::Compression::SNAPPY);
+    const std::shared_ptr<parquet::WriterProperties> writer_props = writer_props_builder.build();
+    parquet::ArrowWriterProperties::Builder arrow_props_builder;
+    const std::shared_ptr<parquet::ArrowWriterProperties> arrow_props =
+        arrow_props_builder.build();
+
+    auto writer_result = parquet::arrow::FileWriter::Open(*schema_, arrow::default_memory_pool(),
+                                                          output_, writer_props, arrow_props);
+    if (!writer_result.ok()) {
+        const arrow::Status ignored_close_status = output_->Close();
+        (void)ignored_close_status;
+        output_.reset();
+        std::error_code ec;
+        std::filesystem::remove(tmp_path_, ec);
+        return SetError(
+            "failed to open " + label_ + " parquet writer: " + writer_result.status().ToString(),
+            error);
+    }
+    writer_ = std::move(writer_result).ValueOrDie();
+
+    stop_requested_ = false;
+    encoder_error_.clear();
+    queue_.clear();
+    if (background_encoding) {
+        encoder_ = std::thread([this]() { EncoderLoop(); });
+    }
+    return true;
+}
+
+bool TraceParquetFileSink::WriteRowGroup(std::vector<std::shared_ptr<arrow::Array>> columns,
+                                         std::int64_t rows, std::string* error) {
+    if (!is_open()) {
+        return SetError(label_ + " parquet sink is not open", error);
+    }
+    if (rows <= 0) {
+        return true;
+    }
+    auto table = arrow::Table::Make(schema_, std::move(columns), rows);
+    if (!encoder_.joinable()) {
+        return WriteTable(*table, error);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() {
+        return queue_.size() < kMaxQueuedRowGroups || !encoder_error_.empty();
+    });
+    if (!encoder_error_.empty()) {
+        return SetError(encoder_error_, error);
+    }
+    queue_.push_back(std::move(table));
+    cv_.notify_all();
+    return true;
+}
+
+bool TraceParquetFileSink::Finish(std::string* error) {
+    if (!is_open()) {
+        return true;
+    }
+    std::string finish_error;
+    if (!StopEncoder(&finish_error) || !CloseFile(&finish_error)) {
+        Abort();
+        return SetError(finish_error, error);
+    }
+
+    try {
+        std::error_code ec;
+        std::filesystem::remove(output_path_, ec);
+        std::filesystem::rename(tmp_path_, output_path_);
+    } catch (const std::exception& ex) {
+        std::error_code ec;
+        std::filesystem::remove(tmp_path_, ec);
+        return SetError(std::string("failed to finalize ") + label_ + " parquet: " + ex.what(),
+                        error);
+    }
+    return true;
+}
+
+void TraceParquetFileSink::Abort() {
+    if (!is_open() && !encoder_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.clear();
+    }
+    std::string ignored;
+    (void)StopEncoder(&ignored);
+    (void)CloseFile(&ignored);
+    std::error_code ec;
+    std::filesystem::remove(tmp_path_, ec);
+}
+
+bool TraceParquetFileSink::WriteTable(const arrow::Table& table, std::string* error) {
+    const arrow::Status status =
+        writer_->WriteTable(table, std::max<std::int64_t>(1, table.num_rows()));
+    if (!status.ok()) {
+        return SetError("failed to write " + label_ + " parquet: " + status.ToString(), error);
+    }
+    return true;
+}
+
+void TraceParquetFileSink::EncoderLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this]() { return stop_requested_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;
+        }
+        std::shared_ptr<arrow::Table> table = std::move(queue_.front());
+        queue_.pop_front();
+        const bool failed = !encoder_error_.empty();
+        lock.unlock();
+        std::string write_error;
+        const bool written = failed || WriteTable(*table, &write_error);
+        table.reset();
+        lock.lock();
+        if (!written && encoder_error_.empty()) {
+            encoder_error_ = write_error;
+        }
+        cv_.notify_all();
+    }
+}
+
+bool TraceParquetFileSink::StopEncoder(std::string* error) {
+    if (encoder_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_requested_ = true;
+        }
+        cv_.notify_all();
+        encoder_.join();
+    }
+    if (!encoder_error_.empty()) {
+        return SetError(encoder_error_, error);
+    }
+    return true;
+}
+
+bool TraceParquetFileSink::CloseFile(std::string* error) {
+    bool ok = true;
+    if (writer_ != nullptr) {
+        const arrow::Status writer_status = writer_->Close();
+        writer_.reset();
+        if (!writer_status.ok()) {
+            ok = SetError("failed to write " + label_ + " parquet: " + writer_status.ToString(),
+                          error);
+        }
+    }
+    if (output_ != nullptr) {
+        const arrow::Status close_status = output_->Close();
+        output_.reset();
+        if (ok && !close_status.ok()) {
+            ok = SetError(
+                "failed to close " + label_ + " parquet file: " + close_status.ToString(), error);
+        }
+    }
+    return ok;
+}
+
+}  // namespace quant_hft::trace_internal
+
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+
+#if QUANT_HFT_ENABLE_ARROW_PARQUET
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <parquet/arrow/writer.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace quant_hft::trace_internal {
+
+// Streams trace columns into one parquet file, one row group per WriteRowGroup call, so a
+// trace writer only holds the rows of the row group it is building. Output goes to
+// `<path>.tmp` and Finish renames it over `path`; Abort (and the destructor) remove it, so a
+// failed run never leaves a partial trace behind.
+//
+// With background encoding the parquet encode, compression and file write of each row group
+// run on a dedicated thread. At most kMaxQueuedRowGroups finished row groups wait for it;
+// WriteRowGroup blocks beyond that so memory stays bounded when the disk is slower than the
+// replay.
+class TraceParquetFileSink {
+   public:
+    TraceParquetFileSink() = default;
+    ~TraceParquetFileSink();
+
+    TraceParquetFileSink(const TraceParquetFileSink&) = delete;
+    TraceParquetFileSink& operator=(const TraceParquetFileSink&) = delete;
+
+    // `label` names the trace in error messages, e.g. "indicator trace".
+    bool Open(const std::string& output_path, std::shared_ptr<arrow::Schema> schema,
+              bool background_encoding, const std::string& label, std::string* error);
+    bool WriteRowGroup(std::vector<std::shared_ptr<arrow::Array>> columns, std::int64_t rows,
+                       std::string* error);
+    bool Finish(std::string* error);
+    void Abort();
+
+    bool is_open() const noexcept { return writer_ != nullptr; }
+
+   private:
+    static constexpr std::size_t kMaxQueuedRowGroups = 2;
+
+    bool WriteTable(const arrow::Table& table, std::string* error);
+    void EncoderLoop();
+    // Drains queued row groups, joins the encoder and reports its first error.
+    bool StopEncoder(std::string* error);
+    bool CloseFile(std::string* error);
+
+    std::string output_path_;
+    std::string tmp_path_;
+    std::string label_;
+    std::shared_ptr<arrow::Schema> schema_;
+    std::shared_ptr<arrow::io::FileOutputStream> output_;
+    std::unique_ptr<parquet::arrow::FileWriter> writer_;
+
+    std::thread encoder_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::shared_ptr<arrow::Table>> queue_;
+    bool stop_requested_{false};
+    std::string encoder_error_;
+};
+
+}  // namespace quant_hft::trace_internal
+
+#endif
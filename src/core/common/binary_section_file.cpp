@@ -0,0 +1,293 @@
+#include "quant_hft/core/binary_section_file.h"
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace quant_hft {
+namespace {
+
+void SetError(std::string* error, const std::string& value) {
+    if (error != nullptr) {
+        *error = value;
+    }
+}
+
+std::string ErrnoMessage(const std::string& action, int saved_errno) {
+    return action + ": " + std::strerror(saved_errno);
+}
+
+constexpr std::array<std::uint32_t, 256> MakeCrc32Table() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t index = 0; index < 256; ++index) {
+        std::uint32_t value = index;
+        for (int bit = 0; bit < 8; ++bit) {
+            value = (value & 1U) != 0 ? 0xEDB88320U ^ (value >> 1) : value >> 1;
+        }
+        table[index] = value;
+    }
+    return table;
+}
+
+constexpr std::array<std::uint32_t, 256> kCrc32Table = MakeCrc32Table();
+
+#if !defined(_WIN32)
+bool FsyncPath(const std::filesystem::path& path, bool directory, std::string* error) {
+    const int fd = ::open(path.c_str(), directory ? (O_RDONLY | O_DIRECTORY) : O_RDONLY);
+    if (fd < 0) {
+        SetError(error, ErrnoMessage("open for fsync failed: " + path.string(), errno));
+        return false;
+    }
+    const int rc = ::fsync(fd);
+    const int saved_errno = errno;
+    ::close(fd);
+    if (rc != 0) {
+        SetError(error, ErrnoMessage("fsync failed: " + path.string(), saved_errno));
+        return false;
+    }
+    return true;
+}
+#endif
+
+}  // namespace
+
+std::uint32_t BinarySectionCrc32(const char* data, std::size_t size) {
+    std::uint32_t crc = 0xFFFFFFFFU;
+    for (std::size_t index = 0; index < size; ++index) {
+        crc = kCrc32Table[(crc ^ static_cast<unsigned char>(data[index])) & 0xFFU] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+BinarySectionWriter::BinarySectionWriter(std::string* out) : out_(out) {
+    out_->assign(kBinarySectionHeaderBytes, '\0');
+}
+
+void BinarySectionWriter::BeginSection(std::uint32_t kind) {
+    Put(kind);
+    section_start_ = out_->size();
+    Put(std::uint32_t{0});
+    Put(std::uint64_t{0});
+}
+
+void BinarySectionWriter::EndSection() {
+    const std::size_t payload_start = section_start_ + 12;
+    const std::uint64_t payload_bytes = out_->size() - payload_start;
+    const std::uint32_t crc = BinarySectionCrc32(out_->data() + payload_start, payload_bytes);
+    std::memcpy(&(*out_)[section_start_], &crc, sizeof(crc));
+    std::memcpy(&(*out_)[section_start_ + 4], &payload_bytes, sizeof(payload_bytes));
+    ++section_count_;
+}
+
+void BinarySectionWriter::Finish(const BinarySectionFileFormat& format) {
+    std::memcpy(&(*out_)[0], format.magic, sizeof(format.magic));
+    const std::uint32_t header_fields[3] = {format.version, kBinarySectionByteOrderMark,
+                                            section_count_};
+    std::memcpy(&(*out_)[8], header_fields, sizeof(header_fields));
+    const std::uint32_t header_crc = BinarySectionCrc32(out_->data(), 20);
+    std::memcpy(&(*out_)[20], &header_crc, sizeof(header_crc));
+}
+
+bool BinarySectionReader::GetBool(bool* value) {
+    std::uint8_t raw = 0;
+    if (!Get(&raw) || raw > 1) {
+        return false;
+    }
+    *value = raw == 1;
+    return true;
+}
+
+bool BinarySectionReader::GetString(std::string* value) {
+    std::uint32_t length = 0;
+    if (!Get(&length) || size_ - offset_ < length) {
+        return false;
+    }
+    value->assign(data_ + offset_, length);
+    offset_ += length;
+    return true;
+}
+
+bool SplitBinarySections(const char* data, std::size_t size, const BinarySectionFileFormat& format,
+                         std::vector<BinarySection>* sections, std::string* error) {
+    const std::string label = format.label;
+    if (size < kBinarySectionHeaderBytes ||
+        std::memcmp(data, format.magic, sizeof(format.magic)) != 0) {
+        SetError(error, "not a " + label);
+        return false;
+    }
+    std::uint32_t header_fields[4] = {0, 0, 0, 0};
+    std::memcpy(header_fields, data + 8, sizeof(header_fields));
+    if (header_fields[3] != BinarySectionCrc32(data, 20)) {
+        SetError(error, label + " header crc mismatch");
+        return false;
+    }
+    if (header_fields[0] != format.version || header_fields[1] != kBinarySectionByteOrderMark) {
+        SetError(error, "unsupported " + label + " version");
+        return false;
+    }
+
+    sections->clear();
+    std::size_t offset = kBinarySectionHeaderBytes;
+    for (std::uint32_t index = 0; index < header_fields[2]; ++index) {
+        BinarySection section;
+        std::uint32_t crc = 0;
+        std::uint64_t payload_bytes = 0;
+        if (size - offset < kBinarySectionFrameBytes) {
+            SetError(error, "truncated " + label + " section header");
+            return false;
+        }
+        std::memcpy(&section.kind, data + offset, sizeof(section.kind));
+        std::memcpy(&crc, data + offset + 4, sizeof(crc));
+        std::memcpy(&payload_bytes, data + offset + 8, sizeof(payload_bytes));
+        offset += kBinarySectionFrameBytes;
+        if (size - offset < payload_bytes) {
+            SetError(error, "truncated " + label + " section");
+            return false;
+        }
+        section.payload = data + offset;
+        section.payload_bytes = static_cast<std::size_t>(payload_bytes);
+        offset += section.payload_bytes;
+        if (BinarySectionCrc32(section.payload, section.payload_bytes) != crc) {
+            SetError(error, label + " section crc mismatch");
+            return false;
+        }
+        sections->push_back(section);
+    }
+    if (offset != size) {
+        SetError(error, label + " has trailing bytes");
+        return false;
+    }
+    return true;
+}
+
+MappedReadOnlyFile::~MappedReadOnlyFile() {
+#if !defined(_WIN32)
+    if (mapped_ != nullptr) {
+        ::munmap(mapped_, size_);
+    }
+#endif
+}
+
+bool MappedReadOnlyFile::Open(const std::string& path, const std::string& label,
+                              std::string* error) {
+#if !defined(_WIN32)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SetError(error, "failed to open " + label + ": " + path);
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        const int saved_errno = errno;
+        ::close(fd);
+        SetError(error, ErrnoMessage("failed to stat " + label + ": " + path, saved_errno));
+        return false;
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) {
+        void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            const int saved_errno = errno;
+            ::close(fd);
+            SetError(error, ErrnoMessage("failed to map " + label + ": " + path, saved_errno));
+            return false;
+        }
+        mapped_ = mapped;
+    }
+    ::close(fd);
+    return true;
+#else
+    std::ifstream stream(path, std::ios::in | std::ios::binary);
+    if (!stream.is_open()) {
+        SetError(error, "failed to open " + label + ": " + path);
+        return false;
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    size_ = buffer_.size();
+    return true;
+#endif
+}
+
+const char* MappedReadOnlyFile::data() const {
+#if !defined(_WIN32)
+    return static_cast<const char*>(mapped_);
+#else
+    return buffer_.data();
+#endif
+}
+
+bool WriteFileAtomically(const std::string& path, const std::string& payload,
+                         const std::string& label, std::string* error) {
+    if (path.empty()) {
+        SetError(error, label + " path is empty");
+        return false;
+    }
+    const std::filesystem::path output(path);
+    std::error_code ec;
+    if (!output.parent_path().empty()) {
+        std::filesystem::create_directories(output.parent_path(), ec);
+        if (ec) {
+            SetError(error, "failed to create " + label + " directory: " + ec.message());
+            return false;
+        }
+    }
+    // Unique per writer: concurrent writers (threads or processes) may publish the same path.
+    const auto now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
+    std::string suffix = std::to_string(now_ns) + "." +
+                         std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#if !defined(_WIN32)
+    suffix += "." + std::to_string(static_cast<long long>(::getpid()));
+#endif
+    const std::filesystem::path temporary = output.string() + ".tmp." + suffix;
+    {
+        std::ofstream stream(temporary, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!stream.is_open()) {
+            SetError(error, "failed to open " + label + " temp file");
+            return false;
+        }
+        stream.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        stream.flush();
+        if (!stream.good()) {
+            stream.close();
+            std::filesystem::remove(temporary, ec);
+            SetError(error, "failed to flush " + label + " temp file");
+            return false;
+        }
+    }
+#if !defined(_WIN32)
+    if (!FsyncPath(temporary, false, error)) {
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+#endif
+    std::filesystem::rename(temporary, output, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        SetError(error, "failed to atomically publish " + label + ": " + ec.message());
+        return false;
+    }
+#if !defined(_WIN32)
+    const std::filesystem::path parent =
+        output.parent_path().empty() ? std::filesystem::path(".") : output.parent_path();
+    if (!FsyncPath(parent, true, error)) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+}  // namespace quant_hft
@@ -0,0 +1,127 @@
+#include "quant_hft/core/instrument_registry.h"
+
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include <utility>
+
+#include "quant_hft/core/instrument_meta_cache.h"
+
+namespace quant_hft {
+namespace {
+
+std::string Lowercase(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+    return value;
+}
+
+}  // namespace
+
+InstrumentRegistry::InstrumentRegistry() = default;
+
+InstrumentRegistry::~InstrumentRegistry() {
+    for (auto& chunk : chunks_) {
+        delete chunk.load(std::memory_order_relaxed);
+    }
+}
+
+InstrumentRegistry& InstrumentRegistry::Global() {
+    static InstrumentRegistry registry;
+    return registry;
+}
+
+InstrumentId InstrumentRegistry::Intern(const std::string& instrument_id) {
+    const InstrumentId found = Find(instrument_id);
+    if (found != kInvalidInstrumentId || instrument_id.empty()) {
+        return found;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return InternLocked(instrument_id);
+}
+
+InstrumentId InstrumentRegistry::Find(const std::string& instrument_id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const auto it = ids_.find(instrument_id);
+    return it == ids_.end() ? kInvalidInstrumentId : it->second;
+}
+
+InstrumentId InstrumentRegistry::Register(const InstrumentMetaSnapshot& meta) {
+    if (meta.instrument_id.empty()) {
+        return kInvalidInstrumentId;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    const InstrumentId id = InternLocked(meta.instrument_id);
+    if (id == kInvalidInstrumentId) {
+        return id;
+    }
+    auto& slot = SlotFor(id);
+    InstrumentInfo info = *slot.load(std::memory_order_acquire);
+    if (!meta.product_id.empty()) {
+        info.product_id = Lowercase(meta.product_id);
+    }
+    if (!meta.exchange_id.empty()) {
+        info.exchange_id = meta.exchange_id;
+    }
+    if (meta.volume_multiple > 0) {
+        info.volume_multiple = meta.volume_multiple;
+    }
+    if (meta.price_tick > 0.0) {
+        info.price_tick = meta.price_tick;
+    }
+    slot.store(KeepLocked(std::move(info)), std::memory_order_release);
+    return id;
+}
+
+std::size_t InstrumentRegistry::RegisterAll(
+    const std::vector<InstrumentMetaSnapshot>& instruments) {
+    std::size_t registered = 0;
+    for (const auto& instrument : instruments) {
+        registered += Register(instrument) != kInvalidInstrumentId ? 1U : 0U;
+    }
+    return registered;
+}
+
+const InstrumentInfo& InstrumentRegistry::Info(InstrumentId id) const {
+    return *SlotFor(id).load(std::memory_order_acquire);
+}
+
+std::atomic<const InstrumentInfo*>& InstrumentRegistry::SlotFor(InstrumentId id) const {
+    Chunk* chunk = chunks_[id / kChunkSize].load(std::memory_order_acquire);
+    return (*chunk)[id % kChunkSize];
+}
+
+InstrumentId InstrumentRegistry::InternLocked(const std::string& instrument_id) {
+    const auto it = ids_.find(instrument_id);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    const std::size_t next = size_.load(std::memory_order_relaxed);
+    if (next >= kChunkSize * kMaxChunks) {
+        return kInvalidInstrumentId;
+    }
+    auto& chunk_slot = chunks_[next / kChunkSize];
+    if (chunk_slot.load(std::memory_order_relaxed) == nullptr) {
+        chunk_slot.store(new Chunk(), std::memory_order_release);
+    }
+
+    InstrumentInfo info;
+    info.instrument_id = instrument_id;
+    info.product_id = ExtractFuturesProductId(instrument_id);
+    const auto dot = instrument_id.find('.');
+    if (dot != std::string::npos && dot > 0) {
+        info.exchange_id = instrument_id.substr(0, dot);
+    }
+    const auto id = static_cast<InstrumentId>(next);
+    SlotFor(id).store(KeepLocked(std::move(info)), std::memory_order_release);
+    ids_.emplace(instrument_id, id);
+    size_.store(next + 1, std::memory_order_release);
+    return id;
+}
+
+const InstrumentInfo* InstrumentRegistry::KeepLocked(InstrumentInfo info) {
+    records_.push_back(std::make_unique<const InstrumentInfo>(std::move(info)));
+    return records_.back().get();
+}
+
+}  // namespace quant_hft
@@ -1279,6 +1279,20 @@ bool CtpConfigLoader::LoadFromYaml(const std::string& path, CtpFileConfig* confi
         }
         return false;
     }
+    loaded.strategy_worker_count = 1;
+    SetOptionalInt(kv, "strategy_worker_count", &loaded.strategy_worker_count, &load_error);
+    if (!load_error.empty()) {
+        if (error != nullptr) {
+            *error = load_error;
+        }
+        return false;
+    }
+    if (loaded.strategy_worker_count <= 0) {
+        if (error != nullptr) {
+            *error = "strategy_worker_count must be > 0";
+        }
+        return false;
+    }
     loaded.strategy_state_persist_enabled = false;
     if (const auto it = kv.find("strategy_state_persist_enabled"); it != kv.end()) {
         if (!ParseBoolValue(it->second, &loaded.strategy_state_persist_enabled)) {
@@ -1421,6 +1435,21 @@ bool CtpConfigLoader::LoadFromYaml(const std::string& path, CtpFileConfig* confi
         }
         return false;
     }
+    loaded.execution.scheduler_lanes = 1;
+    SetOptionalInt(kv, "execution_scheduler_lanes", &loaded.execution.scheduler_lanes,
+                   &load_error);
+    if (!load_error.empty()) {
+        if (error != nullptr) {
+            *error = load_error;
+        }
+        return false;
+    }
+    if (loaded.execution.scheduler_lanes <= 0) {
+        if (error != nullptr) {
+            *error = "execution_scheduler_lanes must be > 0";
+        }
+        return false;
+    }
     loaded.execution.twap_duration_ms = 0;
     SetOptionalInt(kv, "twap_duration_ms", &loaded.execution.twap_duration_ms, &load_error);
     if (!load_error.empty()) {
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "quant_hft/core/ctp_text.h"
+#include "quant_hft/core/instrument_registry.h"
 #include "quant_hft/core/structured_log.h"
 #include "quant_hft/monitoring/metric_registry.h"
 
@@ -40,6 +41,12 @@ namespace quant_hft {
 namespace {
 
 constexpr int kDefaultConnectTimeoutMs = 10000;
+// Periodic queries still queued this long are superseded by the next poll, so they are dropped
+// instead of being sent stale.
+constexpr auto kQueuedQueryTtl = std::chrono::seconds(10);
+// A query whose response never arrives (e.g. the front dropped mid-query) stops blocking the
+// queue after this long.
+constexpr auto kQueryResponseTimeout = std::chrono::seconds(30);
 
 #if QUANT_HFT_HAS_REAL_CTP
 std::shared_ptr<MonitoringCounter> CtpReconnectCounter() {
@@ -404,7 +411,24 @@ std::string InferExchangeIdFromInstrument(const std::string& instrument_id) {
     return instrument_id.substr(0, dot_pos);
 }
 
-struct ScheduledQueryTaskState {
+void StampOrderEventTimestamps(OrderEvent* event) {
+    if (event == nullptr) {
+        return;
+    }
+    if (event->recv_ts_ns <= 0) {
+        event->recv_ts_ns = NowEpochNanos();
+    }
+    if (event->exchange_ts_ns <= 0) {
+        event->exchange_ts_ns = event->recv_ts_ns;
+    }
+    if (event->ts_ns <= 0) {
+        event->ts_ns = event->recv_ts_ns;
+    }
+}
+
+}  // namespace
+
+struct CtpGatewayAdapter::ScheduledQueryTaskState {
     bool query_ok{true};
 
     CtpGatewayAdapter::TradingAccountSnapshotCallback trading_account_callback;
@@ -431,26 +455,15 @@ struct ScheduledQueryTaskState {
     CtpGatewayAdapter::BrokerTradingParamsSnapshotCallback broker_trading_params_callback;
     BrokerTradingParamsSnapshot broker_trading_params_snapshot;
 
-    CtpGatewayAdapter::QueryCompleteCallback completion_callback;
-    bool completion_notified{false};
-};
-
-void StampOrderEventTimestamps(OrderEvent* event) {
-    if (event == nullptr) {
-        return;
-    }
-    if (event->recv_ts_ns <= 0) {
-        event->recv_ts_ns = NowEpochNanos();
-    }
-    if (event->exchange_ts_ns <= 0) {
-        event->exchange_ts_ns = event->recv_ts_ns;
-    }
-    if (event->ts_ns <= 0) {
-        event->ts_ns = event->recv_ts_ns;
-    }
-}
+    // "order" or "trade" for queries whose callers wait on their request id.
+    std::string completion_kind;
 
-}  // namespace
+    // Written under `mutex` by whichever thread runs the task; the caller waits on `cv`.
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool started{false};
+    bool finished{false};
+};
 
 #if QUANT_HFT_HAS_REAL_CTP
 class CtpMdSpi;
@@ -616,6 +629,7 @@ class CtpMdSpi final : public CThostFtdcMdSpi {
 
         MarketSnapshot snapshot;
         snapshot.instrument_id = SafeCtpString(p_depth_market_data->InstrumentID);
+        snapshot.instrument_handle = InstrumentRegistry::Global().Intern(snapshot.instrument_id);
         snapshot.exchange_id = SafeCtpString(p_depth_market_data->ExchangeID);
         snapshot.trading_day = SafeCtpString(p_depth_market_data->TradingDay);
         snapshot.action_day = SafeCtpString(p_depth_market_data->ActionDay);
@@ -822,7 +836,7 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
     }
 
     void OnRspQryUserSession(CThostFtdcUserSessionField* p_user_session,
-                             CThostFtdcRspInfoField* p_rsp_info, int, bool b_is_last) {
+                             CThostFtdcRspInfoField* p_rsp_info, int n_request_id, bool b_is_last) {
         CtpCallbackScope scope(state_);
         if (!scope.active()) {
             return;
@@ -830,7 +844,7 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
         if (!b_is_last) {
             return;
         }
-        owner_->CompleteScheduledQuery();
+        owner_->CompleteScheduledQuery(n_request_id);
         if (!IsRspSuccess(p_rsp_info) || p_user_session == nullptr) {
             return;
         }
@@ -875,13 +889,14 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
     }
 
     void OnRspQryTradingAccount(CThostFtdcTradingAccountField* p_trading_account,
-                                CThostFtdcRspInfoField* p_rsp_info, int, bool b_is_last) override {
+                                CThostFtdcRspInfoField* p_rsp_info, int n_request_id,
+                                bool b_is_last) override {
         CtpCallbackScope scope(state_);
         if (!scope.active()) {
             return;
         }
         if (b_is_last) {
-            owner_->CompleteScheduledQuery();
+            owner_->CompleteScheduledQuery(n_request_id);
         }
         if (!IsRspSuccess(p_rsp_info)) {
             return;
@@ -930,14 +945,14 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
     }
 
     void OnRspQryInvestorPosition(CThostFtdcInvestorPositionField* p_investor_position,
-                                  CThostFtdcRspInfoField* p_rsp_info, int,
+                                  CThostFtdcRspInfoField* p_rsp_info, int n_request_id,
                                   bool b_is_last) override {
         CtpCallbackScope scope(state_);
         if (!scope.active()) {
             return;
         }
         if (b_is_last) {
-            owner_->CompleteScheduledQuery();
+            owner_->CompleteScheduledQuery(n_request_id);
         }
         if (!IsRspSuccess(p_rsp_info)) {
             return;
@@ -985,13 +1000,14 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
     }
 
     void OnRspQryInstrument(CThostFtdcInstrumentField* p_instrument,
-                            CThostFtdcRspInfoField* p_rsp_info, int, bool b_is_last) override {
+                            CThostFtdcRspInfoField* p_rsp_info, int n_request_id,
+                            bool b_is_last) override {
         CtpCallbackScope scope(state_);
         if (!scope.active()) {
             return;
         }
         if (b_is_last) {
-            owner_->CompleteScheduledQuery();
+            owner_->CompleteScheduledQuery(n_request_id);
         }
         if (!IsRspSuccess(p_rsp_info)) {
             return;
@@ -1035,13 +1051,14 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
     }
 
     void OnRspQryDepthMarketData(CThostFtdcDepthMarketDataField* p_depth_market_data,
-                                 CThostFtdcRspInfoField* p_rsp_info, int, bool b_is_last) override {
+                                 CThostFtdcRspInfoField* p_rsp_info, int n_request_id,
+                                 bool b_is_last) override {
         CtpCallbackScope scope(state_);
         if (!scope.active()) {
             return;
         }
         if (b_is_last) {
-            owner_->CompleteScheduledQuery();
+            owner_->CompleteScheduledQuery(n_request_id);
         }
         if (!IsRspSuccess(p_rsp_info)) {
             return;
@@ -1054,6 +1071,8 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
             if (p_depth_market_data != nullptr) {
                 MarketSnapshot snapshot;
                 snapshot.instrument_id = SafeCtpString(p_depth_market_data->InstrumentID);
+                snapshot.instrument_handle =
+                    InstrumentRegistry::Global().Intern(snapshot.instrument_id);
                 snapshot.exchange_id = SafeCtpString(p_depth_market_data->ExchangeID);
                 snapshot.trading_day = SafeCtpString(p_depth_market_data->TradingDay);
                 snapshot.action_day = SafeCtpString(p_depth_market_data->ActionDay);
@@ -1093,14 +1112,14 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
     }
 
     void OnRspQryBrokerTradingParams(CThostFtdcBrokerTradingParamsField* p_broker_trading_params,
-                                     CThostFtdcRspInfoField* p_rsp_info, int,
+                                     CThostFtdcRspInfoField* p_rsp_info, int n_request_id,
                                      bool b_is_last) override {
         CtpCallbackScope scope(state_);
         if (!scope.active()) {
             return;
         }
         if (b_is_last) {
-            owner_->CompleteScheduledQuery();
+            owner_->CompleteScheduledQuery(n_request_id);
         }
         if (!b_is_last || !IsRspSuccess(p_rsp_info) || p_broker_trading_params == nullptr) {
             return;
@@ -1127,14 +1146,14 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
     }
 
     void OnRspQryInstrumentMarginRate(CThostFtdcInstrumentMarginRateField* p_margin_rate,
-                                      CThostFtdcRspInfoField* p_rsp_info, int,
+                                      CThostFtdcRspInfoField* p_rsp_info, int n_request_id,
                                       bool b_is_last) override {
         CtpCallbackScope scope(state_);
         if (!scope.active()) {
             return;
         }
         if (b_is_last) {
-            owner_->CompleteScheduledQuery();
+            owner_->CompleteScheduledQuery(n_request_id);
         }
         if (!IsRspSuccess(p_rsp_info)) {
             if (IsRecoverableQueryError(p_rsp_info)) {
@@ -1184,13 +1203,13 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
 
     void OnRspQryInstrumentCommissionRate(
         CThostFtdcInstrumentCommissionRateField* p_commission_rate,
-        CThostFtdcRspInfoField* p_rsp_info, int, bool b_is_last) override {
+        CThostFtdcRspInfoField* p_rsp_info, int n_request_id, bool b_is_last) override {
         CtpCallbackScope scope(state_);
         if (!scope.active()) {
             return;
         }
         if (b_is_last) {
-            owner_->CompleteScheduledQuery();
+            owner_->CompleteScheduledQuery(n_request_id);
         }
         if (!IsRspSuccess(p_rsp_info)) {
             if (IsRecoverableQueryError(p_rsp_info)) {
@@ -1237,14 +1256,14 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
     }
 
     void OnRspQryInstrumentOrderCommRate(CThostFtdcInstrumentOrderCommRateField* p_order_comm_rate,
-                                         CThostFtdcRspInfoField* p_rsp_info, int,
+                                         CThostFtdcRspInfoField* p_rsp_info, int n_request_id,
                                          bool b_is_last) override {
         CtpCallbackScope scope(state_);
         if (!scope.active()) {
             return;
         }
         if (b_is_last) {
-            owner_->CompleteScheduledQuery();
+            owner_->CompleteScheduledQuery(n_request_id);
         }
         if (!IsRspSuccess(p_rsp_info)) {
             if (IsRecoverableQueryError(p_rsp_info)) {
@@ -1295,21 +1314,19 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
             return;
         }
         if (b_is_last) {
-            owner_->CompleteScheduledQuery();
+            owner_->CompleteScheduledQuery(n_request_id);
         }
         const bool success = IsRspSuccess(p_rsp_info);
         auto notify_complete = [&]() {
             if (!b_is_last) {
                 return;
             }
-            CtpGatewayAdapter::QueryCompleteCallback query_callback;
+            std::vector<int> request_ids;
             {
                 std::lock_guard<std::mutex> lock(owner_->mutex_);
-                query_callback = owner_->query_complete_callback_;
-            }
-            if (query_callback) {
-                query_callback(n_request_id, "order", success);
+                request_ids = owner_->TakeQueryWaitersLocked(n_request_id);
             }
+            owner_->NotifyQueryComplete("order", request_ids, success);
         };
         if (!success || p_order == nullptr) {
             notify_complete();
@@ -1378,21 +1395,19 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
             return;
         }
         if (b_is_last) {
-            owner_->CompleteScheduledQuery();
+            owner_->CompleteScheduledQuery(n_request_id);
         }
         const bool success = IsRspSuccess(p_rsp_info);
         auto notify_complete = [&]() {
             if (!b_is_last) {
                 return;
             }
-            CtpGatewayAdapter::QueryCompleteCallback query_callback;
+            std::vector<int> request_ids;
             {
                 std::lock_guard<std::mutex> lock(owner_->mutex_);
-                query_callback = owner_->query_complete_callback_;
-            }
-            if (query_callback) {
-                query_callback(n_request_id, "trade", success);
+                request_ids = owner_->TakeQueryWaitersLocked(n_request_id);
             }
+            owner_->NotifyQueryComplete("trade", request_ids, success);
         };
         if (!success || p_trade == nullptr) {
             notify_complete();
@@ -1823,9 +1838,15 @@ class CtpTdSpi final : public CThostFtdcTraderSpi {
 #endif
 
 CtpGatewayAdapter::CtpGatewayAdapter(std::size_t query_qps_limit)
-    : query_scheduler_(query_qps_limit) {}
+    : query_scheduler_(query_qps_limit) {
+    query_scheduler_.SetInFlightTimeout(
+        std::chrono::duration_cast<std::chrono::milliseconds>(kQueryResponseTimeout));
+    query_scheduler_.StartDrainThread();
+}
 
 CtpGatewayAdapter::~CtpGatewayAdapter() {
+    // Queued tasks capture `this`; stop running them before members go away.
+    query_scheduler_.StopDrainThread();
     Disconnect();
     StopReconnectWorker();
 }
@@ -2232,6 +2253,7 @@ void CtpGatewayAdapter::RequestReconnect() {
 void CtpGatewayAdapter::HandleConnectionLoss() {
     ConnectionStateCallback callback;
     std::vector<ConnectionStateCallback> listeners;
+    std::unordered_map<int, QueryWaiters> waiters;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         if (!desired_connected_) {
@@ -2243,6 +2265,13 @@ void CtpGatewayAdapter::HandleConnectionLoss() {
             (void)token;
             listeners.push_back(listener);
         }
+        waiters.swap(query_waiters_);
+    }
+    // A query in flight on the dropped session will never be answered.
+    query_scheduler_.MarkComplete();
+    for (const auto& [request_id, waiter] : waiters) {
+        (void)request_id;
+        NotifyQueryComplete(waiter.query_name, waiter.request_ids, false);
     }
     if (callback) {
         callback(false);
@@ -3158,7 +3187,7 @@ bool CtpGatewayAdapter::EnqueueTradingAccountQuery(int request_id) {
     task.execute = [this, request_id, state]() {
         auto mark_failed = [&]() {
             state->query_ok = false;
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         };
         CtpRuntimeConfig runtime;
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3197,21 +3226,13 @@ bool CtpGatewayAdapter::EnqueueTradingAccountQuery(int request_id) {
         state->query_ok = ExecuteTdQueryWithRetry(
             [&]() { return td_api->ReqQryTradingAccount(&req, request_id); });
         if (!state->query_ok) {
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         }
 #endif
     };
 
-    if (!query_scheduler_.TrySchedule(std::move(task))) {
-        return false;
-    }
-    if (!FinishQuerySchedule(query_scheduler_.DrainOnce(), state->query_ok)) {
-        return false;
-    }
-    if (state->trading_account_callback) {
-        state->trading_account_callback(state->trading_account_snapshot);
-    }
-    return true;
+    const auto scheduled = ScheduleQuery(std::move(task), "trading_account", state);
+    return FinishQuerySchedule(scheduled, state.get());
 }
 
 bool CtpGatewayAdapter::EnqueueInvestorPositionQuery(int request_id) {
@@ -3229,7 +3250,7 @@ bool CtpGatewayAdapter::EnqueueInvestorPositionQuery(int request_id) {
     task.execute = [this, request_id, state]() {
         auto mark_failed = [&]() {
             state->query_ok = false;
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         };
         CtpRuntimeConfig runtime;
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3264,21 +3285,13 @@ bool CtpGatewayAdapter::EnqueueInvestorPositionQuery(int request_id) {
         state->query_ok = ExecuteTdQueryWithRetry(
             [&]() { return td_api->ReqQryInvestorPosition(&req, request_id); });
         if (!state->query_ok) {
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         }
 #endif
     };
 
-    if (!query_scheduler_.TrySchedule(std::move(task))) {
-        return false;
-    }
-    if (!FinishQuerySchedule(query_scheduler_.DrainOnce(), state->query_ok)) {
-        return false;
-    }
-    if (state->investor_position_callback) {
-        state->investor_position_callback(state->investor_position_snapshots);
-    }
-    return true;
+    const auto scheduled = ScheduleQuery(std::move(task), "investor_position", state);
+    return FinishQuerySchedule(scheduled, state.get());
 }
 
 bool CtpGatewayAdapter::EnqueueInstrumentQuery(int request_id) {
@@ -3300,7 +3313,7 @@ bool CtpGatewayAdapter::EnqueueInstrumentQuery(int request_id, const std::string
     task.execute = [this, request_id, instrument_id, state]() {
         auto mark_failed = [&]() {
             state->query_ok = false;
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         };
         CtpRuntimeConfig runtime;
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3366,21 +3379,13 @@ bool CtpGatewayAdapter::EnqueueInstrumentQuery(int request_id, const std::string
         state->query_ok =
             ExecuteTdQueryWithRetry([&]() { return td_api->ReqQryInstrument(&req, request_id); });
         if (!state->query_ok) {
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         }
 #endif
     };
 
-    if (!query_scheduler_.TrySchedule(std::move(task))) {
-        return false;
-    }
-    if (!FinishQuerySchedule(query_scheduler_.DrainOnce(), state->query_ok)) {
-        return false;
-    }
-    if (state->instrument_meta_callback) {
-        state->instrument_meta_callback(state->instrument_meta_snapshots);
-    }
-    return true;
+    const auto scheduled = ScheduleQuery(std::move(task), "instrument:" + instrument_id, state);
+    return FinishQuerySchedule(scheduled, state.get());
 }
 
 bool CtpGatewayAdapter::EnqueueDepthMarketDataQuery(int request_id) {
@@ -3398,7 +3403,7 @@ bool CtpGatewayAdapter::EnqueueDepthMarketDataQuery(int request_id) {
     task.execute = [this, request_id, state]() {
         auto mark_failed = [&]() {
             state->query_ok = false;
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         };
 #if QUANT_HFT_HAS_REAL_CTP
         CThostFtdcTraderApi* td_api = nullptr;
@@ -3428,21 +3433,13 @@ bool CtpGatewayAdapter::EnqueueDepthMarketDataQuery(int request_id) {
         state->query_ok = ExecuteTdQueryWithRetry(
             [&]() { return td_api->ReqQryDepthMarketData(&req, request_id); });
         if (!state->query_ok) {
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         }
 #endif
     };
 
-    if (!query_scheduler_.TrySchedule(std::move(task))) {
-        return false;
-    }
-    if (!FinishQuerySchedule(query_scheduler_.DrainOnce(), state->query_ok)) {
-        return false;
-    }
-    if (state->depth_market_callback) {
-        state->depth_market_callback(state->depth_market_snapshots);
-    }
-    return true;
+    const auto scheduled = ScheduleQuery(std::move(task), "depth_market_data", state);
+    return FinishQuerySchedule(scheduled, state.get());
 }
 
 bool CtpGatewayAdapter::EnqueueInstrumentMarginRateQuery(int request_id,
@@ -3465,7 +3462,7 @@ bool CtpGatewayAdapter::EnqueueInstrumentMarginRateQuery(int request_id,
     task.execute = [this, request_id, instrument_id, state]() {
         auto mark_failed = [&]() {
             state->query_ok = false;
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         };
         CtpRuntimeConfig runtime;
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3520,21 +3517,13 @@ bool CtpGatewayAdapter::EnqueueInstrumentMarginRateQuery(int request_id,
         state->query_ok = ExecuteTdQueryWithRetry(
             [&]() { return td_api->ReqQryInstrumentMarginRate(&req, request_id); });
         if (!state->query_ok) {
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         }
 #endif
     };
 
-    if (!query_scheduler_.TrySchedule(std::move(task))) {
-        return false;
-    }
-    if (!FinishQuerySchedule(query_scheduler_.DrainOnce(), state->query_ok)) {
-        return false;
-    }
-    if (state->instrument_margin_rate_callback) {
-        state->instrument_margin_rate_callback(state->instrument_margin_rate_snapshots);
-    }
-    return true;
+    const auto scheduled = ScheduleQuery(std::move(task), "margin_rate:" + instrument_id, state);
+    return FinishQuerySchedule(scheduled, state.get());
 }
 
 bool CtpGatewayAdapter::EnqueueInstrumentCommissionRateQuery(int request_id,
@@ -3557,7 +3546,7 @@ bool CtpGatewayAdapter::EnqueueInstrumentCommissionRateQuery(int request_id,
     task.execute = [this, request_id, instrument_id, state]() {
         auto mark_failed = [&]() {
             state->query_ok = false;
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         };
         CtpRuntimeConfig runtime;
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3611,21 +3600,14 @@ bool CtpGatewayAdapter::EnqueueInstrumentCommissionRateQuery(int request_id,
         state->query_ok = ExecuteTdQueryWithRetry(
             [&]() { return td_api->ReqQryInstrumentCommissionRate(&req, request_id); });
         if (!state->query_ok) {
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         }
 #endif
     };
 
-    if (!query_scheduler_.TrySchedule(std::move(task))) {
-        return false;
-    }
-    if (!FinishQuerySchedule(query_scheduler_.DrainOnce(), state->query_ok)) {
-        return false;
-    }
-    if (state->instrument_commission_rate_callback) {
-        state->instrument_commission_rate_callback(state->instrument_commission_rate_snapshots);
-    }
-    return true;
+    const auto scheduled =
+        ScheduleQuery(std::move(task), "commission_rate:" + instrument_id, state);
+    return FinishQuerySchedule(scheduled, state.get());
 }
 
 bool CtpGatewayAdapter::EnqueueInstrumentOrderCommRateQuery(int request_id,
@@ -3648,7 +3630,7 @@ bool CtpGatewayAdapter::EnqueueInstrumentOrderCommRateQuery(int request_id,
     task.execute = [this, request_id, instrument_id, state]() {
         auto mark_failed = [&]() {
             state->query_ok = false;
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         };
         CtpRuntimeConfig runtime;
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3701,21 +3683,14 @@ bool CtpGatewayAdapter::EnqueueInstrumentOrderCommRateQuery(int request_id,
         state->query_ok = ExecuteTdQueryWithRetry(
             [&]() { return td_api->ReqQryInstrumentOrderCommRate(&req, request_id); });
         if (!state->query_ok) {
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         }
 #endif
     };
 
-    if (!query_scheduler_.TrySchedule(std::move(task))) {
-        return false;
-    }
-    if (!FinishQuerySchedule(query_scheduler_.DrainOnce(), state->query_ok)) {
-        return false;
-    }
-    if (state->instrument_order_comm_rate_callback) {
-        state->instrument_order_comm_rate_callback(state->instrument_order_comm_rate_snapshots);
-    }
-    return true;
+    const auto scheduled =
+        ScheduleQuery(std::move(task), "order_comm_rate:" + instrument_id, state);
+    return FinishQuerySchedule(scheduled, state.get());
 }
 
 bool CtpGatewayAdapter::EnqueueBrokerTradingParamsQuery(int request_id) {
@@ -3733,7 +3708,7 @@ bool CtpGatewayAdapter::EnqueueBrokerTradingParamsQuery(int request_id) {
     task.execute = [this, request_id, state]() {
         auto mark_failed = [&]() {
             state->query_ok = false;
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         };
         CtpRuntimeConfig runtime;
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3773,25 +3748,18 @@ bool CtpGatewayAdapter::EnqueueBrokerTradingParamsQuery(int request_id) {
         state->query_ok = ExecuteTdQueryWithRetry(
             [&]() { return td_api->ReqQryBrokerTradingParams(&req, request_id); });
         if (!state->query_ok) {
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         }
 #endif
     };
 
-    if (!query_scheduler_.TrySchedule(std::move(task))) {
-        return false;
-    }
-    if (!FinishQuerySchedule(query_scheduler_.DrainOnce(), state->query_ok)) {
-        return false;
-    }
-    if (state->broker_trading_params_callback) {
-        state->broker_trading_params_callback(state->broker_trading_params_snapshot);
-    }
-    return true;
+    const auto scheduled = ScheduleQuery(std::move(task), "broker_trading_params", state);
+    return FinishQuerySchedule(scheduled, state.get());
 }
 
 bool CtpGatewayAdapter::EnqueueOrderQuery(int request_id) {
     auto state = std::make_shared<ScheduledQueryTaskState>();
+    state->completion_kind = "order";
     {
         std::lock_guard<std::mutex> lock(mutex_);
         if (!connected_) {
@@ -3805,7 +3773,7 @@ bool CtpGatewayAdapter::EnqueueOrderQuery(int request_id) {
     task.execute = [this, request_id, state]() {
         auto mark_failed = [&]() {
             state->query_ok = false;
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         };
         CtpRuntimeConfig runtime;
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3815,8 +3783,6 @@ bool CtpGatewayAdapter::EnqueueOrderQuery(int request_id) {
             std::lock_guard<std::mutex> lock(mutex_);
             runtime = runtime_config_;
             if (!runtime_config_.enable_real_api) {
-                state->completion_callback = query_complete_callback_;
-                state->completion_notified = true;
                 return;
             }
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3837,23 +3803,18 @@ bool CtpGatewayAdapter::EnqueueOrderQuery(int request_id) {
         state->query_ok =
             ExecuteTdQueryWithRetry([&]() { return td_api->ReqQryOrder(&req, request_id); });
         if (!state->query_ok) {
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         }
 #endif
     };
 
-    if (!query_scheduler_.TrySchedule(std::move(task))) {
-        return false;
-    }
-    const bool ok = FinishQuerySchedule(query_scheduler_.DrainOnce(), state->query_ok);
-    if (state->completion_notified && state->completion_callback) {
-        state->completion_callback(request_id, "order", ok);
-    }
-    return ok;
+    const auto scheduled = ScheduleQuery(std::move(task), "orders", state);
+    return FinishQuerySchedule(scheduled, state.get());
 }
 
 bool CtpGatewayAdapter::EnqueueTradeQuery(int request_id) {
     auto state = std::make_shared<ScheduledQueryTaskState>();
+    state->completion_kind = "trade";
     {
         std::lock_guard<std::mutex> lock(mutex_);
         if (!connected_) {
@@ -3867,7 +3828,7 @@ bool CtpGatewayAdapter::EnqueueTradeQuery(int request_id) {
     task.execute = [this, request_id, state]() {
         auto mark_failed = [&]() {
             state->query_ok = false;
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         };
         CtpRuntimeConfig runtime;
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3877,8 +3838,6 @@ bool CtpGatewayAdapter::EnqueueTradeQuery(int request_id) {
             std::lock_guard<std::mutex> lock(mutex_);
             runtime = runtime_config_;
             if (!runtime_config_.enable_real_api) {
-                state->completion_callback = query_complete_callback_;
-                state->completion_notified = true;
                 return;
             }
 #if QUANT_HFT_HAS_REAL_CTP
@@ -3899,19 +3858,13 @@ bool CtpGatewayAdapter::EnqueueTradeQuery(int request_id) {
         state->query_ok =
             ExecuteTdQueryWithRetry([&]() { return td_api->ReqQryTrade(&req, request_id); });
         if (!state->query_ok) {
-            query_scheduler_.MarkComplete();
+            query_scheduler_.MarkComplete(request_id);
         }
 #endif
     };
 
-    if (!query_scheduler_.TrySchedule(std::move(task))) {
-        return false;
-    }
-    const bool ok = FinishQuerySchedule(query_scheduler_.DrainOnce(), state->query_ok);
-    if (state->completion_notified && state->completion_callback) {
-        state->completion_callback(request_id, "trade", ok);
-    }
-    return ok;
+    const auto scheduled = ScheduleQuery(std::move(task), "trades", state);
+    return FinishQuerySchedule(scheduled, state.get());
 }
 
 void CtpGatewayAdapter::RegisterTradingAccountSnapshotCallback(
@@ -4061,22 +4014,140 @@ bool CtpGatewayAdapter::ExecuteTdQueryWithRetry(const std::function<int()>& requ
     return false;
 }
 
-void CtpGatewayAdapter::CompleteScheduledQuery() {
-    query_scheduler_.MarkComplete();
+void CtpGatewayAdapter::CompleteScheduledQuery(int request_id) {
+    query_scheduler_.MarkComplete(request_id);
     while (query_scheduler_.DrainOnce() > 0U) {
     }
 }
 
-bool CtpGatewayAdapter::FinishQuerySchedule(std::size_t drained, bool query_ok) {
-    bool complete_immediately = false;
+QueryScheduler::ScheduleResult CtpGatewayAdapter::ScheduleQuery(
+    QueryScheduler::QueryTask task, std::string coalesce_key,
+    const std::shared_ptr<ScheduledQueryTaskState>& state) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task.completes_on_return = !runtime_config_.enable_real_api;
+    }
+    task.coalesce_key = std::move(coalesce_key);
+    task.deadline = std::chrono::steady_clock::now() + kQueuedQueryTtl;
+
+    const int request_id = task.request_id;
+    auto execute = std::move(task.execute);
+    task.execute = [this, request_id, state, execute = std::move(execute)]() {
+        auto merged_request_ids = query_scheduler_.TakeMergedRequestIds(request_id);
+        if (!state->completion_kind.empty()) {
+            // Registered before the request goes out, since its response may beat execute's
+            // return.
+            merged_request_ids.insert(merged_request_ids.begin(), request_id);
+            std::lock_guard<std::mutex> lock(mutex_);
+            query_waiters_[request_id] =
+                QueryWaiters{state->completion_kind, std::move(merged_request_ids)};
+        }
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->started = true;
+        }
+        execute();
+        DeliverScheduledQuery(request_id, *state);
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finished = true;
+        }
+        state->cv.notify_all();
+    };
+    task.on_expired = [this, state](const std::vector<int>& request_ids) {
+        NotifyQueryComplete(state->completion_kind, request_ids, false);
+    };
+    return query_scheduler_.Schedule(std::move(task));
+}
+
+bool CtpGatewayAdapter::FinishQuerySchedule(QueryScheduler::ScheduleResult scheduled,
+                                            ScheduledQueryTaskState* state) {
+    if (scheduled == QueryScheduler::ScheduleResult::kRejected) {
+        return false;
+    }
+    if (scheduled == QueryScheduler::ScheduleResult::kCoalesced) {
+        // The identical query already queued answers this request id as well.
+        return true;
+    }
+    (void)query_scheduler_.DrainOnce();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (!state->started) {
+        // Still behind the in-flight query or the rate limit; the drain thread issues it.
+        return true;
+    }
+    // This call or the drain thread is running the task; its outcome is known once it returns.
+    state->cv.wait(lock, [state]() { return state->finished; });
+    return state->query_ok;
+}
+
+void CtpGatewayAdapter::DeliverScheduledQuery(int request_id,
+                                              const ScheduledQueryTaskState& state) {
+    if (state.trading_account_callback) {
+        state.trading_account_callback(state.trading_account_snapshot);
+    }
+    if (state.investor_position_callback) {
+        state.investor_position_callback(state.investor_position_snapshots);
+    }
+    if (state.instrument_meta_callback) {
+        state.instrument_meta_callback(state.instrument_meta_snapshots);
+    }
+    if (state.depth_market_callback) {
+        state.depth_market_callback(state.depth_market_snapshots);
+    }
+    if (state.instrument_margin_rate_callback) {
+        state.instrument_margin_rate_callback(state.instrument_margin_rate_snapshots);
+    }
+    if (state.instrument_commission_rate_callback) {
+        state.instrument_commission_rate_callback(state.instrument_commission_rate_snapshots);
+    }
+    if (state.instrument_order_comm_rate_callback) {
+        state.instrument_order_comm_rate_callback(state.instrument_order_comm_rate_snapshots);
+    }
+    if (state.broker_trading_params_callback) {
+        state.broker_trading_params_callback(state.broker_trading_params_snapshot);
+    }
+    if (state.completion_kind.empty()) {
+        return;
+    }
+
+    std::vector<int> request_ids;
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        complete_immediately = !runtime_config_.enable_real_api;
+        if (runtime_config_.enable_real_api && state.query_ok) {
+            // Sent; the last response row answers every waiter.
+            return;
+        }
+        request_ids = TakeQueryWaitersLocked(request_id);
+    }
+    NotifyQueryComplete(state.completion_kind, request_ids, state.query_ok);
+}
+
+std::vector<int> CtpGatewayAdapter::TakeQueryWaitersLocked(int request_id) {
+    const auto it = query_waiters_.find(request_id);
+    if (it == query_waiters_.end()) {
+        return {request_id};
+    }
+    auto request_ids = std::move(it->second.request_ids);
+    query_waiters_.erase(it);
+    return request_ids;
+}
+
+void CtpGatewayAdapter::NotifyQueryComplete(const std::string& query_name,
+                                            const std::vector<int>& request_ids, bool success) {
+    if (query_name.empty()) {
+        return;
+    }
+    QueryCompleteCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callback = query_complete_callback_;
+    }
+    if (!callback) {
+        return;
     }
-    if (drained > 0U && (complete_immediately || !query_ok)) {
-        query_scheduler_.MarkComplete();
+    for (const int request_id : request_ids) {
+        callback(request_id, query_name, success);
     }
-    return complete_immediately ? (drained > 0U && query_ok) : query_ok;
 }
 
 int CtpGatewayAdapter::NextRequestIdLocked() { return ++request_id_seq_; }
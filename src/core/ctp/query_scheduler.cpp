@@ -1,6 +1,7 @@
 #include "quant_hft/core/query_scheduler.h"
 
 #include <algorithm>
+#include <cmath>
 #include <utility>
 
 namespace quant_hft {
@@ -10,58 +11,123 @@ QueryScheduler::QueryScheduler(std::size_t max_qps)
       tokens_(static_cast<double>(max_qps)),
       last_refill_(std::chrono::steady_clock::now()) {}
 
-bool QueryScheduler::TrySchedule(QueryTask task) {
+QueryScheduler::~QueryScheduler() { StopDrainThread(); }
+
+QueryScheduler::ScheduleResult QueryScheduler::Schedule(QueryTask task) {
     if (!task.execute) {
-        return false;
+        return ScheduleResult::kRejected;
     }
     const auto idx = static_cast<std::size_t>(task.priority);
     if (idx >= queues_.size()) {
-        return false;
+        return ScheduleResult::kRejected;
     }
 
     std::lock_guard<std::mutex> lock(mutex_);
-    task.created_at = std::chrono::steady_clock::now();
-    queues_[idx].push(std::move(task));
-    return true;
+    task.created_at = Clock::now();
+    if (!task.coalesce_key.empty()) {
+        const auto pending_it = pending_by_key_.find(task.coalesce_key);
+        if (pending_it != pending_by_key_.end()) {
+            // The queued task answers this request too; it now waits for the later deadline.
+            QueryTask& pending = *pending_it->second;
+            if (!pending.deadline.has_value() || !task.deadline.has_value()) {
+                pending.deadline.reset();
+            } else {
+                pending.deadline = std::max(*pending.deadline, *task.deadline);
+            }
+            pending.merged_request_ids.push_back(task.request_id);
+            pending.merged_request_ids.insert(pending.merged_request_ids.end(),
+                                              task.merged_request_ids.begin(),
+                                              task.merged_request_ids.end());
+            ++coalesced_count_;
+            return ScheduleResult::kCoalesced;
+        }
+    }
+    queues_[idx].push_back(std::move(task));
+    if (!queues_[idx].back().coalesce_key.empty()) {
+        pending_by_key_[queues_[idx].back().coalesce_key] = &queues_[idx].back();
+    }
+    return ScheduleResult::kQueued;
+}
+
+bool QueryScheduler::TrySchedule(QueryTask task) {
+    return Schedule(std::move(task)) != ScheduleResult::kRejected;
 }
 
 std::size_t QueryScheduler::DrainOnce() {
-    std::array<std::function<void()>, 1024> executions;
-    std::size_t planned = 0;
+    std::function<void()> execution;
+    bool completes_on_return = false;
+    std::uint64_t generation = 0;
+    std::vector<QueryTask> expired;
 
     {
         std::lock_guard<std::mutex> lock(mutex_);
+        const auto now = Clock::now();
         RefillTokens();
+        ExpireLocked(now, &expired);
+        ReleaseStaleInFlightLocked(now);
 
-        if (in_flight_) {
-            return 0;
-        }
-
-        auto remaining = static_cast<std::size_t>(tokens_);
-        if (remaining == 0) {
-            return 0;
-        }
-
-        for (std::size_t p = 0; p < queues_.size() && remaining > 0; ++p) {
-            while (!queues_[p].empty() && remaining > 0 && planned < 1) {
-                executions[planned++] = std::move(queues_[p].front().execute);
-                queues_[p].pop();
-                --remaining;
-                tokens_ -= 1.0;
-                in_flight_ = true;
+        if (CanStartLocked()) {
+            for (auto& queue : queues_) {
+                if (queue.empty()) {
+                    continue;
+                }
+                QueryTask& task = queue.front();
+                if (!task.coalesce_key.empty()) {
+                    pending_by_key_.erase(task.coalesce_key);
+                }
+                execution = std::move(task.execute);
+                completes_on_return = task.completes_on_return;
+                in_flight_request_id_ = task.request_id;
+                in_flight_merged_request_ids_ = std::move(task.merged_request_ids);
+                queue.pop_front();
+                break;
             }
+            tokens_ -= 1.0;
+            in_flight_ = true;
+            generation = ++in_flight_generation_;
+            in_flight_since_ = now;
+        } else if (HasPendingLocked()) {
+            // Hand the backlog to the drain thread, which knows when it can start next.
+            cv_.notify_all();
         }
     }
 
-    for (std::size_t i = 0; i < planned; ++i) {
-        executions[i]();
+    NotifyExpired(&expired);
+    if (!execution) {
+        return 0;
+    }
+    execution();
+    if (completes_on_return) {
+        CompleteGeneration(generation);
     }
-    return planned;
+    return 1;
 }
 
 void QueryScheduler::MarkComplete() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_ = false;
+    }
+    cv_.notify_all();
+}
+
+void QueryScheduler::MarkComplete(int request_id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!in_flight_ || in_flight_request_id_ != request_id) {
+            return;
+        }
+        in_flight_ = false;
+    }
+    cv_.notify_all();
+}
+
+std::vector<int> QueryScheduler::TakeMergedRequestIds(int request_id) {
     std::lock_guard<std::mutex> lock(mutex_);
-    in_flight_ = false;
+    if (in_flight_request_id_ != request_id) {
+        return {};
+    }
+    return std::exchange(in_flight_merged_request_ids_, {});
 }
 
 std::size_t QueryScheduler::PendingCount() const {
@@ -74,9 +140,52 @@ std::size_t QueryScheduler::PendingCount() const {
 }
 
 void QueryScheduler::SetRateLimit(std::size_t max_qps) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        max_qps_ = std::max<std::size_t>(1, max_qps);
+        tokens_ = std::min(tokens_, static_cast<double>(max_qps_));
+    }
+    cv_.notify_all();
+}
+
+void QueryScheduler::SetInFlightTimeout(std::chrono::milliseconds timeout) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_timeout_ = std::max(std::chrono::milliseconds(0), timeout);
+    }
+    cv_.notify_all();
+}
+
+void QueryScheduler::StartDrainThread() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (drain_thread_.joinable()) {
+        return;
+    }
+    stop_drain_ = false;
+    drain_thread_ = std::thread([this]() { DrainLoop(); });
+}
+
+void QueryScheduler::StopDrainThread() {
+    std::thread drain_thread;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_drain_ = true;
+        drain_thread = std::move(drain_thread_);
+    }
+    cv_.notify_all();
+    if (drain_thread.joinable()) {
+        drain_thread.join();
+    }
+}
+
+std::uint64_t QueryScheduler::CoalescedCount() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    max_qps_ = std::max<std::size_t>(1, max_qps);
-    tokens_ = std::min(tokens_, static_cast<double>(max_qps_));
+    return coalesced_count_;
+}
+
+std::uint64_t QueryScheduler::ExpiredCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return expired_count_;
 }
 
 void QueryScheduler::RefillTokens() {
@@ -92,4 +201,130 @@ void QueryScheduler::RefillTokens() {
     last_refill_ = now;
 }
 
+void QueryScheduler::ExpireLocked(Clock::time_point now, std::vector<QueryTask>* expired) {
+    const std::size_t expired_before = expired->size();
+    for (auto& queue : queues_) {
+        for (auto it = queue.begin(); it != queue.end();) {
+            if (!it->deadline.has_value() || *it->deadline > now) {
+                ++it;
+                continue;
+            }
+            if (!it->coalesce_key.empty()) {
+                pending_by_key_.erase(it->coalesce_key);
+            }
+            expired->push_back(std::move(*it));
+            it = queue.erase(it);
+            ++expired_count_;
+        }
+    }
+    if (expired->size() == expired_before) {
+        return;
+    }
+    // Erasing from the middle of a deque may move the remaining elements.
+    for (auto& queue : queues_) {
+        for (auto& task : queue) {
+            if (!task.coalesce_key.empty()) {
+                pending_by_key_[task.coalesce_key] = &task;
+            }
+        }
+    }
+}
+
+void QueryScheduler::NotifyExpired(std::vector<QueryTask>* expired) {
+    for (auto& task : *expired) {
+        if (!task.on_expired) {
+            continue;
+        }
+        std::vector<int> request_ids;
+        request_ids.reserve(task.merged_request_ids.size() + 1);
+        request_ids.push_back(task.request_id);
+        request_ids.insert(request_ids.end(), task.merged_request_ids.begin(),
+                           task.merged_request_ids.end());
+        task.on_expired(request_ids);
+    }
+    expired->clear();
+}
+
+void QueryScheduler::CompleteGeneration(std::uint64_t generation) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!in_flight_ || in_flight_generation_ != generation) {
+            return;
+        }
+        in_flight_ = false;
+    }
+    cv_.notify_all();
+}
+
+void QueryScheduler::ReleaseStaleInFlightLocked(Clock::time_point now) {
+    if (in_flight_ && in_flight_timeout_.count() > 0 &&
+        now - in_flight_since_ >= in_flight_timeout_) {
+        in_flight_ = false;
+    }
+}
+
+bool QueryScheduler::HasPendingLocked() const {
+    return std::any_of(queues_.begin(), queues_.end(),
+                       [](const Queue& queue) { return !queue.empty(); });
+}
+
+bool QueryScheduler::CanStartLocked() const {
+    return !in_flight_ && tokens_ >= 1.0 && HasPendingLocked();
+}
+
+std::optional<QueryScheduler::Clock::time_point> QueryScheduler::NextWakeLocked(
+    Clock::time_point now) const {
+    std::optional<Clock::time_point> wake;
+    const auto consider = [&wake](Clock::time_point candidate) {
+        if (!wake.has_value() || candidate < *wake) {
+            wake = candidate;
+        }
+    };
+    for (const auto& queue : queues_) {
+        for (const auto& task : queue) {
+            if (task.deadline.has_value()) {
+                consider(*task.deadline);
+            }
+        }
+    }
+    if (in_flight_ && in_flight_timeout_.count() > 0) {
+        consider(in_flight_since_ + in_flight_timeout_);
+    }
+    if (!in_flight_ && tokens_ < 1.0 && max_qps_ > 0 && HasPendingLocked()) {
+        const double wait_ms =
+            std::ceil((1.0 - tokens_) * 1000.0 / static_cast<double>(max_qps_));
+        consider(now + std::chrono::milliseconds(static_cast<std::int64_t>(wait_ms)));
+    }
+    return wake;
+}
+
+void QueryScheduler::DrainLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::vector<QueryTask> expired;
+    while (!stop_drain_) {
+        const auto now = Clock::now();
+        RefillTokens();
+        ExpireLocked(now, &expired);
+        if (!expired.empty()) {
+            lock.unlock();
+            NotifyExpired(&expired);
+            lock.lock();
+            continue;
+        }
+        ReleaseStaleInFlightLocked(now);
+        if (CanStartLocked()) {
+            lock.unlock();
+            (void)DrainOnce();
+            lock.lock();
+            continue;
+        }
+        const auto wake = NextWakeLocked(now);
+        if (wake.has_value()) {
+            cv_.wait_until(lock, *wake);
+        } else {
+            cv_.wait(lock);
+        }
+    }
+}
+
 }  // namespace quant_hft
@@ -396,8 +396,20 @@ bool LibpqTimescaleSqlClient::ExecuteStatement(
     }
 
     const auto& api = Api();
-    auto* conn = static_cast<PGconn*>(conn_raw);
-    std::unique_ptr<PGconn, LibpqApi::PQfinishFn> conn_guard(conn, api.PQfinish);
+    std::unique_ptr<PGconn, LibpqApi::PQfinishFn> conn_guard(static_cast<PGconn*>(conn_raw),
+                                                             api.PQfinish);
+    return ExecuteOnConnection(conn_raw, sql, params, expect_tuples, out_rows, error);
+}
+
+bool LibpqTimescaleSqlClient::ExecuteOnConnection(
+    void* conn_ptr,
+    const std::string& sql,
+    const std::vector<std::string>& params,
+    bool expect_tuples,
+    std::vector<std::unordered_map<std::string, std::string>>* out_rows,
+    std::string* error) {
+    const auto& api = Api();
+    auto* conn = static_cast<PGconn*>(conn_ptr);
 
     PGresult* result = nullptr;
     if (params.empty()) {
@@ -613,6 +625,203 @@ bool LibpqTimescaleSqlClient::UpsertRow(
     return ExecuteStatement(sql.str(), params, false, nullptr, error);
 }
 
+bool LibpqTimescaleSqlClient::WriteBatches(const std::vector<TimescaleWriteBatch>& batches,
+                                           std::string* error) {
+    // Every statement is rendered and validated before the connection opens so
+    // a malformed batch never leaves a half-written transaction behind.
+    std::vector<Statement> statements;
+    for (const auto& batch : batches) {
+        if (!AppendBatchStatements(batch, &statements, error)) {
+            return false;
+        }
+    }
+    if (statements.empty()) {
+        return true;
+    }
+
+    void* conn_raw = nullptr;
+    if (!Connect(&conn_raw, error)) {
+        return false;
+    }
+    const auto& api = Api();
+    std::unique_ptr<PGconn, LibpqApi::PQfinishFn> conn_guard(static_cast<PGconn*>(conn_raw),
+                                                             api.PQfinish);
+    if (!ExecuteOnConnection(conn_raw, "BEGIN", {}, false, nullptr, error)) {
+        return false;
+    }
+    for (const auto& [sql, params] : statements) {
+        if (!ExecuteOnConnection(conn_raw, sql, params, false, nullptr, error)) {
+            std::string rollback_error;
+            (void)ExecuteOnConnection(conn_raw, "ROLLBACK", {}, false, nullptr, &rollback_error);
+            return false;
+        }
+    }
+    return ExecuteOnConnection(conn_raw, "COMMIT", {}, false, nullptr, error);
+}
+
+bool LibpqTimescaleSqlClient::AppendBatchStatements(const TimescaleWriteBatch& batch,
+                                                    std::vector<Statement>* statements,
+                                                    std::string* error) const {
+    if (batch.rows.empty()) {
+        return true;
+    }
+    std::string sql_table;
+    if (!ValidateQualifiedTableIdentifier(batch.table, &sql_table, error)) {
+        return false;
+    }
+
+    std::vector<std::string> columns;
+    columns.reserve(batch.rows.front().size());
+    for (const auto& [column, value] : batch.rows.front()) {
+        (void)value;
+        if (!ValidateSimpleIdentifier(column, "column", error)) {
+            return false;
+        }
+        columns.push_back(column);
+    }
+    std::sort(columns.begin(), columns.end());
+    if (columns.empty()) {
+        if (error != nullptr) {
+            *error = "empty row";
+        }
+        return false;
+    }
+    for (const auto& row : batch.rows) {
+        bool same_shape = row.size() == columns.size();
+        for (std::size_t i = 0; same_shape && i < columns.size(); ++i) {
+            same_shape = row.find(columns[i]) != row.end();
+        }
+        if (!same_shape) {
+            if (error != nullptr) {
+                *error = "batch rows must share one column set: " + batch.table;
+            }
+            return false;
+        }
+    }
+
+    std::vector<std::string> update_keys;
+    for (const auto& key : batch.conflict_keys) {
+        if (!ValidateSimpleIdentifier(key, "conflict key", error)) {
+            return false;
+        }
+        if (!std::binary_search(columns.begin(), columns.end(), key)) {
+            if (error != nullptr) {
+                *error = "missing conflict key in row: " + key;
+            }
+            return false;
+        }
+    }
+    if (!batch.conflict_keys.empty()) {
+        if (!batch.update_keys.empty()) {
+            update_keys = batch.update_keys;
+        } else {
+            for (const auto& column : columns) {
+                if (std::find(batch.conflict_keys.begin(), batch.conflict_keys.end(), column) ==
+                    batch.conflict_keys.end()) {
+                    update_keys.push_back(column);
+                }
+            }
+        }
+        for (const auto& key : update_keys) {
+            if (!ValidateSimpleIdentifier(key, "update key", error)) {
+                return false;
+            }
+            if (!std::binary_search(columns.begin(), columns.end(), key)) {
+                if (error != nullptr) {
+                    *error = "missing update key in row: " + key;
+                }
+                return false;
+            }
+        }
+    }
+
+    // ON CONFLICT DO UPDATE may not touch the same row twice in one statement,
+    // so only the last row per conflict key is sent, in first-seen order.
+    std::vector<std::size_t> order;
+    order.reserve(batch.rows.size());
+    if (batch.conflict_keys.empty()) {
+        for (std::size_t i = 0; i < batch.rows.size(); ++i) {
+            order.push_back(i);
+        }
+    } else {
+        std::unordered_map<std::string, std::size_t> slot_by_key;
+        for (std::size_t i = 0; i < batch.rows.size(); ++i) {
+            std::string key;
+            for (const auto& conflict_key : batch.conflict_keys) {
+                key += batch.rows[i].at(conflict_key);
+                key.push_back('\x1f');
+            }
+            const auto [it, inserted] = slot_by_key.emplace(std::move(key), order.size());
+            if (inserted) {
+                order.push_back(i);
+            } else {
+                order[it->second] = i;
+            }
+        }
+    }
+
+    std::string prefix = "INSERT INTO " + sql_table + " (";
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        if (i > 0) {
+            prefix += ",";
+        }
+        prefix += QuoteIdentifier(columns[i]);
+    }
+    prefix += ") VALUES ";
+
+    std::string suffix;
+    if (batch.conflict_keys.empty()) {
+        suffix = " ON CONFLICT DO NOTHING";
+    } else {
+        suffix = " ON CONFLICT (";
+        for (std::size_t i = 0; i < batch.conflict_keys.size(); ++i) {
+            if (i > 0) {
+                suffix += ",";
+            }
+            suffix += QuoteIdentifier(batch.conflict_keys[i]);
+        }
+        suffix += ") ";
+        if (update_keys.empty()) {
+            suffix += "DO NOTHING";
+        } else {
+            suffix += "DO UPDATE SET ";
+            for (std::size_t i = 0; i < update_keys.size(); ++i) {
+                if (i > 0) {
+                    suffix += ",";
+                }
+                suffix += QuoteIdentifier(update_keys[i]) + " = EXCLUDED." +
+                          QuoteIdentifier(update_keys[i]);
+            }
+        }
+    }
+
+    // The wire protocol caps a statement at 65535 bind parameters.
+    constexpr std::size_t kMaxParams = 65535;
+    const std::size_t rows_per_statement = std::max<std::size_t>(1, kMaxParams / columns.size());
+    for (std::size_t begin = 0; begin < order.size(); begin += rows_per_statement) {
+        const std::size_t end = std::min(order.size(), begin + rows_per_statement);
+        std::ostringstream sql;
+        sql << prefix;
+        std::vector<std::string> params;
+        params.reserve((end - begin) * columns.size());
+        for (std::size_t i = begin; i < end; ++i) {
+            sql << (i > begin ? ",(" : "(");
+            const auto& row = batch.rows[order[i]];
+            for (std::size_t col = 0; col < columns.size(); ++col) {
+                if (col > 0) {
+                    sql << ",";
+                }
+                params.push_back(row.at(columns[col]));
+                sql << "$" << params.size();
+            }
+            sql << ")";
+        }
+        sql << suffix;
+        statements->emplace_back(sql.str(), std::move(params));
+    }
+    return true;
+}
+
 std::vector<std::unordered_map<std::string, std::string>>
 LibpqTimescaleSqlClient::QueryRows(const std::string& table,
                                    const std::string& key,
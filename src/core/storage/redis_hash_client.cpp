@@ -20,7 +20,11 @@ bool InMemoryRedisHashClient::HSet(
         storage_.erase(key);
         expiry_epoch_seconds_.erase(key);
     }
-    storage_[key] = fields;
+    // Like Redis HSET: fields not named in this call keep their values.
+    auto& hash = storage_[key];
+    for (const auto& [field, value] : fields) {
+        hash[field] = value;
+    }
     return true;
 }
 
@@ -92,6 +96,37 @@ bool InMemoryRedisHashClient::HIncrBy(const std::string& key,
     return true;
 }
 
+bool InMemoryRedisHashClient::HDel(const std::string& key,
+                                   const std::vector<std::string>& fields,
+                                   std::string* error) {
+    if (key.empty()) {
+        if (error != nullptr) {
+            *error = "empty key";
+        }
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (IsExpiredLocked(key)) {
+        storage_.erase(key);
+        expiry_epoch_seconds_.erase(key);
+        return true;
+    }
+    const auto it = storage_.find(key);
+    if (it == storage_.end()) {
+        return true;
+    }
+    for (const std::string& field : fields) {
+        it->second.erase(field);
+    }
+    // Like Redis, a hash left without fields no longer exists.
+    if (it->second.empty()) {
+        storage_.erase(it);
+        expiry_epoch_seconds_.erase(key);
+    }
+    return true;
+}
+
 bool InMemoryRedisHashClient::Expire(const std::string& key,
                                      int ttl_seconds,
                                      std::string* error) {
@@ -6,10 +6,12 @@
 #include <cmath>
 #include <ctime>
 #include <iomanip>
+#include <iterator>
 #include <limits>
 #include <sstream>
 #include <thread>
 #include <unordered_set>
+#include <utility>
 
 namespace quant_hft {
 namespace {
@@ -212,19 +214,30 @@ SettlementStoreClientAdapter::SettlementStoreClientAdapter(
       ops_schema_(ops_schema.empty() ? "ops" : std::move(ops_schema)) {}
 
 bool SettlementStoreClientAdapter::BeginTransaction(std::string* error) {
-    (void)error;
+    if (in_transaction_) {
+        if (error != nullptr) {
+            *error = "settlement transaction already open";
+        }
+        return false;
+    }
+    pending_writes_.clear();
     in_transaction_ = true;
     return true;
 }
 
 bool SettlementStoreClientAdapter::CommitTransaction(std::string* error) {
-    (void)error;
+    if (!in_transaction_) {
+        return true;
+    }
+    std::vector<TimescaleWriteBatch> pending;
+    pending.swap(pending_writes_);
     in_transaction_ = false;
-    return true;
+    return WriteBatchesWithRetry(pending, error);
 }
 
 bool SettlementStoreClientAdapter::RollbackTransaction(std::string* error) {
     (void)error;
+    pending_writes_.clear();
     in_transaction_ = false;
     return true;
 }
@@ -316,9 +329,9 @@ bool SettlementStoreClientAdapter::UpsertRun(const SettlementRunRecord& run, std
         {"evidence_path", run.evidence_path},
         {"updated_at", ToTimestamp(run.heartbeat_ts_ns > 0 ? run.heartbeat_ts_ns : NowEpochNanos())},
     };
-    return UpsertWithRetry(
+    return WriteRows(
         TableName(ops_schema_, "settlement_runs"),
-        row,
+        {row},
         {"trading_day"},
         {"status",
          "force_run",
@@ -355,71 +368,106 @@ bool SettlementStoreClientAdapter::AppendSummary(const SettlementSummaryRecord&
         {"risk_degree", ToString(summary.risk_degree)},
         {"created_at", ToTimestamp(summary.created_ts_ns)},
     };
-    return InsertWithRetry(TableName(trading_schema_, "settlement_summary"), row, error);
+    return WriteRows(TableName(trading_schema_, "settlement_summary"), {row}, {}, {},
+                     error);
 }
 
 bool SettlementStoreClientAdapter::AppendDetail(const SettlementDetailRecord& detail,
                                                 std::string* error) {
-    if (detail.trading_day.empty() || detail.instrument_id.empty() || detail.position_id <= 0) {
-        if (error != nullptr) {
-            *error = "settlement detail requires trading_day/instrument_id/position_id";
-        }
-        return false;
-    }
-    std::unordered_map<std::string, std::string> row{
-        {"trading_day", detail.trading_day},
-        {"settlement_id", ToString(detail.settlement_id)},
-        {"position_id", ToString(detail.position_id)},
-        {"instrument_id", detail.instrument_id},
-        {"volume", ToString(detail.volume)},
-        {"settlement_price", ToString(detail.settlement_price)},
-        {"profit", ToString(detail.profit)},
-        {"created_at", ToTimestamp(detail.created_ts_ns)},
-    };
-    return InsertWithRetry(TableName(trading_schema_, "settlement_detail"), row, error);
+    return AppendDetails({detail}, error);
 }
 
 bool SettlementStoreClientAdapter::AppendPrice(const SettlementPriceRecord& price,
                                                std::string* error) {
-    if (price.trading_day.empty() || price.instrument_id.empty() || price.source.empty()) {
-        if (error != nullptr) {
-            *error = "settlement price requires trading_day/instrument_id/source";
-        }
-        return false;
-    }
-    std::unordered_map<std::string, std::string> row{
-        {"trading_day", price.trading_day},
-        {"instrument_id", price.instrument_id},
-        {"exchange_id", price.exchange_id},
-        {"source", price.source},
-        {"settlement_price", price.has_settlement_price ? ToString(price.settlement_price) : ""},
-        {"is_final", price.is_final ? "1" : "0"},
-        {"created_at", ToTimestamp(price.created_ts_ns)},
-    };
-    return InsertWithRetry(TableName(trading_schema_, "settlement_prices"), row, error);
+    return AppendPrices({price}, error);
 }
 
 bool SettlementStoreClientAdapter::AppendReconcileDiff(const SettlementReconcileDiffRecord& diff,
                                                        std::string* error) {
-    if (diff.trading_day.empty() || diff.diff_type.empty()) {
-        if (error != nullptr) {
-            *error = "settlement reconcile diff requires trading_day/diff_type";
+    return AppendReconcileDiffs({diff}, error);
+}
+
+bool SettlementStoreClientAdapter::AppendDetails(
+    const std::vector<SettlementDetailRecord>& details,
+    std::string* error) {
+    std::vector<std::unordered_map<std::string, std::string>> rows;
+    rows.reserve(details.size());
+    for (const auto& detail : details) {
+        if (detail.trading_day.empty() || detail.instrument_id.empty() ||
+            detail.position_id <= 0) {
+            if (error != nullptr) {
+                *error = "settlement detail requires trading_day/instrument_id/position_id";
+            }
+            return false;
         }
-        return false;
-    }
-    std::unordered_map<std::string, std::string> row{
-        {"trading_day", diff.trading_day},
-        {"account_id", diff.account_id},
-        {"diff_type", diff.diff_type},
-        {"key_ref", diff.key_ref},
-        {"local_value", ToString(diff.local_value)},
-        {"ctp_value", ToString(diff.ctp_value)},
-        {"delta_value", ToString(diff.delta_value)},
-        {"diagnose_hint", diff.diagnose_hint},
-        {"raw_payload", diff.raw_payload},
-        {"created_at", ToTimestamp(diff.created_ts_ns)},
-    };
-    return InsertWithRetry(TableName(ops_schema_, "settlement_reconcile_diff"), row, error);
+        rows.push_back({
+            {"trading_day", detail.trading_day},
+            {"settlement_id", ToString(detail.settlement_id)},
+            {"position_id", ToString(detail.position_id)},
+            {"instrument_id", detail.instrument_id},
+            {"volume", ToString(detail.volume)},
+            {"settlement_price", ToString(detail.settlement_price)},
+            {"profit", ToString(detail.profit)},
+            {"created_at", ToTimestamp(detail.created_ts_ns)},
+        });
+    }
+    return WriteRows(TableName(trading_schema_, "settlement_detail"), std::move(rows), {}, {},
+                     error);
+}
+
+bool SettlementStoreClientAdapter::AppendPrices(const std::vector<SettlementPriceRecord>& prices,
+                                                std::string* error) {
+    std::vector<std::unordered_map<std::string, std::string>> rows;
+    rows.reserve(prices.size());
+    for (const auto& price : prices) {
+        if (price.trading_day.empty() || price.instrument_id.empty() || price.source.empty()) {
+            if (error != nullptr) {
+                *error = "settlement price requires trading_day/instrument_id/source";
+            }
+            return false;
+        }
+        rows.push_back({
+            {"trading_day", price.trading_day},
+            {"instrument_id", price.instrument_id},
+            {"exchange_id", price.exchange_id},
+            {"source", price.source},
+            {"settlement_price",
+             price.has_settlement_price ? ToString(price.settlement_price) : ""},
+            {"is_final", price.is_final ? "1" : "0"},
+            {"created_at", ToTimestamp(price.created_ts_ns)},
+        });
+    }
+    return WriteRows(TableName(trading_schema_, "settlement_prices"), std::move(rows), {}, {},
+                     error);
+}
+
+bool SettlementStoreClientAdapter::AppendReconcileDiffs(
+    const std::vector<SettlementReconcileDiffRecord>& diffs,
+    std::string* error) {
+    std::vector<std::unordered_map<std::string, std::string>> rows;
+    rows.reserve(diffs.size());
+    for (const auto& diff : diffs) {
+        if (diff.trading_day.empty() || diff.diff_type.empty()) {
+            if (error != nullptr) {
+                *error = "settlement reconcile diff requires trading_day/diff_type";
+            }
+            return false;
+        }
+        rows.push_back({
+            {"trading_day", diff.trading_day},
+            {"account_id", diff.account_id},
+            {"diff_type", diff.diff_type},
+            {"key_ref", diff.key_ref},
+            {"local_value", ToString(diff.local_value)},
+            {"ctp_value", ToString(diff.ctp_value)},
+            {"delta_value", ToString(diff.delta_value)},
+            {"diagnose_hint", diff.diagnose_hint},
+            {"raw_payload", diff.raw_payload},
+            {"created_at", ToTimestamp(diff.created_ts_ns)},
+        });
+    }
+    return WriteRows(TableName(ops_schema_, "settlement_reconcile_diff"), std::move(rows), {}, {},
+                     error);
 }
 
 bool SettlementStoreClientAdapter::LoadOpenPositions(
@@ -537,47 +585,61 @@ bool SettlementStoreClientAdapter::LoadInstruments(
 bool SettlementStoreClientAdapter::UpdatePositionAfterSettlement(
     const SettlementOpenPositionRecord& position,
     std::string* error) {
-    if (position.position_id <= 0 || position.open_date.empty() || position.instrument_id.empty()) {
-        if (error != nullptr) {
-            *error = "position requires position_id/open_date/instrument_id";
-        }
-        return false;
-    }
+    return UpdatePositionsAfterSettlement({position}, error);
+}
 
-    const EpochNanos now_ts = position.update_ts_ns > 0 ? position.update_ts_ns : NowEpochNanos();
-    std::unordered_map<std::string, std::string> row{
-        {"position_id", ToString(position.position_id)},
-        {"account_id", position.account_id},
-        {"strategy_id", position.strategy_id},
-        {"instrument_id", position.instrument_id},
-        {"exchange_id", position.exchange_id},
-        {"open_date", position.open_date},
-        {"open_price", ToString(position.open_price)},
-        {"volume", ToString(position.volume)},
-        {"is_today", position.is_today ? "1" : "0"},
-        {"position_date", position.position_date},
-        {"close_volume", ToString(position.close_volume)},
-        {"position_status", ToString(position.position_status)},
-        {"accumulated_mtm", ToString(position.accumulated_mtm)},
-        {"last_settlement_date", position.last_settlement_date},
-        {"last_settlement_price", ToString(position.last_settlement_price)},
-        {"last_settlement_profit", ToString(position.last_settlement_profit)},
-        {"update_time", ToTimestamp(now_ts)},
-    };
-    return UpsertWithRetry(TableName(trading_schema_, "position_detail"),
-                           row,
-                           {"position_id", "open_date"},
-                           {"open_price",
-                            "is_today",
-                            "position_date",
-                            "close_volume",
-                            "position_status",
-                            "accumulated_mtm",
-                            "last_settlement_date",
-                            "last_settlement_price",
-                            "last_settlement_profit",
-                            "update_time"},
-                           error);
+bool SettlementStoreClientAdapter::UpdatePositionsAfterSettlement(
+    const std::vector<SettlementOpenPositionRecord>& positions,
+    std::string* error) {
+    std::vector<std::unordered_map<std::string, std::string>> rows;
+    rows.reserve(positions.size());
+    EpochNanos fallback_ts = 0;
+    for (const auto& position : positions) {
+        if (position.position_id <= 0 || position.open_date.empty() ||
+            position.instrument_id.empty()) {
+            if (error != nullptr) {
+                *error = "position requires position_id/open_date/instrument_id";
+            }
+            return false;
+        }
+        if (position.update_ts_ns <= 0 && fallback_ts == 0) {
+            fallback_ts = NowEpochNanos();
+        }
+        const EpochNanos now_ts = position.update_ts_ns > 0 ? position.update_ts_ns : fallback_ts;
+        rows.push_back({
+            {"position_id", ToString(position.position_id)},
+            {"account_id", position.account_id},
+            {"strategy_id", position.strategy_id},
+            {"instrument_id", position.instrument_id},
+            {"exchange_id", position.exchange_id},
+            {"open_date", position.open_date},
+            {"open_price", ToString(position.open_price)},
+            {"volume", ToString(position.volume)},
+            {"is_today", position.is_today ? "1" : "0"},
+            {"position_date", position.position_date},
+            {"close_volume", ToString(position.close_volume)},
+            {"position_status", ToString(position.position_status)},
+            {"accumulated_mtm", ToString(position.accumulated_mtm)},
+            {"last_settlement_date", position.last_settlement_date},
+            {"last_settlement_price", ToString(position.last_settlement_price)},
+            {"last_settlement_profit", ToString(position.last_settlement_profit)},
+            {"update_time", ToTimestamp(now_ts)},
+        });
+    }
+    return WriteRows(TableName(trading_schema_, "position_detail"),
+                     std::move(rows),
+                     {"position_id", "open_date"},
+                     {"open_price",
+                      "is_today",
+                      "position_date",
+                      "close_volume",
+                      "position_status",
+                      "accumulated_mtm",
+                      "last_settlement_date",
+                      "last_settlement_price",
+                      "last_settlement_profit",
+                      "update_time"},
+                     error);
 }
 
 bool SettlementStoreClientAdapter::RolloverPositionDetail(const std::string& account_id,
@@ -586,17 +648,17 @@ bool SettlementStoreClientAdapter::RolloverPositionDetail(const std::string& acc
     if (!LoadOpenPositions(account_id, &positions, error)) {
         return false;
     }
+    std::vector<SettlementOpenPositionRecord> rolled;
+    const EpochNanos now_ts = NowEpochNanos();
     for (auto& position : positions) {
         if (!position.is_today) {
             continue;
         }
         position.is_today = false;
-        position.update_ts_ns = NowEpochNanos();
-        if (!UpdatePositionAfterSettlement(position, error)) {
-            return false;
-        }
+        position.update_ts_ns = now_ts;
+        rolled.push_back(std::move(position));
     }
-    return true;
+    return UpdatePositionsAfterSettlement(rolled, error);
 }
 
 bool SettlementStoreClientAdapter::RolloverPositionSummary(const std::string& account_id,
@@ -611,6 +673,9 @@ bool SettlementStoreClientAdapter::RolloverPositionSummary(const std::string& ac
         return false;
     }
 
+    std::vector<std::unordered_map<std::string, std::string>> updates;
+    updates.reserve(rows.size());
+    const std::string update_time = ToTimestamp(NowEpochNanos());
     for (const auto& row : rows) {
         const int long_today = ParseIntOrDefault(row, "long_today_volume");
         const int short_today = ParseIntOrDefault(row, "short_today_volume");
@@ -619,7 +684,7 @@ bool SettlementStoreClientAdapter::RolloverPositionSummary(const std::string& ac
         const int long_volume = ParseIntOrDefault(row, "long_volume");
         const int short_volume = ParseIntOrDefault(row, "short_volume");
 
-        std::unordered_map<std::string, std::string> update{
+        updates.push_back({
             {"account_id", ParseStringOrDefault(row, "account_id")},
             {"strategy_id", ParseStringOrDefault(row, "strategy_id")},
             {"instrument_id", ParseStringOrDefault(row, "instrument_id")},
@@ -635,28 +700,25 @@ bool SettlementStoreClientAdapter::RolloverPositionSummary(const std::string& ac
             {"avg_short_price", ParseStringOrDefault(row, "avg_short_price")},
             {"position_profit", ParseStringOrDefault(row, "position_profit")},
             {"margin", ParseStringOrDefault(row, "margin")},
-            {"update_time", ToTimestamp(NowEpochNanos())},
-        };
-        if (!UpsertWithRetry(TableName(trading_schema_, "position_summary"),
-                             update,
-                             {"account_id", "strategy_id", "instrument_id"},
-                             {"long_volume",
-                              "short_volume",
-                              "net_volume",
-                              "long_today_volume",
-                              "short_today_volume",
-                              "long_yd_volume",
-                              "short_yd_volume",
-                              "avg_long_price",
-                              "avg_short_price",
-                              "position_profit",
-                              "margin",
-                              "update_time"},
-                             error)) {
-            return false;
-        }
-    }
-    return true;
+            {"update_time", update_time},
+        });
+    }
+    return WriteRows(TableName(trading_schema_, "position_summary"),
+                     std::move(updates),
+                     {"account_id", "strategy_id", "instrument_id"},
+                     {"long_volume",
+                      "short_volume",
+                      "net_volume",
+                      "long_today_volume",
+                      "short_today_volume",
+                      "long_yd_volume",
+                      "short_yd_volume",
+                      "avg_long_price",
+                      "avg_short_price",
+                      "position_profit",
+                      "margin",
+                      "update_time"},
+                     error);
 }
 
 bool SettlementStoreClientAdapter::LoadAccountFunds(const std::string& account_id,
@@ -825,26 +887,26 @@ bool SettlementStoreClientAdapter::UpsertAccountFunds(const SettlementAccountFun
         {"floating_profit", ToString(funds.floating_profit)},
         {"update_time", ToTimestamp(funds.update_ts_ns)},
     };
-    return UpsertWithRetry(TableName(trading_schema_, "account_funds"),
-                           row,
-                           {"account_id", "trading_day"},
-                           {"currency",
-                            "pre_balance",
-                            "deposit",
-                            "withdraw",
-                            "frozen_commission",
-                            "frozen_margin",
-                            "available",
-                            "curr_margin",
-                            "commission",
-                            "close_profit",
-                            "position_profit",
-                            "balance",
-                            "risk_degree",
-                            "pre_settlement_balance",
-                            "floating_profit",
-                            "update_time"},
-                           error);
+    return WriteRows(TableName(trading_schema_, "account_funds"),
+                     {row},
+                     {"account_id", "trading_day"},
+                     {"currency",
+                      "pre_balance",
+                      "deposit",
+                      "withdraw",
+                      "frozen_commission",
+                      "frozen_margin",
+                      "available",
+                      "curr_margin",
+                      "commission",
+                      "close_profit",
+                      "position_profit",
+                      "balance",
+                      "risk_degree",
+                      "pre_settlement_balance",
+                      "floating_profit",
+                      "update_time"},
+                     error);
 }
 
 bool SettlementStoreClientAdapter::LoadPositionSummary(
@@ -972,11 +1034,11 @@ bool SettlementStoreClientAdapter::UpsertSystemConfig(const std::string& key,
         {"description", ""},
         {"update_time", ToTimestamp(NowEpochNanos())},
     };
-    return UpsertWithRetry(TableName(ops_schema_, "system_config"),
-                           row,
-                           {"config_key"},
-                           {"config_value", "update_time"},
-                           error);
+    return WriteRows(TableName(ops_schema_, "system_config"),
+                     {row},
+                     {"config_key"},
+                     {"config_value", "update_time"},
+                     error);
 }
 
 bool SettlementStoreClientAdapter::SumTradeField(const std::string& account_id,
@@ -1081,6 +1143,115 @@ bool SettlementStoreClientAdapter::UpsertWithRetry(
     return false;
 }
 
+bool SettlementStoreClientAdapter::WriteRows(
+    const std::string& table,
+    std::vector<std::unordered_map<std::string, std::string>> rows,
+    std::vector<std::string> conflict_keys,
+    std::vector<std::string> update_keys,
+    std::string* error) {
+    if (rows.empty()) {
+        return true;
+    }
+    if (in_transaction_) {
+        // Consecutive writes of one statement shape share a batch so a loop of
+        // per-row calls still commits as a handful of multi-row statements.
+        if (!pending_writes_.empty()) {
+            auto& last = pending_writes_.back();
+            if (last.table == table && last.conflict_keys == conflict_keys &&
+                last.update_keys == update_keys && SameColumns(last.rows.front(), rows.front())) {
+                last.rows.insert(last.rows.end(),
+                                 std::make_move_iterator(rows.begin()),
+                                 std::make_move_iterator(rows.end()));
+                return true;
+            }
+        }
+        pending_writes_.push_back(TimescaleWriteBatch{
+            table, std::move(rows), std::move(conflict_keys), std::move(update_keys)});
+        return true;
+    }
+    if (rows.size() == 1) {
+        return conflict_keys.empty()
+                   ? InsertWithRetry(table, rows.front(), error)
+                   : UpsertWithRetry(table, rows.front(), conflict_keys, update_keys, error);
+    }
+    return WriteBatchesWithRetry(
+        {TimescaleWriteBatch{
+            table, std::move(rows), std::move(conflict_keys), std::move(update_keys)}},
+        error);
+}
+
+bool SettlementStoreClientAdapter::WriteBatchesWithRetry(
+    const std::vector<TimescaleWriteBatch>& batches,
+    std::string* error) const {
+    if (client_ == nullptr) {
+        if (error != nullptr) {
+            *error = "null sql client";
+        }
+        return false;
+    }
+    if (batches.empty()) {
+        return true;
+    }
+    const int attempts = std::max(1, retry_policy_.max_attempts);
+    int backoff_ms = std::max(0, retry_policy_.initial_backoff_ms);
+    const int max_backoff_ms = std::max(backoff_ms, retry_policy_.max_backoff_ms);
+
+    // Every fallback stays a single WriteBatches call, so the client's
+    // transaction keeps the whole set all-or-nothing; replaying rows one at a
+    // time would commit a prefix of it on failure.
+    std::vector<TimescaleWriteBatch> inserts;
+    const std::vector<TimescaleWriteBatch>* current = &batches;
+    std::string last_error;
+    for (int attempt = 1; attempt <= attempts; ++attempt) {
+        std::string local_error;
+        if (client_->WriteBatches(*current, &local_error)) {
+            return true;
+        }
+        if (current == &batches && IsUpsertUnsupportedError(local_error)) {
+            // Like UpsertWithRetry, clients without upsert get plain inserts
+            // that skip rows colliding with an existing key.
+            inserts = batches;
+            for (auto& batch : inserts) {
+                batch.conflict_keys.clear();
+                batch.update_keys.clear();
+            }
+            current = &inserts;
+            local_error.clear();
+            if (client_->WriteBatches(*current, &local_error)) {
+                return true;
+            }
+        }
+        last_error = local_error;
+        if (IsDuplicateKeyError(local_error)) {
+            // The client does not skip conflicting rows; retrying cannot help.
+            break;
+        }
+        if (attempt < attempts && backoff_ms > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(backoff_ms));
+            backoff_ms = std::min(max_backoff_ms, backoff_ms * 2);
+        }
+    }
+    if (error != nullptr) {
+        *error = last_error.empty() ? "batch write failed" : last_error;
+    }
+    return false;
+}
+
+bool SettlementStoreClientAdapter::SameColumns(
+    const std::unordered_map<std::string, std::string>& lhs,
+    const std::unordered_map<std::string, std::string>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (const auto& [column, value] : lhs) {
+        (void)value;
+        if (rhs.find(column) == rhs.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool SettlementStoreClientAdapter::IsDuplicateKeyError(const std::string& error) const {
     std::string lowered = error;
     std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char ch) {
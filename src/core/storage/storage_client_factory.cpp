@@ -62,6 +62,17 @@ public:
         return false;
     }
 
+    bool HDel(const std::string& key,
+              const std::vector<std::string>& fields,
+              std::string* error) override {
+        (void)key;
+        (void)fields;
+        if (error != nullptr) {
+            *error = reason_;
+        }
+        return false;
+    }
+
     bool Expire(const std::string& key, int ttl_seconds, std::string* error) override {
         (void)key;
         (void)ttl_seconds;
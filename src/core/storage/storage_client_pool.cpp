@@ -161,6 +161,38 @@ bool PooledRedisHashClient::HIncrBy(const std::string& key,
     return false;
 }
 
+bool PooledRedisHashClient::HDel(const std::string& key,
+                                 const std::vector<std::string>& fields,
+                                 std::string* error) {
+    const auto total = pool_.Size();
+    if (total == 0 || key.empty() || fields.empty()) {
+        if (error != nullptr) {
+            *error = "redis pool empty or invalid input";
+        }
+        return false;
+    }
+
+    const std::size_t start = std::hash<std::string>{}(key) % total;
+    for (std::size_t i = 0; i < total; ++i) {
+        const auto client = pool_.ClientAt(start + i);
+        if (client == nullptr) {
+            continue;
+        }
+
+        std::string ping_error;
+        if (!client->Ping(&ping_error)) {
+            continue;
+        }
+        if (client->HDel(key, fields, error)) {
+            return true;
+        }
+    }
+    if (error != nullptr && error->empty()) {
+        *error = "all redis clients failed";
+    }
+    return false;
+}
+
 bool PooledRedisHashClient::Expire(const std::string& key,
                                    int ttl_seconds,
                                    std::string* error) {
@@ -599,6 +599,41 @@ bool TcpRedisHashClient::HIncrBy(const std::string& key,
     return true;
 }
 
+bool TcpRedisHashClient::HDel(const std::string& key,
+                              const std::vector<std::string>& fields,
+                              std::string* error) {
+    if (key.empty()) {
+        if (error != nullptr) {
+            *error = "empty key";
+        }
+        return false;
+    }
+    if (fields.empty()) {
+        if (error != nullptr) {
+            *error = "fields is empty";
+        }
+        return false;
+    }
+
+    std::vector<std::string> args;
+    args.reserve(2 + fields.size());
+    args.push_back("HDEL");
+    args.push_back(key);
+    args.insert(args.end(), fields.begin(), fields.end());
+
+    RespValue reply;
+    if (!ExecuteCommand(args, &reply, error)) {
+        return false;
+    }
+    if (reply.type != RespValue::Type::kInteger) {
+        if (error != nullptr) {
+            *error = "unexpected HDEL reply";
+        }
+        return false;
+    }
+    return true;
+}
+
 bool TcpRedisHashClient::Expire(const std::string& key,
                                 int ttl_seconds,
                                 std::string* error) {
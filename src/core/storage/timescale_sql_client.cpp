@@ -1,5 +1,7 @@
 #include "quant_hft/core/timescale_sql_client.h"
 
+#include <utility>
+
 namespace quant_hft {
 
 bool InMemoryTimescaleSqlClient::InsertRow(
@@ -41,7 +43,56 @@ bool InMemoryTimescaleSqlClient::UpsertRow(
     }
 
     std::lock_guard<std::mutex> lock(mutex_);
-    auto& rows = tables_[table];
+    return UpsertInto(&tables_[table], row, conflict_keys, update_keys, error);
+}
+
+bool InMemoryTimescaleSqlClient::WriteBatches(const std::vector<TimescaleWriteBatch>& batches,
+                                              std::string* error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Batches are applied to copies of the touched tables and swapped in only
+    // when every row succeeded, matching the all-or-nothing libpq transaction.
+    std::unordered_map<std::string, Rows> staged;
+    for (const auto& batch : batches) {
+        if (batch.table.empty()) {
+            if (error != nullptr) {
+                *error = "empty table";
+            }
+            return false;
+        }
+        auto staged_it = staged.find(batch.table);
+        if (staged_it == staged.end()) {
+            const auto table_it = tables_.find(batch.table);
+            staged_it =
+                staged.emplace(batch.table, table_it == tables_.end() ? Rows{} : table_it->second)
+                    .first;
+        }
+        Rows& rows = staged_it->second;
+        for (const auto& row : batch.rows) {
+            if (row.empty()) {
+                if (error != nullptr) {
+                    *error = "empty row";
+                }
+                return false;
+            }
+            if (batch.conflict_keys.empty()) {
+                rows.push_back(row);
+            } else if (!UpsertInto(&rows, row, batch.conflict_keys, batch.update_keys, error)) {
+                return false;
+            }
+        }
+    }
+    for (auto& [table, rows] : staged) {
+        tables_[table] = std::move(rows);
+    }
+    return true;
+}
+
+bool InMemoryTimescaleSqlClient::UpsertInto(
+    Rows* rows,
+    const std::unordered_map<std::string, std::string>& row,
+    const std::vector<std::string>& conflict_keys,
+    const std::vector<std::string>& update_keys,
+    std::string* error) {
     for (const auto& key : conflict_keys) {
         if (row.find(key) == row.end()) {
             if (error != nullptr) {
@@ -86,7 +137,7 @@ bool InMemoryTimescaleSqlClient::UpsertRow(
         return derived;
     }();
 
-    for (auto& existing : rows) {
+    for (auto& existing : *rows) {
         if (!matches_conflict_keys(existing)) {
             continue;
         }
@@ -103,7 +154,7 @@ bool InMemoryTimescaleSqlClient::UpsertRow(
         return true;
     }
 
-    rows.push_back(row);
+    rows->push_back(row);
     return true;
 }
 
@@ -0,0 +1,438 @@
+#include "quant_hft/indicators/batch_indicators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace quant_hft {
+namespace {
+
+int MaxPeriod(const std::vector<int>& periods, const char* error_message) {
+    int max_period = 0;
+    for (const int period : periods) {
+        if (period <= 0) {
+            throw std::invalid_argument(error_message);
+        }
+        max_period = std::max(max_period, period);
+    }
+    return max_period;
+}
+
+}  // namespace
+
+namespace batch_detail {
+
+RecentHistory::RecentHistory(std::size_t capacity) : values_(capacity, 0.0) {}
+
+void RecentHistory::Push(double value) {
+    if (values_.empty()) {
+        return;
+    }
+    head_ = head_ + 1 == values_.size() ? 0 : head_ + 1;
+    values_[head_] = value;
+    size_ = std::min(size_ + 1, values_.size());
+}
+
+double RecentHistory::Back(std::size_t offset) const {
+    const std::size_t capacity = values_.size();
+    return values_[(head_ + capacity - offset) % capacity];
+}
+
+void RecentHistory::Clear() {
+    head_ = 0;
+    size_ = 0;
+}
+
+}  // namespace batch_detail
+
+BatchSMA::BatchSMA(std::vector<int> periods)
+    : periods_(std::move(periods)),
+      sums_(periods_.size(), 0.0),
+      closes_(static_cast<std::size_t>(MaxPeriod(periods_, "SMA period must be positive"))) {}
+
+void BatchSMA::Update(double high, double low, double close, double volume) {
+    (void)high;
+    (void)low;
+    (void)volume;
+
+    if (!std::isfinite(close)) {
+        return;
+    }
+
+    // Offset p-1 before the push is the close that leaves a full window of p.
+    const std::size_t lanes = periods_.size();
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        const int period = periods_[lane];
+        if (bars_ >= period) {
+            sums_[lane] -= closes_.Back(static_cast<std::size_t>(period - 1));
+        }
+    }
+    closes_.Push(close);
+    ++bars_;
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        sums_[lane] += close;
+    }
+}
+
+std::optional<double> BatchSMA::Value(std::size_t lane) const {
+    if (!IsReady(lane)) {
+        return std::nullopt;
+    }
+    return sums_[lane] / static_cast<double>(periods_[lane]);
+}
+
+bool BatchSMA::IsReady(std::size_t lane) const {
+    return lane < periods_.size() && bars_ >= periods_[lane];
+}
+
+void BatchSMA::Reset() {
+    std::fill(sums_.begin(), sums_.end(), 0.0);
+    closes_.Clear();
+    bars_ = 0;
+}
+
+BatchEMA::BatchEMA(std::vector<int> periods)
+    : periods_(std::move(periods)),
+      emas_(periods_.size(), 0.0),
+      closes_(static_cast<std::size_t>(MaxPeriod(periods_, "EMA period must be positive"))) {
+    alphas_.reserve(periods_.size());
+    for (const int period : periods_) {
+        alphas_.push_back(2.0 / static_cast<double>(period + 1));
+    }
+}
+
+void BatchEMA::Update(double high, double low, double close, double volume) {
+    (void)high;
+    (void)low;
+    (void)volume;
+
+    if (!std::isfinite(close)) {
+        return;
+    }
+
+    closes_.Push(close);
+    ++bars_;
+    const std::size_t lanes = periods_.size();
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        const int period = periods_[lane];
+        if (bars_ > period) {
+            emas_[lane] = emas_[lane] + alphas_[lane] * (close - emas_[lane]);
+        } else if (bars_ == period) {
+            double sum = 0.0;
+            for (int offset = period - 1; offset >= 0; --offset) {
+                sum += closes_.Back(static_cast<std::size_t>(offset));
+            }
+            emas_[lane] = sum / static_cast<double>(period);
+        }
+    }
+}
+
+std::optional<double> BatchEMA::Value(std::size_t lane) const {
+    if (!IsReady(lane)) {
+        return std::nullopt;
+    }
+    return emas_[lane];
+}
+
+bool BatchEMA::IsReady(std::size_t lane) const {
+    return lane < periods_.size() && bars_ >= periods_[lane];
+}
+
+void BatchEMA::Reset() {
+    std::fill(emas_.begin(), emas_.end(), 0.0);
+    closes_.Clear();
+    bars_ = 0;
+}
+
+BatchATR::BatchATR(std::vector<int> periods)
+    : periods_(std::move(periods)), seed_sums_(periods_.size(), 0.0), atrs_(periods_.size(), 0.0) {
+    MaxPeriod(periods_, "ATR period must be positive");
+}
+
+void BatchATR::Update(double high, double low, double close, double volume) {
+    (void)volume;
+
+    if (!std::isfinite(high) || !std::isfinite(low) || !std::isfinite(close)) {
+        return;
+    }
+
+    const double range = std::fabs(high - low);
+    double tr = range;
+    if (has_prev_close_) {
+        tr = std::max({range, std::fabs(high - prev_close_), std::fabs(low - prev_close_)});
+    }
+
+    ++bars_;
+    const std::size_t lanes = periods_.size();
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        const int period = periods_[lane];
+        if (bars_ > period) {
+            atrs_[lane] = ((atrs_[lane] * static_cast<double>(period - 1)) + tr) /
+                          static_cast<double>(period);
+        } else {
+            seed_sums_[lane] += tr;
+            if (bars_ == period) {
+                atrs_[lane] = seed_sums_[lane] / static_cast<double>(period);
+            }
+        }
+    }
+    prev_close_ = close;
+    has_prev_close_ = true;
+}
+
+std::optional<double> BatchATR::Value(std::size_t lane) const {
+    if (!IsReady(lane)) {
+        return std::nullopt;
+    }
+    return atrs_[lane];
+}
+
+bool BatchATR::IsReady(std::size_t lane) const {
+    return lane < periods_.size() && bars_ >= periods_[lane];
+}
+
+void BatchATR::Reset() {
+    std::fill(seed_sums_.begin(), seed_sums_.end(), 0.0);
+    std::fill(atrs_.begin(), atrs_.end(), 0.0);
+    has_prev_close_ = false;
+    prev_close_ = 0.0;
+    bars_ = 0;
+}
+
+BatchADX::BatchADX(std::vector<int> periods)
+    : periods_(std::move(periods)),
+      tr_smoothed_(periods_.size(), 0.0),
+      plus_dm_smoothed_(periods_.size(), 0.0),
+      minus_dm_smoothed_(periods_.size(), 0.0),
+      plus_di_(periods_.size(), 0.0),
+      minus_di_(periods_.size(), 0.0),
+      dx_(periods_.size(), 0.0),
+      dx_seed_sums_(periods_.size(), 0.0),
+      adx_(periods_.size(), 0.0) {
+    MaxPeriod(periods_, "ADX period must be positive");
+}
+
+void BatchADX::Update(double high, double low, double close, double volume) {
+    (void)volume;
+
+    if (!std::isfinite(high) || !std::isfinite(low) || !std::isfinite(close)) {
+        return;
+    }
+
+    const double tr_range = std::fabs(high - low);
+    double tr = tr_range;
+    double plus_dm = 0.0;
+    double minus_dm = 0.0;
+    if (has_prev_bar_) {
+        const double up_move = high - prev_high_;
+        const double down_move = prev_low_ - low;
+        plus_dm = (up_move > down_move && up_move > 0.0) ? up_move : 0.0;
+        minus_dm = (down_move > up_move && down_move > 0.0) ? down_move : 0.0;
+        tr = std::max({tr_range, std::fabs(high - prev_close_), std::fabs(low - prev_close_)});
+    }
+    prev_high_ = high;
+    prev_low_ = low;
+    prev_close_ = close;
+    has_prev_bar_ = true;
+
+    // The smoothed sums double as seed sums until a lane has seen `period` bars,
+    // which is exactly the value the scalar ADX copies over when it turns ready.
+    ++bars_;
+    const std::size_t lanes = periods_.size();
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        const int period = periods_[lane];
+        if (bars_ > period) {
+            const double p = static_cast<double>(period);
+            tr_smoothed_[lane] = tr_smoothed_[lane] - (tr_smoothed_[lane] / p) + tr;
+            plus_dm_smoothed_[lane] = plus_dm_smoothed_[lane] - (plus_dm_smoothed_[lane] / p) +
+                                      plus_dm;
+            minus_dm_smoothed_[lane] =
+                minus_dm_smoothed_[lane] - (minus_dm_smoothed_[lane] / p) + minus_dm;
+        } else {
+            tr_smoothed_[lane] += tr;
+            plus_dm_smoothed_[lane] += plus_dm;
+            minus_dm_smoothed_[lane] += minus_dm;
+            if (bars_ < period) {
+                continue;
+            }
+        }
+
+        if (tr_smoothed_[lane] <= 0.0) {
+            plus_di_[lane] = 0.0;
+            minus_di_[lane] = 0.0;
+            dx_[lane] = 0.0;
+        } else {
+            plus_di_[lane] = 100.0 * plus_dm_smoothed_[lane] / tr_smoothed_[lane];
+            minus_di_[lane] = 100.0 * minus_dm_smoothed_[lane] / tr_smoothed_[lane];
+            const double denominator = plus_di_[lane] + minus_di_[lane];
+            dx_[lane] = denominator > 0.0
+                            ? 100.0 * std::fabs(plus_di_[lane] - minus_di_[lane]) / denominator
+                            : 0.0;
+        }
+
+        // DX is first available on bar `period`; ADX seeds on the period-th DX.
+        const std::int64_t adx_seed_bar = 2 * static_cast<std::int64_t>(period) - 1;
+        if (bars_ > adx_seed_bar) {
+            adx_[lane] = ((adx_[lane] * static_cast<double>(period - 1)) + dx_[lane]) /
+                         static_cast<double>(period);
+        } else {
+            dx_seed_sums_[lane] += dx_[lane];
+            if (bars_ == adx_seed_bar) {
+                adx_[lane] = dx_seed_sums_[lane] / static_cast<double>(period);
+            }
+        }
+    }
+}
+
+std::optional<double> BatchADX::Value(std::size_t lane) const {
+    if (!IsReady(lane)) {
+        return std::nullopt;
+    }
+    return adx_[lane];
+}
+
+std::optional<double> BatchADX::PlusDI(std::size_t lane) const {
+    if (!DiReady(lane)) {
+        return std::nullopt;
+    }
+    return plus_di_[lane];
+}
+
+std::optional<double> BatchADX::MinusDI(std::size_t lane) const {
+    if (!DiReady(lane)) {
+        return std::nullopt;
+    }
+    return minus_di_[lane];
+}
+
+std::optional<double> BatchADX::Dx(std::size_t lane) const {
+    if (!DiReady(lane)) {
+        return std::nullopt;
+    }
+    return dx_[lane];
+}
+
+bool BatchADX::IsReady(std::size_t lane) const {
+    return lane < periods_.size() && bars_ >= 2 * static_cast<std::int64_t>(periods_[lane]) - 1;
+}
+
+bool BatchADX::DiReady(std::size_t lane) const {
+    return lane < periods_.size() && bars_ >= periods_[lane];
+}
+
+void BatchADX::Reset() {
+    for (auto* values : {&tr_smoothed_, &plus_dm_smoothed_, &minus_dm_smoothed_, &plus_di_,
+                         &minus_di_, &dx_, &dx_seed_sums_, &adx_}) {
+        std::fill(values->begin(), values->end(), 0.0);
+    }
+    has_prev_bar_ = false;
+    prev_high_ = 0.0;
+    prev_low_ = 0.0;
+    prev_close_ = 0.0;
+    bars_ = 0;
+}
+
+BatchKAMA::BatchKAMA(std::vector<Params> params) {
+    const std::size_t lanes = params.size();
+    er_periods_.reserve(lanes);
+    fast_sc_.reserve(lanes);
+    slow_sc_.reserve(lanes);
+    int max_er_period = 0;
+    for (const Params& lane : params) {
+        if (lane.er_period <= 0 || lane.fast_period <= 0 || lane.slow_period <= 0) {
+            throw std::invalid_argument("KAMA periods must be positive");
+        }
+        er_periods_.push_back(lane.er_period);
+        fast_sc_.push_back(2.0 / static_cast<double>(lane.fast_period + 1));
+        slow_sc_.push_back(2.0 / static_cast<double>(lane.slow_period + 1));
+        max_er_period = std::max(max_er_period, lane.er_period);
+    }
+    volatility_sums_.assign(lanes, 0.0);
+    efficiency_ratios_.assign(lanes, 0.0);
+    kamas_.assign(lanes, 0.0);
+    initialized_.assign(lanes, 0);
+    closes_ = batch_detail::RecentHistory(static_cast<std::size_t>(max_er_period + 1));
+    abs_changes_ = batch_detail::RecentHistory(static_cast<std::size_t>(max_er_period + 1));
+}
+
+void BatchKAMA::Update(double high, double low, double close, double volume) {
+    (void)high;
+    (void)low;
+    (void)volume;
+
+    if (!std::isfinite(close)) {
+        return;
+    }
+
+    const bool has_prev = bars_ > 0;
+    const double abs_change = has_prev ? std::fabs(close - closes_.Back(0)) : 0.0;
+    closes_.Push(close);
+    abs_changes_.Push(abs_change);
+    ++bars_;
+
+    const std::size_t lanes = er_periods_.size();
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        const std::int64_t window = static_cast<std::int64_t>(er_periods_[lane]) + 1;
+        if (has_prev) {
+            volatility_sums_[lane] += abs_change;
+        }
+        if (bars_ > window) {
+            // The change leaving the window is the one into its old second close.
+            volatility_sums_[lane] -= abs_changes_.Back(static_cast<std::size_t>(window - 1));
+            volatility_sums_[lane] = std::max(0.0, volatility_sums_[lane]);
+        }
+        if (bars_ < window) {
+            continue;
+        }
+
+        const double change =
+            std::fabs(close - closes_.Back(static_cast<std::size_t>(window - 1)));
+        const double er = volatility_sums_[lane] > 0.0 ? change / volatility_sums_[lane] : 0.0;
+        efficiency_ratios_[lane] = er;
+
+        if (initialized_[lane] == 0) {
+            double seed_sum = 0.0;
+            for (std::int64_t offset = window - 1; offset >= 0; --offset) {
+                seed_sum += closes_.Back(static_cast<std::size_t>(offset));
+            }
+            kamas_[lane] = seed_sum / static_cast<double>(window);
+            initialized_[lane] = 1;
+            continue;
+        }
+
+        const double smoothing =
+            std::pow(er * (fast_sc_[lane] - slow_sc_[lane]) + slow_sc_[lane], 2.0);
+        kamas_[lane] = kamas_[lane] + smoothing * (close - kamas_[lane]);
+    }
+}
+
+std::optional<double> BatchKAMA::Value(std::size_t lane) const {
+    if (!IsReady(lane)) {
+        return std::nullopt;
+    }
+    return kamas_[lane];
+}
+
+std::optional<double> BatchKAMA::EfficiencyRatio(std::size_t lane) const {
+    if (!IsReady(lane)) {
+        return std::nullopt;
+    }
+    return efficiency_ratios_[lane];
+}
+
+bool BatchKAMA::IsReady(std::size_t lane) const {
+    return lane < er_periods_.size() && initialized_[lane] != 0;
+}
+
+void BatchKAMA::Reset() {
+    std::fill(volatility_sums_.begin(), volatility_sums_.end(), 0.0);
+    std::fill(efficiency_ratios_.begin(), efficiency_ratios_.end(), 0.0);
+    std::fill(kamas_.begin(), kamas_.end(), 0.0);
+    std::fill(initialized_.begin(), initialized_.end(), 0);
+    closes_.Clear();
+    abs_changes_.Clear();
+    bars_ = 0;
+}
+
+}  // namespace quant_hft
@@ -0,0 +1,43 @@
+#include "quant_hft/optim/indicator_sweep.h"
+
+#include <exception>
+#include <string>
+
+#include "quant_hft/strategy/atomic/kama_trend_strategy.h"
+
+namespace quant_hft::optim {
+
+std::shared_ptr<KamaTrendIndicatorBatch> BuildKamaTrendIndicatorBatch(
+    const std::vector<TrialConfigRequest>& requests) {
+    std::vector<KamaTrendIndicatorSpec> specs;
+    for (const TrialConfigRequest& request : requests) {
+        CompositeStrategyDefinition definition;
+        std::string error;
+        if (!ResolveTrialCompositeDefinition(request, &definition, &error)) {
+            continue;
+        }
+        for (const SubStrategyDefinition& sub_strategy : definition.sub_strategies) {
+            if (!sub_strategy.enabled || sub_strategy.type != "KamaTrendStrategy") {
+                continue;
+            }
+            // Backtests run the sub-strategy with its backtest overrides applied.
+            AtomicParams params = sub_strategy.params;
+            for (const auto& [key, value] : sub_strategy.overrides.backtest_params) {
+                params[key] = value;
+            }
+            KamaTrendStrategy strategy;
+            try {
+                strategy.Init(params);
+            } catch (const std::exception&) {
+                continue;
+            }
+            specs.push_back(strategy.IndicatorSpec());
+        }
+    }
+    if (specs.size() < 2) {
+        return nullptr;
+    }
+    return std::make_shared<KamaTrendIndicatorBatch>(std::move(specs));
+}
+
+}  // namespace quant_hft::optim
@@ -1,6 +1,7 @@
 #include "quant_hft/optim/parameter_space.h"
 
 #include "quant_hft/optim/result_analyzer.h"
+#include "quant_hft/optim/successive_halving.h"
 
 #include <algorithm>
 #include <cctype>
@@ -563,6 +564,28 @@ bool SetOptimizationField(const std::string& key,
         config->preserve_top_k_trials = parsed;
         return true;
     }
+    if (key == "halving_eta") {
+        int parsed = 0;
+        if (!ParseInt(value, &parsed)) {
+            if (error != nullptr) {
+                *error = FormatLineError(line_no, "invalid halving_eta int");
+            }
+            return false;
+        }
+        config->halving_eta = parsed;
+        return true;
+    }
+    if (key == "halving_min_fraction") {
+        double parsed = 0.0;
+        if (!ParseDouble(value, &parsed)) {
+            if (error != nullptr) {
+                *error = FormatLineError(line_no, "invalid halving_min_fraction double");
+            }
+            return false;
+        }
+        config->halving_min_fraction = parsed;
+        return true;
+    }
     if (key == "export_heatmap") {
         bool parsed = false;
         if (!ParseBool(value, &parsed)) {
@@ -1110,12 +1133,26 @@ bool LoadParameterSpace(const std::string& yaml_path, ParameterSpace* out, std::
     if (space.optimization.algorithm.empty()) {
         space.optimization.algorithm = "grid";
     }
-    if (space.optimization.algorithm != "grid" && space.optimization.algorithm != "random") {
+    if (space.optimization.algorithm != "grid" && space.optimization.algorithm != "random" &&
+        space.optimization.algorithm != "successive_halving") {
         if (error != nullptr) {
             *error = "unsupported optimization.algorithm: " + space.optimization.algorithm;
         }
         return false;
     }
+    if (space.optimization.halving_eta < 2) {
+        if (error != nullptr) {
+            *error = "optimization.halving_eta must be >= 2";
+        }
+        return false;
+    }
+    if (!(space.optimization.halving_min_fraction > 0.0 &&
+          space.optimization.halving_min_fraction <= 1.0)) {
+        if (error != nullptr) {
+            *error = "optimization.halving_min_fraction must be in (0, 1]";
+        }
+        return false;
+    }
     if (space.optimization.objectives.empty() && space.optimization.metric_path.empty()) {
         space.optimization.metric_path = "hf_standard.profit_factor";
     }
@@ -1153,6 +1190,25 @@ bool LoadParameterSpace(const std::string& yaml_path, ParameterSpace* out, std::
         }
         return false;
     }
+    if (space.optimization.algorithm == "successive_halving") {
+        const auto start_it = space.backtest_args.find("start_date");
+        const auto end_it = space.backtest_args.find("end_date");
+        std::string probe_end_date;
+        std::string range_error;
+        if (start_it == space.backtest_args.end() || end_it == space.backtest_args.end() ||
+            !ResolveFidelityEndDate(start_it->second, end_it->second, 1.0, &probe_end_date,
+                                    &range_error)) {
+            if (error != nullptr) {
+                *error =
+                    "successive_halving requires valid backtest_args.start_date and "
+                    "backtest_args.end_date";
+                if (!range_error.empty()) {
+                    *error += ": " + range_error;
+                }
+            }
+            return false;
+        }
+    }
 
     *out = std::move(space);
     return true;
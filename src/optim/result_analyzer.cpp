@@ -3,14 +3,18 @@
 #include <algorithm>
 #include <cmath>
 #include <cctype>
+#include <cstdint>
 #include <deque>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <iterator>
 #include <limits>
 #include <map>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -612,74 +616,6 @@ bool ExtractTrialMetricsFromValueTree(const Value& root,
     return true;
 }
 
-bool TryExtractDerivedMetric(const Value& root,
-                             const std::string& metric_path,
-                             double* out,
-                             std::string* error) {
-    TrialMetricsSnapshot metrics;
-    std::string metrics_error;
-    if (!ExtractTrialMetricsFromValueTree(root, &metrics, &metrics_error)) {
-        if (error != nullptr) {
-            *error = metrics_error;
-        }
-        return false;
-    }
-
-    if (TryExtractMetricFromSnapshot(metrics, metric_path, out)) {
-        return true;
-    }
-
-    if (metric_path == "hf_standard.risk_metrics.max_drawdown_pct") {
-        const Value* fallback = ResolvePath(root, "summary.max_drawdown", nullptr);
-        if (fallback != nullptr && TryReadNumber(*fallback, out)) {
-            return true;
-        }
-    }
-
-    if (error != nullptr) {
-        *error = "metric path unavailable: " + metric_path;
-        if (!metrics_error.empty()) {
-            *error += " (" + metrics_error + ")";
-        }
-    }
-    return false;
-}
-
-double ExtractMetricFromValueTree(const Value& root,
-                                  const std::string& metric_path,
-                                  std::string* error) {
-    std::string path_error;
-    const Value* current = ResolvePath(root, metric_path, &path_error);
-    if (current != nullptr) {
-        double value = 0.0;
-        if (TryReadNumber(*current, &value)) {
-            if (error != nullptr) {
-                error->clear();
-            }
-            return value;
-        }
-        if (error != nullptr) {
-            *error = "metric path does not resolve to numeric value";
-        }
-        return 0.0;
-    }
-
-    const std::string resolved_metric_path = ResultAnalyzer::ResolveMetricPathAlias(metric_path);
-    double derived_value = 0.0;
-    std::string derived_error;
-    if (TryExtractDerivedMetric(root, resolved_metric_path, &derived_value, &derived_error)) {
-        if (error != nullptr) {
-            error->clear();
-        }
-        return derived_value;
-    }
-
-    if (error != nullptr) {
-        *error = path_error.empty() ? derived_error : path_error;
-    }
-    return 0.0;
-}
-
 bool TryExtractOptionalMetric(const Value& root,
                               const std::string& metric_path,
                               std::optional<double>* out,
@@ -706,58 +642,6 @@ bool TryExtractOptionalMetric(const Value& root,
     return true;
 }
 
-double ComputeObjectiveFromValueTree(const Value& root,
-                                     const OptimizationConfig& config,
-                                     std::string* error) {
-    if (config.objectives.empty()) {
-        return ExtractMetricFromValueTree(root, config.metric_path, error);
-    }
-
-    const bool needs_initial_equity =
-        std::any_of(config.objectives.begin(), config.objectives.end(), [](const auto& objective) {
-            return objective.scale_by_initial_equity;
-        });
-
-    double initial_equity = 0.0;
-    if (needs_initial_equity) {
-        std::string initial_equity_error;
-        initial_equity = ExtractMetricFromValueTree(root, "initial_equity", &initial_equity_error);
-        if (!initial_equity_error.empty()) {
-            if (error != nullptr) {
-                *error = "failed to read initial_equity: " + initial_equity_error;
-            }
-            return 0.0;
-        }
-        if (!(initial_equity > 0.0)) {
-            if (error != nullptr) {
-                *error = "initial_equity must be > 0 when scale_by_initial_equity=true";
-            }
-            return 0.0;
-        }
-    }
-
-    double score = 0.0;
-    for (const OptimizationObjective& objective : config.objectives) {
-        std::string metric_error;
-        double value = ExtractMetricFromValueTree(root, objective.metric_path, &metric_error);
-        if (!metric_error.empty()) {
-            if (error != nullptr) {
-                *error = "objective path `" + objective.metric_path + "`: " + metric_error;
-            }
-            return 0.0;
-        }
-        if (objective.scale_by_initial_equity) {
-            value /= initial_equity;
-        }
-        if (!objective.maximize) {
-            value = -value;
-        }
-        score += objective.weight * value;
-    }
-
-    return score;
-}
-
 std::string LedgerKey(const std::string& symbol, const std::string& side) {
     return symbol + "|" + side;
 }
@@ -1197,11 +1081,13 @@ bool ExtractTradeDerivedMetrics(const Value& root,
     return true;
 }
 
+bool IsFullFidelity(const Trial& trial) { return trial.fidelity.fraction >= 1.0 - 1e-9; }
+
 std::vector<const Trial*> SortedCompletedTrials(const OptimizationReport& report) {
     std::vector<const Trial*> completed;
     completed.reserve(report.trials.size());
     for (const Trial& trial : report.trials) {
-        if (trial.status == "completed") {
+        if (trial.status == "completed" && IsFullFidelity(trial)) {
             completed.push_back(&trial);
         }
     }
@@ -1232,6 +1118,8 @@ void AppendTrialJsonObject(std::ostringstream& json, const Trial& trial, int ind
          << "\",\n"
          << inner << "\"error_msg\": \"" << JsonEscape(trial.error_msg) << "\",\n"
          << inner << "\"metrics_error\": \"" << JsonEscape(trial.metrics_error) << "\",\n"
+         << inner << "\"rung\": " << trial.fidelity.rung << ",\n"
+         << inner << "\"fidelity\": " << FormatDouble(trial.fidelity.fraction) << ",\n"
          << inner << "\"params\": {";
 
     const auto params = SortedParams(trial.params);
@@ -1267,6 +1155,207 @@ void AppendTrialJsonObject(std::ostringstream& json, const Trial& trial, int ind
          << indent << "}";
 }
 
+void FlattenResultFields(const Value& value,
+                         const std::string& path,
+                         std::unordered_map<std::string, TrialResultField>* fields) {
+    TrialResultField field;
+    if (value.IsObject()) {
+        field.kind = TrialResultField::Kind::kObject;
+        for (const auto& [key, child] : value.object_value) {
+            // Keys containing '.' can never be addressed by a dotted metric path.
+            if (key.empty() || key.find('.') != std::string::npos) {
+                continue;
+            }
+            FlattenResultFields(child, path.empty() ? key : path + "." + key, fields);
+        }
+    } else if (TryReadNumber(value, &field.value)) {
+        field.kind = TrialResultField::Kind::kNumber;
+    }
+    (*fields)[path] = field;
+}
+
+enum class RecordLookup {
+    kNumber,
+    kNotNumeric,
+    kMissing,
+};
+
+RecordLookup LookupRecordPath(const TrialResultRecord& record,
+                              const std::string& metric_path,
+                              double* out,
+                              std::string* error) {
+    const std::string resolved_path = ResultAnalyzer::ResolveMetricPathAlias(metric_path);
+    const std::vector<std::string> segments = SplitPath(resolved_path);
+    if (segments.empty()) {
+        if (error != nullptr) {
+            *error = "metric path is empty";
+        }
+        return RecordLookup::kMissing;
+    }
+
+    std::string path;
+    const TrialResultField* current = nullptr;
+    const auto root_it = record.fields.find(path);
+    if (root_it != record.fields.end()) {
+        current = &root_it->second;
+    }
+    for (const std::string& segment : segments) {
+        if (current == nullptr || current->kind != TrialResultField::Kind::kObject) {
+            if (error != nullptr) {
+                *error = "metric path segment `" + segment + "` is not an object parent";
+            }
+            return RecordLookup::kMissing;
+        }
+        path = path.empty() ? segment : path + "." + segment;
+        const auto it = record.fields.find(path);
+        if (it == record.fields.end()) {
+            if (error != nullptr) {
+                *error = "metric path segment not found: " + segment;
+            }
+            return RecordLookup::kMissing;
+        }
+        current = &it->second;
+    }
+
+    if (current->kind != TrialResultField::Kind::kNumber) {
+        if (error != nullptr) {
+            *error = "metric path does not resolve to numeric value";
+        }
+        return RecordLookup::kNotNumeric;
+    }
+    if (out != nullptr) {
+        *out = current->value;
+    }
+    return RecordLookup::kNumber;
+}
+
+// Binary sidecar layout (host byte order, local cache only):
+//   magic[8] version:u32 json_size:u64 json_mtime:i64
+//   snapshot: per optional {present:u8 value:f64|i32}, warnings:str
+//   field_count:u32 then per field {path:str kind:u8 value:f64}
+// where str is {length:u32 bytes}.
+constexpr char kSidecarMagic[8] = {'Q', 'H', 'T', 'R', 'S', 'C', 'A', 'R'};
+constexpr std::uint32_t kSidecarVersion = 1;
+
+template <typename T>
+void WritePod(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(std::istream& in, T* value) {
+    in.read(reinterpret_cast<char*>(value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+void WriteSidecarString(std::ostream& out, const std::string& value) {
+    WritePod(out, static_cast<std::uint32_t>(value.size()));
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+bool ReadSidecarString(std::istream& in, std::string* value) {
+    std::uint32_t size = 0;
+    if (!ReadPod(in, &size)) {
+        return false;
+    }
+    value->resize(size);
+    in.read(value->data(), static_cast<std::streamsize>(size));
+    return static_cast<bool>(in);
+}
+
+template <typename T>
+void WriteSidecarOptional(std::ostream& out, const std::optional<T>& value) {
+    WritePod(out, static_cast<std::uint8_t>(value.has_value() ? 1 : 0));
+    WritePod(out, value.value_or(T{}));
+}
+
+template <typename T>
+bool ReadSidecarOptional(std::istream& in, std::optional<T>* value) {
+    std::uint8_t present = 0;
+    T parsed{};
+    if (!ReadPod(in, &present) || !ReadPod(in, &parsed)) {
+        return false;
+    }
+    *value = present != 0 ? std::optional<T>(parsed) : std::nullopt;
+    return true;
+}
+
+bool StatResultJson(const std::string& json_path, std::uint64_t* size, std::int64_t* mtime) {
+    std::error_code ec;
+    const auto file_size = std::filesystem::file_size(json_path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto write_time = std::filesystem::last_write_time(json_path, ec);
+    if (ec) {
+        return false;
+    }
+    *size = static_cast<std::uint64_t>(file_size);
+    *mtime = static_cast<std::int64_t>(write_time.time_since_epoch().count());
+    return true;
+}
+
+bool ReadTrialResultSidecar(const std::string& json_path, TrialResultRecord* out_record) {
+    std::uint64_t json_size = 0;
+    std::int64_t json_mtime = 0;
+    if (!StatResultJson(json_path, &json_size, &json_mtime)) {
+        return false;
+    }
+    std::ifstream input(ResultAnalyzer::TrialResultSidecarPath(json_path), std::ios::binary);
+    if (!input.is_open()) {
+        return false;
+    }
+
+    char magic[sizeof(kSidecarMagic)] = {};
+    std::uint32_t version = 0;
+    std::uint64_t recorded_size = 0;
+    std::int64_t recorded_mtime = 0;
+    input.read(magic, sizeof(magic));
+    if (!input || !std::equal(std::begin(magic), std::end(magic), std::begin(kSidecarMagic)) ||
+        !ReadPod(input, &version) || version != kSidecarVersion ||
+        !ReadPod(input, &recorded_size) || !ReadPod(input, &recorded_mtime) ||
+        recorded_size != json_size || recorded_mtime != json_mtime) {
+        return false;
+    }
+
+    TrialResultRecord record;
+    TrialMetricsSnapshot& metrics = record.metrics;
+    if (!ReadSidecarOptional(input, &metrics.total_pnl) ||
+        !ReadSidecarOptional(input, &metrics.max_drawdown) ||
+        !ReadSidecarOptional(input, &metrics.max_drawdown_pct) ||
+        !ReadSidecarOptional(input, &metrics.annualized_return_pct) ||
+        !ReadSidecarOptional(input, &metrics.sharpe_ratio) ||
+        !ReadSidecarOptional(input, &metrics.calmar_ratio) ||
+        !ReadSidecarOptional(input, &metrics.profit_factor) ||
+        !ReadSidecarOptional(input, &metrics.win_rate_pct) ||
+        !ReadSidecarOptional(input, &metrics.total_trades) ||
+        !ReadSidecarOptional(input, &metrics.expectancy_r) ||
+        !ReadSidecarString(input, &record.metrics_warnings)) {
+        return false;
+    }
+
+    std::uint32_t field_count = 0;
+    if (!ReadPod(input, &field_count)) {
+        return false;
+    }
+    record.fields.reserve(field_count);
+    for (std::uint32_t index = 0; index < field_count; ++index) {
+        std::string path;
+        std::uint8_t kind = 0;
+        TrialResultField field;
+        if (!ReadSidecarString(input, &path) || !ReadPod(input, &kind) ||
+            kind > static_cast<std::uint8_t>(TrialResultField::Kind::kOther) ||
+            !ReadPod(input, &field.value)) {
+            return false;
+        }
+        field.kind = static_cast<TrialResultField::Kind>(kind);
+        record.fields.emplace(std::move(path), field);
+    }
+
+    *out_record = std::move(record);
+    return true;
+}
+
 }  // namespace
 
 bool ResultAnalyzer::ParseOptimizationConstraint(const std::string& expression,
@@ -1372,55 +1461,41 @@ std::string ResultAnalyzer::ResolveMetricPathAlias(const std::string& metric_pat
 double ResultAnalyzer::ExtractMetricFromJsonText(const std::string& json_text,
                                                  const std::string& metric_path,
                                                  std::string* error) {
-    Value root;
-    if (!quant_hft::simple_json::Parse(json_text, &root, error)) {
+    TrialResultRecord record;
+    if (!DecodeTrialResultJsonText(json_text, &record, error)) {
         return 0.0;
     }
-    return ExtractMetricFromValueTree(root, metric_path, error);
+    return ExtractMetric(record, metric_path, error);
 }
 
 double ResultAnalyzer::ExtractMetricFromJson(const std::string& json_path,
                                              const std::string& metric_path,
                                              std::string* error) {
-    std::ifstream input(json_path);
-    if (!input.is_open()) {
-        if (error != nullptr) {
-            *error = "unable to open trial json: " + json_path;
-        }
+    TrialResultRecord record;
+    if (!LoadTrialResult(json_path, &record, error)) {
         return 0.0;
     }
-
-    std::ostringstream buffer;
-    buffer << input.rdbuf();
-
-    return ExtractMetricFromJsonText(buffer.str(), metric_path, error);
+    return ExtractMetric(record, metric_path, error);
 }
 
 double ResultAnalyzer::ComputeObjectiveFromJsonText(const std::string& json_text,
                                                     const OptimizationConfig& config,
                                                     std::string* error) {
-    Value root;
-    if (!quant_hft::simple_json::Parse(json_text, &root, error)) {
+    TrialResultRecord record;
+    if (!DecodeTrialResultJsonText(json_text, &record, error)) {
         return 0.0;
     }
-    return ComputeObjectiveFromValueTree(root, config, error);
+    return ComputeObjective(record, config, error);
 }
 
 double ResultAnalyzer::ComputeObjectiveFromJson(const std::string& json_path,
                                                 const OptimizationConfig& config,
                                                 std::string* error) {
-    std::ifstream input(json_path);
-    if (!input.is_open()) {
-        if (error != nullptr) {
-            *error = "unable to open trial json: " + json_path;
-        }
+    TrialResultRecord record;
+    if (!LoadTrialResult(json_path, &record, error)) {
         return 0.0;
     }
-
-    std::ostringstream buffer;
-    buffer << input.rdbuf();
-
-    return ComputeObjectiveFromJsonText(buffer.str(), config, error);
+    return ComputeObjective(record, config, error);
 }
 
 bool ResultAnalyzer::ExtractTrialMetricsFromJsonText(const std::string& json_text,
@@ -1433,12 +1508,15 @@ bool ResultAnalyzer::ExtractTrialMetricsFromJsonText(const std::string& json_tex
         return false;
     }
 
-    Value root;
-    if (!quant_hft::simple_json::Parse(json_text, &root, error)) {
+    TrialResultRecord record;
+    if (!DecodeTrialResultJsonText(json_text, &record, error)) {
         return false;
     }
-
-    return ExtractTrialMetricsFromValueTree(root, out_metrics, error);
+    *out_metrics = std::move(record.metrics);
+    if (error != nullptr) {
+        *error = std::move(record.metrics_warnings);
+    }
+    return true;
 }
 
 bool ResultAnalyzer::ExtractTrialMetricsFromJson(const std::string& json_path,
@@ -1451,18 +1529,15 @@ bool ResultAnalyzer::ExtractTrialMetricsFromJson(const std::string& json_path,
         return false;
     }
 
-    std::ifstream input(json_path);
-    if (!input.is_open()) {
-        if (error != nullptr) {
-            *error = "unable to open trial json: " + json_path;
-        }
+    TrialResultRecord record;
+    if (!LoadTrialResult(json_path, &record, error)) {
         return false;
     }
-
-    std::ostringstream buffer;
-    buffer << input.rdbuf();
-
-    return ExtractTrialMetricsFromJsonText(buffer.str(), out_metrics, error);
+    *out_metrics = std::move(record.metrics);
+    if (error != nullptr) {
+        *error = std::move(record.metrics_warnings);
+    }
+    return true;
 }
 
 bool ResultAnalyzer::EvaluateConstraintsFromJsonText(const std::string& json_text,
@@ -1484,30 +1559,273 @@ bool ResultAnalyzer::EvaluateConstraintsFromJsonText(const std::string& json_tex
         return true;
     }
 
+    TrialResultRecord record;
+    if (!DecodeTrialResultJsonText(json_text, &record, error)) {
+        return false;
+    }
+    return EvaluateConstraints(record, config, violations, error);
+}
+
+bool ResultAnalyzer::EvaluateConstraintsFromJson(const std::string& json_path,
+                                                 const OptimizationConfig& config,
+                                                 std::vector<std::string>* violations,
+                                                 std::string* error) {
+    if (violations == nullptr) {
+        if (error != nullptr) {
+            *error = "constraint violations output is null";
+        }
+        return false;
+    }
+    violations->clear();
+
+    if (config.constraints.empty()) {
+        if (error != nullptr) {
+            error->clear();
+        }
+        return true;
+    }
+
+    TrialResultRecord record;
+    if (!LoadTrialResult(json_path, &record, error)) {
+        return false;
+    }
+    return EvaluateConstraints(record, config, violations, error);
+}
+
+bool ResultAnalyzer::DecodeTrialResultJsonText(const std::string& json_text,
+                                               TrialResultRecord* out_record,
+                                               std::string* error) {
+    if (out_record == nullptr) {
+        if (error != nullptr) {
+            *error = "trial result output is null";
+        }
+        return false;
+    }
+
     Value root;
     if (!quant_hft::simple_json::Parse(json_text, &root, error)) {
         return false;
     }
 
-    TrialMetricsSnapshot metrics;
-    std::string metrics_error;
-    if (!ExtractTrialMetricsFromValueTree(root, &metrics, &metrics_error)) {
+    TrialResultRecord record;
+    FlattenResultFields(root, "", &record.fields);
+    if (!ExtractTrialMetricsFromValueTree(root, &record.metrics, &record.metrics_warnings)) {
+        if (error != nullptr) {
+            *error = record.metrics_warnings;
+        }
+        return false;
+    }
+
+    *out_record = std::move(record);
+    if (error != nullptr) {
+        error->clear();
+    }
+    return true;
+}
+
+bool ResultAnalyzer::LoadTrialResult(const std::string& json_path,
+                                     TrialResultRecord* out_record,
+                                     std::string* error) {
+    if (out_record == nullptr) {
+        if (error != nullptr) {
+            *error = "trial result output is null";
+        }
+        return false;
+    }
+
+    if (ReadTrialResultSidecar(json_path, out_record)) {
+        if (error != nullptr) {
+            error->clear();
+        }
+        return true;
+    }
+
+    std::ifstream input(json_path);
+    if (!input.is_open()) {
+        if (error != nullptr) {
+            *error = "unable to open trial json: " + json_path;
+        }
+        return false;
+    }
+
+    std::ostringstream buffer;
+    buffer << input.rdbuf();
+    return DecodeTrialResultJsonText(buffer.str(), out_record, error);
+}
+
+std::string ResultAnalyzer::TrialResultSidecarPath(const std::string& json_path) {
+    return json_path + ".metrics.bin";
+}
+
+bool ResultAnalyzer::WriteTrialResultSidecar(const std::string& json_path,
+                                             const TrialResultRecord& record,
+                                             std::string* error) {
+    std::uint64_t json_size = 0;
+    std::int64_t json_mtime = 0;
+    if (!StatResultJson(json_path, &json_size, &json_mtime)) {
+        if (error != nullptr) {
+            *error = "unable to stat trial json: " + json_path;
+        }
+        return false;
+    }
+
+    const std::string sidecar_path = TrialResultSidecarPath(json_path);
+    std::ofstream out(sidecar_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
         if (error != nullptr) {
-            *error = metrics_error;
+            *error = "unable to open trial result sidecar: " + sidecar_path;
         }
         return false;
     }
 
+    out.write(kSidecarMagic, sizeof(kSidecarMagic));
+    WritePod(out, kSidecarVersion);
+    WritePod(out, json_size);
+    WritePod(out, json_mtime);
+
+    const TrialMetricsSnapshot& metrics = record.metrics;
+    WriteSidecarOptional(out, metrics.total_pnl);
+    WriteSidecarOptional(out, metrics.max_drawdown);
+    WriteSidecarOptional(out, metrics.max_drawdown_pct);
+    WriteSidecarOptional(out, metrics.annualized_return_pct);
+    WriteSidecarOptional(out, metrics.sharpe_ratio);
+    WriteSidecarOptional(out, metrics.calmar_ratio);
+    WriteSidecarOptional(out, metrics.profit_factor);
+    WriteSidecarOptional(out, metrics.win_rate_pct);
+    WriteSidecarOptional(out, metrics.total_trades);
+    WriteSidecarOptional(out, metrics.expectancy_r);
+    WriteSidecarString(out, record.metrics_warnings);
+
+    WritePod(out, static_cast<std::uint32_t>(record.fields.size()));
+    for (const auto& [path, field] : record.fields) {
+        WriteSidecarString(out, path);
+        WritePod(out, static_cast<std::uint8_t>(field.kind));
+        WritePod(out, field.value);
+    }
+
+    out.close();
+    if (!out) {
+        if (error != nullptr) {
+            *error = "failed to write trial result sidecar: " + sidecar_path;
+        }
+        return false;
+    }
+    return true;
+}
+
+double ResultAnalyzer::ExtractMetric(const TrialResultRecord& record,
+                                     const std::string& metric_path,
+                                     std::string* error) {
+    double value = 0.0;
+    std::string path_error;
+    const RecordLookup lookup = LookupRecordPath(record, metric_path, &value, &path_error);
+    if (lookup == RecordLookup::kNumber) {
+        if (error != nullptr) {
+            error->clear();
+        }
+        return value;
+    }
+    if (lookup == RecordLookup::kNotNumeric) {
+        if (error != nullptr) {
+            *error = path_error;
+        }
+        return 0.0;
+    }
+
+    const std::string resolved_metric_path = ResolveMetricPathAlias(metric_path);
+    if (TryExtractMetricFromSnapshot(record.metrics, resolved_metric_path, &value) ||
+        (resolved_metric_path == "hf_standard.risk_metrics.max_drawdown_pct" &&
+         LookupRecordPath(record, "summary.max_drawdown", &value, nullptr) ==
+             RecordLookup::kNumber)) {
+        if (error != nullptr) {
+            error->clear();
+        }
+        return value;
+    }
+
+    if (error != nullptr) {
+        *error = path_error;
+    }
+    return 0.0;
+}
+
+double ResultAnalyzer::ComputeObjective(const TrialResultRecord& record,
+                                        const OptimizationConfig& config,
+                                        std::string* error) {
+    if (config.objectives.empty()) {
+        return ExtractMetric(record, config.metric_path, error);
+    }
+
+    const bool needs_initial_equity =
+        std::any_of(config.objectives.begin(), config.objectives.end(), [](const auto& objective) {
+            return objective.scale_by_initial_equity;
+        });
+    double initial_equity = 0.0;
+    if (needs_initial_equity) {
+        std::string initial_equity_error;
+        initial_equity = ExtractMetric(record, "initial_equity", &initial_equity_error);
+        if (!initial_equity_error.empty()) {
+            if (error != nullptr) {
+                *error = "failed to read initial_equity: " + initial_equity_error;
+            }
+            return 0.0;
+        }
+        if (!(initial_equity > 0.0)) {
+            if (error != nullptr) {
+                *error = "initial_equity must be > 0 when scale_by_initial_equity=true";
+            }
+            return 0.0;
+        }
+    }
+
+    double score = 0.0;
+    for (const OptimizationObjective& objective : config.objectives) {
+        std::string metric_error;
+        double value = ExtractMetric(record, objective.metric_path, &metric_error);
+        if (!metric_error.empty()) {
+            if (error != nullptr) {
+                *error = "objective path `" + objective.metric_path + "`: " + metric_error;
+            }
+            return 0.0;
+        }
+        if (objective.scale_by_initial_equity) {
+            value /= initial_equity;
+        }
+        if (!objective.maximize) {
+            value = -value;
+        }
+        score += objective.weight * value;
+    }
+
+    if (error != nullptr) {
+        error->clear();
+    }
+    return score;
+}
+
+bool ResultAnalyzer::EvaluateConstraints(const TrialResultRecord& record,
+                                         const OptimizationConfig& config,
+                                         std::vector<std::string>* violations,
+                                         std::string* error) {
+    if (violations == nullptr) {
+        if (error != nullptr) {
+            *error = "constraint violations output is null";
+        }
+        return false;
+    }
+    violations->clear();
+
     for (const OptimizationConstraint& constraint : config.constraints) {
         double actual_value = 0.0;
         std::string value_error;
-        if (!TryExtractMetricFromSnapshot(metrics, constraint.metric_path, &actual_value)) {
-            const Value* direct_value = ResolvePath(root, constraint.metric_path, nullptr);
-            if (direct_value != nullptr && TryReadNumber(*direct_value, &actual_value)) {
+        if (!TryExtractMetricFromSnapshot(record.metrics, constraint.metric_path,
+                                          &actual_value)) {
+            if (LookupRecordPath(record, constraint.metric_path, &actual_value, nullptr) ==
+                RecordLookup::kNumber) {
                 // Use the directly recorded metric when present.
             } else if (constraint.metric_name == "max_drawdown_pct") {
-                const Value* fallback = ResolvePath(root, "summary.max_drawdown", nullptr);
-                if (fallback != nullptr && TryReadNumber(*fallback, &actual_value)) {
+                if (LookupRecordPath(record, "summary.max_drawdown", &actual_value, nullptr) ==
+                    RecordLookup::kNumber) {
                     // Older result.json variants may only have summary.max_drawdown.
                 } else {
                     value_error = "metric unavailable: " + constraint.metric_name;
@@ -1520,8 +1838,8 @@ bool ResultAnalyzer::EvaluateConstraintsFromJsonText(const std::string& json_tex
         if (!value_error.empty()) {
             if (error != nullptr) {
                 *error = "constraint `" + constraint.raw_expression + "`: " + value_error;
-                if (!metrics_error.empty()) {
-                    *error += " (" + metrics_error + ")";
+                if (!record.metrics_warnings.empty()) {
+                    *error += " (" + record.metrics_warnings + ")";
                 }
             }
             return false;
@@ -1541,30 +1859,6 @@ bool ResultAnalyzer::EvaluateConstraintsFromJsonText(const std::string& json_tex
     return true;
 }
 
-bool ResultAnalyzer::EvaluateConstraintsFromJson(const std::string& json_path,
-                                                 const OptimizationConfig& config,
-                                                 std::vector<std::string>* violations,
-                                                 std::string* error) {
-    if (violations == nullptr) {
-        if (error != nullptr) {
-            *error = "constraint violations output is null";
-        }
-        return false;
-    }
-
-    std::ifstream input(json_path);
-    if (!input.is_open()) {
-        if (error != nullptr) {
-            *error = "unable to open trial json: " + json_path;
-        }
-        return false;
-    }
-
-    std::ostringstream buffer;
-    buffer << input.rdbuf();
-    return EvaluateConstraintsFromJsonText(buffer.str(), config, violations, error);
-}
-
 OptimizationReport ResultAnalyzer::Analyze(const std::vector<Trial>& trials,
                                            const OptimizationConfig& config,
                                            bool interrupted) {
@@ -1592,7 +1886,11 @@ OptimizationReport ResultAnalyzer::Analyze(const std::vector<Trial>& trials,
                                          : std::numeric_limits<double>::infinity();
 
     for (const Trial& trial : trials) {
-        if (trial.status == "completed") {
+        if (trial.status == "completed" && !IsFullFidelity(trial)) {
+            ++report.completed_trials;
+            ++report.partial_fidelity_trials;
+            report.all_objectives.push_back(trial.objective);
+        } else if (trial.status == "completed") {
             ++report.completed_trials;
             report.all_objectives.push_back(trial.objective);
 
@@ -1666,6 +1964,7 @@ bool ResultAnalyzer::WriteReport(const OptimizationReport& report,
          << "  \"total_trials\": " << report.total_trials << ",\n"
          << "  \"completed_trials\": " << report.completed_trials << ",\n"
          << "  \"failed_trials\": " << report.failed_trials << ",\n"
+         << "  \"partial_fidelity_trials\": " << report.partial_fidelity_trials << ",\n"
          << "  \"constraint_stats\": {\n"
          << "    \"total_violations\": " << report.constraint_stats.total_violations << ",\n"
          << "    \"violated_trials\": [";
@@ -1751,6 +2050,7 @@ bool ResultAnalyzer::WriteReport(const OptimizationReport& report,
        << "- 总试验数: `" << report.total_trials << "`\n"
        << "- 成功: `" << report.completed_trials << "`\n"
        << "- 失败: `" << report.failed_trials << "`\n"
+       << "- 短区间试验: `" << report.partial_fidelity_trials << "`\n"
        << "- 约束违反: `" << report.constraint_stats.total_violations << "`\n"
        << "- 中断: `" << (report.interrupted ? "true" : "false") << "`\n"
        << "- Top10 文件: `" << top10_path << "`\n\n";
@@ -1876,7 +2176,7 @@ bool ResultAnalyzer::WriteHeatmaps(const OptimizationReport& report,
 
         std::map<std::pair<std::size_t, std::size_t>, std::vector<double>> buckets;
         for (const Trial& trial : report.trials) {
-            if (trial.status != "completed") {
+            if (trial.status != "completed" || !IsFullFidelity(trial)) {
                 continue;
             }
 
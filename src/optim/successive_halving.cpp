@@ -0,0 +1,240 @@
+#include "quant_hft/optim/successive_halving.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+#include "quant_hft/optim/random_search.h"
+
+namespace quant_hft::optim {
+namespace {
+
+constexpr double kFullFidelityEps = 1e-9;
+
+bool ParseCivilDate(const std::string& raw, int* year, int* month, int* day) {
+    std::string digits;
+    digits.reserve(raw.size());
+    for (unsigned char ch : raw) {
+        if (std::isdigit(ch) != 0) {
+            digits.push_back(static_cast<char>(ch));
+        }
+    }
+    if (digits.size() != 8) {
+        return false;
+    }
+    *year = std::stoi(digits.substr(0, 4));
+    *month = std::stoi(digits.substr(4, 2));
+    *day = std::stoi(digits.substr(6, 2));
+    return *month >= 1 && *month <= 12 && *day >= 1 && *day <= 31;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date.
+std::int64_t DaysFromCivil(int year, int month, int day) {
+    year -= month <= 2 ? 1 : 0;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const std::int64_t year_of_era = year - era * 400;
+    const std::int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const std::int64_t day_of_era =
+        year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+std::string CivilFromDays(std::int64_t days) {
+    days += 719468;
+    const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const std::int64_t day_of_era = days - era * 146097;
+    const std::int64_t year_of_era =
+        (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const std::int64_t day_of_year =
+        day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const std::int64_t mp = (5 * day_of_year + 2) / 153;
+    const int day = static_cast<int>(day_of_year - (153 * mp + 2) / 5 + 1);
+    const int month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    const int year = static_cast<int>(year_of_era + era * 400 + (month <= 2 ? 1 : 0));
+
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%04d%02d%02d", year, month, day);
+    return buffer;
+}
+
+bool IsBetter(const OptimizationConfig& config, const Trial& left, const Trial& right) {
+    return config.maximize ? (left.objective > right.objective)
+                           : (left.objective < right.objective);
+}
+
+}  // namespace
+
+void SuccessiveHalving::Initialize(const ParameterSpace& space,
+                                   const OptimizationConfig& config) {
+    config_ = config;
+    rung_fractions_.clear();
+    current_rung_ = 0;
+    rung_candidates_.clear();
+    emitted_in_rung_ = 0;
+    rung_results_.clear();
+    results_.clear();
+
+    const int eta = std::max(2, config.halving_eta);
+    double fraction = std::clamp(config.halving_min_fraction, 0.0, 1.0);
+    if (!(fraction > 0.0)) {
+        fraction = 1.0;
+    }
+    while (fraction < 1.0 - kFullFidelityEps) {
+        rung_fractions_.push_back(fraction);
+        fraction *= static_cast<double>(eta);
+    }
+    rung_fractions_.push_back(1.0);
+
+    RandomSearch sampler;
+    sampler.Initialize(space, config);
+    rung_candidates_ = sampler.GetNextBatch(std::max(1, config.max_trials));
+    finished_ = rung_candidates_.empty();
+}
+
+std::vector<ParamValueMap> SuccessiveHalving::GetNextBatch(int batch_size) {
+    if (batch_size <= 0) {
+        batch_size = 1;
+    }
+    if (finished_) {
+        return {};
+    }
+
+    // Promotion needs every result of the rung, so a batch never spans two rungs.
+    const std::size_t remaining = rung_candidates_.size() - emitted_in_rung_;
+    const std::size_t count =
+        std::min<std::size_t>(static_cast<std::size_t>(batch_size), remaining);
+    std::vector<ParamValueMap> batch(rung_candidates_.begin() + emitted_in_rung_,
+                                     rung_candidates_.begin() + emitted_in_rung_ + count);
+    emitted_in_rung_ += count;
+    return batch;
+}
+
+void SuccessiveHalving::AddTrialResult(const Trial& trial) {
+    results_.push_back(trial);
+    if (finished_ || trial.fidelity.rung != static_cast<int>(current_rung_)) {
+        return;
+    }
+    rung_results_.push_back(trial);
+    if (emitted_in_rung_ >= rung_candidates_.size() &&
+        rung_results_.size() >= rung_candidates_.size()) {
+        AdvanceRung();
+    }
+}
+
+void SuccessiveHalving::AdvanceRung() {
+    if (current_rung_ + 1 >= rung_fractions_.size()) {
+        finished_ = true;
+        return;
+    }
+
+    std::vector<const Trial*> completed;
+    completed.reserve(rung_results_.size());
+    for (const Trial& trial : rung_results_) {
+        if (trial.status == "completed") {
+            completed.push_back(&trial);
+        }
+    }
+    if (completed.empty()) {
+        finished_ = true;
+        return;
+    }
+    std::stable_sort(completed.begin(), completed.end(), [this](const Trial* left,
+                                                                const Trial* right) {
+        return IsBetter(config_, *left, *right);
+    });
+
+    const std::size_t eta = static_cast<std::size_t>(std::max(2, config_.halving_eta));
+    const std::size_t keep =
+        std::min(completed.size(), std::max<std::size_t>(1, rung_candidates_.size() / eta));
+    std::vector<ParamValueMap> survivors;
+    survivors.reserve(keep);
+    for (std::size_t index = 0; index < keep; ++index) {
+        survivors.push_back(completed[index]->params);
+    }
+
+    // A lone survivor gains nothing from intermediate slices.
+    current_rung_ = keep == 1 ? rung_fractions_.size() - 1 : current_rung_ + 1;
+    rung_candidates_ = std::move(survivors);
+    emitted_in_rung_ = 0;
+    rung_results_.clear();
+}
+
+bool SuccessiveHalving::IsFinished() const { return finished_; }
+
+std::vector<Trial> SuccessiveHalving::GetAllTrials() const { return results_; }
+
+Trial SuccessiveHalving::GetBestTrial() const {
+    Trial best;
+    bool has_best = false;
+    for (const Trial& trial : results_) {
+        if (trial.status != "completed" ||
+            trial.fidelity.fraction < 1.0 - kFullFidelityEps) {
+            continue;
+        }
+        if (!has_best || IsBetter(config_, trial, best)) {
+            best = trial;
+            has_best = true;
+        }
+    }
+    if (!has_best) {
+        best.status = "failed";
+        best.error_msg = "no completed full-range trial";
+    }
+    return best;
+}
+
+TrialFidelity SuccessiveHalving::CurrentFidelity() const {
+    TrialFidelity fidelity;
+    fidelity.rung = static_cast<int>(current_rung_);
+    fidelity.fraction = rung_fractions_.empty() ? 1.0 : rung_fractions_[current_rung_];
+    return fidelity;
+}
+
+bool ResolveFidelityEndDate(const std::string& start_date,
+                            const std::string& end_date,
+                            double fraction,
+                            std::string* out_end_date,
+                            std::string* error) {
+    if (out_end_date == nullptr) {
+        if (error != nullptr) {
+            *error = "fidelity end date output is null";
+        }
+        return false;
+    }
+    int start_year = 0;
+    int start_month = 0;
+    int start_day = 0;
+    int end_year = 0;
+    int end_month = 0;
+    int end_day = 0;
+    if (!ParseCivilDate(start_date, &start_year, &start_month, &start_day) ||
+        !ParseCivilDate(end_date, &end_year, &end_month, &end_day)) {
+        if (error != nullptr) {
+            *error = "invalid fidelity date range: " + start_date + " .. " + end_date;
+        }
+        return false;
+    }
+
+    const std::int64_t start_days = DaysFromCivil(start_year, start_month, start_day);
+    const std::int64_t end_days = DaysFromCivil(end_year, end_month, end_day);
+    if (end_days < start_days) {
+        if (error != nullptr) {
+            *error = "fidelity date range ends before it starts: " + start_date + " .. " +
+                     end_date;
+        }
+        return false;
+    }
+
+    const double clamped = std::clamp(fraction, 0.0, 1.0);
+    const std::int64_t span_days = end_days - start_days + 1;
+    const std::int64_t kept_days = std::max<std::int64_t>(
+        1, static_cast<std::int64_t>(
+               std::ceil(static_cast<double>(span_days) * clamped - kFullFidelityEps)));
+    *out_end_date = CivilFromDays(start_days + std::min(kept_days, span_days) - 1);
+    return true;
+}
+
+}  // namespace quant_hft::optim
@@ -364,46 +364,37 @@ std::string MakeUniqueSuffix() {
     return std::to_string(now_ns);
 }
 
-}  // namespace
-
-bool GenerateTrialConfig(const TrialConfigRequest& request,
-                         TrialConfigArtifacts* out,
-                         std::string* error) {
-    if (out == nullptr) {
-        if (error != nullptr) {
-            *error = "trial config output is null";
-        }
-        return false;
-    }
-
+bool LoadTrialTarget(const TrialConfigRequest& request, StrategyMainConfig* main_config,
+                     std::size_t* target_index, AtomicParams* target_params,
+                     std::filesystem::path* composite_base_dir, std::string* error) {
     const std::filesystem::path composite_path =
         std::filesystem::absolute(request.composite_config_path).lexically_normal();
-    const std::filesystem::path composite_base_dir = composite_path.parent_path();
+    *composite_base_dir = composite_path.parent_path();
 
-    StrategyMainConfig main_config;
-    if (!LoadStrategyMainConfig(composite_path.string(), &main_config, error)) {
+    if (!LoadStrategyMainConfig(composite_path.string(), main_config, error)) {
         return false;
     }
-    const CompositeStrategyDefinition& definition = main_config.composite;
+    const CompositeStrategyDefinition& definition = main_config->composite;
 
     const std::filesystem::path target_sub_abs =
-        AbsolutePathFrom(composite_base_dir, request.target_sub_config_path).lexically_normal();
+        AbsolutePathFrom(*composite_base_dir, request.target_sub_config_path).lexically_normal();
 
-    std::size_t target_index = definition.sub_strategies.size();
+    *target_index = definition.sub_strategies.size();
     for (std::size_t i = 0; i < definition.sub_strategies.size(); ++i) {
         const SubStrategyDefinition& strategy = definition.sub_strategies[i];
         if (strategy.config_path.empty()) {
             continue;
         }
         const std::filesystem::path strategy_path =
-            AbsolutePathFrom(composite_base_dir, std::filesystem::path(strategy.config_path)).lexically_normal();
+            AbsolutePathFrom(*composite_base_dir, std::filesystem::path(strategy.config_path))
+                .lexically_normal();
         if (strategy_path == target_sub_abs) {
-            target_index = i;
+            *target_index = i;
             break;
         }
     }
 
-    if (target_index >= definition.sub_strategies.size()) {
+    if (*target_index >= definition.sub_strategies.size()) {
         if (error != nullptr) {
             *error = "target_sub_config_path not found in composite.sub_strategies: " +
                      target_sub_abs.string();
@@ -411,14 +402,58 @@ bool GenerateTrialConfig(const TrialConfigRequest& request,
         return false;
     }
 
-    AtomicParams target_params = definition.sub_strategies[target_index].params;
-    if (target_params.empty()) {
-        if (!LoadAtomicParamsFromYaml(target_sub_abs, &target_params, error)) {
+    *target_params = definition.sub_strategies[*target_index].params;
+    if (target_params->empty()) {
+        if (!LoadAtomicParamsFromYaml(target_sub_abs, target_params, error)) {
             return false;
         }
     }
     for (const auto& [key, value] : request.param_overrides) {
-        target_params[key] = ToScalarString(value);
+        (*target_params)[key] = ToScalarString(value);
+    }
+    return true;
+}
+
+}  // namespace
+
+bool ResolveTrialCompositeDefinition(const TrialConfigRequest& request,
+                                     CompositeStrategyDefinition* out, std::string* error) {
+    if (out == nullptr) {
+        if (error != nullptr) {
+            *error = "trial composite output is null";
+        }
+        return false;
+    }
+    StrategyMainConfig main_config;
+    std::size_t target_index = 0;
+    AtomicParams target_params;
+    std::filesystem::path composite_base_dir;
+    if (!LoadTrialTarget(request, &main_config, &target_index, &target_params,
+                         &composite_base_dir, error)) {
+        return false;
+    }
+    *out = std::move(main_config.composite);
+    out->sub_strategies[target_index].params = std::move(target_params);
+    return true;
+}
+
+bool GenerateTrialConfig(const TrialConfigRequest& request,
+                         TrialConfigArtifacts* out,
+                         std::string* error) {
+    if (out == nullptr) {
+        if (error != nullptr) {
+            *error = "trial config output is null";
+        }
+        return false;
+    }
+
+    StrategyMainConfig main_config;
+    std::size_t target_index = 0;
+    AtomicParams target_params;
+    std::filesystem::path composite_base_dir;
+    if (!LoadTrialTarget(request, &main_config, &target_index, &target_params,
+                         &composite_base_dir, error)) {
+        return false;
     }
 
     const std::string trial_id = request.trial_id.empty() ? "trial" : request.trial_id;
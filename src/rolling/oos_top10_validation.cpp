@@ -1,6 +1,7 @@
 #include "quant_hft/rolling/oos_top10_validation.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
@@ -11,6 +12,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -981,6 +983,78 @@ BacktestCliResult BuildResultForWrite(const BacktestCliResult& source,
     return result;
 }
 
+// A candidate whose OOS spec is prepared and only needs its backtest run.
+struct PendingValidationRun {
+    std::size_t row_index{0};
+    BacktestCliSpec spec;
+    std::filesystem::path row_dir;
+};
+
+// Runs one candidate and records its outcome in `row`. Touches only the candidate's own row
+// and directory, so candidates may run concurrently.
+void RunValidationCandidate(const OosBacktestRunFn& run_fn, const PendingValidationRun& pending,
+                            OosTop10ValidationRow* row) {
+    std::string row_error;
+    BacktestCliResult run_result;
+    if (!run_fn(pending.spec, &run_result, &row_error)) {
+        row->status = "failed";
+        row->error_msg = row_error;
+        (void)quant_hft::apps::WriteTextFile((pending.row_dir / "error.txt").string(), row_error,
+                                             nullptr);
+        return;
+    }
+
+    const BacktestCliResult persisted_result = BuildResultForWrite(run_result, pending.spec);
+    const std::string result_json_text = quant_hft::apps::RenderBacktestJson(persisted_result);
+    if (!quant_hft::apps::WriteTextFile(row->result_json_path, result_json_text, &row_error)) {
+        row->status = "failed";
+        row->error_msg = row_error;
+        return;
+    }
+
+    TrialMetricsSnapshot extracted_metrics;
+    if (!ResultAnalyzer::ExtractTrialMetricsFromJson(row->result_json_path, &extracted_metrics,
+                                                     &row_error)) {
+        row->status = "failed";
+        row->error_msg = row_error;
+        return;
+    }
+
+    PopulateOosMetrics(extracted_metrics, row);
+    row->success = true;
+    row->status = "completed";
+}
+
+void RunValidationCandidates(const OosBacktestRunFn& run_fn, int parallelism,
+                             const std::vector<PendingValidationRun>& pending_runs,
+                             std::vector<OosTop10ValidationRow>* rows) {
+    const std::size_t worker_count =
+        std::min(static_cast<std::size_t>(std::max(parallelism, 1)), pending_runs.size());
+    if (worker_count <= 1) {
+        for (const PendingValidationRun& pending : pending_runs) {
+            RunValidationCandidate(run_fn, pending, &(*rows)[pending.row_index]);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next_run{0};
+    const auto worker = [&]() {
+        for (std::size_t index = next_run.fetch_add(1); index < pending_runs.size();
+             index = next_run.fetch_add(1)) {
+            const PendingValidationRun& pending = pending_runs[index];
+            RunValidationCandidate(run_fn, pending, &(*rows)[pending.row_index]);
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (std::size_t index = 0; index < worker_count; ++index) {
+        workers.emplace_back(worker);
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+}
+
 }  // namespace
 
 bool RunOosTop10Validation(const OosTop10ValidationRequest& request,
@@ -1007,6 +1081,12 @@ bool RunOosTop10Validation(const OosTop10ValidationRequest& request,
         }
         return false;
     }
+    if (request.parallelism <= 0) {
+        if (error != nullptr) {
+            *error = "parallelism must be positive";
+        }
+        return false;
+    }
 
     const std::filesystem::path train_report_json =
         ToAbsoluteNormalized(std::filesystem::path(request.train_report_json));
@@ -1047,10 +1127,15 @@ bool RunOosTop10Validation(const OosTop10ValidationRequest& request,
     }
 
     OosBacktestRunFn effective_run_fn = std::move(run_fn);
+    // Every candidate replays the same OOS window, so the default runner loads the ticks once
+    // and shares them across candidates.
+    quant_hft::apps::ReplayDatasetCache dataset_cache;
     if (!effective_run_fn) {
-        effective_run_fn = [](const BacktestCliSpec& spec, BacktestCliResult* out,
-                              std::string* run_error) {
-            return quant_hft::apps::RunBacktestSpec(spec, out, run_error);
+        effective_run_fn = [&dataset_cache](const BacktestCliSpec& spec, BacktestCliResult* out,
+                                            std::string* run_error) {
+            const auto dataset = dataset_cache.Get(spec, run_error);
+            return dataset != nullptr &&
+                   quant_hft::apps::RunBacktestSpecOnDataset(spec, *dataset, out, run_error);
         };
     }
 
@@ -1066,6 +1151,7 @@ bool RunOosTop10Validation(const OosTop10ValidationRequest& request,
     report->failed_count = 0;
     report->rows.clear();
     report->rows.reserve(static_cast<std::size_t>(report->selected_count));
+    std::vector<PendingValidationRun> pending_runs;
 
     for (int index = 0; index < report->selected_count; ++index) {
         const RankedTrial& trial = ranked_trials[static_cast<std::size_t>(index)];
@@ -1083,7 +1169,6 @@ bool RunOosTop10Validation(const OosTop10ValidationRequest& request,
         if (archived_dir.empty()) {
             row.status = "failed";
             row.error_msg = "missing archived trial directory for " + trial.trial_id;
-            ++report->failed_count;
             report->rows.push_back(std::move(row));
             continue;
         }
@@ -1102,7 +1187,6 @@ bool RunOosTop10Validation(const OosTop10ValidationRequest& request,
             row.success = true;
             row.reused_existing = true;
             row.status = "cached";
-            ++report->success_count;
             report->rows.push_back(std::move(row));
             continue;
         }
@@ -1112,7 +1196,6 @@ bool RunOosTop10Validation(const OosTop10ValidationRequest& request,
         if (!RewriteCompositeConfig(archived_dir, row_dir, &composite_path, &row_error)) {
             row.status = "failed";
             row.error_msg = row_error;
-            ++report->failed_count;
             report->rows.push_back(std::move(row));
             continue;
         }
@@ -1121,7 +1204,6 @@ bool RunOosTop10Validation(const OosTop10ValidationRequest& request,
         if (!LoadArchivedBacktestSpec(archived_dir / "result.json", &spec, &row_error)) {
             row.status = "failed";
             row.error_msg = row_error;
-            ++report->failed_count;
             report->rows.push_back(std::move(row));
             continue;
         }
@@ -1140,42 +1222,21 @@ bool RunOosTop10Validation(const OosTop10ValidationRequest& request,
                 (row_dir / "sub_strategy_indicator_trace.csv").string();
         }
 
-        BacktestCliResult run_result;
-        if (!effective_run_fn(spec, &run_result, &row_error)) {
-            row.status = "failed";
-            row.error_msg = row_error;
-            (void)quant_hft::apps::WriteTextFile((row_dir / "error.txt").string(), row_error,
-                                                 nullptr);
-            ++report->failed_count;
-            report->rows.push_back(std::move(row));
-            continue;
-        }
-
-        const BacktestCliResult persisted_result = BuildResultForWrite(run_result, spec);
-        const std::string result_json_text = quant_hft::apps::RenderBacktestJson(persisted_result);
-        if (!quant_hft::apps::WriteTextFile(result_json_path.string(), result_json_text,
-                                            &row_error)) {
-            row.status = "failed";
-            row.error_msg = row_error;
-            ++report->failed_count;
-            report->rows.push_back(std::move(row));
-            continue;
-        }
+        PendingValidationRun pending;
+        pending.row_index = report->rows.size();
+        pending.spec = std::move(spec);
+        pending.row_dir = row_dir;
+        pending_runs.push_back(std::move(pending));
+        report->rows.push_back(std::move(row));
+    }
 
-        if (!ResultAnalyzer::ExtractTrialMetricsFromJson(result_json_path.string(),
-                                                         &extracted_metrics, &row_error)) {
-            row.status = "failed";
-            row.error_msg = row_error;
+    RunValidationCandidates(effective_run_fn, request.parallelism, pending_runs, &report->rows);
+    for (const OosTop10ValidationRow& row : report->rows) {
+        if (row.success) {
+            ++report->success_count;
+        } else {
             ++report->failed_count;
-            report->rows.push_back(std::move(row));
-            continue;
         }
-
-        PopulateOosMetrics(extracted_metrics, &row);
-        row.success = true;
-        row.status = "completed";
-        ++report->success_count;
-        report->rows.push_back(std::move(row));
     }
 
     const std::string csv_text = RenderCsv(*report);
@@ -21,6 +21,7 @@
 
 #include "quant_hft/apps/cli_support.h"
 #include "quant_hft/optim/grid_search.h"
+#include "quant_hft/optim/indicator_sweep.h"
 #include "quant_hft/optim/random_search.h"
 #include "quant_hft/optim/parameter_space.h"
 #include "quant_hft/optim/result_analyzer.h"
@@ -38,6 +39,7 @@ using quant_hft::apps::RunBacktestSpec;
 using quant_hft::apps::SummarizeBacktest;
 using quant_hft::apps::UnixEpochMillisNow;
 using quant_hft::apps::WriteTextFile;
+using quant_hft::optim::BuildKamaTrendIndicatorBatch;
 using quant_hft::optim::GridSearch;
 using quant_hft::optim::IOptimizationAlgorithm;
 using quant_hft::optim::LoadParameterSpace;
@@ -563,6 +565,16 @@ WindowResult RunOptimizedWindow(const RollingConfig& config,
     TaskScheduler scheduler(SafeMaxConcurrent(opt_config.batch_size));
     TempArtifactManager artifact_manager;
     std::atomic<int> trial_counter{0};
+    // Indicators shared by the KamaTrendStrategy trials of the running batch.
+    std::shared_ptr<KamaTrendIndicatorBatch> indicator_batch;
+
+    auto make_request = [&](const ParamValueMap& params) {
+        TrialConfigRequest request;
+        request.composite_config_path = space.composite_config_path;
+        request.target_sub_config_path = space.target_sub_config_path;
+        request.param_overrides = params.values;
+        return request;
+    };
 
     auto trial_task = [&](const ParamValueMap& params) -> Trial {
         Trial trial;
@@ -570,11 +582,9 @@ WindowResult RunOptimizedWindow(const RollingConfig& config,
         trial.trial_id = "window_" + std::to_string(window.index) + "_trial_" +
                          std::to_string(trial_index + 1);
         trial.params = params;
+        const KamaTrendIndicatorBatch::Scope indicator_scope(indicator_batch);
 
-        TrialConfigRequest request;
-        request.composite_config_path = space.composite_config_path;
-        request.target_sub_config_path = space.target_sub_config_path;
-        request.param_overrides = params.values;
+        TrialConfigRequest request = make_request(params);
         request.trial_id = trial.trial_id;
 
         TrialConfigArtifacts artifacts;
@@ -644,12 +654,22 @@ WindowResult RunOptimizedWindow(const RollingConfig& config,
         if (g_interrupted.load()) {
             break;
         }
-        std::vector<ParamValueMap> batch = algorithm->GetNextBatch(scheduler.max_concurrent());
+        // The whole configured batch shares one indicator pass; the scheduler caps only how many
+        // of its trials run at once.
+        std::vector<ParamValueMap> batch =
+            algorithm->GetNextBatch(std::max(1, opt_config.batch_size));
         if (batch.empty()) {
             break;
         }
 
+        std::vector<TrialConfigRequest> requests;
+        requests.reserve(batch.size());
+        for (const ParamValueMap& params : batch) {
+            requests.push_back(make_request(params));
+        }
+        indicator_batch = BuildKamaTrendIndicatorBatch(requests);
         std::vector<Trial> results = scheduler.RunBatch(batch, trial_task);
+        indicator_batch.reset();
         for (Trial& trial : results) {
             if (!trial.working_dir.empty()) {
                 if (config.output.keep_temp_files || trial.status != "completed") {
@@ -6,7 +6,6 @@
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
-#include <fstream>
 #include <limits>
 #include <sstream>
 #include <unordered_map>
@@ -116,187 +115,6 @@ bool ParsePersistenceBool(const BarAggregator::PersistenceState& state, const st
 
 bool IsFinitePositive(double value) { return std::isfinite(value) && value > 0.0; }
 
-std::string InferExchangeIdFromDottedInstrument(const std::string& instrument_id) {
-    const auto dot_pos = instrument_id.find('.');
-    if (dot_pos == std::string::npos || dot_pos == 0) {
-        return "";
-    }
-    return instrument_id.substr(0, dot_pos);
-}
-
-std::string ExtractInstrumentSymbol(const std::string& instrument_id) {
-    const auto dot_pos = instrument_id.find('.');
-    if (dot_pos == std::string::npos || dot_pos + 1 >= instrument_id.size()) {
-        return instrument_id;
-    }
-    return instrument_id.substr(dot_pos + 1);
-}
-
-std::string ToUpperAscii(std::string value) {
-    std::transform(value.begin(), value.end(), value.begin(),
-                   [](unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
-    return value;
-}
-
-std::string Trim(const std::string& value) {
-    std::size_t start = 0;
-    while (start < value.size() && std::isspace(static_cast<unsigned char>(value[start])) != 0) {
-        ++start;
-    }
-    std::size_t end = value.size();
-    while (end > start && std::isspace(static_cast<unsigned char>(value[end - 1])) != 0) {
-        --end;
-    }
-    return value.substr(start, end - start);
-}
-
-std::string RemoveInlineComment(const std::string& value) {
-    bool in_quotes = false;
-    for (std::size_t i = 0; i < value.size(); ++i) {
-        const char ch = value[i];
-        if (ch == '"') {
-            in_quotes = !in_quotes;
-            continue;
-        }
-        if (ch == '#' && !in_quotes) {
-            return Trim(value.substr(0, i));
-        }
-    }
-    return Trim(value);
-}
-
-std::string NormalizeYamlValue(std::string value) {
-    value = Trim(value);
-    if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
-        value = value.substr(1, value.size() - 2);
-    }
-    if (value == "null" || value == "NULL" || value == "~") {
-        return "";
-    }
-    return value;
-}
-
-bool StartsWith(const std::string& value, const std::string& prefix) {
-    if (prefix.size() > value.size()) {
-        return false;
-    }
-    return std::equal(prefix.begin(), prefix.end(), value.begin());
-}
-
-bool ParseYamlKeyValue(const std::string& line, std::string* key, std::string* value) {
-    if (key == nullptr || value == nullptr) {
-        return false;
-    }
-    const auto colon_pos = line.find(':');
-    if (colon_pos == std::string::npos) {
-        return false;
-    }
-    *key = Trim(line.substr(0, colon_pos));
-    *value = NormalizeYamlValue(RemoveInlineComment(line.substr(colon_pos + 1)));
-    return !key->empty();
-}
-
-bool ParseSessionTimeToMinute(const std::string& raw, int* minute_of_day) {
-    if (minute_of_day == nullptr || (raw.size() != 5 && raw.size() != 8) || raw[2] != ':') {
-        return false;
-    }
-    if (!std::isdigit(static_cast<unsigned char>(raw[0])) ||
-        !std::isdigit(static_cast<unsigned char>(raw[1])) ||
-        !std::isdigit(static_cast<unsigned char>(raw[3])) ||
-        !std::isdigit(static_cast<unsigned char>(raw[4]))) {
-        return false;
-    }
-    if (raw.size() == 8 && (raw[5] != ':' || !std::isdigit(static_cast<unsigned char>(raw[6])) ||
-                            !std::isdigit(static_cast<unsigned char>(raw[7])))) {
-        return false;
-    }
-    const int hour = (raw[0] - '0') * 10 + (raw[1] - '0');
-    const int minute = (raw[3] - '0') * 10 + (raw[4] - '0');
-    const int second = raw.size() == 8 ? (raw[6] - '0') * 10 + (raw[7] - '0') : 0;
-    if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59) {
-        return false;
-    }
-    *minute_of_day = hour * 60 + minute;
-    return true;
-}
-
-bool ParseSessionRange(const std::string& raw, BarAggregator::SessionInterval* interval) {
-    if (interval == nullptr || raw.empty()) {
-        return false;
-    }
-    const auto dash_pos = raw.find('-');
-    if (dash_pos == std::string::npos) {
-        return false;
-    }
-    const auto left = Trim(raw.substr(0, dash_pos));
-    const auto right = Trim(raw.substr(dash_pos + 1));
-    int start = 0;
-    int end = 0;
-    if (!ParseSessionTimeToMinute(left, &start) || !ParseSessionTimeToMinute(right, &end)) {
-        return false;
-    }
-    interval->start_minute = start;
-    interval->end_minute = end;
-    return true;
-}
-
-bool ParseSessionRanges(const std::string& raw,
-                        std::vector<BarAggregator::SessionInterval>* intervals) {
-    if (intervals == nullptr || raw.empty()) {
-        return false;
-    }
-    std::vector<BarAggregator::SessionInterval> parsed;
-    std::size_t start = 0;
-    while (start <= raw.size()) {
-        const auto comma_pos = raw.find(',', start);
-        const auto token = Trim(raw.substr(
-            start, comma_pos == std::string::npos ? std::string::npos : comma_pos - start));
-        if (!token.empty()) {
-            BarAggregator::SessionInterval interval;
-            if (!ParseSessionRange(token, &interval)) {
-                return false;
-            }
-            parsed.push_back(interval);
-        }
-        if (comma_pos == std::string::npos) {
-            break;
-        }
-        start = comma_pos + 1;
-    }
-    if (parsed.empty()) {
-        return false;
-    }
-    intervals->insert(intervals->end(), parsed.begin(), parsed.end());
-    return true;
-}
-
-bool IsMinuteInInterval(const BarAggregator::SessionInterval& interval, int minute_of_day) {
-    if (interval.start_minute < interval.end_minute) {
-        return minute_of_day >= interval.start_minute && minute_of_day < interval.end_minute;
-    }
-    if (interval.start_minute > interval.end_minute) {
-        return minute_of_day >= interval.start_minute || minute_of_day < interval.end_minute;
-    }
-    return false;
-}
-
-int PreviousMinuteOfDay(int minute_of_day) {
-    constexpr int kMinutesPerDay = 24 * 60;
-    return (minute_of_day + kMinutesPerDay - 1) % kMinutesPerDay;
-}
-
-bool IsLastMinuteInInterval(const BarAggregator::SessionInterval& interval, int minute_of_day) {
-    // The last in-session minute (e.g. 14:59 for a PM session ending at 15:00)
-    if (IsMinuteInInterval(interval, minute_of_day) &&
-        minute_of_day == PreviousMinuteOfDay(interval.end_minute)) {
-        return true;
-    }
-    // The end_minute itself (e.g. 15:00): the exchange sends a closing tick at
-    // exactly the end time. Although this minute is outside IsMinuteInInterval
-    // (exclusive upper bound), it forms a real bar with closing-auction data.
-    return minute_of_day == interval.end_minute;
-}
-
 bool ParseSecondOfMinute(const std::string& update_time, int* second) {
     if (second == nullptr) {
         return false;
@@ -355,56 +173,6 @@ bool ParsePhysicalTimestamp(const std::string& action_day, const std::string& up
     return true;
 }
 
-int SessionOrderKey(const BarAggregator::SessionInterval& interval) {
-    if (interval.start_minute > interval.end_minute || interval.start_minute >= 18 * 60) {
-        return interval.start_minute - 24 * 60;
-    }
-    return interval.start_minute;
-}
-
-std::string FormatSessionKey(const BarAggregator::SessionInterval& interval) {
-    return std::to_string(interval.start_minute) + "-" + std::to_string(interval.end_minute);
-}
-
-std::unordered_map<std::string, std::vector<BarAggregator::SessionRule>> BuildDefaultRules() {
-    using SessionInterval = BarAggregator::SessionInterval;
-    using SessionRule = BarAggregator::SessionRule;
-
-    auto with_intervals = [](std::initializer_list<SessionInterval> ranges,
-                             const std::string& instrument_prefix = "",
-                             const std::string& product = "") {
-        SessionRule rule;
-        rule.instrument_prefix = instrument_prefix;
-        rule.product = product;
-        rule.intervals = ranges;
-        return rule;
-    };
-
-    const SessionInterval commodity_morning_1{9 * 60, 10 * 60 + 15};
-    const SessionInterval commodity_morning_2{10 * 60 + 30, 11 * 60 + 30};
-    const SessionInterval commodity_afternoon{13 * 60 + 30, 15 * 60};
-    const SessionInterval cffex_morning{9 * 60 + 30, 11 * 60 + 30};
-    const SessionInterval cffex_afternoon{13 * 60, 15 * 60};
-    const SessionInterval cffex_treasury_afternoon{13 * 60, 15 * 60 + 15};
-
-    std::unordered_map<std::string, std::vector<SessionRule>> rules;
-    rules["SHFE"].push_back(
-        with_intervals({commodity_morning_1, commodity_morning_2, commodity_afternoon,
-                        SessionInterval{21 * 60, 1 * 60}}));
-    rules["DCE"].push_back(
-        with_intervals({commodity_morning_1, commodity_morning_2, commodity_afternoon,
-                        SessionInterval{21 * 60, 23 * 60}}));
-    rules["CFFEX"].push_back(with_intervals({cffex_morning, cffex_afternoon}));
-    rules["CFFEX"].push_back(with_intervals({cffex_morning, cffex_treasury_afternoon}, "T"));
-    rules["CFFEX"].push_back(with_intervals({cffex_morning, cffex_treasury_afternoon}, "TF"));
-    rules["CFFEX"].push_back(with_intervals({cffex_morning, cffex_treasury_afternoon}, "TS"));
-    rules["CFFEX"].push_back(with_intervals({cffex_morning, cffex_treasury_afternoon}, "TL"));
-    rules["*"].push_back(with_intervals({commodity_morning_1, commodity_morning_2,
-                                         SessionInterval{13 * 60 + 30, 15 * 60 + 15},
-                                         SessionInterval{21 * 60, 2 * 60 + 30}}));
-    return rules;
-}
-
 bool ParseMinuteValue(const std::string& minute_key, std::string* trading_day, int* minute_of_day) {
     if (trading_day == nullptr || minute_of_day == nullptr || minute_key.size() < 14) {
         return false;
@@ -446,17 +214,6 @@ std::string FormatMinuteValue(const std::string& trading_day, int minute_of_day)
     return std::string(buffer);
 }
 
-std::string FormatTimeOfDay(int minute_of_day) {
-    if (minute_of_day < 0 || minute_of_day >= 24 * 60) {
-        return "";
-    }
-    const int hour = minute_of_day / 60;
-    const int minute = minute_of_day % 60;
-    char buffer[8];
-    std::snprintf(buffer, sizeof(buffer), "%02d:%02d", hour, minute);
-    return std::string(buffer);
-}
-
 std::string BuildClosedBoundaryMinuteKey(const std::string& instrument_id,
                                          const std::string& minute_key) {
     if (instrument_id.empty() || minute_key.empty()) {
@@ -469,12 +226,8 @@ std::string BuildClosedBoundaryMinuteKey(const std::string& instrument_id,
 
 BarAggregator::BarAggregator(BarAggregatorConfig config)
     : config_(std::move(config)),
-      session_rules_by_exchange_(
-          config_.use_default_session_fallback
-              ? BuildDefaultRules()
-              : std::unordered_map<std::string, std::vector<SessionRule>>{}) {
-    LoadTradingSessions();
-}
+      sessions_(CompiledSessionCalendar::Shared(config_.trading_sessions_config_path,
+                                                config_.use_default_session_fallback)) {}
 
 bool BarAggregator::ShouldProcessSnapshot(const MarketSnapshot& snapshot) const {
     if (snapshot.instrument_id.empty() || snapshot.update_time.size() < 5 ||
@@ -488,12 +241,14 @@ bool BarAggregator::ShouldProcessSnapshot(const MarketSnapshot& snapshot) const
     }
 
     if (config_.filter_non_trading_ticks) {
-        const std::string exchange_id = ResolveExchangeId(snapshot);
-        const std::string product = ResolveProductCode(snapshot);
-        if (!IsInTradingSession(exchange_id, snapshot.instrument_id, product,
-                                snapshot.update_time) &&
-            !IsExactSessionEndTime(exchange_id, snapshot.instrument_id, product,
-                                   snapshot.update_time)) {
+        int minute_of_day = 0;
+        if (!CompiledSessionCalendar::ParseMinuteOfDay(snapshot.update_time, &minute_of_day)) {
+            return false;
+        }
+        const auto* schedule =
+            sessions_->ResolveInstrument(snapshot.exchange_id, snapshot.instrument_id);
+        if (schedule == nullptr || (!schedule->IsOpen(minute_of_day) &&
+                                    !IsExactSessionEndTime(*schedule, snapshot.update_time))) {
             return false;
         }
     }
@@ -510,10 +265,10 @@ std::vector<BarSnapshot> BarAggregator::OnMarketSnapshot(const MarketSnapshot& s
     const auto trading_day = ResolveTradingDay(snapshot);
     const auto action_day = ResolveActionDay(snapshot);
     const auto minute_key = BuildMinuteKey(trading_day, snapshot.update_time);
-    const bool is_exact_session_end =
-        !snapshot.instrument_id.empty() && !minute_key.empty() &&
-        IsExactSessionEndTime(exchange_id, snapshot.instrument_id, ResolveProductCode(snapshot),
-                              snapshot.update_time);
+    const auto* schedule = sessions_->ResolveInstrument(exchange_id, snapshot.instrument_id);
+    const bool is_exact_session_end = !snapshot.instrument_id.empty() && !minute_key.empty() &&
+                                      schedule != nullptr &&
+                                      IsExactSessionEndTime(*schedule, snapshot.update_time);
 
     if (minute_key.empty()) {
         return emitted;
@@ -1064,88 +819,59 @@ std::vector<BarSnapshot> BarAggregator::AggregateFromOneMinute(
 
 bool BarAggregator::IsInTradingSession(const std::string& exchange_id,
                                        const std::string& update_time) const {
-    return IsInTradingSession(exchange_id, "", "", update_time);
+    int minute_of_day = 0;
+    if (!CompiledSessionCalendar::ParseMinuteOfDay(update_time, &minute_of_day)) {
+        return false;
+    }
+    const auto* schedule = sessions_->Resolve(exchange_id, "", "");
+    return schedule != nullptr && schedule->IsOpen(minute_of_day);
 }
 
 bool BarAggregator::IsSessionEndMinute(const std::string& exchange_id,
                                        const std::string& instrument_id,
                                        const std::string& update_time) const {
     int minute_of_day = 0;
-    if (!ParseMinuteOfDay(update_time, &minute_of_day)) {
+    if (!CompiledSessionCalendar::ParseMinuteOfDay(update_time, &minute_of_day)) {
         return false;
     }
-
-    MarketSnapshot snapshot;
-    snapshot.instrument_id = instrument_id;
-
-    SessionInterval interval;
-    const std::string resolved_exchange =
-        exchange_id.empty() ? InferExchangeId(instrument_id) : exchange_id;
-    if (ResolveSessionInterval(resolved_exchange, instrument_id, ResolveProductCode(snapshot),
-                               update_time, &interval)) {
-        return IsLastMinuteInInterval(interval, minute_of_day);
+    const auto* schedule = sessions_->ResolveInstrument(exchange_id, instrument_id);
+    if (schedule == nullptr) {
+        return false;
     }
-    // ResolveSessionInterval uses an exclusive upper bound, so ticks at exactly
-    // end_minute (e.g. 15:00, 23:00, 11:30, 10:15) are not matched by it. Check
-    // directly whether the minute equals any session's end_minute.
-    return IsExactSessionEndTime(resolved_exchange, instrument_id, ResolveProductCode(snapshot),
-                                 update_time);
+    if (schedule->IsOpen(minute_of_day)) {
+        return schedule->IsLastMinute(minute_of_day);
+    }
+    // Intervals have an exclusive upper bound, so ticks at exactly end_minute (e.g. 15:00,
+    // 23:00, 11:30, 10:15) are not inside any of them.
+    return IsExactSessionEndTime(*schedule, update_time);
 }
 
 std::string BarAggregator::ResolveSessionKey(const std::string& exchange_id,
                                              const std::string& instrument_id,
                                              const std::string& update_time) const {
-    MarketSnapshot snapshot;
-    snapshot.instrument_id = instrument_id;
-
-    SessionInterval interval;
-    const std::string resolved_exchange =
-        exchange_id.empty() ? InferExchangeId(instrument_id) : exchange_id;
-    if (!ResolveSessionInterval(resolved_exchange, instrument_id, ResolveProductCode(snapshot),
-                                update_time, &interval)) {
+    int minute_of_day = 0;
+    if (!CompiledSessionCalendar::ParseMinuteOfDay(update_time, &minute_of_day)) {
         return "";
     }
-    return FormatSessionKey(interval);
+    const auto* schedule = sessions_->ResolveInstrument(exchange_id, instrument_id);
+    const auto* interval = schedule == nullptr ? nullptr : schedule->IntervalAt(minute_of_day);
+    return interval == nullptr ? "" : CompiledSessionCalendar::FormatSessionKey(*interval);
 }
 
 int BarAggregator::ResolveSessionOrder(const std::string& exchange_id,
                                        const std::string& instrument_id,
                                        const std::string& update_time) const {
-    MarketSnapshot snapshot;
-    snapshot.instrument_id = instrument_id;
-
-    SessionInterval interval;
-    const std::string resolved_exchange =
-        exchange_id.empty() ? InferExchangeId(instrument_id) : exchange_id;
-    if (!ResolveSessionInterval(resolved_exchange, instrument_id, ResolveProductCode(snapshot),
-                                update_time, &interval)) {
-        int minute_of_day = 24 * 60;
-        if (ParseMinuteOfDay(update_time, &minute_of_day)) {
-            return minute_of_day;
-        }
+    int minute_of_day = 0;
+    if (!CompiledSessionCalendar::ParseMinuteOfDay(update_time, &minute_of_day)) {
         return std::numeric_limits<int>::max();
     }
-    return SessionOrderKey(interval);
+    const auto* schedule = sessions_->ResolveInstrument(exchange_id, instrument_id);
+    const auto* interval = schedule == nullptr ? nullptr : schedule->IntervalAt(minute_of_day);
+    return interval == nullptr ? minute_of_day
+                               : CompiledSessionCalendar::SessionOrderKey(*interval);
 }
 
-bool BarAggregator::ParseMinuteOfDay(const std::string& update_time, int* minute_of_day) {
-    if (minute_of_day == nullptr || update_time.size() < 5) {
-        return false;
-    }
-    if (!std::isdigit(static_cast<unsigned char>(update_time[0])) ||
-        !std::isdigit(static_cast<unsigned char>(update_time[1])) || update_time[2] != ':' ||
-        !std::isdigit(static_cast<unsigned char>(update_time[3])) ||
-        !std::isdigit(static_cast<unsigned char>(update_time[4]))) {
-        return false;
-    }
-    const int hour = (update_time[0] - '0') * 10 + (update_time[1] - '0');
-    const int minute = (update_time[3] - '0') * 10 + (update_time[4] - '0');
-    if (hour < 0 || hour > 23 || minute < 0 || minute > 59) {
-        return false;
-    }
-    *minute_of_day = hour * 60 + minute;
-    return true;
-}
+const CompiledSessionCalendar& BarAggregator::session_calendar() const { return *sessions_; }
 
 std::string BarAggregator::ResolveExchangeId(const MarketSnapshot& snapshot) const {
     if (!snapshot.exchange_id.empty()) {
@@ -1155,51 +881,7 @@ std::string BarAggregator::ResolveExchangeId(const MarketSnapshot& snapshot) con
 }
 
 std::string BarAggregator::InferExchangeId(const std::string& instrument_id) const {
-    const auto dotted_exchange = InferExchangeIdFromDottedInstrument(instrument_id);
-    if (!dotted_exchange.empty()) {
-        return ToUpperAscii(dotted_exchange);
-    }
-
-    const auto symbol_upper = ToUpperAscii(ExtractInstrumentSymbol(instrument_id));
-    if (symbol_upper.empty()) {
-        return "";
-    }
-
-    std::size_t best_prefix_len = 0;
-    std::string best_exchange;
-    for (const auto& [exchange_id, rules] : session_rules_by_exchange_) {
-        const auto exchange_upper = ToUpperAscii(exchange_id);
-        if (exchange_upper.empty() || exchange_upper == "*") {
-            continue;
-        }
-        for (const auto& rule : rules) {
-            const auto prefix_upper = ToUpperAscii(rule.instrument_prefix);
-            if (prefix_upper.empty() || !StartsWith(symbol_upper, prefix_upper)) {
-                continue;
-            }
-            if (prefix_upper.size() > best_prefix_len ||
-                (prefix_upper.size() == best_prefix_len &&
-                 (best_exchange.empty() || exchange_upper < best_exchange))) {
-                best_prefix_len = prefix_upper.size();
-                best_exchange = exchange_upper;
-            }
-        }
-    }
-    return best_exchange;
-}
-
-std::string BarAggregator::ResolveProductCode(const MarketSnapshot& snapshot) {
-    const auto dot_pos = snapshot.instrument_id.find('.');
-    const auto symbol = dot_pos == std::string::npos ? snapshot.instrument_id
-                                                     : snapshot.instrument_id.substr(dot_pos + 1);
-    std::string product;
-    for (char ch : symbol) {
-        if (!std::isalpha(static_cast<unsigned char>(ch))) {
-            break;
-        }
-        product.push_back(ch);
-    }
-    return ToUpperAscii(product);
+    return sessions_->InferExchangeId(instrument_id);
 }
 
 std::string BarAggregator::ResolveTradingDay(const MarketSnapshot& snapshot) {
@@ -1263,173 +945,11 @@ EpochNanos BarAggregator::ResolveTimestamp(const MarketSnapshot& snapshot) const
     return NowEpochNanos();
 }
 
-bool BarAggregator::IsInTradingSession(const std::string& exchange_id,
-                                       const std::string& instrument_id, const std::string& product,
-                                       const std::string& update_time) const {
-    SessionInterval interval;
-    return ResolveSessionInterval(exchange_id, instrument_id, product, update_time, &interval);
-}
-
-bool BarAggregator::ResolveSessionInterval(const std::string& exchange_id,
-                                           const std::string& instrument_id,
-                                           const std::string& product,
-                                           const std::string& update_time,
-                                           SessionInterval* interval) const {
-    int minute_of_day = 0;
-    if (!ParseMinuteOfDay(update_time, &minute_of_day)) {
-        return false;
-    }
-
-    auto evaluate_rules = [&](const std::vector<SessionRule>& rules) {
-        if (instrument_id.empty() && product.empty()) {
-            for (const auto& rule : rules) {
-                for (const auto& rule_interval : rule.intervals) {
-                    if (IsMinuteInInterval(rule_interval, minute_of_day)) {
-                        if (interval != nullptr) {
-                            *interval = rule_interval;
-                        }
-                        return true;
-                    }
-                }
-            }
-            return false;
-        }
-
-        const auto symbol_upper = ToUpperAscii(ExtractInstrumentSymbol(instrument_id));
-        const auto current_product = ToUpperAscii(product);
-        bool has_specific_match = false;
-        for (const auto& rule : rules) {
-            const bool has_selector = !rule.instrument_prefix.empty() || !rule.product.empty();
-            if (!has_selector) {
-                continue;
-            }
-
-            const auto prefix_upper = ToUpperAscii(rule.instrument_prefix);
-            const auto product_upper = ToUpperAscii(rule.product);
-            const bool prefix_match =
-                prefix_upper.empty() || StartsWith(symbol_upper, prefix_upper);
-            const bool product_match = product_upper.empty() || product_upper == current_product;
-            if (!prefix_match || !product_match) {
-                continue;
-            }
-            has_specific_match = true;
-            for (const auto& rule_interval : rule.intervals) {
-                if (IsMinuteInInterval(rule_interval, minute_of_day)) {
-                    if (interval != nullptr) {
-                        *interval = rule_interval;
-                    }
-                    return true;
-                }
-            }
-        }
-        if (has_specific_match) {
-            return false;
-        }
-
-        for (const auto& rule : rules) {
-            if (!rule.instrument_prefix.empty() || !rule.product.empty()) {
-                continue;
-            }
-            for (const auto& rule_interval : rule.intervals) {
-                if (IsMinuteInInterval(rule_interval, minute_of_day)) {
-                    if (interval != nullptr) {
-                        *interval = rule_interval;
-                    }
-                    return true;
-                }
-            }
-        }
-        return false;
-    };
-
-    const auto exchange = ToUpperAscii(exchange_id);
-    const auto it = session_rules_by_exchange_.find(exchange);
-    if (it != session_rules_by_exchange_.end()) {
-        return evaluate_rules(it->second);
-    }
-    const auto fallback = session_rules_by_exchange_.find("*");
-    if (fallback != session_rules_by_exchange_.end()) {
-        return evaluate_rules(fallback->second);
-    }
-    return false;
-}
-
-bool BarAggregator::IsExactSessionEndTime(const std::string& exchange_id,
-                                          const std::string& instrument_id,
-                                          const std::string& product,
-                                          const std::string& update_time) const {
-    int minute_of_day = 0;
-    if (!ParseMinuteOfDay(update_time, &minute_of_day)) {
-        return false;
-    }
-    int second = 0;
-    if (!ParseSecondOfMinute(update_time, &second) || second != 0) {
-        return false;
-    }
-
-    auto evaluate_rules = [&](const std::vector<SessionRule>& rules) {
-        if (instrument_id.empty() && product.empty()) {
-            for (const auto& rule : rules) {
-                for (const auto& rule_interval : rule.intervals) {
-                    if (minute_of_day == rule_interval.end_minute) {
-                        return true;
-                    }
-                }
-            }
-            return false;
-        }
-
-        const auto symbol_upper = ToUpperAscii(ExtractInstrumentSymbol(instrument_id));
-        const auto current_product = ToUpperAscii(product);
-        bool has_specific_match = false;
-        for (const auto& rule : rules) {
-            const bool has_selector = !rule.instrument_prefix.empty() || !rule.product.empty();
-            if (!has_selector) {
-                continue;
-            }
-
-            const auto prefix_upper = ToUpperAscii(rule.instrument_prefix);
-            const auto product_upper = ToUpperAscii(rule.product);
-            const bool prefix_match =
-                prefix_upper.empty() || StartsWith(symbol_upper, prefix_upper);
-            const bool product_match = product_upper.empty() || product_upper == current_product;
-            if (!prefix_match || !product_match) {
-                continue;
-            }
-            has_specific_match = true;
-            for (const auto& rule_interval : rule.intervals) {
-                if (minute_of_day == rule_interval.end_minute) {
-                    return true;
-                }
-            }
-        }
-        if (has_specific_match) {
-            return false;
-        }
-
-        for (const auto& rule : rules) {
-            if (!rule.instrument_prefix.empty() || !rule.product.empty()) {
-                continue;
-            }
-            for (const auto& rule_interval : rule.intervals) {
-                if (minute_of_day == rule_interval.end_minute) {
-                    return true;
-                }
-            }
-        }
-        return false;
-    };
-
-    const auto exchange = ToUpperAscii(exchange_id);
-    const auto it = session_rules_by_exchange_.find(exchange);
-    if (it != session_rules_by_exchange_.end()) {
-        return evaluate_rules(it->second);
-    }
-    const auto fallback = session_rules_by_exchange_.find("*");
-    if (fallback != session_rules_by_exchange_.end()) {
-        return evaluate_rules(fallback->second);
-    }
-    return false;
+bool BarAggregator::IsExactSessionEndTime(const CompiledSessionCalendar::Schedule& schedule,
+                                          const std::string& update_time) {
+    int second_of_day = 0;
+    return CompiledSessionCalendar::ParseSecondOfDay(update_time, &second_of_day) &&
+           second_of_day % 60 == 0 && schedule.IsIntervalEnd(second_of_day / 60);
 }
 
 bool BarAggregator::IsSessionEndMinuteKey(const std::string& exchange_id,
@@ -1440,108 +960,8 @@ bool BarAggregator::IsSessionEndMinuteKey(const std::string& exchange_id,
     if (!ParseMinuteValue(minute_key, &trading_day, &minute_of_day)) {
         return false;
     }
-    return IsSessionEndMinute(exchange_id, instrument_id, FormatTimeOfDay(minute_of_day));
-}
-
-void BarAggregator::LoadTradingSessions() {
-    const char* env_path = std::getenv("TRADING_SESSIONS_CONFIG_PATH");
-    const std::string config_path = env_path != nullptr && std::string(env_path).size() > 0
-                                        ? std::string(env_path)
-                                        : config_.trading_sessions_config_path;
-    if (config_path.empty()) {
-        return;
-    }
-
-    std::ifstream file(config_path);
-    if (!file.is_open()) {
-        return;
-    }
-
-    struct PendingSession {
-        std::string exchange;
-        std::string instrument_prefix;
-        std::string product;
-        std::string day;
-        std::string night;
-    };
-
-    auto to_rule = [](const PendingSession& pending, std::string* exchange,
-                      SessionRule* rule) -> bool {
-        if (exchange == nullptr || rule == nullptr || pending.exchange.empty()) {
-            return false;
-        }
-        rule->instrument_prefix = ToUpperAscii(pending.instrument_prefix);
-        rule->product = pending.product;
-        rule->intervals.clear();
-
-        (void)ParseSessionRanges(pending.day, &rule->intervals);
-        (void)ParseSessionRanges(pending.night, &rule->intervals);
-        if (rule->intervals.empty()) {
-            return false;
-        }
-        *exchange = ToUpperAscii(pending.exchange);
-        return true;
-    };
-
-    std::unordered_map<std::string, std::vector<SessionRule>> loaded_rules;
-    PendingSession pending;
-    bool has_pending = false;
-    std::string line;
-
-    auto flush_pending = [&]() {
-        if (!has_pending) {
-            return;
-        }
-        SessionRule rule;
-        std::string exchange;
-        if (to_rule(pending, &exchange, &rule)) {
-            loaded_rules[exchange].push_back(std::move(rule));
-        }
-        pending = PendingSession{};
-        has_pending = false;
-    };
-
-    while (std::getline(file, line)) {
-        std::string trimmed = RemoveInlineComment(Trim(line));
-        if (trimmed.empty() || trimmed == "sessions:") {
-            continue;
-        }
-
-        if (trimmed.rfind("- ", 0) == 0) {
-            flush_pending();
-            has_pending = true;
-            trimmed = Trim(trimmed.substr(2));
-            if (trimmed.empty()) {
-                continue;
-            }
-        }
-
-        if (!has_pending) {
-            continue;
-        }
-
-        std::string key;
-        std::string value;
-        if (!ParseYamlKeyValue(trimmed, &key, &value)) {
-            continue;
-        }
-        if (key == "exchange") {
-            pending.exchange = value;
-        } else if (key == "instrument_prefix") {
-            pending.instrument_prefix = value;
-        } else if (key == "product") {
-            pending.product = value;
-        } else if (key == "day") {
-            pending.day = value;
-        } else if (key == "night") {
-            pending.night = value;
-        }
-    }
-    flush_pending();
-
-    for (const auto& entry : loaded_rules) {
-        session_rules_by_exchange_[entry.first] = entry.second;
-    }
+    const auto* schedule = sessions_->ResolveInstrument(exchange_id, instrument_id);
+    return schedule != nullptr && schedule->IsLastMinute(minute_of_day);
 }
 
 void BarAggregator::PruneClosedBoundaryMinutesLocked(const std::string& instrument_id,
@@ -0,0 +1,615 @@
+#include "quant_hft/services/compiled_session_calendar.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <system_error>
+#include <utility>
+
+namespace quant_hft {
+namespace {
+
+using Interval = CompiledSessionCalendar::Interval;
+using Rule = CompiledSessionCalendar::Rule;
+
+std::string Trim(const std::string& value) {
+    std::size_t start = 0;
+    while (start < value.size() && std::isspace(static_cast<unsigned char>(value[start])) != 0) {
+        ++start;
+    }
+    std::size_t end = value.size();
+    while (end > start && std::isspace(static_cast<unsigned char>(value[end - 1])) != 0) {
+        --end;
+    }
+    return value.substr(start, end - start);
+}
+
+std::string RemoveInlineComment(const std::string& value) {
+    bool in_quotes = false;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        const char ch = value[i];
+        if (ch == '"') {
+            in_quotes = !in_quotes;
+            continue;
+        }
+        if (ch == '#' && !in_quotes) {
+            return Trim(value.substr(0, i));
+        }
+    }
+    return Trim(value);
+}
+
+std::string NormalizeYamlValue(std::string value) {
+    value = Trim(value);
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+        value = value.substr(1, value.size() - 2);
+    }
+    if (value == "null" || value == "NULL" || value == "~") {
+        return "";
+    }
+    return value;
+}
+
+bool ParseYamlKeyValue(const std::string& line, std::string* key, std::string* value) {
+    if (key == nullptr || value == nullptr) {
+        return false;
+    }
+    const auto colon_pos = line.find(':');
+    if (colon_pos == std::string::npos) {
+        return false;
+    }
+    *key = Trim(line.substr(0, colon_pos));
+    *value = NormalizeYamlValue(RemoveInlineComment(line.substr(colon_pos + 1)));
+    return !key->empty();
+}
+
+std::string ToUpperAscii(std::string_view value) {
+    std::string upper(value);
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
+    return upper;
+}
+
+bool StartsWith(std::string_view value, std::string_view prefix) {
+    return prefix.size() <= value.size() && value.compare(0, prefix.size(), prefix) == 0;
+}
+
+std::string_view ExtractInstrumentSymbol(std::string_view instrument_id) {
+    const auto dot_pos = instrument_id.find('.');
+    if (dot_pos == std::string_view::npos || dot_pos + 1 >= instrument_id.size()) {
+        return instrument_id;
+    }
+    return instrument_id.substr(dot_pos + 1);
+}
+
+bool IsDigit(char ch) { return std::isdigit(static_cast<unsigned char>(ch)) != 0; }
+
+bool ParseSessionTimeToMinute(const std::string& raw, int* minute_of_day) {
+    if (minute_of_day == nullptr || (raw.size() != 5 && raw.size() != 8)) {
+        return false;
+    }
+    int second_of_day = 0;
+    if (!CompiledSessionCalendar::ParseSecondOfDay(raw, &second_of_day)) {
+        return false;
+    }
+    *minute_of_day = second_of_day / 60;
+    return true;
+}
+
+bool ParseSessionRange(const std::string& raw, Interval* interval) {
+    if (interval == nullptr || raw.empty()) {
+        return false;
+    }
+    const auto dash_pos = raw.find('-');
+    if (dash_pos == std::string::npos) {
+        return false;
+    }
+    int start = 0;
+    int end = 0;
+    if (!ParseSessionTimeToMinute(Trim(raw.substr(0, dash_pos)), &start) ||
+        !ParseSessionTimeToMinute(Trim(raw.substr(dash_pos + 1)), &end)) {
+        return false;
+    }
+    interval->start_minute = start;
+    interval->end_minute = end;
+    return true;
+}
+
+bool ParseSessionRanges(const std::string& raw, std::vector<Interval>* intervals) {
+    if (intervals == nullptr || raw.empty()) {
+        return false;
+    }
+    std::vector<Interval> parsed;
+    std::size_t start = 0;
+    while (start <= raw.size()) {
+        const auto comma_pos = raw.find(',', start);
+        const auto token = Trim(raw.substr(
+            start, comma_pos == std::string::npos ? std::string::npos : comma_pos - start));
+        if (!token.empty()) {
+            Interval interval;
+            if (!ParseSessionRange(token, &interval)) {
+                return false;
+            }
+            parsed.push_back(interval);
+        }
+        if (comma_pos == std::string::npos) {
+            break;
+        }
+        start = comma_pos + 1;
+    }
+    if (parsed.empty()) {
+        return false;
+    }
+    intervals->insert(intervals->end(), parsed.begin(), parsed.end());
+    return true;
+}
+
+bool IsMinuteInInterval(const Interval& interval, int minute_of_day) {
+    if (interval.start_minute < interval.end_minute) {
+        return minute_of_day >= interval.start_minute && minute_of_day < interval.end_minute;
+    }
+    if (interval.start_minute > interval.end_minute) {
+        return minute_of_day >= interval.start_minute || minute_of_day < interval.end_minute;
+    }
+    return false;
+}
+
+int PreviousMinuteOfDay(int minute_of_day) {
+    constexpr int kMinutesPerDay = CompiledSessionCalendar::kMinutesPerDay;
+    return (minute_of_day + kMinutesPerDay - 1) % kMinutesPerDay;
+}
+
+bool IsValidMinute(int minute_of_day) {
+    return minute_of_day >= 0 && minute_of_day < CompiledSessionCalendar::kMinutesPerDay;
+}
+
+// The rules BarAggregator used to evaluate for one (prefix, product) key: selector rules that
+// match take precedence over the exchange-wide ones.
+std::vector<const Rule*> SelectRules(const std::vector<Rule>& rules, const std::string& prefix_key,
+                                     const std::string& product_key) {
+    std::vector<const Rule*> specific;
+    for (const Rule& rule : rules) {
+        if (rule.instrument_prefix.empty() && rule.product.empty()) {
+            continue;
+        }
+        const bool prefix_match = StartsWith(prefix_key, rule.instrument_prefix);
+        const bool product_match = rule.product.empty() || rule.product == product_key;
+        if (prefix_match && product_match) {
+            specific.push_back(&rule);
+        }
+    }
+    if (!specific.empty()) {
+        return specific;
+    }
+    std::vector<const Rule*> generic;
+    for (const Rule& rule : rules) {
+        if (rule.instrument_prefix.empty() && rule.product.empty()) {
+            generic.push_back(&rule);
+        }
+    }
+    return generic;
+}
+
+}  // namespace
+
+CompiledSessionCalendar::Schedule::Schedule(const std::vector<const Rule*>& rules) {
+    interval_at_.fill(kNoInterval);
+    for (const Rule* rule : rules) {
+        for (const Interval& interval : rule->intervals) {
+            if (!IsValidMinute(interval.start_minute) || !IsValidMinute(interval.end_minute) ||
+                intervals_.size() >= kNoInterval) {
+                continue;
+            }
+            const auto index = static_cast<std::uint8_t>(intervals_.size());
+            intervals_.push_back(interval);
+            interval_end_.set(static_cast<std::size_t>(interval.end_minute));
+            for (int minute = 0; minute < kMinutesPerDay; ++minute) {
+                // Earlier rules win where intervals overlap, as the rule walk did.
+                if (interval_at_[minute] == kNoInterval && IsMinuteInInterval(interval, minute)) {
+                    interval_at_[minute] = index;
+                }
+            }
+        }
+    }
+}
+
+const CompiledSessionCalendar::Interval* CompiledSessionCalendar::Schedule::IntervalAt(
+    int minute_of_day) const {
+    if (!IsValidMinute(minute_of_day)) {
+        return nullptr;
+    }
+    const std::uint8_t index = interval_at_[static_cast<std::size_t>(minute_of_day)];
+    return index == kNoInterval ? nullptr : &intervals_[index];
+}
+
+bool CompiledSessionCalendar::Schedule::IsIntervalEnd(int minute_of_day) const {
+    return IsValidMinute(minute_of_day) &&
+           interval_end_.test(static_cast<std::size_t>(minute_of_day));
+}
+
+bool CompiledSessionCalendar::Schedule::IsLastMinute(int minute_of_day) const {
+    const Interval* interval = IntervalAt(minute_of_day);
+    if (interval == nullptr) {
+        return IsIntervalEnd(minute_of_day);
+    }
+    return minute_of_day == PreviousMinuteOfDay(interval->end_minute);
+}
+
+CompiledSessionCalendar::RuleSet CompiledSessionCalendar::DefaultRules() {
+    auto with_intervals = [](std::initializer_list<Interval> ranges,
+                             const std::string& instrument_prefix = "",
+                             const std::string& product = "") {
+        Rule rule;
+        rule.instrument_prefix = instrument_prefix;
+        rule.product = product;
+        rule.intervals = ranges;
+        return rule;
+    };
+
+    const Interval commodity_morning_1{9 * 60, 10 * 60 + 15};
+    const Interval commodity_morning_2{10 * 60 + 30, 11 * 60 + 30};
+    const Interval commodity_afternoon{13 * 60 + 30, 15 * 60};
+    const Interval cffex_morning{9 * 60 + 30, 11 * 60 + 30};
+    const Interval cffex_afternoon{13 * 60, 15 * 60};
+    const Interval cffex_treasury_afternoon{13 * 60, 15 * 60 + 15};
+
+    RuleSet rules;
+    rules["SHFE"].push_back(with_intervals({commodity_morning_1, commodity_morning_2,
+                                            commodity_afternoon, Interval{21 * 60, 1 * 60}}));
+    rules["DCE"].push_back(with_intervals({commodity_morning_1, commodity_morning_2,
+                                           commodity_afternoon, Interval{21 * 60, 23 * 60}}));
+    rules["CFFEX"].push_back(with_intervals({cffex_morning, cffex_afternoon}));
+    rules["CFFEX"].push_back(with_intervals({cffex_morning, cffex_treasury_afternoon}, "T"));
+    rules["CFFEX"].push_back(with_intervals({cffex_morning, cffex_treasury_afternoon}, "TF"));
+    rules["CFFEX"].push_back(with_intervals({cffex_morning, cffex_treasury_afternoon}, "TS"));
+    rules["CFFEX"].push_back(with_intervals({cffex_morning, cffex_treasury_afternoon}, "TL"));
+    rules["*"].push_back(with_intervals({commodity_morning_1, commodity_morning_2,
+                                         Interval{13 * 60 + 30, 15 * 60 + 15},
+                                         Interval{21 * 60, 2 * 60 + 30}}));
+    return rules;
+}
+
+CompiledSessionCalendar::RuleSet CompiledSessionCalendar::LoadRules(const std::string& config_path,
+                                                                    bool use_default_fallback) {
+    RuleSet rules = use_default_fallback ? DefaultRules() : RuleSet{};
+    const std::string resolved_path = ResolveConfigPath(config_path);
+    if (resolved_path.empty()) {
+        return rules;
+    }
+    std::ifstream file(resolved_path);
+    if (!file.is_open()) {
+        return rules;
+    }
+
+    struct PendingSession {
+        std::string exchange;
+        std::string instrument_prefix;
+        std::string product;
+        std::string day;
+        std::string night;
+    };
+
+    auto to_rule = [](const PendingSession& pending, std::string* exchange, Rule* rule) -> bool {
+        if (exchange == nullptr || rule == nullptr || pending.exchange.empty()) {
+            return false;
+        }
+        rule->instrument_prefix = ToUpperAscii(pending.instrument_prefix);
+        rule->product = pending.product;
+        rule->intervals.clear();
+
+        (void)ParseSessionRanges(pending.day, &rule->intervals);
+        (void)ParseSessionRanges(pending.night, &rule->intervals);
+        if (rule->intervals.empty()) {
+            return false;
+        }
+        *exchange = ToUpperAscii(pending.exchange);
+        return true;
+    };
+
+    RuleSet loaded_rules;
+    PendingSession pending;
+    bool has_pending = false;
+    std::string line;
+
+    auto flush_pending = [&]() {
+        if (!has_pending) {
+            return;
+        }
+        Rule rule;
+        std::string exchange;
+        if (to_rule(pending, &exchange, &rule)) {
+            loaded_rules[exchange].push_back(std::move(rule));
+        }
+        pending = PendingSession{};
+        has_pending = false;
+    };
+
+    while (std::getline(file, line)) {
+        std::string trimmed = RemoveInlineComment(Trim(line));
+        if (trimmed.empty() || trimmed == "sessions:") {
+            continue;
+        }
+
+        if (trimmed.rfind("- ", 0) == 0) {
+            flush_pending();
+            has_pending = true;
+            trimmed = Trim(trimmed.substr(2));
+            if (trimmed.empty()) {
+                continue;
+            }
+        }
+
+        if (!has_pending) {
+            continue;
+        }
+
+        std::string key;
+        std::string value;
+        if (!ParseYamlKeyValue(trimmed, &key, &value)) {
+            continue;
+        }
+        if (key == "exchange") {
+            pending.exchange = value;
+        } else if (key == "instrument_prefix") {
+            pending.instrument_prefix = value;
+        } else if (key == "product") {
+            pending.product = value;
+        } else if (key == "day") {
+            pending.day = value;
+        } else if (key == "night") {
+            pending.night = value;
+        }
+    }
+    flush_pending();
+
+    for (auto& entry : loaded_rules) {
+        rules[entry.first] = std::move(entry.second);
+    }
+    return rules;
+}
+
+std::shared_ptr<const CompiledSessionCalendar> CompiledSessionCalendar::Build(
+    const RuleSet& rules) {
+    std::shared_ptr<CompiledSessionCalendar> calendar(new CompiledSessionCalendar());
+    for (const auto& [raw_exchange, raw_rules] : rules) {
+        const std::string exchange = ToUpperAscii(raw_exchange);
+        // Matching is case-insensitive, so compile against upper-cased selectors.
+        std::vector<Rule> exchange_rules = raw_rules;
+        ExchangeTable table;
+        std::vector<std::string> prefix_keys{""};
+        for (Rule& rule : exchange_rules) {
+            rule.instrument_prefix = ToUpperAscii(rule.instrument_prefix);
+            rule.product = ToUpperAscii(rule.product);
+            if (!rule.instrument_prefix.empty()) {
+                prefix_keys.push_back(rule.instrument_prefix);
+                table.max_prefix_length =
+                    std::max(table.max_prefix_length, rule.instrument_prefix.size());
+            }
+            if (!rule.product.empty() && std::find(table.products.begin(), table.products.end(),
+                                                   rule.product) == table.products.end()) {
+                table.products.push_back(rule.product);
+            }
+        }
+        table.has_product_rules = !table.products.empty();
+
+        std::vector<std::string> product_keys{""};
+        product_keys.insert(product_keys.end(), table.products.begin(), table.products.end());
+        for (const std::string& prefix_key : prefix_keys) {
+            for (const std::string& product_key : product_keys) {
+                const std::string key = prefix_key + "|" + product_key;
+                if (table.schedule_by_key.count(key) != 0) {
+                    continue;
+                }
+                calendar->schedules_.emplace_back(
+                    SelectRules(exchange_rules, prefix_key, product_key));
+                table.schedule_by_key.emplace(key, calendar->schedules_.size() - 1);
+            }
+        }
+
+        std::vector<const Rule*> all_rules;
+        for (const Rule& rule : exchange_rules) {
+            all_rules.push_back(&rule);
+        }
+        calendar->schedules_.emplace_back(all_rules);
+        table.all_rules_schedule = calendar->schedules_.size() - 1;
+
+        if (exchange != "*" && !exchange.empty()) {
+            for (const Rule& rule : exchange_rules) {
+                if (rule.instrument_prefix.empty()) {
+                    continue;
+                }
+                auto [it, inserted] =
+                    calendar->exchange_by_prefix_.emplace(rule.instrument_prefix, exchange);
+                if (!inserted && exchange < it->second) {
+                    it->second = exchange;
+                }
+                calendar->max_inferred_prefix_length_ =
+                    std::max(calendar->max_inferred_prefix_length_, rule.instrument_prefix.size());
+            }
+        }
+        calendar->exchanges_[exchange] = std::move(table);
+    }
+    return calendar;
+}
+
+std::string CompiledSessionCalendar::ResolveConfigPath(const std::string& config_path) {
+    const char* env_path = std::getenv("TRADING_SESSIONS_CONFIG_PATH");
+    return env_path != nullptr && std::string(env_path).size() > 0 ? std::string(env_path)
+                                                                     : config_path;
+}
+
+std::shared_ptr<const CompiledSessionCalendar> CompiledSessionCalendar::Shared(
+    const std::string& config_path, bool use_default_fallback) {
+    return SharedOrInstall(config_path, use_default_fallback, nullptr);
+}
+
+std::shared_ptr<const CompiledSessionCalendar> CompiledSessionCalendar::InstallShared(
+    const std::string& config_path, bool use_default_fallback, const RuleSet& rules) {
+    return SharedOrInstall(config_path, use_default_fallback, &rules);
+}
+
+std::shared_ptr<const CompiledSessionCalendar> CompiledSessionCalendar::SharedOrInstall(
+    const std::string& config_path, bool use_default_fallback, const RuleSet* rules) {
+    struct CacheEntry {
+        std::uintmax_t size{0};
+        std::filesystem::file_time_type mtime{};
+        bool exists{false};
+        std::shared_ptr<const CompiledSessionCalendar> calendar;
+    };
+    static std::mutex mutex;
+    static std::unordered_map<std::string, CacheEntry> cache;
+
+    const std::string resolved_path = ResolveConfigPath(config_path);
+    CacheEntry current;
+    if (!resolved_path.empty()) {
+        std::error_code ec;
+        current.exists = std::filesystem::is_regular_file(resolved_path, ec);
+        if (current.exists) {
+            current.size = std::filesystem::file_size(resolved_path, ec);
+            current.mtime = std::filesystem::last_write_time(resolved_path, ec);
+        }
+    }
+    const std::string key = resolved_path + (use_default_fallback ? "|fallback" : "|strict");
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = cache.find(key);
+    if (rules == nullptr && it != cache.end() && it->second.exists == current.exists &&
+        it->second.size == current.size && it->second.mtime == current.mtime) {
+        return it->second.calendar;
+    }
+    current.calendar =
+        Build(rules != nullptr ? *rules : LoadRules(resolved_path, use_default_fallback));
+    cache[key] = current;
+    return current.calendar;
+}
+
+const CompiledSessionCalendar::ExchangeTable* CompiledSessionCalendar::FindExchange(
+    std::string_view exchange_id) const {
+    const auto it = exchanges_.find(ToUpperAscii(exchange_id));
+    if (it != exchanges_.end()) {
+        return &it->second;
+    }
+    const auto fallback = exchanges_.find("*");
+    return fallback == exchanges_.end() ? nullptr : &fallback->second;
+}
+
+const CompiledSessionCalendar::Schedule* CompiledSessionCalendar::Resolve(
+    std::string_view exchange_id, std::string_view instrument_id, std::string_view product) const {
+    const ExchangeTable* table = FindExchange(exchange_id);
+    if (table == nullptr) {
+        return nullptr;
+    }
+    if (instrument_id.empty() && product.empty()) {
+        return &schedules_[table->all_rules_schedule];
+    }
+
+    std::string product_key;
+    if (table->has_product_rules) {
+        product_key = ToUpperAscii(product);
+        if (std::find(table->products.begin(), table->products.end(), product_key) ==
+            table->products.end()) {
+            product_key.clear();
+        }
+    }
+    const std::string_view symbol = ExtractInstrumentSymbol(instrument_id);
+    std::string key = ToUpperAscii(symbol.substr(0, table->max_prefix_length));
+    // The longest configured prefix of the symbol selects the same rules as the symbol itself.
+    for (std::size_t length = key.size();; --length) {
+        key.resize(length);
+        key.push_back('|');
+        key.append(product_key);
+        const auto it = table->schedule_by_key.find(key);
+        if (it != table->schedule_by_key.end()) {
+            return &schedules_[it->second];
+        }
+        if (length == 0) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+const CompiledSessionCalendar::Schedule* CompiledSessionCalendar::ResolveInstrument(
+    std::string_view exchange_id, std::string_view instrument_id) const {
+    if (!exchange_id.empty()) {
+        return Resolve(exchange_id, instrument_id, ProductCode(instrument_id));
+    }
+    return Resolve(InferExchangeId(instrument_id), instrument_id, ProductCode(instrument_id));
+}
+
+std::string CompiledSessionCalendar::InferExchangeId(std::string_view instrument_id) const {
+    const auto dot_pos = instrument_id.find('.');
+    if (dot_pos != std::string_view::npos && dot_pos != 0) {
+        return ToUpperAscii(instrument_id.substr(0, dot_pos));
+    }
+    std::string prefix =
+        ToUpperAscii(ExtractInstrumentSymbol(instrument_id).substr(0, max_inferred_prefix_length_));
+    for (; !prefix.empty(); prefix.pop_back()) {
+        const auto it = exchange_by_prefix_.find(prefix);
+        if (it != exchange_by_prefix_.end()) {
+            return it->second;
+        }
+    }
+    return "";
+}
+
+bool CompiledSessionCalendar::ParseMinuteOfDay(std::string_view update_time, int* minute_of_day) {
+    if (minute_of_day == nullptr || update_time.size() < 5 || !IsDigit(update_time[0]) ||
+        !IsDigit(update_time[1]) || update_time[2] != ':' || !IsDigit(update_time[3]) ||
+        !IsDigit(update_time[4])) {
+        return false;
+    }
+    const int hour = (update_time[0] - '0') * 10 + (update_time[1] - '0');
+    const int minute = (update_time[3] - '0') * 10 + (update_time[4] - '0');
+    if (hour > 23 || minute > 59) {
+        return false;
+    }
+    *minute_of_day = hour * 60 + minute;
+    return true;
+}
+
+bool CompiledSessionCalendar::ParseSecondOfDay(std::string_view update_time, int* second_of_day) {
+    int minute_of_day = 0;
+    if (second_of_day == nullptr || !ParseMinuteOfDay(update_time, &minute_of_day)) {
+        return false;
+    }
+    int second = 0;
+    if (update_time.size() >= 8) {
+        if (update_time[5] != ':' || !IsDigit(update_time[6]) || !IsDigit(update_time[7])) {
+            return false;
+        }
+        second = (update_time[6] - '0') * 10 + (update_time[7] - '0');
+        if (second > 59) {
+            return false;
+        }
+    }
+    *second_of_day = minute_of_day * 60 + second;
+    return true;
+}
+
+std::string CompiledSessionCalendar::ProductCode(std::string_view instrument_id) {
+    const auto dot_pos = instrument_id.find('.');
+    const std::string_view symbol =
+        dot_pos == std::string_view::npos ? instrument_id : instrument_id.substr(dot_pos + 1);
+    std::size_t length = 0;
+    while (length < symbol.size() && std::isalpha(static_cast<unsigned char>(symbol[length]))) {
+        ++length;
+    }
+    return ToUpperAscii(symbol.substr(0, length));
+}
+
+std::string CompiledSessionCalendar::FormatSessionKey(const Interval& interval) {
+    return std::to_string(interval.start_minute) + "-" + std::to_string(interval.end_minute);
+}
+
+int CompiledSessionCalendar::SessionOrderKey(const Interval& interval) {
+    if (interval.start_minute > interval.end_minute || interval.start_minute >= 18 * 60) {
+        return interval.start_minute - kMinutesPerDay;
+    }
+    return interval.start_minute;
+}
+
+}  // namespace quant_hft
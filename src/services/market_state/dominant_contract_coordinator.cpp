@@ -206,7 +206,7 @@ bool DominantContractCoordinator::RefreshTradingDay(
     }
     state.eligible_instruments = std::move(unique);
     state.baseline_snapshots.clear();
-    state.live_snapshots.clear();
+    state.live_snapshots.Clear();
     state.warmup_bar_keys.clear();
     status.trading_day = trading_day;
     status.eligible_count = state.eligible_instruments.size();
@@ -251,15 +251,15 @@ void DominantContractCoordinator::UpdateLiveSnapshot(const MarketSnapshot& snaps
         return;
     }
     std::lock_guard<std::mutex> lock(mutex_);
-    const auto product_it = product_by_instrument_.find(snapshot.instrument_id);
-    if (product_it == product_by_instrument_.end()) {
+    // Index ids are registry handles, so a snapshot interned at receipt needs no lookup here.
+    const InstrumentId id = snapshot.instrument_handle != kInvalidInstrumentId
+                                ? snapshot.instrument_handle
+                                : LocalIdLocked(snapshot.instrument_id);
+    ProductState* const* state = state_by_instrument_.Find(id);
+    if (state == nullptr) {
         return;
     }
-    auto state_it = products_.find(product_it->second);
-    if (state_it == products_.end()) {
-        return;
-    }
-    auto& stored = state_it->second.live_snapshots[snapshot.instrument_id];
+    auto& stored = (*state)->live_snapshots[id];
     if (stored.instrument_id.empty() || IsNewerSnapshot(snapshot, stored)) {
         stored = snapshot;
     }
@@ -341,9 +341,8 @@ DominantContractDecision DominantContractCoordinator::Evaluate(const std::string
     status.candidate_metric = metric == "open_interest" ? best->open_interest : best->volume;
     decision.candidate_instrument_id = best->instrument_id;
 
-    const auto best_live_it = state.live_snapshots.find(best->instrument_id);
-    if (best_live_it == state.live_snapshots.end() ||
-        !IsFreshExecutableSnapshot(best_live_it->second, now_ns)) {
+    const MarketSnapshot* best_live = LiveSnapshotLocked(state, best->instrument_id);
+    if (best_live == nullptr || !IsFreshExecutableSnapshot(*best_live, now_ns)) {
         decision.reason = "best_candidate_market_not_fresh";
         return decision;
     }
@@ -366,9 +365,9 @@ DominantContractDecision DominantContractCoordinator::Evaluate(const std::string
     }
 
     const MarketSnapshot* current = LatestSnapshotLocked(state, status.current_instrument_id);
-    const auto current_live_it = state.live_snapshots.find(status.current_instrument_id);
-    if (current == nullptr || current_live_it == state.live_snapshots.end() ||
-        !IsFreshExecutableSnapshot(current_live_it->second, now_ns)) {
+    const MarketSnapshot* current_live = LiveSnapshotLocked(state, status.current_instrument_id);
+    if (current == nullptr || current_live == nullptr ||
+        !IsFreshExecutableSnapshot(*current_live, now_ns)) {
         decision.reason = "current_market_not_fresh";
         return decision;
     }
@@ -662,25 +661,20 @@ void DominantContractCoordinator::MarkFault(const std::string& product_id,
 
 bool DominantContractCoordinator::CanDispatchToStrategy(const std::string& instrument_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    const auto product_it = product_by_instrument_.find(instrument_id);
-    if (product_it == product_by_instrument_.end()) {
-        return false;
-    }
-    const auto state_it = products_.find(product_it->second);
-    if (state_it == products_.end() ||
-        state_it->second.status.phase == DominantContractPhase::kDraining ||
-        state_it->second.status.phase == DominantContractPhase::kFault ||
-        state_it->second.status.phase == DominantContractPhase::kSelecting) {
+    const ProductState* found = StateForInstrumentLocked(instrument_id);
+    if (found == nullptr || found->status.phase == DominantContractPhase::kDraining ||
+        found->status.phase == DominantContractPhase::kFault ||
+        found->status.phase == DominantContractPhase::kSelecting) {
         return false;
     }
-    const auto& state = state_it->second;
+    const auto& state = *found;
     return state.status.current_instrument_id == instrument_id ||
            state.broker.held_instrument_ids.count(instrument_id) > 0U;
 }
 
 bool DominantContractCoordinator::IsCandidateInstrument(const std::string& instrument_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return product_by_instrument_.count(instrument_id) > 0U;
+    return StateForInstrumentLocked(instrument_id) != nullptr;
 }
 
 ContractSignalValidation DominantContractCoordinator::ValidateSignal(
@@ -689,9 +683,9 @@ ContractSignalValidation DominantContractCoordinator::ValidateSignal(
     ContractSignalValidation validation;
     std::string product_id = signal.product_id;
     if (product_id.empty()) {
-        const auto product_it = product_by_instrument_.find(signal.instrument_id);
-        if (product_it != product_by_instrument_.end()) {
-            product_id = product_it->second;
+        const ProductState* state = StateForInstrumentLocked(signal.instrument_id);
+        if (state != nullptr) {
+            product_id = state->status.product_id;
         }
     }
     auto state_it = products_.find(product_id);
@@ -738,23 +732,19 @@ ContractSignalValidation DominantContractCoordinator::ValidateSignal(
 std::optional<std::uint64_t> DominantContractCoordinator::GenerationForInstrument(
     const std::string& instrument_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    const auto product_it = product_by_instrument_.find(instrument_id);
-    if (product_it == product_by_instrument_.end()) {
+    const ProductState* state = StateForInstrumentLocked(instrument_id);
+    if (state == nullptr) {
         return std::nullopt;
     }
-    const auto state_it = products_.find(product_it->second);
-    if (state_it == products_.end()) {
-        return std::nullopt;
-    }
-    return state_it->second.status.generation;
+    return state->status.generation;
 }
 
 std::optional<std::string> DominantContractCoordinator::ProductForInstrument(
     const std::string& instrument_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    const auto it = product_by_instrument_.find(instrument_id);
-    return it == product_by_instrument_.end() ? std::nullopt
-                                              : std::optional<std::string>(it->second);
+    const ProductState* state = StateForInstrumentLocked(instrument_id);
+    return state == nullptr ? std::nullopt
+                            : std::optional<std::string>(state->status.product_id);
 }
 
 DominantContractStatus DominantContractCoordinator::GetStatus(const std::string& product_id) const {
@@ -926,29 +916,55 @@ const MarketSnapshot* DominantContractCoordinator::BestSnapshotLocked(const Prod
 
 const MarketSnapshot* DominantContractCoordinator::LatestSnapshotLocked(
     const ProductState& state, const std::string& instrument_id) const {
-    const auto live_it = state.live_snapshots.find(instrument_id);
+    const MarketSnapshot* live = LiveSnapshotLocked(state, instrument_id);
     const auto baseline_it = state.baseline_snapshots.find(instrument_id);
-    if (live_it == state.live_snapshots.end()) {
+    if (live == nullptr) {
         return baseline_it == state.baseline_snapshots.end() ? nullptr : &baseline_it->second;
     }
     if (baseline_it == state.baseline_snapshots.end()) {
-        return &live_it->second;
+        return live;
     }
-    return IsNewerSnapshot(live_it->second, baseline_it->second) ? &live_it->second
-                                                                 : &baseline_it->second;
+    return IsNewerSnapshot(*live, baseline_it->second) ? live : &baseline_it->second;
+}
+
+const MarketSnapshot* DominantContractCoordinator::LiveSnapshotLocked(
+    const ProductState& state, const std::string& instrument_id) const {
+    return state.live_snapshots.Find(LocalIdLocked(instrument_id));
+}
+
+DominantContractCoordinator::ProductState* DominantContractCoordinator::StateForInstrumentLocked(
+    const std::string& instrument_id) const {
+    ProductState* const* state = state_by_instrument_.Find(LocalIdLocked(instrument_id));
+    return state == nullptr ? nullptr : *state;
+}
+
+InstrumentId DominantContractCoordinator::LocalIdLocked(const std::string& instrument_id) const {
+    const auto it = instrument_ids_.find(instrument_id);
+    return it == instrument_ids_.end() ? kInvalidInstrumentId : it->second;
 }
 
 void DominantContractCoordinator::RebuildInstrumentIndexLocked() {
-    product_by_instrument_.clear();
-    for (const auto& [product_id, state] : products_) {
+    state_by_instrument_.Clear();
+    InstrumentRegistry& registry = InstrumentRegistry::Global();
+    auto index = [&](const std::string& instrument_id, ProductState* state) {
+        auto it = instrument_ids_.try_emplace(instrument_id, kInvalidInstrumentId).first;
+        if (it->second == kInvalidInstrumentId) {
+            it->second = registry.Intern(instrument_id);
+        }
+        const InstrumentId id = it->second;
+        if (id != kInvalidInstrumentId) {
+            state_by_instrument_[id] = state;
+        }
+    };
+    for (auto& [product_id, state] : products_) {
         for (const auto& instrument_id : state.eligible_instruments) {
-            product_by_instrument_[instrument_id] = product_id;
+            index(instrument_id, &state);
         }
         if (!state.status.current_instrument_id.empty()) {
-            product_by_instrument_[state.status.current_instrument_id] = product_id;
+            index(state.status.current_instrument_id, &state);
         }
         for (const auto& instrument_id : state.broker.held_instrument_ids) {
-            product_by_instrument_[instrument_id] = product_id;
+            index(instrument_id, &state);
         }
     }
 }
@@ -1,19 +1,13 @@
 #include "quant_hft/services/market_bar_pipeline.h"
 
 #include <algorithm>
-#include <cerrno>
-#include <chrono>
 #include <cstring>
-#include <filesystem>
-#include <fstream>
 #include <iomanip>
+#include <map>
 #include <sstream>
 #include <utility>
 
-#if !defined(_WIN32)
-#include <fcntl.h>
-#include <unistd.h>
-#endif
+#include "quant_hft/core/binary_section_file.h"
 
 namespace quant_hft {
 namespace {
@@ -82,27 +76,89 @@ std::string FormatDouble(double value) {
     return stream.str();
 }
 
-std::string ErrnoMessage(const std::string& action) { return action + ": " + std::strerror(errno); }
+// Pipeline-level state is split into one section per instrument so a corrupt section is
+// pinpointed and the format can later be loaded selectively.
+constexpr BinarySectionFileFormat kCheckpointFormat{
+    {'Q', 'H', 'M', 'B', 'P', 'C', 'K', '\0'}, 3, "market bar checkpoint"};
 
-#if !defined(_WIN32)
-bool FsyncPath(const std::filesystem::path& path, bool directory, std::string* error) {
-    const int flags = directory ? (O_RDONLY | O_DIRECTORY) : O_RDONLY;
-    const int fd = ::open(path.c_str(), flags);
-    if (fd < 0) {
-        SetError(error, ErrnoMessage("open for fsync failed: " + path.string()));
+enum class CheckpointSection : std::uint32_t {
+    kPipeline = 1,
+    kAggregator = 2,
+    kFanout = 3,
+    kInstrument = 4,
+};
+
+std::string InstrumentOfKey(const std::string& key) { return key.substr(0, key.find('|')); }
+
+void PutStringMap(BinarySectionWriter* writer,
+                  const std::unordered_map<std::string, std::string>& map) {
+    writer->Put(static_cast<std::uint32_t>(map.size()));
+    for (const auto& [key, value] : map) {
+        writer->PutString(key);
+        writer->PutString(value);
+    }
+}
+
+bool GetStringMap(BinarySectionReader* reader, std::unordered_map<std::string, std::string>* map) {
+    std::uint32_t count = 0;
+    if (!reader->Get(&count)) {
+        return false;
+    }
+    map->reserve(map->size() + count);
+    for (std::uint32_t index = 0; index < count; ++index) {
+        std::string key;
+        std::string value;
+        if (!reader->GetString(&key) || !reader->GetString(&value)) {
+            return false;
+        }
+        (*map)[std::move(key)] = std::move(value);
+    }
+    return reader->AtEnd();
+}
+
+void PutRecentState(BinarySectionWriter* writer, const StateSnapshot7D& state) {
+    writer->Put(state.timeframe_minutes);
+    for (const double value :
+         {state.bar_open, state.bar_high, state.bar_low, state.bar_close, state.analysis_bar_open,
+          state.analysis_bar_high, state.analysis_bar_low, state.analysis_bar_close,
+          state.analysis_price_offset, state.bar_volume, state.market_state_adx,
+          state.market_state_kama_er, state.market_state_atr_ratio}) {
+        writer->Put(value);
+    }
+    writer->Put(static_cast<std::int32_t>(state.market_regime));
+    writer->Put(state.market_state_bars_seen);
+    writer->PutString(state.market_state_decision_reason);
+    writer->Put(state.ts_ns);
+}
+
+bool GetRecentState(BinarySectionReader* reader, StateSnapshot7D* state) {
+    std::int32_t regime = 0;
+    if (!reader->Get(&state->timeframe_minutes)) {
         return false;
     }
-    const int rc = ::fsync(fd);
-    const int saved_errno = errno;
-    ::close(fd);
-    if (rc != 0) {
-        errno = saved_errno;
-        SetError(error, ErrnoMessage("fsync failed: " + path.string()));
+    for (double* value :
+         {&state->bar_open, &state->bar_high, &state->bar_low, &state->bar_close,
+          &state->analysis_bar_open, &state->analysis_bar_high, &state->analysis_bar_low,
+          &state->analysis_bar_close, &state->analysis_price_offset, &state->bar_volume,
+          &state->market_state_adx, &state->market_state_kama_er,
+          &state->market_state_atr_ratio}) {
+        if (!reader->Get(value)) {
+            return false;
+        }
+    }
+    if (!reader->Get(&regime) || !reader->Get(&state->market_state_bars_seen) ||
+        !reader->GetString(&state->market_state_decision_reason) ||
+        !reader->Get(&state->ts_ns)) {
         return false;
     }
+    if (regime < static_cast<int>(MarketRegime::kUnknown) ||
+        regime > static_cast<int>(MarketRegime::kFlat)) {
+        return false;
+    }
+    state->market_regime = static_cast<MarketRegime>(regime);
+    state->has_bar = true;
     return true;
 }
-#endif
 
 }  // namespace
 
@@ -225,76 +281,203 @@ bool MarketBarPipeline::SaveCheckpointAtomically(const std::string& path,
         SetError(error, "market bar checkpoint path is empty");
         return false;
     }
-    PersistenceState state;
-    if (!SaveState(&state, error)) {
+    CheckpointSnapshot snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!CaptureSnapshotLocked(&snapshot, error)) {
+            return false;
+        }
+    }
+    return WriteFileAtomically(path, EncodeCheckpoint(snapshot), kCheckpointFormat.label, error);
+}
+
+bool MarketBarPipeline::LoadCheckpointFile(const std::string& path, std::string* error) {
+    MappedReadOnlyFile file;
+    if (!file.Open(path, kCheckpointFormat.label, error)) {
         return false;
     }
-    std::vector<std::pair<std::string, std::string>> entries(state.begin(), state.end());
-    std::sort(entries.begin(), entries.end());
-    std::ostringstream payload;
-    for (const auto& [key, value] : entries) {
-        payload << EscapeCheckpointValue(key) << '=' << EscapeCheckpointValue(value) << '\n';
+    CheckpointSnapshot snapshot;
+    if (file.size() >= sizeof(kCheckpointFormat.magic) &&
+        std::memcmp(file.data(), kCheckpointFormat.magic, sizeof(kCheckpointFormat.magic)) == 0) {
+        if (!DecodeCheckpoint(file.data(), file.size(), &snapshot, error)) {
+            return false;
+        }
+    } else {
+        PersistenceState state;
+        if (!ParseTextCheckpoint(file.data(), file.size(), &state, error) ||
+            !StateToSnapshot(state, &snapshot, error)) {
+            return false;
+        }
     }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return InstallSnapshotLocked(std::move(snapshot), error);
+}
 
-    const std::filesystem::path output(path);
-    std::error_code ec;
-    if (!output.parent_path().empty()) {
-        std::filesystem::create_directories(output.parent_path(), ec);
-        if (ec) {
-            SetError(error, "failed to create checkpoint directory: " + ec.message());
-            return false;
+std::string MarketBarPipeline::EncodeCheckpoint(const CheckpointSnapshot& snapshot) {
+    struct InstrumentRecords {
+        std::vector<const std::pair<const std::string, EpochNanos>*> tick_fingerprints;
+        std::vector<const std::pair<const std::string, std::string>*> canonical_bars;
+        const RecoveryState* recovery{nullptr};
+        std::vector<const std::deque<StateSnapshot7D>*> recent_series;
+    };
+    std::map<std::string, InstrumentRecords> instruments;
+    for (const auto& entry : snapshot.tick_fingerprints) {
+        instruments[InstrumentOfKey(entry.first)].tick_fingerprints.push_back(&entry);
+    }
+    for (const auto& entry : snapshot.canonical_bars) {
+        instruments[InstrumentOfKey(entry.first)].canonical_bars.push_back(&entry);
+    }
+    for (const auto& [instrument_id, recovery] : snapshot.recovery) {
+        instruments[instrument_id].recovery = &recovery;
+    }
+    for (const auto& [key, states] : snapshot.recent_states) {
+        if (!states.empty()) {
+            instruments[InstrumentOfKey(key)].recent_series.push_back(&states);
         }
     }
-    const auto suffix = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                            std::chrono::system_clock::now().time_since_epoch())
-                            .count();
-    const std::filesystem::path temporary = output.string() + ".tmp." + std::to_string(suffix);
-    {
-        std::ofstream stream(temporary, std::ios::out | std::ios::trunc | std::ios::binary);
-        if (!stream.is_open()) {
-            SetError(error, "failed to open market bar checkpoint temp file");
-            return false;
+
+    std::string out;
+    BinarySectionWriter writer(&out);
+    writer.BeginSection(static_cast<std::uint32_t>(CheckpointSection::kPipeline));
+    writer.Put(snapshot.last_watermark_ns);
+    writer.EndSection();
+    writer.BeginSection(static_cast<std::uint32_t>(CheckpointSection::kAggregator));
+    PutStringMap(&writer, snapshot.aggregator);
+    writer.EndSection();
+    writer.BeginSection(static_cast<std::uint32_t>(CheckpointSection::kFanout));
+    PutStringMap(&writer, snapshot.fanout);
+    writer.EndSection();
+
+    for (const auto& [instrument_id, records] : instruments) {
+        writer.BeginSection(static_cast<std::uint32_t>(CheckpointSection::kInstrument));
+        writer.PutString(instrument_id);
+        writer.Put(static_cast<std::uint32_t>(records.tick_fingerprints.size()));
+        for (const auto* entry : records.tick_fingerprints) {
+            writer.PutString(entry->first);
+            writer.Put(entry->second);
         }
-        stream << payload.str();
-        stream.flush();
-        if (!stream.good()) {
-            stream.close();
-            std::filesystem::remove(temporary, ec);
-            SetError(error, "failed to flush market bar checkpoint temp file");
-            return false;
+        writer.Put(static_cast<std::uint32_t>(records.canonical_bars.size()));
+        for (const auto* entry : records.canonical_bars) {
+            writer.PutString(entry->first);
+            writer.PutString(entry->second);
+        }
+        writer.Put(static_cast<std::uint8_t>(records.recovery != nullptr ? 1 : 0));
+        if (records.recovery != nullptr) {
+            writer.Put(records.recovery->consecutive_complete_five_minute_bars);
+        }
+        writer.Put(static_cast<std::uint32_t>(records.recent_series.size()));
+        for (const auto* states : records.recent_series) {
+            writer.Put(static_cast<std::uint32_t>(states->size()));
+            for (const auto& state : *states) {
+                PutRecentState(&writer, state);
+            }
         }
+        writer.EndSection();
     }
-#if !defined(_WIN32)
-    if (!FsyncPath(temporary, false, error)) {
-        std::filesystem::remove(temporary, ec);
+
+    writer.Finish(kCheckpointFormat);
+    return out;
+}
+
+bool MarketBarPipeline::DecodeCheckpoint(const char* data, std::size_t size,
+                                         CheckpointSnapshot* out, std::string* error) const {
+    std::vector<BinarySection> sections;
+    if (!SplitBinarySections(data, size, kCheckpointFormat, &sections, error)) {
         return false;
     }
-#endif
-    std::filesystem::rename(temporary, output, ec);
-    if (ec) {
-        std::filesystem::remove(temporary, ec);
-        SetError(error, "failed to atomically publish market bar checkpoint: " + ec.message());
-        return false;
+
+    const std::size_t limit = std::max<std::size_t>(1, config_.recent_complete_state_limit);
+    bool saw_pipeline = false;
+    bool saw_aggregator = false;
+    bool saw_fanout = false;
+    std::unordered_set<std::string> seen_instruments;
+    for (const BinarySection& section : sections) {
+        BinarySectionReader reader(section.payload, section.payload_bytes);
+        bool ok = true;
+        switch (static_cast<CheckpointSection>(section.kind)) {
+            case CheckpointSection::kPipeline:
+                ok = !saw_pipeline && reader.Get(&out->last_watermark_ns) && reader.AtEnd();
+                saw_pipeline = true;
+                break;
+            case CheckpointSection::kAggregator:
+                ok = !saw_aggregator && GetStringMap(&reader, &out->aggregator);
+                saw_aggregator = true;
+                break;
+            case CheckpointSection::kFanout:
+                ok = !saw_fanout && GetStringMap(&reader, &out->fanout);
+                saw_fanout = true;
+                break;
+            case CheckpointSection::kInstrument: {
+                std::string instrument_id;
+                std::uint32_t count = 0;
+                ok = reader.GetString(&instrument_id) && !instrument_id.empty() &&
+                     seen_instruments.insert(instrument_id).second && reader.Get(&count);
+                for (std::uint32_t index = 0; ok && index < count; ++index) {
+                    std::string fingerprint;
+                    EpochNanos ts_ns = 0;
+                    ok = reader.GetString(&fingerprint) && reader.Get(&ts_ns);
+                    out->tick_fingerprints[std::move(fingerprint)] = ts_ns;
+                }
+                ok = ok && reader.Get(&count);
+                for (std::uint32_t index = 0; ok && index < count; ++index) {
+                    std::string key;
+                    std::string fingerprint;
+                    ok = reader.GetString(&key) && !key.empty() && reader.GetString(&fingerprint);
+                    out->canonical_bars[std::move(key)] = std::move(fingerprint);
+                }
+                std::uint8_t has_recovery = 0;
+                ok = ok && reader.Get(&has_recovery);
+                if (ok && has_recovery != 0) {
+                    RecoveryState recovery;
+                    ok = reader.Get(&recovery.consecutive_complete_five_minute_bars);
+                    out->recovery[instrument_id] = recovery;
+                }
+                std::uint32_t series_count = 0;
+                ok = ok && reader.Get(&series_count);
+                for (std::uint32_t series = 0; ok && series < series_count; ++series) {
+                    ok = reader.Get(&count);
+                    for (std::uint32_t index = 0; ok && index < count; ++index) {
+                        StateSnapshot7D recent;
+                        ok = GetRecentState(&reader, &recent);
+                        if (!ok) {
+                            break;
+                        }
+                        recent.instrument_id = instrument_id;
+                        auto& rows = out->recent_states[instrument_id + "|" +
+                                                        std::to_string(recent.timeframe_minutes)];
+                        rows.push_back(std::move(recent));
+                        while (rows.size() > limit) {
+                            rows.pop_front();
+                        }
+                    }
+                }
+                ok = ok && reader.AtEnd();
+                break;
+            }
+            default:
+                ok = false;
+                break;
+        }
+        if (!ok) {
+            SetError(error, "malformed market bar checkpoint section");
+            return false;
+        }
     }
-#if !defined(_WIN32)
-    const std::filesystem::path parent =
-        output.parent_path().empty() ? std::filesystem::path(".") : output.parent_path();
-    if (!FsyncPath(parent, true, error)) {
+    if (!saw_pipeline || !saw_aggregator || !saw_fanout) {
+        SetError(error, "incomplete market bar checkpoint");
         return false;
     }
-#endif
     return true;
 }
 
-bool MarketBarPipeline::LoadCheckpointFile(const std::string& path, std::string* error) {
-    std::ifstream stream(path, std::ios::in | std::ios::binary);
-    if (!stream.is_open()) {
-        SetError(error, "failed to open market bar checkpoint: " + path);
-        return false;
-    }
-    PersistenceState state;
-    std::string line;
-    while (std::getline(stream, line)) {
+bool MarketBarPipeline::ParseTextCheckpoint(const char* data, std::size_t size,
+                                            PersistenceState* out, std::string* error) {
+    std::size_t offset = 0;
+    while (offset < size) {
+        const char* end = static_cast<const char*>(std::memchr(data + offset, '\n', size - offset));
+        const std::size_t line_end = end != nullptr ? static_cast<std::size_t>(end - data) : size;
+        const std::string line(data + offset, line_end - offset);
+        offset = line_end + 1;
         if (line.empty()) {
             continue;
         }
@@ -310,16 +493,12 @@ bool MarketBarPipeline::LoadCheckpointFile(const std::string& path, std::string*
             SetError(error, "invalid market bar checkpoint escape sequence");
             return false;
         }
-        if (!state.emplace(std::move(key), std::move(value)).second) {
+        if (!out->emplace(std::move(key), std::move(value)).second) {
             SetError(error, "duplicate market bar checkpoint key");
             return false;
         }
     }
-    if (!stream.eof()) {
-        SetError(error, "failed while reading market bar checkpoint");
-        return false;
-    }
-    return LoadState(state, error);
+    return true;
 }
 
 bool MarketBarPipeline::IsOpeningSuppressed(const std::string& instrument_id) const {
@@ -420,20 +599,6 @@ std::string MarketBarPipeline::BarFingerprint(const BarSnapshot& bar) {
     return out.str();
 }
 
-std::string MarketBarPipeline::EscapeCheckpointValue(const std::string& value) {
-    std::ostringstream out;
-    out << std::uppercase << std::hex;
-    for (unsigned char ch : value) {
-        if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') ||
-            ch == '.' || ch == '_' || ch == '-' || ch == '|') {
-            out << static_cast<char>(ch);
-        } else {
-            out << '%' << std::setw(2) << std::setfill('0') << static_cast<int>(ch);
-        }
-    }
-    return out.str();
-}
-
 bool MarketBarPipeline::UnescapeCheckpointValue(const std::string& value, std::string* out) {
     if (out == nullptr) {
         return false;
@@ -605,41 +770,39 @@ bool MarketBarPipeline::SaveStateLocked(PersistenceState* out, std::string* erro
         SetError(error, "market bar pipeline state output is null");
         return false;
     }
-    BarAggregator::PersistenceState aggregator_state;
-    TimeframeStateFanout::PersistenceState fanout_state;
-    if (!bar_aggregator_.SaveState(&aggregator_state, error) ||
-        !timeframe_fanout_.SaveState(&fanout_state, error)) {
+    CheckpointSnapshot snapshot;
+    if (!CaptureSnapshotLocked(&snapshot, error)) {
         return false;
     }
     out->clear();
     (*out)["version"] = "2";
-    (*out)["last_watermark_ns"] = std::to_string(last_watermark_ns_);
-    for (const auto& [key, value] : aggregator_state) {
+    (*out)["last_watermark_ns"] = std::to_string(snapshot.last_watermark_ns);
+    for (const auto& [key, value] : snapshot.aggregator) {
         (*out)["aggregator." + key] = value;
     }
-    for (const auto& [key, value] : fanout_state) {
+    for (const auto& [key, value] : snapshot.fanout) {
         (*out)["fanout." + key] = value;
     }
 
-    (*out)["tick_fingerprints.count"] = std::to_string(tick_fingerprint_seen_ts_.size());
+    (*out)["tick_fingerprints.count"] = std::to_string(snapshot.tick_fingerprints.size());
     std::size_t fingerprint_index = 0;
-    for (const auto& [fingerprint, ts_ns] : tick_fingerprint_seen_ts_) {
+    for (const auto& [fingerprint, ts_ns] : snapshot.tick_fingerprints) {
         const std::string prefix = "tick_fingerprints." + std::to_string(fingerprint_index++);
         (*out)[prefix + ".value"] = fingerprint;
         (*out)[prefix + ".ts_ns"] = std::to_string(ts_ns);
     }
 
-    (*out)["canonical_bars.count"] = std::to_string(canonical_bar_fingerprints_.size());
+    (*out)["canonical_bars.count"] = std::to_string(snapshot.canonical_bars.size());
     std::size_t canonical_index = 0;
-    for (const auto& [key, fingerprint] : canonical_bar_fingerprints_) {
+    for (const auto& [key, fingerprint] : snapshot.canonical_bars) {
         const std::string prefix = "canonical_bars." + std::to_string(canonical_index++);
         (*out)[prefix + ".key"] = key;
         (*out)[prefix + ".fingerprint"] = fingerprint;
     }
 
-    (*out)["recovery.count"] = std::to_string(recovery_by_instrument_.size());
+    (*out)["recovery.count"] = std::to_string(snapshot.recovery.size());
     std::size_t recovery_index = 0;
-    for (const auto& [instrument_id, recovery] : recovery_by_instrument_) {
+    for (const auto& [instrument_id, recovery] : snapshot.recovery) {
         const std::string prefix = "recovery." + std::to_string(recovery_index++);
         (*out)[prefix + ".instrument_id"] = instrument_id;
         (*out)[prefix + ".complete_five_minute_bars"] =
@@ -647,13 +810,13 @@ bool MarketBarPipeline::SaveStateLocked(PersistenceState* out, std::string* erro
     }
 
     std::size_t recent_count = 0;
-    for (const auto& [key, states] : recent_complete_states_) {
+    for (const auto& [key, states] : snapshot.recent_states) {
         (void)key;
         recent_count += states.size();
     }
     (*out)["recent_states.count"] = std::to_string(recent_count);
     std::size_t recent_index = 0;
-    for (const auto& [key, states] : recent_complete_states_) {
+    for (const auto& [key, states] : snapshot.recent_states) {
         (void)key;
         for (const auto& state : states) {
             const std::string prefix = "recent_states." + std::to_string(recent_index++);
@@ -684,25 +847,44 @@ bool MarketBarPipeline::SaveStateLocked(PersistenceState* out, std::string* erro
 }
 
 bool MarketBarPipeline::LoadStateLocked(const PersistenceState& state, std::string* error) {
+    CheckpointSnapshot snapshot;
+    if (!StateToSnapshot(state, &snapshot, error)) {
+        return false;
+    }
+    return InstallSnapshotLocked(std::move(snapshot), error);
+}
+
+bool MarketBarPipeline::CaptureSnapshotLocked(CheckpointSnapshot* out, std::string* error) const {
+    if (!bar_aggregator_.SaveState(&out->aggregator, error) ||
+        !timeframe_fanout_.SaveState(&out->fanout, error)) {
+        return false;
+    }
+    out->last_watermark_ns = last_watermark_ns_;
+    out->tick_fingerprints = tick_fingerprint_seen_ts_;
+    out->canonical_bars = canonical_bar_fingerprints_;
+    out->recovery = recovery_by_instrument_;
+    out->recent_states = recent_complete_states_;
+    return true;
+}
+
+bool MarketBarPipeline::StateToSnapshot(const PersistenceState& state, CheckpointSnapshot* out,
+                                        std::string* error) const {
     const std::string* version = RequireValue(state, "version", error);
     if (version == nullptr || *version != "2") {
         SetError(error, "unsupported market bar pipeline checkpoint version");
         return false;
     }
-    EpochNanos loaded_watermark = 0;
-    if (!ParseInteger(state, "last_watermark_ns", &loaded_watermark, error)) {
+    if (!ParseInteger(state, "last_watermark_ns", &out->last_watermark_ns, error)) {
         return false;
     }
-    BarAggregator::PersistenceState aggregator_state;
-    TimeframeStateFanout::PersistenceState fanout_state;
     for (const auto& [key, value] : state) {
         if (key.rfind("aggregator.", 0) == 0) {
-            aggregator_state[key.substr(std::string("aggregator.").size())] = value;
+            out->aggregator[key.substr(std::string("aggregator.").size())] = value;
         } else if (key.rfind("fanout.", 0) == 0) {
-            fanout_state[key.substr(std::string("fanout.").size())] = value;
+            out->fanout[key.substr(std::string("fanout.").size())] = value;
         }
     }
-    std::unordered_map<std::string, EpochNanos> loaded_tick_fingerprints;
+    auto& loaded_tick_fingerprints = out->tick_fingerprints;
     std::int64_t fingerprint_count = 0;
     if (!ParseInteger(state, "tick_fingerprints.count", &fingerprint_count, error) ||
         fingerprint_count < 0) {
@@ -718,7 +900,7 @@ bool MarketBarPipeline::LoadStateLocked(const PersistenceState& state, std::stri
         loaded_tick_fingerprints[*fingerprint] = ts_ns;
     }
 
-    std::unordered_map<std::string, std::string> loaded_canonical;
+    auto& loaded_canonical = out->canonical_bars;
     std::int64_t canonical_count = 0;
     if (!ParseInteger(state, "canonical_bars.count", &canonical_count, error) ||
         canonical_count < 0) {
@@ -734,7 +916,7 @@ bool MarketBarPipeline::LoadStateLocked(const PersistenceState& state, std::stri
         loaded_canonical[*key] = *fingerprint;
     }
 
-    std::unordered_map<std::string, RecoveryState> loaded_recovery;
+    auto& loaded_recovery = out->recovery;
     std::int64_t recovery_count = 0;
     if (!ParseInteger(state, "recovery.count", &recovery_count, error) || recovery_count < 0) {
         return false;
@@ -751,7 +933,7 @@ bool MarketBarPipeline::LoadStateLocked(const PersistenceState& state, std::stri
         loaded_recovery[*instrument_id] = recovery;
     }
 
-    std::unordered_map<std::string, std::deque<StateSnapshot7D>> loaded_recent;
+    auto& loaded_recent = out->recent_states;
     std::int64_t recent_count = 0;
     const auto recent_count_it = state.find("recent_states.count");
     if (recent_count_it != state.end()) {
@@ -815,26 +997,30 @@ bool MarketBarPipeline::LoadStateLocked(const PersistenceState& state, std::stri
         }
     }
 
+    return true;
+}
+
+bool MarketBarPipeline::InstallSnapshotLocked(CheckpointSnapshot snapshot, std::string* error) {
     // Validate all nested state before mutating the live pipeline.  This prevents a valid
     // aggregator section followed by a corrupt fanout section from producing a half-restore.
     BarAggregator validated_aggregator(config_.bar_aggregator);
     TimeframeStateFanout validated_fanout(config_.timeframes, config_.detector,
                                           config_.detector_by_product);
-    if (!validated_aggregator.LoadState(aggregator_state, error) ||
-        !validated_fanout.LoadState(fanout_state, error)) {
+    if (!validated_aggregator.LoadState(snapshot.aggregator, error) ||
+        !validated_fanout.LoadState(snapshot.fanout, error)) {
         return false;
     }
-    if (!bar_aggregator_.LoadState(aggregator_state, error) ||
-        !timeframe_fanout_.LoadState(fanout_state, error)) {
+    if (!bar_aggregator_.LoadState(snapshot.aggregator, error) ||
+        !timeframe_fanout_.LoadState(snapshot.fanout, error)) {
         SetError(error, "validated market bar checkpoint failed to install");
         return false;
     }
 
-    last_watermark_ns_ = loaded_watermark;
-    tick_fingerprint_seen_ts_ = std::move(loaded_tick_fingerprints);
-    canonical_bar_fingerprints_ = std::move(loaded_canonical);
-    recovery_by_instrument_ = std::move(loaded_recovery);
-    recent_complete_states_ = std::move(loaded_recent);
+    last_watermark_ns_ = snapshot.last_watermark_ns;
+    tick_fingerprint_seen_ts_ = std::move(snapshot.tick_fingerprints);
+    canonical_bar_fingerprints_ = std::move(snapshot.canonical_bars);
+    recovery_by_instrument_ = std::move(snapshot.recovery);
+    recent_complete_states_ = std::move(snapshot.recent_states);
     replaying_ = false;
     return true;
 }
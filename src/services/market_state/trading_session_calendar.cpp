@@ -7,10 +7,16 @@
 
 namespace quant_hft {
 
+namespace {
+
+constexpr int kSecondsPerDay = 24 * 60 * 60;
+
+}  // namespace
+
 TradingSessionCalendar::TradingSessionCalendar(TradingSessionCalendarConfig config)
     : config_(std::move(config)),
-      delegate_(BarAggregatorConfig{true, false, config_.trading_sessions_config_path,
-                                    config_.use_default_session_fallback}) {}
+      sessions_(CompiledSessionCalendar::Shared(config_.trading_sessions_config_path,
+                                                config_.use_default_session_fallback)) {}
 
 void TradingSessionCalendar::SetTradingDayOpenResolver(TradingDayOpenResolver resolver) {
     trading_day_open_resolver_ = std::move(resolver);
@@ -19,30 +25,41 @@ void TradingSessionCalendar::SetTradingDayOpenResolver(TradingDayOpenResolver re
 bool TradingSessionCalendar::IsMarketDataTime(const std::string& exchange_id,
                                               const std::string& instrument_id,
                                               const std::string& update_time) const {
-    MarketSnapshot snapshot;
-    snapshot.exchange_id = exchange_id;
-    snapshot.instrument_id = instrument_id;
-    snapshot.trading_day = "19700101";
-    snapshot.action_day = "19700101";
-    snapshot.update_time = update_time;
-    snapshot.last_price = 1.0;
-    if (delegate_.ShouldProcessSnapshot(snapshot)) {
-        return true;
-    }
-
-    int minute = 0;
-    int second = 0;
-    return ParseMinute(update_time, &minute, &second) && second == 0 &&
-           delegate_.IsSessionEndMinute(exchange_id, instrument_id, update_time);
+    int second_of_day = 0;
+    return !instrument_id.empty() &&
+           CompiledSessionCalendar::ParseSecondOfDay(update_time, &second_of_day) &&
+           IsMarketDataTime(exchange_id, instrument_id, second_of_day);
 }
 
 bool TradingSessionCalendar::IsOrderTime(const std::string& exchange_id,
                                          const std::string& instrument_id,
                                          const std::string& update_time) const {
-    // ResolveSessionKey only returns a key for the half-open session interval.  In contrast,
-    // ShouldProcessSnapshot deliberately accepts an exact endpoint tick so the market pipeline
-    // can preserve the closing-auction Bar; that endpoint must never be order-eligible.
-    return !delegate_.ResolveSessionKey(exchange_id, instrument_id, update_time).empty();
+    int second_of_day = 0;
+    return CompiledSessionCalendar::ParseSecondOfDay(update_time, &second_of_day) &&
+           IsOrderTime(exchange_id, instrument_id, second_of_day);
+}
+
+bool TradingSessionCalendar::IsMarketDataTime(const std::string& exchange_id,
+                                              const std::string& instrument_id,
+                                              int second_of_day) const {
+    const auto* schedule = sessions_->ResolveInstrument(exchange_id, instrument_id);
+    if (schedule == nullptr || second_of_day < 0 || second_of_day >= kSecondsPerDay) {
+        return false;
+    }
+    const int minute_of_day = second_of_day / 60;
+    return schedule->IsOpen(minute_of_day) ||
+           (second_of_day % 60 == 0 && schedule->IsIntervalEnd(minute_of_day));
+}
+
+bool TradingSessionCalendar::IsOrderTime(const std::string& exchange_id,
+                                         const std::string& instrument_id,
+                                         int second_of_day) const {
+    // Sessions are half-open.  In contrast, IsMarketDataTime deliberately accepts an exact
+    // endpoint tick so the market pipeline can preserve the closing-auction Bar; that endpoint
+    // must never be order-eligible.
+    const auto* schedule = sessions_->ResolveInstrument(exchange_id, instrument_id);
+    return schedule != nullptr && second_of_day >= 0 && second_of_day < kSecondsPerDay &&
+           schedule->IsOpen(second_of_day / 60);
 }
 
 TradingSessionDecision TradingSessionCalendar::EvaluateOrderTime(
@@ -50,10 +67,10 @@ TradingSessionDecision TradingSessionCalendar::EvaluateOrderTime(
     const std::string& trading_day, EpochNanos now_ns, std::int64_t open_guard_ms,
     bool has_fresh_session_tick) const {
     TradingSessionDecision decision;
-    const std::string update_time = TimeOfDay(now_ns);
-    decision.in_session = IsOrderTime(exchange_id, instrument_id, update_time);
+    const int second_of_day = SecondOfDay(now_ns);
+    decision.in_session = IsOrderTime(exchange_id, instrument_id, second_of_day);
     decision.is_session_endpoint =
-        !decision.in_session && IsMarketDataTime(exchange_id, instrument_id, update_time);
+        !decision.in_session && IsMarketDataTime(exchange_id, instrument_id, second_of_day);
     if (!decision.in_session) {
         decision.reason = decision.is_session_endpoint ? "session_endpoint" : "outside_session";
         return decision;
@@ -74,20 +91,13 @@ TradingSessionDecision TradingSessionCalendar::EvaluateOrderTime(
         return decision;
     }
 
-    int ignored_minute = 0;
-    int second = 0;
-    (void)ParseMinute(update_time, &ignored_minute, &second);
-    const auto dot = update_time.find('.');
-    std::int32_t millisec = 0;
-    if (dot != std::string::npos) {
-        try {
-            millisec = std::stoi(update_time.substr(dot + 1, 3));
-        } catch (...) {
-            millisec = 0;
-        }
-    }
+    constexpr std::int64_t kNanosPerMillisecond = 1'000'000LL;
+    constexpr std::int64_t kMillisPerSecond = 1'000LL;
+    const auto millisec = static_cast<std::int32_t>(
+        ((now_ns / kNanosPerMillisecond) % kMillisPerSecond + kMillisPerSecond) %
+        kMillisPerSecond);
     decision.remaining_session_ms =
-        RemainingSessionMillis(exchange_id, instrument_id, update_time, millisec);
+        RemainingSessionMillis(exchange_id, instrument_id, second_of_day, millisec);
     if (decision.remaining_session_ms <= std::max<std::int64_t>(0, open_guard_ms)) {
         decision.reason = "session_end_guard";
         return decision;
@@ -101,28 +111,36 @@ std::int64_t TradingSessionCalendar::RemainingSessionMillis(const std::string& e
                                                             const std::string& instrument_id,
                                                             const std::string& update_time,
                                                             std::int32_t update_millisec) const {
-    int current_minute = 0;
-    int second = 0;
-    if (!ParseMinute(update_time, &current_minute, &second) ||
-        !IsOrderTime(exchange_id, instrument_id, update_time)) {
+    int second_of_day = 0;
+    if (!CompiledSessionCalendar::ParseSecondOfDay(update_time, &second_of_day)) {
+        return 0;
+    }
+    return RemainingSessionMillis(exchange_id, instrument_id, second_of_day, update_millisec);
+}
+
+std::int64_t TradingSessionCalendar::RemainingSessionMillis(const std::string& exchange_id,
+                                                            const std::string& instrument_id,
+                                                            int second_of_day,
+                                                            std::int32_t update_millisec) const {
+    const auto* schedule = sessions_->ResolveInstrument(exchange_id, instrument_id);
+    if (schedule == nullptr || second_of_day < 0 || second_of_day >= kSecondsPerDay) {
         return 0;
     }
-    const std::string key = delegate_.ResolveSessionKey(exchange_id, instrument_id, update_time);
-    int start_minute = 0;
-    int end_minute = 0;
-    if (!ParseSessionKey(key, &start_minute, &end_minute)) {
+    const int current_minute = second_of_day / 60;
+    const auto* interval = schedule->IntervalAt(current_minute);
+    if (interval == nullptr) {
         return 0;
     }
     int remaining_minutes = 0;
-    if (start_minute < end_minute) {
-        remaining_minutes = end_minute - current_minute;
-    } else if (current_minute >= start_minute) {
-        remaining_minutes = (24 * 60 - current_minute) + end_minute;
+    if (interval->start_minute < interval->end_minute) {
+        remaining_minutes = interval->end_minute - current_minute;
+    } else if (current_minute >= interval->start_minute) {
+        remaining_minutes = (24 * 60 - current_minute) + interval->end_minute;
     } else {
-        remaining_minutes = end_minute - current_minute;
+        remaining_minutes = interval->end_minute - current_minute;
     }
-    const std::int64_t elapsed_ms =
-        static_cast<std::int64_t>(second) * 1000 + std::clamp(update_millisec, 0, 999);
+    const std::int64_t elapsed_ms = static_cast<std::int64_t>(second_of_day % 60) * 1000 +
+                                    std::clamp(update_millisec, 0, 999);
     return std::max<std::int64_t>(
         0, static_cast<std::int64_t>(remaining_minutes) * 60'000 - elapsed_ms);
 }
@@ -144,39 +162,14 @@ std::string TradingSessionCalendar::TimeOfDay(EpochNanos ts_ns) const {
     return std::string(buffer);
 }
 
-bool TradingSessionCalendar::ParseMinute(const std::string& text, int* minute_of_day, int* second) {
-    if (minute_of_day == nullptr || second == nullptr || text.size() < 5 || text[2] != ':') {
-        return false;
-    }
-    int hour = 0;
-    int minute = 0;
-    int parsed_second = 0;
-    if (std::sscanf(text.c_str(), "%2d:%2d:%2d", &hour, &minute, &parsed_second) < 2 || hour < 0 ||
-        hour > 23 || minute < 0 || minute > 59 || parsed_second < 0 || parsed_second > 59) {
-        return false;
-    }
-    *minute_of_day = hour * 60 + minute;
-    *second = parsed_second;
-    return true;
-}
-
-bool TradingSessionCalendar::ParseSessionKey(const std::string& key, int* start_minute,
-                                             int* end_minute) {
-    if (start_minute == nullptr || end_minute == nullptr) {
-        return false;
-    }
-    const auto separator = key.find('-');
-    if (separator == std::string::npos) {
-        return false;
-    }
-    try {
-        *start_minute = std::stoi(key.substr(0, separator));
-        *end_minute = std::stoi(key.substr(separator + 1));
-    } catch (...) {
-        return false;
+int TradingSessionCalendar::SecondOfDay(EpochNanos ts_ns) const {
+    constexpr std::int64_t kNanosPerSecond = 1'000'000'000LL;
+    std::int64_t seconds = ts_ns / kNanosPerSecond;
+    if (ts_ns % kNanosPerSecond < 0) {
+        --seconds;
     }
-    return *start_minute >= 0 && *start_minute < 24 * 60 && *end_minute >= 0 &&
-           *end_minute < 24 * 60;
+    seconds += static_cast<std::int64_t>(config_.timezone_offset_hours) * 60 * 60;
+    return static_cast<int>(((seconds % kSecondsPerDay) + kSecondsPerDay) % kSecondsPerDay);
 }
 
 }  // namespace quant_hft
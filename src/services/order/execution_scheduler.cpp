@@ -0,0 +1,229 @@
+#include "quant_hft/services/execution_scheduler.h"
+
+#include <algorithm>
+
+#include "quant_hft/core/structured_log.h"
+#include "quant_hft/monitoring/metric_registry.h"
+
+namespace quant_hft {
+
+namespace {
+
+std::int64_t ToNs(ExecutionScheduler::Clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+}
+
+std::shared_ptr<MonitoringCounter> SchedulerRejectedCounter() {
+    static auto counter = MetricRegistry::Instance().BuildCounter(
+        "quant_hft_execution_scheduler_rejected_total",
+        "Total order submissions rejected by ExecutionScheduler");
+    return counter;
+}
+
+std::shared_ptr<MonitoringGauge> SchedulerPendingGauge() {
+    static auto gauge = MetricRegistry::Instance().BuildGauge(
+        "quant_hft_execution_scheduler_pending", "Pending order submissions in ExecutionScheduler");
+    return gauge;
+}
+
+}  // namespace
+
+ExecutionScheduler::ExecutionScheduler(std::size_t lane_count, std::size_t max_pending)
+    : max_pending_(std::max<std::size_t>(1, max_pending)) {
+    const std::size_t normalized_lanes = std::max<std::size_t>(1, lane_count);
+    lanes_.reserve(normalized_lanes);
+    for (std::size_t index = 0; index < normalized_lanes; ++index) {
+        lanes_.push_back(std::make_unique<Lane>());
+    }
+}
+
+ExecutionScheduler::~ExecutionScheduler() { Stop(); }
+
+void ExecutionScheduler::Start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    stop_ = false;
+    running_ = true;
+    timer_worker_ = std::thread(&ExecutionScheduler::TimerLoop, this);
+    for (std::size_t index = 0; index < lanes_.size(); ++index) {
+        lanes_[index]->worker = std::thread(&ExecutionScheduler::LaneLoop, this, index);
+    }
+}
+
+void ExecutionScheduler::Stop() {
+    std::thread timer_worker;
+    std::vector<std::thread> lane_workers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        stop_ = true;
+        running_ = false;
+        timer_worker.swap(timer_worker_);
+        for (auto& lane : lanes_) {
+            lane_workers.push_back(std::move(lane->worker));
+        }
+    }
+    timer_cv_.notify_all();
+    if (timer_worker.joinable()) {
+        timer_worker.join();
+    }
+    for (auto& lane : lanes_) {
+        lane->cv.notify_all();
+    }
+    for (auto& worker : lane_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    std::size_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dropped = stats_.dropped_on_stop;
+        SchedulerPendingGauge()->Set(static_cast<double>(PendingLocked()));
+    }
+    idle_cv_.notify_all();
+    if (dropped > 0) {
+        EmitStructuredLog(nullptr, "execution_scheduler", "warn", "pending_timers_dropped",
+                          {{"dropped_total", std::to_string(dropped)}});
+    }
+}
+
+bool ExecutionScheduler::ScheduleAt(const std::string& lane_key, Clock::time_point due,
+                                    Task task) {
+    if (!task) {
+        return false;
+    }
+    std::size_t pending = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || stop_ || PendingLocked() >= max_pending_) {
+            ++stats_.rejected;
+            SchedulerRejectedCounter()->Increment();
+            return false;
+        }
+        timers_.emplace(std::make_pair(ToNs(due), next_sequence_++),
+                        std::make_pair(LaneIndex(lane_key), std::move(task)));
+        ++stats_.scheduled;
+        pending = PendingLocked();
+        stats_.max_pending = std::max(stats_.max_pending, pending);
+    }
+    SchedulerPendingGauge()->Set(static_cast<double>(pending));
+    timer_cv_.notify_one();
+    return true;
+}
+
+bool ExecutionScheduler::ScheduleAfter(const std::string& lane_key,
+                                       std::chrono::milliseconds delay, Task task) {
+    return ScheduleAt(lane_key, Clock::now() + std::max(std::chrono::milliseconds(0), delay),
+                      std::move(task));
+}
+
+bool ExecutionScheduler::WaitUntilIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return idle_cv_.wait_for(lock, timeout, [this]() { return IdleLocked(); });
+}
+
+ExecutionScheduler::Stats ExecutionScheduler::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.pending_timers = timers_.size();
+    stats.pending_dispatch = PendingLocked() - timers_.size();
+    return stats;
+}
+
+void ExecutionScheduler::TimerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        const auto now_ns = ToNs(Clock::now());
+        while (!timers_.empty() && (timers_.begin()->first.first <= now_ns || stop_)) {
+            auto node = timers_.extract(timers_.begin());
+            if (node.key().first > now_ns) {
+                // Stop requested: timers that are not due yet never reserved anything, so they
+                // are dropped instead of being submitted early.
+                ++stats_.dropped_on_stop;
+                continue;
+            }
+            auto& lane = *lanes_[node.mapped().first];
+            lane.queue.emplace_back(Clock::time_point(std::chrono::nanoseconds(node.key().first)),
+                                    std::move(node.mapped().second));
+            lane.cv.notify_one();
+        }
+        if (stop_) {
+            return;
+        }
+        if (timers_.empty()) {
+            idle_cv_.notify_all();
+            timer_cv_.wait(lock, [this]() { return stop_ || !timers_.empty(); });
+            continue;
+        }
+        const auto next_due =
+            Clock::time_point(std::chrono::nanoseconds(timers_.begin()->first.first));
+        timer_cv_.wait_until(lock, next_due);
+    }
+}
+
+void ExecutionScheduler::LaneLoop(std::size_t lane_index) {
+    Lane& lane = *lanes_[lane_index];
+    while (true) {
+        std::pair<Clock::time_point, Task> entry;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            lane.cv.wait(lock, [this, &lane]() { return stop_ || !lane.queue.empty(); });
+            if (lane.queue.empty()) {
+                return;
+            }
+            entry = std::move(lane.queue.front());
+            lane.queue.pop_front();
+            lane.busy = true;
+            const auto delay_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                      Clock::now() - entry.first)
+                                      .count();
+            stats_.max_dispatch_delay_ms =
+                std::max<std::int64_t>(stats_.max_dispatch_delay_ms, delay_ms);
+        }
+
+        if (entry.second) {
+            entry.second();
+        }
+
+        std::size_t pending = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lane.busy = false;
+            ++stats_.executed;
+            pending = PendingLocked();
+        }
+        SchedulerPendingGauge()->Set(static_cast<double>(pending));
+        idle_cv_.notify_all();
+    }
+}
+
+std::size_t ExecutionScheduler::LaneIndex(const std::string& lane_key) const {
+    if (lanes_.size() == 1) {
+        return 0;
+    }
+    return std::hash<std::string>{}(lane_key) % lanes_.size();
+}
+
+std::size_t ExecutionScheduler::PendingLocked() const {
+    std::size_t pending = timers_.size();
+    for (const auto& lane : lanes_) {
+        pending += lane->queue.size();
+    }
+    return pending;
+}
+
+bool ExecutionScheduler::IdleLocked() const {
+    if (!timers_.empty()) {
+        return false;
+    }
+    return std::all_of(lanes_.begin(), lanes_.end(), [](const std::unique_ptr<Lane>& lane) {
+        return lane->queue.empty() && !lane->busy;
+    });
+}
+
+}  // namespace quant_hft
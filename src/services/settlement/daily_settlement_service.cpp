@@ -6,10 +6,12 @@
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 #include "quant_hft/monitoring/metric_registry.h"
 
@@ -368,15 +370,13 @@ bool DailySettlementService::Run(const DailySettlementConfig& config, DailySettl
     result->reconcile_diff_count = reconcile.diffs.size();
 
     if (reconcile.blocked) {
-        for (const auto& diff : reconcile.diffs) {
-            SettlementReconcileDiffCounter()->Increment();
-            std::string diff_error;
-            if (!store_->AppendReconcileDiff(diff, &diff_error)) {
-                if (error != nullptr) {
-                    *error = "append reconcile diff failed: " + diff_error;
-                }
-                return false;
+        SettlementReconcileDiffCounter()->Increment(static_cast<double>(reconcile.diffs.size()));
+        std::string diff_error;
+        if (!store_->AppendReconcileDiffs(reconcile.diffs, &diff_error)) {
+            if (error != nullptr) {
+                *error = "append reconcile diff failed: " + diff_error;
             }
+            return false;
         }
         if (!GenerateDiffReport(config, reconcile.diffs, error)) {
             return false;
@@ -506,14 +506,29 @@ bool DailySettlementService::LoadSettlementPrices(
     }
 
     std::vector<std::string> instrument_ids(instrument_set.begin(), instrument_set.end());
+    std::sort(instrument_ids.begin(), instrument_ids.end());
     if (!store_->LoadInstruments(instrument_ids, instruments, error)) {
         return false;
     }
 
+    std::unordered_map<std::string, std::pair<double, SettlementPriceSource>> prefetched;
+    if (config.prefetch_settlement_prices) {
+        prefetched = price_provider_->BatchGetSettlementPrices(instrument_ids, config.trading_day);
+    }
+
     std::vector<std::string> missing;
+    std::vector<SettlementPriceRecord> price_records;
+    price_records.reserve(instrument_ids.size());
     const EpochNanos now_ts = NowEpochNanos();
     for (const auto& instrument_id : instrument_ids) {
-        auto price = price_provider_->GetSettlementPrice(instrument_id, config.trading_day);
+        std::optional<std::pair<double, SettlementPriceSource>> price;
+        if (config.prefetch_settlement_prices) {
+            if (const auto it = prefetched.find(instrument_id); it != prefetched.end()) {
+                price = it->second;
+            }
+        } else {
+            price = price_provider_->GetSettlementPrice(instrument_id, config.trading_day);
+        }
         if (!price.has_value()) {
             SettlementPriceRecord missing_record;
             missing_record.trading_day = config.trading_day;
@@ -527,8 +542,7 @@ bool DailySettlementService::LoadSettlementPrices(
             missing_record.has_settlement_price = false;
             missing_record.is_final = false;
             missing_record.created_ts_ns = now_ts;
-            std::string persist_error;
-            (void)store_->AppendPrice(missing_record, &persist_error);
+            price_records.push_back(std::move(missing_record));
             missing.push_back(instrument_id);
             continue;
         }
@@ -556,11 +570,14 @@ bool DailySettlementService::LoadSettlementPrices(
         price_record.settlement_price = price->first;
         price_record.is_final = true;
         price_record.created_ts_ns = now_ts;
-
-        std::string persist_error;
-        (void)store_->AppendPrice(price_record, &persist_error);
+        price_records.push_back(std::move(price_record));
     }
 
+    // Price evidence is best effort, as it was per row; one statement covers
+    // every instrument.
+    std::string persist_error;
+    (void)store_->AppendPrices(price_records, &persist_error);
+
     if (!missing.empty()) {
         if (error != nullptr) {
             std::ostringstream stream;
@@ -591,21 +608,14 @@ bool DailySettlementService::RunSettlementLoop(
     }
     *total_position_profit_cents = 0;
 
-    std::string tx_error;
-    if (!store_->BeginTransaction(&tx_error)) {
-        if (error != nullptr) {
-            *error = "begin transaction failed: " + tx_error;
-        }
-        return false;
-    }
-
-    bool committed = false;
+    // Profits are computed up front so the position updates and detail rows go
+    // to the store as two set-based writes inside one transaction.
+    std::vector<SettlementDetailRecord> details;
+    details.reserve(positions->size());
     const EpochNanos now_ts = NowEpochNanos();
     for (auto& position : *positions) {
         const auto price_it = final_prices.find(position.instrument_id);
         if (price_it == final_prices.end()) {
-            std::string rollback_error;
-            (void)store_->RollbackTransaction(&rollback_error);
             if (error != nullptr) {
                 *error = "missing settlement price for " + position.instrument_id;
             }
@@ -613,8 +623,6 @@ bool DailySettlementService::RunSettlementLoop(
         }
         const auto instrument_it = instruments.find(position.instrument_id);
         if (instrument_it == instruments.end()) {
-            std::string rollback_error;
-            (void)store_->RollbackTransaction(&rollback_error);
             if (error != nullptr) {
                 *error = "missing instrument meta for " + position.instrument_id;
             }
@@ -639,16 +647,6 @@ bool DailySettlementService::RunSettlementLoop(
         position.update_ts_ns = now_ts;
         *total_position_profit_cents += profit_cents;
 
-        std::string update_error;
-        if (!store_->UpdatePositionAfterSettlement(position, &update_error)) {
-            std::string rollback_error;
-            (void)store_->RollbackTransaction(&rollback_error);
-            if (error != nullptr) {
-                *error = "update position failed: " + update_error;
-            }
-            return false;
-        }
-
         SettlementDetailRecord detail;
         detail.trading_day = config.trading_day;
         detail.settlement_id = 0;
@@ -658,31 +656,44 @@ bool DailySettlementService::RunSettlementLoop(
         detail.settlement_price = price_it->second;
         detail.profit = position.last_settlement_profit;
         detail.created_ts_ns = now_ts;
+        details.push_back(std::move(detail));
+    }
 
-        std::string detail_error;
-        if (!store_->AppendDetail(detail, &detail_error)) {
-            std::string rollback_error;
-            (void)store_->RollbackTransaction(&rollback_error);
-            if (error != nullptr) {
-                *error = "append settlement detail failed: " + detail_error;
-            }
-            return false;
+    std::string tx_error;
+    if (!store_->BeginTransaction(&tx_error)) {
+        if (error != nullptr) {
+            *error = "begin transaction failed: " + tx_error;
         }
+        return false;
     }
 
-    if (!store_->CommitTransaction(&tx_error)) {
+    std::string update_error;
+    if (!store_->UpdatePositionsAfterSettlement(*positions, &update_error)) {
         std::string rollback_error;
         (void)store_->RollbackTransaction(&rollback_error);
         if (error != nullptr) {
-            *error = "commit transaction failed: " + tx_error;
+            *error = "update position failed: " + update_error;
         }
         return false;
     }
-    committed = true;
 
-    if (!committed) {
+    std::string detail_error;
+    if (!store_->AppendDetails(details, &detail_error)) {
         std::string rollback_error;
         (void)store_->RollbackTransaction(&rollback_error);
+        if (error != nullptr) {
+            *error = "append settlement detail failed: " + detail_error;
+        }
+        return false;
+    }
+
+    if (!store_->CommitTransaction(&tx_error)) {
+        std::string rollback_error;
+        (void)store_->RollbackTransaction(&rollback_error);
+        if (error != nullptr) {
+            *error = "commit transaction failed: " + tx_error;
+        }
+        return false;
     }
     return true;
 }
@@ -938,16 +949,23 @@ bool DailySettlementService::VerifyAgainstCTP(const DailySettlementConfig& confi
         }
     }
 
-    std::unordered_set<std::string> instruments;
+    std::vector<std::string> instruments;
+    instruments.reserve(local_agg.size() + ctp_agg.size());
     for (const auto& [instrument_id, _] : local_agg) {
         (void)_;
-        instruments.insert(instrument_id);
+        instruments.push_back(instrument_id);
     }
     for (const auto& [instrument_id, _] : ctp_agg) {
         (void)_;
-        instruments.insert(instrument_id);
+        if (local_agg.find(instrument_id) == local_agg.end()) {
+            instruments.push_back(instrument_id);
+        }
     }
+    // Sorted instruments keep the diff order, and with it the persisted rows and
+    // the diff report, identical across runs.
+    std::sort(instruments.begin(), instruments.end());
 
+    const EpochNanos diff_ts_ns = NowEpochNanos();
     auto append_position_diff = [&](const std::string& instrument_id, const std::string& field,
                                     int local_value, int ctp_value) {
         if (local_value == ctp_value) {
@@ -963,7 +981,7 @@ bool DailySettlementService::VerifyAgainstCTP(const DailySettlementConfig& confi
         diff.delta_value = static_cast<double>(local_value - ctp_value);
         diff.diagnose_hint = "check order/trade replay and offset mapping";
         diff.raw_payload = "{}";
-        diff.created_ts_ns = NowEpochNanos();
+        diff.created_ts_ns = diff_ts_ns;
         reconcile_result->diffs.push_back(std::move(diff));
     };
 
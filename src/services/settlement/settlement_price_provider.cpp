@@ -10,7 +10,9 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace quant_hft {
 namespace {
@@ -40,6 +42,7 @@ struct SqliteApi {
     using PrepareFn = int (*)(sqlite3*, const char*, int, sqlite3_stmt**, const char**);
     using StepFn = int (*)(sqlite3_stmt*);
     using FinalizeFn = int (*)(sqlite3_stmt*);
+    using ResetFn = int (*)(sqlite3_stmt*);
     using BindTextFn = int (*)(sqlite3_stmt*, int, const char*, int, SqliteDestructor);
     using BindDoubleFn = int (*)(sqlite3_stmt*, int, double);
     using BindInt64Fn = int (*)(sqlite3_stmt*, int, long long);
@@ -58,6 +61,7 @@ struct SqliteApi {
     PrepareFn prepare{nullptr};
     StepFn step{nullptr};
     FinalizeFn finalize{nullptr};
+    ResetFn reset{nullptr};
     BindTextFn bind_text{nullptr};
     BindDoubleFn bind_double{nullptr};
     BindInt64Fn bind_int64{nullptr};
@@ -113,6 +117,7 @@ SqliteApi LoadSqliteApi() {
         !LoadSymbol(api.handle, "sqlite3_prepare_v2", &api.prepare, &error) ||
         !LoadSymbol(api.handle, "sqlite3_step", &api.step, &error) ||
         !LoadSymbol(api.handle, "sqlite3_finalize", &api.finalize, &error) ||
+        !LoadSymbol(api.handle, "sqlite3_reset", &api.reset, &error) ||
         !LoadSymbol(api.handle, "sqlite3_bind_text", &api.bind_text, &error) ||
         !LoadSymbol(api.handle, "sqlite3_bind_double", &api.bind_double, &error) ||
         !LoadSymbol(api.handle, "sqlite3_bind_int64", &api.bind_int64, &error) ||
@@ -202,13 +207,50 @@ public:
     std::unordered_map<std::string, std::pair<double, SettlementPriceSource>> BatchGetSettlementPrices(
         const std::vector<std::string>& instrument_ids,
         const std::string& trading_day) {
+        std::lock_guard<std::mutex> lock(mutex_);
         std::unordered_map<std::string, std::pair<double, SettlementPriceSource>> prices;
+        if (trading_day.empty()) {
+            return prices;
+        }
+        // One pass over each sqlite table for the whole day replaces a pair of
+        // point queries per instrument; later lookups for the day stay in memory.
+        PrefetchTradingDay(trading_day);
+        if (!api_price_json_path_.empty()) {
+            RefreshApiJsonCache();
+        }
+
+        std::vector<std::pair<std::string, double>> api_rows;
         for (const auto& instrument_id : instrument_ids) {
-            auto price = GetSettlementPrice(instrument_id, trading_day);
-            if (price.has_value()) {
-                prices[instrument_id] = *price;
+            if (instrument_id.empty() || prices.count(instrument_id) > 0) {
+                continue;
+            }
+            const std::string key = BuildKey(trading_day, instrument_id);
+            if (const auto it = manual_cache_.find(key); it != manual_cache_.end()) {
+                prices.emplace(instrument_id,
+                               std::make_pair(it->second,
+                                              SettlementPriceSource{
+                                                  SettlementPriceSource::SourceType::kManual,
+                                                  "manual in-memory"}));
+                continue;
+            }
+            if (const auto it = api_prices_.find(instrument_id); it != api_prices_.end()) {
+                api_rows.emplace_back(instrument_id, it->second);
+                prices.emplace(instrument_id,
+                               std::make_pair(it->second,
+                                              SettlementPriceSource{
+                                                  SettlementPriceSource::SourceType::kApi,
+                                                  "api price json"}));
+                continue;
+            }
+            if (const auto it = cache_prices_.find(key); it != cache_prices_.end()) {
+                prices.emplace(instrument_id,
+                               std::make_pair(it->second,
+                                              SettlementPriceSource{
+                                                  SettlementPriceSource::SourceType::kCache,
+                                                  "cache in-memory"}));
             }
         }
+        StoreCacheBatch(trading_day, api_rows, "API");
         return prices;
     }
 
@@ -307,6 +349,54 @@ private:
         return true;
     }
 
+    // Loads every manual override and cached price of the day into memory once.
+    void PrefetchTradingDay(const std::string& trading_day) {
+        if (!sqlite_ready_ || prefetched_days_.count(trading_day) > 0) {
+            return;
+        }
+        sqlite3* db = nullptr;
+        if (!OpenSqlite(&db)) {
+            return;
+        }
+        const bool manual_ok = LoadDayRows(
+            db,
+            "SELECT instrument_id, price FROM manual_settlement_price_overrides "
+            "WHERE trading_day=?;",
+            trading_day, &manual_cache_);
+        const bool cache_ok = LoadDayRows(
+            db,
+            "SELECT instrument_id, price FROM settlement_price_cache WHERE trading_day=?;",
+            trading_day, &cache_prices_);
+        (void)sqlite_api_.close(db);
+        if (manual_ok && cache_ok) {
+            prefetched_days_.insert(trading_day);
+        }
+    }
+
+    bool LoadDayRows(sqlite3* db,
+                     const char* sql,
+                     const std::string& trading_day,
+                     std::unordered_map<std::string, double>* out) {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite_api_.prepare(db, sql, -1, &stmt, nullptr) != kSqliteOk || stmt == nullptr) {
+            return false;
+        }
+        (void)sqlite_api_.bind_text(stmt, 1, trading_day.c_str(), -1, SqliteTransient());
+        int step = kSqliteRow;
+        while ((step = sqlite_api_.step(stmt)) == kSqliteRow) {
+            const auto* instrument_raw = sqlite_api_.column_text(stmt, 0);
+            if (instrument_raw == nullptr) {
+                continue;
+            }
+            const std::string key =
+                BuildKey(trading_day, reinterpret_cast<const char*>(instrument_raw));
+            // In-memory entries are at least as new as the table rows.
+            out->emplace(key, sqlite_api_.column_double(stmt, 1));
+        }
+        (void)sqlite_api_.finalize(stmt);
+        return step == kSqliteDone;
+    }
+
     bool LoadManual(const std::string& trading_day,
                     const std::string& instrument_id,
                     double* out_price,
@@ -322,7 +412,7 @@ private:
             }
             return true;
         }
-        if (!sqlite_ready_) {
+        if (!sqlite_ready_ || prefetched_days_.count(trading_day) > 0) {
             return false;
         }
 
@@ -377,7 +467,7 @@ private:
             }
             return true;
         }
-        if (!sqlite_ready_) {
+        if (!sqlite_ready_ || prefetched_days_.count(trading_day) > 0) {
             return false;
         }
 
@@ -499,7 +589,20 @@ private:
                     const std::string& instrument_id,
                     double price,
                     const std::string& source) {
-        cache_prices_[BuildKey(trading_day, instrument_id)] = price;
+        StoreCacheBatch(trading_day, {{instrument_id, price}}, source);
+    }
+
+    // Writes all rows through one prepared statement inside one sqlite
+    // transaction.
+    void StoreCacheBatch(const std::string& trading_day,
+                         const std::vector<std::pair<std::string, double>>& rows,
+                         const std::string& source) {
+        if (rows.empty()) {
+            return;
+        }
+        for (const auto& [instrument_id, price] : rows) {
+            cache_prices_[BuildKey(trading_day, instrument_id)] = price;
+        }
         if (!sqlite_ready_) {
             return;
         }
@@ -527,13 +630,22 @@ private:
                 std::chrono::system_clock::now().time_since_epoch())
                 .count());
 
-        (void)sqlite_api_.bind_text(stmt, 1, trading_day.c_str(), -1, SqliteTransient());
-        (void)sqlite_api_.bind_text(stmt, 2, instrument_id.c_str(), -1, SqliteTransient());
-        (void)sqlite_api_.bind_double(stmt, 3, price);
-        (void)sqlite_api_.bind_text(stmt, 4, source.c_str(), -1, SqliteTransient());
-        (void)sqlite_api_.bind_int64(stmt, 5, now_sec);
-        (void)sqlite_api_.step(stmt);
+        const bool in_transaction = rows.size() > 1 &&
+                                    sqlite_api_.exec(db, "BEGIN;", nullptr, nullptr, nullptr) ==
+                                        kSqliteOk;
+        for (const auto& [instrument_id, price] : rows) {
+            (void)sqlite_api_.bind_text(stmt, 1, trading_day.c_str(), -1, SqliteTransient());
+            (void)sqlite_api_.bind_text(stmt, 2, instrument_id.c_str(), -1, SqliteTransient());
+            (void)sqlite_api_.bind_double(stmt, 3, price);
+            (void)sqlite_api_.bind_text(stmt, 4, source.c_str(), -1, SqliteTransient());
+            (void)sqlite_api_.bind_int64(stmt, 5, now_sec);
+            (void)sqlite_api_.step(stmt);
+            (void)sqlite_api_.reset(stmt);
+        }
         (void)sqlite_api_.finalize(stmt);
+        if (in_transaction) {
+            (void)sqlite_api_.exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+        }
         (void)sqlite_api_.close(db);
     }
 
@@ -546,6 +658,7 @@ private:
     std::unordered_map<std::string, double> manual_cache_;
     std::unordered_map<std::string, double> cache_prices_;
     std::unordered_map<std::string, double> api_prices_;
+    std::unordered_set<std::string> prefetched_days_;
     long long api_json_stamp_{0};
 };
 
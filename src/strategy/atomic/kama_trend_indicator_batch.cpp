@@ -0,0 +1,158 @@
+#include "quant_hft/strategy/atomic/kama_trend_indicator_batch.h"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <utility>
+
+namespace quant_hft {
+namespace {
+
+thread_local std::shared_ptr<KamaTrendIndicatorBatch> g_current_batch;
+
+template <typename Key>
+std::size_t InternLane(const Key& key, std::map<Key, std::size_t>* lanes) {
+    return lanes->emplace(key, lanes->size()).first->second;
+}
+
+}  // namespace
+
+KamaTrendIndicatorBatch::KamaTrendIndicatorBatch(std::vector<KamaTrendIndicatorSpec> specs) {
+    for (const KamaTrendIndicatorSpec& spec : specs) {
+        if (std::find(specs_.begin(), specs_.end(), spec) == specs_.end()) {
+            specs_.push_back(spec);
+        }
+    }
+
+    std::map<std::tuple<int, int, int>, std::size_t> kama_lanes;
+    std::map<int, std::size_t> adx_lanes;
+    std::map<int, std::size_t> atr_lanes;
+    lanes_.reserve(specs_.size());
+    for (const KamaTrendIndicatorSpec& spec : specs_) {
+        Lanes lanes;
+        lanes.kama = InternLane(std::make_tuple(spec.er_period, spec.fast_period, spec.slow_period),
+                                &kama_lanes);
+        lanes.adx = InternLane(spec.adx_period, &adx_lanes);
+        if (spec.stop_loss_atr_period > 0) {
+            lanes.stop_loss_atr = InternLane(spec.stop_loss_atr_period, &atr_lanes);
+        }
+        if (spec.take_profit_atr_period > 0) {
+            lanes.take_profit_atr = InternLane(spec.take_profit_atr_period, &atr_lanes);
+        }
+        lanes_.push_back(lanes);
+    }
+
+    std::vector<BatchKAMA::Params> kama_params(kama_lanes.size());
+    for (const auto& [key, lane] : kama_lanes) {
+        kama_params[lane].er_period = std::get<0>(key);
+        kama_params[lane].fast_period = std::get<1>(key);
+        kama_params[lane].slow_period = std::get<2>(key);
+    }
+    std::vector<int> adx_periods(adx_lanes.size());
+    for (const auto& [period, lane] : adx_lanes) {
+        adx_periods[lane] = period;
+    }
+    std::vector<int> atr_periods(atr_lanes.size());
+    for (const auto& [period, lane] : atr_lanes) {
+        atr_periods[lane] = period;
+    }
+    kama_.emplace(std::move(kama_params));
+    adx_.emplace(std::move(adx_periods));
+    atr_.emplace(std::move(atr_periods));
+    slots_per_step_ = 2 * kama_->lane_count() + adx_->lane_count() + atr_->lane_count();
+}
+
+std::optional<std::size_t> KamaTrendIndicatorBatch::Find(
+    const KamaTrendIndicatorSpec& spec) const {
+    const auto it = std::find(specs_.begin(), specs_.end(), spec);
+    if (it == specs_.end()) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(it - specs_.begin());
+}
+
+bool KamaTrendIndicatorBatch::Values(std::size_t index, std::size_t step,
+                                     const KamaTrendIndicatorBar& bar,
+                                     KamaTrendIndicatorValues* out) {
+    if (out == nullptr || index >= lanes_.size()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (step == bars_.size()) {
+        RecordStepLocked(bar);
+    } else if (step > bars_.size()) {
+        return false;
+    } else {
+        const KamaTrendIndicatorBar& recorded = bars_[step];
+        if (recorded.high != bar.high || recorded.low != bar.low || recorded.close != bar.close) {
+            return false;
+        }
+    }
+
+    const Lanes& lanes = lanes_[index];
+    const std::size_t adx_base = 2 * kama_->lane_count();
+    const std::size_t atr_base = adx_base + adx_->lane_count();
+    out->kama = RecordedLocked(step, 2 * lanes.kama);
+    out->efficiency_ratio = RecordedLocked(step, 2 * lanes.kama + 1);
+    out->adx = RecordedLocked(step, adx_base + lanes.adx);
+    out->stop_loss_atr.reset();
+    out->take_profit_atr.reset();
+    if (lanes.stop_loss_atr.has_value()) {
+        out->stop_loss_atr = RecordedLocked(step, atr_base + *lanes.stop_loss_atr);
+    }
+    if (lanes.take_profit_atr.has_value()) {
+        out->take_profit_atr = RecordedLocked(step, atr_base + *lanes.take_profit_atr);
+    }
+    return true;
+}
+
+std::vector<KamaTrendIndicatorBar> KamaTrendIndicatorBatch::RecordedBars(std::size_t steps) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::size_t count = std::min(steps, bars_.size());
+    return std::vector<KamaTrendIndicatorBar>(bars_.begin(),
+                                              bars_.begin() + static_cast<std::ptrdiff_t>(count));
+}
+
+void KamaTrendIndicatorBatch::RecordStepLocked(const KamaTrendIndicatorBar& bar) {
+    kama_->Update(bar.high, bar.low, bar.close);
+    adx_->Update(bar.high, bar.low, bar.close);
+    atr_->Update(bar.high, bar.low, bar.close);
+    bars_.push_back(bar);
+
+    const auto record = [this](const std::optional<double>& value) {
+        values_.push_back(value.value_or(0.0));
+        has_value_.push_back(value.has_value() ? 1 : 0);
+    };
+    for (std::size_t lane = 0; lane < kama_->lane_count(); ++lane) {
+        record(kama_->Value(lane));
+        record(kama_->EfficiencyRatio(lane));
+    }
+    for (std::size_t lane = 0; lane < adx_->lane_count(); ++lane) {
+        record(adx_->Value(lane));
+    }
+    for (std::size_t lane = 0; lane < atr_->lane_count(); ++lane) {
+        record(atr_->Value(lane));
+    }
+}
+
+std::optional<double> KamaTrendIndicatorBatch::RecordedLocked(std::size_t step,
+                                                              std::size_t slot) const {
+    const std::size_t offset = step * slots_per_step_ + slot;
+    if (has_value_[offset] == 0) {
+        return std::nullopt;
+    }
+    return values_[offset];
+}
+
+KamaTrendIndicatorBatch::Scope::Scope(std::shared_ptr<KamaTrendIndicatorBatch> batch)
+    : previous_(std::move(g_current_batch)) {
+    g_current_batch = std::move(batch);
+}
+
+KamaTrendIndicatorBatch::Scope::~Scope() { g_current_batch = std::move(previous_); }
+
+std::shared_ptr<KamaTrendIndicatorBatch> KamaTrendIndicatorBatch::Current() {
+    return g_current_batch;
+}
+
+}  // namespace quant_hft
@@ -523,6 +523,16 @@ void KamaTrendStrategy::Init(const AtomicParams& params) {
     if (take_profit_mode_ == "atr_target") {
         take_profit_atr_ = std::make_unique<ATR>(take_profit_atr_period_);
     }
+    shared_indicators_ = KamaTrendIndicatorBatch::Current();
+    shared_indicator_step_ = 0;
+    if (shared_indicators_ != nullptr) {
+        const std::optional<std::size_t> index = shared_indicators_->Find(IndicatorSpec());
+        if (index.has_value()) {
+            shared_indicator_index_ = *index;
+        } else {
+            shared_indicators_.reset();
+        }
+    }
     kama_recent_.clear();
     kama_window_.clear();
     kama_window_sum_ = 0.0;
@@ -564,6 +574,7 @@ void KamaTrendStrategy::Reset() {
     if (take_profit_atr_ != nullptr) {
         take_profit_atr_->Reset();
     }
+    shared_indicator_step_ = 0;
     kama_recent_.clear();
     kama_window_.clear();
     kama_window_sum_ = 0.0;
@@ -617,30 +628,21 @@ std::vector<SignalIntent> KamaTrendStrategy::OnState(const StateSnapshot7D& stat
         return {};
     }
 
-    kama_->Update(analysis_high, analysis_low, analysis_close, state.bar_volume);
-    if (adx_ != nullptr) {
-        adx_->Update(analysis_high, analysis_low, analysis_close, state.bar_volume);
-    }
-    if (stop_loss_atr_ != nullptr) {
-        stop_loss_atr_->Update(analysis_high, analysis_low, analysis_close, state.bar_volume);
-    }
-    if (take_profit_atr_ != nullptr) {
-        take_profit_atr_->Update(analysis_high, analysis_low, analysis_close, state.bar_volume);
-    }
-
-    if (kama_->IsReady()) {
-        last_kama_ = kama_->Value();
-        last_er_ = kama_->EfficiencyRatio();
-    }
-    if (adx_ != nullptr && adx_->IsReady()) {
-        last_adx_ = adx_->Value();
-    }
-    if (stop_loss_atr_ != nullptr && stop_loss_atr_->IsReady()) {
-        last_stop_atr_ = stop_loss_atr_->Value();
-    }
-    if (take_profit_atr_ != nullptr && take_profit_atr_->IsReady()) {
-        last_take_atr_ = take_profit_atr_->Value();
+    const KamaTrendIndicatorBar bar{analysis_high, analysis_low, analysis_close};
+    KamaTrendIndicatorValues values;
+    if (shared_indicators_ != nullptr &&
+        shared_indicators_->Values(shared_indicator_index_, shared_indicator_step_, bar, &values)) {
+        ++shared_indicator_step_;
+    } else {
+        DetachSharedIndicators();
+        UpdateOwnIndicators(bar);
+        values = OwnIndicatorValues();
     }
+    last_kama_ = values.kama;
+    last_er_ = values.efficiency_ratio;
+    last_adx_ = values.adx;
+    last_stop_atr_ = values.stop_loss_atr;
+    last_take_atr_ = values.take_profit_atr;
 
     if (last_kama_.has_value() && std::isfinite(*last_kama_)) {
         kama_recent_.push_back(*last_kama_);
@@ -895,18 +897,42 @@ bool KamaTrendStrategy::SaveState(AtomicState* out, std::string* error) const {
         return false;
     }
 
+    KAMA kama = *kama_;
+    ADX adx = *adx_;
+    std::optional<ATR> stop_atr;
+    std::optional<ATR> take_atr;
+    if (stop_loss_atr_ != nullptr) {
+        stop_atr = *stop_loss_atr_;
+    }
+    if (take_profit_atr_ != nullptr) {
+        take_atr = *take_profit_atr_;
+    }
+    if (shared_indicators_ != nullptr) {
+        for (const KamaTrendIndicatorBar& bar :
+             shared_indicators_->RecordedBars(shared_indicator_step_)) {
+            kama.Update(bar.high, bar.low, bar.close);
+            adx.Update(bar.high, bar.low, bar.close);
+            if (stop_atr.has_value()) {
+                stop_atr->Update(bar.high, bar.low, bar.close);
+            }
+            if (take_atr.has_value()) {
+                take_atr->Update(bar.high, bar.low, bar.close);
+            }
+        }
+    }
+
     out->clear();
     (*out)["version"] = "1";
     (*out)["id"] = id_;
-    WriteKamaState(out, "kama", kama_->ExportState());
-    WriteAdxState(out, "adx", adx_->ExportState());
-    (*out)["stop_atr.enabled"] = FormatStateBool(stop_loss_atr_ != nullptr);
-    if (stop_loss_atr_ != nullptr) {
-        WriteAtrState(out, "stop_atr", stop_loss_atr_->ExportState());
+    WriteKamaState(out, "kama", kama.ExportState());
+    WriteAdxState(out, "adx", adx.ExportState());
+    (*out)["stop_atr.enabled"] = FormatStateBool(stop_atr.has_value());
+    if (stop_atr.has_value()) {
+        WriteAtrState(out, "stop_atr", stop_atr->ExportState());
     }
-    (*out)["take_atr.enabled"] = FormatStateBool(take_profit_atr_ != nullptr);
-    if (take_profit_atr_ != nullptr) {
-        WriteAtrState(out, "take_atr", take_profit_atr_->ExportState());
+    (*out)["take_atr.enabled"] = FormatStateBool(take_atr.has_value());
+    if (take_atr.has_value()) {
+        WriteAtrState(out, "take_atr", take_atr->ExportState());
     }
 
     WriteDeque(out, "kama_recent", kama_recent_);
@@ -1146,6 +1172,7 @@ bool KamaTrendStrategy::LoadState(const AtomicState& state, std::string* error)
         return false;
     }
 
+    shared_indicators_.reset();
     if (!kama_->ImportState(kama_state) || !adx_->ImportState(adx_state)) {
         SetError(error, "failed to import KAMA or ADX state");
         return false;
@@ -1190,6 +1217,59 @@ bool KamaTrendStrategy::LoadState(const AtomicState& state, std::string* error)
     return true;
 }
 
+KamaTrendIndicatorSpec KamaTrendStrategy::IndicatorSpec() const {
+    KamaTrendIndicatorSpec spec;
+    spec.er_period = er_period_;
+    spec.fast_period = fast_period_;
+    spec.slow_period = slow_period_;
+    spec.adx_period = adx_period_;
+    spec.stop_loss_atr_period = stop_loss_mode_ == "trailing_atr" ? stop_loss_atr_period_ : 0;
+    spec.take_profit_atr_period = take_profit_mode_ == "atr_target" ? take_profit_atr_period_ : 0;
+    return spec;
+}
+
+void KamaTrendStrategy::UpdateOwnIndicators(const KamaTrendIndicatorBar& bar) {
+    kama_->Update(bar.high, bar.low, bar.close);
+    if (adx_ != nullptr) {
+        adx_->Update(bar.high, bar.low, bar.close);
+    }
+    if (stop_loss_atr_ != nullptr) {
+        stop_loss_atr_->Update(bar.high, bar.low, bar.close);
+    }
+    if (take_profit_atr_ != nullptr) {
+        take_profit_atr_->Update(bar.high, bar.low, bar.close);
+    }
+}
+
+KamaTrendIndicatorValues KamaTrendStrategy::OwnIndicatorValues() const {
+    KamaTrendIndicatorValues values;
+    if (kama_->IsReady()) {
+        values.kama = kama_->Value();
+        values.efficiency_ratio = kama_->EfficiencyRatio();
+    }
+    if (adx_ != nullptr && adx_->IsReady()) {
+        values.adx = adx_->Value();
+    }
+    if (stop_loss_atr_ != nullptr && stop_loss_atr_->IsReady()) {
+        values.stop_loss_atr = stop_loss_atr_->Value();
+    }
+    if (take_profit_atr_ != nullptr && take_profit_atr_->IsReady()) {
+        values.take_profit_atr = take_profit_atr_->Value();
+    }
+    return values;
+}
+
+void KamaTrendStrategy::DetachSharedIndicators() {
+    if (shared_indicators_ == nullptr) {
+        return;
+    }
+    for (const KamaTrendIndicatorBar& bar :
+         shared_indicators_->RecordedBars(shared_indicator_step_)) {
+        UpdateOwnIndicators(bar);
+    }
+    shared_indicators_.reset();
+}
+
 int KamaTrendStrategy::ClassifyDiff(double diff, double threshold) const {
     if (diff > threshold) {
         return 1;
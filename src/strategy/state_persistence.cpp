@@ -153,6 +153,36 @@ bool RedisStrategyStatePersistence::SaveStrategyState(const std::string& account
     return true;
 }
 
+bool RedisStrategyStatePersistence::SaveStrategyStateDelta(
+    const std::string& account_id, const std::string& strategy_id, const StrategyState& state,
+    const StrategyState& changed_fields, const std::vector<std::string>& removed_fields,
+    std::string* error) {
+    (void)state;
+    if (redis_client_ == nullptr) {
+        if (error != nullptr) {
+            *error = "redis client is null";
+        }
+        return false;
+    }
+    if (account_id.empty() || strategy_id.empty()) {
+        if (error != nullptr) {
+            *error = "account_id and strategy_id must be non-empty";
+        }
+        return false;
+    }
+    const std::string key = BuildKey(account_id, strategy_id);
+    if (!changed_fields.empty() && !redis_client_->HSet(key, changed_fields, error)) {
+        return false;
+    }
+    if (!removed_fields.empty() && !redis_client_->HDel(key, removed_fields, error)) {
+        return false;
+    }
+    if (ttl_seconds_ > 0 && !redis_client_->Expire(key, ttl_seconds_, error)) {
+        return false;
+    }
+    return true;
+}
+
 bool RedisStrategyStatePersistence::LoadStrategyState(const std::string& account_id,
                                                       const std::string& strategy_id,
                                                       StrategyState* state,
@@ -233,6 +263,20 @@ bool FileStrategyStatePersistence::SaveStrategyState(const std::string& account_
     return true;
 }
 
+bool FileStrategyStatePersistence::SaveStrategyStateDelta(
+    const std::string& account_id, const std::string& strategy_id, const StrategyState& state,
+    const StrategyState& changed_fields, const std::vector<std::string>& removed_fields,
+    std::string* error) {
+    if (changed_fields.empty() && removed_fields.empty() && ttl_seconds_ <= 0) {
+        if (account_id.empty() || strategy_id.empty()) {
+            SetPersistenceError(error, "account_id and strategy_id must be non-empty");
+            return false;
+        }
+        return true;
+    }
+    return SaveStrategyState(account_id, strategy_id, state, error);
+}
+
 bool FileStrategyStatePersistence::LoadStrategyState(const std::string& account_id,
                                                      const std::string& strategy_id,
                                                      StrategyState* state,
@@ -0,0 +1,156 @@
+#include "quant_hft/strategy/state_snapshot_writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "quant_hft/core/structured_log.h"
+
+namespace quant_hft {
+namespace {
+
+StrategyState ChangedFields(const StrategyState& previous, const StrategyState& current) {
+    StrategyState changed;
+    for (const auto& [key, value] : current) {
+        const auto it = previous.find(key);
+        if (it == previous.end() || it->second != value) {
+            changed.emplace(key, value);
+        }
+    }
+    return changed;
+}
+
+std::vector<std::string> RemovedFields(const StrategyState& previous,
+                                       const StrategyState& current) {
+    std::vector<std::string> removed;
+    for (const auto& [key, value] : previous) {
+        (void)value;
+        if (current.find(key) == current.end()) {
+            removed.push_back(key);
+        }
+    }
+    std::sort(removed.begin(), removed.end());
+    return removed;
+}
+
+}  // namespace
+
+StrategyStateSnapshotWriter::StrategyStateSnapshotWriter(
+    std::shared_ptr<IStrategyStatePersistence> persistence)
+    : persistence_(std::move(persistence)) {
+    thread_ = std::thread(&StrategyStateSnapshotWriter::Run, this);
+}
+
+StrategyStateSnapshotWriter::~StrategyStateSnapshotWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void StrategyStateSnapshotWriter::SetBaseline(const std::string& account_id,
+                                              const std::string& strategy_id,
+                                              StrategyState state) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_baselines_[Key{account_id, strategy_id}] = std::move(state);
+    }
+    cv_.notify_all();
+}
+
+void StrategyStateSnapshotWriter::Submit(const std::string& account_id,
+                                         const std::string& strategy_id, StrategyState state) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.submitted;
+        auto [it, inserted] = pending_.try_emplace(Key{account_id, strategy_id});
+        if (!inserted) {
+            ++stats_.coalesced;
+        }
+        it->second = std::move(state);
+    }
+    cv_.notify_all();
+}
+
+bool StrategyStateSnapshotWriter::Flush(std::int64_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::milliseconds(std::max<std::int64_t>(0, timeout_ms)),
+                        [&]() {
+                            return pending_.empty() && pending_baselines_.empty() && !writing_;
+                        });
+}
+
+StrategyStateSnapshotWriter::Stats StrategyStateSnapshotWriter::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void StrategyStateSnapshotWriter::Run() {
+    for (;;) {
+        std::map<Key, StrategyState> batch;
+        std::map<Key, StrategyState> baselines;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&]() {
+                return stop_requested_ || !pending_.empty() || !pending_baselines_.empty();
+            });
+            if (pending_.empty() && pending_baselines_.empty()) {
+                break;
+            }
+            batch.swap(pending_);
+            baselines.swap(pending_baselines_);
+            writing_ = true;
+        }
+
+        for (auto& [key, state] : baselines) {
+            written_[key] = std::move(state);
+        }
+
+        Stats delta;
+        for (auto& [key, state] : batch) {
+            const auto previous = written_.find(key);
+            const StrategyState changed =
+                previous == written_.end() ? state : ChangedFields(previous->second, state);
+            const std::vector<std::string> removed =
+                previous == written_.end() ? std::vector<std::string>{}
+                                           : RemovedFields(previous->second, state);
+            std::string error;
+            if (persistence_ == nullptr ||
+                !persistence_->SaveStrategyStateDelta(key.first, key.second, state, changed,
+                                                      removed, &error)) {
+                // Keep the old baseline so the next snapshot re-sends these fields.
+                ++delta.failures;
+                EmitStructuredLog(nullptr, "strategy_engine", "warn",
+                                  "strategy_state_snapshot_write_failed",
+                                  {{"account_id", key.first},
+                                   {"strategy_id", key.second},
+                                   {"error", persistence_ == nullptr ? "persistence is null"
+                                                                     : error}});
+                continue;
+            }
+            ++delta.written;
+            if (changed.empty() && removed.empty()) {
+                ++delta.unchanged;
+            }
+            delta.changed_fields += changed.size() + removed.size();
+            written_[key] = std::move(state);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            writing_ = false;
+            stats_.written += delta.written;
+            stats_.unchanged += delta.unchanged;
+            stats_.changed_fields += delta.changed_fields;
+            stats_.failures += delta.failures;
+        }
+        cv_.notify_all();
+    }
+}
+
+}  // namespace quant_hft
@@ -14,6 +14,25 @@ namespace quant_hft {
 namespace {
 
 constexpr EpochNanos kDefaultTimerIntervalNs = 100'000'000;
+// Events taken per lock acquisition in WorkerLoop.
+constexpr std::size_t kWorkerDrainBatch = 64;
+constexpr std::int64_t kStopSnapshotFlushTimeoutMs = 5'000;
+
+const std::vector<std::size_t>& FirstWorker() {
+    static const std::vector<std::size_t> kFirstWorker{0};
+    return kFirstWorker;
+}
+
+bool HandlesProduct(const std::vector<std::string>& product_ids, const std::string& product_id) {
+    return product_ids.empty() || product_id.empty() ||
+           std::find(product_ids.begin(), product_ids.end(), product_id) != product_ids.end();
+}
+
+void AddWorker(std::vector<std::size_t>* workers, std::size_t worker_index) {
+    if (std::find(workers->begin(), workers->end(), worker_index) == workers->end()) {
+        workers->push_back(worker_index);
+    }
+}
 
 void EmitStrategyExceptionLog(const std::string& event, const std::string& phase,
                               const std::string& strategy_id, const std::string& error) {
@@ -37,6 +56,16 @@ StrategyEngine::StrategyEngine(StrategyEngineConfig config, IntentSink intent_si
     if (config_.metrics_collect_interval_ns < 0) {
         config_.metrics_collect_interval_ns = 0;
     }
+    const std::size_t worker_count = std::max<std::size_t>(1, config_.worker_count);
+    workers_.reserve(worker_count);
+    for (std::size_t index = 0; index < worker_count; ++index) {
+        auto worker = std::make_unique<Worker>();
+        worker->events.resize(config_.queue_capacity);
+        workers_.push_back(std::move(worker));
+    }
+    if (config_.state_persistence != nullptr) {
+        state_writer_ = std::make_unique<StrategyStateSnapshotWriter>(config_.state_persistence);
+    }
 }
 
 StrategyEngine::~StrategyEngine() { Stop(); }
@@ -102,8 +131,8 @@ bool StrategyEngine::Start(const std::vector<StrategyLaunchSpec>& launch_specs,
             StrategyContext strategy_context = spec.context;
             strategy_context.strategy_id = spec.strategy_id;
             strategy->Initialize(strategy_context);
-            initialized.push_back(
-                StrategyEntry{spec.strategy_id, strategy_context.account_id, std::move(strategy)});
+            initialized.push_back(StrategyEntry{spec.strategy_id, strategy_context.account_id,
+                                                spec.product_ids, std::move(strategy)});
         }
     } catch (const std::exception& ex) {
         if (error != nullptr) {
@@ -145,53 +174,137 @@ bool StrategyEngine::Start(const std::vector<StrategyLaunchSpec>& launch_specs,
                 }
                 return false;
             }
+            state_writer_->SetBaseline(entry.account_id, entry.strategy_id,
+                                       std::move(loaded_state));
         }
     }
 
+    // Distinct affinity keys are spread round-robin in launch order, so placement is stable
+    // across restarts with the same configuration.
+    auto routing = std::make_shared<Routing>();
+    std::vector<std::vector<std::size_t>> strategy_indices(workers_.size());
+    std::unordered_map<std::string, std::size_t> worker_by_affinity;
+    for (std::size_t index = 0; index < launch_specs.size(); ++index) {
+        const StrategyLaunchSpec& spec = launch_specs[index];
+        std::string affinity_key = spec.affinity_key;
+        if (affinity_key.empty()) {
+            affinity_key = spec.product_ids.empty() ? spec.strategy_id : spec.product_ids.front();
+        }
+        const std::size_t worker_index =
+            worker_by_affinity.emplace(affinity_key, worker_by_affinity.size() % workers_.size())
+                .first->second;
+        strategy_indices[worker_index].push_back(index);
+
+        const StrategyEntry& entry = initialized[index];
+        AddWorker(&routing->active_workers, worker_index);
+        AddWorker(&routing->workers_by_account[entry.account_id], worker_index);
+        routing->worker_by_strategy[entry.strategy_id] = worker_index;
+        if (entry.product_ids.empty()) {
+            AddWorker(&routing->unscoped_workers, worker_index);
+        }
+    }
+    for (const StrategyEntry& entry : initialized) {
+        for (const std::string& product_id : entry.product_ids) {
+            std::vector<std::size_t>& workers = routing->workers_by_product[product_id];
+            for (std::size_t index = 0; index < workers_.size(); ++index) {
+                const bool owns = std::any_of(
+                    strategy_indices[index].begin(), strategy_indices[index].end(),
+                    [&](std::size_t strategy_index) {
+                        return HandlesProduct(initialized[strategy_index].product_ids,
+                                              product_id);
+                    });
+                if (owns) {
+                    AddWorker(&workers, index);
+                }
+            }
+        }
+    }
+
+    for (std::size_t index = 0; index < workers_.size(); ++index) {
+        Worker& worker = *workers_[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        ClearEventsLocked(worker);
+        worker.dispatching = false;
+        worker.stop_requested = false;
+        worker.enqueued_events = 0;
+        worker.processed_events = 0;
+        worker.dropped_oldest_events = 0;
+        worker.cached_metrics.clear();
+        worker.strategy_indices = std::move(strategy_indices[index]);
+        worker.last_state_snapshot_ns = 0;
+        worker.last_metrics_collect_ns = 0;
+    }
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        queue_.clear();
         strategies_ = std::move(initialized);
-        cached_metrics_.clear();
+        std::atomic_store_explicit(&routing_, std::shared_ptr<const Routing>(std::move(routing)),
+                                   std::memory_order_release);
         stats_ = {};
-        last_state_snapshot_ns_ = 0;
-        last_metrics_collect_ns_ = 0;
         running_ = true;
         stop_requested_ = false;
-        dispatching_ = false;
     }
 
-    worker_thread_ = std::thread(&StrategyEngine::WorkerLoop, this);
+    for (auto& worker : workers_) {
+        worker->thread = std::thread(&StrategyEngine::WorkerLoop, this, std::ref(*worker));
+    }
     return true;
 }
 
 void StrategyEngine::Stop() {
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        if (!running_ && !worker_thread_.joinable() && strategies_.empty()) {
+        const bool any_thread =
+            std::any_of(workers_.begin(), workers_.end(),
+                        [](const std::unique_ptr<Worker>& worker) {
+                            return worker->thread.joinable();
+                        });
+        if (!running_ && !any_thread && strategies_.empty()) {
             return;
         }
         stop_requested_ = true;
     }
-    cv_.notify_all();
-
-    if (worker_thread_.joinable()) {
-        worker_thread_.join();
+    for (auto& worker : workers_) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->stop_requested = true;
+        }
+        worker->cv.notify_all();
+    }
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
     }
 
-    SnapshotStates(NowEpochNanos());
+    std::vector<std::size_t> all_strategies(strategies_.size());
+    for (std::size_t index = 0; index < all_strategies.size(); ++index) {
+        all_strategies[index] = index;
+    }
+    SnapshotStates(all_strategies);
+    if (state_writer_ != nullptr && !state_writer_->Flush(kStopSnapshotFlushTimeoutMs)) {
+        EmitStructuredLog(nullptr, "strategy_engine", "warn", "strategy_state_flush_timeout",
+                          {{"timeout_ms", std::to_string(kStopSnapshotFlushTimeoutMs)}});
+    }
 
     std::vector<StrategyEntry> strategies_to_shutdown;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         strategies_to_shutdown = std::move(strategies_);
-        queue_.clear();
-        cached_metrics_.clear();
+        strategies_.clear();
+        std::atomic_store_explicit(&routing_, std::shared_ptr<const Routing>(),
+                                   std::memory_order_release);
         running_ = false;
         stop_requested_ = false;
-        dispatching_ = false;
-        last_state_snapshot_ns_ = 0;
-        last_metrics_collect_ns_ = 0;
+    }
+    for (auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        ClearEventsLocked(*worker);
+        worker->cached_metrics.clear();
+        worker->strategy_indices.clear();
+        worker->dispatching = false;
+        worker->stop_requested = false;
+        worker->last_state_snapshot_ns = 0;
+        worker->last_metrics_collect_ns = 0;
     }
 
     for (auto& entry : strategies_to_shutdown) {
@@ -204,62 +317,95 @@ void StrategyEngine::Stop() {
 
 void StrategyEngine::EnqueueState(const StateSnapshot7D& state, const std::string& product_id,
                                   std::uint64_t contract_generation, bool emit_intents) {
-    EngineEvent event;
-    event.type = EventType::kState;
-    event.state = state;
-    event.product_id = product_id;
-    event.contract_generation = contract_generation;
-    event.emit_intents = emit_intents;
-    EnqueueEvent(std::move(event));
+    const auto routing = workers_.size() == 1 ? nullptr : CurrentRouting();
+    EnqueueRouted(ProductWorkers(routing.get(), product_id), [&]() -> EngineEvent {
+        return StateEvent{state, product_id, contract_generation, emit_intents};
+    });
 }
 
 void StrategyEngine::EnqueueMarketTick(const MarketSnapshot& snapshot,
                                        const std::string& product_id,
                                        std::uint64_t contract_generation, bool emit_intents) {
-    EngineEvent event;
-    event.type = EventType::kMarketTick;
-    event.market_tick = snapshot;
-    event.product_id = product_id;
-    event.contract_generation = contract_generation;
-    event.emit_intents = emit_intents;
-    EnqueueEvent(std::move(event));
+    const auto routing = workers_.size() == 1 ? nullptr : CurrentRouting();
+    EnqueueRouted(ProductWorkers(routing.get(), product_id), [&]() -> EngineEvent {
+        return MarketTickEvent{snapshot, product_id, contract_generation, emit_intents};
+    });
 }
 
 void StrategyEngine::EnqueueOrderEvent(const OrderEvent& event) {
-    EngineEvent engine_event;
-    engine_event.type = EventType::kOrderEvent;
-    engine_event.order_event = event;
-    EnqueueEvent(std::move(engine_event));
+    const auto routing = CurrentRouting();
+    const std::vector<std::size_t>* targets = &FirstWorker();
+    std::vector<std::size_t> owner;
+    if (routing != nullptr) {
+        if (event.strategy_id.empty()) {
+            targets = &routing->active_workers;
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.broadcast_order_events;
+        } else {
+            const auto it = routing->worker_by_strategy.find(event.strategy_id);
+            if (it == routing->worker_by_strategy.end()) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.unmatched_order_events;
+                return;
+            }
+            owner.push_back(it->second);
+            targets = &owner;
+        }
+    }
+    EnqueueRouted(*targets,
+                  [&]() -> EngineEvent { return std::make_unique<OrderEvent>(event); });
 }
 
 void StrategyEngine::EnqueueAccountSnapshot(const TradingAccountSnapshot& snapshot) {
-    EngineEvent event;
-    event.type = EventType::kAccountSnapshot;
-    event.account_snapshot = snapshot;
-    EnqueueEvent(std::move(event));
+    const auto routing = CurrentRouting();
+    EnqueueRouted(routing == nullptr ? FirstWorker() : routing->active_workers,
+                  [&]() -> EngineEvent { return snapshot; });
 }
 
 void StrategyEngine::EnqueueReconcilePositions(
     const std::string& account_id,
     const std::unordered_map<std::string, std::int32_t>& authoritative_net,
     const std::unordered_map<std::string, double>& authoritative_avg_open) {
-    EngineEvent event;
-    event.type = EventType::kReconcilePositions;
-    event.reconcile_account_id = account_id;
-    event.reconcile_net = authoritative_net;
-    event.reconcile_avg_open = authoritative_avg_open;
-    EnqueueEvent(std::move(event));
+    const auto routing = CurrentRouting();
+    const std::vector<std::size_t>* targets = &FirstWorker();
+    if (routing != nullptr) {
+        targets = &routing->active_workers;
+        if (!account_id.empty()) {
+            const auto it = routing->workers_by_account.find(account_id);
+            if (it == routing->workers_by_account.end()) {
+                return;
+            }
+            targets = &it->second;
+        }
+    }
+    EnqueueRouted(*targets, [&]() -> EngineEvent {
+        return std::make_unique<ReconcileEvent>(
+            ReconcileEvent{account_id, authoritative_net, authoritative_avg_open});
+    });
 }
 
 std::vector<StrategyMetric> StrategyEngine::CollectAllMetrics() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return cached_metrics_;
+    std::vector<StrategyMetric> metrics;
+    for (const auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        metrics.insert(metrics.end(), worker->cached_metrics.begin(),
+                       worker->cached_metrics.end());
+    }
+    return metrics;
 }
 
 bool StrategyEngine::WaitUntilDrained(std::int64_t timeout_ms) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return cv_.wait_for(lock, std::chrono::milliseconds(std::max<std::int64_t>(0, timeout_ms)),
-                        [&]() { return queue_.empty() && !dispatching_; });
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::milliseconds(std::max<std::int64_t>(0, timeout_ms));
+    for (auto& worker : workers_) {
+        std::unique_lock<std::mutex> lock(worker->mutex);
+        if (!worker->cv.wait_until(lock, deadline, [&]() {
+                return worker->events_size == 0 && !worker->dispatching;
+            })) {
+            return false;
+        }
+    }
+    return true;
 }
 
 StrategyEngine::ContractSwitchReport StrategyEngine::ApplyContractSwitch(
@@ -272,23 +418,28 @@ StrategyEngine::ContractSwitchReport StrategyEngine::ApplyContractSwitch(
         failed.error = "invalid contract switch context";
         return failed;
     }
-    auto promise = std::make_shared<std::promise<ContractSwitchReport>>();
-    auto future = promise->get_future();
+    auto barrier = std::make_shared<ContractSwitchBarrier>();
+    barrier->report.generation = context.generation;
+    auto future = barrier->promise.get_future();
     {
+        // Held while queueing so concurrent switches reach every worker in the same order and
+        // their barriers cannot interleave.
         std::lock_guard<std::mutex> lock(mutex_);
         if (!running_ || stop_requested_) {
             failed.error = "strategy engine is not running";
             return failed;
         }
-        EngineEvent event;
-        event.type = EventType::kContractSwitch;
-        event.contract_switch = context;
-        event.warmup_states = warmup_states;
-        event.contract_switch_promise = promise;
-        queue_.push_back(std::move(event));
-        ++stats_.enqueued_events;
+        barrier->participants = routing_->active_workers.size();
+        if (barrier->participants == 0) {
+            barrier->report.success = true;
+            return barrier->report;
+        }
+        // Contract control events are never dropped by the ordinary bounded-queue policy.
+        EnqueueRouted(routing_->active_workers, [&]() -> EngineEvent {
+            return std::make_unique<ContractSwitchEvent>(
+                ContractSwitchEvent{context, warmup_states, barrier});
+        });
     }
-    cv_.notify_one();
     const auto wait = std::chrono::milliseconds(std::max<std::int64_t>(0, timeout_ms));
     if (future.wait_for(wait) != std::future_status::ready) {
         failed.error = "strategy contract switch barrier timeout";
@@ -304,133 +455,225 @@ bool StrategyEngine::ApplyContractWarmupState(const StateSnapshot7D& state,
     if (state.instrument_id.empty() || product_id.empty() || contract_generation == 0) {
         return false;
     }
-    auto promise = std::make_shared<std::promise<bool>>();
-    auto future = promise->get_future();
+    std::shared_ptr<const Routing> routing;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         if (!running_ || stop_requested_) {
             return false;
         }
-        EngineEvent event;
-        event.type = EventType::kContractWarmupState;
-        event.state = state;
-        event.product_id = product_id;
-        event.contract_generation = contract_generation;
-        event.emit_intents = false;
-        event.contract_warmup_promise = promise;
-        // Contract control events are never dropped by the ordinary bounded-queue policy.
-        queue_.push_back(std::move(event));
-        ++stats_.enqueued_events;
+        routing = routing_;
+    }
+    const std::vector<std::size_t>& targets = ProductWorkers(routing.get(), product_id);
+    auto completion = std::make_shared<ContractWarmupCompletion>();
+    completion->remaining.store(targets.size());
+    auto future = completion->promise.get_future();
+    if (targets.empty()) {
+        completion->promise.set_value(true);
     }
-    cv_.notify_one();
+    // Contract control events are never dropped by the ordinary bounded-queue policy.
+    EnqueueRouted(targets, [&]() -> EngineEvent {
+        return std::make_unique<ContractWarmupEvent>(ContractWarmupEvent{
+            StateEvent{state, product_id, contract_generation, false}, completion});
+    });
     const auto wait = std::chrono::milliseconds(std::max<std::int64_t>(0, timeout_ms));
     return future.wait_for(wait) == std::future_status::ready && future.get();
 }
 
 StrategyEngine::Stats StrategyEngine::GetStats() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return stats_;
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats = stats_;
+    }
+    for (const auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        stats.enqueued_events += worker->enqueued_events;
+        stats.processed_events += worker->processed_events;
+        stats.dropped_oldest_events += worker->dropped_oldest_events;
+    }
+    if (state_writer_ != nullptr) {
+        const StrategyStateSnapshotWriter::Stats writer_stats = state_writer_->GetStats();
+        stats.state_snapshot_failures += writer_stats.failures;
+        stats.state_snapshot_writes = writer_stats.written;
+        stats.state_snapshot_coalesced = writer_stats.coalesced;
+        stats.state_snapshot_unchanged = writer_stats.unchanged;
+    }
+    return stats;
+}
+
+std::shared_ptr<const StrategyEngine::Routing> StrategyEngine::CurrentRouting() const {
+    return std::atomic_load_explicit(&routing_, std::memory_order_acquire);
 }
 
-void StrategyEngine::EnqueueEvent(EngineEvent event) {
+const std::vector<std::size_t>& StrategyEngine::ProductWorkers(
+    const Routing* routing, const std::string& product_id) const {
+    if (routing == nullptr) {
+        return FirstWorker();
+    }
+    if (product_id.empty()) {
+        return routing->active_workers;
+    }
+    const auto it = routing->workers_by_product.find(product_id);
+    return it == routing->workers_by_product.end() ? routing->unscoped_workers : it->second;
+}
+
+template <typename MakeEvent>
+void StrategyEngine::EnqueueRouted(const std::vector<std::size_t>& worker_indices,
+                                   MakeEvent make_event) {
+    for (const std::size_t worker_index : worker_indices) {
+        EnqueueEvent(*workers_[worker_index], make_event());
+    }
+}
+
+void StrategyEngine::EnqueueEvent(Worker& worker, EngineEvent event) {
+    const auto is_control = [](const EngineEvent& candidate) {
+        return std::holds_alternative<std::unique_ptr<ContractSwitchEvent>>(candidate) ||
+               std::holds_alternative<std::unique_ptr<ContractWarmupEvent>>(candidate);
+    };
+    bool was_empty = false;
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (queue_.size() >= config_.queue_capacity) {
-            queue_.pop_front();
-            ++stats_.dropped_oldest_events;
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        was_empty = worker.events_size == 0;
+        if (!is_control(event) && worker.events_size >= config_.queue_capacity) {
+            // Drop the oldest ordinary event; control events ahead of it shift up one slot so
+            // their promises are always fulfilled.
+            const std::size_t capacity = worker.events.size();
+            std::size_t offset = 0;
+            while (offset < worker.events_size &&
+                   is_control(worker.events[(worker.events_head + offset) % capacity])) {
+                ++offset;
+            }
+            if (offset < worker.events_size) {
+                for (std::size_t shift = offset; shift > 0; --shift) {
+                    worker.events[(worker.events_head + shift) % capacity] =
+                        std::move(worker.events[(worker.events_head + shift - 1) % capacity]);
+                }
+                worker.events[worker.events_head] = std::monostate{};
+                worker.events_head = (worker.events_head + 1) % capacity;
+                --worker.events_size;
+                ++worker.dropped_oldest_events;
+            }
         }
-        queue_.push_back(std::move(event));
-        ++stats_.enqueued_events;
+        PushEventLocked(worker, std::move(event));
+        ++worker.enqueued_events;
+    }
+    // The worker only sleeps on an empty ring, so only the first event after a drain wakes it.
+    if (was_empty) {
+        worker.cv.notify_one();
     }
-    cv_.notify_one();
 }
 
-void StrategyEngine::WorkerLoop() {
+void StrategyEngine::PushEventLocked(Worker& worker, EngineEvent event) {
+    if (worker.events_size == worker.events.size()) {
+        std::vector<EngineEvent> grown(std::max<std::size_t>(1, worker.events.size() * 2));
+        for (std::size_t index = 0; index < worker.events_size; ++index) {
+            grown[index] =
+                std::move(worker.events[(worker.events_head + index) % worker.events.size()]);
+        }
+        worker.events = std::move(grown);
+        worker.events_head = 0;
+    }
+    worker.events[(worker.events_head + worker.events_size) % worker.events.size()] =
+        std::move(event);
+    ++worker.events_size;
+}
+
+void StrategyEngine::ClearEventsLocked(Worker& worker) {
+    for (std::size_t index = 0; index < worker.events_size; ++index) {
+        worker.events[(worker.events_head + index) % worker.events.size()] = std::monostate{};
+    }
+    worker.events_head = 0;
+    worker.events_size = 0;
+}
+
+void StrategyEngine::WorkerLoop(Worker& worker) {
+    std::vector<EngineEvent> batch;
+    batch.reserve(kWorkerDrainBatch);
     for (;;) {
-        EngineEvent event;
-        bool has_event = false;
+        batch.clear();
 
         {
-            std::unique_lock<std::mutex> lock(mutex_);
-            if (queue_.empty()) {
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            if (worker.events_size == 0) {
                 const auto wait_interval =
                     std::chrono::nanoseconds(std::max<EpochNanos>(1, config_.timer_interval_ns));
-                cv_.wait_for(lock, wait_interval,
-                             [&]() { return stop_requested_ || !queue_.empty(); });
+                worker.cv.wait_for(lock, wait_interval, [&]() {
+                    return worker.stop_requested || worker.events_size != 0;
+                });
             }
 
-            if (stop_requested_ && queue_.empty()) {
+            if (worker.stop_requested && worker.events_size == 0) {
                 break;
             }
 
-            if (!queue_.empty()) {
-                event = std::move(queue_.front());
-                queue_.pop_front();
-                ++stats_.processed_events;
-                dispatching_ = true;
-                has_event = true;
+            while (worker.events_size != 0 && batch.size() < kWorkerDrainBatch) {
+                batch.push_back(std::move(worker.events[worker.events_head]));
+                worker.events[worker.events_head] = std::monostate{};
+                worker.events_head = (worker.events_head + 1) % worker.events.size();
+                --worker.events_size;
             }
+            worker.processed_events += batch.size();
+            worker.dispatching = true;
         }
 
-        if (has_event) {
-            if (event.type == EventType::kState) {
-                DispatchState(event.state, event.product_id, event.contract_generation,
-                              event.emit_intents);
-            } else if (event.type == EventType::kMarketTick) {
-                DispatchMarketTick(event.market_tick, event.product_id, event.contract_generation,
-                                   event.emit_intents);
-            } else if (event.type == EventType::kOrderEvent) {
-                DispatchOrderEvent(event.order_event);
-            } else if (event.type == EventType::kReconcilePositions) {
-                DispatchReconcilePositions(event.reconcile_account_id, event.reconcile_net,
-                                           event.reconcile_avg_open);
-            } else if (event.type == EventType::kContractSwitch) {
-                ContractSwitchReport report =
-                    DispatchContractSwitch(event.contract_switch, event.warmup_states);
-                if (event.contract_switch_promise != nullptr) {
-                    try {
-                        event.contract_switch_promise->set_value(std::move(report));
-                    } catch (...) {
-                    }
-                }
-            } else if (event.type == EventType::kContractWarmupState) {
-                const bool success =
-                    DispatchState(event.state, event.product_id, event.contract_generation, false);
-                if (event.contract_warmup_promise != nullptr) {
-                    try {
-                        event.contract_warmup_promise->set_value(success);
-                    } catch (...) {
-                    }
-                }
-            } else {
-                DispatchAccountSnapshot(event.account_snapshot);
+        if (batch.empty()) {
+            DispatchTimer(worker, NowEpochNanos());
+        } else {
+            for (EngineEvent& event : batch) {
+                DispatchEvent(worker, event);
             }
-            {
-                std::lock_guard<std::mutex> lock(mutex_);
-                dispatching_ = false;
-            }
-            cv_.notify_all();
-            continue;
         }
-
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            dispatching_ = true;
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.dispatching = false;
         }
-        DispatchTimer(NowEpochNanos());
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            dispatching_ = false;
+        worker.cv.notify_all();
+    }
+}
+
+void StrategyEngine::DispatchEvent(Worker& worker, EngineEvent& event) {
+    if (auto* state = std::get_if<StateEvent>(&event)) {
+        DispatchState(worker, state->state, state->product_id, state->contract_generation,
+                      state->emit_intents);
+    } else if (auto* tick = std::get_if<MarketTickEvent>(&event)) {
+        DispatchMarketTick(worker, tick->snapshot, tick->product_id, tick->contract_generation,
+                           tick->emit_intents);
+    } else if (auto* order = std::get_if<std::unique_ptr<OrderEvent>>(&event)) {
+        DispatchOrderEvent(worker, **order);
+    } else if (auto* account = std::get_if<TradingAccountSnapshot>(&event)) {
+        DispatchAccountSnapshot(worker, *account);
+    } else if (auto* reconcile = std::get_if<std::unique_ptr<ReconcileEvent>>(&event)) {
+        DispatchReconcilePositions(worker, (*reconcile)->account_id,
+                                   (*reconcile)->authoritative_net,
+                                   (*reconcile)->authoritative_avg_open);
+    } else if (auto* contract_switch = std::get_if<std::unique_ptr<ContractSwitchEvent>>(&event)) {
+        DispatchContractSwitch(worker, **contract_switch);
+    } else if (auto* warmup = std::get_if<std::unique_ptr<ContractWarmupEvent>>(&event)) {
+        const StateEvent& state = (*warmup)->state;
+        ContractWarmupCompletion& completion = *(*warmup)->completion;
+        if (!DispatchState(worker, state.state, state.product_id, state.contract_generation,
+                           false)) {
+            completion.success.store(false);
+        }
+        if (completion.remaining.fetch_sub(1) == 1) {
+            try {
+                completion.promise.set_value(completion.success.load());
+            } catch (...) {
+            }
         }
-        cv_.notify_all();
     }
 }
 
-bool StrategyEngine::DispatchState(const StateSnapshot7D& state, const std::string& product_id,
+bool StrategyEngine::DispatchState(const Worker& worker, const StateSnapshot7D& state,
+                                   const std::string& product_id,
                                    std::uint64_t contract_generation, bool emit_intents) {
     bool success = true;
     std::vector<SignalIntent> intents;
-    for (auto& entry : strategies_) {
+    for (const std::size_t index : worker.strategy_indices) {
+        StrategyEntry& entry = strategies_[index];
+        if (!HandlesProduct(entry.product_ids, product_id)) {
+            continue;
+        }
         try {
             auto* composite = dynamic_cast<CompositeStrategy*>(entry.strategy.get());
             if (composite != nullptr && config_.contract_multiplier_resolver) {
@@ -483,11 +726,15 @@ bool StrategyEngine::DispatchState(const StateSnapshot7D& state, const std::stri
     return success;
 }
 
-void StrategyEngine::DispatchMarketTick(const MarketSnapshot& snapshot,
+void StrategyEngine::DispatchMarketTick(const Worker& worker, const MarketSnapshot& snapshot,
                                         const std::string& product_id,
                                         std::uint64_t contract_generation, bool emit_intents) {
     std::vector<SignalIntent> intents;
-    for (auto& entry : strategies_) {
+    for (const std::size_t index : worker.strategy_indices) {
+        StrategyEntry& entry = strategies_[index];
+        if (!HandlesProduct(entry.product_ids, product_id)) {
+            continue;
+        }
         try {
             auto* composite = dynamic_cast<CompositeStrategy*>(entry.strategy.get());
             if (composite != nullptr && config_.contract_multiplier_resolver) {
@@ -515,13 +762,12 @@ void StrategyEngine::DispatchMarketTick(const MarketSnapshot& snapshot,
     }
 }
 
-void StrategyEngine::DispatchOrderEvent(const OrderEvent& event) {
+void StrategyEngine::DispatchOrderEvent(const Worker& worker, const OrderEvent& event) {
+    // Broadcast and unmatched order events are counted once at enqueue time, where routing
+    // decides which workers receive them.
     if (event.strategy_id.empty()) {
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            ++stats_.broadcast_order_events;
-        }
-        for (auto& entry : strategies_) {
+        for (const std::size_t index : worker.strategy_indices) {
+            StrategyEntry& entry = strategies_[index];
             try {
                 entry.strategy->OnOrderEvent(event);
             } catch (const std::exception& ex) {
@@ -539,32 +785,35 @@ void StrategyEngine::DispatchOrderEvent(const OrderEvent& event) {
         return;
     }
 
-    auto it = std::find_if(strategies_.begin(), strategies_.end(), [&](const StrategyEntry& entry) {
-        return entry.strategy_id == event.strategy_id;
-    });
-    if (it == strategies_.end()) {
+    const auto match = std::find_if(
+        worker.strategy_indices.begin(), worker.strategy_indices.end(),
+        [&](std::size_t index) { return strategies_[index].strategy_id == event.strategy_id; });
+    if (match == worker.strategy_indices.end()) {
         std::lock_guard<std::mutex> lock(mutex_);
         ++stats_.unmatched_order_events;
         return;
     }
+    StrategyEntry& owner = strategies_[*match];
 
     try {
-        it->strategy->OnOrderEvent(event);
+        owner.strategy->OnOrderEvent(event);
     } catch (const std::exception& ex) {
-        EmitStrategyExceptionLog("strategy_callback_exception", "order_event", it->strategy_id,
+        EmitStrategyExceptionLog("strategy_callback_exception", "order_event", owner.strategy_id,
                                  ex.what());
         std::lock_guard<std::mutex> lock(mutex_);
         ++stats_.strategy_callback_exceptions;
     } catch (...) {
-        EmitStrategyExceptionLog("strategy_callback_exception", "order_event", it->strategy_id,
+        EmitStrategyExceptionLog("strategy_callback_exception", "order_event", owner.strategy_id,
                                  "unknown exception");
         std::lock_guard<std::mutex> lock(mutex_);
         ++stats_.strategy_callback_exceptions;
     }
 }
 
-void StrategyEngine::DispatchAccountSnapshot(const TradingAccountSnapshot& snapshot) {
-    for (auto& entry : strategies_) {
+void StrategyEngine::DispatchAccountSnapshot(const Worker& worker,
+                                             const TradingAccountSnapshot& snapshot) {
+    for (const std::size_t index : worker.strategy_indices) {
+        StrategyEntry& entry = strategies_[index];
         try {
             entry.strategy->OnAccountSnapshot(snapshot);
         } catch (const std::exception& ex) {
@@ -582,10 +831,11 @@ void StrategyEngine::DispatchAccountSnapshot(const TradingAccountSnapshot& snaps
 }
 
 void StrategyEngine::DispatchReconcilePositions(
-    const std::string& account_id,
+    const Worker& worker, const std::string& account_id,
     const std::unordered_map<std::string, std::int32_t>& authoritative_net,
     const std::unordered_map<std::string, double>& authoritative_avg_open) {
-    for (auto& entry : strategies_) {
+    for (const std::size_t index : worker.strategy_indices) {
+        StrategyEntry& entry = strategies_[index];
         if (!account_id.empty() && entry.account_id != account_id) {
             continue;
         }
@@ -626,70 +876,116 @@ void StrategyEngine::DispatchReconcilePositions(
     }
 }
 
-StrategyEngine::ContractSwitchReport StrategyEngine::DispatchContractSwitch(
-    const ContractSwitchContext& context, const std::vector<StateSnapshot7D>& warmup_states) {
-    ContractSwitchReport report;
-    report.generation = context.generation;
+void StrategyEngine::DispatchContractSwitch(const Worker& worker,
+                                            const ContractSwitchEvent& event) {
+    const ContractSwitchContext& context = event.context;
+    ContractSwitchBarrier& barrier = *event.barrier;
+    std::vector<StrategyEntry*> affected;
+    for (const std::size_t index : worker.strategy_indices) {
+        StrategyEntry& entry = strategies_[index];
+        if (HandlesProduct(entry.product_ids, context.product_id)) {
+            affected.push_back(&entry);
+        }
+    }
+
+    std::int32_t required_warmup_bars = 0;
+    std::string error;
     try {
-        for (auto& entry : strategies_) {
+        for (StrategyEntry* entry : affected) {
             std::string reset_error;
-            if (!entry.strategy->ResetForContractSwitch(context, &reset_error)) {
-                report.error = "strategy `" + entry.strategy_id + "` reset failed: " + reset_error;
-                return report;
+            if (!entry->strategy->ResetForContractSwitch(context, &reset_error)) {
+                error = "strategy `" + entry->strategy_id + "` reset failed: " + reset_error;
+                break;
             }
-            report.required_warmup_bars = std::max(
-                report.required_warmup_bars, entry.strategy->RequiredContractWarmupBars(context));
+            required_warmup_bars = std::max(required_warmup_bars,
+                                            entry->strategy->RequiredContractWarmupBars(context));
         }
+    } catch (const std::exception& ex) {
+        error = ex.what();
+    } catch (...) {
+        error = "unknown strategy contract switch failure";
+    }
 
-        std::vector<StateSnapshot7D> ordered = warmup_states;
-        std::sort(ordered.begin(), ordered.end(), [](const auto& lhs, const auto& rhs) {
-            if (lhs.ts_ns != rhs.ts_ns) {
-                return lhs.ts_ns < rhs.ts_ns;
-            }
-            if (lhs.instrument_id != rhs.instrument_id) {
-                return lhs.instrument_id < rhs.instrument_id;
+    // Every worker must finish resetting before any replays, so the replay length is the
+    // maximum warmup requirement across all strategies.
+    {
+        std::unique_lock<std::mutex> lock(barrier.mutex);
+        barrier.report.required_warmup_bars =
+            std::max(barrier.report.required_warmup_bars, required_warmup_bars);
+        if (!error.empty() && barrier.report.error.empty()) {
+            barrier.report.error = error;
+        }
+        ++barrier.reset_arrivals;
+        barrier.cv.notify_all();
+        barrier.cv.wait(lock, [&]() { return barrier.reset_arrivals >= barrier.participants; });
+        required_warmup_bars = barrier.report.required_warmup_bars;
+        error = barrier.report.error;
+    }
+
+    std::int32_t replayed_warmup_bars = 0;
+    if (error.empty()) {
+        try {
+            std::vector<StateSnapshot7D> ordered = event.warmup_states;
+            std::sort(ordered.begin(), ordered.end(), [](const auto& lhs, const auto& rhs) {
+                if (lhs.ts_ns != rhs.ts_ns) {
+                    return lhs.ts_ns < rhs.ts_ns;
+                }
+                if (lhs.instrument_id != rhs.instrument_id) {
+                    return lhs.instrument_id < rhs.instrument_id;
+                }
+                return lhs.timeframe_minutes < rhs.timeframe_minutes;
+            });
+            ordered.erase(std::unique(ordered.begin(), ordered.end(),
+                                      [](const auto& lhs, const auto& rhs) {
+                                          return lhs.ts_ns == rhs.ts_ns &&
+                                                 lhs.instrument_id == rhs.instrument_id &&
+                                                 lhs.timeframe_minutes == rhs.timeframe_minutes;
+                                      }),
+                          ordered.end());
+            ordered.erase(std::remove_if(ordered.begin(), ordered.end(),
+                                         [&](const auto& state) {
+                                             return state.instrument_id !=
+                                                        context.current_instrument_id ||
+                                                    state.timeframe_minutes != 5 ||
+                                                    !state.has_bar;
+                                         }),
+                          ordered.end());
+            if (required_warmup_bars > 0 &&
+                ordered.size() > static_cast<std::size_t>(required_warmup_bars)) {
+                ordered.erase(ordered.begin(), ordered.end() - required_warmup_bars);
             }
-            return lhs.timeframe_minutes < rhs.timeframe_minutes;
-        });
-        ordered.erase(std::unique(ordered.begin(), ordered.end(),
-                                  [](const auto& lhs, const auto& rhs) {
-                                      return lhs.ts_ns == rhs.ts_ns &&
-                                             lhs.instrument_id == rhs.instrument_id &&
-                                             lhs.timeframe_minutes == rhs.timeframe_minutes;
-                                  }),
-                      ordered.end());
-        ordered.erase(std::remove_if(ordered.begin(), ordered.end(),
-                                     [&](const auto& state) {
-                                         return state.instrument_id !=
-                                                    context.current_instrument_id ||
-                                                state.timeframe_minutes != 5 || !state.has_bar;
-                                     }),
-                      ordered.end());
-        if (report.required_warmup_bars > 0 &&
-            ordered.size() > static_cast<std::size_t>(report.required_warmup_bars)) {
-            ordered.erase(ordered.begin(), ordered.end() - report.required_warmup_bars);
-        }
-        for (const auto& state : ordered) {
-            for (auto& entry : strategies_) {
-                // Warmup deliberately suppresses every returned intent.  The state mutation is
-                // identical to live evaluation, but execution cannot observe a replay signal.
-                (void)entry.strategy->OnState(state);
+            for (const auto& state : ordered) {
+                for (StrategyEntry* entry : affected) {
+                    // Warmup deliberately suppresses every returned intent.  The state mutation
+                    // is identical to live evaluation, but execution cannot observe a replay
+                    // signal.
+                    (void)entry->strategy->OnState(state);
+                }
+                ++replayed_warmup_bars;
             }
-            ++report.replayed_warmup_bars;
+        } catch (const std::exception& ex) {
+            error = ex.what();
+        } catch (...) {
+            error = "unknown strategy contract switch failure";
         }
-        report.success = true;
-        return report;
-    } catch (const std::exception& ex) {
-        report.error = ex.what();
-    } catch (...) {
-        report.error = "unknown strategy contract switch failure";
     }
-    return report;
+
+    std::lock_guard<std::mutex> lock(barrier.mutex);
+    barrier.report.replayed_warmup_bars =
+        std::max(barrier.report.replayed_warmup_bars, replayed_warmup_bars);
+    if (!error.empty() && barrier.report.error.empty()) {
+        barrier.report.error = error;
+    }
+    if (++barrier.finished == barrier.participants) {
+        barrier.report.success = barrier.report.error.empty();
+        barrier.promise.set_value(barrier.report);
+    }
 }
 
-void StrategyEngine::DispatchTimer(EpochNanos now_ns) {
+void StrategyEngine::DispatchTimer(Worker& worker, EpochNanos now_ns) {
     std::vector<SignalIntent> intents;
-    for (auto& entry : strategies_) {
+    for (const std::size_t index : worker.strategy_indices) {
+        StrategyEntry& entry = strategies_[index];
         try {
             intents = entry.strategy->OnTimer(now_ns);
             EmitIntents(entry.strategy_id, std::move(intents));
@@ -705,25 +1001,24 @@ void StrategyEngine::DispatchTimer(EpochNanos now_ns) {
             ++stats_.strategy_callback_exceptions;
         }
     }
-    MaybeCollectMetrics(now_ns);
-    MaybeSnapshotStates(now_ns);
+    MaybeCollectMetrics(worker, now_ns);
+    MaybeSnapshotStates(worker, now_ns);
 }
 
-void StrategyEngine::MaybeSnapshotStates(EpochNanos now_ns) {
+void StrategyEngine::MaybeSnapshotStates(Worker& worker, EpochNanos now_ns) {
     if (config_.state_persistence == nullptr || config_.state_snapshot_interval_ns <= 0) {
         return;
     }
-    if (last_state_snapshot_ns_ > 0 &&
-        (now_ns - last_state_snapshot_ns_) < config_.state_snapshot_interval_ns) {
+    if (worker.last_state_snapshot_ns > 0 &&
+        (now_ns - worker.last_state_snapshot_ns) < config_.state_snapshot_interval_ns) {
         return;
     }
-    last_state_snapshot_ns_ = now_ns;
-    SnapshotStates(now_ns);
+    worker.last_state_snapshot_ns = now_ns;
+    SnapshotStates(worker.strategy_indices);
 }
 
-void StrategyEngine::SnapshotStates(EpochNanos now_ns) {
-    (void)now_ns;
-    if (config_.state_persistence == nullptr) {
+void StrategyEngine::SnapshotStates(const std::vector<std::size_t>& strategy_indices) {
+    if (state_writer_ == nullptr) {
         return;
     }
     {
@@ -732,19 +1027,20 @@ void StrategyEngine::SnapshotStates(EpochNanos now_ns) {
     }
 
     std::uint64_t failures = 0;
-    for (auto& entry : strategies_) {
+    for (const std::size_t index : strategy_indices) {
+        StrategyEntry& entry = strategies_[index];
         StrategyState state;
         std::string state_error;
         if (!entry.strategy->SaveState(&state, &state_error)) {
             ++failures;
             continue;
         }
-        if (entry.account_id.empty() ||
-            !config_.state_persistence->SaveStrategyState(entry.account_id, entry.strategy_id,
-                                                          state, &state_error)) {
+        if (entry.account_id.empty()) {
             ++failures;
             continue;
         }
+        // Only the capture runs on the worker; diffing and I/O happen on the writer thread.
+        state_writer_->Submit(entry.account_id, entry.strategy_id, std::move(state));
     }
     if (failures > 0) {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -752,18 +1048,19 @@ void StrategyEngine::SnapshotStates(EpochNanos now_ns) {
     }
 }
 
-void StrategyEngine::MaybeCollectMetrics(EpochNanos now_ns) {
+void StrategyEngine::MaybeCollectMetrics(Worker& worker, EpochNanos now_ns) {
     if (config_.metrics_collect_interval_ns <= 0) {
         return;
     }
-    if (last_metrics_collect_ns_ > 0 &&
-        (now_ns - last_metrics_collect_ns_) < config_.metrics_collect_interval_ns) {
+    if (worker.last_metrics_collect_ns > 0 &&
+        (now_ns - worker.last_metrics_collect_ns) < config_.metrics_collect_interval_ns) {
         return;
     }
-    last_metrics_collect_ns_ = now_ns;
+    worker.last_metrics_collect_ns = now_ns;
 
     std::vector<StrategyMetric> collected;
-    for (auto& entry : strategies_) {
+    for (const std::size_t index : worker.strategy_indices) {
+        StrategyEntry& entry = strategies_[index];
         try {
             std::vector<StrategyMetric> strategy_metrics = entry.strategy->CollectMetrics();
             for (auto& metric : strategy_metrics) {
@@ -784,9 +1081,12 @@ void StrategyEngine::MaybeCollectMetrics(EpochNanos now_ns) {
             ++stats_.strategy_callback_exceptions;
         }
     }
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.cached_metrics = std::move(collected);
+    }
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        cached_metrics_ = std::move(collected);
         ++stats_.metrics_collection_runs;
     }
 }
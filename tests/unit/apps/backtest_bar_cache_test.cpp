@@ -0,0 +1,134 @@
+#include "quant_hft/apps/backtest_bar_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace quant_hft::apps {
+namespace {
+
+std::filesystem::path MakeTempDir(const std::string& stem) {
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto dir =
+        std::filesystem::temp_directory_path() / (stem + "_" + std::to_string(stamp));
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+CachedReplayBar MakeCachedBar(const std::string& instrument_id, const std::string& minute,
+                              std::uint64_t tick_index, ReplayBarEmitPoint point, double close) {
+    CachedReplayBar row;
+    row.tick_index = tick_index;
+    row.emit_point = point;
+    row.first_tick_index = tick_index > 0 ? tick_index - 1 : 0;
+    row.last_tick_index = tick_index > 0 ? tick_index - 1 : 0;
+    row.bar.instrument_id = instrument_id;
+    row.bar.exchange_id = "DCE";
+    row.bar.trading_day = "20240103";
+    row.bar.action_day = "20240103";
+    row.bar.minute = minute;
+    row.bar.open = close - 1.0;
+    row.bar.high = close + 2.0;
+    row.bar.low = close - 3.0;
+    row.bar.close = close;
+    row.bar.analysis_open = row.bar.open + 0.5;
+    row.bar.analysis_high = row.bar.high + 0.5;
+    row.bar.analysis_low = row.bar.low + 0.5;
+    row.bar.analysis_close = close + 0.5;
+    row.bar.analysis_price_offset = 0.5;
+    row.bar.volume = 42;
+    row.bar.ts_ns = 1'704'243'600'000'000'000 + static_cast<EpochNanos>(tick_index);
+    row.bar.period_end_ts_ns = row.bar.ts_ns + 60'000'000'000;
+    row.bar.finalized_ts_ns = row.bar.period_end_ts_ns + 1;
+    row.bar.expected_source_bars = 1;
+    row.bar.observed_source_bars = 1;
+    row.bar.is_session_endpoint = point == ReplayBarEmitPoint::kEnd;
+    row.bar.volume_complete = false;
+    return row;
+}
+
+TEST(BacktestBarCacheTest, RoundTripsBarsFilteredTicksAndEmitPoints) {
+    const auto dir = MakeTempDir("backtest_bar_cache_roundtrip");
+    ReplayBarCache cache;
+    cache.key = "abc123";
+    cache.tick_count = 4;
+    cache.filtered_ticks = {0, 1, 0, 0};
+    cache.bars.push_back(
+        MakeCachedBar("c2405", "20240103 09:00", 2, ReplayBarEmitPoint::kTick, 100.0));
+    cache.bars.push_back(
+        MakeCachedBar("rb2405", "20240103 09:00", 3, ReplayBarEmitPoint::kFlushFinished, 200.0));
+    cache.bars.push_back(
+        MakeCachedBar("c2405", "20240103 09:01", 4, ReplayBarEmitPoint::kEnd, 101.0));
+
+    const auto path = ReplayBarCachePath(dir, cache.key);
+    std::string error;
+    ASSERT_TRUE(SaveReplayBarCache(path, cache, &error)) << error;
+
+    ReplayBarCache loaded;
+    ASSERT_TRUE(LoadReplayBarCache(path, cache.key, &loaded, &error)) << error;
+    EXPECT_EQ(loaded.key, cache.key);
+    EXPECT_EQ(loaded.tick_count, cache.tick_count);
+    EXPECT_EQ(loaded.filtered_ticks, cache.filtered_ticks);
+    ASSERT_EQ(loaded.bars.size(), cache.bars.size());
+    for (std::size_t index = 0; index < cache.bars.size(); ++index) {
+        const CachedReplayBar& expected = cache.bars[index];
+        const CachedReplayBar& actual = loaded.bars[index];
+        EXPECT_EQ(actual.tick_index, expected.tick_index);
+        EXPECT_EQ(actual.emit_point, expected.emit_point);
+        EXPECT_EQ(actual.first_tick_index, expected.first_tick_index);
+        EXPECT_EQ(actual.last_tick_index, expected.last_tick_index);
+        EXPECT_EQ(actual.bar.instrument_id, expected.bar.instrument_id);
+        EXPECT_EQ(actual.bar.minute, expected.bar.minute);
+        EXPECT_DOUBLE_EQ(actual.bar.close, expected.bar.close);
+        EXPECT_DOUBLE_EQ(actual.bar.analysis_low, expected.bar.analysis_low);
+        EXPECT_EQ(actual.bar.volume, expected.bar.volume);
+        EXPECT_EQ(actual.bar.ts_ns, expected.bar.ts_ns);
+        EXPECT_EQ(actual.bar.finalized_ts_ns, expected.bar.finalized_ts_ns);
+        EXPECT_EQ(actual.bar.is_session_endpoint, expected.bar.is_session_endpoint);
+        EXPECT_EQ(actual.bar.volume_complete, expected.bar.volume_complete);
+        EXPECT_TRUE(actual.bar.strategy_eligible);
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
+TEST(BacktestBarCacheTest, RejectsMissingMismatchedAndCorruptFiles) {
+    const auto dir = MakeTempDir("backtest_bar_cache_reject");
+    ReplayBarCache cache;
+    cache.key = "key-a";
+    cache.tick_count = 2;
+    cache.filtered_ticks = {0, 0};
+    cache.bars.push_back(
+        MakeCachedBar("c2405", "20240103 09:00", 1, ReplayBarEmitPoint::kTick, 100.0));
+
+    ReplayBarCache loaded;
+    std::string error;
+    EXPECT_FALSE(LoadReplayBarCache(ReplayBarCachePath(dir, "missing"), "missing", &loaded,
+                                    &error));
+
+    const auto path = ReplayBarCachePath(dir, cache.key);
+    ASSERT_TRUE(SaveReplayBarCache(path, cache, &error)) << error;
+    EXPECT_FALSE(LoadReplayBarCache(path, "key-b", &loaded, &error));
+    EXPECT_NE(error.find("key mismatch"), std::string::npos);
+
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-3, std::ios::end);
+        file.put('\x7f');
+    }
+    EXPECT_FALSE(LoadReplayBarCache(path, cache.key, &loaded, &error));
+    EXPECT_NE(error.find("crc mismatch"), std::string::npos) << error;
+
+    cache.filtered_ticks.clear();
+    EXPECT_FALSE(SaveReplayBarCache(path, cache, &error));
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
+}  // namespace
+}  // namespace quant_hft::apps
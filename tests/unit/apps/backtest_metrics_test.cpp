@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <vector>
@@ -212,5 +213,132 @@ TEST(BacktestMetricsTest, ComputeRegimePerformanceExcludesOpenLegsFromWinRate) {
     EXPECT_DOUBLE_EQ(performance[0].total_pnl, 50.0);
 }
 
+TEST(BacktestMetricsTest, ComputeRollingMetricsMatchesFullWindowRecompute) {
+    std::vector<DailyPerformance> daily;
+    double capital = 100.0;
+    for (int day = 0; day < 40; ++day) {
+        DailyPerformance perf;
+        perf.date = std::to_string(20240101 + day);
+        perf.daily_return_pct = std::sin(static_cast<double>(day) * 0.7) * 2.0;
+        capital *= 1.0 + perf.daily_return_pct / 100.0;
+        perf.capital = capital;
+        daily.push_back(perf);
+    }
+
+    const int window = 7;
+    const RollingMetrics rolling = ComputeRollingMetrics(daily, window);
+    ASSERT_EQ(rolling.rolling_sharpe_3m.size(), daily.size());
+    for (std::size_t end = 0; end < daily.size(); ++end) {
+        if (static_cast<int>(end + 1) < window) {
+            EXPECT_DOUBLE_EQ(rolling.rolling_sharpe_3m[end], 0.0);
+            EXPECT_DOUBLE_EQ(rolling.rolling_max_dd_3m[end], 0.0);
+            continue;
+        }
+        const std::size_t begin = end + 1 - static_cast<std::size_t>(window);
+        double mean = 0.0;
+        for (std::size_t index = begin; index <= end; ++index) {
+            mean += daily[index].daily_return_pct / 100.0;
+        }
+        mean /= static_cast<double>(window);
+        double variance = 0.0;
+        for (std::size_t index = begin; index <= end; ++index) {
+            const double diff = daily[index].daily_return_pct / 100.0 - mean;
+            variance += diff * diff;
+        }
+        const double stdev = std::sqrt(variance / static_cast<double>(window));
+        EXPECT_NEAR(rolling.rolling_sharpe_3m[end], mean / stdev * std::sqrt(252.0), 1e-9);
+
+        double peak = daily[begin].capital;
+        double max_dd = 0.0;
+        for (std::size_t index = begin; index <= end; ++index) {
+            peak = std::max(peak, daily[index].capital);
+            max_dd = std::max(max_dd, (peak - daily[index].capital) / peak * 100.0);
+        }
+        EXPECT_DOUBLE_EQ(rolling.rolling_max_dd_3m[end], max_dd);
+    }
+}
+
+TEST(BacktestMetricsTest, ComputeRollingMetricsKeepsZeroSharpeForConstantReturns) {
+    std::vector<DailyPerformance> daily;
+    for (int day = 0; day < 200; ++day) {
+        DailyPerformance perf;
+        perf.date = std::to_string(20240101 + day);
+        perf.daily_return_pct = 0.1;
+        perf.capital = 100.0 + static_cast<double>(day);
+        daily.push_back(perf);
+    }
+
+    const RollingMetrics rolling = ComputeRollingMetrics(daily, 63);
+    for (const double sharpe : rolling.rolling_sharpe_3m) {
+        EXPECT_DOUBLE_EQ(sharpe, 0.0);
+    }
+}
+
+TEST(BacktestMetricsTest, OnlineDailyMetricsMatchesBatchComputation) {
+    std::vector<EquitySample> latest_by_day;
+    OnlineDailyMetrics online(1000.0, 5);
+    double equity = 1000.0;
+    for (int day = 0; day < 12; ++day) {
+        const std::string trading_day = std::to_string(20240101 + day);
+        EquitySample last;
+        for (int tick = 0; tick < 4; ++tick) {
+            equity += std::cos(static_cast<double>(day * 4 + tick)) * 7.0;
+            EquitySample sample;
+            sample.ts_ns = static_cast<EpochNanos>(day * 4 + tick + 1) * 1'000'000'000LL;
+            sample.trading_day = trading_day;
+            sample.equity = equity;
+            sample.position_value = 10.0 * tick;
+            sample.market_regime = tick == 3 ? "" : "kWeakTrend";
+            online.UpsertEquitySample(sample);
+            if (tick < 3) {
+                last = sample;
+            } else {
+                last.ts_ns = sample.ts_ns;
+                last.equity = sample.equity;
+                last.position_value = sample.position_value;
+            }
+        }
+        latest_by_day.push_back(last);
+        EXPECT_EQ(online.closed_days(), static_cast<std::size_t>(day));
+    }
+
+    TradeRecord trade;
+    trade.trading_day = "20240103";
+    trade.price = 10.0;
+    trade.volume = 2;
+
+    RollingMetrics online_rolling;
+    const std::vector<DailyPerformance> online_daily = online.Finalize({trade}, &online_rolling);
+    const std::vector<DailyPerformance> batch_daily =
+        ComputeDailyMetrics(latest_by_day, {trade}, 1000.0);
+    const RollingMetrics batch_rolling = ComputeRollingMetrics(batch_daily, 5);
+
+    ASSERT_EQ(online_daily.size(), batch_daily.size());
+    for (std::size_t index = 0; index < batch_daily.size(); ++index) {
+        EXPECT_EQ(online_daily[index].date, batch_daily[index].date);
+        EXPECT_DOUBLE_EQ(online_daily[index].capital, batch_daily[index].capital);
+        EXPECT_DOUBLE_EQ(online_daily[index].daily_return_pct, batch_daily[index].daily_return_pct);
+        EXPECT_DOUBLE_EQ(online_daily[index].drawdown_pct, batch_daily[index].drawdown_pct);
+        EXPECT_EQ(online_daily[index].trades_count, batch_daily[index].trades_count);
+        EXPECT_EQ(online_daily[index].market_regime, "kWeakTrend");
+    }
+    EXPECT_EQ(online_rolling.rolling_sharpe_3m, batch_rolling.rolling_sharpe_3m);
+    EXPECT_EQ(online_rolling.rolling_max_dd_3m, batch_rolling.rolling_max_dd_3m);
+    EXPECT_EQ(online_daily[2].trades_count, 1);
+}
+
+TEST(BacktestMetricsTest, OnlineDailyMetricsRebuildsWhenEarlierDayArrivesLate) {
+    OnlineDailyMetrics online(100.0);
+    online.UpsertEquitySample(EquitySample{1, "20240102", 101.0, 0.0, "kFlat"});
+    online.UpsertEquitySample(EquitySample{2, "20240103", 103.0, 0.0, "kFlat"});
+    online.UpsertEquitySample(EquitySample{3, "20240101", 99.0, 0.0, "kFlat"});
+
+    const std::vector<DailyPerformance> daily = online.Finalize({}, nullptr);
+    ASSERT_EQ(daily.size(), 3U);
+    EXPECT_EQ(daily[0].date, "20240101");
+    EXPECT_DOUBLE_EQ(daily[0].capital, 99.0);
+    EXPECT_DOUBLE_EQ(daily[2].capital, 103.0);
+}
+
 }  // namespace
 }  // namespace quant_hft::apps
@@ -2272,6 +2272,210 @@ TEST(BacktestReplaySupportTest, RunBacktestSpecReplaysInterleavedMultiProductStr
     std::filesystem::remove(rb_main, ec);
 }
 
+TEST(BacktestReplaySupportTest, ParseBacktestCliSpecReadsProductParallelism) {
+    ArgMap args;
+    args["engine_mode"] = "csv";
+    args["csv_path"] = "ticks.csv";
+    args["product-parallelism"] = "4";
+    args["product-sync-granularity"] = "Day";
+
+    BacktestCliSpec spec;
+    std::string error;
+    ASSERT_TRUE(ParseBacktestCliSpec(args, &spec, &error)) << error;
+    EXPECT_EQ(spec.product_parallelism, 4);
+    EXPECT_EQ(spec.product_sync_granularity, "day");
+    BacktestCliSpec shared_spec = spec;
+    shared_spec.product_parallelism = 0;
+    EXPECT_NE(BuildInputSignature(spec), BuildInputSignature(shared_spec));
+
+    args["product-sync-granularity"] = "minute";
+    EXPECT_FALSE(ParseBacktestCliSpec(args, &spec, &error));
+    EXPECT_NE(error.find("product_sync_granularity"), std::string::npos);
+
+    args["product-sync-granularity"] = "bar";
+    args["product-parallelism"] = "-1";
+    EXPECT_FALSE(ParseBacktestCliSpec(args, &spec, &error));
+    EXPECT_NE(error.find("product_parallelism"), std::string::npos);
+}
+
+TEST(BacktestReplaySupportTest, RunBacktestSpecProductParallelReplayIsDeterministic) {
+    const std::string strategy_type = UniqueAtomicType("parallel_replay_open_once");
+    RegisterOpenOnceReplayType(strategy_type);
+    const std::filesystem::path csv_path =
+        WriteInterleavedProductReplayCsv("quant_hft_product_parallel_replay");
+    const std::filesystem::path c_atomic = WriteProductAtomicStrategyConfig("open_once_c");
+    const std::filesystem::path rb_atomic = WriteProductAtomicStrategyConfig("open_once_rb");
+    const std::filesystem::path c_main =
+        WriteProductMainStrategyConfig(c_atomic, strategy_type, "c", "c2405", "open_once_c");
+    const std::filesystem::path rb_main =
+        WriteProductMainStrategyConfig(rb_atomic, strategy_type, "rb", "rb2405", "open_once_rb");
+
+    ArgMap args;
+    args["engine_mode"] = "csv";
+    args["csv_path"] = csv_path.string();
+    args["strategy_main_config_paths"] = c_main.string() + "," + rb_main.string();
+    args["strategy_ids"] = "candidate_c,candidate_rb";
+    args["product_config_path"] = "";
+
+    BacktestCliSpec spec;
+    std::string error;
+    ASSERT_TRUE(ParseBacktestCliSpec(args, &spec, &error)) << error;
+
+    BacktestCliResult shared;
+    ASSERT_TRUE(RunBacktestSpec(spec, &shared, &error)) << error;
+
+    spec.product_parallelism = 1;
+    BacktestCliResult sequential;
+    ASSERT_TRUE(RunBacktestSpec(spec, &sequential, &error)) << error;
+    spec.product_parallelism = 4;
+    BacktestCliResult parallel;
+    ASSERT_TRUE(RunBacktestSpec(spec, &parallel, &error)) << error;
+
+    EXPECT_EQ(RenderBacktestJson(sequential), RenderBacktestJson(parallel));
+    EXPECT_EQ(parallel.replay.ticks_read, shared.replay.ticks_read);
+    EXPECT_EQ(parallel.replay.instrument_count, 2);
+    EXPECT_EQ(parallel.deterministic.instrument_bars, shared.deterministic.instrument_bars);
+
+    // Without margin pressure the isolated accounts fill exactly like the shared one.
+    ASSERT_EQ(parallel.trades.size(), shared.trades.size());
+    for (std::size_t index = 0; index < shared.trades.size(); ++index) {
+        EXPECT_EQ(parallel.trades[index].trade_id, shared.trades[index].trade_id);
+        EXPECT_EQ(parallel.trades[index].order_id, shared.trades[index].order_id);
+        EXPECT_EQ(parallel.trades[index].symbol, shared.trades[index].symbol);
+        EXPECT_EQ(parallel.trades[index].fill_seq, shared.trades[index].fill_seq);
+    }
+    EXPECT_DOUBLE_EQ(parallel.final_equity, shared.final_equity);
+
+    spec.deterministic_fills = false;
+    EXPECT_FALSE(RunBacktestSpec(spec, &parallel, &error));
+    EXPECT_NE(error.find("product_parallelism"), std::string::npos);
+
+    std::error_code ec;
+    std::filesystem::remove(csv_path, ec);
+    std::filesystem::remove(c_atomic, ec);
+    std::filesystem::remove(rb_atomic, ec);
+    std::filesystem::remove(c_main, ec);
+    std::filesystem::remove(rb_main, ec);
+}
+
+TEST(BacktestReplaySupportTest, RunBacktestSpecReplaysCachedBarsIdentically) {
+    const std::string strategy_type = UniqueAtomicType("bar_cache_open_once");
+    RegisterOpenOnceReplayType(strategy_type);
+    const std::filesystem::path csv_path =
+        WriteInterleavedProductReplayCsv("quant_hft_bar_cache_replay");
+    const std::filesystem::path c_atomic = WriteProductAtomicStrategyConfig("open_once_c");
+    const std::filesystem::path rb_atomic = WriteProductAtomicStrategyConfig("open_once_rb");
+    const std::filesystem::path c_main =
+        WriteProductMainStrategyConfig(c_atomic, strategy_type, "c", "c2405", "open_once_c");
+    const std::filesystem::path rb_main =
+        WriteProductMainStrategyConfig(rb_atomic, strategy_type, "rb", "rb2405", "open_once_rb");
+    const std::filesystem::path cache_dir =
+        std::filesystem::temp_directory_path() /
+        ("quant_hft_bar_cache_" +
+         std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+
+    ArgMap args;
+    args["engine_mode"] = "csv";
+    args["csv_path"] = csv_path.string();
+    args["strategy_main_config_paths"] = c_main.string() + "," + rb_main.string();
+    args["strategy_ids"] = "candidate_c,candidate_rb";
+    args["product_config_path"] = "";
+    args["run_id"] = "bar-cache-replay";
+
+    BacktestCliSpec spec;
+    std::string error;
+    ASSERT_TRUE(ParseBacktestCliSpec(args, &spec, &error)) << error;
+    BacktestCliResult uncached;
+    ASSERT_TRUE(RunBacktestSpec(spec, &uncached, &error)) << error;
+    EXPECT_TRUE(uncached.bar_cache_status.empty());
+
+    args["bar_cache_dir"] = cache_dir.string();
+    ASSERT_TRUE(ParseBacktestCliSpec(args, &spec, &error)) << error;
+    BacktestCliResult stored;
+    ASSERT_TRUE(RunBacktestSpec(spec, &stored, &error)) << error;
+    EXPECT_EQ(stored.bar_cache_status, "stored");
+    BacktestCliResult cached;
+    ASSERT_TRUE(RunBacktestSpec(spec, &cached, &error)) << error;
+    EXPECT_EQ(cached.bar_cache_status, "hit");
+
+    ASSERT_FALSE(uncached.trades.empty());
+    EXPECT_EQ(RenderBacktestJson(stored), RenderBacktestJson(uncached));
+    EXPECT_EQ(RenderBacktestJson(cached), RenderBacktestJson(uncached));
+
+    // The cache key covers the tick selection, so a narrower replay does not reuse the entry.
+    args["symbols"] = "c2405";
+    ASSERT_TRUE(ParseBacktestCliSpec(args, &spec, &error)) << error;
+    BacktestCliResult narrowed;
+    ASSERT_TRUE(RunBacktestSpec(spec, &narrowed, &error)) << error;
+    EXPECT_EQ(narrowed.bar_cache_status, "stored");
+
+    std::error_code ec;
+    std::filesystem::remove_all(cache_dir, ec);
+    std::filesystem::remove(csv_path, ec);
+    std::filesystem::remove(c_atomic, ec);
+    std::filesystem::remove(rb_atomic, ec);
+    std::filesystem::remove(c_main, ec);
+    std::filesystem::remove(rb_main, ec);
+}
+
+TEST(BacktestReplaySupportTest, ComputeDatasetDigestHashesManifestRangeThroughDigestIndex) {
+    const auto root = MakeTempDir("quant_hft_dataset_digest_index");
+    const auto write_file = [](const std::filesystem::path& path, const std::string& content) {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << content;
+    };
+    const auto day1 = root / "source=c/trading_day=20240102/instrument_id=c2405/part-0000.parquet";
+    const auto day2 = root / "source=c/trading_day=20240103/instrument_id=c2405/part-0000.parquet";
+    write_file(day1, "day1-rows");
+    write_file(day2, "day2-rows");
+    const EpochNanos day1_ns = detail::ToEpochNs("20240102", "10:00:00", 0);
+    const EpochNanos day2_ns = detail::ToEpochNs("20240103", "10:00:00", 0);
+    {
+        std::filesystem::create_directories(root / "_manifest");
+        std::ofstream manifest(root / "_manifest" / "partitions.jsonl");
+        manifest << "{\"file_path\":\"" << day1.lexically_relative(root).generic_string()
+                 << "\",\"source\":\"c\",\"min_ts_ns\":" << day1_ns << ",\"max_ts_ns\":" << day1_ns
+                 << "}\n";
+        manifest << "{\"file_path\":\"" << day2.lexically_relative(root).generic_string()
+                 << "\",\"source\":\"c\",\"min_ts_ns\":" << day2_ns << ",\"max_ts_ns\":" << day2_ns
+                 << "}\n";
+    }
+
+    std::string error;
+    const std::string first = ComputeDatasetDigest(root, "20240102", "20240102", &error);
+    ASSERT_FALSE(first.empty()) << error;
+    DatasetDigestIndex index;
+    ASSERT_TRUE(index.Load(DatasetDigestIndex::PathFor(root), &error)) << error;
+    EXPECT_EQ(index.size(), 1U);
+
+    // Files outside the manifest or the date range do not affect the digest, and neither does
+    // a touch that leaves the content unchanged.
+    write_file(root / "stray.csv", "ignored");
+    write_file(day2, "day2-rows-rewritten");
+    std::filesystem::last_write_time(day1, std::filesystem::last_write_time(day1) +
+                                               std::chrono::hours(1));
+    EXPECT_EQ(ComputeDatasetDigest(root, "20240102", "20240102", &error), first);
+    EXPECT_NE(ComputeDatasetDigest(root, "20240102", "20240103", &error), first);
+
+    write_file(day1, "day1-ROWS");
+    std::filesystem::last_write_time(day1, std::filesystem::last_write_time(day1) +
+                                               std::chrono::hours(2));
+    const std::string changed = ComputeDatasetDigest(root, "20240102", "20240102", &error);
+    ASSERT_FALSE(changed.empty()) << error;
+    EXPECT_NE(changed, first);
+
+    std::vector<std::string> digests;
+    ASSERT_TRUE(ComputeFileDigests({day1, day2}, 4, &digests, &error)) << error;
+    ASSERT_EQ(digests.size(), 2U);
+    EXPECT_EQ(digests[0], ComputeFileDigest(day1, &error));
+    EXPECT_EQ(digests[1], ComputeFileDigest(day2, &error));
+    EXPECT_FALSE(ComputeFileDigests({root / "missing.parquet"}, 2, &digests, &error));
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+}
+
 TEST(BacktestReplaySupportTest, LoadCsvTicksAcceptsUtf8BomHeader) {
     const std::filesystem::path csv_path = WriteBomHeaderReplayCsv("quant_hft_bom_header");
 
@@ -0,0 +1,117 @@
+#include "quant_hft/apps/log_tail_follower.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace quant_hft::apps {
+namespace {
+
+std::filesystem::path MakeTempDir(const std::string& stem) {
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto dir =
+        std::filesystem::temp_directory_path() / (stem + "_" + std::to_string(stamp));
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+void AppendText(const std::filesystem::path& path, const std::string& text) {
+    std::ofstream out(path, std::ios::app | std::ios::binary);
+    out << text;
+}
+
+TEST(LogTailFollowerTest, ReturnsOnlyLinesAppendedSinceLastPoll) {
+    const auto dir = MakeTempDir("log_tail_follower_append");
+    const auto path = dir / "core.log";
+    AppendText(path, "first\nsecond\r\n");
+
+    LogTailFollower follower;
+    auto poll = follower.Poll(path.string());
+    EXPECT_TRUE(poll.exists);
+    EXPECT_FALSE(poll.reset);
+    EXPECT_EQ(poll.lines, (std::vector<std::string>{"first", "second"}));
+
+    poll = follower.Poll(path.string());
+    EXPECT_TRUE(poll.lines.empty());
+
+    AppendText(path, "third\n");
+    poll = follower.Poll(path.string());
+    EXPECT_FALSE(poll.reset);
+    EXPECT_EQ(poll.lines, (std::vector<std::string>{"third"}));
+    EXPECT_EQ(follower.offset(), std::filesystem::file_size(path));
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(LogTailFollowerTest, HoldsBackUnterminatedLineUntilFinished) {
+    const auto dir = MakeTempDir("log_tail_follower_partial");
+    const auto path = dir / "wal.jsonl";
+    AppendText(path, "done\npart");
+
+    LogTailFollower follower;
+    auto poll = follower.Poll(path.string());
+    EXPECT_EQ(poll.lines, (std::vector<std::string>{"done"}));
+    EXPECT_EQ(follower.pending_line(), "part");
+
+    AppendText(path, "ial\nnext");
+    poll = follower.Poll(path.string());
+    EXPECT_EQ(poll.lines, (std::vector<std::string>{"partial"}));
+    EXPECT_EQ(follower.pending_line(), "next");
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(LogTailFollowerTest, ResetsOnTruncationAndRotation) {
+    const auto dir = MakeTempDir("log_tail_follower_reset");
+    const auto path = dir / "core.log";
+    AppendText(path, "old-1\nold-2\n");
+
+    LogTailFollower follower;
+    ASSERT_EQ(follower.Poll(path.string()).lines.size(), 2U);
+
+    std::filesystem::resize_file(path, 0);
+    AppendText(path, "new\n");
+    auto poll = follower.Poll(path.string());
+    EXPECT_TRUE(poll.reset);
+    EXPECT_EQ(poll.lines, (std::vector<std::string>{"new"}));
+
+    const auto rotated = dir / "core.log.1";
+    std::filesystem::rename(path, rotated);
+    AppendText(path, "rotated-a\nrotated-b\n");
+    poll = follower.Poll(path.string());
+    EXPECT_TRUE(poll.reset);
+    EXPECT_EQ(poll.lines, (std::vector<std::string>{"rotated-a", "rotated-b"}));
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(LogTailFollowerTest, ReportsMissingFileAndResetsAfterItVanishes) {
+    const auto dir = MakeTempDir("log_tail_follower_missing");
+    const auto path = dir / "probe.log";
+
+    LogTailFollower follower;
+    auto poll = follower.Poll(path.string());
+    EXPECT_FALSE(poll.exists);
+    EXPECT_FALSE(poll.reset);
+
+    AppendText(path, "line\n");
+    poll = follower.Poll(path.string());
+    EXPECT_TRUE(poll.exists);
+    EXPECT_FALSE(poll.reset);
+    EXPECT_EQ(poll.lines.size(), 1U);
+
+    std::filesystem::remove(path);
+    poll = follower.Poll(path.string());
+    EXPECT_FALSE(poll.exists);
+    EXPECT_TRUE(poll.reset);
+    EXPECT_EQ(follower.offset(), 0U);
+
+    std::filesystem::remove_all(dir);
+}
+
+}  // namespace
+}  // namespace quant_hft::apps
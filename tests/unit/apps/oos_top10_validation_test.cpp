@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
@@ -345,5 +346,66 @@ TEST(OosTop10ValidationTest, ContinuesAfterBacktestFailureAndRecordsError) {
     std::filesystem::remove_all(dir);
 }
 
+TEST(OosTop10ValidationTest, ParallelCandidatesKeepRankOrderAndMatchSerialRun) {
+    const auto dir = MakeTempDir("oos_top10_validation_parallel");
+    const auto runtime_root = dir / "runtime" / "rolling_optimize_kama";
+    const auto top_trials_dir = runtime_root / "top_trials" / "window_0000";
+    WriteArchivedTrial(top_trials_dir, "01_trial_alpha", "trial_alpha");
+    WriteArchivedTrial(top_trials_dir, "02_trial_beta", "trial_beta");
+    WriteArchivedTrial(top_trials_dir, "03_trial_gamma", "trial_gamma");
+    const auto train_report = WriteTrainReport(runtime_root);
+
+    std::atomic<int> run_count{0};
+    OosBacktestRunFn run_fn = [&](const BacktestCliSpec& spec, BacktestCliResult* out,
+                                  std::string* error) {
+        ++run_count;
+        if (spec.run_id.find("trial_gamma") != std::string::npos) {
+            *error = "synthetic oos failure";
+            return false;
+        }
+        const double pnl = spec.run_id.find("trial_alpha") != std::string::npos ? 48.0 : 24.0;
+        *out = MakeBacktestResult(spec, spec.run_id, pnl, 80.0, 2.0,
+                                  MakeDailySeries(0.05, 0.05, 0.08, 0.03, 0.08, 0.08));
+        return true;
+    };
+
+    OosTop10ValidationRequest request;
+    request.train_report_json = train_report.string();
+    request.oos_start_date = "20240701";
+    request.oos_end_date = "20241231";
+    request.top_n = 3;
+    request.overwrite = true;
+
+    OosTop10ValidationReport serial;
+    std::string error;
+    request.output_dir = (dir / "serial").string();
+    ASSERT_TRUE(RunOosTop10Validation(request, &serial, &error, run_fn)) << error;
+
+    OosTop10ValidationReport parallel;
+    request.output_dir = (dir / "parallel").string();
+    request.parallelism = 3;
+    ASSERT_TRUE(RunOosTop10Validation(request, &parallel, &error, run_fn)) << error;
+
+    EXPECT_EQ(run_count.load(), 6);
+    EXPECT_EQ(parallel.success_count, 2);
+    EXPECT_EQ(parallel.failed_count, 1);
+    EXPECT_EQ(parallel.recommended_trial_id, serial.recommended_trial_id);
+    ASSERT_EQ(parallel.rows.size(), serial.rows.size());
+    for (std::size_t index = 0; index < parallel.rows.size(); ++index) {
+        EXPECT_EQ(parallel.rows[index].rank, static_cast<int>(index) + 1);
+        EXPECT_EQ(parallel.rows[index].trial_id, serial.rows[index].trial_id);
+        EXPECT_EQ(parallel.rows[index].status, serial.rows[index].status);
+        EXPECT_EQ(parallel.rows[index].error_msg, serial.rows[index].error_msg);
+        EXPECT_EQ(parallel.rows[index].oos_total_pnl, serial.rows[index].oos_total_pnl);
+    }
+    EXPECT_EQ(ReadFile(parallel.output_csv), ReadFile(serial.output_csv));
+
+    request.parallelism = 0;
+    EXPECT_FALSE(RunOosTop10Validation(request, &parallel, &error, run_fn));
+    EXPECT_EQ(error, "parallelism must be positive");
+
+    std::filesystem::remove_all(dir);
+}
+
 }  // namespace
 }  // namespace quant_hft::rolling
\ No newline at end of file
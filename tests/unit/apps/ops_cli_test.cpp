@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
@@ -598,4 +600,70 @@ TEST(OpsCli, MarketDataRepairRefusesToOverwriteInputEvidence) {
     EXPECT_NE(ReadFile(output_log).find("refusing to overwrite output root"), std::string::npos);
 }
 
+TEST(OpsCli, MarketDataRepairParallelProductsMatchSerialOutput) {
+    const auto dir = MakeTempDir("market_data_repair_parallel");
+    const auto input_root = dir / "input";
+    const std::vector<std::pair<std::string, std::string>> products = {
+        {"rb", "rb2610"}, {"hc", "hc2610"}, {"ag", "ag2610"}};
+    const std::vector<std::pair<std::string, std::int64_t>> days = {
+        {"20260702", 1782954000LL}, {"20260703", 1783040400LL}};
+    for (const auto& [product, instrument] : products) {
+        for (const auto& [day, start_epoch_s] : days) {
+            std::ostringstream ticks;
+            ticks << "instrument_id,exchange_id,trading_day,action_day,update_time,"
+                     "update_millisec,last_price,bid_price_1,ask_price_1,bid_volume_1,"
+                     "ask_volume_1,volume,open_interest,recv_ts_ns\n";
+            for (int index = 0; index < 24; ++index) {
+                const int seconds = index * 30;
+                char update_time[16];
+                std::snprintf(update_time, sizeof(update_time), "09:%02d:%02d", seconds / 60,
+                              seconds % 60);
+                const std::int64_t recv_ts_ns = (start_epoch_s + seconds) * 1'000'000'000LL;
+                ticks << instrument << ",SHFE," << day << ',' << day << ',' << update_time
+                      << ",0," << 3500 + index << ',' << 3499 + index << ',' << 3501 + index
+                      << ",5,5," << 10 * (index + 1) << ",1000," << recv_ts_ns << '\n';
+            }
+            WriteFile(input_root / ("trading_day=" + day) / "varieties" / product / "market" /
+                          "ticks.csv",
+                      ticks.str());
+        }
+    }
+
+    const auto run_repair = [&](const std::string& name, const std::string& extra_args) {
+        const auto output_root = dir / name;
+        const std::string command =
+            "\"" + BinaryPath("market_data_repair_cli").string() + "\" --repo-root \"" +
+            dir.string() + "\" --input-root \"" + input_root.string() + "\" --output-root \"" +
+            output_root.string() + "\" --trading-root \"" + (dir / "trading").string() +
+            "\" --wal-file \"" + (dir / "missing.wal").string() + "\" --report-json \"" +
+            (dir / (name + ".json")).string() + "\" --report-md \"" +
+            (dir / (name + ".md")).string() + "\" --start-day 20260701 --end-day 20260718 " +
+            extra_args;
+        RunCommandCapture(command, dir / (name + ".log"));
+        return output_root;
+    };
+    const auto serial_root = run_repair("serial", "--jobs 1");
+    const auto parallel_root = run_repair("parallel", "--jobs 3 --max-buffered-mb 1");
+    EXPECT_NE(ReadFile(dir / "parallel.log").find("jobs=3"), std::string::npos);
+
+    std::vector<std::filesystem::path> serial_files;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(serial_root)) {
+        if (entry.is_regular_file()) {
+            serial_files.push_back(std::filesystem::relative(entry.path(), serial_root));
+        }
+    }
+    ASSERT_FALSE(serial_files.empty());
+    EXPECT_TRUE(std::filesystem::exists(serial_root / "trading_day=20260703" / "varieties" /
+                                        "hc" / "market" / "bars_1m.csv"));
+    for (const auto& relative : serial_files) {
+        ASSERT_TRUE(std::filesystem::exists(parallel_root / relative)) << relative;
+        EXPECT_EQ(ReadFile(serial_root / relative), ReadFile(parallel_root / relative))
+            << relative;
+    }
+    const std::string manifest = ReadFile(parallel_root / "baseline_sha256.csv");
+    EXPECT_NE(manifest.find("input/trading_day=20260702/varieties/ag/market/ticks.csv"),
+              std::string::npos);
+    EXPECT_EQ(ReadLines(parallel_root / "baseline_sha256.csv").size(), 7U);
+}
+
 }  // namespace
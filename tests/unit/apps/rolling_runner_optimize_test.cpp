@@ -5,9 +5,12 @@
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "quant_hft/strategy/atomic/kama_trend_indicator_batch.h"
+
 namespace quant_hft::rolling {
 namespace {
 
@@ -401,6 +404,143 @@ TEST(RollingRunnerOptimizeTest, SupportsRandomSearchAlgorithm) {
     std::filesystem::remove_all(dir, ec);
 }
 
+TEST(RollingRunnerOptimizeTest, SharesKamaTrendIndicatorsAcrossTrialBatch) {
+    const auto dir = MakeTempDir("rolling_runner_kama_batch");
+    const auto dataset_root = dir / "data";
+    const auto manifest = WriteManifest(dataset_root, {"20230101", "20230102", "20230103", "20230104"});
+    const auto products = WriteFile(dir / "instrument_info.json", "{\"products\":{}}\n");
+    const auto calendar = WriteFile(dir / "contract_expiry_calendar.yaml", "contracts:\n");
+
+    const auto sub_config = WriteFile(dir / "sub_strategy.yaml",
+                                      "params:\n"
+                                      "  id: kama_1\n"
+                                      "  er_period: 10\n"
+                                      "  default_volume: 1\n");
+
+    const auto composite_config = WriteFile(dir / "composite.yaml",
+                                            "run_type: backtest\n"
+                                            "market_state_mode: false\n"
+                                            "backtest:\n"
+                                            "  initial_equity: 200000\n"
+                                            "  product_series_mode: raw\n"
+                                            "  symbols: [rb]\n"
+                                            "  start_date: 20230101\n"
+                                            "  end_date: 20230131\n"
+                                            "  product_config_path: " +
+                                                products.string() +
+                                                "\n"
+                                                "  contract_expiry_calendar_path: " +
+                                                calendar.string() +
+                                                "\n"
+                                                "composite:\n"
+                                            "  merge_rule: kPriority\n"
+                                            "  enable_non_backtest: false\n"
+                                            "  sub_strategies:\n"
+                                            "    - id: kama_1\n"
+                                            "      enabled: true\n"
+                                            "      timeframe_minutes: 5\n"
+                                            "      type: KamaTrendStrategy\n"
+                                            "      config_path: " +
+                                                sub_config.string() + "\n");
+
+    const auto param_space = WriteFile(
+        dir / "param_space.yaml",
+        "composite_config_path: " + composite_config.string() +
+            "\n"
+            "target_sub_config_path: " + sub_config.string() +
+            "\n"
+            "backtest_args:\n"
+            "  engine_mode: parquet\n"
+            "  dataset_root: " +
+            dataset_root.string() +
+            "\n"
+            "optimization:\n"
+            "  algorithm: grid\n"
+            "  metric_path: hf_standard.profit_factor\n"
+            "  maximize: true\n"
+            "  max_trials: 10\n"
+            "  parallel: 2\n"
+            "parameters:\n"
+            "  - name: er_period\n"
+            "    type: int\n"
+            "    values: [5, 10]\n");
+
+    RollingConfig config;
+    config.mode = "rolling_optimize";
+    config.backtest_base.engine_mode = "parquet";
+    config.backtest_base.dataset_root = dataset_root.string();
+    config.backtest_base.dataset_manifest = manifest.string();
+    config.backtest_base.strategy_factory = "composite";
+    config.backtest_base.strategy_composite_config = composite_config.string();
+    config.backtest_base.product_config_path = products.string();
+    config.backtest_base.contract_expiry_calendar_path = calendar.string();
+    config.backtest_base.initial_equity = 200000.0;
+    config.backtest_base.symbols = {"rb"};
+    config.window.type = "rolling";
+    config.window.train_length_days = 2;
+    config.window.test_length_days = 2;
+    config.window.step_days = 2;
+    config.window.min_train_days = 2;
+    config.window.start_date = "20230101";
+    config.window.end_date = "20230131";
+
+    config.optimization.algorithm = "grid";
+    config.optimization.metric = "hf_standard.profit_factor";
+    config.optimization.maximize = true;
+    config.optimization.max_trials = 10;
+    config.optimization.parallel = 2;
+    config.optimization.param_space = param_space.string();
+    config.optimization.target_sub_config_path = sub_config.string();
+
+    config.output.root_dir = (dir / "artifacts").string();
+    config.output.report_json = (dir / "artifacts" / "report.json").string();
+    config.output.report_md = (dir / "artifacts" / "report.md").string();
+    config.output.best_params_dir = (dir / "best").string();
+    config.output.keep_temp_files = false;
+    config.output.window_parallel = 1;
+
+    std::mutex batch_sizes_mutex;
+    std::vector<std::size_t> train_batch_sizes;
+    bool test_run_shared = false;
+    auto fake_run_fn = [&](const quant_hft::apps::BacktestCliSpec& spec,
+                           quant_hft::apps::BacktestCliResult* out, std::string* error) {
+        (void)error;
+        const auto batch = KamaTrendIndicatorBatch::Current();
+        {
+            std::lock_guard<std::mutex> lock(batch_sizes_mutex);
+            if (spec.run_id.find("-train-") != std::string::npos) {
+                train_batch_sizes.push_back(batch == nullptr ? 0U : batch->size());
+            } else {
+                test_run_shared = test_run_shared || batch != nullptr;
+            }
+        }
+        quant_hft::apps::BacktestCliResult result;
+        result.run_id = spec.run_id;
+        result.spec = spec;
+        result.mode = "backtest";
+        result.engine_mode = spec.engine_mode;
+        result.data_source = "parquet";
+        result.advanced_summary.profit_factor = 2.0;
+        result.has_deterministic = true;
+        result.deterministic.performance.total_pnl = 20.0;
+        result.deterministic.performance.max_drawdown = -1.0;
+        result.final_equity = 1000020.0;
+        *out = std::move(result);
+        return true;
+    };
+
+    RollingReport report;
+    std::string error;
+    ASSERT_TRUE(RunRollingBacktest(config, &report, &error, fake_run_fn)) << error;
+    ASSERT_EQ(report.windows.size(), 1U);
+    ASSERT_TRUE(report.windows[0].success) << report.windows[0].error_msg;
+    EXPECT_EQ(train_batch_sizes, (std::vector<std::size_t>{2U, 2U}));
+    EXPECT_FALSE(test_run_shared);
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
 }  // namespace
 }  // namespace quant_hft::rolling
 
@@ -2,6 +2,7 @@
 #include <unistd.h>
 
 #include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
@@ -41,6 +42,31 @@ void WriteFile(const std::filesystem::path& path, const std::string& content) {
     out << content;
 }
 
+void AppendFile(const std::filesystem::path& path, const std::string& content) {
+    std::ofstream out(path, std::ios::app);
+    out << content;
+}
+
+// The ctp_connection and ctp_order_flow sections of a dashboard state JSON, without the
+// wall-clock probe age.
+std::string CtpSections(const std::string& json) {
+    const std::size_t begin = json.find("  \"ctp_connection\": {");
+    const std::size_t flow = json.find("  \"ctp_order_flow\": {", begin);
+    const std::size_t end = json.find("\n  },\n", flow);
+    if (begin == std::string::npos || flow == std::string::npos || end == std::string::npos) {
+        return "";
+    }
+    std::istringstream lines(json.substr(begin, end - begin));
+    std::string sections;
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.find("\"probe_age_seconds\"") == std::string::npos) {
+            sections += line + "\n";
+        }
+    }
+    return sections;
+}
+
 std::filesystem::path MakeTempDir(const std::string& suffix) {
     const auto base =
         std::filesystem::temp_directory_path() / ("quant_hft_simnow_dashboard_cli_test_" + suffix);
@@ -514,6 +540,67 @@ TEST(SimnowDashboardCli, RendersCtpConnectionAndOrderFlowPanels) {
     EXPECT_EQ(html.find("auth_code"), std::string::npos);
 }
 
+TEST(SimnowDashboardCli, WatchModeFoldsAppendedLinesLikeAFullRead) {
+    const auto root = MakeTempDir("watch_incremental");
+    const auto watch_dir = root / "dashboard_watch";
+    const auto full_dir = root / "dashboard_full";
+    const auto core_log = root / "runs" / "run_1" / "core_engine.log";
+    const auto probe_log = root / "verify_simnow_login" / "simnow_probe_real.log";
+    const auto wal = root / "wal" / "events.wal";
+    WriteSampleCtpRuntime(root, core_log);
+    WriteSampleCtpSignalMonitor(root);
+    WriteSampleCtpWal(root);
+
+    const std::string command = DashboardCommand(root, watch_dir) +
+                                " --watch-seconds 1 --max-refreshes 3 2>&1";
+    FILE* pipe = ::popen(command.c_str(), "r");
+    ASSERT_NE(pipe, nullptr);
+    char line[4096];
+    // Each "wrote" line ends a refresh; the next one starts a second later.
+    ASSERT_NE(std::fgets(line, sizeof(line), pipe), nullptr);
+    AppendFile(core_log,
+               "ts_ns=8 level=warn app=core_engine event=ctp_td_front_disconnected reason=4097\n"
+               "ts_ns=9 level=info app=core_engine event=ctp_reconnect_attempt attempt=1\n"
+               "ts_ns=10 level=info app=core_engine event=order_submitted "
+               "trace_id=kama_candidate_c-open-c2607-3 "
+               "client_order_id=kama_candidate_c-0003-3 instr");
+    AppendFile(probe_log,
+               "ts_ns=3 level=warn app=simnow_probe event=session_snapshot state=reconnecting\n");
+    AppendFile(wal,
+               "{\"seq\":3,\"schema_version\":2,\"kind\":\"trade\","
+               "\"event_type\":\"trade_fill\","
+               "\"strategy_id\":\"kama_trend_production\","
+               "\"trace_id\":\"kama_trend_production-close-c2607-3\",");
+    ASSERT_NE(std::fgets(line, sizeof(line), pipe), nullptr);
+    AppendFile(core_log,
+               "ument_id=c2607\n"
+               "ts_ns=11 level=info app=core_engine event=ctp_td_front_connected\n"
+               "ts_ns=12 level=info app=core_engine event=ctp_order_submitted "
+               "trace_id=kama_candidate_c-open-c2607-3 "
+               "client_order_id=kama_candidate_c-0003-3 order_ref=0003 request_id=9\n");
+    AppendFile(probe_log,
+               "ts_ns=4 level=info app=simnow_probe event=probe_completed state=healthy\n");
+    AppendFile(wal,
+               "\"client_order_id\":\"kama_trend_production-0003-3\","
+               "\"instrument_id\":\"c2607\",\"exchange_id\":\"DCE\","
+               "\"side\":1,\"offset\":1,\"last_trade_volume\":1,"
+               "\"avg_fill_price\":2331,\"order_ref\":\"0003\","
+               "\"trade_id\":\"trade-3\",\"ts_ns\":1780291287262046132}\n");
+    ASSERT_NE(std::fgets(line, sizeof(line), pipe), nullptr);
+    while (std::fgets(line, sizeof(line), pipe) != nullptr) {
+    }
+    ASSERT_EQ(::pclose(pipe), 0);
+
+    const int rc = RunCommandCapture(DashboardCommand(root, full_dir), root / "stdout.log");
+    ASSERT_EQ(rc, 0) << ReadFile(root / "stdout.log");
+    const std::string watched = CtpSections(ReadFile(watch_dir / "dashboard_state.json"));
+    const std::string full = CtpSections(ReadFile(full_dir / "dashboard_state.json"));
+    ASSERT_FALSE(full.empty());
+    EXPECT_EQ(watched, full);
+    EXPECT_NE(full.find("\"trade_id\": \"trade-3\""), std::string::npos) << full;
+    EXPECT_NE(full.find("\"ctp_submitted\": 2"), std::string::npos) << full;
+}
+
 TEST(SimnowDashboardCli, RendersInternalOffsetCodesAsCloseNames) {
     const auto root = MakeTempDir("offset_codes");
     const auto output_dir = root / "dashboard";
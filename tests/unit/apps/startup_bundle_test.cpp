@@ -0,0 +1,159 @@
+#include "quant_hft/apps/startup_bundle.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace quant_hft {
+namespace {
+
+std::filesystem::path MakeTempDir(const std::string& stem) {
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto dir =
+        std::filesystem::temp_directory_path() / (stem + "_" + std::to_string(stamp));
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+void WriteText(const std::filesystem::path& path, const std::string& text) {
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    out << text;
+}
+
+InstrumentMetaSnapshot MakeInstrument(const std::string& instrument_id) {
+    InstrumentMetaSnapshot row;
+    row.instrument_id = instrument_id;
+    row.exchange_id = "SHFE";
+    row.product_id = "rb";
+    row.volume_multiple = 10;
+    row.price_tick = 1.0;
+    row.ts_ns = 1'700'000'000'000'000'000;
+    row.source = "ctp";
+    row.open_date = "20250915";
+    row.expire_date = "20261015";
+    row.is_trading = true;
+    row.product_class = "1";
+    return row;
+}
+
+struct BundleFixture {
+    std::filesystem::path dir;
+    std::filesystem::path cache_path;
+    std::filesystem::path sessions_path;
+};
+
+BundleFixture WriteSources(const std::string& stem) {
+    BundleFixture fixture;
+    fixture.dir = MakeTempDir(stem);
+    fixture.cache_path = fixture.dir / "rb_contracts.json";
+    fixture.sessions_path = fixture.dir / "trading_sessions.yaml";
+    std::string error;
+    EXPECT_TRUE(WriteInstrumentMetaCacheV2Atomically(
+        fixture.cache_path.string(), "rb", "20260105",
+        {MakeInstrument("rb2605"), MakeInstrument("rb2610")}, 1'700'000'000'000'000'000, &error))
+        << error;
+    WriteText(fixture.sessions_path,
+              "sessions:\n"
+              "  - exchange: SHFE\n"
+              "    instrument_prefix: \"rb\"\n"
+              "    day: \"09:00-10:15,10:30-11:30,13:30-15:00\"\n"
+              "    night: \"21:00-23:00\"\n");
+    return fixture;
+}
+
+TEST(StartupBundleTest, RoundTripsInstrumentCachesAndSessionRules) {
+    const auto fixture = WriteSources("startup_bundle_roundtrip");
+    StartupBundle built;
+    std::string error;
+    ASSERT_TRUE(BuildStartupBundle({fixture.cache_path.string()}, fixture.sessions_path.string(),
+                                   false, 42, &built, &error))
+        << error;
+    const std::string bundle_path = (fixture.dir / "startup_bundle.bin").string();
+    ASSERT_TRUE(WriteStartupBundleAtomically(bundle_path, built, &error)) << error;
+
+    StartupBundle loaded;
+    ASSERT_TRUE(LoadStartupBundle(bundle_path, &loaded, &error)) << error;
+    EXPECT_EQ(loaded.generated_ts_ns, 42);
+    ASSERT_EQ(loaded.instrument_caches.size(), 1U);
+    const auto* cache = FindStartupBundleInstrumentCache(loaded, "RB");
+    ASSERT_NE(cache, nullptr);
+    EXPECT_EQ(cache->source.path, fixture.cache_path.string());
+    EXPECT_TRUE(IsStartupBundleSourceCurrent(cache->source));
+    EXPECT_EQ(cache->document.schema_version, 2);
+    EXPECT_EQ(cache->document.broker_trading_day, "20260105");
+    ASSERT_EQ(cache->document.instruments.size(), 2U);
+    const auto& row = cache->document.instruments[1];
+    EXPECT_EQ(row.instrument_id, "rb2610");
+    EXPECT_EQ(row.volume_multiple, 10);
+    EXPECT_DOUBLE_EQ(row.price_tick, 1.0);
+    EXPECT_EQ(row.expire_date, "20261015");
+    EXPECT_TRUE(row.is_trading);
+    EXPECT_EQ(row.product_class, "1");
+    EXPECT_EQ(FindStartupBundleInstrumentCache(loaded, "au"), nullptr);
+
+    ASSERT_TRUE(loaded.has_sessions);
+    EXPECT_FALSE(loaded.sessions.use_default_fallback);
+    ASSERT_EQ(loaded.sessions.rules.count("SHFE"), 1U);
+    const auto& rules = loaded.sessions.rules.at("SHFE");
+    ASSERT_EQ(rules.size(), 1U);
+    EXPECT_EQ(rules[0].intervals.size(), 4U);
+
+    const auto calendar = CompiledSessionCalendar::InstallShared(
+        fixture.sessions_path.string(), false, loaded.sessions.rules);
+    EXPECT_EQ(CompiledSessionCalendar::Shared(fixture.sessions_path.string(), false).get(),
+              calendar.get());
+    const auto* schedule = calendar->ResolveInstrument("SHFE", "rb2610");
+    ASSERT_NE(schedule, nullptr);
+    EXPECT_TRUE(schedule->IsOpen(22 * 60));
+    EXPECT_FALSE(schedule->IsOpen(23 * 60 + 30));
+}
+
+TEST(StartupBundleTest, DetectsStaleSourcesAndCorruptBundles) {
+    const auto fixture = WriteSources("startup_bundle_stale");
+    StartupBundle built;
+    std::string error;
+    ASSERT_TRUE(BuildStartupBundle({fixture.cache_path.string()}, fixture.sessions_path.string(),
+                                   true, 1, &built, &error))
+        << error;
+    ASSERT_TRUE(IsStartupBundleSourceCurrent(built.sessions.source));
+
+    WriteText(fixture.sessions_path, "sessions: []\n# edited\n");
+    std::string reason;
+    EXPECT_FALSE(IsStartupBundleSourceCurrent(built.sessions.source, &reason));
+    EXPECT_EQ(reason, "source_modified");
+    std::filesystem::remove(fixture.cache_path);
+    EXPECT_FALSE(IsStartupBundleSourceCurrent(built.instrument_caches[0].source, &reason));
+    EXPECT_EQ(reason, "source_removed");
+
+    std::string encoded = EncodeStartupBundle(built);
+    StartupBundle decoded;
+    ASSERT_TRUE(DecodeStartupBundle(encoded.data(), encoded.size(), &decoded, &error)) << error;
+    encoded[encoded.size() - 3] ^= 0x5A;
+    EXPECT_FALSE(DecodeStartupBundle(encoded.data(), encoded.size(), &decoded, &error));
+    EXPECT_EQ(error, "startup bundle section crc mismatch");
+    EXPECT_FALSE(DecodeStartupBundle(encoded.data(), encoded.size() / 2, &decoded, &error));
+    EXPECT_FALSE(DecodeStartupBundle("{\"schema_version\": 2}", 21, &decoded, &error));
+    EXPECT_EQ(error, "not a startup bundle");
+}
+
+TEST(StartupBundleTest, PhaseTimerReportsPhasesInOrder) {
+    StartupPhaseTimer timer;
+    timer.Mark("config_load");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    timer.Mark("subscribe");
+    const LogFields fields = timer.ReportFields();
+    ASSERT_EQ(fields.size(), 3U);
+    EXPECT_EQ(fields[0].first, "config_load_ms");
+    EXPECT_EQ(fields[1].first, "subscribe_ms");
+    EXPECT_GE(std::stoll(fields[1].second), 2);
+    EXPECT_EQ(fields[2].first, "total_ms");
+    EXPECT_GE(std::stoll(fields[2].second), std::stoll(fields[1].second));
+}
+
+}  // namespace
+}  // namespace quant_hft
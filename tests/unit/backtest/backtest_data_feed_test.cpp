@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include "quant_hft/backtest/backtest_data_feed.h"
+#include "quant_hft/core/instrument_registry.h"
 #include "tick_partition_fixture.h"
 
 namespace fs = std::filesystem;
@@ -83,6 +84,12 @@ TEST_F(BacktestDataFeedTest, GetHistoryTicksDelegatesToParquetFeed) {
     ASSERT_EQ(ticks.size(), 2U);
     EXPECT_EQ(ticks.front().symbol, "rb2405");
     EXPECT_EQ(ticks.back().ts_ns, 1704067201000000000);
+
+    // Ticks arrive interned, so the broker indexes its book by handle.
+    const InstrumentId id = InstrumentRegistry::Global().Find("rb2405");
+    ASSERT_NE(id, kInvalidInstrumentId);
+    EXPECT_EQ(ticks.front().instrument_handle, id);
+    EXPECT_EQ(ticks.back().instrument_handle, id);
 }
 
 TEST_F(BacktestDataFeedTest, StopInterruptsRunLoop) {
@@ -122,4 +122,69 @@ TEST(BrokerTest, PartialFillLeavesPending) {
     EXPECT_EQ(fills, 1);
 }
 
+TEST(BrokerTest, OrdersOnlyMatchTicksOfTheirOwnSymbol) {
+    SimulatedBroker broker;
+    std::vector<Trade> fills;
+    broker.SetFillCallback([&fills](const Trade& trade) { fills.push_back(trade); });
+
+    OrderIntent other = BuildIntent(Side::kBuy, OrderType::kLimit, 4000.0, 1);
+    other.instrument_id = "hc2405";
+    broker.PlaceOrder(other);
+    broker.PlaceOrder(BuildIntent(Side::kBuy, OrderType::kLimit, 3500.0, 1));
+
+    broker.OnTick(BuildTick(3499.0, 3500.0));
+    ASSERT_EQ(fills.size(), 1U);
+    EXPECT_EQ(fills.back().symbol, "rb2405");
+
+    Tick hc_tick = BuildTick(3999.0, 4000.0);
+    hc_tick.symbol = "hc2405";
+    broker.OnTick(hc_tick);
+    ASSERT_EQ(fills.size(), 2U);
+    EXPECT_EQ(fills.back().symbol, "hc2405");
+}
+
+TEST(BrokerTest, CancelRemovesRestingOrderFromItsBook) {
+    SimulatedBroker broker;
+    int fills = 0;
+    broker.SetFillCallback([&fills](const Trade&) { ++fills; });
+
+    const std::string order_id =
+        broker.PlaceOrder(BuildIntent(Side::kBuy, OrderType::kLimit, 3500.0, 1));
+    EXPECT_TRUE(broker.CancelOrder(order_id));
+    EXPECT_FALSE(broker.CancelOrder(order_id));
+    EXPECT_FALSE(broker.CancelOrder("ord-missing"));
+
+    broker.OnTick(BuildTick(3499.0, 3500.0));
+    EXPECT_EQ(fills, 0);
+}
+
+TEST(BrokerTest, InternedTicksShareTheOrderBookAndRegistryMultiplier) {
+    InstrumentMetaSnapshot meta;
+    meta.instrument_id = "i2405";
+    meta.exchange_id = "DCE";
+    meta.volume_multiple = 100;
+    meta.price_tick = 0.5;
+    const InstrumentId id = InstrumentRegistry::Global().Register(meta);
+    ASSERT_NE(id, kInvalidInstrumentId);
+
+    BrokerConfig config;
+    config.initial_capital = 10000.0;
+    config.commission_rate = 0.001;
+    config.contract_multipliers["i2405"] = 10.0;
+    SimulatedBroker broker(config);
+    int fills = 0;
+    broker.SetFillCallback([&fills](const Trade&) { ++fills; });
+
+    OrderIntent intent = BuildIntent(Side::kBuy, OrderType::kLimit, 800.0, 1);
+    intent.instrument_id = "i2405";
+    broker.PlaceOrder(intent);
+
+    Tick tick = BuildTick(799.5, 800.0);
+    tick.symbol = "i2405";
+    tick.instrument_handle = id;
+    broker.OnTick(tick);
+    EXPECT_EQ(fills, 1);
+    EXPECT_NEAR(broker.GetAccountBalance(), 10000.0 - 800.0 * 100.0 * 0.001, 1e-9);
+}
+
 }  // namespace quant_hft::backtest
@@ -1,4 +1,5 @@
 #include <filesystem>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -27,6 +28,53 @@ private:
     bool ordered_{false};
 };
 
+class VectorFeed final : public DataFeed {
+public:
+    explicit VectorFeed(std::vector<Tick> ticks) : ticks_(std::move(ticks)) {}
+
+    void Subscribe(const std::vector<std::string>&, std::function<void(const Tick&)> on_tick,
+                   std::function<void(const Bar&)>) override {
+        on_tick_ = std::move(on_tick);
+    }
+    std::vector<Bar> GetHistoryBars(const std::string&, const Timestamp&, const Timestamp&,
+                                    const std::string&) override {
+        return {};
+    }
+    std::vector<Tick> GetHistoryTicks(const std::string&, const Timestamp&,
+                                      const Timestamp&) override {
+        return {};
+    }
+    void Run() override {
+        for (const auto& tick : ticks_) {
+            current_ = Timestamp(tick.ts_ns);
+            on_tick_(tick);
+        }
+    }
+    void Stop() override {}
+    Timestamp CurrentTime() const override { return current_; }
+    bool IsLive() const override { return false; }
+
+private:
+    std::vector<Tick> ticks_;
+    std::function<void(const Tick&)> on_tick_;
+    Timestamp current_;
+};
+
+std::vector<Tick> BuildSecondTicks(std::size_t count) {
+    std::vector<Tick> ticks;
+    for (std::size_t index = 0; index < count; ++index) {
+        Tick tick;
+        tick.symbol = "rb2405";
+        tick.ts_ns = 1'704'067'200'000'000'000 + static_cast<EpochNanos>(index) * 1'000'000'000;
+        tick.last_price = 3500.0;
+        tick.last_volume = 10;
+        tick.ask_price1 = 3501.0;
+        tick.bid_price1 = 3499.0;
+        ticks.push_back(tick);
+    }
+    return ticks;
+}
+
 }  // namespace
 
 TEST(EngineTest, RunWithSimpleStrategyGeneratesTrades) {
@@ -82,4 +130,35 @@ TEST(EngineTest, RunWithSimpleStrategyGeneratesTrades) {
     fs::remove_all(root);
 }
 
+TEST(EngineTest, EquitySamplingKeepsIntervalPointsBalanceChangesAndFinalTick) {
+    const auto ticks = BuildSecondTicks(10);
+    BacktestEngine engine(std::make_unique<VectorFeed>(ticks),
+                          std::make_unique<SimulatedBroker>(BrokerConfig{}),
+                          std::make_shared<TestStrategy>());
+    engine.SetEquitySampling(EquitySamplingConfig{4'000'000'000, true});
+    engine.Run();
+
+    const auto& curve = engine.GetResult().equity_curve;
+    // First tick (commission paid on the fill), 4s, 8s and the final tick at 9s.
+    ASSERT_EQ(curve.size(), 4U);
+    EXPECT_EQ(curve[0].time.ToEpochNanos(), ticks[0].ts_ns);
+    EXPECT_LT(curve[0].balance, BrokerConfig{}.initial_capital);
+    EXPECT_EQ(curve[1].time.ToEpochNanos(), ticks[4].ts_ns);
+    EXPECT_EQ(curve[2].time.ToEpochNanos(), ticks[8].ts_ns);
+    EXPECT_EQ(curve[3].time.ToEpochNanos(), ticks[9].ts_ns);
+}
+
+TEST(EngineTest, DefaultSamplingRecordsEveryTickAndTakeResultMovesOut) {
+    BacktestEngine engine(std::make_unique<VectorFeed>(BuildSecondTicks(5)),
+                          std::make_unique<SimulatedBroker>(BrokerConfig{}),
+                          std::make_shared<TestStrategy>());
+    engine.Run();
+
+    BacktestResult result = engine.TakeResult();
+    EXPECT_EQ(result.equity_curve.size(), 5U);
+    EXPECT_EQ(result.trades.size(), 1U);
+    EXPECT_TRUE(engine.GetResult().equity_curve.empty());
+    EXPECT_TRUE(engine.GetResult().trades.empty());
+}
+
 }  // namespace quant_hft::backtest
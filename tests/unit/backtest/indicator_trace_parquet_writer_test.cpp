@@ -256,5 +256,56 @@ TEST(IndicatorTraceParquetWriterTest, WritesRowsWithNullableIndicatorsWhenEnable
 #endif
 }
 
+TEST(IndicatorTraceParquetWriterTest, StreamsRowGroupsFromBackgroundEncoder) {
+#if !QUANT_HFT_ENABLE_ARROW_PARQUET
+    GTEST_SKIP() << "Arrow parquet writer is disabled in this build";
+#else
+    const std::filesystem::path path = UniqueTracePath("indicator_trace_row_groups");
+    TraceParquetWriterOptions options;
+    options.row_group_rows = 2;
+    options.background_encoding = true;
+
+    IndicatorTraceRow row;
+    row.instrument_id = "rb2405";
+    row.ts_ns = 1700000000000000000LL;
+    row.market_state_decision_reason = "warmup";
+
+    std::string error;
+    {
+        IndicatorTraceParquetWriter abandoned(options);
+        ASSERT_TRUE(abandoned.Open(path.string(), &error)) << error;
+        for (int index = 0; index < 3; ++index) {
+            ASSERT_TRUE(abandoned.Append(row, &error)) << error;
+        }
+    }
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+    IndicatorTraceParquetWriter writer(options);
+    ASSERT_TRUE(writer.Open(path.string(), &error)) << error;
+    for (int index = 0; index < 5; ++index) {
+        row.ts_ns += 60'000'000'000LL;
+        row.bar_close = 100.0 + index;
+        ASSERT_TRUE(writer.Append(row, &error)) << error;
+    }
+    ASSERT_TRUE(writer.Close(&error)) << error;
+    EXPECT_EQ(writer.rows_written(), 5);
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+    auto input_result = arrow::io::ReadableFile::Open(path.string());
+    ASSERT_TRUE(input_result.ok()) << input_result.status().ToString();
+    std::unique_ptr<parquet::arrow::FileReader> parquet_reader;
+    ASSERT_TRUE(OpenParquetReaderCompat(input_result.ValueOrDie(), &parquet_reader, 0));
+    EXPECT_EQ(parquet_reader->num_row_groups(), 3);
+    std::shared_ptr<arrow::Table> table;
+    ASSERT_TRUE(parquet_reader->ReadTable(&table).ok());
+    ASSERT_NE(table, nullptr);
+    EXPECT_EQ(table->num_rows(), 5);
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+#endif
+}
+
 }  // namespace
 }  // namespace quant_hft
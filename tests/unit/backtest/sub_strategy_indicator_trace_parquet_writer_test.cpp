@@ -233,5 +233,38 @@ TEST(SubStrategyIndicatorTraceParquetWriterTest, WritesRowsWithNullableIndicator
 #endif
 }
 
+TEST(SubStrategyIndicatorTraceParquetWriterTest, FlushesRowGroupsWhileAppending) {
+#if !QUANT_HFT_ENABLE_ARROW_PARQUET
+    GTEST_SKIP() << "Arrow parquet writer is disabled in this build";
+#else
+    const std::filesystem::path path = UniqueTracePath("sub_strategy_trace_row_groups");
+    TraceParquetWriterOptions options;
+    options.row_group_rows = 2;
+
+    SubStrategyIndicatorTraceParquetWriter writer(options);
+    std::string error;
+    ASSERT_TRUE(writer.Open(path.string(), &error)) << error;
+
+    SubStrategyIndicatorTraceRow row;
+    row.instrument_id = "rb2405";
+    row.ts_ns = 1700000000000000000LL;
+    row.strategy_id = "open_1";
+    row.strategy_type = "TrendStrategy";
+    for (int index = 0; index < 4; ++index) {
+        row.ts_ns += 60'000'000'000LL;
+        ASSERT_TRUE(writer.Append(row, &error)) << error;
+    }
+    // Both full row groups are on disk before Close, past the 4-byte file magic.
+    EXPECT_GT(std::filesystem::file_size(path.string() + ".tmp"), 4U);
+    ASSERT_TRUE(writer.Close(&error)) << error;
+    EXPECT_EQ(writer.rows_written(), 4);
+    EXPECT_TRUE(std::filesystem::exists(path));
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+#endif
+}
+
 }  // namespace
 }  // namespace quant_hft
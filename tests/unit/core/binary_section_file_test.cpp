@@ -0,0 +1,110 @@
+#include "quant_hft/core/binary_section_file.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace quant_hft {
+namespace {
+
+constexpr BinarySectionFileFormat kTestFormat{
+    {'Q', 'H', 'T', 'E', 'S', 'T', '0', '\0'}, 2, "test file"};
+
+std::string EncodeTwoSections() {
+    std::string out;
+    BinarySectionWriter writer(&out);
+    writer.BeginSection(7);
+    writer.Put(std::int64_t{42});
+    writer.PutString("rb2610");
+    writer.EndSection();
+    writer.BeginSection(9);
+    writer.PutBool(true);
+    writer.EndSection();
+    writer.Finish(kTestFormat);
+    return out;
+}
+
+TEST(BinarySectionFileTest, RoundTripsSectionsInOrder) {
+    const std::string encoded = EncodeTwoSections();
+    std::vector<BinarySection> sections;
+    std::string error;
+    ASSERT_TRUE(SplitBinarySections(encoded.data(), encoded.size(), kTestFormat, &sections,
+                                    &error))
+        << error;
+    ASSERT_EQ(sections.size(), 2U);
+    EXPECT_EQ(sections[0].kind, 7U);
+    EXPECT_EQ(sections[1].kind, 9U);
+
+    BinarySectionReader first(sections[0].payload, sections[0].payload_bytes);
+    std::int64_t value = 0;
+    std::string symbol;
+    ASSERT_TRUE(first.Get(&value));
+    ASSERT_TRUE(first.GetString(&symbol));
+    EXPECT_TRUE(first.AtEnd());
+    EXPECT_EQ(value, 42);
+    EXPECT_EQ(symbol, "rb2610");
+
+    BinarySectionReader second(sections[1].payload, sections[1].payload_bytes);
+    bool flag = false;
+    ASSERT_TRUE(second.GetBool(&flag));
+    EXPECT_TRUE(flag);
+    EXPECT_FALSE(second.Get(&value));
+}
+
+TEST(BinarySectionFileTest, RejectsCorruptTruncatedAndForeignFiles) {
+    std::string encoded = EncodeTwoSections();
+    std::vector<BinarySection> sections;
+    std::string error;
+
+    EXPECT_FALSE(SplitBinarySections(encoded.data(), encoded.size() - 1, kTestFormat, &sections,
+                                     &error));
+    EXPECT_EQ(error, "truncated test file section");
+
+    const std::string trailing = encoded + "x";
+    EXPECT_FALSE(
+        SplitBinarySections(trailing.data(), trailing.size(), kTestFormat, &sections, &error));
+    EXPECT_EQ(error, "test file has trailing bytes");
+
+    BinarySectionFileFormat newer = kTestFormat;
+    newer.version = 3;
+    EXPECT_FALSE(SplitBinarySections(encoded.data(), encoded.size(), newer, &sections, &error));
+    EXPECT_EQ(error, "unsupported test file version");
+
+    encoded[encoded.size() - 1] ^= 0x01;
+    EXPECT_FALSE(
+        SplitBinarySections(encoded.data(), encoded.size(), kTestFormat, &sections, &error));
+    EXPECT_EQ(error, "test file section crc mismatch");
+
+    encoded[12] ^= 0x01;
+    EXPECT_FALSE(
+        SplitBinarySections(encoded.data(), encoded.size(), kTestFormat, &sections, &error));
+    EXPECT_EQ(error, "test file header crc mismatch");
+
+    EXPECT_FALSE(SplitBinarySections("{}", 2, kTestFormat, &sections, &error));
+    EXPECT_EQ(error, "not a test file");
+}
+
+TEST(BinarySectionFileTest, WritesAtomicallyAndMapsBack) {
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "binary_section_file_test";
+    std::filesystem::remove_all(dir);
+    const std::string path = (dir / "nested" / "data.bin").string();
+    const std::string encoded = EncodeTwoSections();
+    std::string error;
+    ASSERT_TRUE(WriteFileAtomically(path, encoded, kTestFormat.label, &error)) << error;
+
+    MappedReadOnlyFile file;
+    ASSERT_TRUE(file.Open(path, kTestFormat.label, &error)) << error;
+    EXPECT_EQ(std::string(file.data(), file.size()), encoded);
+
+    MappedReadOnlyFile missing;
+    EXPECT_FALSE(missing.Open((dir / "missing.bin").string(), kTestFormat.label, &error));
+    EXPECT_EQ(error.rfind("failed to open test file: ", 0), 0U) << error;
+    std::filesystem::remove_all(dir);
+}
+
+}  // namespace
+}  // namespace quant_hft
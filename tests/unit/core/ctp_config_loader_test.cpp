@@ -232,6 +232,7 @@ TEST(CtpConfigLoaderTest, LoadsStrategyEngineKeysAndSplitsLists) {
         "  run_type: \"sim\"\n"
         "  strategy_factory: \"demo\"\n"
         "  strategy_queue_capacity: 4096\n"
+        "  strategy_worker_count: 2\n"
         "  account_id: \"sim-account\"\n");
 
     CtpFileConfig config;
@@ -247,6 +248,7 @@ TEST(CtpConfigLoaderTest, LoadsStrategyEngineKeysAndSplitsLists) {
     EXPECT_EQ(config.run_type, "sim");
     EXPECT_EQ(config.strategy_factory, "demo");
     EXPECT_EQ(config.strategy_queue_capacity, 4096);
+    EXPECT_EQ(config.strategy_worker_count, 2);
     EXPECT_FALSE(config.strategy_state_persist_enabled);
     EXPECT_EQ(config.strategy_state_backend, "redis");
     EXPECT_EQ(config.strategy_state_snapshot_interval_ms, 60000);
@@ -501,6 +503,7 @@ TEST(CtpConfigLoaderTest, LoadsExecutionAndRiskRuleConfigs) {
         "  execution_price_mode: \"marketable_limit\"\n"
         "  slice_size: 3\n"
         "  slice_interval_ms: 120\n"
+        "  execution_scheduler_lanes: 4\n"
         "  twap_duration_ms: 2500\n"
         "  vwap_lookback_bars: 30\n"
         "  throttle_reject_ratio: 0.25\n"
@@ -559,6 +562,7 @@ TEST(CtpConfigLoaderTest, LoadsExecutionAndRiskRuleConfigs) {
     EXPECT_EQ(config.execution.price_mode, ExecutionPriceMode::kMarketableLimit);
     EXPECT_EQ(config.execution.slice_size, 3);
     EXPECT_EQ(config.execution.slice_interval_ms, 120);
+    EXPECT_EQ(config.execution.scheduler_lanes, 4);
     EXPECT_EQ(config.execution.twap_duration_ms, 2500);
     EXPECT_EQ(config.execution.vwap_lookback_bars, 30);
     EXPECT_DOUBLE_EQ(config.execution.throttle_reject_ratio, 0.25);
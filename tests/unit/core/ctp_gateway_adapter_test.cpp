@@ -6,6 +6,8 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <future>
+#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -337,6 +339,53 @@ TEST(CtpGatewayAdapterTest, QuerySnapshotsInSimulatedMode) {
     EXPECT_EQ(order_comm_rate_callbacks.load(), 1);
 }
 
+TEST(CtpGatewayAdapterTest, CoalescedOrderQueryAnswersEveryWaiter) {
+    // One query per second, so the order queries queue behind the account query.
+    CtpGatewayAdapter adapter(1);
+
+    MarketDataConnectConfig cfg;
+    cfg.market_front_address = "tcp://sim-md";
+    cfg.trader_front_address = "tcp://sim-td";
+    cfg.broker_id = "9999";
+    cfg.user_id = "191202";
+    cfg.investor_id = "191202";
+    cfg.password = "p1";
+    cfg.is_production_mode = false;
+    ASSERT_TRUE(adapter.Connect(cfg));
+
+    std::mutex waiters_mutex;
+    std::map<int, std::promise<bool>> waiters;
+    std::map<int, std::future<bool>> results;
+    for (int request_id : {2, 3}) {
+        results.emplace(request_id, waiters[request_id].get_future());
+    }
+    adapter.RegisterQueryCompleteCallback(
+        [&](int request_id, const std::string& query_name, bool success) {
+            EXPECT_EQ(query_name, "order");
+            std::promise<bool> waiter;
+            {
+                std::lock_guard<std::mutex> lock(waiters_mutex);
+                const auto it = waiters.find(request_id);
+                ASSERT_NE(it, waiters.end());
+                waiter = std::move(it->second);
+                waiters.erase(it);
+            }
+            waiter.set_value(success);
+        });
+
+    ASSERT_TRUE(adapter.EnqueueTradingAccountQuery(1));
+    std::thread first_caller([&]() { EXPECT_TRUE(adapter.EnqueueOrderQuery(2)); });
+    first_caller.join();
+    std::thread second_caller([&]() { EXPECT_TRUE(adapter.EnqueueOrderQuery(3)); });
+    second_caller.join();
+
+    for (auto& [request_id, result] : results) {
+        ASSERT_EQ(result.wait_for(std::chrono::seconds(5)), std::future_status::ready)
+            << "request " << request_id;
+        EXPECT_TRUE(result.get());
+    }
+}
+
 TEST(CtpGatewayAdapterTest, CallbackCanReenterCancelOrderWithoutLockContention) {
     using namespace std::chrono_literals;
 
@@ -0,0 +1,117 @@
+#include "quant_hft/core/instrument_registry.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace quant_hft {
+namespace {
+
+TEST(InstrumentRegistryTest, InternsIdsOnceAndDerivesProduct) {
+    InstrumentRegistry registry;
+    const InstrumentId rebar = registry.Intern("SHFE.rb2610");
+    const InstrumentId gold = registry.Intern("au2608");
+    EXPECT_EQ(rebar, 0U);
+    EXPECT_EQ(gold, 1U);
+    EXPECT_EQ(registry.Intern("SHFE.rb2610"), rebar);
+    EXPECT_EQ(registry.Find("au2608"), gold);
+    EXPECT_EQ(registry.Find("ag2612"), kInvalidInstrumentId);
+    EXPECT_EQ(registry.Intern(""), kInvalidInstrumentId);
+    EXPECT_EQ(registry.size(), 2U);
+
+    EXPECT_EQ(registry.Info(rebar).instrument_id, "SHFE.rb2610");
+    EXPECT_EQ(registry.Info(rebar).product_id, "rb");
+    EXPECT_EQ(registry.Info(rebar).exchange_id, "SHFE");
+    EXPECT_EQ(registry.Info(gold).product_id, "au");
+    EXPECT_TRUE(registry.Info(gold).exchange_id.empty());
+}
+
+TEST(InstrumentRegistryTest, RegisterOverlaysInstrumentMetadata) {
+    InstrumentRegistry registry;
+    const InstrumentId id = registry.Intern("IF2609");
+    const InstrumentInfo& before = registry.Info(id);
+
+    InstrumentMetaSnapshot meta;
+    meta.instrument_id = "IF2609";
+    meta.exchange_id = "CFFEX";
+    meta.product_id = "IF";
+    meta.volume_multiple = 300;
+    meta.price_tick = 0.2;
+    EXPECT_EQ(registry.Register(meta), id);
+
+    const InstrumentInfo& after = registry.Info(id);
+    EXPECT_EQ(after.exchange_id, "CFFEX");
+    EXPECT_EQ(after.product_id, "if");
+    EXPECT_EQ(after.volume_multiple, 300);
+    EXPECT_DOUBLE_EQ(after.price_tick, 0.2);
+    // A reference taken before the update still reads the old record.
+    EXPECT_TRUE(before.exchange_id.empty());
+    EXPECT_EQ(before.volume_multiple, 0);
+
+    InstrumentMetaSnapshot partial;
+    partial.instrument_id = "IF2609";
+    partial.price_tick = 0.4;
+    EXPECT_EQ(registry.RegisterAll({partial, InstrumentMetaSnapshot{}}), 1U);
+    EXPECT_EQ(registry.Info(id).volume_multiple, 300);
+    EXPECT_DOUBLE_EQ(registry.Info(id).price_tick, 0.4);
+}
+
+TEST(InstrumentRegistryTest, ConcurrentInternAgreesOnIds) {
+    InstrumentRegistry registry;
+    std::vector<std::string> symbols;
+    for (int i = 0; i < 2000; ++i) {
+        symbols.push_back("rb" + std::to_string(2600 + i));
+    }
+    std::vector<std::vector<InstrumentId>> seen(4);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (const auto& symbol : symbols) {
+                seen[t].push_back(registry.Intern(symbol));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(registry.size(), symbols.size());
+    for (std::size_t t = 1; t < seen.size(); ++t) {
+        EXPECT_EQ(seen[t], seen[0]);
+    }
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        EXPECT_EQ(registry.Info(seen[0][i]).instrument_id, symbols[i]);
+    }
+}
+
+TEST(InstrumentMapTest, DenseStorageKeepsReferencesStable) {
+    InstrumentMap<int> values;
+    EXPECT_TRUE(values.empty());
+    int& first = values[2];
+    first = 7;
+    values[1500] = 9;
+    EXPECT_EQ(&values[2], &first);
+    EXPECT_EQ(first, 7);
+    EXPECT_EQ(values.size(), 2U);
+    EXPECT_TRUE(values.Contains(1500));
+    EXPECT_FALSE(values.Contains(3));
+    EXPECT_EQ(values.Find(3), nullptr);
+    ASSERT_NE(values.Find(1500), nullptr);
+    EXPECT_EQ(*values.Find(1500), 9);
+
+    std::vector<InstrumentId> visited;
+    values.ForEach([&](InstrumentId id, int) { visited.push_back(id); });
+    EXPECT_EQ(visited, (std::vector<InstrumentId>{2, 1500}));
+
+    EXPECT_TRUE(values.Erase(2));
+    EXPECT_FALSE(values.Erase(2));
+    EXPECT_EQ(values.size(), 1U);
+    EXPECT_EQ(values[2], 0);
+    values.Clear();
+    EXPECT_TRUE(values.empty());
+    EXPECT_FALSE(values.Contains(1500));
+}
+
+}  // namespace
+}  // namespace quant_hft
@@ -58,4 +58,21 @@ TEST(LibpqTimescaleSqlClientTest, PingReturnsFalseWhenServerUnavailable) {
     EXPECT_FALSE(error.empty());
 }
 
+TEST(LibpqTimescaleSqlClientTest, RejectsMixedColumnBatchBeforeNetworkAccess) {
+    LibpqTimescaleSqlClient client(BuildConfig());
+    std::string error;
+    TimescaleWriteBatch batch;
+    batch.table = "trading_core.settlement_detail";
+    batch.rows = {{{"k", "1"}, {"v", "a"}}, {{"k", "2"}, {"w", "b"}}};
+    EXPECT_FALSE(client.WriteBatches({batch}, &error));
+    EXPECT_NE(error.find("one column set"), std::string::npos);
+
+    batch.rows = {{{"k", "1"}}};
+    batch.conflict_keys = {"id"};
+    EXPECT_FALSE(client.WriteBatches({batch}, &error));
+    EXPECT_NE(error.find("missing conflict key"), std::string::npos);
+
+    EXPECT_TRUE(client.WriteBatches({}, &error));
+}
+
 }  // namespace quant_hft
@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace quant_hft {
 
@@ -94,4 +95,125 @@ TEST(QuerySchedulerTest, DeferredTaskOwnsStateUntilDrainedAfterCompletion) {
     EXPECT_TRUE(observed_state.expired());
 }
 
+TEST(QuerySchedulerTest, CoalescesIdenticalPendingQueries) {
+    QueryScheduler scheduler(10);
+    int executed = 0;
+    const auto make_task = [&executed](int request_id) {
+        QueryScheduler::QueryTask task;
+        task.request_id = request_id;
+        task.priority = QueryScheduler::Priority::kHigh;
+        task.coalesce_key = "trading_account";
+        task.execute = [&executed] { ++executed; };
+        return task;
+    };
+
+    EXPECT_EQ(scheduler.Schedule(make_task(1)), QueryScheduler::ScheduleResult::kQueued);
+    EXPECT_EQ(scheduler.Schedule(make_task(2)), QueryScheduler::ScheduleResult::kCoalesced);
+    EXPECT_EQ(scheduler.Schedule(make_task(3)), QueryScheduler::ScheduleResult::kCoalesced);
+    EXPECT_EQ(scheduler.PendingCount(), 1U);
+    EXPECT_EQ(scheduler.CoalescedCount(), 2U);
+
+    EXPECT_EQ(scheduler.DrainOnce(), 1U);
+    EXPECT_EQ(executed, 1);
+    // The one response answers the merged callers too, so their ids travel with the task.
+    EXPECT_TRUE(scheduler.TakeMergedRequestIds(2).empty());
+    EXPECT_EQ(scheduler.TakeMergedRequestIds(1), (std::vector<int>{2, 3}));
+    EXPECT_TRUE(scheduler.TakeMergedRequestIds(1).empty());
+
+    // Once the query is in flight a new poll queues again rather than joining it.
+    EXPECT_EQ(scheduler.Schedule(make_task(4)), QueryScheduler::ScheduleResult::kQueued);
+    EXPECT_EQ(scheduler.PendingCount(), 1U);
+}
+
+TEST(QuerySchedulerTest, DropsTasksQueuedPastTheirDeadline) {
+    QueryScheduler scheduler(10);
+    std::string order;
+    const auto now = std::chrono::steady_clock::now();
+
+    std::vector<int> expired_ids;
+
+    QueryScheduler::QueryTask stale;
+    stale.request_id = 7;
+    stale.priority = QueryScheduler::Priority::kHigh;
+    stale.coalesce_key = "positions";
+    stale.deadline = now - std::chrono::milliseconds(1);
+    stale.execute = [&order] { order += "S"; };
+    stale.on_expired = [&expired_ids](const std::vector<int>& request_ids) {
+        expired_ids = request_ids;
+    };
+    QueryScheduler::QueryTask merged;
+    merged.request_id = 8;
+    merged.coalesce_key = "positions";
+    merged.deadline = stale.deadline;
+    merged.execute = [&order] { order += "M"; };
+    QueryScheduler::QueryTask fresh;
+    fresh.priority = QueryScheduler::Priority::kLow;
+    fresh.deadline = now + std::chrono::seconds(10);
+    fresh.execute = [&order] { order += "F"; };
+    ASSERT_TRUE(scheduler.TrySchedule(std::move(stale)));
+    ASSERT_EQ(scheduler.Schedule(std::move(merged)), QueryScheduler::ScheduleResult::kCoalesced);
+    ASSERT_TRUE(scheduler.TrySchedule(std::move(fresh)));
+
+    EXPECT_EQ(scheduler.DrainOnce(), 1U);
+    EXPECT_EQ(order, "F");
+    EXPECT_EQ(expired_ids, (std::vector<int>{7, 8}));
+    EXPECT_EQ(scheduler.ExpiredCount(), 1U);
+    EXPECT_EQ(scheduler.PendingCount(), 0U);
+
+    QueryScheduler::QueryTask requeued;
+    requeued.coalesce_key = "positions";
+    requeued.execute = [&order] { order += "R"; };
+    EXPECT_EQ(scheduler.Schedule(std::move(requeued)), QueryScheduler::ScheduleResult::kQueued);
+}
+
+TEST(QuerySchedulerTest, DrainThreadRunsQueuedTasksWithoutPolling) {
+    QueryScheduler scheduler(100);
+    scheduler.SetInFlightTimeout(std::chrono::milliseconds(50));
+    scheduler.StartDrainThread();
+    std::atomic<int> executed{0};
+
+    for (int i = 0; i < 3; ++i) {
+        QueryScheduler::QueryTask task;
+        task.request_id = i;
+        task.completes_on_return = i == 0;
+        task.execute = [&executed] { executed.fetch_add(1); };
+        ASSERT_TRUE(scheduler.TrySchedule(std::move(task)));
+    }
+    scheduler.MarkComplete();
+
+    // Task 0 frees its slot on return; task 1 waits for a response that never comes and is
+    // released by the in-flight timeout, after which task 2 runs.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (executed.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(executed.load(), 3);
+    EXPECT_EQ(scheduler.PendingCount(), 0U);
+    scheduler.StopDrainThread();
+}
+
+TEST(QuerySchedulerTest, IgnoresCompletionFromTimedOutQuery) {
+    QueryScheduler scheduler(100);
+    scheduler.SetInFlightTimeout(std::chrono::milliseconds(200));
+    std::string order;
+    for (int request_id : {1, 2, 3}) {
+        QueryScheduler::QueryTask task;
+        task.request_id = request_id;
+        task.execute = [&order, request_id] { order += std::to_string(request_id); };
+        ASSERT_TRUE(scheduler.TrySchedule(std::move(task)));
+    }
+
+    EXPECT_EQ(scheduler.DrainOnce(), 1U);
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    // The in-flight timeout released query 1, so query 2 starts.
+    EXPECT_EQ(scheduler.DrainOnce(), 1U);
+
+    // Query 1's late response must not free the slot query 2 still holds.
+    scheduler.MarkComplete(1);
+    EXPECT_EQ(scheduler.DrainOnce(), 0U);
+    scheduler.MarkComplete(2);
+    EXPECT_EQ(scheduler.DrainOnce(), 1U);
+    EXPECT_EQ(order, "123");
+}
+
 }  // namespace quant_hft
@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "quant_hft/contracts/types.h"
 #include "quant_hft/core/redis_hash_client.h"
@@ -62,6 +63,16 @@ class FlakyRedisClient : public IRedisHashClient {
         return true;
     }
 
+    bool HDel(const std::string& key, const std::vector<std::string>& fields,
+              std::string* error) override {
+        auto& hash = storage_[key];
+        for (const std::string& field : fields) {
+            hash.erase(field);
+        }
+        (void)error;
+        return true;
+    }
+
     bool Expire(const std::string& key, int ttl_seconds, std::string* error) override {
         if (ttl_seconds <= 0) {
             if (error != nullptr) {
@@ -0,0 +1,219 @@
+#include "quant_hft/core/settlement_store_client_adapter.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "quant_hft/core/timescale_sql_client.h"
+
+namespace quant_hft {
+namespace {
+
+class CountingSqlClient : public InMemoryTimescaleSqlClient {
+   public:
+    bool InsertRow(const std::string& table,
+                   const std::unordered_map<std::string, std::string>& row,
+                   std::string* error) override {
+        ++row_calls;
+        return InMemoryTimescaleSqlClient::InsertRow(table, row, error);
+    }
+
+    bool UpsertRow(const std::string& table,
+                   const std::unordered_map<std::string, std::string>& row,
+                   const std::vector<std::string>& conflict_keys,
+                   const std::vector<std::string>& update_keys,
+                   std::string* error) override {
+        ++row_calls;
+        return InMemoryTimescaleSqlClient::UpsertRow(table, row, conflict_keys, update_keys,
+                                                     error);
+    }
+
+    bool WriteBatches(const std::vector<TimescaleWriteBatch>& batches,
+                      std::string* error) override {
+        ++batch_calls;
+        last_batches = batches;
+        return InMemoryTimescaleSqlClient::WriteBatches(batches, error);
+    }
+
+    int row_calls{0};
+    int batch_calls{0};
+    std::vector<TimescaleWriteBatch> last_batches;
+};
+
+// Rejects upserts and can fail any batch touching `fail_table`, applying the
+// rest all-or-nothing like a transactional client.
+class NoUpsertSqlClient : public CountingSqlClient {
+   public:
+    bool WriteBatches(const std::vector<TimescaleWriteBatch>& batches,
+                      std::string* error) override {
+        ++batch_calls;
+        for (const auto& batch : batches) {
+            if (!batch.conflict_keys.empty()) {
+                *error = "upsert row not supported";
+                return false;
+            }
+            if (batch.table == fail_table) {
+                *error = fail_error;
+                return false;
+            }
+        }
+        return InMemoryTimescaleSqlClient::WriteBatches(batches, error);
+    }
+
+    std::string fail_table;
+    std::string fail_error{"server closed the connection unexpectedly"};
+};
+
+SettlementOpenPositionRecord MakePosition(std::int64_t position_id) {
+    SettlementOpenPositionRecord position;
+    position.position_id = position_id;
+    position.account_id = "acc1";
+    position.strategy_id = "s1";
+    position.instrument_id = "rb2405";
+    position.exchange_id = "SHFE";
+    position.open_date = "2026-02-12";
+    position.position_date = "2026-02-12";
+    position.open_price = 100.0;
+    position.volume = 1;
+    position.is_today = true;
+    position.update_ts_ns = 1'700'000'000'000'000'000;
+    return position;
+}
+
+SettlementDetailRecord MakeDetail(std::int64_t position_id) {
+    SettlementDetailRecord detail;
+    detail.trading_day = "2026-02-12";
+    detail.position_id = position_id;
+    detail.instrument_id = "rb2405";
+    detail.volume = 1;
+    detail.settlement_price = 102.0;
+    detail.profit = 20.0;
+    detail.created_ts_ns = 1'700'000'000'000'000'000;
+    return detail;
+}
+
+TEST(SettlementStoreClientAdapterTest, StagesTransactionWritesAndCommitsOneBatch) {
+    auto client = std::make_shared<CountingSqlClient>();
+    SettlementStoreClientAdapter store(client, StorageRetryPolicy{}, "trading_core", "ops");
+    std::string error;
+
+    ASSERT_TRUE(store.BeginTransaction(&error)) << error;
+    EXPECT_FALSE(store.BeginTransaction(&error));
+    std::vector<SettlementOpenPositionRecord> positions{MakePosition(1), MakePosition(2),
+                                                        MakePosition(3)};
+    ASSERT_TRUE(store.UpdatePositionsAfterSettlement(positions, &error)) << error;
+    ASSERT_TRUE(store.AppendDetails({MakeDetail(1), MakeDetail(2)}, &error)) << error;
+    ASSERT_TRUE(store.AppendDetail(MakeDetail(3), &error)) << error;
+    EXPECT_TRUE(client->QueryAllRows("trading_core.settlement_detail", &error).empty());
+
+    ASSERT_TRUE(store.CommitTransaction(&error)) << error;
+    EXPECT_EQ(client->row_calls, 0);
+    EXPECT_EQ(client->batch_calls, 1);
+    ASSERT_EQ(client->last_batches.size(), 2U);
+    EXPECT_EQ(client->last_batches[1].rows.size(), 3U);
+    EXPECT_EQ(client->QueryAllRows("trading_core.settlement_detail", &error).size(), 3U);
+    EXPECT_EQ(client->QueryAllRows("trading_core.position_detail", &error).size(), 3U);
+
+    // Replaying the same positions updates rows in place instead of appending.
+    positions[0].accumulated_mtm = 20.0;
+    ASSERT_TRUE(store.UpdatePositionsAfterSettlement(positions, &error)) << error;
+    EXPECT_EQ(client->batch_calls, 2);
+    const auto rows = client->QueryRows("trading_core.position_detail", "position_id", "1", &error);
+    ASSERT_EQ(rows.size(), 1U);
+    EXPECT_EQ(rows[0].at("accumulated_mtm"), "20.000000");
+}
+
+TEST(SettlementStoreClientAdapterTest, RollbackAndInvalidRowsLeaveTablesUntouched) {
+    auto client = std::make_shared<CountingSqlClient>();
+    SettlementStoreClientAdapter store(client, StorageRetryPolicy{}, "trading_core", "ops");
+    std::string error;
+
+    ASSERT_TRUE(store.BeginTransaction(&error)) << error;
+    ASSERT_TRUE(store.AppendDetails({MakeDetail(1), MakeDetail(2)}, &error)) << error;
+    ASSERT_TRUE(store.RollbackTransaction(&error)) << error;
+    ASSERT_TRUE(store.CommitTransaction(&error)) << error;
+    EXPECT_EQ(client->batch_calls, 0);
+    EXPECT_TRUE(client->QueryAllRows("trading_core.settlement_detail", &error).empty());
+
+    SettlementDetailRecord invalid = MakeDetail(0);
+    EXPECT_FALSE(store.AppendDetails({MakeDetail(1), invalid}, &error));
+    EXPECT_EQ(client->batch_calls, 0);
+
+    // A failing batch rolls back the batches applied before it.
+    TimescaleWriteBatch ok_batch{"t1", {{{"k", "1"}}}, {}, {}};
+    TimescaleWriteBatch bad_batch{"t2", {{{"k", "1"}}}, {"missing"}, {}};
+    EXPECT_FALSE(client->WriteBatches({ok_batch, bad_batch}, &error));
+    EXPECT_TRUE(client->QueryAllRows("t1", &error).empty());
+}
+
+TEST(SettlementStoreClientAdapterTest, RolloverWritesPositionSummaryAsOneBatch) {
+    auto client = std::make_shared<CountingSqlClient>();
+    SettlementStoreClientAdapter store(client, StorageRetryPolicy{}, "trading_core", "ops");
+    std::string error;
+    for (const char* instrument_id : {"rb2405", "rb2410", "au2406"}) {
+        ASSERT_TRUE(client->InsertRow("trading_core.position_summary",
+                                      {{"account_id", "acc1"},
+                                       {"strategy_id", "s1"},
+                                       {"instrument_id", instrument_id},
+                                       {"long_volume", "3"},
+                                       {"long_today_volume", "2"},
+                                       {"long_yd_volume", "1"}},
+                                      &error));
+    }
+    client->row_calls = 0;
+
+    ASSERT_TRUE(store.RolloverPositionSummary("acc1", &error)) << error;
+    EXPECT_EQ(client->row_calls, 0);
+    EXPECT_EQ(client->batch_calls, 1);
+    const auto rows = client->QueryAllRows("trading_core.position_summary", &error);
+    ASSERT_EQ(rows.size(), 3U);
+    for (const auto& row : rows) {
+        EXPECT_EQ(row.at("long_today_volume"), "0");
+        EXPECT_EQ(row.at("long_yd_volume"), "3");
+    }
+}
+
+TEST(SettlementStoreClientAdapterTest, UpsertFallbackCommitsAllOrNothing) {
+    auto client = std::make_shared<NoUpsertSqlClient>();
+    StorageRetryPolicy retry;
+    retry.max_attempts = 2;
+    retry.initial_backoff_ms = 0;
+    SettlementStoreClientAdapter store(client, retry, "trading_core", "ops");
+    std::string error;
+
+    ASSERT_TRUE(store.UpdatePositionsAfterSettlement({MakePosition(1), MakePosition(2)}, &error))
+        << error;
+    EXPECT_EQ(client->row_calls, 0);
+    EXPECT_EQ(client->batch_calls, 2);
+    EXPECT_EQ(client->QueryAllRows("trading_core.position_detail", &error).size(), 2U);
+
+    // A failure after the fallback leaves every staged table untouched rather
+    // than the rows written before it.
+    client->fail_table = "trading_core.settlement_detail";
+    client->batch_calls = 0;
+    ASSERT_TRUE(store.BeginTransaction(&error)) << error;
+    ASSERT_TRUE(store.UpdatePositionsAfterSettlement({MakePosition(3), MakePosition(4)}, &error))
+        << error;
+    ASSERT_TRUE(store.AppendDetails({MakeDetail(3), MakeDetail(4)}, &error)) << error;
+    EXPECT_FALSE(store.CommitTransaction(&error));
+    EXPECT_EQ(error, client->fail_error);
+    EXPECT_EQ(client->row_calls, 0);
+    EXPECT_EQ(client->batch_calls, 3);
+    EXPECT_EQ(client->QueryAllRows("trading_core.position_detail", &error).size(), 2U);
+    EXPECT_TRUE(client->QueryAllRows("trading_core.settlement_detail", &error).empty());
+
+    // Duplicate keys are not retried or replayed row by row.
+    client->fail_error = "duplicate key value violates unique constraint";
+    client->batch_calls = 0;
+    EXPECT_FALSE(store.AppendDetails({MakeDetail(5), MakeDetail(6)}, &error));
+    EXPECT_EQ(error, client->fail_error);
+    EXPECT_EQ(client->row_calls, 0);
+    EXPECT_EQ(client->batch_calls, 1);
+    EXPECT_TRUE(client->QueryAllRows("trading_core.settlement_detail", &error).empty());
+}
+
+}  // namespace
+}  // namespace quant_hft
@@ -0,0 +1,141 @@
+#include "quant_hft/core/simple_json.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace quant_hft::simple_json {
+namespace {
+
+TEST(SimpleJsonTest, ParsesNestedDocumentInPlace) {
+    Value root;
+    std::string error;
+    ASSERT_TRUE(Parse(R"({"b": [1, -2.5e2, true, null, {"x": "y"}], "a": {"k": "v\n\"q\""},
+                         "b": [3]})",
+                      &root, &error))
+        << error;
+    ASSERT_TRUE(root.IsObject());
+    // A repeated key keeps the last value.
+    const Value* b = root.Find("b");
+    ASSERT_NE(b, nullptr);
+    ASSERT_EQ(b->array_value.size(), 1U);
+    EXPECT_DOUBLE_EQ(b->array_value[0].number_value, 3.0);
+    const Value* a = root.Find("a");
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->Find("k")->string_value, "v\n\"q\"");
+    EXPECT_EQ(root.object_value.begin()->first, "a");
+
+    ASSERT_TRUE(Parse(R"([1, -2.5e2, 0.125, true, null, {"x": "y"}, []])", &root, &error))
+        << error;
+    ASSERT_EQ(root.array_value.size(), 7U);
+    EXPECT_DOUBLE_EQ(root.array_value[1].number_value, -250.0);
+    EXPECT_DOUBLE_EQ(root.array_value[2].number_value, 0.125);
+    EXPECT_TRUE(root.array_value[3].bool_value);
+    EXPECT_TRUE(root.array_value[4].IsNull());
+    EXPECT_EQ(root.array_value[5].Find("x")->string_value, "y");
+    EXPECT_TRUE(root.array_value[6].IsArray());
+}
+
+TEST(SimpleJsonTest, DecodesUnicodeEscapes) {
+    Value root;
+    std::string error;
+    ASSERT_TRUE(Parse(R"("\u87ba\u7eb9\u94a2 \ud83d\ude00 \/")", &root, &error)) << error;
+    EXPECT_EQ(root.string_value, "螺纹钢 \xF0\x9F\x98\x80 /");
+    EXPECT_FALSE(Parse(R"("\u12")", &root, &error));
+    EXPECT_FALSE(Parse(R"("\ud83dA")", &root, &error));
+    EXPECT_EQ(error, "invalid unicode surrogate pair");
+    EXPECT_FALSE(Parse(R"("\ude00")", &root, &error));
+}
+
+TEST(SimpleJsonTest, RejectsMalformedInput) {
+    Value root;
+    std::string error;
+    EXPECT_FALSE(Parse("{\"a\": 1,}", &root, &error));
+    EXPECT_FALSE(Parse("[1 2]", &root, &error));
+    EXPECT_EQ(error, "expected ',' or ']' in array");
+    EXPECT_FALSE(Parse("1e", &root, &error));
+    EXPECT_EQ(error, "invalid number exponent");
+    EXPECT_FALSE(Parse("1e999", &root, &error));
+    EXPECT_FALSE(Parse("\"open", &root, &error));
+    EXPECT_EQ(error, "unterminated string");
+    EXPECT_FALSE(Parse("{} x", &root, &error));
+    EXPECT_EQ(error, "unexpected trailing characters in json");
+}
+
+TEST(SimpleJsonTest, ObjectCursorScansTopLevelMembersOnly) {
+    const std::string line =
+        R"({"file_path":"source=rb/a.parquet","nested":{"row_count":7,"s":"}"},)"
+        R"("list":[1,[2,"]"]],"row_count":1700000000123456789,"ok":true,)"
+        R"("ratio":0.5,"we\"ird":"x","none":null})";
+    ObjectCursor cursor(line);
+    std::string_view key;
+    RawValue value;
+    std::string file_path;
+    std::int64_t row_count = 0;
+    bool ok = false;
+    double ratio = 0.0;
+    int members = 0;
+    while (cursor.Next(&key, &value)) {
+        ++members;
+        if (key == "file_path") {
+            EXPECT_TRUE(value.GetString(&file_path));
+        } else if (key == "nested") {
+            EXPECT_EQ(value.type, Value::Type::kObject);
+            Value nested;
+            ASSERT_TRUE(value.Parse(&nested));
+            EXPECT_EQ(nested.Find("s")->string_value, "}");
+        } else if (key == "list") {
+            EXPECT_EQ(value.text, R"([1,[2,"]"]])");
+        } else if (key == "row_count") {
+            EXPECT_TRUE(value.GetInt64(&row_count));
+            EXPECT_FALSE(value.GetString(&file_path));
+        } else if (key == "ok") {
+            EXPECT_TRUE(value.GetBool(&ok));
+        } else if (key == "ratio") {
+            EXPECT_TRUE(value.GetNumber(&ratio));
+            std::int64_t truncated = 42;
+            EXPECT_FALSE(value.GetInt64(&truncated));
+            EXPECT_EQ(truncated, 42);
+        } else if (key == "we\"ird") {
+            std::string text;
+            EXPECT_TRUE(value.GetString(&text));
+            EXPECT_EQ(text, "x");
+        } else {
+            EXPECT_EQ(key, "none");
+            EXPECT_EQ(value.type, Value::Type::kNull);
+        }
+    }
+    EXPECT_TRUE(cursor.ok()) << cursor.error();
+    EXPECT_EQ(members, 8);
+    EXPECT_EQ(file_path, "source=rb/a.parquet");
+    EXPECT_EQ(row_count, 1700000000123456789LL);
+    EXPECT_TRUE(ok);
+    EXPECT_DOUBLE_EQ(ratio, 0.5);
+
+    ObjectCursor empty(" {} ");
+    EXPECT_FALSE(empty.Next(&key, &value));
+    EXPECT_TRUE(empty.ok());
+}
+
+TEST(SimpleJsonTest, ObjectCursorReportsMalformedLines) {
+    std::string_view key;
+    RawValue value;
+
+    ObjectCursor truncated(R"({"a":1,"b":[1,2)");
+    EXPECT_TRUE(truncated.Next(&key, &value));
+    EXPECT_FALSE(truncated.Next(&key, &value));
+    EXPECT_FALSE(truncated.ok());
+
+    ObjectCursor not_object("[1]");
+    EXPECT_FALSE(not_object.Next(&key, &value));
+    EXPECT_EQ(not_object.error(), "expected '{'");
+
+    ObjectCursor trailing(R"({"a":1} {"b":2})");
+    EXPECT_TRUE(trailing.Next(&key, &value));
+    EXPECT_FALSE(trailing.ok());
+}
+
+}  // namespace
+}  // namespace quant_hft::simple_json
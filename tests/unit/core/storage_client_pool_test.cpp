@@ -71,6 +71,22 @@ public:
         return true;
     }
 
+    bool HDel(const std::string& key,
+              const std::vector<std::string>& fields,
+              std::string* error) override {
+        if (!write_ok_) {
+            if (error != nullptr) {
+                *error = "write fail";
+            }
+            return false;
+        }
+        auto& hash = store_[key];
+        for (const std::string& field : fields) {
+            hash.erase(field);
+        }
+        return true;
+    }
+
     bool Expire(const std::string& key, int ttl_seconds, std::string* error) override {
         ++expire_calls_;
         if (ttl_seconds <= 0) {
@@ -307,4 +307,17 @@ TEST(TcpRedisHashClientTest, SupportsExpire) {
     EXPECT_TRUE(server.passed()) << server.error();
 }
 
+TEST(TcpRedisHashClientTest, SupportsHDel) {
+    FakeRedisServer server({
+        Expectation{{"HDEL", "strategy_state:acc-1:kama", "stop_price", "target_price"}, ":1\r\n"},
+    });
+
+    TcpRedisHashClient client(BuildConfig(server.port()));
+    std::string error;
+    EXPECT_TRUE(client.HDel("strategy_state:acc-1:kama", {"stop_price", "target_price"}, &error))
+        << error;
+    EXPECT_FALSE(client.HDel("strategy_state:acc-1:kama", {}, &error));
+    EXPECT_TRUE(server.passed()) << server.error();
+}
+
 }  // namespace quant_hft
@@ -2,10 +2,13 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "quant_hft/core/local_wal_regulatory_sink.h"
 #include "quant_hft/services/in_memory_portfolio_ledger.h"
@@ -281,4 +284,76 @@ TEST(CtpOrderMappingStoreTest, ExchangeOrderIdentityResolvesTradeWithoutOrderRef
     EXPECT_EQ(trade.instrument_id, "DCE.i2609");
 }
 
+TEST(CtpOrderMappingStoreTest, RetiresTradingDaysBeyondRetention) {
+    CtpOrderMappingStore store(2);
+    CtpOrderSubmitMapping mapping;
+    mapping.account_id = "acc";
+    mapping.order_ref = "7";
+    mapping.front_id = 1;
+    mapping.session_id = 9;
+    for (const std::string day : {"20260717", "20260718", "20260719"}) {
+        mapping.client_order_id = "client-" + day;
+        mapping.trading_day = day;
+        store.Upsert(mapping);
+    }
+    EXPECT_EQ(store.stored_mapping_count(), 2U);
+
+    OrderEvent event;
+    event.account_id = "acc";
+    event.order_ref = "7";
+    event.front_id = 1;
+    event.session_id = 9;
+    event.trading_day = "20260717";
+    EXPECT_FALSE(store.EnrichOrderEvent(&event));
+    event.trading_day = "20260718";
+    ASSERT_TRUE(store.EnrichOrderEvent(&event));
+    EXPECT_EQ(event.client_order_id, "client-20260718");
+
+    store.RetireTradingDaysBefore("20260719");
+    EXPECT_EQ(store.stored_mapping_count(), 1U);
+    event.client_order_id.clear();
+    EXPECT_FALSE(store.EnrichOrderEvent(&event));
+}
+
+TEST(CtpOrderMappingStoreTest, CallbacksResolveWhileOrdersAreSubmitted) {
+    constexpr int kOrders = 5000;
+    CtpOrderMappingStore store;
+    std::atomic<int> submitted{0};
+    std::atomic<bool> failed{false};
+    std::thread reader([&]() {
+        while (submitted.load() < kOrders) {
+            const int index = submitted.load() - 1;
+            if (index < 0) {
+                continue;
+            }
+            OrderEvent event;
+            event.account_id = "acc";
+            event.order_ref = std::to_string(index);
+            event.front_id = 1;
+            event.session_id = 9;
+            event.trading_day = "20260719";
+            if (!store.EnrichOrderEvent(&event) ||
+                event.client_order_id != "client-" + std::to_string(index)) {
+                failed.store(true);
+            }
+        }
+    });
+
+    CtpOrderSubmitMapping mapping;
+    mapping.account_id = "acc";
+    mapping.front_id = 1;
+    mapping.session_id = 9;
+    mapping.trading_day = "20260719";
+    for (int index = 0; index < kOrders; ++index) {
+        mapping.client_order_id = "client-" + std::to_string(index);
+        mapping.order_ref = std::to_string(index);
+        store.Upsert(mapping);
+        submitted.store(index + 1);
+    }
+    reader.join();
+
+    EXPECT_FALSE(failed.load());
+    EXPECT_EQ(store.stored_mapping_count(), static_cast<std::size_t>(kOrders));
+}
+
 }  // namespace quant_hft
@@ -0,0 +1,171 @@
+#include "quant_hft/indicators/batch_indicators.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "quant_hft/indicators/adx.h"
+#include "quant_hft/indicators/atr.h"
+#include "quant_hft/indicators/ema.h"
+#include "quant_hft/indicators/kama.h"
+#include "quant_hft/indicators/sma.h"
+
+namespace quant_hft {
+namespace {
+
+struct TestBar {
+    double high;
+    double low;
+    double close;
+};
+
+// Deterministic random walk with a few flat stretches and a non-finite bar.
+std::vector<TestBar> MakeBars(std::size_t count) {
+    std::vector<TestBar> bars;
+    bars.reserve(count);
+    std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+    double close = 100.0;
+    for (std::size_t index = 0; index < count; ++index) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const double step = static_cast<double>((state >> 33) % 2001) / 1000.0 - 1.0;
+        if (index % 37 >= 3) {
+            close += step;
+        }
+        const double spread = 0.25 + static_cast<double>((state >> 17) % 100) / 200.0;
+        bars.push_back({close + spread, close - spread, close});
+    }
+    bars[50].close = std::numeric_limits<double>::quiet_NaN();
+    return bars;
+}
+
+void ExpectSameValue(const std::optional<double>& expected, const std::optional<double>& actual) {
+    ASSERT_EQ(expected.has_value(), actual.has_value());
+    if (expected.has_value()) {
+        EXPECT_EQ(*expected, *actual);
+    }
+}
+
+TEST(BatchIndicatorsTest, ThrowsWhenAnyLanePeriodIsNotPositive) {
+    EXPECT_THROW((void)BatchSMA({5, 0}), std::invalid_argument);
+    EXPECT_THROW((void)BatchEMA({-1}), std::invalid_argument);
+    EXPECT_THROW((void)BatchATR({14, 0}), std::invalid_argument);
+    EXPECT_THROW((void)BatchADX({0}), std::invalid_argument);
+    EXPECT_THROW((void)BatchKAMA({{10, 2, 30}, {10, 0, 30}}), std::invalid_argument);
+}
+
+TEST(BatchIndicatorsTest, MovingAveragesMatchScalarIndicatorsPerLane) {
+    const std::vector<int> periods = {1, 3, 7, 20, 64};
+    BatchSMA batch_sma(periods);
+    BatchEMA batch_ema(periods);
+    std::vector<SMA> smas;
+    std::vector<EMA> emas;
+    for (const int period : periods) {
+        smas.emplace_back(period);
+        emas.emplace_back(period);
+    }
+
+    for (const TestBar& bar : MakeBars(300)) {
+        batch_sma.Update(bar.high, bar.low, bar.close);
+        batch_ema.Update(bar.high, bar.low, bar.close);
+        for (std::size_t lane = 0; lane < periods.size(); ++lane) {
+            smas[lane].Update(bar.high, bar.low, bar.close);
+            emas[lane].Update(bar.high, bar.low, bar.close);
+            EXPECT_EQ(smas[lane].IsReady(), batch_sma.IsReady(lane));
+            ExpectSameValue(smas[lane].Value(), batch_sma.Value(lane));
+            EXPECT_EQ(emas[lane].IsReady(), batch_ema.IsReady(lane));
+            ExpectSameValue(emas[lane].Value(), batch_ema.Value(lane));
+        }
+    }
+}
+
+TEST(BatchIndicatorsTest, AtrAndAdxMatchScalarIndicatorsPerLane) {
+    const std::vector<int> periods = {1, 2, 7, 14, 28};
+    BatchATR batch_atr(periods);
+    BatchADX batch_adx(periods);
+    std::vector<ATR> atrs;
+    std::vector<ADX> adxs;
+    for (const int period : periods) {
+        atrs.emplace_back(period);
+        adxs.emplace_back(period);
+    }
+
+    for (const TestBar& bar : MakeBars(300)) {
+        batch_atr.Update(bar.high, bar.low, bar.close);
+        batch_adx.Update(bar.high, bar.low, bar.close);
+        for (std::size_t lane = 0; lane < periods.size(); ++lane) {
+            atrs[lane].Update(bar.high, bar.low, bar.close);
+            adxs[lane].Update(bar.high, bar.low, bar.close);
+            EXPECT_EQ(atrs[lane].IsReady(), batch_atr.IsReady(lane));
+            ExpectSameValue(atrs[lane].Value(), batch_atr.Value(lane));
+            EXPECT_EQ(adxs[lane].IsReady(), batch_adx.IsReady(lane));
+            ExpectSameValue(adxs[lane].Value(), batch_adx.Value(lane));
+            ExpectSameValue(adxs[lane].PlusDI(), batch_adx.PlusDI(lane));
+            ExpectSameValue(adxs[lane].MinusDI(), batch_adx.MinusDI(lane));
+            ExpectSameValue(adxs[lane].Dx(), batch_adx.Dx(lane));
+        }
+    }
+}
+
+TEST(BatchIndicatorsTest, KamaMatchesScalarIndicatorPerLane) {
+    const std::vector<BatchKAMA::Params> params = {
+        {1, 2, 30}, {3, 2, 5}, {10, 2, 30}, {10, 3, 40}, {25, 2, 30}};
+    BatchKAMA batch_kama(params);
+    std::vector<KAMA> kamas;
+    for (const auto& lane : params) {
+        kamas.emplace_back(lane.er_period, lane.fast_period, lane.slow_period);
+    }
+
+    for (const TestBar& bar : MakeBars(300)) {
+        batch_kama.Update(bar.high, bar.low, bar.close);
+        for (std::size_t lane = 0; lane < params.size(); ++lane) {
+            kamas[lane].Update(bar.high, bar.low, bar.close);
+            EXPECT_EQ(kamas[lane].IsReady(), batch_kama.IsReady(lane));
+            ExpectSameValue(kamas[lane].Value(), batch_kama.Value(lane));
+            ExpectSameValue(kamas[lane].EfficiencyRatio(), batch_kama.EfficiencyRatio(lane));
+        }
+    }
+}
+
+TEST(BatchIndicatorsTest, ResetClearsEveryLane) {
+    BatchKAMA batch_kama({{3, 2, 5}});
+    BatchADX batch_adx({3});
+    const std::vector<TestBar> bars = MakeBars(20);
+    for (const TestBar& bar : bars) {
+        batch_kama.Update(bar.high, bar.low, bar.close);
+        batch_adx.Update(bar.high, bar.low, bar.close);
+    }
+    const std::optional<double> kama_before = batch_kama.Value(0);
+    const std::optional<double> adx_before = batch_adx.Value(0);
+    ASSERT_TRUE(kama_before.has_value());
+    ASSERT_TRUE(adx_before.has_value());
+
+    batch_kama.Reset();
+    batch_adx.Reset();
+    EXPECT_FALSE(batch_kama.IsReady(0));
+    EXPECT_FALSE(batch_adx.IsReady(0));
+    EXPECT_FALSE(batch_adx.Dx(0).has_value());
+
+    for (const TestBar& bar : bars) {
+        batch_kama.Update(bar.high, bar.low, bar.close);
+        batch_adx.Update(bar.high, bar.low, bar.close);
+    }
+    ExpectSameValue(kama_before, batch_kama.Value(0));
+    ExpectSameValue(adx_before, batch_adx.Value(0));
+}
+
+TEST(BatchIndicatorsTest, OutOfRangeLaneIsNeverReady) {
+    BatchSMA batch_sma({2});
+    batch_sma.Update(0.0, 0.0, 1.0);
+    batch_sma.Update(0.0, 0.0, 2.0);
+    EXPECT_TRUE(batch_sma.IsReady(0));
+    EXPECT_FALSE(batch_sma.IsReady(1));
+    EXPECT_FALSE(batch_sma.Value(1).has_value());
+}
+
+}  // namespace
+}  // namespace quant_hft
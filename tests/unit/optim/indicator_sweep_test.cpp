@@ -0,0 +1,115 @@
+#include "quant_hft/optim/indicator_sweep.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace quant_hft::optim {
+namespace {
+
+std::filesystem::path MakeTempDir() {
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto dir = std::filesystem::temp_directory_path() /
+                     ("quant_hft_indicator_sweep_test_" + std::to_string(stamp));
+    std::filesystem::create_directories(dir / "sub");
+    return dir;
+}
+
+void WriteFile(const std::filesystem::path& path, const std::string& content) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream out(path);
+    out << content;
+    out.close();
+}
+
+std::filesystem::path WriteComposite(const std::filesystem::path& base_dir,
+                                     const std::string& target_type) {
+    WriteFile(base_dir / "sub" / "target.yaml",
+              "params:\n"
+              "  id: target\n"
+              "  er_period: 10\n"
+              "  stop_loss_atr_period: 14\n"
+              "  default_volume: 1\n");
+    const std::filesystem::path composite = base_dir / "composite.yaml";
+    WriteFile(composite,
+              "run_type: backtest\n"
+              "market_state_mode: false\n"
+              "backtest:\n"
+              "  initial_equity: 200000\n"
+              "  product_series_mode: raw\n"
+              "  symbols: [c]\n"
+              "  start_date: 20240101\n"
+              "  end_date: 20240331\n"
+              "  product_config_path: ./instrument_info.json\n"
+              "  contract_expiry_calendar_path: ./contract_expiry_calendar.yaml\n"
+              "composite:\n"
+              "  merge_rule: kPriority\n"
+              "  enable_non_backtest: false\n"
+              "  sub_strategies:\n"
+              "    - id: target\n"
+              "      enabled: true\n"
+              "      timeframe_minutes: 5\n"
+              "      type: " +
+                  target_type +
+                  "\n"
+                  "      config_path: ./sub/target.yaml\n");
+    return composite;
+}
+
+TrialConfigRequest MakeRequest(const std::filesystem::path& composite, int er_period,
+                               double stop_loss_multiplier) {
+    TrialConfigRequest request;
+    request.composite_config_path = composite;
+    request.target_sub_config_path = "./sub/target.yaml";
+    request.param_overrides["er_period"] = er_period;
+    request.param_overrides["stop_loss_atr_multiplier"] = stop_loss_multiplier;
+    return request;
+}
+
+TEST(IndicatorSweepTest, SharesIndicatorsAcrossKamaTrendTrials) {
+    const std::filesystem::path base_dir = MakeTempDir();
+    const std::filesystem::path composite = WriteComposite(base_dir, "KamaTrendStrategy");
+
+    std::vector<TrialConfigRequest> requests;
+    for (const int er_period : {5, 10}) {
+        for (const double multiplier : {1.5, 2.0, 2.5}) {
+            requests.push_back(MakeRequest(composite, er_period, multiplier));
+        }
+    }
+    const auto batch = BuildKamaTrendIndicatorBatch(requests);
+    ASSERT_NE(batch, nullptr);
+    EXPECT_EQ(batch->size(), 2U);
+    EXPECT_EQ(batch->kama_lane_count(), 2U);
+    EXPECT_EQ(batch->adx_lane_count(), 1U);
+    EXPECT_EQ(batch->atr_lane_count(), 1U);
+
+    KamaTrendIndicatorSpec expected;
+    expected.er_period = 5;
+    expected.stop_loss_atr_period = 14;
+    expected.take_profit_atr_period = 14;
+    EXPECT_TRUE(batch->Find(expected).has_value());
+    std::filesystem::remove_all(base_dir);
+}
+
+TEST(IndicatorSweepTest, SkipsBatchesWithoutSharedKamaTrendWork) {
+    const std::filesystem::path base_dir = MakeTempDir();
+    const std::filesystem::path trend = WriteComposite(base_dir, "TrendStrategy");
+    EXPECT_EQ(
+        BuildKamaTrendIndicatorBatch({MakeRequest(trend, 5, 2.0), MakeRequest(trend, 8, 2.0)}),
+        nullptr);
+
+    const std::filesystem::path kama = WriteComposite(base_dir, "KamaTrendStrategy");
+    EXPECT_EQ(BuildKamaTrendIndicatorBatch({MakeRequest(kama, 5, 2.0)}), nullptr);
+
+    TrialConfigRequest broken = MakeRequest(kama, 5, 2.0);
+    broken.target_sub_config_path = "./sub/missing.yaml";
+    EXPECT_EQ(BuildKamaTrendIndicatorBatch({MakeRequest(kama, 5, 2.0), broken}), nullptr);
+    std::filesystem::remove_all(base_dir);
+}
+
+}  // namespace
+}  // namespace quant_hft::optim
@@ -172,6 +172,46 @@ TEST(ParameterSpaceTest, LoadsRandomSearchConfigWithSeed) {
     std::filesystem::remove_all(dir, ec);
 }
 
+TEST(ParameterSpaceTest, LoadsSuccessiveHalvingConfigAndRequiresDateRange) {
+    const auto dir = MakeTempDir("quant_hft_parameter_space_successive_halving");
+    WriteFile(dir / "space_assets" / "strategies" / "main_backtest_strategy.yaml", "composite:\n");
+    WriteFile(dir / "space_assets" / "strategies" / "sub" / "kama_trend_1.yaml", "params:\n");
+    const std::string header =
+        "composite_config_path: ./space_assets/strategies/main_backtest_strategy.yaml\n"
+        "target_sub_config_path: ./sub/kama_trend_1.yaml\n"
+        "backtest_args:\n"
+        "  engine_mode: parquet\n"
+        "  dataset_root: backtest_data/parquet_v2\n";
+    const std::string tail =
+        "optimization:\n"
+        "  algorithm: successive_halving\n"
+        "  metric_path: profit_factor\n"
+        "  max_trials: 27\n"
+        "  halving_eta: 3\n"
+        "  halving_min_fraction: 0.25\n"
+        "parameters:\n"
+        "  - name: default_volume\n"
+        "    type: int\n"
+        "    values: [1, 2, 3]\n";
+
+    ParameterSpace space;
+    std::string error;
+    const auto with_dates = WriteFile(
+        dir / "with_dates.yaml",
+        header + "  start_date: 20240102\n  end_date: 20241231\n" + tail);
+    EXPECT_TRUE(LoadParameterSpace(with_dates.string(), &space, &error)) << error;
+    EXPECT_EQ(space.optimization.algorithm, "successive_halving");
+    EXPECT_EQ(space.optimization.halving_eta, 3);
+    EXPECT_DOUBLE_EQ(space.optimization.halving_min_fraction, 0.25);
+
+    const auto without_dates = WriteFile(dir / "without_dates.yaml", header + tail);
+    EXPECT_FALSE(LoadParameterSpace(without_dates.string(), &space, &error));
+    EXPECT_NE(error.find("start_date"), std::string::npos);
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
 TEST(ParameterSpaceTest, UsesDefaultsWhenOptimizationMissing) {
     const auto dir = MakeTempDir("quant_hft_parameter_space_defaults");
     const auto composite = WriteFile(dir / "space_assets" / "strategies" / "main_backtest_strategy.yaml",
@@ -600,5 +600,84 @@ TEST(ResultAnalyzerTest, WritesHeatmapsForNumericPairsWithAveragesAndNulls) {
     std::filesystem::remove_all(temp_dir, ec);
 }
 
+TEST(ResultAnalyzerTest, DecodedTrialResultServesObjectiveMetricsAndConstraints) {
+    const std::string json_text =
+        "{\n"
+        "  \"initial_equity\": 1000.0,\n"
+        "  \"summary\": {\"total_pnl\": \"25.0\", \"max_drawdown\": 0.15, \"label\": \"run\"},\n"
+        "  \"hf_standard\": {\"advanced_summary\": {\"profit_factor\": 1.8}}\n"
+        "}\n";
+
+    TrialResultRecord record;
+    std::string error;
+    ASSERT_TRUE(ResultAnalyzer::DecodeTrialResultJsonText(json_text, &record, &error)) << error;
+    EXPECT_EQ(record.fields.at("summary").kind, TrialResultField::Kind::kObject);
+    EXPECT_DOUBLE_EQ(record.fields.at("summary.total_pnl").value, 25.0);
+
+    EXPECT_DOUBLE_EQ(ResultAnalyzer::ExtractMetric(record, "total_pnl", &error), 25.0);
+    EXPECT_TRUE(error.empty()) << error;
+    EXPECT_DOUBLE_EQ(ResultAnalyzer::ExtractMetric(record, "max_drawdown_pct", &error), 0.15);
+    EXPECT_TRUE(error.empty()) << error;
+    (void)ResultAnalyzer::ExtractMetric(record, "summary.label", &error);
+    EXPECT_EQ(error, "metric path does not resolve to numeric value");
+    (void)ResultAnalyzer::ExtractMetric(record, "summary.total_pnl.value", &error);
+    EXPECT_EQ(error, "metric path segment `value` is not an object parent");
+    (void)ResultAnalyzer::ExtractMetric(record, "summary.missing", &error);
+    EXPECT_EQ(error, "metric path segment not found: missing");
+
+    OptimizationConfig config;
+    OptimizationObjective pnl;
+    pnl.metric_path = "summary.total_pnl";
+    pnl.scale_by_initial_equity = true;
+    config.objectives = {pnl};
+    OptimizationConstraint profit_factor;
+    ASSERT_TRUE(ResultAnalyzer::ParseOptimizationConstraint("profit_factor >= 2.0",
+                                                            &profit_factor, &error))
+        << error;
+    config.constraints = {profit_factor};
+
+    EXPECT_DOUBLE_EQ(ResultAnalyzer::ComputeObjective(record, config, &error), 0.025);
+    EXPECT_TRUE(error.empty()) << error;
+    std::vector<std::string> violations;
+    ASSERT_TRUE(ResultAnalyzer::EvaluateConstraints(record, config, &violations, &error))
+        << error;
+    ASSERT_EQ(violations.size(), 1U);
+    EXPECT_NE(violations[0].find("actual=1.8"), std::string::npos);
+}
+
+TEST(ResultAnalyzerTest, LoadTrialResultUsesSidecarUntilJsonChanges) {
+    const std::string json_text =
+        "{\"summary\": {\"total_pnl\": 12.5}, "
+        "\"hf_standard\": {\"advanced_summary\": {\"profit_factor\": 2.5}}}\n";
+    const auto json_path = WriteTempFile(".json", json_text);
+
+    TrialResultRecord decoded;
+    std::string error;
+    ASSERT_TRUE(ResultAnalyzer::DecodeTrialResultJsonText(json_text, &decoded, &error)) << error;
+    // Tamper with the cached value so the test can tell which source was used.
+    decoded.fields["summary.total_pnl"].value = 99.0;
+    ASSERT_TRUE(ResultAnalyzer::WriteTrialResultSidecar(json_path.string(), decoded, &error))
+        << error;
+
+    TrialResultRecord loaded;
+    ASSERT_TRUE(ResultAnalyzer::LoadTrialResult(json_path.string(), &loaded, &error)) << error;
+    EXPECT_EQ(loaded.fields.size(), decoded.fields.size());
+    EXPECT_DOUBLE_EQ(ResultAnalyzer::ExtractMetric(loaded, "total_pnl", &error), 99.0);
+    ASSERT_TRUE(loaded.metrics.profit_factor.has_value());
+    EXPECT_DOUBLE_EQ(*loaded.metrics.profit_factor, 2.5);
+    EXPECT_EQ(loaded.metrics_warnings, decoded.metrics_warnings);
+
+    {
+        std::ofstream out(json_path, std::ios::app);
+        out << "\n";
+    }
+    ASSERT_TRUE(ResultAnalyzer::LoadTrialResult(json_path.string(), &loaded, &error)) << error;
+    EXPECT_DOUBLE_EQ(ResultAnalyzer::ExtractMetric(loaded, "total_pnl", &error), 12.5);
+
+    std::error_code ec;
+    std::filesystem::remove(json_path, ec);
+    std::filesystem::remove(ResultAnalyzer::TrialResultSidecarPath(json_path.string()), ec);
+}
+
 }  // namespace
 }  // namespace quant_hft::optim
@@ -0,0 +1,146 @@
+#include "quant_hft/optim/successive_halving.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "quant_hft/optim/result_analyzer.h"
+
+namespace quant_hft::optim {
+namespace {
+
+ParameterSpace MakeSpace(int value_count) {
+    ParameterSpace space;
+    ParameterDef def;
+    def.name = "kama_filter";
+    def.type = ParameterType::kInt;
+    def.min = 1;
+    def.max = value_count;
+    def.step = 1.0;
+    space.parameters.push_back(def);
+    return space;
+}
+
+// Drives the algorithm the way parameter_optim_cli does; the objective is the
+// parameter value scaled by the fidelity so short rungs rank the same way.
+std::vector<Trial> RunToCompletion(SuccessiveHalving* algorithm, int batch_size) {
+    int trial_index = 0;
+    while (!algorithm->IsFinished()) {
+        const std::vector<ParamValueMap> batch = algorithm->GetNextBatch(batch_size);
+        if (batch.empty()) {
+            break;
+        }
+        const TrialFidelity fidelity = algorithm->CurrentFidelity();
+        for (const ParamValueMap& params : batch) {
+            Trial trial;
+            trial.trial_id = "trial_" + std::to_string(++trial_index);
+            trial.params = params;
+            trial.fidelity = fidelity;
+            trial.status = "completed";
+            trial.objective =
+                static_cast<double>(std::get<int>(params.values.at("kama_filter"))) *
+                fidelity.fraction;
+            algorithm->AddTrialResult(trial);
+        }
+    }
+    return algorithm->GetAllTrials();
+}
+
+TEST(SuccessiveHalvingTest, PromotesTopFractionThroughRungs) {
+    OptimizationConfig config;
+    config.max_trials = 27;
+    config.random_seed = 7;
+    config.halving_eta = 3;
+    config.halving_min_fraction = 1.0 / 9.0;
+
+    SuccessiveHalving algorithm;
+    algorithm.Initialize(MakeSpace(27), config);
+    ASSERT_EQ(algorithm.rung_fractions().size(), 3U);
+    EXPECT_NEAR(algorithm.rung_fractions()[0], 1.0 / 9.0, 1e-12);
+    EXPECT_NEAR(algorithm.rung_fractions()[1], 1.0 / 3.0, 1e-12);
+    EXPECT_DOUBLE_EQ(algorithm.rung_fractions()[2], 1.0);
+
+    const std::vector<Trial> trials = RunToCompletion(&algorithm, 4);
+    std::vector<int> per_rung(3, 0);
+    for (const Trial& trial : trials) {
+        ++per_rung[static_cast<std::size_t>(trial.fidelity.rung)];
+    }
+    EXPECT_EQ(per_rung, (std::vector<int>{27, 9, 3}));
+
+    const Trial best = algorithm.GetBestTrial();
+    EXPECT_EQ(best.status, "completed");
+    EXPECT_DOUBLE_EQ(best.fidelity.fraction, 1.0);
+    EXPECT_EQ(std::get<int>(best.params.values.at("kama_filter")), 27);
+}
+
+TEST(SuccessiveHalvingTest, FailedTrialsAreNeverPromoted) {
+    OptimizationConfig config;
+    config.max_trials = 4;
+    config.random_seed = 11;
+    config.halving_eta = 2;
+    config.halving_min_fraction = 0.5;
+
+    SuccessiveHalving algorithm;
+    algorithm.Initialize(MakeSpace(4), config);
+    const std::vector<ParamValueMap> first_rung = algorithm.GetNextBatch(8);
+    ASSERT_EQ(first_rung.size(), 4U);
+    for (const ParamValueMap& params : first_rung) {
+        Trial trial;
+        trial.params = params;
+        trial.fidelity = algorithm.CurrentFidelity();
+        const int value = std::get<int>(params.values.at("kama_filter"));
+        trial.status = value == 4 ? "failed" : "completed";
+        trial.objective = static_cast<double>(value);
+        algorithm.AddTrialResult(trial);
+    }
+
+    ASSERT_FALSE(algorithm.IsFinished());
+    EXPECT_DOUBLE_EQ(algorithm.CurrentFidelity().fraction, 1.0);
+    const std::vector<ParamValueMap> survivors = algorithm.GetNextBatch(8);
+    ASSERT_EQ(survivors.size(), 2U);
+    for (const ParamValueMap& params : survivors) {
+        EXPECT_NE(std::get<int>(params.values.at("kama_filter")), 4);
+    }
+}
+
+TEST(SuccessiveHalvingTest, AnalyzeRanksOnlyFullRangeTrials) {
+    OptimizationConfig config;
+    config.algorithm = "successive_halving";
+    config.max_trials = 9;
+    config.random_seed = 3;
+    config.halving_eta = 3;
+    config.halving_min_fraction = 1.0 / 3.0;
+
+    SuccessiveHalving algorithm;
+    algorithm.Initialize(MakeSpace(9), config);
+    const std::vector<Trial> trials = RunToCompletion(&algorithm, 2);
+    ASSERT_EQ(trials.size(), 12U);
+
+    const OptimizationReport report = ResultAnalyzer::Analyze(trials, config, false);
+    EXPECT_EQ(report.completed_trials, 12);
+    EXPECT_EQ(report.partial_fidelity_trials, 9);
+    EXPECT_DOUBLE_EQ(report.best_trial.fidelity.fraction, 1.0);
+    EXPECT_EQ(std::get<int>(report.best_trial.params.values.at("kama_filter")), 9);
+}
+
+TEST(SuccessiveHalvingTest, ResolvesLeadingSliceOfDateRange) {
+    std::string end_date;
+    std::string error;
+    ASSERT_TRUE(ResolveFidelityEndDate("20240101", "20240109", 1.0 / 3.0, &end_date, &error))
+        << error;
+    EXPECT_EQ(end_date, "20240103");
+
+    ASSERT_TRUE(ResolveFidelityEndDate("2024-02-20", "2024-03-10", 0.5, &end_date, &error))
+        << error;
+    EXPECT_EQ(end_date, "20240229");
+
+    ASSERT_TRUE(ResolveFidelityEndDate("20240101", "20241231", 1.0, &end_date, &error)) << error;
+    EXPECT_EQ(end_date, "20241231");
+
+    EXPECT_FALSE(ResolveFidelityEndDate("20240301", "20240101", 0.5, &end_date, &error));
+    EXPECT_FALSE(ResolveFidelityEndDate("2024", "20240101", 0.5, &end_date, &error));
+}
+
+}  // namespace
+}  // namespace quant_hft::optim
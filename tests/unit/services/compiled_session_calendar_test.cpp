@@ -0,0 +1,92 @@
+#include "quant_hft/services/compiled_session_calendar.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace quant_hft {
+namespace {
+
+constexpr int Minute(int hour, int minute) { return hour * 60 + minute; }
+
+TEST(CompiledSessionCalendarTest, PrefixRulesOverrideExchangeWideSessions) {
+    CompiledSessionCalendar::RuleSet rules;
+    rules["SHFE"].push_back(
+        {"", "", {{Minute(9, 0), Minute(11, 30)}, {Minute(21, 0), Minute(23, 0)}}});
+    rules["SHFE"].push_back(
+        {"AU", "", {{Minute(9, 0), Minute(11, 30)}, {Minute(21, 0), Minute(2, 30)}}});
+    rules["CFFEX"].push_back({"", "", {{Minute(9, 30), Minute(15, 0)}}});
+    rules["CFFEX"].push_back({"T", "", {{Minute(9, 30), Minute(15, 15)}}});
+    rules["CFFEX"].push_back({"TF", "", {{Minute(9, 30), Minute(15, 15)}}});
+    const auto calendar = CompiledSessionCalendar::Build(rules);
+
+    const auto* gold = calendar->ResolveInstrument("shfe", "SHFE.au2608");
+    ASSERT_NE(gold, nullptr);
+    EXPECT_TRUE(gold->IsOpen(Minute(1, 59)));
+    EXPECT_TRUE(gold->IsLastMinute(Minute(2, 29)));
+    EXPECT_TRUE(gold->IsIntervalEnd(Minute(2, 30)));
+    EXPECT_FALSE(gold->IsOpen(Minute(2, 30)));
+
+    const auto* rebar = calendar->ResolveInstrument("SHFE", "rb2610");
+    ASSERT_NE(rebar, nullptr);
+    EXPECT_FALSE(rebar->IsOpen(Minute(23, 30)));
+    EXPECT_TRUE(rebar->IsIntervalEnd(Minute(23, 0)));
+
+    // "TF" and "T" both prefix TF2609; an index future falls back to the exchange-wide rule.
+    const auto* five_year = calendar->ResolveInstrument("CFFEX", "TF2609");
+    ASSERT_NE(five_year, nullptr);
+    EXPECT_TRUE(five_year->IsOpen(Minute(15, 10)));
+    const auto* ten_year = calendar->ResolveInstrument("CFFEX", "T2609");
+    ASSERT_NE(ten_year, nullptr);
+    EXPECT_TRUE(ten_year->IsOpen(Minute(15, 10)));
+    const auto* index = calendar->ResolveInstrument("CFFEX", "IF2609");
+    ASSERT_NE(index, nullptr);
+    EXPECT_FALSE(index->IsOpen(Minute(15, 10)));
+
+    EXPECT_EQ(calendar->ResolveInstrument("CZCE", "SR609"), nullptr);
+    EXPECT_EQ(calendar->InferExchangeId("tf2609"), "CFFEX");
+    EXPECT_EQ(calendar->InferExchangeId("au2608"), "SHFE");
+    EXPECT_EQ(calendar->InferExchangeId("dce.m2609"), "DCE");
+    EXPECT_EQ(calendar->InferExchangeId("IF2609"), "");
+}
+
+TEST(CompiledSessionCalendarTest, IntervalKeysAndOrderFollowConfiguredSessions) {
+    const auto calendar = CompiledSessionCalendar::Build(CompiledSessionCalendar::DefaultRules());
+    const auto* schedule = calendar->ResolveInstrument("DCE", "c2609");
+    ASSERT_NE(schedule, nullptr);
+
+    const auto* night = schedule->IntervalAt(Minute(22, 15));
+    ASSERT_NE(night, nullptr);
+    EXPECT_EQ(CompiledSessionCalendar::FormatSessionKey(*night), "1260-1380");
+    const auto* morning = schedule->IntervalAt(Minute(9, 0));
+    ASSERT_NE(morning, nullptr);
+    EXPECT_LT(CompiledSessionCalendar::SessionOrderKey(*night),
+              CompiledSessionCalendar::SessionOrderKey(*morning));
+    EXPECT_EQ(schedule->IntervalAt(Minute(10, 20)), nullptr);
+
+    // Unknown exchanges use the "*" rules.
+    EXPECT_NE(calendar->ResolveInstrument("GFEX", "si2609"), nullptr);
+}
+
+TEST(CompiledSessionCalendarTest, ParsesIntegerTimesOnce) {
+    int minute_of_day = 0;
+    int second_of_day = 0;
+    EXPECT_TRUE(CompiledSessionCalendar::ParseMinuteOfDay("14:59", &minute_of_day));
+    EXPECT_EQ(minute_of_day, Minute(14, 59));
+    EXPECT_TRUE(CompiledSessionCalendar::ParseSecondOfDay("14:59:30.500", &second_of_day));
+    EXPECT_EQ(second_of_day, Minute(14, 59) * 60 + 30);
+    EXPECT_FALSE(CompiledSessionCalendar::ParseSecondOfDay("14:59:6x", &second_of_day));
+    EXPECT_FALSE(CompiledSessionCalendar::ParseMinuteOfDay("24:00", &minute_of_day));
+    EXPECT_EQ(CompiledSessionCalendar::ProductCode("SHFE.rb2610"), "RB");
+}
+
+TEST(CompiledSessionCalendarTest, SharedInstanceIsCompiledOncePerConfig) {
+    const std::string path = "configs/trading_sessions.yaml";
+    const auto first = CompiledSessionCalendar::Shared(path, true);
+    const auto second = CompiledSessionCalendar::Shared(path, true);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_NE(first.get(), CompiledSessionCalendar::Shared(path, false).get());
+}
+
+}  // namespace
+}  // namespace quant_hft
@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <memory>
@@ -304,13 +305,38 @@ class FakeSettlementStore : public ISettlementStore {
         return true;
     }
 
+    bool AppendDetails(const std::vector<SettlementDetailRecord>& batch,
+                       std::string* error) override {
+        detail_batch_sizes.push_back(batch.size());
+        writes_in_transaction = writes_in_transaction && in_transaction;
+        return ISettlementStore::AppendDetails(batch, error);
+    }
+
+    bool AppendPrices(const std::vector<SettlementPriceRecord>& batch,
+                      std::string* error) override {
+        price_batch_sizes.push_back(batch.size());
+        return ISettlementStore::AppendPrices(batch, error);
+    }
+
+    bool UpdatePositionsAfterSettlement(const std::vector<SettlementOpenPositionRecord>& batch,
+                                        std::string* error) override {
+        position_batch_sizes.push_back(batch.size());
+        writes_in_transaction = writes_in_transaction && in_transaction;
+        return ISettlementStore::UpdatePositionsAfterSettlement(batch, error);
+    }
+
     bool in_transaction{false};
+    bool writes_in_transaction{true};
+    std::vector<std::size_t> detail_batch_sizes;
+    std::vector<std::size_t> price_batch_sizes;
+    std::vector<std::size_t> position_batch_sizes;
 };
 
 class FakePriceProvider : public SettlementPriceProvider {
    public:
     std::optional<std::pair<double, SettlementPriceSource>> GetSettlementPrice(
         const std::string& instrument_id, const std::string& trading_day) override {
+        ++single_calls;
         const auto manual_it = manual.find(trading_day + "|" + instrument_id);
         if (manual_it != manual.end()) {
             return std::make_pair(
@@ -328,9 +354,11 @@ class FakePriceProvider : public SettlementPriceProvider {
     std::unordered_map<std::string, std::pair<double, SettlementPriceSource>>
     BatchGetSettlementPrices(const std::vector<std::string>& instrument_ids,
                              const std::string& trading_day) override {
+        ++batch_calls;
         std::unordered_map<std::string, std::pair<double, SettlementPriceSource>> result;
         for (const auto& instrument_id : instrument_ids) {
             auto price = GetSettlementPrice(instrument_id, trading_day);
+            --single_calls;
             if (price.has_value()) {
                 result[instrument_id] = *price;
             }
@@ -346,6 +374,8 @@ class FakePriceProvider : public SettlementPriceProvider {
 
     std::unordered_map<std::string, double> prices;
     std::unordered_map<std::string, double> manual;
+    int single_calls{0};
+    int batch_calls{0};
 };
 
 class FakeTradingDomainStore : public ITradingDomainStore {
@@ -576,6 +606,53 @@ TEST(DailySettlementServiceTest, SettlementLoopUpdatesPositionsAndProfit) {
     EXPECT_DOUBLE_EQ(store->upserted_funds.back().position_profit, 40.0);
 }
 
+TEST(DailySettlementServiceTest, SettlementLoopWritesAllPositionsAsOneBatch) {
+    auto store = std::make_shared<FakeSettlementStore>();
+    auto price = std::make_shared<FakePriceProvider>();
+    auto query_client = BuildFailingQueryClient();
+
+    for (std::int64_t id = 1; id <= 4; ++id) {
+        SettlementOpenPositionRecord position;
+        position.position_id = id;
+        position.account_id = "acc1";
+        position.strategy_id = "s1";
+        position.instrument_id = id % 2 == 0 ? "rb2405" : "au2406";
+        position.exchange_id = "SHFE";
+        position.open_date = "2026-02-12";
+        position.position_date = "2026-02-12";
+        position.volume = 1;
+        position.open_price = 100.0;
+        position.position_status = 1;
+        store->open_positions.push_back(position);
+    }
+    for (const char* instrument_id : {"rb2405", "au2406"}) {
+        SettlementInstrumentRecord instrument;
+        instrument.instrument_id = instrument_id;
+        instrument.contract_multiplier = 10;
+        store->instruments[instrument_id] = instrument;
+        price->prices[std::string("2026-02-12|") + instrument_id] = 101.0;
+    }
+
+    DailySettlementService service(price, store, query_client);
+
+    DailySettlementResult result;
+    std::string error;
+    ASSERT_TRUE(service.Run(BaseConfig(), &result, &error)) << error;
+    EXPECT_EQ(price->batch_calls, 1);
+    EXPECT_EQ(price->single_calls, 0);
+    ASSERT_EQ(store->price_batch_sizes.size(), 1U);
+    EXPECT_EQ(store->price_batch_sizes[0], 2U);
+    ASSERT_FALSE(store->position_batch_sizes.empty());
+    EXPECT_EQ(store->position_batch_sizes[0], 4U);
+    ASSERT_EQ(store->detail_batch_sizes.size(), 1U);
+    EXPECT_EQ(store->detail_batch_sizes[0], 4U);
+    EXPECT_TRUE(store->writes_in_transaction);
+    EXPECT_FALSE(store->in_transaction);
+    EXPECT_EQ(store->details.size(), 4U);
+    ASSERT_FALSE(store->upserted_funds.empty());
+    EXPECT_DOUBLE_EQ(store->upserted_funds.back().position_profit, 40.0);
+}
+
 TEST(DailySettlementServiceTest, RolloverUpdatesPositionSummary) {
     auto store = std::make_shared<FakeSettlementStore>();
     auto price = std::make_shared<FakePriceProvider>();
@@ -686,6 +763,43 @@ TEST(DailySettlementServiceTest, ReconcileDetectsMismatchAndBlocks) {
     bundle.trader->Disconnect();
 }
 
+TEST(DailySettlementServiceTest, ReconcileDiffOrderFollowsSortedInstruments) {
+    auto store = std::make_shared<FakeSettlementStore>();
+    auto price = std::make_shared<FakePriceProvider>();
+    auto bundle = BuildConnectedQueryClient();
+    // Inserted in reverse so the output order cannot come from the input order.
+    for (int i = 49; i >= 0; --i) {
+        SettlementPositionSummaryRecord row;
+        row.account_id = "191202";
+        row.strategy_id = "s1";
+        row.instrument_id = "ins" + std::to_string(10000 + i);
+        row.long_volume = 1;
+        row.long_yd_volume = 1;
+        store->position_summary.push_back(row);
+    }
+
+    DailySettlementService service(price, store, bundle.query_client);
+    DailySettlementResult result;
+    std::string error;
+    EXPECT_TRUE(service.Run(BaseConfig("191202"), &result, &error)) << error;
+    EXPECT_EQ(result.status, "BLOCKED");
+    bundle.trader->Disconnect();
+
+    std::vector<std::string> keys;
+    for (const auto& diff : store->diffs) {
+        keys.push_back(diff.diff_type + "|" + diff.key_ref);
+    }
+    const auto first_position =
+        std::find_if(keys.begin(), keys.end(),
+                     [](const std::string& key) { return key.rfind("POSITION|", 0) == 0; });
+    ASSERT_NE(first_position, keys.end());
+    EXPECT_EQ(std::count_if(first_position, keys.end(),
+                            [](const std::string& key) { return key.rfind("POSITION|", 0) == 0; }),
+              100);
+    EXPECT_EQ(*first_position, "POSITION|ins10000:long_position");
+    EXPECT_TRUE(std::is_sorted(first_position, keys.end()));
+}
+
 TEST(DailySettlementServiceTest, ReconcilePassesAndCompletes) {
     auto store = std::make_shared<FakeSettlementStore>();
     auto price = std::make_shared<FakePriceProvider>();
@@ -82,6 +82,20 @@ TEST(DominantContractCoordinatorTest, RequiresThreeLeadWindowsThenFreezesOpens)
     EXPECT_FALSE(coordinator.ValidateSignal(open, 0).allowed);
 }
 
+TEST(DominantContractCoordinatorTest, InternedSnapshotsUpdateTheSameInstrument) {
+    auto coordinator = MakeCoordinator();
+    Seed(&coordinator);
+    MarketSnapshot interned = Tick("c2609", 1200);
+    interned.instrument_handle = InstrumentRegistry::Global().Intern("c2609");
+    coordinator.UpdateLiveSnapshot(interned);
+
+    EXPECT_EQ(coordinator.Evaluate("c", kNow + 1, true).action, DominantContractAction::kNone);
+    EXPECT_EQ(coordinator.Evaluate("c", kNow + 2, true).action, DominantContractAction::kNone);
+    const auto decision = coordinator.Evaluate("c", kNow + 3, true);
+    EXPECT_EQ(decision.action, DominantContractAction::kBeginSwitch);
+    EXPECT_EQ(decision.candidate_instrument_id, "c2609");
+}
+
 TEST(DominantContractCoordinatorTest, EnforcesLeadBoundaryAndFifteenMinuteHold) {
     DominantContractCoordinatorConfig config;
     config.min_lead_ratio = 0.15;
@@ -0,0 +1,114 @@
+#include "quant_hft/services/execution_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace quant_hft {
+
+TEST(ExecutionSchedulerTest, ScheduleDoesNotBlockCallerAndRunsInDueOrder) {
+    ExecutionScheduler scheduler(1);
+    scheduler.Start();
+
+    std::mutex order_mutex;
+    std::vector<int> order;
+    const auto started_at = std::chrono::steady_clock::now();
+    for (int slice = 0; slice < 3; ++slice) {
+        ASSERT_TRUE(scheduler.ScheduleAfter("SHFE.rb2405", std::chrono::milliseconds(40 * slice),
+                                            [&order_mutex, &order, slice]() {
+                                                std::lock_guard<std::mutex> lock(order_mutex);
+                                                order.push_back(slice);
+                                            }));
+    }
+    const auto schedule_elapsed = std::chrono::steady_clock::now() - started_at;
+    EXPECT_LT(schedule_elapsed, std::chrono::milliseconds(40));
+
+    ASSERT_TRUE(scheduler.WaitUntilIdle(std::chrono::milliseconds(2000)));
+    EXPECT_GE(std::chrono::steady_clock::now() - started_at, std::chrono::milliseconds(80));
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+    scheduler.Stop();
+
+    const auto stats = scheduler.GetStats();
+    EXPECT_EQ(stats.scheduled, 3U);
+    EXPECT_EQ(stats.executed, 3U);
+}
+
+TEST(ExecutionSchedulerTest, SameDueTimeKeepsScheduleOrder) {
+    ExecutionScheduler scheduler(1);
+    scheduler.Start();
+
+    std::vector<int> order;
+    const auto due = ExecutionScheduler::Clock::now() + std::chrono::milliseconds(10);
+    for (int index = 0; index < 5; ++index) {
+        ASSERT_TRUE(
+            scheduler.ScheduleAt("lane", due, [&order, index]() { order.push_back(index); }));
+    }
+    ASSERT_TRUE(scheduler.WaitUntilIdle(std::chrono::milliseconds(2000)));
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(ExecutionSchedulerTest, SlowLaneDoesNotDelayOtherLanes) {
+    ExecutionScheduler scheduler(8);
+    scheduler.Start();
+
+    std::promise<void> release_slow;
+    const auto release_future = release_slow.get_future().share();
+    std::promise<void> slow_started;
+    ASSERT_TRUE(scheduler.ScheduleAfter("SHFE.rb2405", std::chrono::milliseconds(0),
+                                        [&slow_started, release_future]() {
+                                            slow_started.set_value();
+                                            release_future.wait();
+                                        }));
+    ASSERT_EQ(slow_started.get_future().wait_for(std::chrono::milliseconds(500)),
+              std::future_status::ready);
+
+    std::string fast_key = "DCE.m2405";
+    for (int suffix = 0; std::hash<std::string>{}(fast_key) % 8 ==
+                         std::hash<std::string>{}(std::string("SHFE.rb2405")) % 8;
+         ++suffix) {
+        fast_key = "DCE.m2405_" + std::to_string(suffix);
+    }
+    std::promise<void> fast_done;
+    ASSERT_TRUE(scheduler.ScheduleAfter(fast_key, std::chrono::milliseconds(0),
+                                        [&fast_done]() { fast_done.set_value(); }));
+    EXPECT_EQ(fast_done.get_future().wait_for(std::chrono::milliseconds(500)),
+              std::future_status::ready);
+
+    release_slow.set_value();
+    ASSERT_TRUE(scheduler.WaitUntilIdle(std::chrono::milliseconds(2000)));
+}
+
+TEST(ExecutionSchedulerTest, StopDropsTimersThatAreNotDue) {
+    ExecutionScheduler scheduler(1);
+    scheduler.Start();
+
+    std::atomic<int> executed{0};
+    ASSERT_TRUE(scheduler.ScheduleAfter("lane", std::chrono::milliseconds(0),
+                                        [&executed]() { executed.fetch_add(1); }));
+    ASSERT_TRUE(scheduler.WaitUntilIdle(std::chrono::milliseconds(2000)));
+    ASSERT_TRUE(scheduler.ScheduleAfter("lane", std::chrono::milliseconds(60'000),
+                                        [&executed]() { executed.fetch_add(1); }));
+    scheduler.Stop();
+
+    EXPECT_EQ(executed.load(), 1);
+    EXPECT_EQ(scheduler.GetStats().dropped_on_stop, 1U);
+    EXPECT_FALSE(scheduler.ScheduleAfter("lane", std::chrono::milliseconds(0), [] {}));
+}
+
+TEST(ExecutionSchedulerTest, RejectsWhenPendingCapacityExceeded) {
+    ExecutionScheduler scheduler(1, 2);
+    scheduler.Start();
+
+    ASSERT_TRUE(scheduler.ScheduleAfter("lane", std::chrono::milliseconds(60'000), [] {}));
+    ASSERT_TRUE(scheduler.ScheduleAfter("lane", std::chrono::milliseconds(60'000), [] {}));
+    EXPECT_FALSE(scheduler.ScheduleAfter("lane", std::chrono::milliseconds(0), [] {}));
+    EXPECT_EQ(scheduler.GetStats().rejected, 1U);
+    scheduler.Stop();
+}
+
+}  // namespace quant_hft
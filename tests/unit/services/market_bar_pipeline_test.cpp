@@ -2,9 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cctype>
 #include <cstdio>
 #include <ctime>
 #include <filesystem>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -226,6 +228,110 @@ TEST(MarketBarPipelineTest, AtomicCheckpointRoundTripPreservesPendingState) {
     std::filesystem::remove(path, ec);
 }
 
+TEST(MarketBarPipelineTest, BinaryCheckpointPreservesRecentStatesAndTickDedup) {
+    MarketBarPipeline source(MakeConfig());
+    for (int minute = 0; minute <= 9; ++minute) {
+        FeedAndFinalizeMinute(&source, minute, 100 + minute * 10);
+    }
+    const MarketSnapshot pending = MakeTick(10, 10, 200, 110.0);
+    (void)source.OnTick(pending);
+    const auto path = std::filesystem::temp_directory_path() /
+                      "quant_hft_market_bar_pipeline_checkpoint_binary.state";
+    std::string error;
+    ASSERT_TRUE(source.SaveCheckpointAtomically(path.string(), &error)) << error;
+    std::ifstream stream(path, std::ios::binary);
+    std::string magic(7, '\0');
+    stream.read(&magic[0], 7);
+    EXPECT_EQ(magic, "QHMBPCK");
+
+    MarketBarPipeline restored(MakeConfig());
+    ASSERT_TRUE(restored.LoadCheckpointFile(path.string(), &error)) << error;
+    const auto recent = source.RecentCompleteStates("DCE.c2609", 5, 30);
+    const auto restored_recent = restored.RecentCompleteStates("DCE.c2609", 5, 30);
+    ASSERT_EQ(restored_recent.size(), recent.size());
+    ASSERT_FALSE(restored_recent.empty());
+    EXPECT_EQ(restored_recent.back().ts_ns, recent.back().ts_ns);
+    EXPECT_DOUBLE_EQ(restored_recent.back().bar_close, recent.back().bar_close);
+    EXPECT_EQ(restored_recent.back().market_state_bars_seen, recent.back().market_state_bars_seen);
+    EXPECT_TRUE(restored.OnTick(pending).duplicate_tick);
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+TEST(MarketBarPipelineTest, CorruptBinaryCheckpointIsRejectedWithoutMutatingState) {
+    MarketBarPipeline source(MakeConfig());
+    FeedAndFinalizeMinute(&source, 0, 100);
+    (void)source.OnTick(MakeTick(1, 10, 110, 101.0));
+    const auto path = std::filesystem::temp_directory_path() /
+                      "quant_hft_market_bar_pipeline_checkpoint_corrupt.state";
+    std::string error;
+    ASSERT_TRUE(source.SaveCheckpointAtomically(path.string(), &error)) << error;
+    {
+        std::fstream stream(path, std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekg(-3, std::ios::end);
+        char byte = 0;
+        stream.read(&byte, 1);
+        stream.seekp(-3, std::ios::end);
+        byte = static_cast<char>(byte ^ 0x5A);
+        stream.write(&byte, 1);
+    }
+
+    MarketBarPipeline live(MakeConfig());
+    (void)live.OnTick(MakeTick(0, 20, 90, 99.0));
+    MarketBarPipeline::PersistenceState before;
+    ASSERT_TRUE(live.SaveState(&before, &error)) << error;
+    EXPECT_FALSE(live.LoadCheckpointFile(path.string(), &error));
+    EXPECT_NE(error.find("crc"), std::string::npos) << error;
+    MarketBarPipeline::PersistenceState after;
+    ASSERT_TRUE(live.SaveState(&after, &error)) << error;
+    EXPECT_EQ(after, before);
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+TEST(MarketBarPipelineTest, LegacyTextCheckpointStillLoads) {
+    MarketBarPipeline source(MakeConfig());
+    (void)source.OnTick(MakeTick(0, 10, 100, 100.0));
+    MarketBarPipeline::PersistenceState state;
+    std::string error;
+    ASSERT_TRUE(source.SaveState(&state, &error)) << error;
+
+    const auto escape = [](const std::string& value) {
+        std::string escaped;
+        for (unsigned char ch : value) {
+            if (std::isalnum(ch) != 0 || ch == '.' || ch == '_' || ch == '-' || ch == '|') {
+                escaped.push_back(static_cast<char>(ch));
+            } else {
+                char buffer[4];
+                std::snprintf(buffer, sizeof(buffer), "%%%02X", ch);
+                escaped += buffer;
+            }
+        }
+        return escaped;
+    };
+    const auto path = std::filesystem::temp_directory_path() /
+                      "quant_hft_market_bar_pipeline_checkpoint_text.state";
+    {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        for (const auto& [key, value] : state) {
+            stream << escape(key) << '=' << escape(value) << '\n';
+        }
+    }
+
+    MarketBarPipeline restored(MakeConfig());
+    ASSERT_TRUE(restored.LoadCheckpointFile(path.string(), &error)) << error;
+    (void)restored.OnTick(MakeTick(0, 50, 110, 102.0));
+    const auto result = restored.AdvanceWatermark(ShanghaiEpochNs("20260710", 9, 1, 4));
+    ASSERT_EQ(result.one_minute_bars.size(), 1U);
+    EXPECT_DOUBLE_EQ(result.one_minute_bars[0].open, 100.0);
+    EXPECT_EQ(result.one_minute_bars[0].volume, 10);
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
 TEST(MarketBarPipelineTest, CorruptNestedCheckpointDoesNotPartiallyMutateLiveState) {
     MarketBarPipeline pipeline(MakeConfig());
     (void)pipeline.OnTick(MakeTick(0, 10, 100, 100.0));
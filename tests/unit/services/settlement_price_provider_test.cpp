@@ -80,5 +80,44 @@ TEST(SettlementPriceProviderTest, MissingPriceReturnsNullopt) {
     EXPECT_FALSE(price.has_value());
 }
 
+TEST(SettlementPriceProviderTest, BatchPrefetchResolvesWholeTradingDay) {
+    const auto cache_path = TempPath("settlement_cache_batch.sqlite");
+    const auto json_path = TempPath("settlement_prices_batch.json");
+    std::filesystem::remove(cache_path);
+
+    {
+        std::ofstream out(json_path);
+        out << "{\"rb2405\": 3800.0, \"au2406\": 512.5}";
+    }
+    {
+        ProdSettlementPriceProvider seed(cache_path, json_path);
+        const auto seeded =
+            seed.BatchGetSettlementPrices({"rb2405", "au2406", "cu2405"}, "2026-02-12");
+        ASSERT_EQ(seeded.size(), 2U);
+        EXPECT_EQ(seeded.at("au2406").second.type, SettlementPriceSource::SourceType::kApi);
+        seed.SetManualOverride("au2406", "2026-02-12", 510.0, "tester");
+    }
+    std::filesystem::remove(json_path);
+
+    ProdSettlementPriceProvider provider(cache_path, json_path);
+    const auto prices =
+        provider.BatchGetSettlementPrices({"rb2405", "au2406", "cu2405"}, "2026-02-12");
+    if (prices.empty()) {
+        GTEST_SKIP() << "sqlite cache unavailable in current runtime";
+    }
+    ASSERT_EQ(prices.size(), 2U);
+    EXPECT_DOUBLE_EQ(prices.at("rb2405").first, 3800.0);
+    EXPECT_EQ(prices.at("rb2405").second.type, SettlementPriceSource::SourceType::kCache);
+    EXPECT_DOUBLE_EQ(prices.at("au2406").first, 510.0);
+    EXPECT_EQ(prices.at("au2406").second.type, SettlementPriceSource::SourceType::kManual);
+    EXPECT_EQ(prices.count("cu2405"), 0U);
+
+    // The prefetched day also serves single lookups.
+    const auto single = provider.GetSettlementPrice("rb2405", "2026-02-12");
+    ASSERT_TRUE(single.has_value());
+    EXPECT_DOUBLE_EQ(single->first, 3800.0);
+    EXPECT_FALSE(provider.GetSettlementPrice("cu2405", "2026-02-12").has_value());
+}
+
 }  // namespace
 }  // namespace quant_hft
@@ -0,0 +1,202 @@
+#include "quant_hft/strategy/atomic/kama_trend_indicator_batch.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "quant_hft/strategy/atomic/kama_trend_strategy.h"
+
+namespace quant_hft {
+namespace {
+
+StateSnapshot7D MakeBarState(double close, EpochNanos ts_ns) {
+    StateSnapshot7D state;
+    state.instrument_id = "rb2405";
+    state.has_bar = true;
+    state.bar_high = close + 1.0;
+    state.bar_low = close - 1.0;
+    state.bar_close = close;
+    state.analysis_bar_high = state.bar_high;
+    state.analysis_bar_low = state.bar_low;
+    state.analysis_bar_close = close;
+    state.ts_ns = ts_ns;
+    return state;
+}
+
+std::vector<double> MakeCloses(std::size_t count, double drift) {
+    std::vector<double> closes;
+    double close = 3500.0;
+    for (std::size_t index = 0; index < count; ++index) {
+        close += (index % 7 < 4) ? drift : -0.6 * drift;
+        closes.push_back(close + std::sin(static_cast<double>(index)) * 2.0);
+    }
+    return closes;
+}
+
+AtomicParams MakeParams(const std::string& er_period, const std::string& stop_multiplier,
+                        const std::string& take_profit_mode) {
+    return {
+        {"id", "kama_" + er_period},
+        {"er_period", er_period},
+        {"fast_period", "2"},
+        {"slow_period", "6"},
+        {"std_period", "3"},
+        {"kama_filter", "0.0"},
+        {"stop_loss_atr_period", "3"},
+        {"stop_loss_atr_multiplier", stop_multiplier},
+        {"take_profit_mode", take_profit_mode},
+        {"take_profit_atr_period", "5"},
+        {"adx_period", "3"},
+    };
+}
+
+AtomicStrategyContext MakeContext() {
+    AtomicStrategyContext ctx;
+    ctx.account_id = "acct";
+    ctx.account_equity = 100000.0;
+    ctx.contract_multipliers["rb2405"] = 10.0;
+    return ctx;
+}
+
+// Feeds `closes` and asserts every bar's indicators and signals match `reference`, which is fed the
+// same bars.
+void ExpectSameAsReference(KamaTrendStrategy* shared, KamaTrendStrategy* reference,
+                           const std::vector<double>& closes) {
+    const AtomicStrategyContext ctx = MakeContext();
+    for (std::size_t index = 0; index < closes.size(); ++index) {
+        const StateSnapshot7D state =
+            MakeBarState(closes[index], static_cast<EpochNanos>(index + 1));
+        const std::vector<SignalIntent> shared_signals = shared->OnState(state, ctx);
+        const std::vector<SignalIntent> reference_signals = reference->OnState(state, ctx);
+        ASSERT_EQ(shared_signals.size(), reference_signals.size()) << "bar " << index;
+        for (std::size_t signal = 0; signal < shared_signals.size(); ++signal) {
+            EXPECT_EQ(shared_signals[signal].side, reference_signals[signal].side);
+            EXPECT_EQ(shared_signals[signal].volume, reference_signals[signal].volume);
+        }
+        const auto shared_snapshot = shared->IndicatorSnapshot();
+        const auto reference_snapshot = reference->IndicatorSnapshot();
+        ASSERT_EQ(shared_snapshot.has_value(), reference_snapshot.has_value()) << "bar " << index;
+        if (reference_snapshot.has_value()) {
+            EXPECT_EQ(shared_snapshot->kama, reference_snapshot->kama) << "bar " << index;
+            EXPECT_EQ(shared_snapshot->er, reference_snapshot->er) << "bar " << index;
+            EXPECT_EQ(shared_snapshot->adx, reference_snapshot->adx) << "bar " << index;
+            EXPECT_EQ(shared_snapshot->atr, reference_snapshot->atr) << "bar " << index;
+            EXPECT_EQ(shared_snapshot->trend_sum, reference_snapshot->trend_sum);
+        }
+    }
+}
+
+TEST(KamaTrendIndicatorBatchTest, MergesConfigurationsAndLanes) {
+    KamaTrendIndicatorSpec base;
+    base.stop_loss_atr_period = 14;
+    base.take_profit_atr_period = 14;
+    KamaTrendIndicatorSpec faster = base;
+    faster.er_period = 5;
+    KamaTrendIndicatorSpec no_targets = base;
+    no_targets.take_profit_atr_period = 0;
+    no_targets.stop_loss_atr_period = 20;
+
+    const KamaTrendIndicatorBatch batch({base, faster, base, no_targets});
+    EXPECT_EQ(batch.size(), 3U);
+    EXPECT_EQ(batch.kama_lane_count(), 2U);
+    EXPECT_EQ(batch.adx_lane_count(), 1U);
+    EXPECT_EQ(batch.atr_lane_count(), 2U);
+    EXPECT_EQ(batch.Find(faster), std::optional<std::size_t>(1));
+    KamaTrendIndicatorSpec unknown = base;
+    unknown.adx_period = 7;
+    EXPECT_FALSE(batch.Find(unknown).has_value());
+}
+
+TEST(KamaTrendIndicatorBatchTest, SharedStrategiesMatchTheirOwnIndicators) {
+    const std::vector<AtomicParams> trials = {
+        MakeParams("2", "2.0", "atr_target"),
+        MakeParams("2", "3.0", "atr_target"),
+        MakeParams("4", "2.0", "none"),
+    };
+    std::vector<KamaTrendIndicatorSpec> specs;
+    for (const AtomicParams& params : trials) {
+        KamaTrendStrategy probe;
+        probe.Init(params);
+        specs.push_back(probe.IndicatorSpec());
+    }
+    auto batch = std::make_shared<KamaTrendIndicatorBatch>(specs);
+    EXPECT_EQ(batch->size(), 2U);
+    EXPECT_EQ(batch->kama_lane_count(), 2U);
+
+    // Trials run one after another, like an optimizer batch on one worker: the first records,
+    // the rest replay the recording.
+    const std::vector<double> closes = MakeCloses(80, 4.0);
+    for (const AtomicParams& params : trials) {
+        KamaTrendStrategy shared;
+        {
+            const KamaTrendIndicatorBatch::Scope scope(batch);
+            shared.Init(params);
+        }
+        KamaTrendStrategy reference;
+        reference.Init(params);
+        ExpectSameAsReference(&shared, &reference, closes);
+    }
+}
+
+TEST(KamaTrendIndicatorBatchTest, DivergingBarsFallBackToOwnIndicators) {
+    const AtomicParams params = MakeParams("3", "2.0", "atr_target");
+    KamaTrendStrategy probe;
+    probe.Init(params);
+    auto batch = std::make_shared<KamaTrendIndicatorBatch>(
+        std::vector<KamaTrendIndicatorSpec>{probe.IndicatorSpec()});
+
+    const std::vector<double> recorded = MakeCloses(60, 4.0);
+    std::vector<double> diverged = recorded;
+    for (std::size_t index = 25; index < diverged.size(); ++index) {
+        diverged[index] -= 15.0;
+    }
+
+    KamaTrendStrategy first;
+    KamaTrendStrategy second;
+    {
+        const KamaTrendIndicatorBatch::Scope scope(batch);
+        first.Init(params);
+        second.Init(params);
+    }
+    KamaTrendStrategy first_reference;
+    first_reference.Init(params);
+    ExpectSameAsReference(&first, &first_reference, recorded);
+
+    KamaTrendStrategy second_reference;
+    second_reference.Init(params);
+    const std::vector<double> head(diverged.begin(), diverged.begin() + 20);
+    ExpectSameAsReference(&second, &second_reference, head);
+
+    // State saved while the batch still computes the indicators equals the reference's.
+    AtomicState shared_state;
+    AtomicState reference_state;
+    std::string error;
+    ASSERT_TRUE(second.SaveState(&shared_state, &error)) << error;
+    ASSERT_TRUE(second_reference.SaveState(&reference_state, &error)) << error;
+    EXPECT_EQ(shared_state, reference_state);
+
+    const std::vector<double> tail(diverged.begin() + 20, diverged.end());
+    ExpectSameAsReference(&second, &second_reference, tail);
+}
+
+TEST(KamaTrendIndicatorBatchTest, ScopeBindsTheBatchToTheCurrentThreadOnly) {
+    auto batch = std::make_shared<KamaTrendIndicatorBatch>(
+        std::vector<KamaTrendIndicatorSpec>{KamaTrendIndicatorSpec{}});
+    EXPECT_EQ(KamaTrendIndicatorBatch::Current(), nullptr);
+    {
+        const KamaTrendIndicatorBatch::Scope scope(batch);
+        EXPECT_EQ(KamaTrendIndicatorBatch::Current(), batch);
+        {
+            const KamaTrendIndicatorBatch::Scope inner(nullptr);
+            EXPECT_EQ(KamaTrendIndicatorBatch::Current(), nullptr);
+        }
+        EXPECT_EQ(KamaTrendIndicatorBatch::Current(), batch);
+    }
+    EXPECT_EQ(KamaTrendIndicatorBatch::Current(), nullptr);
+}
+
+}  // namespace
+}  // namespace quant_hft
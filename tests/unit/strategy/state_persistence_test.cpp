@@ -5,11 +5,26 @@
 #include <chrono>
 #include <filesystem>
 #include <memory>
+#include <string>
 #include <thread>
+#include <unordered_map>
 
 namespace quant_hft {
 namespace {
 
+class CountingRedisHashClient final : public InMemoryRedisHashClient {
+   public:
+    bool HSet(const std::string& key, const std::unordered_map<std::string, std::string>& fields,
+              std::string* error) override {
+        last_hset_fields = fields.size();
+        ++hset_calls;
+        return InMemoryRedisHashClient::HSet(key, fields, error);
+    }
+
+    std::size_t last_hset_fields{0};
+    std::size_t hset_calls{0};
+};
+
 TEST(StatePersistenceTest, SavesAndLoadsStrategyState) {
     auto redis = std::make_shared<InMemoryRedisHashClient>();
     RedisStrategyStatePersistence persistence(redis, "strategy_state", 60);
@@ -27,6 +42,29 @@ TEST(StatePersistenceTest, SavesAndLoadsStrategyState) {
     EXPECT_EQ(loaded.at("k2"), "v2");
 }
 
+TEST(StatePersistenceTest, RedisDeltaWritesOnlyChangedFields) {
+    auto redis = std::make_shared<CountingRedisHashClient>();
+    RedisStrategyStatePersistence persistence(redis, "strategy_state", 60);
+
+    std::string error;
+    ASSERT_TRUE(persistence.SaveStrategyState("acct", "alpha", {{"k1", "v1"}, {"k2", "v2"}},
+                                              &error))
+        << error;
+    ASSERT_TRUE(persistence.SaveStrategyStateDelta("acct", "alpha", {{"k1", "v1"}, {"k2", "v3"}},
+                                                   {{"k2", "v3"}}, {}, &error))
+        << error;
+    EXPECT_EQ(redis->last_hset_fields, 1U);
+    ASSERT_TRUE(persistence.SaveStrategyStateDelta("acct", "alpha", {{"k1", "v1"}, {"k2", "v3"}},
+                                                   {}, {}, &error))
+        << error;
+    EXPECT_EQ(redis->hset_calls, 2U);
+
+    StrategyState loaded;
+    ASSERT_TRUE(persistence.LoadStrategyState("acct", "alpha", &loaded, &error)) << error;
+    EXPECT_EQ(loaded.at("k1"), "v1");
+    EXPECT_EQ(loaded.at("k2"), "v3");
+}
+
 TEST(StatePersistenceTest, ExpiresWhenTtlElapsed) {
     auto redis = std::make_shared<InMemoryRedisHashClient>();
     RedisStrategyStatePersistence persistence(redis, "strategy_state", 1);
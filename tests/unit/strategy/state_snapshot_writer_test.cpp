@@ -0,0 +1,187 @@
+#include "quant_hft/strategy/state_snapshot_writer.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace quant_hft {
+namespace {
+
+class RecordingPersistence final : public IStrategyStatePersistence {
+   public:
+    bool SaveStrategyState(const std::string& account_id, const std::string& strategy_id,
+                           const StrategyState& state, std::string* error) override {
+        return SaveStrategyStateDelta(account_id, strategy_id, state, state, {}, error);
+    }
+
+    bool LoadStrategyState(const std::string& account_id, const std::string& strategy_id,
+                           StrategyState* state, std::string* error) const override {
+        (void)account_id;
+        (void)strategy_id;
+        (void)state;
+        (void)error;
+        return false;
+    }
+
+    bool SaveStrategyStateDelta(const std::string& account_id, const std::string& strategy_id,
+                                const StrategyState& state, const StrategyState& changed_fields,
+                                const std::vector<std::string>& removed_fields,
+                                std::string* error) override {
+        (void)account_id;
+        (void)strategy_id;
+        std::unique_lock<std::mutex> lock(mutex);
+        ++entered;
+        cv.notify_all();
+        cv.wait(lock, [&]() { return !blocked; });
+        if (fail_next) {
+            fail_next = false;
+            if (error != nullptr) {
+                *error = "injected failure";
+            }
+            return false;
+        }
+        states.push_back(state);
+        changes.push_back(changed_fields);
+        removals.push_back(removed_fields);
+        return true;
+    }
+
+    void SetBlocked(bool value) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            blocked = value;
+        }
+        cv.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool blocked{false};
+    std::size_t entered{0};
+    bool fail_next{false};
+    std::vector<StrategyState> states;
+    std::vector<StrategyState> changes;
+    std::vector<std::vector<std::string>> removals;
+};
+
+// Writes {a, b, c}, then {a, c'} without b, through `persistence` and reloads the result.
+StrategyState WriteSnapshotsDroppingAKey(
+    const std::shared_ptr<IStrategyStatePersistence>& persistence) {
+    {
+        StrategyStateSnapshotWriter writer(persistence);
+        writer.Submit("acct", "alpha", StrategyState{{"a", "1"}, {"b", "2"}, {"c", "3"}});
+        EXPECT_TRUE(writer.Flush(1'000));
+        writer.Submit("acct", "alpha", StrategyState{{"a", "1"}, {"c", "4"}});
+        EXPECT_TRUE(writer.Flush(1'000));
+        EXPECT_EQ(writer.GetStats().failures, 0U);
+    }
+    StrategyState loaded;
+    std::string error;
+    EXPECT_TRUE(persistence->LoadStrategyState("acct", "alpha", &loaded, &error)) << error;
+    return loaded;
+}
+
+TEST(StrategyStateSnapshotWriterTest, WritesOnlyFieldsChangedSinceBaseline) {
+    auto persistence = std::make_shared<RecordingPersistence>();
+    StrategyStateSnapshotWriter writer(persistence);
+    writer.SetBaseline("acct", "alpha", StrategyState{{"a", "1"}, {"b", "2"}});
+
+    writer.Submit("acct", "alpha", StrategyState{{"a", "1"}, {"b", "3"}, {"c", "4"}});
+    ASSERT_TRUE(writer.Flush(1'000));
+    writer.Submit("acct", "alpha", StrategyState{{"a", "1"}, {"b", "3"}, {"c", "4"}});
+    ASSERT_TRUE(writer.Flush(1'000));
+
+    std::lock_guard<std::mutex> lock(persistence->mutex);
+    ASSERT_EQ(persistence->changes.size(), 2U);
+    EXPECT_EQ(persistence->changes[0], (StrategyState{{"b", "3"}, {"c", "4"}}));
+    EXPECT_TRUE(persistence->changes[1].empty());
+    EXPECT_EQ(persistence->states[1].size(), 3U);
+    const auto stats = writer.GetStats();
+    EXPECT_EQ(stats.written, 2U);
+    EXPECT_EQ(stats.unchanged, 1U);
+    EXPECT_EQ(stats.changed_fields, 2U);
+}
+
+TEST(StrategyStateSnapshotWriterTest, ReportsKeysRemovedSinceLastWrite) {
+    auto persistence = std::make_shared<RecordingPersistence>();
+    StrategyStateSnapshotWriter writer(persistence);
+    writer.SetBaseline("acct", "alpha", StrategyState{{"a", "1"}, {"b", "2"}, {"c", "3"}});
+
+    writer.Submit("acct", "alpha", StrategyState{{"a", "1"}});
+    ASSERT_TRUE(writer.Flush(1'000));
+
+    std::lock_guard<std::mutex> lock(persistence->mutex);
+    ASSERT_EQ(persistence->removals.size(), 1U);
+    EXPECT_TRUE(persistence->changes[0].empty());
+    EXPECT_EQ(persistence->removals[0], (std::vector<std::string>{"b", "c"}));
+    const auto stats = writer.GetStats();
+    EXPECT_EQ(stats.unchanged, 0U);
+    EXPECT_EQ(stats.changed_fields, 2U);
+}
+
+TEST(StrategyStateSnapshotWriterTest, RemovedKeysAreGoneAfterReloadFromRedis) {
+    auto persistence = std::make_shared<RedisStrategyStatePersistence>(
+        std::make_shared<InMemoryRedisHashClient>(), "strategy_state", 60);
+    EXPECT_EQ(WriteSnapshotsDroppingAKey(persistence), (StrategyState{{"a", "1"}, {"c", "4"}}));
+}
+
+TEST(StrategyStateSnapshotWriterTest, RemovedKeysAreGoneAfterReloadFromFile) {
+    const auto token = std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    const auto root =
+        std::filesystem::temp_directory_path() / ("quant_hft_snapshot_writer_" + token);
+    auto persistence =
+        std::make_shared<FileStrategyStatePersistence>(root.string(), "strategy_state", 0);
+    EXPECT_EQ(WriteSnapshotsDroppingAKey(persistence), (StrategyState{{"a", "1"}, {"c", "4"}}));
+    std::filesystem::remove_all(root);
+}
+
+TEST(StrategyStateSnapshotWriterTest, CoalescesSnapshotsQueuedBehindSlowWrite) {
+    auto persistence = std::make_shared<RecordingPersistence>();
+    persistence->SetBlocked(true);
+    StrategyStateSnapshotWriter writer(persistence);
+
+    writer.Submit("acct", "alpha", StrategyState{{"seq", "1"}});
+    {
+        std::unique_lock<std::mutex> lock(persistence->mutex);
+        ASSERT_TRUE(persistence->cv.wait_for(lock, std::chrono::seconds(1),
+                                             [&]() { return persistence->entered == 1; }));
+    }
+    EXPECT_FALSE(writer.Flush(20));
+    writer.Submit("acct", "alpha", StrategyState{{"seq", "2"}});
+    writer.Submit("acct", "alpha", StrategyState{{"seq", "3"}});
+    persistence->SetBlocked(false);
+    ASSERT_TRUE(writer.Flush(1'000));
+
+    std::lock_guard<std::mutex> lock(persistence->mutex);
+    ASSERT_EQ(persistence->states.size(), 2U);
+    EXPECT_EQ(persistence->states[0].at("seq"), "1");
+    EXPECT_EQ(persistence->states[1].at("seq"), "3");
+    const auto stats = writer.GetStats();
+    EXPECT_EQ(stats.submitted, 3U);
+    EXPECT_EQ(stats.coalesced, 1U);
+}
+
+TEST(StrategyStateSnapshotWriterTest, FailedWriteKeepsFieldsDirty) {
+    auto persistence = std::make_shared<RecordingPersistence>();
+    persistence->fail_next = true;
+    StrategyStateSnapshotWriter writer(persistence);
+
+    writer.Submit("acct", "alpha", StrategyState{{"a", "1"}});
+    ASSERT_TRUE(writer.Flush(1'000));
+    writer.Submit("acct", "alpha", StrategyState{{"a", "1"}});
+    ASSERT_TRUE(writer.Flush(1'000));
+
+    std::lock_guard<std::mutex> lock(persistence->mutex);
+    ASSERT_EQ(persistence->changes.size(), 1U);
+    EXPECT_EQ(persistence->changes[0], (StrategyState{{"a", "1"}}));
+    EXPECT_EQ(writer.GetStats().failures, 1U);
+}
+
+}  // namespace
+}  // namespace quant_hft
@@ -12,6 +12,7 @@
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "quant_hft/strategy/live_strategy.h"
@@ -791,6 +792,51 @@ TEST(StrategyEngineTest, DropsOldestEventsWhenQueueIsFull) {
     EXPECT_GT(stats.dropped_oldest_events, 0U);
 }
 
+TEST(StrategyEngineTest, DropOldestKeepsNewestEventsInOrder) {
+    Probe probe;
+    g_probe = &probe;
+    ResetThrowingBehavior();
+
+    std::string error;
+    const auto factory_name = UniqueFactoryName();
+    ASSERT_TRUE(StrategyRegistry::Instance().RegisterFactory(
+        factory_name, []() { return std::make_unique<RecordingStrategy>(); }, &error))
+        << error;
+
+    StrategyEngineConfig cfg;
+    cfg.queue_capacity = 4;
+    cfg.timer_interval_ns = 1'000'000'000;
+    StrategyEngine engine(cfg);
+    StrategyContext base_context;
+    ASSERT_TRUE(engine.Start({"alpha"}, factory_name, base_context, &error)) << error;
+
+    g_state_delay_ms.store(10);
+    for (EpochNanos ts = 1; ts <= 40; ++ts) {
+        StateSnapshot7D state;
+        state.instrument_id = "SHFE.ag2406";
+        state.ts_ns = ts;
+        engine.EnqueueState(state);
+    }
+    ASSERT_TRUE(engine.WaitUntilDrained(2'000));
+    g_state_delay_ms.store(0);
+
+    const auto stats = engine.GetStats();
+    EXPECT_EQ(stats.enqueued_events, 40U);
+    EXPECT_GT(stats.dropped_oldest_events, 0U);
+    EXPECT_EQ(stats.processed_events + stats.dropped_oldest_events, stats.enqueued_events);
+    {
+        std::lock_guard<std::mutex> lock(probe.mutex);
+        ASSERT_FALSE(probe.observed_state_ts.empty());
+        EXPECT_TRUE(std::is_sorted(probe.observed_state_ts.begin(),
+                                   probe.observed_state_ts.end()));
+        EXPECT_EQ(probe.observed_state_ts.back(), 40);
+        EXPECT_EQ(probe.observed_state_ts.size(), stats.processed_events);
+    }
+
+    engine.Stop();
+    g_probe = nullptr;
+}
+
 TEST(StrategyEngineTest, ContractSwitchWarmsWithoutEmittingAndStampsNextIntent) {
     Probe probe;
     g_probe = &probe;
@@ -907,5 +953,190 @@ TEST(StrategyEngineTest, ContractSwitchWarmsWithoutEmittingAndStampsNextIntent)
     g_probe = nullptr;
 }
 
+TEST(StrategyEngineTest, MultiWorkerRoutesStatesByProductInOrder) {
+    Probe probe;
+    g_probe = &probe;
+    ResetThrowingBehavior();
+
+    std::string error;
+    const auto factory_name = UniqueFactoryName();
+    ASSERT_TRUE(StrategyRegistry::Instance().RegisterFactory(
+        factory_name, []() { return std::make_unique<RecordingStrategy>(); }, &error))
+        << error;
+
+    std::mutex sink_mutex;
+    std::unordered_map<std::string, std::vector<EpochNanos>> intents_by_strategy;
+    StrategyEngineConfig cfg;
+    cfg.queue_capacity = 256;
+    cfg.timer_interval_ns = 1'000'000'000;
+    cfg.worker_count = 2;
+    StrategyEngine engine(cfg, [&](const SignalIntent& intent) {
+        std::lock_guard<std::mutex> lock(sink_mutex);
+        intents_by_strategy[intent.strategy_id].push_back(intent.ts_ns);
+    });
+    std::vector<StrategyEngine::StrategyLaunchSpec> specs(3);
+    specs[0].strategy_id = "alpha";
+    specs[0].strategy_factory = factory_name;
+    specs[0].product_ids = {"rb"};
+    specs[1].strategy_id = "beta";
+    specs[1].strategy_factory = factory_name;
+    specs[1].product_ids = {"ag"};
+    specs[2].strategy_id = "gamma";
+    specs[2].strategy_factory = factory_name;
+    ASSERT_TRUE(engine.Start(specs, &error)) << error;
+    EXPECT_EQ(engine.worker_count(), 2U);
+
+    std::vector<EpochNanos> rb_ts;
+    std::vector<EpochNanos> ag_ts;
+    std::vector<EpochNanos> all_ts;
+    for (EpochNanos index = 1; index <= 20; ++index) {
+        StateSnapshot7D rb;
+        rb.instrument_id = "rb2510";
+        rb.ts_ns = index;
+        engine.EnqueueState(rb, "rb");
+        rb_ts.push_back(index);
+        all_ts.push_back(index);
+
+        StateSnapshot7D ag;
+        ag.instrument_id = "ag2512";
+        ag.ts_ns = 100 + index;
+        engine.EnqueueState(ag, "ag");
+        ag_ts.push_back(100 + index);
+        all_ts.push_back(100 + index);
+    }
+    ASSERT_TRUE(engine.WaitUntilDrained(1'000));
+
+    {
+        std::lock_guard<std::mutex> lock(sink_mutex);
+        EXPECT_EQ(intents_by_strategy["alpha"], rb_ts);
+        EXPECT_EQ(intents_by_strategy["beta"], ag_ts);
+        EXPECT_EQ(intents_by_strategy["gamma"], all_ts);
+    }
+    const auto stats = engine.GetStats();
+    EXPECT_EQ(stats.enqueued_events, stats.processed_events);
+    EXPECT_EQ(stats.dropped_oldest_events, 0U);
+
+    engine.Stop();
+    g_probe = nullptr;
+}
+
+TEST(StrategyEngineTest, MultiWorkerDeliversProductStatesToOneWorker) {
+    Probe probe;
+    g_probe = &probe;
+    ResetThrowingBehavior();
+
+    std::string error;
+    const auto factory_name = UniqueFactoryName();
+    ASSERT_TRUE(StrategyRegistry::Instance().RegisterFactory(
+        factory_name, []() { return std::make_unique<RecordingStrategy>(); }, &error))
+        << error;
+
+    std::mutex sink_mutex;
+    std::unordered_map<std::string, std::size_t> intents_by_strategy;
+    StrategyEngineConfig cfg;
+    cfg.queue_capacity = 256;
+    cfg.timer_interval_ns = 1'000'000'000;
+    cfg.worker_count = 2;
+    StrategyEngine engine(cfg, [&](const SignalIntent& intent) {
+        std::lock_guard<std::mutex> lock(sink_mutex);
+        ++intents_by_strategy[intent.strategy_id];
+    });
+    // Scoped the way core_engine launches composite strategies: by product, with the product
+    // as affinity key.
+    std::vector<StrategyEngine::StrategyLaunchSpec> specs(4);
+    const std::vector<std::pair<std::string, std::string>> placements = {
+        {"rb_trend", "rb"}, {"ag_trend", "ag"}, {"rb_revert", "rb"}, {"ag_revert", "ag"}};
+    for (std::size_t index = 0; index < specs.size(); ++index) {
+        specs[index].strategy_id = placements[index].first;
+        specs[index].strategy_factory = factory_name;
+        specs[index].product_ids = {placements[index].second};
+        specs[index].affinity_key = placements[index].second;
+    }
+    ASSERT_TRUE(engine.Start(specs, &error)) << error;
+
+    constexpr std::uint64_t kStates = 50;
+    for (EpochNanos index = 1; index <= static_cast<EpochNanos>(kStates); ++index) {
+        StateSnapshot7D rb;
+        rb.instrument_id = "rb2510";
+        rb.ts_ns = index;
+        engine.EnqueueState(rb, "rb");
+    }
+    ASSERT_TRUE(engine.WaitUntilDrained(1'000));
+
+    // Every state was queued once, on the single worker owning both rb strategies.
+    const auto stats = engine.GetStats();
+    EXPECT_EQ(stats.enqueued_events, kStates);
+    EXPECT_EQ(stats.processed_events, kStates);
+    {
+        std::lock_guard<std::mutex> lock(sink_mutex);
+        EXPECT_EQ(intents_by_strategy["rb_trend"], kStates);
+        EXPECT_EQ(intents_by_strategy["rb_revert"], kStates);
+        EXPECT_EQ(intents_by_strategy.count("ag_trend"), 0U);
+        EXPECT_EQ(intents_by_strategy.count("ag_revert"), 0U);
+    }
+
+    engine.Stop();
+    g_probe = nullptr;
+}
+
+TEST(StrategyEngineTest, MultiWorkerContractSwitchSpansEveryWorker) {
+    Probe probe;
+    g_probe = &probe;
+    ResetThrowingBehavior();
+
+    std::string error;
+    const auto factory_name = UniqueFactoryName();
+    ASSERT_TRUE(StrategyRegistry::Instance().RegisterFactory(
+        factory_name, []() { return std::make_unique<RecordingStrategy>(); }, &error))
+        << error;
+
+    StrategyEngineConfig cfg;
+    cfg.queue_capacity = 64;
+    cfg.timer_interval_ns = 1'000'000'000;
+    cfg.worker_count = 3;
+    StrategyEngine engine(cfg, nullptr);
+    std::vector<StrategyEngine::StrategyLaunchSpec> specs(3);
+    specs[0].strategy_id = "alpha";
+    specs[0].strategy_factory = factory_name;
+    specs[0].product_ids = {"c"};
+    specs[1].strategy_id = "beta";
+    specs[1].strategy_factory = factory_name;
+    specs[1].product_ids = {"m"};
+    specs[2].strategy_id = "gamma";
+    specs[2].strategy_factory = factory_name;
+    ASSERT_TRUE(engine.Start(specs, &error)) << error;
+
+    std::vector<StateSnapshot7D> warmup;
+    for (EpochNanos ts : {1, 2, 3}) {
+        StateSnapshot7D state;
+        state.instrument_id = "c2609";
+        state.timeframe_minutes = 5;
+        state.ts_ns = ts;
+        state.has_bar = true;
+        warmup.push_back(state);
+    }
+    const auto report =
+        engine.ApplyContractSwitch(ContractSwitchContext{"c", "c2607", "c2609", 3}, warmup, 1'000);
+    ASSERT_TRUE(report.success) << report.error;
+    EXPECT_EQ(report.required_warmup_bars, 2);
+    EXPECT_EQ(report.replayed_warmup_bars, 2);
+    {
+        std::lock_guard<std::mutex> lock(probe.mutex);
+        EXPECT_EQ(probe.contract_switches.size(), 2U);
+        EXPECT_EQ(probe.observed_state_ts.size(), 4U);
+    }
+
+    StateSnapshot7D next = warmup.back();
+    next.ts_ns = 4;
+    EXPECT_TRUE(engine.ApplyContractWarmupState(next, "c", 3, 1'000));
+    {
+        std::lock_guard<std::mutex> lock(probe.mutex);
+        EXPECT_EQ(probe.observed_state_ts.size(), 6U);
+    }
+
+    engine.Stop();
+    g_probe = nullptr;
+}
+
 }  // namespace
 }  // namespace quant_hft